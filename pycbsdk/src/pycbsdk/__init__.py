@@ -24,8 +24,20 @@ from .session import (
     ChanInfoField,
     ProtocolVersion,
     Stats,
+    LatencySummary,
+    LatencyStats,
+    RecordingStats,
+    SpikeBinningStats,
+    DigitalInputStats,
+    SpikeSortingStats,
     ContinuousReader,
+    ReferenceScheme,
+    ReferenceStatistic,
+    VirtualGroup,
+    BandPowerStream,
+    EpochStream,
 )
+from .files import ContinuousFile, EventFile, EventArrays
 
 try:
     from ._version import __version__
@@ -40,6 +52,20 @@ __all__ = [
     "ChanInfoField",
     "ProtocolVersion",
     "Stats",
+    "LatencySummary",
+    "LatencyStats",
+    "RecordingStats",
+    "SpikeBinningStats",
+    "DigitalInputStats",
+    "SpikeSortingStats",
     "ContinuousReader",
+    "ReferenceScheme",
+    "ReferenceStatistic",
+    "VirtualGroup",
+    "BandPowerStream",
+    "EpochStream",
+    "ContinuousFile",
+    "EventFile",
+    "EventArrays",
     "__version__",
 ]
@@ -19,6 +19,8 @@ typedef enum {
     CBSDK_RESULT_SHMEM_ERROR         = -4,
     CBSDK_RESULT_DEVICE_ERROR        = -5,
     CBSDK_RESULT_INTERNAL_ERROR      = -6,
+    CBSDK_RESULT_TIMEOUT             = -7,
+    CBSDK_RESULT_FILE_ERROR          = -8,
 } cbsdk_result_t;
 
 typedef enum {
@@ -113,6 +115,211 @@ typedef struct {
     uint64_t send_errors;
 } cbsdk_stats_t;
 
+typedef struct {
+    uint64_t count;
+    uint64_t min_ns;
+    uint64_t p50_ns;
+    uint64_t p90_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+    double mean_ns;
+} cbsdk_latency_summary_t;
+
+typedef struct {
+    cbsdk_latency_summary_t device_to_arrival;
+    cbsdk_latency_summary_t arrival_to_store;
+    cbsdk_latency_summary_t store_to_dequeue;
+    cbsdk_latency_summary_t dequeue_to_callback;
+    cbsdk_latency_summary_t device_to_callback;
+} cbsdk_latency_stats_t;
+
+typedef struct {
+    uint64_t continuous_packets;
+    uint64_t spike_packets;
+    uint64_t digital_packets;
+    uint64_t bytes_written;
+    uint64_t packets_dropped;
+    uint64_t write_errors;
+    uint64_t pending_bytes;
+    bool direct_io;
+} cbsdk_recording_stats_t;
+
+typedef struct {
+    uint32_t channel_count;
+    uint64_t sample_count;
+    uint32_t period;
+    uint32_t time_resolution;
+    uint32_t segment_count;
+    bool compressed;
+} cbsdk_continuous_file_info_t;
+
+typedef struct {
+    uint64_t packet_count;
+    uint32_t bytes_per_packet;
+    uint32_t time_resolution;
+    uint32_t waveform_samples;
+} cbsdk_event_file_info_t;
+
+typedef struct {
+    uint32_t hpfreq;
+    uint32_t hporder;
+    uint32_t hptype;
+    uint32_t lpfreq;
+    uint32_t lporder;
+    uint32_t lptype;
+    uint32_t notch_freq;
+    uint32_t notch_bandwidth;
+} cbsdk_filter_spec_t;
+
+typedef struct {
+    uint32_t min_samples;
+    uint32_t max_samples;
+    uint32_t max_delay_us;
+} cbsdk_batch_policy_t;
+
+typedef struct {
+    uint32_t kind;
+    cbproto_group_rate_t source;
+    uint32_t up;
+    uint32_t down;
+    double sample_rate_hz;
+    double group_delay;
+    uint32_t channel_count;
+    uint32_t buffer_capacity;
+    uint32_t buffered;
+    uint64_t samples_produced;
+    uint64_t samples_overwritten;
+} cbsdk_virtual_group_info_t;
+
+typedef enum {
+    CBSDK_THRESHOLD_OFF   = 0,
+    CBSDK_THRESHOLD_LEVEL = 1,
+    CBSDK_THRESHOLD_RMS   = 2,
+} cbsdk_threshold_mode_t;
+
+typedef struct {
+    double low_hz;
+    double high_hz;
+} cbsdk_frequency_band_t;
+
+typedef struct {
+    cbproto_group_rate_t source;
+    uint32_t virtual_group;
+    uint32_t window;
+    uint32_t hop;
+} cbsdk_band_power_config_t;
+
+typedef struct {
+    cbproto_group_rate_t source;
+    uint32_t virtual_group;
+    double sample_rate_hz;
+    uint32_t window;
+    uint32_t hop;
+    uint32_t band_count;
+    uint32_t channel_count;
+    uint32_t buffer_capacity;
+    uint32_t buffered;
+    uint64_t frames_produced;
+    uint64_t frames_overwritten;
+} cbsdk_band_power_info_t;
+
+typedef struct {
+    cbproto_group_rate_t source;
+    uint32_t pre_samples;
+    uint32_t post_samples;
+    uint32_t max_delay_samples;
+    uint32_t max_pending;
+    uint32_t unit_mask;
+    bool comments;
+} cbsdk_epoch_config_t;
+
+typedef struct {
+    uint64_t time;
+    uint64_t trigger_time;
+    uint32_t chan_id;
+    uint32_t value;
+} cbsdk_epoch_event_t;
+
+typedef struct {
+    cbproto_group_rate_t source;
+    uint32_t pre_samples;
+    uint32_t post_samples;
+    uint32_t channel_count;
+    uint32_t pending;
+    uint32_t buffer_capacity;
+    uint32_t buffered;
+    uint64_t epochs_produced;
+    uint64_t epochs_overwritten;
+    uint64_t events_late;
+    uint64_t events_dropped;
+} cbsdk_epoch_info_t;
+
+typedef struct {
+    cbsdk_threshold_mode_t mode;
+    int16_t level;
+    float rms_multiplier;
+} cbsdk_spike_threshold_t;
+
+typedef struct {
+    cbproto_group_rate_t source;
+    cbsdk_filter_spec_t filter;
+    cbsdk_spike_threshold_t threshold;
+    uint32_t refractory_samples;
+    uint32_t rms_window;
+} cbsdk_spike_detection_config_t;
+
+typedef struct {
+    uint64_t bin_width;
+    uint64_t latency;
+    uint32_t channel_count;
+    uint32_t unit_count;
+    uint32_t buffer_bins;
+} cbsdk_spike_binning_config_t;
+
+typedef struct {
+    uint64_t spikes_counted;
+    uint64_t spikes_late;
+    uint64_t spikes_ignored;
+    uint64_t bins_closed;
+    uint64_t bins_skipped;
+    uint64_t bins_overwritten;
+} cbsdk_spike_binning_stats_t;
+
+typedef struct {
+    uint64_t time;
+    uint32_t chan_id;
+    uint32_t value;
+    uint32_t rising;
+    uint32_t falling;
+} cbsdk_digital_input_event_t;
+
+typedef struct {
+    uint64_t events;
+    uint64_t edges_rising;
+    uint64_t edges_falling;
+} cbsdk_digital_input_stats_t;
+
+typedef struct {
+    float gate;
+    uint32_t threads;
+    bool device_spikes;
+} cbsdk_spike_sorting_config_t;
+
+typedef struct {
+    uint32_t unit;
+    float mean[2];
+    float inv_covariance[2][2];
+    float log_determinant;
+} cbsdk_sort_unit_t;
+
+typedef struct {
+    uint64_t spikes_sorted;
+    uint64_t spikes_noise;
+    uint64_t spikes_unsorted;
+    uint64_t spikes_unmodelled;
+} cbsdk_spike_sorting_stats_t;
+
 typedef struct {
     int16_t  digmin;
     int16_t  digmax;
@@ -134,15 +341,32 @@ typedef void (*cbsdk_group_callback_fn)(const cbPKT_GROUP* pkt, void* user_data)
 typedef void (*cbsdk_group_batch_callback_fn)(const int16_t* samples, size_t n_samples,
                                                size_t n_channels, const uint64_t* timestamps,
                                                void* user_data);
+typedef enum {
+    CBSDK_SAMPLE_MAJOR  = 0,
+    CBSDK_CHANNEL_MAJOR = 1,
+} cbsdk_sample_layout_t;
+
+typedef void (*cbsdk_scaled_group_batch_callback_fn)(const float* samples, size_t n_samples,
+                                                      size_t n_channels, const uint64_t* timestamps,
+                                                      void* user_data);
 typedef void (*cbsdk_config_callback_fn)(const cbPKT_GENERIC* pkt, void* user_data);
 typedef void (*cbsdk_runlevel_callback_fn)(uint32_t runlevel, void* user_data);
 typedef void (*cbsdk_error_callback_fn)(const char* error_message, void* user_data);
+typedef void (*cbsdk_band_power_callback_fn)(const float* features, size_t n_frames, size_t n_channels,
+                                              size_t n_bands, const uint64_t* timestamps, void* user_data);
+typedef void (*cbsdk_epoch_callback_fn)(const cbsdk_epoch_event_t* event, const int16_t* samples,
+                                         size_t n_samples, size_t n_channels, const uint64_t* timestamps,
+                                         void* user_data);
+typedef void (*cbsdk_spike_bin_callback_fn)(uint64_t start_time, const uint32_t* counts,
+                                             size_t n_channels, size_t n_units, void* user_data);
 
 ///////////////////////////////////////////////////////////////////////////
 // Opaque Handle
 ///////////////////////////////////////////////////////////////////////////
 
 typedef struct cbsdk_session_impl* cbsdk_session_t;
+typedef struct cbsdk_continuous_reader_impl* cbsdk_continuous_reader_t;
+typedef struct cbsdk_event_reader_impl* cbsdk_event_reader_t;
 
 ///////////////////////////////////////////////////////////////////////////
 // Functions
@@ -150,6 +374,10 @@ typedef struct cbsdk_session_impl* cbsdk_session_t;
 
 // Config
 cbsdk_config_t cbsdk_config_default(void);
+cbsdk_spike_detection_config_t cbsdk_spike_detection_config_default(void);
+cbsdk_epoch_config_t cbsdk_epoch_config_default(void);
+cbsdk_spike_binning_config_t cbsdk_spike_binning_config_default(void);
+cbsdk_spike_sorting_config_t cbsdk_spike_sorting_config_default(void);
 
 // Session lifecycle
 cbsdk_result_t cbsdk_session_create(cbsdk_session_t* session, const cbsdk_config_t* config);
@@ -176,6 +404,22 @@ cbsdk_callback_handle_t cbsdk_session_register_group_callback(
 cbsdk_callback_handle_t cbsdk_session_register_group_batch_callback(
     cbsdk_session_t session, cbproto_group_rate_t rate,
     cbsdk_group_batch_callback_fn callback, void* user_data);
+cbsdk_callback_handle_t cbsdk_session_register_filtered_group_batch_callback(
+    cbsdk_session_t session, cbproto_group_rate_t rate, const cbsdk_filter_spec_t* spec,
+    cbsdk_group_batch_callback_fn callback, void* user_data);
+cbsdk_callback_handle_t cbsdk_session_register_channel_group_batch_callback(
+    cbsdk_session_t session, cbproto_group_rate_t rate, const uint32_t* chan_ids, uint32_t n_chans,
+    const cbsdk_filter_spec_t* spec, cbsdk_group_batch_callback_fn callback, void* user_data);
+cbsdk_callback_handle_t cbsdk_session_register_formatted_group_batch_callback(
+    cbsdk_session_t session, cbproto_group_rate_t rate, const uint32_t* chan_ids, uint32_t n_chans,
+    const cbsdk_filter_spec_t* spec, cbsdk_sample_layout_t layout,
+    const cbsdk_batch_policy_t* policy,
+    cbsdk_group_batch_callback_fn callback, void* user_data);
+cbsdk_callback_handle_t cbsdk_session_register_scaled_group_batch_callback(
+    cbsdk_session_t session, cbproto_group_rate_t rate, const uint32_t* chan_ids, uint32_t n_chans,
+    const cbsdk_filter_spec_t* spec, cbsdk_sample_layout_t layout,
+    const cbsdk_batch_policy_t* policy,
+    cbsdk_scaled_group_batch_callback_fn callback, void* user_data);
 cbsdk_callback_handle_t cbsdk_session_register_config_callback(
     cbsdk_session_t session, uint16_t packet_type,
     cbsdk_config_callback_fn callback, void* user_data);
@@ -186,6 +430,7 @@ void cbsdk_session_unregister_callback(cbsdk_session_t session,
 
 // Statistics
 void cbsdk_session_get_stats(cbsdk_session_t session, cbsdk_stats_t* stats);
+void cbsdk_session_get_latency_stats(cbsdk_session_t session, cbsdk_latency_stats_t* stats);
 void cbsdk_session_reset_stats(cbsdk_session_t session);
 
 // Configuration access
@@ -274,6 +519,18 @@ typedef enum {
     CBSDK_CHANINFO_FIELD_TERM        = 12,
 } cbsdk_chaninfo_field_t;
 
+typedef enum {
+    CBSDK_REFERENCE_COMMON    = 0,
+    CBSDK_REFERENCE_BANK      = 1,
+    CBSDK_REFERENCE_HEADSTAGE = 2,
+    CBSDK_REFERENCE_ELECTRODE = 3,
+} cbsdk_reference_scheme_t;
+
+typedef enum {
+    CBSDK_REFERENCE_MEAN   = 0,
+    CBSDK_REFERENCE_MEDIAN = 1,
+} cbsdk_reference_statistic_t;
+
 // Generic single-channel field getter
 int64_t cbsdk_session_get_channel_field(cbsdk_session_t session,
     uint32_t chan_id, cbsdk_chaninfo_field_t field);
@@ -341,6 +598,124 @@ cbsdk_result_t cbsdk_session_stop_central_recording(cbsdk_session_t session);
 cbsdk_result_t cbsdk_session_open_central_file_dialog(cbsdk_session_t session);
 cbsdk_result_t cbsdk_session_close_central_file_dialog(cbsdk_session_t session);
 
+// Local recording (NSx/NEV)
+cbsdk_result_t cbsdk_session_start_recording(cbsdk_session_t session,
+    const char* base_path, const char* comment);
+void cbsdk_session_stop_recording(cbsdk_session_t session);
+bool cbsdk_session_is_recording(cbsdk_session_t session);
+void cbsdk_session_get_recording_stats(cbsdk_session_t session, cbsdk_recording_stats_t* stats);
+
+// Virtual sample groups
+cbsdk_result_t cbsdk_session_create_resampled_group(cbsdk_session_t session,
+    cbproto_group_rate_t source, uint32_t up, uint32_t down, uint32_t buffer_samples, uint32_t* group);
+cbsdk_result_t cbsdk_session_create_rereferenced_group(cbsdk_session_t session,
+    cbproto_group_rate_t source, cbsdk_reference_scheme_t scheme, cbsdk_reference_statistic_t statistic,
+    uint32_t buffer_samples, uint32_t* group);
+cbsdk_result_t cbsdk_session_destroy_virtual_group(cbsdk_session_t session, uint32_t group);
+cbsdk_callback_handle_t cbsdk_session_register_virtual_group_batch_callback(
+    cbsdk_session_t session, uint32_t group, cbsdk_group_batch_callback_fn callback, void* user_data);
+cbsdk_result_t cbsdk_session_get_virtual_group_info(cbsdk_session_t session, uint32_t group,
+    cbsdk_virtual_group_info_t* info);
+cbsdk_result_t cbsdk_session_read_virtual_group(cbsdk_session_t session, uint32_t group,
+    int16_t* samples, uint64_t* timestamps, uint32_t max_channels, uint32_t* n_samples, uint32_t* n_channels);
+
+// Band power
+cbsdk_result_t cbsdk_session_create_band_power_stream(cbsdk_session_t session,
+    const cbsdk_band_power_config_t* config, const cbsdk_frequency_band_t* bands, uint32_t n_bands,
+    uint32_t buffer_frames, uint32_t* stream);
+cbsdk_result_t cbsdk_session_destroy_band_power_stream(cbsdk_session_t session, uint32_t stream);
+cbsdk_callback_handle_t cbsdk_session_register_band_power_callback(
+    cbsdk_session_t session, uint32_t stream, cbsdk_band_power_callback_fn callback, void* user_data);
+cbsdk_result_t cbsdk_session_get_band_power_info(cbsdk_session_t session, uint32_t stream,
+    cbsdk_band_power_info_t* info);
+cbsdk_result_t cbsdk_session_read_band_power(cbsdk_session_t session, uint32_t stream,
+    float* features, uint64_t* timestamps, uint32_t max_channels, uint32_t* n_frames, uint32_t* n_channels);
+
+// Peri-event epochs
+cbsdk_result_t cbsdk_session_create_epoch_stream(cbsdk_session_t session,
+    const cbsdk_epoch_config_t* config, const uint32_t* channels, uint32_t n_channels,
+    uint32_t buffer_epochs, uint32_t* stream);
+cbsdk_result_t cbsdk_session_destroy_epoch_stream(cbsdk_session_t session, uint32_t stream);
+cbsdk_callback_handle_t cbsdk_session_register_epoch_callback(
+    cbsdk_session_t session, uint32_t stream, cbsdk_epoch_callback_fn callback, void* user_data);
+cbsdk_result_t cbsdk_session_get_epoch_info(cbsdk_session_t session, uint32_t stream,
+    cbsdk_epoch_info_t* info);
+cbsdk_result_t cbsdk_session_read_epochs(cbsdk_session_t session, uint32_t stream,
+    int16_t* samples, cbsdk_epoch_event_t* events, uint32_t max_channels, uint32_t* n_epochs,
+    uint32_t* n_channels);
+
+// Host spike detection
+cbsdk_result_t cbsdk_session_start_spike_detection(cbsdk_session_t session,
+    const cbsdk_spike_detection_config_t* config);
+void cbsdk_session_stop_spike_detection(cbsdk_session_t session);
+bool cbsdk_session_is_spike_detection_running(cbsdk_session_t session);
+cbsdk_result_t cbsdk_session_set_spike_detection_threshold(cbsdk_session_t session, uint32_t chan_id,
+    const cbsdk_spike_threshold_t* threshold);
+cbsdk_result_t cbsdk_session_get_spike_detection_level(cbsdk_session_t session, uint32_t chan_id,
+    int16_t* level);
+
+// Spike binning
+cbsdk_result_t cbsdk_session_start_spike_binning(cbsdk_session_t session,
+    const cbsdk_spike_binning_config_t* config);
+void cbsdk_session_stop_spike_binning(cbsdk_session_t session);
+bool cbsdk_session_is_spike_binning_running(cbsdk_session_t session);
+cbsdk_callback_handle_t cbsdk_session_register_spike_bin_callback(
+    cbsdk_session_t session, cbsdk_spike_bin_callback_fn callback, void* user_data);
+cbsdk_result_t cbsdk_session_read_spike_bins(cbsdk_session_t session, uint32_t* counts,
+    uint64_t* start_times, uint32_t* n_bins);
+cbsdk_result_t cbsdk_session_get_spike_binning_stats(cbsdk_session_t session,
+    cbsdk_spike_binning_stats_t* stats);
+
+// Digital input tracking
+cbsdk_result_t cbsdk_session_start_digital_input_tracking(cbsdk_session_t session,
+    uint32_t buffer_events);
+void cbsdk_session_stop_digital_input_tracking(cbsdk_session_t session);
+bool cbsdk_session_is_digital_input_tracking_running(cbsdk_session_t session);
+cbsdk_result_t cbsdk_session_read_digital_input_events(cbsdk_session_t session,
+    uint64_t* cursor, cbsdk_digital_input_event_t* events, uint32_t* n_events, uint64_t* skipped);
+cbsdk_result_t cbsdk_session_get_digital_input_state(cbsdk_session_t session, uint32_t chan_id,
+    const uint64_t* times, uint32_t n_times, uint32_t* values, uint32_t* n_exact);
+cbsdk_result_t cbsdk_session_get_digital_input_word(cbsdk_session_t session, uint32_t chan_id,
+    uint32_t* value);
+cbsdk_result_t cbsdk_session_get_digital_input_stats(cbsdk_session_t session,
+    cbsdk_digital_input_stats_t* stats);
+
+// Host spike sorting
+cbsdk_result_t cbsdk_session_start_spike_sorting(cbsdk_session_t session,
+    const cbsdk_spike_sorting_config_t* config);
+void cbsdk_session_stop_spike_sorting(cbsdk_session_t session);
+bool cbsdk_session_is_spike_sorting_running(cbsdk_session_t session);
+cbsdk_result_t cbsdk_session_set_spike_sort_model(cbsdk_session_t session, uint32_t chan_id,
+    const float* basis, uint32_t n_points, const cbsdk_sort_unit_t* units, uint32_t n_units,
+    const float* noise_center, const float* noise_axes);
+cbsdk_result_t cbsdk_session_get_spike_sorting_stats(cbsdk_session_t session,
+    cbsdk_spike_sorting_stats_t* stats);
+
+// Recorded file access (NSx / .cbz / NEV)
+cbsdk_result_t cbsdk_continuous_reader_open(const char* path, cbsdk_continuous_reader_t* reader);
+void cbsdk_continuous_reader_close(cbsdk_continuous_reader_t reader);
+cbsdk_result_t cbsdk_continuous_reader_get_info(
+    cbsdk_continuous_reader_t reader, cbsdk_continuous_file_info_t* info);
+cbsdk_result_t cbsdk_continuous_reader_get_channel_ids(
+    cbsdk_continuous_reader_t reader, uint16_t* ids, uint32_t* count);
+cbsdk_result_t cbsdk_continuous_reader_find_range(
+    cbsdk_continuous_reader_t reader, uint64_t t0, uint64_t t1, uint64_t* first, uint64_t* count);
+cbsdk_result_t cbsdk_continuous_reader_read(
+    cbsdk_continuous_reader_t reader, const uint16_t* channel_ids, uint32_t n_ids,
+    uint64_t first, uint64_t count, int16_t* samples, uint64_t* timestamps);
+cbsdk_result_t cbsdk_continuous_reader_view(
+    cbsdk_continuous_reader_t reader, uint64_t first, uint64_t count,
+    const void** data, size_t* row_stride);
+cbsdk_result_t cbsdk_event_reader_open(const char* path, cbsdk_event_reader_t* reader);
+void cbsdk_event_reader_close(cbsdk_event_reader_t reader);
+cbsdk_result_t cbsdk_event_reader_get_info(cbsdk_event_reader_t reader, cbsdk_event_file_info_t* info);
+cbsdk_result_t cbsdk_event_reader_find_range(
+    cbsdk_event_reader_t reader, uint64_t t0, uint64_t t1, uint64_t* first, uint64_t* count);
+cbsdk_result_t cbsdk_event_reader_read(
+    cbsdk_event_reader_t reader, uint64_t first, uint64_t count,
+    const uint16_t* packet_ids, uint32_t n_ids,
+    uint64_t* timestamps, uint16_t* out_ids, uint8_t* units, int16_t* waveforms, uint64_t* n_out);
+
 // Spike sorting
 cbsdk_result_t cbsdk_session_set_spike_sorting(
     cbsdk_session_t session, uint32_t n_chans, const uint32_t* chans,
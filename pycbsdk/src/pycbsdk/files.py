@@ -0,0 +1,311 @@
+"""Read recorded NSx / ``.cbz`` and NEV files without loading them whole.
+
+Both readers wrap the memory-mapped C++ readers in ``cbsdk/file_reader.h``:
+opening a file maps it and builds a sparse timestamp index, and each read
+touches only the pages it needs.  Timestamps are in the file's
+``time_resolution`` ticks (nanoseconds for NSx/NEV 3.0, 1/30000 s for 2.x).
+
+Example::
+
+    from pycbsdk import ContinuousFile
+
+    with ContinuousFile("run1.ns6") as f:
+        data, ts = f.read(t0, t0 + 5 * f.time_resolution, channels=[1, 2, 3])
+        # data: (3, n_samples) int16, ts: (n_samples,) uint64
+"""
+
+from __future__ import annotations
+
+from dataclasses import dataclass
+from typing import Optional, Sequence
+
+from ._lib import ffi
+from .session import _check, _get_lib
+
+# Packets copied per C call when reading events, bounding the scratch memory a
+# selective read (few matching packet ids) can take
+_EVENT_BLOCK = 65536
+
+_UINT64_MAX = 0xFFFFFFFFFFFFFFFF
+
+
+def _id_array(ids: Optional[Sequence[int]]):
+    """cffi uint16 array and its length for an id filter (None: everything)."""
+    if not ids:
+        return ffi.NULL, 0
+    return ffi.new("uint16_t[]", list(ids)), len(ids)
+
+
+class _MappedRows:
+    """Exposes rows inside a mapping to numpy and keeps their file open."""
+
+    def __init__(self, owner, address: int, shape, strides):
+        self._owner = owner
+        self.__array_interface__ = {
+            "version": 3,
+            "data": (address, True),
+            "shape": shape,
+            "strides": strides,
+            "typestr": "<i2",
+        }
+
+
+class ContinuousFile:
+    """Memory-mapped reader of an NSx (2.2, 2.3, 3.0) or compressed ``.cbz`` file.
+
+    Arrays are shaped ``(n_channels, n_samples)`` like :class:`ContinuousReader`.
+
+    Args:
+        path: File to open; the format is detected from its header.
+
+    Attributes:
+        channel_ids: Channel (electrode) id of each column, in file order.
+        sample_count: Samples per channel in the file.
+        period: Sample period in 1/30000 s.
+        time_resolution: Timestamp ticks per second.
+        segment_count: Entries in the sparse timestamp index.
+        compressed: Whether the file is ``.cbz`` (no zero-copy :meth:`view`).
+    """
+
+    def __init__(self, path: str):
+        _lib = _get_lib()
+        handle = ffi.new("cbsdk_continuous_reader_t*")
+        _check(_lib.cbsdk_continuous_reader_open(str(path).encode(), handle), f"Failed to open {path}")
+        self._handle = handle[0]
+
+        info = ffi.new("cbsdk_continuous_file_info_t*")
+        _check(_lib.cbsdk_continuous_reader_get_info(self._handle, info), "Failed to get file info")
+        ids = ffi.new("uint16_t[]", max(info.channel_count, 1))
+        count = ffi.new("uint32_t*", info.channel_count)
+        _check(_lib.cbsdk_continuous_reader_get_channel_ids(self._handle, ids, count), "Failed to get channel ids")
+
+        self.channel_ids = [ids[i] for i in range(count[0])]
+        self.sample_count = info.sample_count
+        self.period = info.period
+        self.time_resolution = info.time_resolution
+        self.segment_count = info.segment_count
+        self.compressed = bool(info.compressed)
+
+    def close(self):
+        """Close the file.  Arrays returned by :meth:`view` become invalid."""
+        if self._handle is not None:
+            _get_lib().cbsdk_continuous_reader_close(self._handle)
+            self._handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        if getattr(self, "_handle", None) is not None:
+            self.close()
+
+    def _require_open(self):
+        if self._handle is None:
+            raise RuntimeError("File is closed")
+
+    def find_range(self, t0: int, t1: Optional[int] = None) -> tuple[int, int]:
+        """Samples whose timestamps fall in ``[t0, t1)``.
+
+        Returns:
+            ``(first, count)``.
+        """
+        self._require_open()
+        first = ffi.new("uint64_t*")
+        count = ffi.new("uint64_t*")
+        _check(
+            _get_lib().cbsdk_continuous_reader_find_range(
+                self._handle, t0, _UINT64_MAX if t1 is None else t1, first, count
+            ),
+            "Failed to find range",
+        )
+        return first[0], count[0]
+
+    def read_samples(self, first: int, count: int, channels: Optional[Sequence[int]] = None):
+        """Copy samples ``[first, first + count)`` of selected channels.
+
+        Args:
+            first: First sample index.
+            count: Number of samples.
+            channels: Channel ids in output order (default: every channel).
+
+        Returns:
+            ``(data, timestamps)``: ``(n_channels, count)`` int16 and ``(count,)`` uint64 arrays.
+        """
+        import numpy as np
+
+        self._require_open()
+        ids, n_ids = _id_array(channels)
+        n_cols = n_ids or len(self.channel_ids)
+        rows = np.empty((count, n_cols), dtype=np.int16)
+        ts = np.empty(count, dtype=np.uint64)
+        _check(
+            _get_lib().cbsdk_continuous_reader_read(
+                self._handle,
+                ids,
+                n_ids,
+                first,
+                count,
+                ffi.cast("int16_t*", ffi.from_buffer(rows)),
+                ffi.cast("uint64_t*", ffi.from_buffer(ts)),
+            ),
+            "Failed to read samples",
+        )
+        return rows.T, ts
+
+    def read(self, t0: int = 0, t1: Optional[int] = None, channels: Optional[Sequence[int]] = None):
+        """Copy the samples whose timestamps fall in ``[t0, t1)``.
+
+        Returns:
+            ``(data, timestamps)`` as for :meth:`read_samples`.
+        """
+        first, count = self.find_range(t0, t1)
+        return self.read_samples(first, count, channels)
+
+    def view(self, first: int, count: int):
+        """Zero-copy, read-only view of samples ``[first, first + count)``.
+
+        The samples must lie in one index segment (a whole NSx file of
+        single-sample packets usually is one), and the file must not be
+        compressed.  The view keeps the file open until it is released or
+        :meth:`close` is called.
+
+        Returns:
+            ``(n_channels, count)`` int16 array, all channels in file order.
+        """
+        import numpy as np
+
+        self._require_open()
+        data = ffi.new("const void**")
+        stride = ffi.new("size_t*")
+        _check(
+            _get_lib().cbsdk_continuous_reader_view(self._handle, first, count, data, stride),
+            "Failed to map samples (compressed file, or samples span index segments)",
+        )
+        address = int(ffi.cast("uintptr_t", data[0]))
+        shape = (len(self.channel_ids), count)
+        return np.asarray(_MappedRows(self, address, shape, (2, stride[0])))
+
+
+@dataclass
+class EventArrays:
+    """Events read from a NEV file, one entry per packet."""
+
+    timestamps: "np.ndarray"  # (n,) uint64
+    packet_ids: "np.ndarray"  # (n,) uint16: electrode id, 0 for digital input
+    units: "np.ndarray"  # (n,) uint8: sorted unit, or digital insertion reason
+    waveforms: "np.ndarray"  # (n, waveform_samples) int16; digital value in column 0
+
+
+class EventFile:
+    """Memory-mapped reader of a NEV (2.x, 3.0) file.
+
+    Args:
+        path: File to open.
+
+    Attributes:
+        packet_count: Complete packets in the file.
+        bytes_per_packet: Size of every packet.
+        time_resolution: Timestamp ticks per second.
+        waveform_samples: int16 words of payload per packet.
+    """
+
+    def __init__(self, path: str):
+        _lib = _get_lib()
+        handle = ffi.new("cbsdk_event_reader_t*")
+        _check(_lib.cbsdk_event_reader_open(str(path).encode(), handle), f"Failed to open {path}")
+        self._handle = handle[0]
+
+        info = ffi.new("cbsdk_event_file_info_t*")
+        _check(_lib.cbsdk_event_reader_get_info(self._handle, info), "Failed to get file info")
+        self.packet_count = info.packet_count
+        self.bytes_per_packet = info.bytes_per_packet
+        self.time_resolution = info.time_resolution
+        self.waveform_samples = info.waveform_samples
+
+    def close(self):
+        """Close the file."""
+        if self._handle is not None:
+            _get_lib().cbsdk_event_reader_close(self._handle)
+            self._handle = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        if getattr(self, "_handle", None) is not None:
+            self.close()
+
+    def find_range(self, t0: int, t1: Optional[int] = None) -> tuple[int, int]:
+        """Packets whose timestamps fall in ``[t0, t1)``.
+
+        Returns:
+            ``(first, count)``.
+        """
+        if self._handle is None:
+            raise RuntimeError("File is closed")
+        first = ffi.new("uint64_t*")
+        count = ffi.new("uint64_t*")
+        _check(
+            _get_lib().cbsdk_event_reader_find_range(
+                self._handle, t0, _UINT64_MAX if t1 is None else t1, first, count
+            ),
+            "Failed to find range",
+        )
+        return first[0], count[0]
+
+    def read(
+        self, t0: int = 0, t1: Optional[int] = None, packet_ids: Optional[Sequence[int]] = None
+    ) -> EventArrays:
+        """Copy the packets of ``[t0, t1)`` whose packet id is in ``packet_ids``.
+
+        Args:
+            t0: Start timestamp (inclusive).
+            t1: End timestamp (exclusive; default: end of file).
+            packet_ids: Electrode ids to keep, 0 for digital input (default: all).
+        """
+        import numpy as np
+
+        _lib = _get_lib()
+        first, count = self.find_range(t0, t1)
+        ids, n_ids = _id_array(packet_ids)
+        words = self.waveform_samples
+        block = min(count, _EVENT_BLOCK)
+        ts = np.empty(block, dtype=np.uint64)
+        pid = np.empty(block, dtype=np.uint16)
+        unit = np.empty(block, dtype=np.uint8)
+        wave = np.empty((block, words), dtype=np.int16)
+        n_out = ffi.new("uint64_t*")
+        parts = []
+        while count > 0:
+            n = min(count, block)
+            _check(
+                _lib.cbsdk_event_reader_read(
+                    self._handle,
+                    first,
+                    n,
+                    ids,
+                    n_ids,
+                    ffi.cast("uint64_t*", ffi.from_buffer(ts)),
+                    ffi.cast("uint16_t*", ffi.from_buffer(pid)),
+                    ffi.cast("uint8_t*", ffi.from_buffer(unit)),
+                    ffi.cast("int16_t*", ffi.from_buffer(wave)),
+                    n_out,
+                ),
+                "Failed to read packets",
+            )
+            k = n_out[0]
+            parts.append((ts[:k].copy(), pid[:k].copy(), unit[:k].copy(), wave[:k].copy()))
+            first += n
+            count -= n
+
+        if not parts:
+            return EventArrays(
+                np.empty(0, np.uint64), np.empty(0, np.uint16), np.empty(0, np.uint8), np.empty((0, words), np.int16)
+            )
+        return EventArrays(*(np.concatenate(column) for column in zip(*parts)))
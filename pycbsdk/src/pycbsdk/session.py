@@ -121,6 +121,28 @@ class ChanInfoField(enum.IntEnum):
     TERM = 12
 
 
+class ReferenceScheme(enum.IntEnum):
+    """Pools a re-referenced group subtracts (see :meth:`Session.rereferenced_group`).
+
+    Values match ``cbsdk_reference_scheme_t``.
+    """
+
+    COMMON = 0  # all front-end channels of the group
+    BANK = 1  # one pool per bank
+    HEADSTAGE = 2  # one pool per headstage of the loaded channel maps
+    ELECTRODE = 3  # each channel's own reference electrode (refelecchan)
+
+
+class ReferenceStatistic(enum.IntEnum):
+    """Statistic of a re-referencing pool.
+
+    Values match ``cbsdk_reference_statistic_t``.
+    """
+
+    MEAN = 0
+    MEDIAN = 1
+
+
 _RATE_HZ = {
     SampleRate.NONE: 0,
     SampleRate.SR_500: 500,
@@ -205,6 +227,86 @@ class Stats:
     send_errors: int = 0
 
 
+@dataclass
+class LatencySummary:
+    """Latency percentiles of one pipeline stage, in nanoseconds."""
+
+    count: int = 0
+    min_ns: int = 0
+    p50_ns: int = 0
+    p90_ns: int = 0
+    p99_ns: int = 0
+    p999_ns: int = 0
+    max_ns: int = 0
+    mean_ns: float = 0.0
+
+
+@dataclass
+class LatencyStats:
+    """Per-stage latency of sampled data packets (STANDALONE mode only).
+
+    ``device_to_arrival`` and ``device_to_callback`` start at the device
+    timestamp and stay empty until clock sync has an offset.
+    """
+
+    device_to_arrival: LatencySummary
+    arrival_to_store: LatencySummary
+    store_to_dequeue: LatencySummary
+    dequeue_to_callback: LatencySummary
+    device_to_callback: LatencySummary
+
+
+@dataclass
+class RecordingStats:
+    """Counters of a local NSx/NEV recording."""
+
+    continuous_packets: int = 0
+    spike_packets: int = 0
+    digital_packets: int = 0
+    bytes_written: int = 0
+    packets_dropped: int = 0
+    write_errors: int = 0
+    pending_bytes: int = 0
+    direct_io: bool = False
+
+
+@dataclass
+class SpikeBinningStats:
+    """Counters of spike binning (see :meth:`Session.start_spike_binning`)."""
+
+    spikes_counted: int = 0
+    spikes_late: int = 0
+    spikes_ignored: int = 0
+    bins_closed: int = 0
+    bins_skipped: int = 0
+    bins_overwritten: int = 0
+
+
+@dataclass
+class DigitalInputStats:
+    """Counters of digital input tracking.
+
+    See :meth:`Session.start_digital_input_tracking`.
+    """
+
+    events: int = 0
+    edges_rising: int = 0
+    edges_falling: int = 0
+
+
+@dataclass
+class SpikeSortingStats:
+    """Counters of host spike sorting.
+
+    See :meth:`Session.start_spike_sorting`.
+    """
+
+    spikes_sorted: int = 0
+    spikes_noise: int = 0
+    spikes_unsorted: int = 0
+    spikes_unmodelled: int = 0
+
+
 class Session:
     """CereLink SDK session.
 
@@ -254,6 +356,8 @@ class Session:
         self._handles: list[int] = []
         # prevent Python callback pointers from being garbage collected
         self._callback_refs: list = []
+        self._spike_bin_shape: Optional[tuple[int, int, int]] = None
+        self._digital_cursor = 0
         self._lock = threading.Lock()
         self._closed = False
         # Calibrate monotonic ↔ steady_clock offset for device_to_monotonic().
@@ -337,7 +441,16 @@ class Session:
 
         return decorator
 
-    def on_group_batch(self, rate: SampleRate = SampleRate.SR_30kHz) -> Callable:
+    def on_group_batch(
+        self,
+        rate: SampleRate = SampleRate.SR_30kHz,
+        channels=None,
+        channel_major: bool = False,
+        microvolts: bool = False,
+        min_samples: int = 0,
+        max_samples: int = 0,
+        max_delay: Optional[float] = None,
+    ) -> Callable:
         """Decorator to register a *batch* callback for continuous sample group packets.
 
         Instead of calling the function once per sample (~30,000/s at 30 kHz), the
@@ -353,17 +466,116 @@ class Session:
 
         Args:
             rate: Sample rate to subscribe to.
+            channels: 1-based channel IDs of the group to receive, in column
+                order (None: every channel).  Only these columns are copied
+                out of each packet, so a subscriber watching a few channels
+                of a large group stays cheap.  They are looked up in the
+                group when registering.
+            channel_major: If True, ``samples`` has shape
+                ``(n_channels, n_samples)``, each channel's samples contiguous.
+                The SDK transposes the batch before the callback.
+            microvolts: If True, ``samples`` is ``float32`` in physical units
+                (µV for voltages), scaled with each channel's input scaling
+                as read when registering.  Register again after changing it.
+            min_samples: Hold samples in the SDK until this many are buffered
+                (0: deliver whatever one queue drain produced).
+            max_samples: Split larger blocks (0: no limit).  ``max_samples=1``
+                delivers every sample as soon as it arrives;
+                ``min_samples=max_samples=N`` delivers blocks of exactly N.
+            max_delay: Seconds a short block may wait for ``min_samples``
+                before it is delivered anyway (None: no limit; needs
+                ``min_samples`` of at least 2).
 
         Example::
 
-            @session.on_group_batch(SampleRate.SR_RAW)
+            @session.on_group_batch(SampleRate.SR_RAW, channel_major=True)
             def on_batch(samples, timestamps):
-                ring_buf[:, pos:pos+len(timestamps)] = samples.T
+                ring_buf[:, pos:pos+len(timestamps)] = samples
         """
         rate = _coerce_enum(SampleRate, rate, _RATE_ALIASES)
+        policy = self._batch_policy(min_samples, max_samples, max_delay)
 
         def decorator(fn):
-            self._register_group_batch_callback(int(rate), fn)
+            self._register_group_batch_callback(
+                int(rate),
+                fn,
+                channels=channels,
+                channel_major=channel_major,
+                microvolts=microvolts,
+                policy=policy,
+            )
+            return fn
+
+        return decorator
+
+    def on_filtered_group_batch(
+        self,
+        rate: SampleRate = SampleRate.SR_30kHz,
+        highpass: Optional[float] = None,
+        highpass_order: int = 2,
+        lowpass: Optional[float] = None,
+        lowpass_order: int = 4,
+        notch: Optional[float] = None,
+        notch_bandwidth: float = 2.0,
+        channels=None,
+        channel_major: bool = False,
+        microvolts: bool = False,
+        min_samples: int = 0,
+        max_samples: int = 0,
+        max_delay: Optional[float] = None,
+    ) -> Callable:
+        """Decorator like :meth:`on_group_batch`, but the samples are filtered first.
+
+        The SDK designs a Butterworth high-pass and/or low-pass (the filter
+        types the device reports in ``cbPKT_FILTINFO``) and an optional notch
+        for the group's sample rate, and runs them on every channel of each
+        batch before the callback.  Filter state carries over between batches,
+        so the callback sees one continuous filtered stream.  Filtered samples
+        are rounded to ``int16``.
+
+        Args:
+            rate: Sample rate to subscribe to.
+            highpass: High-pass corner in Hz (None: no high-pass).
+            highpass_order: High-pass order (1-16).
+            lowpass: Low-pass corner in Hz (None: no low-pass).
+            lowpass_order: Low-pass order (1-16).
+            notch: Notch centre in Hz, e.g. 60 (None: no notch).
+            notch_bandwidth: Notch width in Hz.
+            channels: 1-based channel IDs to receive and filter (None: every
+                channel of the group); see :meth:`on_group_batch`.
+            channel_major: Deliver ``(n_channels, n_samples)``; see
+                :meth:`on_group_batch`.
+            microvolts: Deliver ``float32`` physical units, scaled after
+                filtering; see :meth:`on_group_batch`.
+            min_samples: Samples to buffer before delivering; see
+                :meth:`on_group_batch`.
+            max_samples: Largest block delivered (0: no limit).
+            max_delay: Seconds a short block may wait (None: no limit).
+
+        Example::
+
+            @session.on_filtered_group_batch(SampleRate.SR_RAW, highpass=250, notch=60)
+            def on_spike_band(samples, timestamps):
+                ...
+        """
+        rate = _coerce_enum(SampleRate, rate, _RATE_ALIASES)
+        spec = ffi.new("cbsdk_filter_spec_t*")
+        if highpass:
+            spec.hpfreq = round(highpass * 1000)
+            spec.hporder = highpass_order
+        if lowpass:
+            spec.lpfreq = round(lowpass * 1000)
+            spec.lporder = lowpass_order
+        if notch:
+            spec.notch_freq = round(notch * 1000)
+            spec.notch_bandwidth = round(notch_bandwidth * 1000)
+
+        policy = self._batch_policy(min_samples, max_samples, max_delay)
+
+        def decorator(fn):
+            self._register_group_batch_callback(
+                int(rate), fn, spec, channels, channel_major, microvolts, policy
+            )
             return fn
 
         return decorator
@@ -472,31 +684,112 @@ class Session:
         self._handles.append(handle)
         self._callback_refs.append(c_group_cb)
 
-    def _register_group_batch_callback(self, rate: int, fn):
+    @staticmethod
+    def _batch_policy(min_samples=0, max_samples=0, max_delay=None):
+        """``cbsdk_batch_policy_t*`` for the batching arguments, or None if unset."""
+        if not min_samples and not max_samples:
+            return None
+        if max_samples and max_samples < min_samples:
+            raise ValueError("max_samples must be at least min_samples")
+        policy = ffi.new("cbsdk_batch_policy_t*")
+        policy.min_samples = int(min_samples)
+        policy.max_samples = int(max_samples)
+        if max_delay:
+            policy.max_delay_us = round(max_delay * 1e6)
+        return policy
+
+    @staticmethod
+    def _batch_callback(fn, channel_major=False, scaled=False):
+        """cffi batch callback handing ``fn`` copies of ``(samples, timestamps)``.
+
+        ``samples`` is shaped for the layout the callback was registered with:
+        ``(n_channels, n_samples)`` if ``channel_major``, else
+        ``(n_samples, n_channels)``; ``float32`` if ``scaled``, else ``int16``.
+        """
         import numpy as np
 
-        _lib = _get_lib()
+        dtype = np.float32 if scaled else np.int16
+        ctype = "float" if scaled else "int16_t"
 
-        @ffi.callback("void(const int16_t*, size_t, size_t, const uint64_t*, void*)")
+        @ffi.callback(f"void(const {ctype}*, size_t, size_t, const uint64_t*, void*)")
         def c_batch_cb(samples_ptr, n_samples, n_channels, ts_ptr, user_data):
             try:
-                sbuf = ffi.buffer(samples_ptr, n_samples * n_channels * 2)
-                arr = (
-                    np.frombuffer(sbuf, dtype=np.int16)
-                    .reshape(n_samples, n_channels)
-                    .copy()
+                if channel_major:
+                    shape = (n_channels, n_samples)
+                else:
+                    shape = (n_samples, n_channels)
+                sbuf = ffi.buffer(
+                    samples_ptr, n_samples * n_channels * np.dtype(dtype).itemsize
                 )
+                arr = np.frombuffer(sbuf, dtype=dtype).reshape(shape).copy()
                 tbuf = ffi.buffer(ts_ptr, n_samples * 8)
                 ts = np.frombuffer(tbuf, dtype=np.uint64).copy()
                 fn(arr, ts)
             except Exception:
                 pass  # Never let exceptions propagate into C
 
-        handle = _lib.cbsdk_session_register_group_batch_callback(
-            self._session, rate, c_batch_cb, ffi.NULL
-        )
+        return c_batch_cb
+
+    def _register_group_batch_callback(
+        self,
+        rate: int,
+        fn,
+        spec=None,
+        channels=None,
+        channel_major=False,
+        microvolts=False,
+        policy=None,
+    ):
+        _lib = _get_lib()
+        c_batch_cb = self._batch_callback(fn, channel_major, microvolts)
+
+        if channel_major or microvolts or policy is not None:
+            chan_ids = (
+                ffi.new("uint32_t[]", [int(c) for c in channels])
+                if channels is not None
+                else ffi.NULL
+            )
+            register = (
+                _lib.cbsdk_session_register_scaled_group_batch_callback
+                if microvolts
+                else _lib.cbsdk_session_register_formatted_group_batch_callback
+            )
+            handle = register(
+                self._session,
+                rate,
+                chan_ids,
+                len(channels) if channels is not None else 0,
+                spec if spec is not None else ffi.NULL,
+                _lib.CBSDK_CHANNEL_MAJOR if channel_major else _lib.CBSDK_SAMPLE_MAJOR,
+                policy if policy is not None else ffi.NULL,
+                c_batch_cb,
+                ffi.NULL,
+            )
+        elif channels is not None:
+            chan_ids = ffi.new("uint32_t[]", [int(c) for c in channels])
+            handle = _lib.cbsdk_session_register_channel_group_batch_callback(
+                self._session,
+                rate,
+                chan_ids,
+                len(chan_ids),
+                spec if spec is not None else ffi.NULL,
+                c_batch_cb,
+                ffi.NULL,
+            )
+        elif spec is None:
+            handle = _lib.cbsdk_session_register_group_batch_callback(
+                self._session, rate, c_batch_cb, ffi.NULL
+            )
+        else:
+            handle = _lib.cbsdk_session_register_filtered_group_batch_callback(
+                self._session, rate, spec, c_batch_cb, ffi.NULL
+            )
         if handle == 0:
-            raise RuntimeError("Failed to register group batch callback")
+            raise RuntimeError(
+                "Failed to register group batch callback"
+                + (" (invalid filter design?)" if spec is not None else "")
+                + (" (channel not in the group?)" if channels is not None else "")
+            )
         self._handles.append(handle)
         self._callback_refs.append(c_batch_cb)
 
@@ -586,8 +879,35 @@ class Session:
             send_errors=c_stats.send_errors,
         )
 
+    @property
+    def latency_stats(self) -> LatencyStats:
+        """Get per-stage latency percentiles of sampled data packets."""
+        _lib = _get_lib()
+        c_stats = ffi.new("cbsdk_latency_stats_t *")
+        _lib.cbsdk_session_get_latency_stats(self._session, c_stats)
+
+        def summary(c) -> LatencySummary:
+            return LatencySummary(
+                count=c.count,
+                min_ns=c.min_ns,
+                p50_ns=c.p50_ns,
+                p90_ns=c.p90_ns,
+                p99_ns=c.p99_ns,
+                p999_ns=c.p999_ns,
+                max_ns=c.max_ns,
+                mean_ns=c.mean_ns,
+            )
+
+        return LatencyStats(
+            device_to_arrival=summary(c_stats.device_to_arrival),
+            arrival_to_store=summary(c_stats.arrival_to_store),
+            store_to_dequeue=summary(c_stats.store_to_dequeue),
+            dequeue_to_callback=summary(c_stats.dequeue_to_callback),
+            device_to_callback=summary(c_stats.device_to_callback),
+        )
+
     def reset_stats(self):
-        """Reset statistics counters to zero."""
+        """Reset statistics counters and latency histograms to zero."""
         _get_lib().cbsdk_session_reset_stats(self._session)
 
     # --- Configuration Access ---
@@ -1527,6 +1847,53 @@ class Session:
             "Failed to close Central file dialog",
         )
 
+    # --- Local Recording ---
+
+    def start_recording(self, base_path: str, comment: str = ""):
+        """Record continuous groups and spike/digital events to NSx/NEV files.
+
+        Writes ``<base_path>.nev`` and one ``<base_path>.ns<group>`` per
+        sample group with channels, from a dedicated writer thread in this
+        process.  Does not need Central.
+
+        Args:
+            base_path: Output path without extension.
+            comment: Comment stored in the file headers.
+        """
+        _check(
+            _get_lib().cbsdk_session_start_recording(
+                self._session,
+                base_path.encode(),
+                comment.encode() if comment else ffi.NULL,
+            ),
+            "Failed to start recording",
+        )
+
+    def stop_recording(self):
+        """Write out everything queued and close the recording files."""
+        _get_lib().cbsdk_session_stop_recording(self._session)
+
+    @property
+    def is_recording(self) -> bool:
+        """Whether a local recording is running."""
+        return bool(_get_lib().cbsdk_session_is_recording(self._session))
+
+    @property
+    def recording_stats(self) -> RecordingStats:
+        """Counters of the running recording, or of the last one once stopped."""
+        c_stats = ffi.new("cbsdk_recording_stats_t *")
+        _get_lib().cbsdk_session_get_recording_stats(self._session, c_stats)
+        return RecordingStats(
+            continuous_packets=c_stats.continuous_packets,
+            spike_packets=c_stats.spike_packets,
+            digital_packets=c_stats.digital_packets,
+            bytes_written=c_stats.bytes_written,
+            packets_dropped=c_stats.packets_dropped,
+            write_errors=c_stats.write_errors,
+            pending_bytes=c_stats.pending_bytes,
+            direct_io=bool(c_stats.direct_io),
+        )
+
     # --- Spike Sorting ---
 
     def set_spike_sorting(
@@ -1615,6 +1982,481 @@ class Session:
             "Failed to set spike extraction",
         )
 
+    # --- Host Spike Detection ---
+
+    @staticmethod
+    def _spike_threshold(c_threshold, level, rms_multiplier):
+        """Fill a ``cbsdk_spike_threshold_t`` (both None: detection off)."""
+        if level is not None and rms_multiplier is not None:
+            raise ValueError("Give either level or rms_multiplier, not both")
+        if level is not None:
+            c_threshold.mode = _get_lib().CBSDK_THRESHOLD_LEVEL
+            c_threshold.level = int(level)
+        elif rms_multiplier is not None:
+            c_threshold.mode = _get_lib().CBSDK_THRESHOLD_RMS
+            c_threshold.rms_multiplier = float(rms_multiplier)
+        else:
+            c_threshold.mode = _get_lib().CBSDK_THRESHOLD_OFF
+
+    def start_spike_detection(
+        self,
+        rate: SampleRate = SampleRate.SR_RAW,
+        rms_multiplier: Optional[float] = -4.5,
+        level: Optional[int] = None,
+        highpass: Optional[float] = 250.0,
+        highpass_order: int = 4,
+        refractory_ms: float = 1.0,
+        rms_seconds: float = 1.0,
+    ):
+        """Detect spikes on the host instead of the device.
+
+        The SDK high-pass filters the group's samples and looks for threshold
+        crossings on its callback thread, cutting waveforms with the device's
+        spike length and pretrigger.  Spikes arrive as unsorted spike packets
+        through :meth:`on_event`, like the device's; turn device extraction
+        off (:meth:`set_spike_extraction`) to avoid receiving both.  Replaces
+        any detection already running.
+
+        Args:
+            rate: Group to detect on.
+            rms_multiplier: Initial threshold of every front-end channel as a
+                multiple of its running RMS; negative detects downward
+                crossings.  RMS thresholds arm after *rms_seconds*.
+            level: Fixed initial threshold in raw units instead.
+            highpass: High-pass corner in Hz applied first (None: no filter).
+            highpass_order: High-pass order (1-16).
+            refractory_ms: Minimum time between spikes on a channel.
+            rms_seconds: Time the RMS estimate averages over.
+        """
+        rate = _coerce_enum(SampleRate, rate, _RATE_ALIASES)
+        config = _get_lib().cbsdk_spike_detection_config_default()
+        config.source = int(rate)
+        config.filter.hpfreq = round(highpass * 1000) if highpass else 0
+        config.filter.hporder = highpass_order if highpass else 0
+        self._spike_threshold(config.threshold, level, rms_multiplier)
+        config.refractory_samples = round(refractory_ms * rate.hz / 1000)
+        config.rms_window = max(1, round(rms_seconds * rate.hz))
+        _check(
+            _get_lib().cbsdk_session_start_spike_detection(
+                self._session, ffi.new("cbsdk_spike_detection_config_t*", config)
+            ),
+            "Failed to start spike detection",
+        )
+
+    def stop_spike_detection(self):
+        """Stop host spike detection."""
+        _get_lib().cbsdk_session_stop_spike_detection(self._session)
+
+    @property
+    def is_spike_detection_running(self) -> bool:
+        """Whether host spike detection is running."""
+        return bool(_get_lib().cbsdk_session_is_spike_detection_running(self._session))
+
+    def set_spike_detection_threshold(
+        self,
+        chan_id: int,
+        rms_multiplier: Optional[float] = None,
+        level: Optional[int] = None,
+    ):
+        """Change the host detection threshold of one channel.
+
+        Args:
+            chan_id: 1-based channel ID in the detected group.
+            rms_multiplier: Threshold as a multiple of the channel's RMS.
+            level: Fixed threshold in raw units.  With neither given,
+                detection on the channel is turned off.
+        """
+        threshold = ffi.new("cbsdk_spike_threshold_t*")
+        self._spike_threshold(threshold, level, rms_multiplier)
+        _check(
+            _get_lib().cbsdk_session_set_spike_detection_threshold(
+                self._session, chan_id, threshold
+            ),
+            "Failed to set spike detection threshold",
+        )
+
+    def spike_detection_level(self, chan_id: int) -> int:
+        """Level a channel is currently compared against (0 while off or arming).
+
+        Args:
+            chan_id: 1-based channel ID in the detected group.
+        """
+        level = ffi.new("int16_t*")
+        _check(
+            _get_lib().cbsdk_session_get_spike_detection_level(
+                self._session, chan_id, level
+            ),
+            "Failed to get spike detection level",
+        )
+        return level[0]
+
+    # --- Spike Binning ---
+
+    def start_spike_binning(
+        self,
+        bin_ms: float = 20.0,
+        latency_ms: float = 10.0,
+        n_channels: int = 272,
+        n_units: int = 6,
+        history_bins: int = 500,
+    ):
+        """Count spikes per channel and unit in bins of device time.
+
+        Every spike the session receives, device-extracted or host-detected,
+        is counted into the bin its timestamp falls in; bins are aligned to
+        the device clock.  A bin closes once device time has passed its end
+        by *latency_ms*, then goes to :meth:`on_spike_bins` callbacks and to
+        :meth:`read_spike_bins`.  Replaces any binning already running.
+
+        Args:
+            bin_ms: Bin width.
+            latency_ms: How long after its end a bin still accepts late spikes.
+            n_channels: Matrix rows: channel IDs 1..n_channels.
+            n_units: Matrix columns: unit 0 (unsorted) .. n_units - 1.
+            history_bins: Closed bins kept for :meth:`read_spike_bins`.
+        """
+        config = _get_lib().cbsdk_spike_binning_config_default()
+        config.bin_width = round(bin_ms * 1_000_000)
+        config.latency = round(latency_ms * 1_000_000)
+        config.channel_count = n_channels
+        config.unit_count = n_units
+        config.buffer_bins = history_bins
+        _check(
+            _get_lib().cbsdk_session_start_spike_binning(
+                self._session, ffi.new("cbsdk_spike_binning_config_t*", config)
+            ),
+            "Failed to start spike binning",
+        )
+        self._spike_bin_shape = (history_bins, n_channels, n_units)
+
+    def stop_spike_binning(self):
+        """Stop spike binning and drop its bins."""
+        _get_lib().cbsdk_session_stop_spike_binning(self._session)
+        self._spike_bin_shape = None
+
+    @property
+    def is_spike_binning_running(self) -> bool:
+        """Whether spike binning is running."""
+        return bool(_get_lib().cbsdk_session_is_spike_binning_running(self._session))
+
+    def on_spike_bins(self) -> Callable:
+        """Decorator to register a callback for every closed spike bin.
+
+        The callback receives ``(start_time, counts)`` where ``start_time``
+        is the device time the bin starts at and ``counts`` is a ``uint32``
+        array of shape ``(n_channels, n_units)`` (row = channel ID - 1),
+        owned by the callee.
+
+        Example::
+
+            @session.on_spike_bins()
+            def on_bin(start_time, counts):
+                decoder.step(counts.sum(axis=1))
+        """
+        import numpy as np
+
+        def decorator(fn):
+            _lib = _get_lib()
+
+            @ffi.callback("void(uint64_t, const uint32_t*, size_t, size_t, void*)")
+            def c_bin_cb(start_time, counts_ptr, n_channels, n_units, user_data):
+                try:
+                    buf = ffi.buffer(counts_ptr, n_channels * n_units * 4)
+                    counts = (
+                        np.frombuffer(buf, dtype=np.uint32)
+                        .reshape(n_channels, n_units)
+                        .copy()
+                    )
+                    fn(int(start_time), counts)
+                except Exception:
+                    pass  # Never let exceptions propagate into C
+
+            handle = _lib.cbsdk_session_register_spike_bin_callback(
+                self._session, c_bin_cb, ffi.NULL
+            )
+            if handle == 0:
+                raise RuntimeError("Failed to register spike bin callback")
+            self._handles.append(handle)
+            self._callback_refs.append(c_bin_cb)
+            return fn
+
+        return decorator
+
+    def read_spike_bins(self, max_bins: Optional[int] = None):
+        """Move the oldest closed bins out of the binning history.
+
+        Args:
+            max_bins: Most bins to read (default: the whole history).
+
+        Returns:
+            ``(counts, start_times)``: a ``uint32`` array of shape
+            ``(n_bins, n_channels, n_units)`` and a ``uint64`` array of
+            shape ``(n_bins,)``.
+        """
+        import numpy as np
+
+        if self._spike_bin_shape is None:
+            raise RuntimeError("Spike binning is not running")
+        history, n_channels, n_units = self._spike_bin_shape
+        n = history if max_bins is None else min(max_bins, history)
+        counts = np.empty((n, n_channels, n_units), dtype=np.uint32)
+        starts = np.empty(n, dtype=np.uint64)
+        n_bins = ffi.new("uint32_t*", n)
+        _check(
+            _get_lib().cbsdk_session_read_spike_bins(
+                self._session,
+                ffi.cast("uint32_t*", ffi.from_buffer(counts)),
+                ffi.cast("uint64_t*", ffi.from_buffer(starts)),
+                n_bins,
+            ),
+            "Failed to read spike bins",
+        )
+        return counts[: n_bins[0]], starts[: n_bins[0]]
+
+    @property
+    def spike_binning_stats(self) -> SpikeBinningStats:
+        """Counters of the running spike binning."""
+        c_stats = ffi.new("cbsdk_spike_binning_stats_t *")
+        _check(
+            _get_lib().cbsdk_session_get_spike_binning_stats(self._session, c_stats),
+            "Failed to get spike binning stats",
+        )
+        return SpikeBinningStats(
+            spikes_counted=c_stats.spikes_counted,
+            spikes_late=c_stats.spikes_late,
+            spikes_ignored=c_stats.spikes_ignored,
+            bins_closed=c_stats.bins_closed,
+            bins_skipped=c_stats.bins_skipped,
+            bins_overwritten=c_stats.bins_overwritten,
+        )
+
+    # --- Digital Input Tracking ---
+
+    DIGITAL_INPUT_DTYPE = [
+        ("time", "<u8"),
+        ("chan_id", "<u4"),
+        ("value", "<u4"),
+        ("rising", "<u4"),
+        ("falling", "<u4"),
+    ]
+
+    def start_digital_input_tracking(self, buffer_events: int = 65536):
+        """Log digital and serial input packets with the bits that rose and fell.
+
+        Every input packet is decoded against its channel's previous word
+        (all channels start at 0) and logged in a ring of *buffer_events*
+        events, so a task controller can poll :meth:`read_digital_inputs`
+        and :meth:`digital_input_state` at a high rate instead of taking a
+        Python callback per packet.  Replaces any tracking already running.
+
+        Args:
+            buffer_events: Events the log holds.
+        """
+        _check(
+            _get_lib().cbsdk_session_start_digital_input_tracking(
+                self._session, buffer_events
+            ),
+            "Failed to start digital input tracking",
+        )
+        self._digital_cursor = 0
+
+    def stop_digital_input_tracking(self):
+        """Stop digital input tracking and drop its log."""
+        _get_lib().cbsdk_session_stop_digital_input_tracking(self._session)
+
+    @property
+    def is_digital_input_tracking_running(self) -> bool:
+        """Whether digital input tracking is running."""
+        return bool(
+            _get_lib().cbsdk_session_is_digital_input_tracking_running(self._session)
+        )
+
+    def read_digital_inputs(self, max_events: int = 4096):
+        """Read the input events logged since the previous call.
+
+        Args:
+            max_events: Most events to read.
+
+        Returns:
+            ``(events, skipped)``: a structured array with fields ``time``,
+            ``chan_id``, ``value``, ``rising`` and ``falling`` (oldest
+            first), and the number of events overwritten before they could
+            be read.
+        """
+        import numpy as np
+
+        events = np.empty(max_events, dtype=self.DIGITAL_INPUT_DTYPE)
+        cursor = ffi.new("uint64_t*", self._digital_cursor)
+        n_events = ffi.new("uint32_t*", max_events)
+        skipped = ffi.new("uint64_t*")
+        _check(
+            _get_lib().cbsdk_session_read_digital_input_events(
+                self._session,
+                cursor,
+                ffi.cast("cbsdk_digital_input_event_t*", ffi.from_buffer(events)),
+                n_events,
+                skipped,
+            ),
+            "Failed to read digital input events",
+        )
+        self._digital_cursor = cursor[0]
+        return events[: n_events[0]], int(skipped[0])
+
+    def digital_input_state(self, chan_id: int, times):
+        """Word of an input channel at each of *times* (device time).
+
+        A time before the oldest event still logged reads the word from
+        before that event.
+
+        Args:
+            chan_id: 1-based channel ID of a digital or serial input.
+            times: Device times (sequence or array of ``uint64``).
+
+        Returns:
+            ``uint32`` array with one word per time.
+        """
+        import numpy as np
+
+        times = np.ascontiguousarray(times, dtype=np.uint64)
+        values = np.empty(times.shape, dtype=np.uint32)
+        _check(
+            _get_lib().cbsdk_session_get_digital_input_state(
+                self._session,
+                chan_id,
+                ffi.cast("const uint64_t*", ffi.from_buffer(times)),
+                times.size,
+                ffi.cast("uint32_t*", ffi.from_buffer(values)),
+                ffi.NULL,
+            ),
+            "Failed to get digital input state",
+        )
+        return values
+
+    def digital_input_word(self, chan_id: int) -> int:
+        """Current word of an input channel (0 if it has sent nothing)."""
+        value = ffi.new("uint32_t*")
+        _check(
+            _get_lib().cbsdk_session_get_digital_input_word(
+                self._session, chan_id, value
+            ),
+            "Failed to get digital input word",
+        )
+        return int(value[0])
+
+    @property
+    def digital_input_stats(self) -> DigitalInputStats:
+        """Counters of the running digital input tracking."""
+        c_stats = ffi.new("cbsdk_digital_input_stats_t *")
+        _check(
+            _get_lib().cbsdk_session_get_digital_input_stats(self._session, c_stats),
+            "Failed to get digital input stats",
+        )
+        return DigitalInputStats(
+            events=c_stats.events,
+            edges_rising=c_stats.edges_rising,
+            edges_falling=c_stats.edges_falling,
+        )
+
+    def start_spike_sorting(
+        self, gate: float = 9.21, threads: int = 0, device_spikes: bool = True
+    ):
+        """Sort spikes on the host with the device's sort models.
+
+        Each host-detected spike, and each device spike that arrives
+        unsorted, is projected onto its channel's PCA basis and assigned a
+        unit with the channel's unit models and noise boundary before the
+        callbacks run, so callbacks, spike bins and epochs see sorted units
+        (``header.type``) and feature patterns (``fPattern``).  Models follow
+        the ones the device sends; :meth:`set_spike_sort_model` overrides a
+        channel.  Replaces any sorting already running.
+
+        Args:
+            gate: Largest squared Mahalanobis distance to a unit's centre.
+            threads: Worker threads for large bursts of spikes (0: sort on
+                the callback thread).
+            device_spikes: Also sort unsorted device-extracted spikes.
+        """
+        config = _get_lib().cbsdk_spike_sorting_config_default()
+        config.gate = gate
+        config.threads = threads
+        config.device_spikes = device_spikes
+        _check(
+            _get_lib().cbsdk_session_start_spike_sorting(
+                self._session, ffi.new("cbsdk_spike_sorting_config_t*", config)
+            ),
+            "Failed to start spike sorting",
+        )
+
+    def stop_spike_sorting(self):
+        """Stop host spike sorting."""
+        _get_lib().cbsdk_session_stop_spike_sorting(self._session)
+
+    @property
+    def is_spike_sorting_running(self) -> bool:
+        """Whether host spike sorting is running."""
+        return bool(_get_lib().cbsdk_session_is_spike_sorting_running(self._session))
+
+    def set_spike_sort_model(
+        self, chan_id: int, basis, units=(), noise_center=None, noise_axes=None
+    ):
+        """Replace the sort model of one channel until the device sends a new one.
+
+        Args:
+            chan_id: 1-based channel ID.
+            basis: ``(n_points, 3)`` PCA basis, *n_points* at least the spike
+                length.
+            units: Clusters as ``(unit, mean, inv_covariance,
+                log_determinant)`` tuples: unit 1-5 (or 255 for noise), a
+                2-vector and a 2x2 matrix over the first two components.
+            noise_center: Centre of the noise ellipsoid (``None``: no noise
+                boundary).
+            noise_axes: ``(3, 3)`` semi-axes of the noise ellipsoid, one per
+                row.
+        """
+        import numpy as np
+
+        basis = np.ascontiguousarray(basis, dtype=np.float32).reshape(-1, 3)
+        c_units = ffi.new("cbsdk_sort_unit_t[]", max(len(units), 1))
+        for i, (unit, mean, inv_covariance, log_determinant) in enumerate(units):
+            c_units[i].unit = unit
+            c_units[i].mean = [float(m) for m in mean]
+            inv = np.asarray(inv_covariance, dtype=np.float32)
+            c_units[i].inv_covariance = [[float(v) for v in row] for row in inv]
+            c_units[i].log_determinant = log_determinant
+        center = axes = ffi.NULL
+        if noise_center is not None:
+            center = ffi.new("float[3]", [float(v) for v in noise_center])
+            axes_array = np.asarray(noise_axes, dtype=np.float32).reshape(9)
+            axes = ffi.new("float[9]", [float(v) for v in axes_array])
+        _check(
+            _get_lib().cbsdk_session_set_spike_sort_model(
+                self._session,
+                chan_id,
+                ffi.cast("const float*", ffi.from_buffer(basis)),
+                basis.shape[0],
+                c_units,
+                len(units),
+                center,
+                axes,
+            ),
+            "Failed to set spike sort model",
+        )
+
+    @property
+    def spike_sorting_stats(self) -> SpikeSortingStats:
+        """Counters of the running host spike sorting."""
+        c_stats = ffi.new("cbsdk_spike_sorting_stats_t *")
+        _check(
+            _get_lib().cbsdk_session_get_spike_sorting_stats(self._session, c_stats),
+            "Failed to get spike sorting stats",
+        )
+        return SpikeSortingStats(
+            spikes_sorted=c_stats.spikes_sorted,
+            spikes_noise=c_stats.spikes_noise,
+            spikes_unsorted=c_stats.spikes_unsorted,
+            spikes_unmodelled=c_stats.spikes_unmodelled,
+        )
+
     # --- Clock Synchronization ---
 
     # Re-measure the monotonic↔steady offset when the two clocks drift.  A cheap
@@ -1846,6 +2688,204 @@ class Session:
         buffer_samples = int(buffer_seconds * rate.hz)
         return ContinuousReader(self, rate, n_channels, buffer_samples)
 
+    def resampled_group(
+        self,
+        rate: SampleRate = SampleRate.SR_RAW,
+        up: int = 1,
+        down: int = 30,
+        buffer_seconds: float = 10.0,
+    ) -> VirtualGroup:
+        """Create a virtual sample group at ``up / down`` times the rate of *rate*.
+
+        The SDK low-passes and resamples the group with a polyphase FIR on its
+        callback thread, so only the reduced stream crosses into Python: the
+        default turns the 30 kHz raw group into 1 kHz.  Its samples collect in
+        a ring buffer (see :meth:`VirtualGroup.read`) and can also be
+        delivered to batch callbacks (:meth:`VirtualGroup.on_batch`).
+
+        Args:
+            rate: Group to resample.
+            up: Interpolation factor (1-256).
+            down: Decimation factor (1-256).
+            buffer_seconds: Ring buffer duration in seconds at the output rate.
+
+        Returns:
+            A :class:`VirtualGroup` instance.
+        """
+        rate = _coerce_enum(SampleRate, rate, _RATE_ALIASES)
+        buffer_samples = int(buffer_seconds * rate.hz * up / down)
+        group = ffi.new("uint32_t*")
+        _check(
+            _get_lib().cbsdk_session_create_resampled_group(
+                self._session, int(rate), up, down, buffer_samples, group
+            ),
+            "Failed to create resampled group",
+        )
+        return VirtualGroup(self, group[0], buffer_samples)
+
+    def rereferenced_group(
+        self,
+        rate: SampleRate = SampleRate.SR_RAW,
+        scheme: ReferenceScheme = ReferenceScheme.COMMON,
+        statistic: ReferenceStatistic = ReferenceStatistic.MEAN,
+        buffer_seconds: float = 10.0,
+    ) -> VirtualGroup:
+        """Create a virtual sample group that is *rate* re-referenced.
+
+        The SDK subtracts from every front-end channel the mean or median of
+        its pool (all channels, its bank, or its headstage from the loaded
+        channel maps), or the channel's own reference electrode, once per
+        batch on its callback thread.  Every consumer of the group shares that
+        one pass.  The pools are planned from the current configuration;
+        create the group again after changing group membership, banks or the
+        channel map.
+
+        Args:
+            rate: Group to re-reference.
+            scheme: Pools to reference each channel to.
+            statistic: Mean (CAR) or median of each pool.
+            buffer_seconds: Ring buffer duration in seconds.
+
+        Returns:
+            A :class:`VirtualGroup` instance.
+
+        Example::
+
+            car = session.rereferenced_group(SampleRate.SR_RAW, ReferenceScheme.BANK, "median")
+
+            @car.on_batch()
+            def on_car(samples, timestamps):
+                ...
+        """
+        rate = _coerce_enum(SampleRate, rate, _RATE_ALIASES)
+        scheme = _coerce_enum(ReferenceScheme, scheme)
+        statistic = _coerce_enum(ReferenceStatistic, statistic)
+        buffer_samples = int(buffer_seconds * rate.hz)
+        group = ffi.new("uint32_t*")
+        _check(
+            _get_lib().cbsdk_session_create_rereferenced_group(
+                self._session, int(rate), int(scheme), int(statistic), buffer_samples, group
+            ),
+            "Failed to create re-referenced group (no channels in the group?)",
+        )
+        return VirtualGroup(self, group[0], buffer_samples)
+
+    def band_power(
+        self,
+        source: "SampleRate | VirtualGroup" = SampleRate.SR_RAW,
+        bands: "list[tuple[float, float]]" = ((13.0, 30.0), (70.0, 150.0)),
+        window: int = 256,
+        hop: int = 50,
+        buffer_frames: int = 1000,
+    ) -> "BandPowerStream":
+        """Compute per-channel band power of a group inside the SDK.
+
+        Every *hop* samples the SDK Hann-windows the last *window* samples of
+        each channel, transforms them with an FFT shared by all channels and
+        sums the power in each band, so only the feature vectors cross into
+        Python.  Analysing a resampled group (e.g. 1 kHz LFP from
+        :meth:`resampled_group`) is much cheaper than the raw group.
+
+        Args:
+            source: Device group, or a :class:`VirtualGroup` to analyse.
+            bands: ``(low_hz, high_hz)`` pairs, edges inclusive; each must be
+                at least one frequency bin (sample rate / window) wide.
+            window: FFT length in samples (power of two, 16-16384).
+            hop: Samples between feature vectors.
+            buffer_frames: Ring buffer capacity in feature vectors.
+
+        Returns:
+            A :class:`BandPowerStream` instance.
+
+        Example::
+
+            lfp = session.resampled_group(SampleRate.SR_RAW, down=30)
+            power = session.band_power(lfp, bands=[(13, 30), (70, 150)], window=256, hop=50)
+
+            @power.on_features()
+            def on_features(features, timestamps):
+                decoder.step(np.log(features[-1]))  # (n_channels, n_bands)
+        """
+        config = ffi.new("cbsdk_band_power_config_t*")
+        if isinstance(source, VirtualGroup):
+            config.virtual_group = source.group_id
+        else:
+            config.source = int(_coerce_enum(SampleRate, source, _RATE_ALIASES))
+        config.window = window
+        config.hop = hop
+        c_bands = ffi.new("cbsdk_frequency_band_t[]", len(bands))
+        for i, (low, high) in enumerate(bands):
+            c_bands[i].low_hz = low
+            c_bands[i].high_hz = high
+        stream = ffi.new("uint32_t*")
+        _check(
+            _get_lib().cbsdk_session_create_band_power_stream(
+                self._session, config, c_bands, len(bands), buffer_frames, stream
+            ),
+            "Failed to create band power stream (band narrower than a frequency bin?)",
+        )
+        return BandPowerStream(self, stream[0])
+
+    def epochs(
+        self,
+        channels: "list[int]" = (),
+        source: SampleRate = SampleRate.SR_RAW,
+        pre: float = 0.01,
+        post: float = 0.02,
+        units: "Optional[list[int]]" = None,
+        comments: bool = False,
+        max_delay: float = 0.1,
+        buffer_epochs: int = 100,
+    ) -> "EpochStream":
+        """Cut fixed windows of a group around events inside the SDK.
+
+        Digital or serial input packets and spikes on *channels* (and comments,
+        if *comments* is set) each cut *pre* seconds before and *post* seconds
+        from the first sample at or after the event.  Each epoch is assembled
+        once its post window has arrived, so Python never has to buffer the
+        continuous stream.
+
+        Args:
+            channels: Trigger channel IDs (digital/serial inputs, spiking channels).
+            source: Group to cut from.
+            pre: Seconds before the event.
+            post: Seconds from the event on.
+            units: Spike units that trigger (default: all).
+            comments: Whether comments trigger too.
+            max_delay: How late (seconds) an event may arrive after its sample.
+            buffer_epochs: Ring buffer capacity in epochs.
+
+        Returns:
+            An :class:`EpochStream` instance.
+
+        Example::
+
+            stim = session.epochs(channels=[dinp_chan], pre=0.05, post=0.2)
+
+            @stim.on_epoch()
+            def on_epoch(event, samples, timestamps):
+                evoked.append(samples)  # (n_samples, n_channels)
+        """
+        rate = _coerce_enum(SampleRate, source, _RATE_ALIASES)
+        config = _get_lib().cbsdk_epoch_config_default()
+        config.source = int(rate)
+        config.pre_samples = round(pre * rate.hz)
+        config.post_samples = round(post * rate.hz)
+        config.max_delay_samples = round(max_delay * rate.hz)
+        if units is not None:
+            config.unit_mask = sum(1 << u for u in units)
+        config.comments = comments
+        c_channels = ffi.new("uint32_t[]", list(channels))
+        stream = ffi.new("uint32_t*")
+        _check(
+            _get_lib().cbsdk_session_create_epoch_stream(
+                self._session, ffi.addressof(config), c_channels, len(channels),
+                buffer_epochs, stream
+            ),
+            "Failed to create epoch stream (invalid trigger channel?)",
+        )
+        return EpochStream(self, stream[0])
+
     def read_continuous(
         self, rate: SampleRate = SampleRate.SR_30kHz, duration: float = 1.0
     ):
@@ -2170,3 +3210,395 @@ class ContinuousReader:
 
     def __del__(self):
         self.close()
+
+
+class VirtualGroup:
+    """Virtual sample group: a device group resampled or re-referenced inside the SDK.
+
+    Created via :meth:`Session.resampled_group` or
+    :meth:`Session.rereferenced_group`.  Output timestamps are the device times
+    the samples represent; resampled samples arrive :attr:`group_delay` source
+    samples after that.
+
+    Example::
+
+        lfp = session.resampled_group(SampleRate.SR_RAW, down=30)
+        time.sleep(2)
+        data, ts = lfp.read()  # (n_channels, ~2000) int16, (~2000,) uint64
+        lfp.close()
+
+    Attributes:
+        group_id: Id of the virtual group.
+        sample_rate: Output rate in Hz.
+        group_delay: Filter delay in source samples.
+        buffer_samples: Ring buffer capacity.
+    """
+
+    def __init__(self, session: Session, group_id: int, buffer_samples: int):
+        self._session = session
+        self.group_id = group_id
+        self.buffer_samples = buffer_samples
+        self._closed = False
+        info = self._info()
+        self.sample_rate = info.sample_rate_hz
+        self.group_delay = info.group_delay
+
+    def _info(self):
+        info = ffi.new("cbsdk_virtual_group_info_t*")
+        _check(
+            _get_lib().cbsdk_session_get_virtual_group_info(
+                self._session._session, self.group_id, info
+            ),
+            "Failed to get virtual group info",
+        )
+        return info
+
+    def on_batch(self) -> Callable:
+        """Decorator to register a batch callback for the resampled samples.
+
+        The callback receives ``(samples, timestamps)`` as for
+        :meth:`Session.on_group_batch`.
+        """
+
+        def decorator(fn):
+            c_batch_cb = Session._batch_callback(fn)
+            handle = _get_lib().cbsdk_session_register_virtual_group_batch_callback(
+                self._session._session, self.group_id, c_batch_cb, ffi.NULL
+            )
+            if handle == 0:
+                raise RuntimeError("Failed to register virtual group batch callback")
+            self._session._handles.append(handle)
+            self._session._callback_refs.append(c_batch_cb)
+            return fn
+
+        return decorator
+
+    def read(self, max_samples: Optional[int] = None):
+        """Move the oldest buffered samples out of the ring buffer.
+
+        Args:
+            max_samples: Most samples to read (default: everything buffered).
+
+        Returns:
+            ``(data, timestamps)``: ``(n_channels, n)`` int16 and ``(n,)`` uint64 arrays.
+        """
+        import numpy as np
+
+        info = self._info()
+        n = info.buffered if max_samples is None else min(max_samples, info.buffered)
+        n_ch = info.channel_count
+        rows = np.empty((n, n_ch), dtype=np.int16)
+        ts = np.empty(n, dtype=np.uint64)
+        if n == 0:
+            return rows.T, ts
+        n_samples = ffi.new("uint32_t*", n)
+        n_channels = ffi.new("uint32_t*")
+        _check(
+            _get_lib().cbsdk_session_read_virtual_group(
+                self._session._session,
+                self.group_id,
+                ffi.cast("int16_t*", ffi.from_buffer(rows)),
+                ffi.cast("uint64_t*", ffi.from_buffer(ts)),
+                n_ch,
+                n_samples,
+                n_channels,
+            ),
+            "Failed to read virtual group",
+        )
+        k = n_samples[0]
+        return rows[:k].T, ts[:k]
+
+    @property
+    def available(self) -> int:
+        """Number of samples currently in the buffer."""
+        return self._info().buffered
+
+    @property
+    def dropped(self) -> int:
+        """Number of samples overwritten before they were read."""
+        return self._info().samples_overwritten
+
+    def close(self):
+        """Stop the virtual group and its batch callbacks."""
+        if self._closed:
+            return
+        self._closed = True
+        _get_lib().cbsdk_session_destroy_virtual_group(self._session._session, self.group_id)
+
+    def __del__(self):
+        self.close()
+
+
+class BandPowerStream:
+    """Per-channel band power computed inside the SDK.
+
+    Created via :meth:`Session.band_power`.  Each feature vector is a
+    ``(n_channels, n_bands)`` array of mean-square power in raw units squared
+    (a sine of amplitude A reads A**2 / 2), stamped with the device time of
+    the newest sample in its window.
+
+    Attributes:
+        stream_id: Id of the band power stream.
+        sample_rate: Rate of the analysed samples in Hz.
+        n_bands: Bands per channel.
+        buffer_frames: Ring buffer capacity.
+    """
+
+    def __init__(self, session: Session, stream_id: int):
+        self._session = session
+        self.stream_id = stream_id
+        self._closed = False
+        info = self._info()
+        self.sample_rate = info.sample_rate_hz
+        self.n_bands = info.band_count
+        self.buffer_frames = info.buffer_capacity
+
+    def _info(self):
+        info = ffi.new("cbsdk_band_power_info_t*")
+        _check(
+            _get_lib().cbsdk_session_get_band_power_info(
+                self._session._session, self.stream_id, info
+            ),
+            "Failed to get band power stream info",
+        )
+        return info
+
+    def on_features(self) -> Callable:
+        """Decorator to register a callback for the feature vectors.
+
+        The callback receives ``(features, timestamps)``: a ``float32`` array
+        of shape ``(n_frames, n_channels, n_bands)`` owned by the callee and a
+        ``uint64`` array of shape ``(n_frames,)``.
+        """
+        import numpy as np
+
+        def decorator(fn):
+            @ffi.callback("void(const float*, size_t, size_t, size_t, const uint64_t*, void*)")
+            def c_features_cb(features_ptr, n_frames, n_channels, n_bands, ts_ptr, user_data):
+                try:
+                    fbuf = ffi.buffer(features_ptr, n_frames * n_channels * n_bands * 4)
+                    features = (
+                        np.frombuffer(fbuf, dtype=np.float32)
+                        .reshape(n_frames, n_channels, n_bands)
+                        .copy()
+                    )
+                    tbuf = ffi.buffer(ts_ptr, n_frames * 8)
+                    fn(features, np.frombuffer(tbuf, dtype=np.uint64).copy())
+                except Exception:
+                    pass  # Never let exceptions propagate into C
+
+            handle = _get_lib().cbsdk_session_register_band_power_callback(
+                self._session._session, self.stream_id, c_features_cb, ffi.NULL
+            )
+            if handle == 0:
+                raise RuntimeError("Failed to register band power callback")
+            self._session._handles.append(handle)
+            self._session._callback_refs.append(c_features_cb)
+            return fn
+
+        return decorator
+
+    def read(self, max_frames: Optional[int] = None):
+        """Move the oldest buffered feature vectors out of the ring buffer.
+
+        Args:
+            max_frames: Most vectors to read (default: everything buffered).
+
+        Returns:
+            ``(features, timestamps)``: ``(n, n_channels, n_bands)`` float32 and
+            ``(n,)`` uint64 arrays.
+        """
+        import numpy as np
+
+        info = self._info()
+        n = info.buffered if max_frames is None else min(max_frames, info.buffered)
+        n_ch = info.channel_count
+        features = np.empty((n, n_ch, self.n_bands), dtype=np.float32)
+        ts = np.empty(n, dtype=np.uint64)
+        if n == 0:
+            return features, ts
+        n_frames = ffi.new("uint32_t*", n)
+        n_channels = ffi.new("uint32_t*")
+        _check(
+            _get_lib().cbsdk_session_read_band_power(
+                self._session._session,
+                self.stream_id,
+                ffi.cast("float*", ffi.from_buffer(features)),
+                ffi.cast("uint64_t*", ffi.from_buffer(ts)),
+                n_ch,
+                n_frames,
+                n_channels,
+            ),
+            "Failed to read band power",
+        )
+        k = n_frames[0]
+        return features[:k], ts[:k]
+
+    @property
+    def available(self) -> int:
+        """Number of feature vectors currently in the buffer."""
+        return self._info().buffered
+
+    @property
+    def dropped(self) -> int:
+        """Number of feature vectors overwritten before they were read."""
+        return self._info().frames_overwritten
+
+    def close(self):
+        """Stop the stream and its callbacks."""
+        if self._closed:
+            return
+        self._closed = True
+        _get_lib().cbsdk_session_destroy_band_power_stream(
+            self._session._session, self.stream_id
+        )
+
+    def __del__(self):
+        self.close()
+
+
+class EpochStream:
+    """Peri-event windows of a group cut inside the SDK.
+
+    Created via :meth:`Session.epochs`.  Each epoch is an
+    ``(n_samples, n_channels)`` int16 array of ``pre`` samples before the
+    event's trigger sample (the first at or after the event) and ``post``
+    samples from it on.  Events are numpy records with fields ``time``,
+    ``trigger_time``, ``chan_id`` and ``value`` (spike unit or digital
+    input value).
+
+    Attributes:
+        stream_id: Id of the epoch stream.
+        pre_samples: Samples before the trigger sample.
+        post_samples: Samples from the trigger sample on.
+        buffer_epochs: Ring buffer capacity.
+    """
+
+    EVENT_DTYPE = [
+        ("time", "<u8"),
+        ("trigger_time", "<u8"),
+        ("chan_id", "<u4"),
+        ("value", "<u4"),
+    ]
+
+    def __init__(self, session: Session, stream_id: int):
+        self._session = session
+        self.stream_id = stream_id
+        self._closed = False
+        info = self._info()
+        self.pre_samples = info.pre_samples
+        self.post_samples = info.post_samples
+        self.buffer_epochs = info.buffer_capacity
+
+    def _info(self):
+        info = ffi.new("cbsdk_epoch_info_t*")
+        _check(
+            _get_lib().cbsdk_session_get_epoch_info(
+                self._session._session, self.stream_id, info
+            ),
+            "Failed to get epoch stream info",
+        )
+        return info
+
+    def on_epoch(self) -> Callable:
+        """Decorator to register a callback for each epoch.
+
+        The callback receives ``(event, samples, timestamps)``: an event record,
+        an ``int16`` array of shape ``(n_samples, n_channels)`` owned by the
+        callee and a ``uint64`` array of shape ``(n_samples,)``.
+        """
+        import numpy as np
+
+        dtype = np.dtype(self.EVENT_DTYPE)
+
+        def decorator(fn):
+            @ffi.callback(
+                "void(const cbsdk_epoch_event_t*, const int16_t*, size_t, size_t, const uint64_t*, void*)"
+            )
+            def c_epoch_cb(event_ptr, samples_ptr, n_samples, n_channels, ts_ptr, user_data):
+                try:
+                    event = np.frombuffer(ffi.buffer(event_ptr, dtype.itemsize), dtype=dtype).copy()[0]
+                    sbuf = ffi.buffer(samples_ptr, n_samples * n_channels * 2)
+                    samples = (
+                        np.frombuffer(sbuf, dtype=np.int16)
+                        .reshape(n_samples, n_channels)
+                        .copy()
+                    )
+                    tbuf = ffi.buffer(ts_ptr, n_samples * 8)
+                    fn(event, samples, np.frombuffer(tbuf, dtype=np.uint64).copy())
+                except Exception:
+                    pass  # Never let exceptions propagate into C
+
+            handle = _get_lib().cbsdk_session_register_epoch_callback(
+                self._session._session, self.stream_id, c_epoch_cb, ffi.NULL
+            )
+            if handle == 0:
+                raise RuntimeError("Failed to register epoch callback")
+            self._session._handles.append(handle)
+            self._session._callback_refs.append(c_epoch_cb)
+            return fn
+
+        return decorator
+
+    def read(self, max_epochs: Optional[int] = None):
+        """Move the oldest buffered epochs out of the ring buffer.
+
+        Args:
+            max_epochs: Most epochs to read (default: everything buffered).
+
+        Returns:
+            ``(samples, events)``: an ``(n, n_samples, n_channels)`` int16 array
+            and ``n`` event records.
+        """
+        import numpy as np
+
+        info = self._info()
+        n = info.buffered if max_epochs is None else min(max_epochs, info.buffered)
+        n_ch = info.channel_count
+        samples = np.empty((n, self.pre_samples + self.post_samples, n_ch), dtype=np.int16)
+        events = np.empty(n, dtype=self.EVENT_DTYPE)
+        if n == 0:
+            return samples, events
+        n_epochs = ffi.new("uint32_t*", n)
+        n_channels = ffi.new("uint32_t*")
+        _check(
+            _get_lib().cbsdk_session_read_epochs(
+                self._session._session,
+                self.stream_id,
+                ffi.cast("int16_t*", ffi.from_buffer(samples)),
+                ffi.cast("cbsdk_epoch_event_t*", ffi.from_buffer(events)),
+                n_ch,
+                n_epochs,
+                n_channels,
+            ),
+            "Failed to read epochs",
+        )
+        k = n_epochs[0]
+        return samples[:k], events[:k]
+
+    @property
+    def pending(self) -> int:
+        """Number of events waiting for their post window."""
+        return self._info().pending
+
+    @property
+    def available(self) -> int:
+        """Number of epochs currently in the buffer."""
+        return self._info().buffered
+
+    @property
+    def dropped(self) -> int:
+        """Number of epochs overwritten before they were read."""
+        return self._info().epochs_overwritten
+
+    def close(self):
+        """Stop the stream and its callbacks."""
+        if self._closed:
+            return
+        self._closed = True
+        _get_lib().cbsdk_session_destroy_epoch_stream(
+            self._session._session, self.stream_id
+        )
+
+    def __del__(self):
+        self.close()
@@ -0,0 +1,116 @@
+"""Unit tests for the cffi declarations in pycbsdk._cdef.
+
+These run without a device: they check that the cdef mirrors cbsdk.h closely
+enough for cffi to parse it, which is what ``import pycbsdk`` does first, and that
+every type it declares has the size a C compiler gives it from cbsdk.h.
+"""
+
+from __future__ import annotations
+
+import os
+import re
+import shutil
+import subprocess
+from pathlib import Path
+
+import cffi
+import pytest
+
+from pycbsdk._cdef import CDEF
+
+_REPO_ROOT = Path(__file__).resolve().parents[2]
+_INCLUDE_DIRS = [
+    _REPO_ROOT / "src" / "cbsdk" / "include",
+    _REPO_ROOT / "src" / "cbproto" / "include",
+]
+
+# Every ``typedef struct/enum { ... } name;`` in the cdef (opaque handles excluded)
+TYPE_NAMES = re.findall(r"^\}\s*(\w+)\s*;", CDEF, flags=re.MULTILINE)
+
+
+@pytest.fixture(scope="module")
+def ffi() -> cffi.FFI:
+    ffi = cffi.FFI()
+    ffi.cdef(CDEF)
+    return ffi
+
+
+def test_cdef_parses(ffi: cffi.FFI):
+    # pycparser reads the declarations in order: a type used before it is
+    # declared fails here with "Invalid specifier list".
+    assert ffi.sizeof("cbsdk_session_t") == ffi.sizeof("void *")
+
+
+@pytest.mark.parametrize(
+    "type_name",
+    [
+        "cbsdk_filter_spec_t",
+        "cbsdk_virtual_group_info_t",
+        "cbsdk_spike_threshold_t",
+        "cbsdk_spike_detection_config_t",
+    ],
+)
+def test_host_processing_structs_are_complete(ffi: cffi.FFI, type_name: str):
+    assert ffi.sizeof(type_name) > 0
+
+
+@pytest.fixture(scope="module")
+def c_sizes(tmp_path_factory) -> dict[str, int]:
+    """sizeof() of each cdef type, as a C compiler lays it out from cbsdk.h."""
+    compiler = os.environ.get("CC") or shutil.which("cc") or shutil.which("gcc") or shutil.which("clang")
+    if compiler is None:
+        pytest.skip("no C compiler")
+    if not (_INCLUDE_DIRS[0] / "cbsdk" / "cbsdk.h").is_file():
+        pytest.skip("cbsdk.h not found (not running from the CereLink tree)")
+
+    work = tmp_path_factory.mktemp("cdef_sizes")
+    source = work / "sizes.c"
+    source.write_text(
+        "#include <stdio.h>\n#include <cbsdk/cbsdk.h>\nint main(void) {\n"
+        + "".join(f'    printf("{name} %zu\\n", sizeof({name}));\n' for name in TYPE_NAMES)
+        + "    return 0;\n}\n"
+    )
+    exe = work / "sizes"
+    includes = [f"-I{d}" for d in _INCLUDE_DIRS]
+    build = subprocess.run([compiler, *includes, str(source), "-o", str(exe)], capture_output=True, text=True)
+    assert build.returncode == 0, build.stderr
+    output = subprocess.run([str(exe)], capture_output=True, text=True, check=True).stdout
+    return {name: int(size) for name, size in (line.split() for line in output.splitlines())}
+
+
+def test_cdef_declares_every_header_type():
+    path = _INCLUDE_DIRS[0] / "cbsdk" / "cbsdk.h"
+    if not path.is_file():
+        pytest.skip("cbsdk.h not found (not running from the CereLink tree)")
+    header = path.read_text()
+    declared = set(re.findall(r"^\}\s*(cbsdk_\w+_t)\s*;", header, flags=re.MULTILINE))
+    assert declared
+    assert declared - set(TYPE_NAMES) == set()
+
+
+@pytest.mark.parametrize("type_name", TYPE_NAMES)
+def test_type_size_matches_header(ffi: cffi.FFI, c_sizes: dict[str, int], type_name: str):
+    assert ffi.sizeof(type_name) == c_sizes[type_name]
+
+
+def test_threshold_mode_values(ffi: cffi.FFI):
+    values = ffi.typeof("cbsdk_threshold_mode_t").relements
+    assert values == {
+        "CBSDK_THRESHOLD_OFF": 0,
+        "CBSDK_THRESHOLD_LEVEL": 1,
+        "CBSDK_THRESHOLD_RMS": 2,
+    }
+
+
+def test_declared_functions_resolve():
+    """Every declared function exists in the built library (skipped without one)."""
+    from pycbsdk._lib import load_library
+
+    try:
+        lib = load_library()
+    except OSError:
+        pytest.skip("libcbsdk shared library not built")
+    names = re.findall(r"\b(cbsdk_\w+)\s*\(", CDEF)
+    assert names
+    missing = [name for name in names if not hasattr(lib, name)]
+    assert missing == []
@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   capture.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Raw datagram capture files for offline replay
+///
+/// A capture holds every datagram a DeviceSession accepted, exactly as it came off the socket
+/// (i.e. still in the device's wire protocol), each stamped with its host receive time.  Setting
+/// ConnectionParams::replay_path feeds a capture back through the normal receive path, so the
+/// protocol translation, configuration tracking and callbacks run exactly as they did live.
+///
+/// File layout (host byte order, little-endian on every supported platform):
+/// @code
+///   CaptureFileHeader                      32 bytes
+///   { uint64 offset_ns; uint32 size; }     12 bytes  -- repeated per datagram,
+///   uint8  data[size]                                   followed by its payload
+/// @endcode
+/// offset_ns is the receive time relative to CaptureFileHeader::start_unix_ns.  Records are
+/// appended in arrival order, and a capture cut short by a crash is readable up to the last
+/// complete record.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBDEV_CAPTURE_H
+#define CBDEV_CAPTURE_H
+
+#include <cbdev/connection.h>
+#include <cbdev/result.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cbdev {
+
+/// Magic bytes at the start of every capture file
+constexpr char CAPTURE_MAGIC[8] = {'C', 'B', 'C', 'A', 'P', 'T', 'R', '\0'};
+
+/// Current capture format version
+constexpr uint32_t CAPTURE_FORMAT_VERSION = 1;
+
+/// Fixed-size header at the start of a capture file
+struct CaptureFileHeader {
+    char magic[8];              ///< CAPTURE_MAGIC
+    uint32_t format_version;    ///< CAPTURE_FORMAT_VERSION
+    uint32_t protocol;          ///< ProtocolVersion of the captured datagrams
+    uint64_t start_unix_ns;     ///< Wall-clock time the capture started (ns since Unix epoch)
+    uint32_t header_size;       ///< sizeof(CaptureFileHeader); records start at this offset
+    uint32_t reserved;          ///< Zero
+};
+static_assert(sizeof(CaptureFileHeader) == 32, "CaptureFileHeader layout is part of the file format");
+
+/// Capture counters
+struct CaptureStats {
+    uint64_t datagrams = 0;     ///< Datagrams written to disk
+    uint64_t bytes = 0;         ///< Payload bytes written to disk
+    uint64_t dropped = 0;       ///< Datagrams discarded because the writer fell too far behind
+    uint64_t write_errors = 0;  ///< Failed writes (e.g. disk full); the capture stops on the first one
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Append-only capture writer with a background disk thread
+///
+/// write() only copies the datagram into an in-memory buffer; a dedicated thread swaps that
+/// buffer out and writes it to disk, so the receive thread never waits on file I/O.  If the disk
+/// cannot keep up and more than @p max_pending_bytes are waiting, further datagrams are counted
+/// as dropped rather than stalling the receiver.
+///
+class CaptureWriter {
+public:
+    /// Default backlog limit before datagrams are dropped
+    static constexpr size_t DEFAULT_MAX_PENDING_BYTES = 64 * 1024 * 1024;
+
+    /// Create (truncate) a capture file, write its header and start the writer thread
+    /// @param path Output file path
+    /// @param protocol Wire protocol of the datagrams that will be written
+    /// @param max_pending_bytes Backlog limit before datagrams are dropped
+    /// @return Writer on success, error if the file cannot be created
+    static Result<CaptureWriter> open(const std::string& path, ProtocolVersion protocol,
+                                      size_t max_pending_bytes = DEFAULT_MAX_PENDING_BYTES);
+
+    CaptureWriter(CaptureWriter&&) noexcept;
+    CaptureWriter& operator=(CaptureWriter&&) noexcept;
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+
+    /// Flushes and closes the file
+    ~CaptureWriter();
+
+    /// Queue one datagram (thread-safe, never blocks on disk)
+    /// @param received Host time the datagram was received
+    /// @param data Datagram bytes
+    /// @param size Number of bytes
+    void write(std::chrono::steady_clock::time_point received, const void* data, size_t size);
+
+    /// Write everything queued so far, stop the writer thread and close the file
+    void close();
+
+    /// @return Snapshot of the counters
+    [[nodiscard]] CaptureStats stats() const;
+
+private:
+    CaptureWriter();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/// One datagram read back from a capture
+struct CaptureRecord {
+    uint64_t offset_ns = 0;     ///< Receive time relative to the start of the capture
+    std::vector<uint8_t> data;  ///< Datagram bytes
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sequential capture file reader
+///
+class CaptureReader {
+public:
+    /// Open a capture file and validate its header
+    /// @param path Capture file path
+    /// @return Reader positioned at the first record, or error
+    static Result<CaptureReader> open(const std::string& path);
+
+    CaptureReader(CaptureReader&&) noexcept;
+    CaptureReader& operator=(CaptureReader&&) noexcept;
+    CaptureReader(const CaptureReader&) = delete;
+    CaptureReader& operator=(const CaptureReader&) = delete;
+    ~CaptureReader();
+
+    /// @return The file header
+    [[nodiscard]] const CaptureFileHeader& header() const;
+
+    /// @return Wire protocol of the captured datagrams
+    [[nodiscard]] ProtocolVersion protocol() const;
+
+    /// Read the next record
+    /// @param record Receives the record (its buffer is reused between calls)
+    /// @return true if a record was read, false at the end of the capture
+    /// @note A truncated final record (capture cut short) reads as the end of the capture
+    Result<bool> next(CaptureRecord& record);
+
+    /// Seek back to the first record
+    void rewind();
+
+private:
+    CaptureReader();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbdev
+
+#endif // CBDEV_CAPTURE_H
@@ -107,6 +107,10 @@ struct ConnectionParams {
     // Connection options
     bool autorun = true;            ///< Auto-start device on connect (true = performStartupHandshake, false = requestConfiguration only)
 
+    // Replay (see cbdev/capture.h)
+    std::string replay_path;        ///< Read datagrams from this capture instead of a socket (empty = live)
+    double replay_speed = 1.0;      ///< Replay pace relative to the recording (0 = as fast as possible)
+
     /// Create connection parameters for a known device type
     static ConnectionParams forDevice(DeviceType type);
 
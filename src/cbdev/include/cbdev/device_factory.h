@@ -33,6 +33,7 @@ namespace cbdev {
 /// @note Auto-detection blocks briefly (up to 500ms) to probe device
 /// @note For PROTOCOL_CURRENT, creates standard DeviceSession
 /// @note For PROTOCOL_311, creates DeviceSession_311 with translation
+/// @note If config.replay_path is set, UNKNOWN takes the protocol from the capture header
 ///
 /// @example
 /// ```cpp
@@ -14,6 +14,7 @@
 #define CBDEV_DEVICE_SESSION_INTERFACE_H
 
 #include <chrono>
+#include <cbdev/capture.h>
 #include <cbdev/connection.h>
 #include <cbdev/result.h>
 #include <cbproto/cbproto.h>
@@ -344,6 +345,12 @@ public:
     [[nodiscard]] virtual std::optional<uint64_t>
         toDeviceTime(std::chrono::steady_clock::time_point local_time) const = 0;
 
+    /// Host time the most recent datagram was accepted (taken right after recvfrom)
+    /// @return Receive time, or a default-constructed time_point before the first datagram
+    /// @note Written by the receive thread; only meaningful when read from that thread
+    ///       (e.g. inside a receive callback, where it is the current datagram's arrival time)
+    [[nodiscard]] virtual std::chrono::steady_clock::time_point getLastReceiveTime() const = 0;
+
     /// Send a clock synchronization probe (no-op SYSSETRUNLEV(RUNNING)).
     /// Captures T1 (host send time) and completes measurement when SYSREPRUNLEV is received.
     /// @return Success or error
@@ -374,6 +381,29 @@ public:
                                         std::optional<int64_t> uncertainty_ns = std::nullopt) = 0;
 
     /// @}
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @name Capture and Replay
+    /// @{
+
+    /// Start writing every received datagram (untranslated, with its host receive time) to a
+    /// capture file.  Replaces any capture already in progress.
+    /// @param path Output file (truncated)
+    /// @return Success or error if the file cannot be created
+    /// @note Disk writes happen on a background thread; see cbdev/capture.h for the format
+    virtual Result<void> startCapture(const std::string& path) = 0;
+
+    /// Flush and close the capture file (no-op if not capturing)
+    virtual void stopCapture() = 0;
+
+    /// @return Counters of the current (or last) capture
+    [[nodiscard]] virtual CaptureStats getCaptureStats() const = 0;
+
+    /// @return true once a replay session (ConnectionParams::replay_path) has delivered its
+    ///         last datagram; always false for live sessions
+    [[nodiscard]] virtual bool isReplayFinished() const = 0;
+
+    /// @}
 };
 
 } // namespace cbdev
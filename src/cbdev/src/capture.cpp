@@ -0,0 +1,286 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   capture.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Capture file writer (background thread) and reader
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cbdev/capture.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace cbdev {
+
+namespace {
+
+/// Size of the per-datagram record header on disk (offset_ns + size, unpadded)
+constexpr size_t RECORD_HEADER_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+
+/// Largest payload accepted from a record header (anything bigger means a corrupt file)
+constexpr uint32_t MAX_RECORD_SIZE = 1u << 20;
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CaptureWriter
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct CaptureWriter::Impl {
+    FILE* file = nullptr;
+    std::chrono::steady_clock::time_point start;
+    size_t max_pending_bytes = DEFAULT_MAX_PENDING_BYTES;
+
+    // Producer side: records are appended to `front`, the writer thread swaps it out
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<uint8_t> front;
+    uint64_t front_datagrams = 0;
+    uint64_t front_bytes = 0;
+    bool stop_requested = false;
+    bool failed = false;
+
+    std::thread thread;
+
+    std::atomic<uint64_t> datagrams{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> write_errors{0};
+
+    void run() {
+        std::vector<uint8_t> back;
+        for (;;) {
+            uint64_t batch_datagrams = 0;
+            uint64_t batch_bytes = 0;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return stop_requested || !front.empty(); });
+                if (front.empty()) {
+                    break;  // stop requested and nothing left to write
+                }
+                back.swap(front);
+                batch_datagrams = front_datagrams;
+                batch_bytes = front_bytes;
+                front_datagrams = 0;
+                front_bytes = 0;
+            }
+
+            if (std::fwrite(back.data(), 1, back.size(), file) != back.size()) {
+                write_errors.fetch_add(1, std::memory_order_relaxed);
+                dropped.fetch_add(batch_datagrams, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> lock(mutex);
+                failed = true;
+            } else {
+                datagrams.fetch_add(batch_datagrams, std::memory_order_relaxed);
+                bytes.fetch_add(batch_bytes, std::memory_order_relaxed);
+            }
+            back.clear();
+        }
+        std::fflush(file);
+    }
+
+    void shutdown() {
+        if (thread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop_requested = true;
+            }
+            cv.notify_one();
+            thread.join();
+        }
+        if (file) {
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+
+    ~Impl() {
+        shutdown();
+    }
+};
+
+CaptureWriter::CaptureWriter() = default;
+CaptureWriter::CaptureWriter(CaptureWriter&&) noexcept = default;
+CaptureWriter& CaptureWriter::operator=(CaptureWriter&&) noexcept = default;
+CaptureWriter::~CaptureWriter() = default;
+
+Result<CaptureWriter> CaptureWriter::open(const std::string& path, const ProtocolVersion protocol,
+                                          const size_t max_pending_bytes) {
+    if (protocol == ProtocolVersion::UNKNOWN) {
+        return Result<CaptureWriter>::error("Cannot capture with an unknown protocol version");
+    }
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        return Result<CaptureWriter>::error("Failed to create capture file: " + path);
+    }
+
+    CaptureFileHeader header{};
+    std::memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+    header.format_version = CAPTURE_FORMAT_VERSION;
+    header.protocol = static_cast<uint32_t>(protocol);
+    header.start_unix_ns = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    header.header_size = sizeof(CaptureFileHeader);
+
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+        std::fclose(file);
+        return Result<CaptureWriter>::error("Failed to write capture header: " + path);
+    }
+
+    CaptureWriter writer;
+    writer.m_impl = std::make_unique<Impl>();
+    writer.m_impl->file = file;
+    writer.m_impl->start = std::chrono::steady_clock::now();
+    writer.m_impl->max_pending_bytes = max_pending_bytes;
+    Impl* impl = writer.m_impl.get();
+    writer.m_impl->thread = std::thread([impl] { impl->run(); });
+    return Result<CaptureWriter>::ok(std::move(writer));
+}
+
+void CaptureWriter::write(const std::chrono::steady_clock::time_point received,
+                          const void* data, const size_t size) {
+    if (!m_impl || size == 0 || size > MAX_RECORD_SIZE) {
+        return;
+    }
+
+    const auto since_start = received - m_impl->start;
+    const uint64_t offset_ns = since_start.count() > 0
+        ? static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(since_start).count())
+        : 0;
+    const auto size32 = static_cast<uint32_t>(size);
+
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        if (m_impl->failed || m_impl->stop_requested ||
+            m_impl->front.size() + RECORD_HEADER_SIZE + size > m_impl->max_pending_bytes) {
+            m_impl->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        auto& buf = m_impl->front;
+        const size_t at = buf.size();
+        buf.resize(at + RECORD_HEADER_SIZE + size);
+        std::memcpy(&buf[at], &offset_ns, sizeof(offset_ns));
+        std::memcpy(&buf[at + sizeof(offset_ns)], &size32, sizeof(size32));
+        std::memcpy(&buf[at + RECORD_HEADER_SIZE], data, size);
+        m_impl->front_datagrams++;
+        m_impl->front_bytes += size;
+    }
+    m_impl->cv.notify_one();
+}
+
+void CaptureWriter::close() {
+    if (m_impl) {
+        m_impl->shutdown();
+    }
+}
+
+CaptureStats CaptureWriter::stats() const {
+    CaptureStats s;
+    if (m_impl) {
+        s.datagrams = m_impl->datagrams.load(std::memory_order_relaxed);
+        s.bytes = m_impl->bytes.load(std::memory_order_relaxed);
+        s.dropped = m_impl->dropped.load(std::memory_order_relaxed);
+        s.write_errors = m_impl->write_errors.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// CaptureReader
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct CaptureReader::Impl {
+    FILE* file = nullptr;
+    CaptureFileHeader header{};
+    std::vector<char> io_buffer;
+
+    ~Impl() {
+        if (file) {
+            std::fclose(file);
+        }
+    }
+};
+
+CaptureReader::CaptureReader() = default;
+CaptureReader::CaptureReader(CaptureReader&&) noexcept = default;
+CaptureReader& CaptureReader::operator=(CaptureReader&&) noexcept = default;
+CaptureReader::~CaptureReader() = default;
+
+Result<CaptureReader> CaptureReader::open(const std::string& path) {
+    CaptureReader reader;
+    reader.m_impl = std::make_unique<Impl>();
+    auto& impl = *reader.m_impl;
+
+    impl.file = std::fopen(path.c_str(), "rb");
+    if (!impl.file) {
+        return Result<CaptureReader>::error("Failed to open capture file: " + path);
+    }
+
+    // Large stdio buffer: records are small and read back to back
+    impl.io_buffer.resize(1 << 20);
+    std::setvbuf(impl.file, impl.io_buffer.data(), _IOFBF, impl.io_buffer.size());
+
+    if (std::fread(&impl.header, sizeof(impl.header), 1, impl.file) != 1 ||
+        std::memcmp(impl.header.magic, CAPTURE_MAGIC, sizeof(CAPTURE_MAGIC)) != 0) {
+        return Result<CaptureReader>::error("Not a capture file: " + path);
+    }
+    if (impl.header.format_version != CAPTURE_FORMAT_VERSION) {
+        return Result<CaptureReader>::error("Unsupported capture format version " +
+                                            std::to_string(impl.header.format_version));
+    }
+    if (impl.header.header_size < sizeof(CaptureFileHeader)) {
+        return Result<CaptureReader>::error("Corrupt capture header: " + path);
+    }
+
+    reader.rewind();
+    return Result<CaptureReader>::ok(std::move(reader));
+}
+
+const CaptureFileHeader& CaptureReader::header() const {
+    return m_impl->header;
+}
+
+ProtocolVersion CaptureReader::protocol() const {
+    return static_cast<ProtocolVersion>(m_impl->header.protocol);
+}
+
+Result<bool> CaptureReader::next(CaptureRecord& record) {
+    if (!m_impl || !m_impl->file) {
+        return Result<bool>::error("Capture file not open");
+    }
+
+    uint8_t rec_header[RECORD_HEADER_SIZE];
+    if (std::fread(rec_header, 1, sizeof(rec_header), m_impl->file) != sizeof(rec_header)) {
+        return Result<bool>::ok(false);
+    }
+
+    uint32_t size = 0;
+    std::memcpy(&record.offset_ns, rec_header, sizeof(record.offset_ns));
+    std::memcpy(&size, rec_header + sizeof(record.offset_ns), sizeof(size));
+    if (size == 0 || size > MAX_RECORD_SIZE) {
+        return Result<bool>::error("Corrupt capture record (size " + std::to_string(size) + ")");
+    }
+
+    record.data.resize(size);
+    if (std::fread(record.data.data(), 1, size, m_impl->file) != size) {
+        return Result<bool>::ok(false);  // truncated final record
+    }
+    return Result<bool>::ok(true);
+}
+
+void CaptureReader::rewind() {
+    if (m_impl && m_impl->file) {
+        std::clearerr(m_impl->file);
+        std::fseek(m_impl->file, static_cast<long>(m_impl->header.header_size), SEEK_SET);
+    }
+}
+
+} // namespace cbdev
@@ -11,6 +11,7 @@
 #include "platform_first.h"
 
 #include <cbdev/device_factory.h>
+#include <cbdev/capture.h>
 #include "device_session_impl.h"
 #include "device_session_311.h"
 #include "device_session_400.h"
@@ -30,6 +31,15 @@ Result<std::unique_ptr<IDeviceSession>> createDeviceSession(
         client_addr = detectClientAddress(config.type);
     }
 
+    // Replay: the capture records the wire protocol, so there is nothing to probe
+    if (version == ProtocolVersion::UNKNOWN && !config.replay_path.empty()) {
+        auto reader = CaptureReader::open(config.replay_path);
+        if (reader.isError()) {
+            return Result<std::unique_ptr<IDeviceSession>>::error(reader.error());
+        }
+        version = reader.value().protocol();
+    }
+
     // Auto-detect protocol if unknown
     if (version == ProtocolVersion::UNKNOWN) {
         auto detect_result = detectProtocol(
@@ -39,17 +39,21 @@
 
 #include "device_session_impl.h"
 #include "cbdev/clock_sync.h"
+#include "cbdev/capture.h"
 #include <cbproto/cbproto.h>
 #include <cbproto/config.h>
+#include <cbproto/packet_traits.h>
 #include <cstdio>
 #include <cstring>
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
 #include <algorithm>  // for std::remove
+#include <array>
 #include <cctype>     // for std::tolower
 #include <functional> // for std::function
 #include <numeric>    // for std::gcd
+#include <optional>
 #include <thread>
 #include <atomic>
 #include <vector>
@@ -224,16 +228,37 @@ struct DeviceSession::Impl {
     std::mutex clock_probe_mutex;
 
     // General response waiting mechanism
+    // Waiters that name their reply types are bucketed by (8-bit) config packet type, so a
+    // REQCONFIGALL flood only runs the matchers interested in each packet. Waiters without
+    // types land in the catch-all bucket and see every configuration packet.
     struct PendingResponse {
         std::function<bool(const cbPKT_HEADER*)> matcher;
+        std::vector<uint16_t> types;  // Buckets this waiter is filed under (empty = catch-all)
         std::condition_variable cv;
         std::mutex mutex;
         size_t expected_count = 1;  // How many packets we expect
         size_t received_count = 0;  // How many we've received so far
     };
-    std::vector<std::shared_ptr<PendingResponse>> pending_responses;
+    using PendingList = std::vector<std::shared_ptr<PendingResponse>>;
+    static constexpr size_t PENDING_TYPE_BUCKETS = 256;
+    std::array<PendingList, PENDING_TYPE_BUCKETS> pending_by_type;
+    PendingList pending_any;
+    std::atomic<size_t> pending_count{0};  // Fast-path skip when nobody is waiting
     std::mutex pending_mutex;
 
+    /// Run the matchers in one bucket against a config packet (pending_mutex held)
+    static void matchPending(const PendingList& list, const cbPKT_HEADER* header) {
+        for (const auto& pending : list) {
+            if (pending->received_count < pending->expected_count && pending->matcher(header)) {
+                std::lock_guard<std::mutex> resp_lock(pending->mutex);
+                pending->received_count++;
+                if (pending->received_count >= pending->expected_count) {
+                    pending->cv.notify_all();
+                }
+            }
+        }
+    }
+
     // Callback registration
     struct CallbackRegistration {
         CallbackHandle handle;
@@ -256,6 +281,72 @@ struct DeviceSession::Impl {
     uint32_t sent_accum = 0;                // Sent accumulated since last log
     std::chrono::steady_clock::time_point last_drop_log_time{};
 
+    // Configuration packets dropped because their dlen is outside the type's range
+    uint32_t malformed_accum = 0;           // Malformed packets since last log
+    std::chrono::steady_clock::time_point last_malformed_log_time{};
+
+    // Capture: accepted datagrams are handed to a background writer (see cbdev/capture.h)
+    std::optional<CaptureWriter> capture;
+    CaptureStats last_capture_stats{};      // Final counters of the last stopped capture
+    std::atomic<bool> capturing{false};     // Fast-path skip when not capturing
+    mutable std::mutex capture_mutex;
+
+    // Replay: datagrams come from a capture instead of the socket (config.replay_path)
+    std::optional<CaptureReader> replay;
+    CaptureRecord replay_record;            // Next datagram to deliver
+    bool replay_record_loaded = false;
+    bool replay_started = false;
+    uint64_t replay_first_offset_ns = 0;
+    std::chrono::steady_clock::time_point replay_origin{};
+    std::atomic<bool> replay_finished{false};
+
+    /// Deliver the next captured datagram once it is due (replay counterpart of recvfrom)
+    Result<int> receiveReplay(void* buffer, const size_t buffer_size) {
+        if (!replay_record_loaded) {
+            auto next = replay->next(replay_record);
+            if (next.isError()) {
+                replay_finished.store(true);
+                return Result<int>::error(next.error());
+            }
+            if (!next.value()) {
+                // End of capture: afterwards idle like a quiet socket instead of spinning
+                if (replay_finished.exchange(true)) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                }
+                return Result<int>::ok(0);
+            }
+            replay_record_loaded = true;
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (config.replay_speed > 0) {
+            if (!replay_started) {
+                replay_started = true;
+                replay_origin = now;
+                replay_first_offset_ns = replay_record.offset_ns;
+            }
+            const auto due = replay_origin + std::chrono::nanoseconds(static_cast<int64_t>(
+                static_cast<double>(replay_record.offset_ns - replay_first_offset_ns) / config.replay_speed));
+            if (now < due) {
+                // Sleep in bounded steps so the receive thread still notices stop requests
+                std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+                    due - now, std::chrono::milliseconds(50)));
+                now = std::chrono::steady_clock::now();
+                if (now < due) {
+                    return Result<int>::ok(0);
+                }
+            }
+        }
+
+        replay_record_loaded = false;
+        if (replay_record.data.size() > buffer_size) {
+            return Result<int>::error("Captured datagram larger than receive buffer");
+        }
+        std::memcpy(buffer, replay_record.data.data(), replay_record.data.size());
+        last_recv_timestamp = now;
+        return Result<int>::ok(static_cast<int>(replay_record.data.size()));
+    }
+
     // Receive thread state
     std::thread receive_thread;
     std::atomic<bool> receive_thread_running{false};
@@ -320,6 +411,23 @@ Result<DeviceSession> DeviceSession::create(const ConnectionParams& config) {
     session.m_impl = std::make_unique<Impl>();
     session.m_impl->config = config;
 
+    // Replay: no socket, datagrams come from the capture file
+    if (!config.replay_path.empty()) {
+        if (config.replay_speed < 0) {
+            return Result<DeviceSession>::error("Replay speed must be >= 0");
+        }
+        auto reader = CaptureReader::open(config.replay_path);
+        if (reader.isError()) {
+            return Result<DeviceSession>::error(reader.error());
+        }
+        session.m_impl->replay.emplace(std::move(reader.value()));
+        if (config.type == DeviceType::LEGACY_NSP) {
+            session.m_impl->timestamps_are_nanoseconds = false;
+        }
+        session.m_impl->connected = true;
+        return Result<DeviceSession>::ok(std::move(session));
+    }
+
     // LEGACY_NSP is known to use sample-count timestamps (never Gemini).
     // For other types, we default to true and let PROCREP confirm.
     if (config.type == DeviceType::LEGACY_NSP) {
@@ -489,6 +597,10 @@ Result<int> DeviceSession::receivePacketsRaw(void* buffer, const size_t buffer_s
         return Result<int>::error("Device not connected");
     }
 
+    if (m_impl->replay) {
+        return m_impl->receiveReplay(buffer, buffer_size);
+    }
+
     // Receive UDP datagram into provided buffer (non-blocking).
     // Use recvfrom to capture the sender address so we can discard datagrams
     // from other devices sharing the same port (e.g. NPLAY and HUB1 both use 51002).
@@ -521,6 +633,13 @@ Result<int> DeviceSession::receivePacketsRaw(void* buffer, const size_t buffer_s
     // Capture host timestamp as early as possible after accepting a datagram.
     if (bytes_recv > 0) {
         m_impl->last_recv_timestamp = std::chrono::steady_clock::now();
+
+        if (m_impl->capturing.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> lock(m_impl->capture_mutex);
+            if (m_impl->capture) {
+                m_impl->capture->write(m_impl->last_recv_timestamp, buffer, bytes_recv);
+            }
+        }
     }
 
     return Result<int>::ok(bytes_recv);
@@ -642,6 +761,11 @@ Result<void> DeviceSession::sendRaw(const void* buffer, const size_t size) {
         return Result<void>::error("Invalid buffer or size");
     }
 
+    // Replay has nobody to talk to; requests are accepted and dropped
+    if (m_impl->replay) {
+        return Result<void>::ok();
+    }
+
     const int bytes_sent = sendto(
         m_impl->socket,
         (const char*)buffer,
@@ -840,6 +964,7 @@ Result<void> DeviceSession::setSystemRunLevelSync(uint32_t runlevel, uint32_t re
         [this, runlevel, resetque, runflags]() {
             return setSystemRunLevel(runlevel, resetque, runflags);
         },
+        {cbPKTTYPE_SYSREPRUNLEV},
         [expected_runlevel](const cbPKT_HEADER* hdr) {
             if ((hdr->chid & cbPKTCHAN_CONFIGURATION) != cbPKTCHAN_CONFIGURATION ||
                 hdr->type != cbPKTTYPE_SYSREPRUNLEV) {
@@ -873,6 +998,7 @@ Result<void> DeviceSession::requestConfiguration() {
 Result<void> DeviceSession::requestConfigurationSync(std::chrono::milliseconds timeout) {
     return sendAndWait(
         [this]() { return requestConfiguration(); },
+        {cbPKTTYPE_SYSREP},
         [](const cbPKT_HEADER* hdr) {
             return (hdr->chid & cbPKTCHAN_CONFIGURATION) == cbPKTCHAN_CONFIGURATION &&
                    hdr->type == cbPKTTYPE_SYSREP;
@@ -934,10 +1060,18 @@ Result<void> DeviceSession::performHandshakeSync(std::chrono::milliseconds timeo
 // Clock Synchronization
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+std::chrono::steady_clock::time_point DeviceSession::getLastReceiveTime() const {
+    return m_impl ? m_impl->last_recv_timestamp : std::chrono::steady_clock::time_point{};
+}
+
 Result<void> DeviceSession::sendClockProbe() {
     if (!m_impl || !m_impl->connected)
         return Result<void>::error("Device not connected");
 
+    // A replayed NPLAYREP answers a probe from the original session, not this one
+    if (m_impl->replay)
+        return Result<void>::ok();
+
     auto now = std::chrono::steady_clock::now();
     {
         std::lock_guard<std::mutex> lock(m_impl->clock_probe_mutex);
@@ -999,6 +1133,56 @@ void DeviceSession::setExternalClockOffset(std::optional<int64_t> offset_ns,
     m_impl->clock_sync.setExternalOffset(offset_ns, uncertainty_ns);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Capture and Replay
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result<void> DeviceSession::startCapture(const std::string& path) {
+    return startCapture(path, getProtocolVersion());
+}
+
+Result<void> DeviceSession::startCapture(const std::string& path, const ProtocolVersion wire_protocol) {
+    if (!m_impl) {
+        return Result<void>::error("Device not connected");
+    }
+
+    auto writer = CaptureWriter::open(path, wire_protocol);
+    if (writer.isError()) {
+        return Result<void>::error(writer.error());
+    }
+
+    std::lock_guard<std::mutex> lock(m_impl->capture_mutex);
+    if (m_impl->capture) {
+        m_impl->capture->close();
+    }
+    m_impl->capture.emplace(std::move(writer.value()));
+    m_impl->capturing.store(true, std::memory_order_relaxed);
+    return Result<void>::ok();
+}
+
+void DeviceSession::stopCapture() {
+    if (!m_impl) return;
+
+    std::lock_guard<std::mutex> lock(m_impl->capture_mutex);
+    m_impl->capturing.store(false, std::memory_order_relaxed);
+    if (m_impl->capture) {
+        m_impl->capture->close();
+        m_impl->last_capture_stats = m_impl->capture->stats();
+        m_impl->capture.reset();
+    }
+}
+
+CaptureStats DeviceSession::getCaptureStats() const {
+    if (!m_impl) return {};
+
+    std::lock_guard<std::mutex> lock(m_impl->capture_mutex);
+    return m_impl->capture ? m_impl->capture->stats() : m_impl->last_capture_stats;
+}
+
+bool DeviceSession::isReplayFinished() const {
+    return m_impl && m_impl->replay_finished.load();
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Channel Configuration
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1146,6 +1330,7 @@ Result<void> DeviceSession::setChannelsGroupSync(const size_t nChans, const Chan
         [this, nChans, chanType, group_id]() {
             return setChannelsGroupByType(nChans, chanType, group_id, true);
         },
+        {cbPKTTYPE_CHANREPAINP, cbPKTTYPE_CHANREPSMP, cbPKTTYPE_CHANREP},
         [](const cbPKT_HEADER* hdr) {
             return (hdr->chid & cbPKTCHAN_CONFIGURATION) == cbPKTCHAN_CONFIGURATION &&
                    (hdr->type == cbPKTTYPE_CHANREPAINP || hdr->type == cbPKTTYPE_CHANREPSMP || hdr->type == cbPKTTYPE_CHANREP);
@@ -1204,6 +1389,7 @@ Result<void> DeviceSession::setChannelsACInputCouplingSync(const size_t nChans,
         [this, nChans, chanType, enabled]() {
             return setChannelsACInputCouplingByType(nChans, chanType, enabled);
         },
+        {cbPKTTYPE_CHANREPAINP},
         [](const cbPKT_HEADER* hdr) {
             return (hdr->chid & cbPKTCHAN_CONFIGURATION) == cbPKTCHAN_CONFIGURATION &&
                    hdr->type == cbPKTTYPE_CHANREPAINP;
@@ -1264,6 +1450,7 @@ Result<void> DeviceSession::setChannelsSpikeSortingSync(const size_t nChans, con
         [this, nChans, chanType, sortOptions]() {
             return setChannelsSpikeSortingByType(nChans, chanType, sortOptions);
         },
+        {cbPKTTYPE_CHANREP},
         [](const cbPKT_HEADER* hdr) {
             // CHANSET broadcasts a CHANREP echo (not CHANREPSPKTHR).
             return (hdr->chid & cbPKTCHAN_CONFIGURATION) == cbPKTCHAN_CONFIGURATION &&
@@ -1390,18 +1577,25 @@ void DeviceSession::updateConfigFromBuffer(const void* buffer, const size_t byte
             last_data_time = header->time;
         }
 
-        if ((header->chid & cbPKTCHAN_CONFIGURATION) == cbPKTCHAN_CONFIGURATION) {
-            // Configuration packet - process based on type
-            if (header->type == cbPKTTYPE_SYSHEARTBEAT) {
-                // TODO: Handle heartbeat if needed
-                // Central uses this to prevent the system from going idle.
+        const auto& traits = cbproto::packetTraits(*header);
+        if (traits.cls == cbproto::PacketClass::CONFIG && !traits.dlenInRange(header->dlen)) {
+            // Too short for the struct of its slot: drop it rather than read past its end.
+            // The receive threads skip it too, so no callback or response waiter sees it.
+            ++m_impl->malformed_accum;
+            auto now = std::chrono::steady_clock::now();
+            if (now - m_impl->last_malformed_log_time >= std::chrono::seconds(1)) {
+                fprintf(stderr, "[cbdev] dropped %u malformed config packets (last: type 0x%02x, dlen %u)\n",
+                        m_impl->malformed_accum, header->type, static_cast<unsigned>(header->dlen));
+                m_impl->malformed_accum = 0;
+                m_impl->last_malformed_log_time = now;
             }
-            else if (header->type == cbPKTTYPE_LOGREP) {
-                const auto* logrep = reinterpret_cast<const cbPKT_LOG*>(buff_bytes + offset);
-                // TODO: if (logrep->mode == cbLOG_MODE_CRITICAL) {}
-                // NODO: cbsdk uses this to process comments OnPktLog
-            }
-            else if ((header->type & 0xF0) == cbPKTTYPE_CHANREP) {
+        } else if (traits.cls == cbproto::PacketClass::CONFIG) {
+            // Configuration packet - route on the type's config slot (see cbproto/packet_traits.h).
+            // SYSHEARTBEAT (Central uses it to prevent idling), LOGREP (cbsdk processes comments
+            // via OnPktLog), REPCONFIGALL (config flood starting), COMMENTREP and NMREP all map
+            // to ConfigSlot::NONE and need no action here.
+            switch (traits.slot) {
+            case cbproto::ConfigSlot::CHANINFO: {
                 // NODO: Optionally rename the channel label if this device has a prefix
                 //  NSP{instrument}-{label} or Hub{instrument)-{label}
                 // Note: Even though CHANSET* packets sent to the device only have some fields that are valid,
@@ -1410,17 +1604,15 @@ void DeviceSession::updateConfigFromBuffer(const void* buffer, const size_t byte
                 const auto* chaninfo = reinterpret_cast<const cbPKT_CHANINFO*>(buff_bytes + offset);
                 if (const uint32_t chan = chaninfo->chan; chan > 0 && chan <= cbMAXCHANS) {
                     // The device always returns the complete channel info, even if only a subset changed.
-                    m_impl->device_config.chaninfo[chan-1] = *chaninfo;
+                    cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.chaninfo[chan-1]);
                     // Note: If this is exactly type == cbPKTTYPE_CHANREP, then we could invalidate cached spikes.
                     // spk_buffer->cache[chan-1].valid = 0;
                 }
+                break;
             }
-            else if (header->type == cbPKTTYPE_REPCONFIGALL) {
-                // Config flood starting - no action needed
-            }
-            else if ((header->type & 0xF0) == cbPKTTYPE_SYSREP) {
+            case cbproto::ConfigSlot::SYSINFO: {
                 const auto* sysinfo = reinterpret_cast<const cbPKT_SYSINFO*>(buff_bytes + offset);
-                m_impl->device_config.sysinfo = *sysinfo;
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.sysinfo);
 
                 // If SYSREP arrives after PROCREP established non-Gemini identity,
                 // update conversion factors now that sysfreq is available.
@@ -1432,20 +1624,20 @@ void DeviceSession::updateConfigFromBuffer(const void* buffer, const size_t byte
 
                 // Note: Clock sync probes now use nPlay packets (NPLAYREP), not SYSREPRUNLEV.
                 // SYSREPRUNLEV is still processed here for config tracking (sysinfo update above).
+                break;
             }
-            else if (header->type == cbPKTTYPE_GROUPREP) {
+            case cbproto::ConfigSlot::GROUPINFO: {
                 auto const *groupinfo = reinterpret_cast<const cbPKT_GROUPINFO*>(buff_bytes + offset);
-                m_impl->device_config.groupinfo[groupinfo->group-1] = *groupinfo;
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.groupinfo[groupinfo->group-1]);
+                break;
             }
-            // else if (header->type == cbPKTTYPE_COMMENTREP) {
-            //     // cbsdk uses this to update comment shared memory: OnPktComment
-            // }
-            else if (header->type == cbPKTTYPE_FILTREP) {
+            case cbproto::ConfigSlot::FILTINFO: {
                 auto const *filtinfo = reinterpret_cast<const cbPKT_FILTINFO*>(buff_bytes + offset);
-                m_impl->device_config.filtinfo[filtinfo->filt-1] = *filtinfo;
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.filtinfo[filtinfo->filt-1]);
+                break;
             }
-            else if (header->type == cbPKTTYPE_PROCREP) {
-                m_impl->device_config.procinfo = *reinterpret_cast<const cbPKT_PROCINFO*>(buff_bytes + offset);
+            case cbproto::ConfigSlot::PROCINFO: {
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.procinfo);
 
                 // Determine timestamp units from processor identity.
                 // Gemini devices report ident containing "gemini" and send nanosecond timestamps.
@@ -1470,14 +1662,16 @@ void DeviceSession::updateConfigFromBuffer(const void* buffer, const size_t byte
                         m_impl->ts_convert_den = sysfreq / g;
                     }
                 }
+                break;
             }
-            else if (header->type == cbPKTTYPE_BANKREP) {
+            case cbproto::ConfigSlot::BANKINFO: {
                 auto const *bankinfo = reinterpret_cast<const cbPKT_BANKINFO*>(buff_bytes + offset);
                 if (bankinfo->bank < cbMAXBANKS) {
-                    m_impl->device_config.bankinfo[bankinfo->bank] = *bankinfo;
+                    cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.bankinfo[bankinfo->bank]);
                 }
+                break;
             }
-            else if (header->type == cbPKTTYPE_SYSPROTOCOLMONITOR) {
+            case cbproto::ConfigSlot::PROTOCOL_MONITOR: {
                 // Not used for clock sync — sent from firmware's 3rd thread after 2 queues,
                 // giving it an undefined timestamp delay.
                 const auto* mon = reinterpret_cast<const cbPKT_SYSPROTOCOLMONITOR*>(buff_bytes + offset);
@@ -1498,14 +1692,15 @@ void DeviceSession::updateConfigFromBuffer(const void* buffer, const size_t byte
                 }
                 m_impl->first_monitor_seen = true;
                 m_impl->pkts_since_monitor = 0;
+                break;
             }
-            else if (header->type == cbPKTTYPE_ADAPTFILTREP) {
-                m_impl->device_config.adaptinfo = *reinterpret_cast<const cbPKT_ADAPTFILTINFO*>(buff_bytes + offset);
-            }
-            else if (header->type == cbPKTTYPE_REFELECFILTREP) {
-                m_impl->device_config.refelecinfo = *reinterpret_cast<const cbPKT_REFELECFILTINFO*>(buff_bytes + offset);
-            }
-            else if (header->type == cbPKTTYPE_SS_MODELREP) {
+            case cbproto::ConfigSlot::ADAPTINFO:
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.adaptinfo);
+                break;
+            case cbproto::ConfigSlot::REFELECINFO:
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.refelecinfo);
+                break;
+            case cbproto::ConfigSlot::SS_MODEL: {
                 auto const *ssmodelrep = reinterpret_cast<const cbPKT_SS_MODELSET*>(buff_bytes + offset);
                 uint32_t unit = ssmodelrep->unit_number;
                 if (unit == 255) {
@@ -1514,69 +1709,67 @@ void DeviceSession::updateConfigFromBuffer(const void* buffer, const size_t byte
                 }
                 // Note: ssmodelrep->chan is 0-based, unlike most other channel fields.
                 // Note: ssmodelrep->unit_number is 0-based because unit==0 means unsorted
-                m_impl->device_config.spike_sorting.models[ssmodelrep->chan][unit] = *ssmodelrep;
-            }
-            else if (header->type == cbPKTTYPE_SS_STATUSREP) {
-                m_impl->device_config.spike_sorting.status = *reinterpret_cast<const cbPKT_SS_STATUS*>(buff_bytes + offset);
-            }
-            else if (header->type == cbPKTTYPE_SS_DETECTREP) {
-                m_impl->device_config.spike_sorting.detect = *reinterpret_cast<const cbPKT_SS_DETECT*>(buff_bytes + offset);
-            }
-            else if (header->type == cbPKTTYPE_SS_ARTIF_REJECTREP) {
-                m_impl->device_config.spike_sorting.artifact_reject = *reinterpret_cast<const cbPKT_SS_ARTIF_REJECT*>(buff_bytes + offset);
+                cbproto::copyConfigPacket(buff_bytes + offset,
+                                          m_impl->device_config.spike_sorting.models[ssmodelrep->chan][unit]);
+                break;
             }
-            else if (header->type == cbPKTTYPE_SS_NOISE_BOUNDARYREP) {
+            case cbproto::ConfigSlot::SS_STATUS:
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.spike_sorting.status);
+                break;
+            case cbproto::ConfigSlot::SS_DETECT:
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.spike_sorting.detect);
+                break;
+            case cbproto::ConfigSlot::SS_ARTIF_REJECT:
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.spike_sorting.artifact_reject);
+                break;
+            case cbproto::ConfigSlot::SS_NOISE_BOUNDARY: {
                 auto const* noise_boundary = reinterpret_cast<const cbPKT_SS_NOISE_BOUNDARY*>(buff_bytes + offset);
-                m_impl->device_config.spike_sorting.noise_boundary[noise_boundary->chan-1] = *noise_boundary;
-            }
-            else if (header->type == cbPKTTYPE_SS_STATISTICSREP) {
-                m_impl->device_config.spike_sorting.statistics = *reinterpret_cast<const cbPKT_SS_STATISTICS*>(buff_bytes + offset);
+                cbproto::copyConfigPacket(buff_bytes + offset,
+                                          m_impl->device_config.spike_sorting.noise_boundary[noise_boundary->chan-1]);
+                break;
             }
-            else if (header->type == cbPKTTYPE_FS_BASISREP) {
+            case cbproto::ConfigSlot::SS_STATISTICS:
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.spike_sorting.statistics);
+                break;
+            case cbproto::ConfigSlot::FS_BASIS: {
                 auto const* fs_basis = reinterpret_cast<const cbPKT_FS_BASIS*>(buff_bytes + offset);
                 if (fs_basis->chan != 0) {  // chan==0 is for a request packet only
-                    m_impl->device_config.spike_sorting.basis[fs_basis->chan-1] = *fs_basis;
+                    cbproto::copyConfigPacket(buff_bytes + offset,
+                                              m_impl->device_config.spike_sorting.basis[fs_basis->chan-1]);
                 }
+                break;
             }
-            else if (header->type == cbPKTTYPE_LNCREP) {
-                m_impl->device_config.lnc = *reinterpret_cast<const cbPKT_LNC*>(buff_bytes + offset);
-            }
-            else if (header->type == cbPKTTYPE_REPFILECFG) {
+            case cbproto::ConfigSlot::LNC:
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.lnc);
+                break;
+            case cbproto::ConfigSlot::FILECFG: {
                 auto const* filecfg = reinterpret_cast<const cbPKT_FILECFG*>(buff_bytes + offset);
                 if (filecfg->options == cbFILECFG_OPT_REC
                     || filecfg->options == cbFILECFG_OPT_STOP
                     || filecfg->options == cbFILECFG_OPT_TIMEOUT) {
-                    m_impl->device_config.fileinfo = *filecfg;
+                    cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.fileinfo);
                 }
+                break;
             }
-            // else if (header->type == cbPKTTYPE_REPINITIMPEDANCE) {
-            //
-            // }
-            // else if (header->type == cbPKTTYPE_REPPOLL) {
-            //
-            // }
-            // else if (header->type == cbPKTTYPE_SETUNITSELECTION) {
-            //
-            // }
-            else if (header->type == cbPKTTYPE_REPNTRODEINFO) {
+            case cbproto::ConfigSlot::NTRODEINFO: {
                 auto const* ntrodeinfo = reinterpret_cast<const cbPKT_NTRODEINFO*>(buff_bytes + offset);
-                m_impl->device_config.ntrodeinfo[ntrodeinfo->ntrode-1] = *ntrodeinfo;
+                cbproto::copyConfigPacket(buff_bytes + offset, m_impl->device_config.ntrodeinfo[ntrodeinfo->ntrode-1]);
+                break;
             }
-            // else if (header->type == cbPKTTYPE_NMREP) {
-            //     // NODO: Abandon NM support
-            // }
-            else if (header->type == cbPKTTYPE_WAVEFORMREP) {
+            case cbproto::ConfigSlot::WAVEFORM: {
                 const auto* waveformrep = reinterpret_cast<const cbPKT_AOUT_WAVEFORM*>(buff_bytes + offset);
                 uint16_t chan = waveformrep->chan;
                 // Analog out channels start after analog input channels
                 if (chan > cbNUM_ANALOG_CHANS && chan <= cbNUM_ANALOG_CHANS + AOUT_NUM_GAIN_CHANS) {
                     uint16_t aout_idx = chan - cbNUM_ANALOG_CHANS - 1;
                     if (waveformrep->trigNum < cbMAX_AOUT_TRIGGER) {
-                        m_impl->device_config.waveform[aout_idx][waveformrep->trigNum] = *waveformrep;
+                        cbproto::copyConfigPacket(buff_bytes + offset,
+                                                  m_impl->device_config.waveform[aout_idx][waveformrep->trigNum]);
                     }
                 }
+                break;
             }
-            else if (header->type == cbPKTTYPE_NPLAYREP) {
+            case cbproto::ConfigSlot::NPLAY: {
                 // Complete pending clock sync probe from nPlay echo.
                 const auto* nplay = reinterpret_cast<const cbPKT_NPLAY*>(buff_bytes + offset);
                 std::lock_guard<std::mutex> lock(m_impl->clock_probe_mutex);
@@ -1615,17 +1808,18 @@ void DeviceSession::updateConfigFromBuffer(const void* buffer, const size_t byte
                     }
                     m_impl->pending_clock_probe.active = false;
                 }
+                break;
+            }
+            default:
+                break;
             }
 
-            std::lock_guard<std::mutex> lock(m_impl->pending_mutex);
-            for (auto& pending : m_impl->pending_responses) {
-                if (pending->received_count < pending->expected_count && pending->matcher(header)) {
-                    std::lock_guard<std::mutex> resp_lock(pending->mutex);
-                    pending->received_count++;
-                    if (pending->received_count >= pending->expected_count) {
-                        pending->cv.notify_all();
-                    }
+            if (m_impl->pending_count.load(std::memory_order_acquire) > 0) {
+                std::lock_guard<std::mutex> lock(m_impl->pending_mutex);
+                if (header->type < Impl::PENDING_TYPE_BUCKETS) {
+                    Impl::matchPending(m_impl->pending_by_type[header->type], header);
                 }
+                Impl::matchPending(m_impl->pending_any, header);
             }
         }
 
@@ -1751,8 +1945,10 @@ Result<void> DeviceSession::startReceiveThread() {
                     break;  // Incomplete packet
                 }
 
-                // Invoke receive callbacks (skip mutex if no callbacks registered)
-                if (m_impl->has_callbacks.load(std::memory_order_acquire)) {
+                // Invoke receive callbacks (skip mutex if no callbacks registered).
+                // Malformed config packets were already dropped by updateConfigFromBuffer().
+                if (m_impl->has_callbacks.load(std::memory_order_acquire) &&
+                    !cbproto::isMalformedConfigPacket(pkt->cbpkt_header)) {
                     std::lock_guard<std::mutex> lock(m_impl->callback_mutex);
                     for (const auto& reg : m_impl->receive_callbacks) {
                         reg.callback(*pkt);
@@ -1797,10 +1993,21 @@ DeviceSession::ResponseWaiter::ResponseWaiter(std::unique_ptr<Impl> impl)
 
 DeviceSession::ResponseWaiter::~ResponseWaiter() {
     if (m_impl && m_impl->session && m_impl->session->m_impl) {
-        // Remove this waiter from the pending list
-        std::lock_guard<std::mutex> lock(m_impl->session->m_impl->pending_mutex);
-        auto& vec = m_impl->session->m_impl->pending_responses;
-        vec.erase(std::remove(vec.begin(), vec.end(), m_impl->response), vec.end());
+        // Remove this waiter from every bucket it was filed under
+        auto& impl = *m_impl->session->m_impl;
+        const auto& response = m_impl->response;
+        auto unlink = [&response](DeviceSession::Impl::PendingList& vec) {
+            vec.erase(std::remove(vec.begin(), vec.end(), response), vec.end());
+        };
+        std::lock_guard<std::mutex> lock(impl.pending_mutex);
+        if (response->types.empty()) {
+            unlink(impl.pending_any);
+        } else {
+            for (const uint16_t type : response->types) {
+                unlink(impl.pending_by_type[type]);
+            }
+        }
+        impl.pending_count.fetch_sub(1, std::memory_order_release);
     }
     // unique_ptr automatically cleans up m_impl
 }
@@ -1833,14 +2040,36 @@ Result<void> DeviceSession::ResponseWaiter::wait(const std::chrono::milliseconds
 DeviceSession::ResponseWaiter DeviceSession::registerResponseWaiter(
     std::function<bool(const cbPKT_HEADER*)> matcher,
         const size_t count) {
+    return registerResponseWaiter({}, std::move(matcher), count);
+}
+
+DeviceSession::ResponseWaiter DeviceSession::registerResponseWaiter(
+    std::vector<uint16_t> types,
+    std::function<bool(const cbPKT_HEADER*)> matcher,
+        const size_t count) {
+
+    // Types beyond the bucket range can't be indexed; fall back to the catch-all bucket
+    std::sort(types.begin(), types.end());
+    types.erase(std::unique(types.begin(), types.end()), types.end());
+    if (!types.empty() && types.back() >= Impl::PENDING_TYPE_BUCKETS) {
+        types.clear();
+    }
 
     auto response = std::make_shared<Impl::PendingResponse>();
     response->matcher = std::move(matcher);
+    response->types = std::move(types);
     response->expected_count = count;
 
     {
         std::lock_guard<std::mutex> lock(m_impl->pending_mutex);
-        m_impl->pending_responses.push_back(response);
+        if (response->types.empty()) {
+            m_impl->pending_any.push_back(response);
+        } else {
+            for (const uint16_t type : response->types) {
+                m_impl->pending_by_type[type].push_back(response);
+            }
+        }
+        m_impl->pending_count.fetch_add(1, std::memory_order_release);
     }
 
     // Create ResponseWaiter::Impl and wrap in unique_ptr
@@ -1854,12 +2083,13 @@ DeviceSession::ResponseWaiter DeviceSession::registerResponseWaiter(
 
 Result<void> DeviceSession::sendAndWait(
     const std::function<Result<void>()>& sender,
+    std::vector<uint16_t> types,
     std::function<bool(const cbPKT_HEADER*)> matcher,
     const std::chrono::milliseconds timeout,
     const size_t count) {
 
     // Register waiter BEFORE sending packet (avoids race condition)
-    auto waiter = registerResponseWaiter(std::move(matcher), count);
+    auto waiter = registerResponseWaiter(std::move(types), std::move(matcher), count);
 
     // Send the request
     auto result = sender();
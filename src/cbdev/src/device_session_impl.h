@@ -32,6 +32,7 @@
 #include <memory>
 #include <optional>
 #include <cstdint>
+#include <vector>
 
 namespace cbdev {
 
@@ -209,6 +210,16 @@ public:
     /// @note The matcher is checked against all configuration packets in updateConfigFromBuffer
     ResponseWaiter registerResponseWaiter(std::function<bool(const cbPKT_HEADER*)> matcher, size_t count = 1);
 
+    /// Register a response waiter that only sees configuration packets of the given types
+    /// @param types Config packet types the reply can have (empty = every config packet)
+    /// @param matcher Function that returns true when the desired packet is received
+    /// @param count Number of matching packets to wait for (default: 1)
+    /// @return ResponseWaiter object - call wait() to block until packet arrives
+    /// @note Waiters are indexed by type, so the matcher only runs on packets of those types
+    ResponseWaiter registerResponseWaiter(std::vector<uint16_t> types,
+                                          std::function<bool(const cbPKT_HEADER*)> matcher,
+                                          size_t count = 1);
+
     /// @}
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -306,6 +317,8 @@ public:
     [[nodiscard]] std::optional<uint64_t>
         toDeviceTime(std::chrono::steady_clock::time_point local_time) const override;
 
+    [[nodiscard]] std::chrono::steady_clock::time_point getLastReceiveTime() const override;
+
     Result<void> sendClockProbe() override;
 
     [[nodiscard]] std::optional<int64_t> getOffsetNs() const override;
@@ -317,6 +330,22 @@ public:
 
     /// @}
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    /// @name Capture and Replay
+    /// @{
+
+    Result<void> startCapture(const std::string& path) override;
+
+    /// Start a capture, recording @p wire_protocol in its header
+    /// Protocol wrappers call this so a replay rebuilds the same wrapper.
+    Result<void> startCapture(const std::string& path, ProtocolVersion wire_protocol);
+
+    void stopCapture() override;
+    [[nodiscard]] CaptureStats getCaptureStats() const override;
+    [[nodiscard]] bool isReplayFinished() const override;
+
+    /// @}
+
 private:
     /// Private constructor (use create() factory)
     DeviceSession() = default;
@@ -329,12 +358,14 @@ private:
 
     /// Helper for synchronous send-and-wait pattern
     /// @param sender Function that sends the request packet
+    /// @param types Config packet types the response can have (indexes the waiter)
     /// @param matcher Function that identifies the response packet
     /// @param timeout Maximum time to wait for response
     /// @param count Number of matching packets to wait for (default: 1)
     /// @return Success if response received, error on timeout or send failure
     Result<void> sendAndWait(
         const std::function<Result<void>()>& sender,
+        std::vector<uint16_t> types,
         std::function<bool(const cbPKT_HEADER*)> matcher,
         std::chrono::milliseconds timeout,
         size_t count = 1
@@ -25,6 +25,7 @@
 #include <cbdev/connection.h>
 #include <cbdev/result.h>
 #include <cbproto/cbproto.h>
+#include <cbproto/packet_traits.h>
 #include <algorithm>
 #include <atomic>
 #include <memory>
@@ -218,6 +219,10 @@ public:
         return m_device.toDeviceTime(local_time);
     }
 
+    [[nodiscard]] std::chrono::steady_clock::time_point getLastReceiveTime() const override {
+        return m_device.getLastReceiveTime();
+    }
+
     Result<void> sendClockProbe() override {
         return m_device.sendClockProbe();
     }
@@ -243,6 +248,23 @@ public:
         m_device.setExternalClockOffset(offset_ns, uncertainty_ns);
     }
 
+    /// Capture delegation (records the wrapper's wire protocol so replay translates it again)
+    Result<void> startCapture(const std::string& path) override {
+        return m_device.startCapture(path, getProtocolVersion());
+    }
+
+    void stopCapture() override {
+        m_device.stopCapture();
+    }
+
+    [[nodiscard]] CaptureStats getCaptureStats() const override {
+        return m_device.getCaptureStats();
+    }
+
+    [[nodiscard]] bool isReplayFinished() const override {
+        return m_device.isReplayFinished();
+    }
+
     /// @}
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -335,8 +357,9 @@ public:
                         break;
                     }
 
-                    // Invoke receive callbacks
-                    {
+                    // Invoke receive callbacks (malformed config packets were dropped by
+                    // updateConfigFromBuffer())
+                    if (!cbproto::isMalformedConfigPacket(pkt->cbpkt_header)) {
                         std::lock_guard<std::mutex> lock(m_thread_state->callback_mutex);
                         for (const auto& reg : m_thread_state->receive_callbacks) {
                             reg.callback(*pkt);
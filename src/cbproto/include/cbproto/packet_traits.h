@@ -0,0 +1,257 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   packet_traits.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Table-driven packet classification
+///
+/// Every packet is either continuous group data (chid == 0), a channel event
+/// (chid = 1..cbMAXCHANS) or a configuration/system packet (chid & cbPKTCHAN_CONFIGURATION).
+/// Configuration packet types all fit in 8 bits, so their per-type properties live in a
+/// constexpr 256-entry table indexed by type; data packets share two fixed entries.
+/// Dispatchers (DeviceSession::updateConfigFromBuffer, SdkSession's receive path and
+/// PacketTranslator) look the header up once and switch on a dense enum instead of
+/// re-testing `(type & 0xF0) == ...` chains.  Each configuration type also records the
+/// smallest dlen its struct can be read from; the receive paths drop shorter packets before
+/// dispatch, and copyConfigPacket() stores longer ones (newer firmware appending fields)
+/// truncated to the struct this build knows.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBPROTO_PACKET_TRAITS_H
+#define CBPROTO_PACKET_TRAITS_H
+
+#include <cbproto/cbproto.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace cbproto {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Packet Traits Types
+/// @{
+
+/// Broad packet class, derived from chid alone
+enum class PacketClass : uint8_t {
+    GROUP,   ///< Continuous sample group data (chid == 0, type = group id)
+    EVENT,   ///< Spike / digital / serial event (chid = 1..cbMAXCHANS)
+    CONFIG   ///< Configuration / system packet (chid & cbPKTCHAN_CONFIGURATION)
+};
+
+/// Where a configuration reply is stored (or which handler consumes it)
+enum class ConfigSlot : uint8_t {
+    NONE,               ///< Not stored (data packets, requests, unhandled replies)
+    SYSINFO,            ///< cbPKT_SYSINFO (SYSREP family 0x10-0x1F)
+    PROCINFO,           ///< cbPKT_PROCINFO
+    BANKINFO,           ///< cbPKT_BANKINFO
+    FILTINFO,           ///< cbPKT_FILTINFO
+    GROUPINFO,          ///< cbPKT_GROUPINFO
+    CHANINFO,           ///< cbPKT_CHANINFO (CHANREP family 0x40-0x4F)
+    ADAPTINFO,          ///< cbPKT_ADAPTFILTINFO
+    REFELECINFO,        ///< cbPKT_REFELECFILTINFO
+    NTRODEINFO,         ///< cbPKT_NTRODEINFO
+    LNC,                ///< cbPKT_LNC
+    WAVEFORM,           ///< cbPKT_AOUT_WAVEFORM
+    FILECFG,            ///< cbPKT_FILECFG
+    SS_MODEL,           ///< cbPKT_SS_MODELSET
+    SS_STATUS,          ///< cbPKT_SS_STATUS
+    SS_DETECT,          ///< cbPKT_SS_DETECT
+    SS_ARTIF_REJECT,    ///< cbPKT_SS_ARTIF_REJECT
+    SS_NOISE_BOUNDARY,  ///< cbPKT_SS_NOISE_BOUNDARY
+    SS_STATISTICS,      ///< cbPKT_SS_STATISTICS
+    FS_BASIS,           ///< cbPKT_FS_BASIS
+    PROTOCOL_MONITOR,   ///< cbPKT_SYSPROTOCOLMONITOR (drop accounting, not stored)
+    NPLAY,              ///< cbPKT_NPLAY (clock-sync probe echo, not stored)
+};
+
+/// Payload translation required between the current protocol and an older one
+enum class PayloadXlate : uint8_t {
+    NONE,               ///< Payload identical; plain copy
+    NPLAY,              ///< translate_NPLAY_*
+    COMMENT,            ///< translate_COMMENT_*
+    PROTOCOL_MONITOR,   ///< translate_SYSPROTOCOLMONITOR_*
+    CHANINFO,           ///< translate_CHANINFO_*
+    CHANRESET,          ///< translate_CHANRESET_*
+    PREVLNC_TYPE,       ///< Payload unchanged; pre-4.2 LNC preview type code remapped
+};
+
+/// Per-type packet properties
+struct PacketTypeTraits {
+    PacketClass cls;
+    ConfigSlot slot;
+    PayloadXlate from_311;   ///< 3.11 device → current
+    PayloadXlate from_400;   ///< 4.0 device → current
+    PayloadXlate from_410;   ///< 4.1 device → current
+    PayloadXlate to_311;     ///< current → 3.11 device
+    PayloadXlate to_400;     ///< current → 4.0 device
+    PayloadXlate to_410;     ///< current → 4.1 device
+    uint16_t min_dlen;       ///< Smallest well-formed dlen (current protocol)
+    uint16_t max_dlen;       ///< Largest well-formed dlen (MAX_PACKET_DLEN unless a longer
+                             ///< packet cannot be read safely)
+
+    /// @brief Whether @p dlen falls in this type's expected range
+    constexpr bool dlenInRange(uint32_t dlen) const {
+        return dlen >= min_dlen && dlen <= max_dlen;
+    }
+};
+
+/// Largest dlen any packet can carry
+constexpr uint16_t MAX_PACKET_DLEN = (cbPKT_MAX_SIZE - cbPKT_HEADER_SIZE) / 4;
+
+/// @}
+
+namespace detail {
+
+constexpr PacketTypeTraits makeTraits(PacketClass cls, ConfigSlot slot = ConfigSlot::NONE,
+                                      uint16_t min_dlen = 0, uint16_t max_dlen = MAX_PACKET_DLEN) {
+    return PacketTypeTraits{cls, slot,
+                            PayloadXlate::NONE, PayloadXlate::NONE, PayloadXlate::NONE,
+                            PayloadXlate::NONE, PayloadXlate::NONE, PayloadXlate::NONE,
+                            min_dlen, max_dlen};
+}
+
+constexpr std::array<PacketTypeTraits, 256> buildConfigTraits() {
+    std::array<PacketTypeTraits, 256> t{};
+    for (auto& e : t) {
+        e = makeTraits(PacketClass::CONFIG);
+    }
+
+    // Replies may be longer than the struct (fields appended by newer firmware): consumers
+    // read the struct's prefix only, so only the minimum is enforced
+    auto slot = [&t](uint8_t type, ConfigSlot s, uint16_t min_dlen) {
+        t[type].slot = s;
+        t[type].min_dlen = min_dlen;
+    };
+
+    // Replies stored in the device configuration
+    for (uint16_t type = cbPKTTYPE_SYSREP; type < cbPKTTYPE_SYSREP + 0x10; ++type) {
+        slot(static_cast<uint8_t>(type), ConfigSlot::SYSINFO, cbPKTDLEN_SYSINFO);
+    }
+    for (uint16_t type = cbPKTTYPE_CHANREP; type < cbPKTTYPE_CHANREP + 0x10; ++type) {
+        slot(static_cast<uint8_t>(type), ConfigSlot::CHANINFO, cbPKTDLEN_CHANINFOSHORT);
+    }
+    slot(cbPKTTYPE_PROCREP, ConfigSlot::PROCINFO, cbPKTDLEN_PROCINFO);
+    slot(cbPKTTYPE_BANKREP, ConfigSlot::BANKINFO, cbPKTDLEN_BANKINFO);
+    slot(cbPKTTYPE_FILTREP, ConfigSlot::FILTINFO, cbPKTDLEN_FILTINFO);
+    slot(cbPKTTYPE_GROUPREP, ConfigSlot::GROUPINFO, cbPKTDLEN_GROUPINFOSHORT);
+    slot(cbPKTTYPE_ADAPTFILTREP, ConfigSlot::ADAPTINFO, cbPKTDLEN_ADAPTFILTINFO);
+    slot(cbPKTTYPE_REFELECFILTREP, ConfigSlot::REFELECINFO, cbPKTDLEN_REFELECFILTINFO);
+    slot(cbPKTTYPE_REPNTRODEINFO, ConfigSlot::NTRODEINFO, cbPKTDLEN_NTRODEINFO);
+    slot(cbPKTTYPE_LNCREP, ConfigSlot::LNC, cbPKTDLEN_LNC);
+    slot(cbPKTTYPE_WAVEFORMREP, ConfigSlot::WAVEFORM, cbPKTDLEN_WAVEFORM);
+    slot(cbPKTTYPE_REPFILECFG, ConfigSlot::FILECFG, cbPKTDLEN_FILECFGSHORT);
+    slot(cbPKTTYPE_SS_MODELREP, ConfigSlot::SS_MODEL, cbPKTDLEN_SS_MODELSET);
+    slot(cbPKTTYPE_SS_STATUSREP, ConfigSlot::SS_STATUS, cbPKTDLEN_SS_STATUS);
+    slot(cbPKTTYPE_SS_DETECTREP, ConfigSlot::SS_DETECT, cbPKTDLEN_SS_DETECT);
+    slot(cbPKTTYPE_SS_ARTIF_REJECTREP, ConfigSlot::SS_ARTIF_REJECT, cbPKTDLEN_SS_ARTIF_REJECT);
+    slot(cbPKTTYPE_SS_NOISE_BOUNDARYREP, ConfigSlot::SS_NOISE_BOUNDARY, cbPKTDLEN_SS_NOISE_BOUNDARY);
+    slot(cbPKTTYPE_SS_STATISTICSREP, ConfigSlot::SS_STATISTICS, cbPKTDLEN_SS_STATISTICS);
+    slot(cbPKTTYPE_FS_BASISREP, ConfigSlot::FS_BASIS, cbPKTDLEN_FS_BASISSHORT);
+
+    // Replies consumed by a handler rather than stored
+    slot(cbPKTTYPE_SYSPROTOCOLMONITOR, ConfigSlot::PROTOCOL_MONITOR, cbPKTDLEN_SYSPROTOCOLMONITOR);
+    slot(cbPKTTYPE_NPLAYREP, ConfigSlot::NPLAY, cbPKTDLEN_NPLAY);
+
+    // Incoming payload differences (device → current)
+    t[cbPKTTYPE_NPLAYREP].from_311 = PayloadXlate::NPLAY;
+    t[cbPKTTYPE_COMMENTREP].from_311 = PayloadXlate::COMMENT;
+    // cbPKTTYPE_SYSPROTOCOLMONITOR == 0x01 == cbPKTTYPE_PREVREPLNC (pre-4.2).  The monitor
+    // translation takes priority for 3.11/4.0; 4.1 remaps the LNC preview code instead.
+    t[cbPKTTYPE_SYSPROTOCOLMONITOR].from_311 = PayloadXlate::PROTOCOL_MONITOR;
+    t[cbPKTTYPE_SYSPROTOCOLMONITOR].from_400 = PayloadXlate::PROTOCOL_MONITOR;
+    t[cbPKTTYPE_SYSPROTOCOLMONITOR].from_410 = PayloadXlate::PREVLNC_TYPE;
+    t[cbPKTTYPE_CHANRESETREP].from_311 = PayloadXlate::CHANRESET;
+    t[cbPKTTYPE_CHANRESETREP].from_400 = PayloadXlate::CHANRESET;
+    t[cbPKTTYPE_CHANRESETREP].from_410 = PayloadXlate::CHANRESET;
+    for (uint16_t type = cbPKTTYPE_CHANREP; type < cbPKTTYPE_CHANREP + 0x10; ++type) {
+        t[type].from_311 = PayloadXlate::CHANINFO;
+        t[type].from_400 = PayloadXlate::CHANINFO;
+    }
+    // TODO: cbPKT_DINP — needs chaninfo, unavailable here (both directions)
+
+    // Outgoing payload differences (current → device)
+    t[cbPKTTYPE_NPLAYSET].to_311 = PayloadXlate::NPLAY;
+    t[cbPKTTYPE_COMMENTSET].to_311 = PayloadXlate::COMMENT;
+    t[cbPKTTYPE_SYSPROTOCOLMONITOR].to_311 = PayloadXlate::PROTOCOL_MONITOR;
+    t[cbPKTTYPE_SYSPROTOCOLMONITOR].to_400 = PayloadXlate::PROTOCOL_MONITOR;
+    t[cbPKTTYPE_CHANRESET].to_311 = PayloadXlate::CHANRESET;
+    t[cbPKTTYPE_CHANRESET].to_400 = PayloadXlate::CHANRESET;
+    t[cbPKTTYPE_CHANRESET].to_410 = PayloadXlate::CHANRESET;
+    t[cbPKTTYPE_PREVSETLNC].to_311 = PayloadXlate::PREVLNC_TYPE;
+    t[cbPKTTYPE_PREVSETLNC].to_400 = PayloadXlate::PREVLNC_TYPE;
+    t[cbPKTTYPE_PREVSETLNC].to_410 = PayloadXlate::PREVLNC_TYPE;
+    for (uint16_t type = cbPKTTYPE_CHANSET; type < cbPKTTYPE_CHANSET + 0x10; ++type) {
+        t[type].to_311 = PayloadXlate::CHANINFO;
+        t[type].to_400 = PayloadXlate::CHANINFO;
+    }
+
+    return t;
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Packet Traits Lookup
+/// @{
+
+/// Traits for every configuration packet type, indexed by (8-bit) type
+inline constexpr std::array<PacketTypeTraits, 256> CONFIG_PACKET_TRAITS = detail::buildConfigTraits();
+
+/// Traits shared by all continuous group packets
+inline constexpr PacketTypeTraits GROUP_PACKET_TRAITS =
+    detail::makeTraits(PacketClass::GROUP, ConfigSlot::NONE, 0, (cbNUM_ANALOG_CHANS + 1) / 2);
+
+/// Traits shared by all channel event packets
+inline constexpr PacketTypeTraits EVENT_PACKET_TRAITS = detail::makeTraits(PacketClass::EVENT);
+
+/// Traits for configuration types beyond 8 bits (none are defined)
+inline constexpr PacketTypeTraits UNKNOWN_CONFIG_TRAITS = detail::makeTraits(PacketClass::CONFIG);
+
+/// @brief Classify a packet from its channel id
+constexpr PacketClass classifyPacket(uint16_t chid) {
+    return (chid & cbPKTCHAN_CONFIGURATION) ? PacketClass::CONFIG
+         : (chid == 0 ? PacketClass::GROUP : PacketClass::EVENT);
+}
+
+/// @brief Look up the traits for a packet header's (chid, type)
+constexpr const PacketTypeTraits& packetTraits(uint16_t chid, uint16_t type) {
+    if (chid & cbPKTCHAN_CONFIGURATION) {
+        return type < CONFIG_PACKET_TRAITS.size() ? CONFIG_PACKET_TRAITS[type] : UNKNOWN_CONFIG_TRAITS;
+    }
+    return chid == 0 ? GROUP_PACKET_TRAITS : EVENT_PACKET_TRAITS;
+}
+
+/// @brief Look up the traits for a packet header
+inline const PacketTypeTraits& packetTraits(const cbPKT_HEADER& header) {
+    return packetTraits(header.chid, header.type);
+}
+
+/// @brief Whether @p header is a configuration packet too short for its type (or, where a
+/// type sets one, longer than its maximum)
+///
+/// Dispatchers read configuration packets as the struct of their slot, so receive paths drop
+/// these rather than read past the end of the packet.
+inline bool isMalformedConfigPacket(const cbPKT_HEADER& header) {
+    const auto& traits = packetTraits(header);
+    return traits.cls == PacketClass::CONFIG && !traits.dlenInRange(header.dlen);
+}
+
+/// @brief Store the configuration reply at @p packet into @p out
+///
+/// Copies the smaller of the packet and the struct: fields a longer reply appends are not
+/// known to this build, and the tail of @p out past a short reply (dlen between min_dlen and
+/// the struct's size) keeps its previous value.
+template <typename T>
+inline void copyConfigPacket(const uint8_t* packet, T& out) {
+    const auto& header = *reinterpret_cast<const cbPKT_HEADER*>(packet);
+    const size_t size = cbPKT_HEADER_SIZE + static_cast<size_t>(header.dlen) * 4;
+    std::memcpy(&out, packet, std::min(sizeof(T), size));
+}
+
+/// @}
+
+} // namespace cbproto
+
+#endif // CBPROTO_PACKET_TRAITS_H
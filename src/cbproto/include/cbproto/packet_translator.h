@@ -6,6 +6,7 @@
 #define CBPROTO_PACKET_TRANSLATOR_H
 
 #include <cbproto/cbproto.h>
+#include <cbproto/packet_traits.h>
 #include <cstddef>  // for size_t
 #include <cstdint>  // for uint8_t
 #include <cstring>  // for std::memcpy
@@ -46,24 +47,19 @@ public:
         const auto* src_payload = &src[HEADER_SIZE_311];
         auto& dest_header = *reinterpret_cast<cbPKT_HEADER*>(dest);
 
-        switch (dest_header.type) {
-        case cbPKTTYPE_NPLAYREP:
+        switch (packetTraits(dest_header).from_311) {
+        case PayloadXlate::NPLAY:
             return translate_NPLAY_pre400_to_current(src_payload, reinterpret_cast<cbPKT_NPLAY *>(dest));
-        case cbPKTTYPE_COMMENTREP:
+        case PayloadXlate::COMMENT:
             return translate_COMMENT_pre400_to_current(
                 src_payload, reinterpret_cast<cbPKT_COMMENT *>(dest), *reinterpret_cast<const uint32_t*>(src));
-        case cbPKTTYPE_SYSPROTOCOLMONITOR:
-            // cbPKTTYPE_SYSPROTOCOLMONITOR == 0x01 == cbPKTTYPE_PREVREPLNC (pre-4.2)
-            // SYSPROTOCOLMONITOR translation takes priority; PREVREPLNC remap is N/A for 3.11
+        case PayloadXlate::PROTOCOL_MONITOR:
             return translate_SYSPROTOCOLMONITOR_pre410_to_current(src_payload, reinterpret_cast<cbPKT_SYSPROTOCOLMONITOR*>(dest));
-        case cbPKTTYPE_CHANRESETREP:
+        case PayloadXlate::CHANRESET:
             return translate_CHANRESET_pre420_to_current(src_payload, reinterpret_cast<cbPKT_CHANRESET*>(dest));
+        case PayloadXlate::CHANINFO:
+            return translate_CHANINFO_pre410_to_current(src_payload, reinterpret_cast<cbPKT_CHANINFO *>(dest));
         default:
-            // CHANREP family (0x40-0x4F) — bitmask check, can't be a case label
-            if ((dest_header.type & 0xF0) == cbPKTTYPE_CHANREP) {
-                return translate_CHANINFO_pre410_to_current(src_payload, reinterpret_cast<cbPKT_CHANINFO *>(dest));
-            }
-            // TODO: cbPKT_DINP — needs chaninfo, unavailable here
             break;
         }
 
@@ -83,16 +79,14 @@ public:
         auto& dest_header = *reinterpret_cast<cbPKT_HEADER*>(dest);
         const auto* src_payload = &src[HEADER_SIZE_400];
 
-        switch (dest_header.type) {
-        case cbPKTTYPE_SYSPROTOCOLMONITOR:
-            // cbPKTTYPE_SYSPROTOCOLMONITOR == 0x01; PREVREPLNC remap is N/A for 4.0
+        switch (packetTraits(dest_header).from_400) {
+        case PayloadXlate::PROTOCOL_MONITOR:
             return translate_SYSPROTOCOLMONITOR_pre410_to_current(src_payload, reinterpret_cast<cbPKT_SYSPROTOCOLMONITOR*>(dest));
-        case cbPKTTYPE_CHANRESETREP:
+        case PayloadXlate::CHANRESET:
             return translate_CHANRESET_pre420_to_current(src_payload, reinterpret_cast<cbPKT_CHANRESET*>(dest));
+        case PayloadXlate::CHANINFO:
+            return translate_CHANINFO_pre410_to_current(src_payload, reinterpret_cast<cbPKT_CHANINFO *>(dest));
         default:
-            if ((dest_header.type & 0xF0) == cbPKTTYPE_CHANREP) {
-                return translate_CHANINFO_pre410_to_current(src_payload, reinterpret_cast<cbPKT_CHANINFO *>(dest));
-            }
             break;
         }
 
@@ -109,11 +103,11 @@ public:
         // For 410 to current, we do not use an intermediate buffer; src and dest are the same!
         const auto* src_payload = &src[HEADER_SIZE_410];
         auto& dest_header = *reinterpret_cast<cbPKT_HEADER*>(dest);
-        switch (dest_header.type) {
-        case cbPKTTYPE_CHANRESETREP:
+        switch (packetTraits(dest_header).from_410) {
+        case PayloadXlate::CHANRESET:
             return translate_CHANRESET_pre420_to_current(src_payload, reinterpret_cast<cbPKT_CHANRESET*>(dest));
-        case 0x01:
-            dest_header.type = 0x04;
+        case PayloadXlate::PREVLNC_TYPE:
+            dest_header.type = cbPKTTYPE_PREVREPLNC;
             return dest_header.dlen;
         default:
             return dest_header.dlen;
@@ -125,28 +119,26 @@ public:
         auto& dest_header = *reinterpret_cast<cbPKT_HEADER_311*>(dest);
         auto* dest_payload = &dest[HEADER_SIZE_311];
 
-        switch (src.cbpkt_header.type) {
-        case cbPKTTYPE_NPLAYSET:
+        switch (packetTraits(src.cbpkt_header).to_311) {
+        case PayloadXlate::NPLAY:
             return translate_NPLAY_current_to_pre400(
                 *reinterpret_cast<const cbPKT_NPLAY*>(&src), dest_payload);
-        case cbPKTTYPE_COMMENTSET:
+        case PayloadXlate::COMMENT:
             return translate_COMMENT_current_to_pre400(
                 *reinterpret_cast<const cbPKT_COMMENT*>(&src), dest_payload);
-        case cbPKTTYPE_SYSPROTOCOLMONITOR:
+        case PayloadXlate::PROTOCOL_MONITOR:
             return translate_SYSPROTOCOLMONITOR_current_to_pre410(
                 *reinterpret_cast<const cbPKT_SYSPROTOCOLMONITOR*>(&src), dest_payload);
-        case cbPKTTYPE_CHANRESET:
+        case PayloadXlate::CHANRESET:
             return translate_CHANRESET_current_to_pre420(
                 *reinterpret_cast<const cbPKT_CHANRESET*>(&src), dest_payload);
-        case cbPKTTYPE_PREVSETLNC:
+        case PayloadXlate::CHANINFO:
+            return translate_CHANINFO_current_to_pre410(
+                *reinterpret_cast<const cbPKT_CHANINFO*>(&src), dest_payload);
+        case PayloadXlate::PREVLNC_TYPE:
             dest_header.type = 0x81;
             return dest_header.dlen;
         default:
-            if ((src.cbpkt_header.type & 0xF0) == cbPKTTYPE_CHANSET) {
-                return translate_CHANINFO_current_to_pre410(
-                    *reinterpret_cast<const cbPKT_CHANINFO*>(&src), dest_payload);
-            }
-            // TODO: cbPKT_DINP — needs chaninfo, unavailable here
             break;
         }
 
@@ -164,21 +156,20 @@ public:
         auto& dest_header = *reinterpret_cast<cbPKT_HEADER_400*>(dest);
         auto* dest_payload = &dest[HEADER_SIZE_400];
 
-        switch (src.cbpkt_header.type) {
-        case cbPKTTYPE_SYSPROTOCOLMONITOR:
+        switch (packetTraits(src.cbpkt_header).to_400) {
+        case PayloadXlate::PROTOCOL_MONITOR:
             return translate_SYSPROTOCOLMONITOR_current_to_pre410(
                 *reinterpret_cast<const cbPKT_SYSPROTOCOLMONITOR*>(&src), dest_payload);
-        case cbPKTTYPE_CHANRESET:
+        case PayloadXlate::CHANRESET:
             return translate_CHANRESET_current_to_pre420(
                 *reinterpret_cast<const cbPKT_CHANRESET*>(&src), dest_payload);
-        case cbPKTTYPE_PREVSETLNC:
+        case PayloadXlate::CHANINFO:
+            return translate_CHANINFO_current_to_pre410(
+                *reinterpret_cast<const cbPKT_CHANINFO*>(&src), dest_payload);
+        case PayloadXlate::PREVLNC_TYPE:
             dest_header.type = 0x81;
             return dest_header.dlen;
         default:
-            if ((src.cbpkt_header.type & 0xF0) == cbPKTTYPE_CHANSET) {
-                return translate_CHANINFO_current_to_pre410(
-                    *reinterpret_cast<const cbPKT_CHANINFO*>(&src), dest_payload);
-            }
             break;
         }
 
@@ -196,11 +187,11 @@ public:
         // We already copied the entire packet upstream. Here we need to adjust payload only.
         auto& dest_header = *reinterpret_cast<cbPKT_HEADER*>(dest);
         auto* dest_payload = &dest[HEADER_SIZE_410];
-        switch (src.cbpkt_header.type) {
-        case cbPKTTYPE_CHANRESET:
+        switch (packetTraits(src.cbpkt_header).to_410) {
+        case PayloadXlate::CHANRESET:
             return translate_CHANRESET_current_to_pre420(
                 *reinterpret_cast<const cbPKT_CHANRESET*>(&src), dest_payload);
-        case cbPKTTYPE_PREVSETLNC:
+        case PayloadXlate::PREVLNC_TYPE:
             dest_header.type = 0x81;
             return dest_header.dlen;
         default:
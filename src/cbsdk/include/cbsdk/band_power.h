@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   band_power.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Streaming per-channel band power (e.g. beta, high gamma) from continuous group data
+///
+/// Every @c hop samples, the last @c window samples of each channel have their mean removed,
+/// are Hann-windowed and Fourier transformed, and the power of the frequency bins inside each
+/// band is summed.  The FFT plan (bit reversal and twiddles) and every buffer are made once
+/// by create(); the transform runs on all channels at once, with channels contiguous so each
+/// butterfly is a multiply-add across a block of channels (SSE, four channels per
+/// instruction).  A real window of N samples is transformed as an N/2-point complex FFT.
+/// SdkSession::createBandPowerStream() runs one on the callback thread and publishes its
+/// feature vectors to callbacks and a ring buffer.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_BAND_POWER_H
+#define CBSDK_BAND_POWER_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cbsdk {
+
+/// Longest analysis window, in samples
+constexpr size_t BAND_POWER_MAX_WINDOW = 16384;
+
+/// A frequency band, both edges inclusive
+struct FrequencyBand {
+    double low_hz = 0.0;
+    double high_hz = 0.0;
+};
+
+/// Windowing and bands of a BandPowerEngine
+struct BandPowerConfig {
+    size_t window = 256;                ///< FFT length in samples (power of two, 16-BAND_POWER_MAX_WINDOW)
+    size_t hop = 50;                    ///< Samples between feature vectors
+    std::vector<FrequencyBand> bands;   ///< Each must hold at least one bin (width sample rate / window)
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Sliding-window band power of every channel of a sample group
+///
+/// Samples are row-major int16 [n_samples][n_channels], as the batch callbacks deliver them.
+/// Once @c window samples have been seen, a feature vector is produced every @c hop samples:
+/// row-major float [n_channels][n_bands] of mean-square power (raw units squared) in each
+/// band, so a full-scale sine of amplitude A inside a band reads A^2 / 2.  Its timestamp is
+/// that of the newest sample in the window.  Not thread-safe; one engine serves one stream.
+///
+class BandPowerEngine {
+public:
+    /// @param sample_rate_hz Rate of the input samples
+    /// @param channel_count Channels per sample (at least 1)
+    /// @return Error for an invalid window, hop or band
+    static cbutil::Result<BandPowerEngine> create(const BandPowerConfig& config, double sample_rate_hz,
+                                                  size_t channel_count);
+
+    BandPowerEngine(BandPowerEngine&&) noexcept;
+    BandPowerEngine& operator=(BandPowerEngine&&) noexcept;
+    BandPowerEngine(const BandPowerEngine&) = delete;
+    BandPowerEngine& operator=(const BandPowerEngine&) = delete;
+    ~BandPowerEngine();
+
+    /// Upper bound on the feature vectors one process() call of @p n_samples rows can produce
+    [[nodiscard]] size_t maxOutput(size_t n_samples) const;
+
+    /// Consume @p n_samples rows
+    /// @param timestamps Device timestamp of each input row
+    /// @param out Receives up to maxOutput(n_samples) vectors of channelCount() * bandCount() floats
+    /// @param out_timestamps Receives one timestamp per vector
+    /// @return Number of vectors written
+    size_t process(const int16_t* in, const uint64_t* timestamps, size_t n_samples, float* out,
+                   uint64_t* out_timestamps);
+
+    /// Forget all input, as if no samples had been seen
+    void reset();
+
+    [[nodiscard]] const BandPowerConfig& config() const;
+    [[nodiscard]] double sampleRateHz() const;
+    [[nodiscard]] size_t channelCount() const;
+    [[nodiscard]] size_t bandCount() const;
+
+private:
+    BandPowerEngine();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_BAND_POWER_H
@@ -83,6 +83,8 @@ typedef enum {
     CBSDK_RESULT_SHMEM_ERROR         = -4,   ///< Shared memory error
     CBSDK_RESULT_DEVICE_ERROR        = -5,   ///< Device connection error
     CBSDK_RESULT_INTERNAL_ERROR      = -6,   ///< Internal error
+    CBSDK_RESULT_TIMEOUT             = -7,   ///< Operation not acknowledged in time
+    CBSDK_RESULT_FILE_ERROR          = -8,   ///< File missing, unreadable or not in a known format
 } cbsdk_result_t;
 
 /// Channel info field selector for bulk extraction
@@ -102,6 +104,33 @@ typedef enum {
     CBSDK_CHANINFO_FIELD_TERM        = 12,
 } cbsdk_chaninfo_field_t;
 
+/// Pools a re-referenced virtual group subtracts (mirrors cbsdk::ReferenceScheme)
+typedef enum {
+    CBSDK_REFERENCE_COMMON    = 0,   ///< All front-end channels of the group
+    CBSDK_REFERENCE_BANK      = 1,   ///< One pool per bank
+    CBSDK_REFERENCE_HEADSTAGE = 2,   ///< One pool per headstage of the loaded channel maps
+    CBSDK_REFERENCE_ELECTRODE = 3,   ///< Each channel's own reference electrode (refelecchan)
+} cbsdk_reference_scheme_t;
+
+/// Statistic of a re-referencing pool (mirrors cbsdk::ReferenceStatistic)
+typedef enum {
+    CBSDK_REFERENCE_MEAN   = 0,
+    CBSDK_REFERENCE_MEDIAN = 1,
+} cbsdk_reference_statistic_t;
+
+/// How a host spike detection threshold is set (mirrors cbsdk::ThresholdMode)
+typedef enum {
+    CBSDK_THRESHOLD_OFF   = 0,   ///< No detection on the channel
+    CBSDK_THRESHOLD_LEVEL = 1,   ///< Fixed level, in raw sample units
+    CBSDK_THRESHOLD_RMS   = 2,   ///< Multiple of the channel's running RMS
+} cbsdk_threshold_mode_t;
+
+/// Order of the samples a formatted batch callback receives (mirrors cbsdk::SampleLayout)
+typedef enum {
+    CBSDK_SAMPLE_MAJOR  = 0,   ///< [n_samples × n_channels], as the group packets carry them
+    CBSDK_CHANNEL_MAJOR = 1,   ///< [n_channels × n_samples]: each channel's samples contiguous
+} cbsdk_sample_layout_t;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Configuration Structures
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -154,6 +183,230 @@ typedef struct {
     uint64_t send_errors;                    ///< Socket send errors
 } cbsdk_stats_t;
 
+/// Latency percentiles of one pipeline stage, in nanoseconds (C version of LatencySummary)
+typedef struct {
+    uint64_t count;     ///< Sampled packets (all other fields are 0 when this is 0)
+    uint64_t min_ns;
+    uint64_t p50_ns;
+    uint64_t p90_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    uint64_t max_ns;
+    double mean_ns;
+} cbsdk_latency_summary_t;
+
+/// Per-stage latency of sampled data packets (C version of LatencyStats; STANDALONE mode only)
+typedef struct {
+    cbsdk_latency_summary_t device_to_arrival;    ///< Device timestamp -> socket (needs clock sync)
+    cbsdk_latency_summary_t arrival_to_store;     ///< Socket -> shared memory
+    cbsdk_latency_summary_t store_to_dequeue;     ///< Shared memory -> callback thread
+    cbsdk_latency_summary_t dequeue_to_callback;  ///< Callback thread -> user callbacks returned
+    cbsdk_latency_summary_t device_to_callback;   ///< Whole pipeline (needs clock sync)
+} cbsdk_latency_stats_t;
+
+/// Local recorder counters (C version of RecorderStats)
+typedef struct {
+    uint64_t continuous_packets;    ///< Group packets written to NSx files
+    uint64_t spike_packets;         ///< Spike packets written to the NEV file
+    uint64_t digital_packets;       ///< Digital input packets written to the NEV file
+    uint64_t bytes_written;         ///< File bytes written, headers included
+    uint64_t packets_dropped;       ///< Discarded because the writer fell too far behind
+    uint64_t write_errors;          ///< Failed writes (the recording stops on the first one)
+    uint64_t pending_bytes;         ///< Packet bytes waiting for the writer thread
+    bool direct_io;                 ///< Whether the files bypass the page cache
+} cbsdk_recording_stats_t;
+
+/// Layout of a recorded continuous file (NSx or compressed .cbz)
+typedef struct {
+    uint32_t channel_count;         ///< Columns per row
+    uint64_t sample_count;          ///< Rows in the file
+    uint32_t period;                ///< Sample period in 1/30000 s
+    uint32_t time_resolution;       ///< Timestamp ticks per second
+    uint32_t segment_count;         ///< Entries in the sparse timestamp index
+    bool compressed;                ///< Compressed file (no zero-copy views)
+} cbsdk_continuous_file_info_t;
+
+/// Layout of a recorded NEV file
+typedef struct {
+    uint64_t packet_count;          ///< Complete packets in the file
+    uint32_t bytes_per_packet;
+    uint32_t time_resolution;       ///< Timestamp ticks per second
+    uint32_t waveform_samples;      ///< int16 words of payload per packet
+} cbsdk_event_file_info_t;
+
+/// Host-side filter design (C version of FilterSpec); frequencies in mHz, 0 disables a stage
+typedef struct {
+    uint32_t hpfreq;            ///< High-pass corner
+    uint32_t hporder;           ///< High-pass order (1-16)
+    uint32_t hptype;            ///< 0 or cbFILTTYPE_BUTTERWORTH
+    uint32_t lpfreq;            ///< Low-pass corner
+    uint32_t lporder;           ///< Low-pass order (1-16)
+    uint32_t lptype;            ///< 0 or cbFILTTYPE_BUTTERWORTH
+    uint32_t notch_freq;        ///< Notch centre
+    uint32_t notch_bandwidth;   ///< Notch -3 dB width
+} cbsdk_filter_spec_t;
+
+/// Block sizes a batch callback receives (C version of BatchPolicy); all zero: as drained
+typedef struct {
+    uint32_t min_samples;       ///< Hold rows until this many are buffered (0: none)
+    uint32_t max_samples;       ///< Split larger blocks (0: no limit; else >= min_samples)
+    uint32_t max_delay_us;      ///< Deliver a short block once its oldest row has waited this long
+                                ///< (0: no limit; else min_samples >= 2)
+} cbsdk_batch_policy_t;
+
+/// Description and counters of a virtual sample group (C version of VirtualGroupInfo)
+typedef struct {
+    uint32_t kind;                  ///< 0: resampled, 1: re-referenced
+    cbproto_group_rate_t source;    ///< Group it is derived from
+    uint32_t up;                    ///< Resampling factors, in lowest terms
+    uint32_t down;
+    double sample_rate_hz;          ///< Output rate
+    double group_delay;             ///< Filter delay, in source samples
+    uint32_t channel_count;         ///< Channels per sample (0 until data arrives)
+    uint32_t buffer_capacity;       ///< Samples the ring buffer holds
+    uint32_t buffered;              ///< Samples waiting in the ring buffer
+    uint64_t samples_produced;      ///< Output samples since creation
+    uint64_t samples_overwritten;   ///< Samples dropped from a full ring buffer unread
+} cbsdk_virtual_group_info_t;
+
+/// A frequency band, both edges inclusive (C version of FrequencyBand)
+typedef struct {
+    double low_hz;
+    double high_hz;
+} cbsdk_frequency_band_t;
+
+/// Source and windowing of a band power stream (C version of BandPowerConfig plus its source)
+typedef struct {
+    cbproto_group_rate_t source;    ///< Device group to analyse (ignored if virtual_group is set)
+    uint32_t virtual_group;         ///< Virtual group to analyse instead (0: none)
+    uint32_t window;                ///< FFT length in samples (power of two, 16-16384)
+    uint32_t hop;                   ///< Samples between feature vectors
+} cbsdk_band_power_config_t;
+
+/// Description and counters of a band power stream (C version of BandPowerStreamInfo)
+typedef struct {
+    cbproto_group_rate_t source;    ///< Device group it is computed from
+    uint32_t virtual_group;         ///< Virtual group it is computed from (0: the device group)
+    double sample_rate_hz;          ///< Rate of the input samples
+    uint32_t window;
+    uint32_t hop;
+    uint32_t band_count;
+    uint32_t channel_count;         ///< Channels per vector (0 until data arrives)
+    uint32_t buffer_capacity;       ///< Vectors the ring buffer holds
+    uint32_t buffered;              ///< Vectors waiting in the ring buffer
+    uint64_t frames_produced;       ///< Vectors since creation
+    uint64_t frames_overwritten;    ///< Vectors dropped from a full ring buffer unread
+} cbsdk_band_power_info_t;
+
+/// Source, window and triggers of an epoch stream (C version of EpochConfig and EpochTriggers);
+/// the trigger channels are passed separately
+typedef struct {
+    cbproto_group_rate_t source;    ///< Device group to cut from
+    uint32_t pre_samples;           ///< Samples before the trigger sample
+    uint32_t post_samples;          ///< Samples from the trigger sample on (at least 1)
+    uint32_t max_delay_samples;     ///< How many samples late an event may arrive
+    uint32_t max_pending;           ///< Events waiting for their post window at once
+    uint32_t unit_mask;             ///< Spike units that trigger (bit u = unit u)
+    bool comments;                  ///< Comments trigger too
+} cbsdk_epoch_config_t;
+
+/// The event an epoch is cut around (C version of EpochEvent)
+typedef struct {
+    uint64_t time;                  ///< Device time of the event
+    uint64_t trigger_time;          ///< Device time of the trigger sample (first at or after time)
+    uint32_t chan_id;               ///< Channel the event came from (0 for a comment)
+    uint32_t value;                 ///< Spike unit, digital/serial input value, or 0 for a comment
+} cbsdk_epoch_event_t;
+
+/// Description and counters of an epoch stream (C version of EpochStreamInfo)
+typedef struct {
+    cbproto_group_rate_t source;    ///< Device group the epochs are cut from
+    uint32_t pre_samples;
+    uint32_t post_samples;
+    uint32_t channel_count;         ///< Channels per row (0 until data arrives)
+    uint32_t pending;               ///< Events waiting for their post window
+    uint32_t buffer_capacity;       ///< Epochs the ring buffer holds
+    uint32_t buffered;              ///< Epochs waiting in the ring buffer
+    uint64_t epochs_produced;       ///< Epochs since creation
+    uint64_t epochs_overwritten;    ///< Epochs dropped from a full ring buffer unread
+    uint64_t events_late;           ///< Events whose window had left the history
+    uint64_t events_dropped;        ///< Events over max_pending, or pending at a clock restart
+} cbsdk_epoch_info_t;
+
+/// Threshold of one channel (C version of SpikeThreshold); the sign selects the crossing direction
+typedef struct {
+    cbsdk_threshold_mode_t mode;
+    int16_t level;                  ///< CBSDK_THRESHOLD_LEVEL: crossing level (non-zero)
+    float rms_multiplier;           ///< CBSDK_THRESHOLD_RMS: level = multiplier * RMS, e.g. -4.5
+} cbsdk_spike_threshold_t;
+
+/// Host spike detection settings (C version of SpikeDetectionConfig)
+typedef struct {
+    cbproto_group_rate_t source;        ///< Group to detect on
+    cbsdk_filter_spec_t filter;         ///< Applied before detection (all stages 0: none)
+    cbsdk_spike_threshold_t threshold;  ///< Initial threshold of the front-end channels
+    uint32_t refractory_samples;        ///< Minimum samples between spikes on a channel
+    uint32_t rms_window;                ///< Samples the RMS thresholds average over
+} cbsdk_spike_detection_config_t;
+
+/// Spike binning settings (C version of SpikeBinnerConfig); times in device units (ns)
+typedef struct {
+    uint64_t bin_width;             ///< Bin length, e.g. 20000000 (20 ms)
+    uint64_t latency;               ///< How long after its end a bin accepts late spikes
+    uint32_t channel_count;         ///< Matrix rows: channel IDs 1..channel_count (at most cbNUM_ANALOG_CHANS)
+    uint32_t unit_count;            ///< Matrix columns: unit 0 (unsorted) .. unit_count - 1
+    uint32_t buffer_bins;           ///< Closed bins kept for cbsdk_session_read_spike_bins()
+} cbsdk_spike_binning_config_t;
+
+/// Spike binning counters (C version of SpikeBinnerStats)
+typedef struct {
+    uint64_t spikes_counted;        ///< Spikes added to a bin
+    uint64_t spikes_late;           ///< Spikes older than every open bin (dropped)
+    uint64_t spikes_ignored;        ///< Spikes on a channel or unit outside the matrix
+    uint64_t bins_closed;           ///< Bins closed (including empty ones)
+    uint64_t bins_skipped;          ///< Empty bins of long gaps in device time never closed
+    uint64_t bins_overwritten;      ///< Closed bins dropped from the history unread
+} cbsdk_spike_binning_stats_t;
+
+/// One digital or serial input packet (C version of DigitalInputEvent)
+typedef struct {
+    uint64_t time;                  ///< Device time of the packet
+    uint32_t chan_id;
+    uint32_t value;                 ///< Word after the packet
+    uint32_t rising;                ///< Bits that went from 0 to 1
+    uint32_t falling;               ///< Bits that went from 1 to 0
+} cbsdk_digital_input_event_t;
+
+/// Digital input tracking counters (C version of DigitalInputStats)
+typedef struct {
+    uint64_t events;                ///< Packets logged since tracking started
+    uint64_t edges_rising;          ///< Rising bit edges since tracking started
+    uint64_t edges_falling;         ///< Falling bit edges since tracking started
+} cbsdk_digital_input_stats_t;
+
+/// Host spike sorting settings (C version of SpikeSortingConfig)
+typedef struct {
+    float gate;                     ///< Largest squared Mahalanobis distance to a unit's centre
+    uint32_t threads;               ///< Worker threads besides the callback thread's
+    bool device_spikes;             ///< Also sort unsorted device-extracted spikes
+} cbsdk_spike_sorting_config_t;
+
+/// One cluster of a host-supplied sort model (C version of SortUnit)
+typedef struct {
+    uint32_t unit;                  ///< Unit number (1-5, or 255 for noise)
+    float mean[2];                  ///< Cluster centre in the first two pattern components
+    float inv_covariance[2][2];     ///< Inverse covariance
+    float log_determinant;          ///< log |covariance|
+} cbsdk_sort_unit_t;
+
+/// Host spike sorting counters (C version of SpikeSorterStats)
+typedef struct {
+    uint64_t spikes_sorted;         ///< Spikes assigned to a unit
+    uint64_t spikes_noise;          ///< Spikes classified as noise
+    uint64_t spikes_unsorted;       ///< Modelled spikes that matched no unit
+    uint64_t spikes_unmodelled;     ///< Spikes on channels without a model (left as they were)
+} cbsdk_spike_sorting_stats_t;
+
 /// Channel scaling information (mirrors cbSCALING from cbproto)
 typedef struct {
     int16_t  digmin;     ///< Digital value corresponding to anamin
@@ -198,6 +451,46 @@ typedef void (*cbsdk_group_batch_callback_fn)(const int16_t* samples, size_t n_s
                                                size_t n_channels, const uint64_t* timestamps,
                                                void* user_data);
 
+/// Scaled batch callback — a group's samples in physical units (µV for voltages)
+/// @param samples n_samples × n_channels floats, in the layout given when registering
+/// @param n_samples Number of samples (packets) in this batch
+/// @param n_channels Number of channels per sample
+/// @param timestamps Device timestamp for each sample (array of n_samples)
+/// @param user_data User data pointer passed to registration function
+typedef void (*cbsdk_scaled_group_batch_callback_fn)(const float* samples, size_t n_samples,
+                                                      size_t n_channels, const uint64_t* timestamps,
+                                                      void* user_data);
+
+/// Band power callback — the feature vectors one batch completed
+/// @param features Band power [n_frames × n_channels × n_bands], row-major
+/// @param n_frames Number of feature vectors
+/// @param n_channels Channels per vector
+/// @param n_bands Bands per channel
+/// @param timestamps Device timestamp of the newest sample in each vector's window
+/// @param user_data User data pointer passed to registration function
+typedef void (*cbsdk_band_power_callback_fn)(const float* features, size_t n_frames, size_t n_channels,
+                                              size_t n_bands, const uint64_t* timestamps, void* user_data);
+
+/// Epoch callback — one completed peri-event window
+/// @param event The triggering event
+/// @param samples Contiguous int16 sample data [n_samples × n_channels], row-major
+/// @param n_samples pre_samples + post_samples
+/// @param n_channels Channels per row
+/// @param timestamps Device timestamp of each row
+/// @param user_data User data pointer passed to registration function
+typedef void (*cbsdk_epoch_callback_fn)(const cbsdk_epoch_event_t* event, const int16_t* samples,
+                                         size_t n_samples, size_t n_channels, const uint64_t* timestamps,
+                                         void* user_data);
+
+/// Spike bin callback — one completed bin of spike counts
+/// @param start_time Device time the bin starts at
+/// @param counts Spike counts [n_channels × n_units], row-major (row = channel ID - 1)
+/// @param n_channels Channels (rows) of the matrix
+/// @param n_units Units (columns) of the matrix
+/// @param user_data User data pointer passed to registration function
+typedef void (*cbsdk_spike_bin_callback_fn)(uint64_t start_time, const uint32_t* counts,
+                                             size_t n_channels, size_t n_units, void* user_data);
+
 /// Config callback for system/configuration packets (chid & 0x8000)
 /// @param pkt Pointer to the config packet
 /// @param user_data User data pointer passed to registration function
@@ -208,6 +501,13 @@ typedef void (*cbsdk_config_callback_fn)(const cbPKT_GENERIC* pkt, void* user_da
 /// @param user_data User data pointer passed to registration function
 typedef void (*cbsdk_error_callback_fn)(const char* error_message, void* user_data);
 
+/// Completion callback for asynchronous configuration operations.
+/// Runs on the SDK thread that observed the final CHANREP (or the deadline) — keep it short.
+/// @param result CBSDK_RESULT_SUCCESS once every channel acknowledged, CBSDK_RESULT_TIMEOUT
+///        if the deadline passed first, CBSDK_RESULT_INTERNAL_ERROR on send failure/shutdown
+/// @param user_data User data pointer passed to the *_async function
+typedef void (*cbsdk_config_complete_fn)(cbsdk_result_t result, void* user_data);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Opaque Handle
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -215,6 +515,15 @@ typedef void (*cbsdk_error_callback_fn)(const char* error_message, void* user_da
 /// Opaque session handle (do not access fields directly)
 typedef struct cbsdk_session_impl* cbsdk_session_t;
 
+/// Opaque handle to an in-flight asynchronous configuration operation
+typedef struct cbsdk_config_op_impl* cbsdk_config_op_t;
+
+/// Opaque handle to an open continuous (NSx / .cbz) file
+typedef struct cbsdk_continuous_reader_impl* cbsdk_continuous_reader_t;
+
+/// Opaque handle to an open NEV file
+typedef struct cbsdk_event_reader_impl* cbsdk_event_reader_t;
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Configuration Functions
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -223,6 +532,21 @@ typedef struct cbsdk_session_impl* cbsdk_session_t;
 /// @return Default configuration structure
 CBSDK_API cbsdk_config_t cbsdk_config_default(void);
 
+/// Get default host spike detection settings: raw group, 250 Hz 4th-order high-pass,
+/// -4.5 x RMS over one second, 1 ms refractory period
+CBSDK_API cbsdk_spike_detection_config_t cbsdk_spike_detection_config_default(void);
+
+/// Get default epoch settings: raw group, 10 ms before and 20 ms after each event (at 30 kHz),
+/// events up to 100 ms late, 64 pending events, every spike unit, no comments
+CBSDK_API cbsdk_epoch_config_t cbsdk_epoch_config_default(void);
+
+/// Get default spike binning settings: 20 ms bins accepting spikes 10 ms late,
+/// 272 channels x 6 units, 500 bins (10 s) of history
+CBSDK_API cbsdk_spike_binning_config_t cbsdk_spike_binning_config_default(void);
+
+/// Get default host spike sorting settings: 99 % gate (9.21), sorted inline, device spikes too
+CBSDK_API cbsdk_spike_sorting_config_t cbsdk_spike_sorting_config_default(void);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Session Management
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -328,6 +652,95 @@ CBSDK_API cbsdk_callback_handle_t cbsdk_session_register_group_batch_callback(
     cbsdk_group_batch_callback_fn callback,
     void* user_data);
 
+/// Register batch callback that receives group samples after a host-side IIR filter.
+/// The filter is designed for the group's sample rate (Butterworth high/low-pass plus an
+/// optional notch) and keeps its own state; samples are rounded and saturated to int16.
+/// @param session Session handle (must not be NULL)
+/// @param rate Sample rate to match
+/// @param spec Filter to design (must not be NULL)
+/// @param callback Callback function (must not be NULL)
+/// @param user_data User data pointer passed to callback
+/// @return Handle for unregistration, or 0 on failure (including an invalid design)
+CBSDK_API cbsdk_callback_handle_t cbsdk_session_register_filtered_group_batch_callback(
+    cbsdk_session_t session,
+    cbproto_group_rate_t rate,
+    const cbsdk_filter_spec_t* spec,
+    cbsdk_group_batch_callback_fn callback,
+    void* user_data);
+
+/// Register batch callback that receives only some channels of a group, optionally filtered.
+/// Only those columns are copied out of each group packet, in the order given.  The channels
+/// are looked up in the group when registering: register again after changing membership.
+/// @param session Session handle (must not be NULL)
+/// @param rate Sample rate to match
+/// @param chan_ids 1-based channel IDs, each a member of the group (must not be NULL)
+/// @param n_chans Number of channel IDs
+/// @param spec Filter to design and run on those channels (NULL: unfiltered)
+/// @param callback Callback function (must not be NULL)
+/// @param user_data User data pointer passed to callback
+/// @return Handle for unregistration, or 0 on failure (including a channel not in the group
+///         or an invalid design)
+CBSDK_API cbsdk_callback_handle_t cbsdk_session_register_channel_group_batch_callback(
+    cbsdk_session_t session,
+    cbproto_group_rate_t rate,
+    const uint32_t* chan_ids,
+    uint32_t n_chans,
+    const cbsdk_filter_spec_t* spec,
+    cbsdk_group_batch_callback_fn callback,
+    void* user_data);
+
+/// Register batch callback that receives int16 group samples in a chosen layout.
+/// CHANNEL_MAJOR batches are transposed by the SDK after filtering.  Channels are looked up
+/// in the group when registering: register again after changing membership.  A policy
+/// buffers the rows in the SDK and re-cuts them, e.g. max_samples = 1 for every sample as
+/// soon as it arrives, or min_samples = max_samples = N for blocks of exactly N.
+/// @param session Session handle (must not be NULL)
+/// @param rate Sample rate to match
+/// @param chan_ids 1-based channel IDs to deliver, in order (NULL: the whole group)
+/// @param n_chans Number of channel IDs
+/// @param spec Filter to design and run on those channels (NULL: unfiltered)
+/// @param layout Order of the delivered samples
+/// @param policy Block sizes to deliver (NULL: as drained)
+/// @param callback Callback function (must not be NULL)
+/// @param user_data User data pointer passed to callback
+/// @return Handle for unregistration, or 0 on failure (including a channel not in the group,
+///         an empty group, an invalid design or an invalid policy)
+CBSDK_API cbsdk_callback_handle_t cbsdk_session_register_formatted_group_batch_callback(
+    cbsdk_session_t session,
+    cbproto_group_rate_t rate,
+    const uint32_t* chan_ids,
+    uint32_t n_chans,
+    const cbsdk_filter_spec_t* spec,
+    cbsdk_sample_layout_t layout,
+    const cbsdk_batch_policy_t* policy,
+    cbsdk_group_batch_callback_fn callback,
+    void* user_data);
+
+/// Register batch callback that receives group samples as float physical units (µV for
+/// voltages), scaled with each channel's input scaling as read when registering.  Scaling
+/// and, for CHANNEL_MAJOR, transposition run in one pass inside the SDK.
+/// @param session Session handle (must not be NULL)
+/// @param rate Sample rate to match
+/// @param chan_ids 1-based channel IDs to deliver, in order (NULL: the whole group)
+/// @param n_chans Number of channel IDs
+/// @param spec Filter to design and run before scaling (NULL: unfiltered)
+/// @param layout Order of the delivered samples
+/// @param policy Block sizes to deliver (NULL: as drained)
+/// @param callback Callback function (must not be NULL)
+/// @param user_data User data pointer passed to callback
+/// @return Handle for unregistration, or 0 on failure (including a channel not in the group,
+///         an empty group, an invalid design or an invalid policy)
+CBSDK_API cbsdk_callback_handle_t cbsdk_session_register_scaled_group_batch_callback(
+    cbsdk_session_t session,
+    cbproto_group_rate_t rate,
+    const uint32_t* chan_ids,
+    uint32_t n_chans,
+    const cbsdk_filter_spec_t* spec,
+    cbsdk_sample_layout_t layout,
+    const cbsdk_batch_policy_t* policy,
+    cbsdk_scaled_group_batch_callback_fn callback,
+    void* user_data);
+
 /// Register callback for config/system packets
 /// @param session Session handle (must not be NULL)
 /// @param packet_type Packet type to match (e.g., cbPKTTYPE_COMMENTREP, cbPKTTYPE_SYSREPRUNLEV)
@@ -373,7 +786,12 @@ CBSDK_API void cbsdk_session_unregister_callback(cbsdk_session_t session,
 /// @param[out] stats Pointer to receive statistics (must not be NULL)
 CBSDK_API void cbsdk_session_get_stats(cbsdk_session_t session, cbsdk_stats_t* stats);
 
-/// Reset statistics counters to zero
+/// Get per-stage latency percentiles of sampled data packets
+/// @param session Session handle (must not be NULL)
+/// @param[out] stats Pointer to receive latency statistics (must not be NULL)
+CBSDK_API void cbsdk_session_get_latency_stats(cbsdk_session_t session, cbsdk_latency_stats_t* stats);
+
+/// Reset statistics counters and latency histograms to zero
 /// @param session Session handle (must not be NULL)
 CBSDK_API void cbsdk_session_reset_stats(cbsdk_session_t session);
 
@@ -1046,6 +1464,645 @@ CBSDK_API cbsdk_result_t cbsdk_session_open_central_file_dialog(cbsdk_session_t
 /// @return CBSDK_RESULT_SUCCESS on success, error code on failure
 CBSDK_API cbsdk_result_t cbsdk_session_close_central_file_dialog(cbsdk_session_t session);
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Local Recording (NSx/NEV files written by this process)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Start recording continuous groups and spike / digital input events to NSx/NEV files
+/// Creates "<base_path>.nev" and one "<base_path>.ns<group>" per group with channels.
+/// A dedicated writer thread does all disk I/O.  Works in STANDALONE and CLIENT mode.
+/// @param session Session handle (must not be NULL)
+/// @param base_path Output path without extension (must not be NULL)
+/// @param comment Comment stored in the file headers (can be NULL)
+/// @return CBSDK_RESULT_SUCCESS on success, CBSDK_RESULT_ALREADY_RUNNING if already recording,
+///         error code on failure
+CBSDK_API cbsdk_result_t cbsdk_session_start_recording(
+    cbsdk_session_t session,
+    const char* base_path,
+    const char* comment);
+
+/// Write out everything queued and close the recording files (no-op if not recording)
+/// @param session Session handle (must not be NULL)
+CBSDK_API void cbsdk_session_stop_recording(cbsdk_session_t session);
+
+/// Check whether a local recording is running
+/// @param session Session handle (must not be NULL)
+/// @return true while recording
+CBSDK_API bool cbsdk_session_is_recording(cbsdk_session_t session);
+
+/// Get the counters of the running recording, or of the last one once stopped
+/// @param session Session handle (must not be NULL)
+/// @param[out] stats Pointer to receive the counters (must not be NULL)
+CBSDK_API void cbsdk_session_get_recording_stats(cbsdk_session_t session, cbsdk_recording_stats_t* stats);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Virtual Sample Groups
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A virtual group is a device group processed once per batch on the callback thread:
+// resampled by a polyphase FIR (see cbsdk/resampler.h), e.g. 1 kHz LFP from the 30 kHz raw
+// group, or re-referenced (see cbsdk/rereference.h).  Its output goes to a ring buffer and to
+// its own batch callbacks, however many consumers there are.
+
+/// Create a group at up / down times the rate of a device group
+/// @param session Session handle (must not be NULL)
+/// @param source Group to resample (CBPROTO_GROUP_RATE_500Hz through CBPROTO_GROUP_RATE_RAW)
+/// @param up Interpolation factor (1-256)
+/// @param down Decimation factor (1-256), e.g. 30 for 1 kHz from the raw group
+/// @param buffer_samples Ring buffer capacity in output samples (0: callbacks only)
+/// @param[out] group Receives the new group's id (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER for a bad source or factor
+CBSDK_API cbsdk_result_t cbsdk_session_create_resampled_group(
+    cbsdk_session_t session,
+    cbproto_group_rate_t source,
+    uint32_t up,
+    uint32_t down,
+    uint32_t buffer_samples,
+    uint32_t* group);
+
+/// Create a group that is a device group re-referenced, at the same rate
+///
+/// Pools (or reference electrodes) are planned from the group's channels and their bank,
+/// channel-map headstage or refelecchan at creation; recreate the group after changing them.
+/// Only front-end channels are pooled; other channels pass through unchanged.
+/// @param session Session handle (must not be NULL)
+/// @param source Group to re-reference
+/// @param scheme Pools to reference each channel to
+/// @param statistic Mean or median of each pool (ignored for CBSDK_REFERENCE_ELECTRODE)
+/// @param buffer_samples Ring buffer capacity in samples (0: callbacks only)
+/// @param[out] group Receives the new group's id (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER for a bad source or a
+///         group without channels
+CBSDK_API cbsdk_result_t cbsdk_session_create_rereferenced_group(
+    cbsdk_session_t session,
+    cbproto_group_rate_t source,
+    cbsdk_reference_scheme_t scheme,
+    cbsdk_reference_statistic_t statistic,
+    uint32_t buffer_samples,
+    uint32_t* group);
+
+/// Stop a virtual group and drop its batch callbacks
+/// @param session Session handle (must not be NULL)
+/// @param group Id of a virtual group
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if the group does not exist
+CBSDK_API cbsdk_result_t cbsdk_session_destroy_virtual_group(cbsdk_session_t session, uint32_t group);
+
+/// Register a batch callback for a virtual group's output
+/// @param session Session handle (must not be NULL)
+/// @param group Id of a virtual group
+/// @param callback Callback function (must not be NULL)
+/// @param user_data User data pointer passed to callback
+/// @return Handle for unregistration, or 0 on failure (including an unknown group)
+CBSDK_API cbsdk_callback_handle_t cbsdk_session_register_virtual_group_batch_callback(
+    cbsdk_session_t session,
+    uint32_t group,
+    cbsdk_group_batch_callback_fn callback,
+    void* user_data);
+
+/// Get the description and counters of a virtual group
+/// @param session Session handle (must not be NULL)
+/// @param group Id of a virtual group
+/// @param[out] info Receives the description (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if the group does not exist
+CBSDK_API cbsdk_result_t cbsdk_session_get_virtual_group_info(
+    cbsdk_session_t session,
+    uint32_t group,
+    cbsdk_virtual_group_info_t* info);
+
+/// Move the oldest buffered samples of a virtual group out of its ring buffer
+/// @param session Session handle (must not be NULL)
+/// @param group Id of a virtual group
+/// @param[out] samples Receives row-major [n_samples][n_channels] int16 (must not be NULL)
+/// @param[out] timestamps Receives one timestamp per sample (may be NULL)
+/// @param max_channels Channels per row the samples buffer can hold
+/// @param[in,out] n_samples In: rows the buffers can hold. Out: rows written
+/// @param[out] n_channels Receives the channels per row (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if the group does not exist
+///         or has more than max_channels channels
+CBSDK_API cbsdk_result_t cbsdk_session_read_virtual_group(
+    cbsdk_session_t session,
+    uint32_t group,
+    int16_t* samples,
+    uint64_t* timestamps,
+    uint32_t max_channels,
+    uint32_t* n_samples,
+    uint32_t* n_channels);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Band Power
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Per-channel band power of a device or virtual group, computed on the callback thread with a
+// Hann-windowed FFT (see cbsdk/band_power.h).  Every hop samples a feature vector of
+// [channels][bands] mean-square powers (raw units squared) goes to a ring buffer and to the
+// stream's callbacks.
+
+/// Create a band power stream
+/// @param session Session handle (must not be NULL)
+/// @param config Source and windowing (must not be NULL)
+/// @param bands Bands to measure (must not be NULL)
+/// @param n_bands Number of bands (at least 1)
+/// @param buffer_frames Ring buffer capacity in feature vectors (0: no buffering)
+/// @param[out] stream Receives the stream id (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER for an invalid source,
+///         window, hop or band (each band must hold a frequency bin: sample rate / window wide)
+CBSDK_API cbsdk_result_t cbsdk_session_create_band_power_stream(
+    cbsdk_session_t session,
+    const cbsdk_band_power_config_t* config,
+    const cbsdk_frequency_band_t* bands,
+    uint32_t n_bands,
+    uint32_t buffer_frames,
+    uint32_t* stream);
+
+/// Stop a band power stream and drop its callbacks
+/// @param session Session handle (must not be NULL)
+/// @param stream Id of a band power stream
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if the stream does not exist
+CBSDK_API cbsdk_result_t cbsdk_session_destroy_band_power_stream(cbsdk_session_t session, uint32_t stream);
+
+/// Register a callback for a band power stream's feature vectors
+/// @param session Session handle (must not be NULL)
+/// @param stream Id of a band power stream
+/// @param callback Callback function (must not be NULL)
+/// @param user_data User data pointer passed to callback
+/// @return Handle for unregistration, or 0 on failure (including an unknown stream)
+CBSDK_API cbsdk_callback_handle_t cbsdk_session_register_band_power_callback(
+    cbsdk_session_t session,
+    uint32_t stream,
+    cbsdk_band_power_callback_fn callback,
+    void* user_data);
+
+/// Get the description and counters of a band power stream
+/// @param session Session handle (must not be NULL)
+/// @param stream Id of a band power stream
+/// @param[out] info Receives the description (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if the stream does not exist
+CBSDK_API cbsdk_result_t cbsdk_session_get_band_power_info(
+    cbsdk_session_t session,
+    uint32_t stream,
+    cbsdk_band_power_info_t* info);
+
+/// Move the oldest buffered feature vectors of a band power stream out of its ring buffer
+/// @param session Session handle (must not be NULL)
+/// @param stream Id of a band power stream
+/// @param[out] features Receives row-major [n_frames][n_channels][band_count] floats (must not be NULL)
+/// @param[out] timestamps Receives one timestamp per vector (may be NULL)
+/// @param max_channels Channels per vector the features buffer can hold
+/// @param[in,out] n_frames In: vectors the buffers can hold. Out: vectors written
+/// @param[out] n_channels Receives the channels per vector (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if the stream does not exist
+///         or has more than max_channels channels
+CBSDK_API cbsdk_result_t cbsdk_session_read_band_power(
+    cbsdk_session_t session,
+    uint32_t stream,
+    float* features,
+    uint64_t* timestamps,
+    uint32_t max_channels,
+    uint32_t* n_frames,
+    uint32_t* n_channels);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Peri-Event Epochs
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Fixed windows of a device group around events (see cbsdk/epoch_extractor.h).  Digital or
+// serial input packets and spikes on the trigger channels, and optionally comments, each cut
+// pre_samples before and post_samples from the first sample at or after the event; once the
+// post window has arrived the epoch goes to a ring buffer and to the stream's callbacks.
+
+/// Create an epoch stream
+/// @param session Session handle (must not be NULL)
+/// @param config Source, window and triggers (must not be NULL), e.g. from cbsdk_epoch_config_default()
+/// @param channels Trigger channel IDs (may be NULL if n_channels is 0)
+/// @param n_channels Number of trigger channels
+/// @param buffer_epochs Ring buffer capacity in epochs (0: no buffering)
+/// @param[out] stream Receives the stream id (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER for an invalid source,
+///         window or trigger channel
+CBSDK_API cbsdk_result_t cbsdk_session_create_epoch_stream(
+    cbsdk_session_t session,
+    const cbsdk_epoch_config_t* config,
+    const uint32_t* channels,
+    uint32_t n_channels,
+    uint32_t buffer_epochs,
+    uint32_t* stream);
+
+/// Stop an epoch stream and drop its callbacks
+/// @param session Session handle (must not be NULL)
+/// @param stream Id of an epoch stream
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if the stream does not exist
+CBSDK_API cbsdk_result_t cbsdk_session_destroy_epoch_stream(cbsdk_session_t session, uint32_t stream);
+
+/// Register a callback for an epoch stream's epochs
+/// @param session Session handle (must not be NULL)
+/// @param stream Id of an epoch stream
+/// @param callback Callback function (must not be NULL)
+/// @param user_data User data pointer passed to callback
+/// @return Handle for unregistration, or 0 on failure (including an unknown stream)
+CBSDK_API cbsdk_callback_handle_t cbsdk_session_register_epoch_callback(
+    cbsdk_session_t session,
+    uint32_t stream,
+    cbsdk_epoch_callback_fn callback,
+    void* user_data);
+
+/// Get the description and counters of an epoch stream
+/// @param session Session handle (must not be NULL)
+/// @param stream Id of an epoch stream
+/// @param[out] info Receives the description (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if the stream does not exist
+CBSDK_API cbsdk_result_t cbsdk_session_get_epoch_info(
+    cbsdk_session_t session,
+    uint32_t stream,
+    cbsdk_epoch_info_t* info);
+
+/// Move the oldest buffered epochs of an epoch stream out of its ring buffer
+/// @param session Session handle (must not be NULL)
+/// @param stream Id of an epoch stream
+/// @param[out] samples Receives row-major [n_epochs][pre + post][n_channels] samples (must not be NULL)
+/// @param[out] events Receives the triggering event of each epoch (may be NULL)
+/// @param max_channels Channels per row the samples buffer can hold
+/// @param[in,out] n_epochs In: epochs the buffers can hold. Out: epochs written
+/// @param[out] n_channels Receives the channels per row (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if the stream does not exist
+///         or has more than max_channels channels
+CBSDK_API cbsdk_result_t cbsdk_session_read_epochs(
+    cbsdk_session_t session,
+    uint32_t stream,
+    int16_t* samples,
+    cbsdk_epoch_event_t* events,
+    uint32_t max_channels,
+    uint32_t* n_epochs,
+    uint32_t* n_channels);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Host Spike Detection
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Threshold-crossing detection on a sample group, run on the callback thread (see
+// cbsdk/spike_detector.h).  Spikes are delivered as unsorted cbPKT_SPK packets to the event
+// and packet callbacks, like the device's.  Turn device extraction off to avoid duplicates.
+
+/// Start host spike detection, replacing any already running
+/// @param session Session handle (must not be NULL)
+/// @param config Settings (must not be NULL), e.g. from cbsdk_spike_detection_config_default()
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER for a bad source, filter or
+///         threshold, or a group without channels
+CBSDK_API cbsdk_result_t cbsdk_session_start_spike_detection(
+    cbsdk_session_t session,
+    const cbsdk_spike_detection_config_t* config);
+
+/// Stop host spike detection (no-op if not running)
+/// @param session Session handle (must not be NULL)
+CBSDK_API void cbsdk_session_stop_spike_detection(cbsdk_session_t session);
+
+/// Check whether host spike detection is running
+/// @param session Session handle (must not be NULL)
+/// @return true while running
+CBSDK_API bool cbsdk_session_is_spike_detection_running(cbsdk_session_t session);
+
+/// Change the host detection threshold of one channel
+/// @param session Session handle (must not be NULL)
+/// @param chan_id 1-based channel ID in the detected group
+/// @param threshold New threshold (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if detection is not running,
+///         the channel is not detected on or the threshold is invalid
+CBSDK_API cbsdk_result_t cbsdk_session_set_spike_detection_threshold(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    const cbsdk_spike_threshold_t* threshold);
+
+/// Get the level a channel is currently compared against
+/// @param session Session handle (must not be NULL)
+/// @param chan_id 1-based channel ID in the detected group
+/// @param[out] level Receives the level; 0 while off or while an RMS threshold arms (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if detection is not running
+///         or the channel is not detected on
+CBSDK_API cbsdk_result_t cbsdk_session_get_spike_detection_level(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    int16_t* level);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Spike Binning
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Spike counts per channel and unit in bins aligned to device time (see cbsdk/spike_binner.h),
+// fed by every spike packet the session dispatches, including host-detected ones.  A bin
+// closes once device time has passed its end by the latency.
+
+/// Start spike binning, replacing any already running
+/// @param session Session handle (must not be NULL)
+/// @param config Settings (must not be NULL), e.g. from cbsdk_spike_binning_config_default()
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER for a zero dimension or bin
+///         width, a latency of buffer_bins bins or more, or too many channels
+CBSDK_API cbsdk_result_t cbsdk_session_start_spike_binning(
+    cbsdk_session_t session,
+    const cbsdk_spike_binning_config_t* config);
+
+/// Stop spike binning and drop its bins (no-op if not running)
+/// @param session Session handle (must not be NULL)
+CBSDK_API void cbsdk_session_stop_spike_binning(cbsdk_session_t session);
+
+/// Check whether spike binning is running
+/// @param session Session handle (must not be NULL)
+/// @return true while running
+CBSDK_API bool cbsdk_session_is_spike_binning_running(cbsdk_session_t session);
+
+/// Register a callback for every closed spike bin
+/// @param session Session handle (must not be NULL)
+/// @param callback Callback function (must not be NULL)
+/// @param user_data User data pointer passed to callback
+/// @return Handle for unregistration, or 0 on failure
+CBSDK_API cbsdk_callback_handle_t cbsdk_session_register_spike_bin_callback(
+    cbsdk_session_t session,
+    cbsdk_spike_bin_callback_fn callback,
+    void* user_data);
+
+/// Move the oldest closed bins out of the binning history
+/// @param session Session handle (must not be NULL)
+/// @param[out] counts Receives [n_bins][channel_count][unit_count] counts (must not be NULL)
+/// @param[out] start_times Receives each bin's start time (may be NULL)
+/// @param[in,out] n_bins In: bins @p counts can hold; out: bins written (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if binning is not running
+CBSDK_API cbsdk_result_t cbsdk_session_read_spike_bins(
+    cbsdk_session_t session,
+    uint32_t* counts,
+    uint64_t* start_times,
+    uint32_t* n_bins);
+
+/// Get the counters of the running spike binning
+/// @param session Session handle (must not be NULL)
+/// @param[out] stats Receives the counters (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if binning is not running
+CBSDK_API cbsdk_result_t cbsdk_session_get_spike_binning_stats(
+    cbsdk_session_t session,
+    cbsdk_spike_binning_stats_t* stats);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Digital Input Tracking
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// A log of every digital and serial input packet with the bits that rose and fell (see
+// cbsdk/digital_input_tracker.h).  Pollers read it with a cursor and ask for the word at given
+// device times in bulk, instead of taking a callback per packet.
+
+/// Start digital input tracking, replacing any already running
+/// @param session Session handle (must not be NULL)
+/// @param buffer_events Events the log holds
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if @p buffer_events is 0
+CBSDK_API cbsdk_result_t cbsdk_session_start_digital_input_tracking(
+    cbsdk_session_t session,
+    uint32_t buffer_events);
+
+/// Stop digital input tracking and drop its log (no-op if not running)
+/// @param session Session handle (must not be NULL)
+CBSDK_API void cbsdk_session_stop_digital_input_tracking(cbsdk_session_t session);
+
+/// Check whether digital input tracking is running
+/// @param session Session handle (must not be NULL)
+/// @return true while running
+CBSDK_API bool cbsdk_session_is_digital_input_tracking_running(cbsdk_session_t session);
+
+/// Copy the logged input events from a cursor on (oldest first)
+/// @param session Session handle (must not be NULL)
+/// @param[in,out] cursor Sequence number of the first event wanted (0 for the oldest); moved
+///                past the events copied (must not be NULL)
+/// @param[out] events Receives the events (must not be NULL)
+/// @param[in,out] n_events In: events @p events can hold; out: events copied (must not be NULL)
+/// @param[out] skipped Receives the number of events overwritten before the cursor reached
+///             them (may be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if tracking is not running
+CBSDK_API cbsdk_result_t cbsdk_session_read_digital_input_events(
+    cbsdk_session_t session,
+    uint64_t* cursor,
+    cbsdk_digital_input_event_t* events,
+    uint32_t* n_events,
+    uint64_t* skipped);
+
+/// Get the word of an input channel at each of a list of device times
+/// @param session Session handle (must not be NULL)
+/// @param chan_id 1-based channel ID of a digital or serial input
+/// @param times Device times (must not be NULL)
+/// @param n_times Number of times
+/// @param[out] values Receives one word per time (must not be NULL)
+/// @param[out] n_exact Receives how many times were answered exactly; a time before the
+///             oldest event still logged reads the word from before it (may be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if tracking is not running
+CBSDK_API cbsdk_result_t cbsdk_session_get_digital_input_state(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    const uint64_t* times,
+    uint32_t n_times,
+    uint32_t* values,
+    uint32_t* n_exact);
+
+/// Get the current word of an input channel
+/// @param session Session handle (must not be NULL)
+/// @param chan_id 1-based channel ID of a digital or serial input
+/// @param[out] value Receives the word (0 if the channel has sent nothing) (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if tracking is not running
+CBSDK_API cbsdk_result_t cbsdk_session_get_digital_input_word(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    uint32_t* value);
+
+/// Get the counters of the running digital input tracking
+/// @param session Session handle (must not be NULL)
+/// @param[out] stats Receives the counters (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if tracking is not running
+CBSDK_API cbsdk_result_t cbsdk_session_get_digital_input_stats(
+    cbsdk_session_t session,
+    cbsdk_digital_input_stats_t* stats);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Host Spike Sorting
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Classification of host-detected and unsorted device spikes with the device's PCA bases, unit
+// models and noise boundaries (see cbsdk/spike_sorter.h).  Sorted spikes reach the packet and
+// event callbacks, spike bins and epochs with their unit in header.type and their feature
+// pattern in fPattern.
+
+/// Start host spike sorting, replacing any already running
+/// @param session Session handle (must not be NULL)
+/// @param config Settings (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER for a gate that is not
+///         positive or no spike length from the device
+CBSDK_API cbsdk_result_t cbsdk_session_start_spike_sorting(
+    cbsdk_session_t session,
+    const cbsdk_spike_sorting_config_t* config);
+
+/// Stop host spike sorting (no-op if not running)
+/// @param session Session handle (must not be NULL)
+CBSDK_API void cbsdk_session_stop_spike_sorting(cbsdk_session_t session);
+
+/// Check whether host spike sorting is running
+/// @param session Session handle (must not be NULL)
+/// @return true while running
+CBSDK_API bool cbsdk_session_is_spike_sorting_running(cbsdk_session_t session);
+
+/// Replace the sort model of one channel until the device sends a new one
+/// @param session Session handle (must not be NULL)
+/// @param chan_id 1-based channel ID
+/// @param basis Row-major [n_points][3] PCA basis, n_points at least the spike length
+///        (must not be NULL)
+/// @param n_points Rows of @p basis
+/// @param units Clusters (may be NULL if @p n_units is 0)
+/// @param n_units Number of clusters
+/// @param noise_center Centre of the noise ellipsoid (NULL: no noise boundary)
+/// @param noise_axes Row-major [3][3] semi-axes of the noise ellipsoid (must not be NULL if
+///        @p noise_center is not)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if sorting is not running or
+///         the model is invalid
+CBSDK_API cbsdk_result_t cbsdk_session_set_spike_sort_model(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    const float* basis,
+    uint32_t n_points,
+    const cbsdk_sort_unit_t* units,
+    uint32_t n_units,
+    const float* noise_center,
+    const float* noise_axes);
+
+/// Get the counters of the running host spike sorting
+/// @param session Session handle (must not be NULL)
+/// @param[out] stats Receives the counters (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_INVALID_PARAMETER if sorting is not running
+CBSDK_API cbsdk_result_t cbsdk_session_get_spike_sorting_stats(
+    cbsdk_session_t session,
+    cbsdk_spike_sorting_stats_t* stats);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Recorded File Access
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Memory-mapped readers of NSx / .cbz and NEV files (see cbsdk/file_reader.h).  They need no
+// session.  Opening builds a sparse timestamp index; reads touch only the pages they need.
+// Timestamps are in the file's time_resolution ticks.  A reader is not thread-safe.
+
+/// Open a continuous file; the format is detected from its header
+/// @param path File path (must not be NULL)
+/// @param[out] reader Receives the handle (must not be NULL); release with cbsdk_continuous_reader_close()
+/// @return CBSDK_RESULT_SUCCESS on success, CBSDK_RESULT_FILE_ERROR if the file cannot be read
+CBSDK_API cbsdk_result_t cbsdk_continuous_reader_open(const char* path, cbsdk_continuous_reader_t* reader);
+
+/// Close a continuous file; views into it become invalid (NULL is ignored)
+CBSDK_API void cbsdk_continuous_reader_close(cbsdk_continuous_reader_t reader);
+
+/// Get the layout of a continuous file
+/// @param reader Reader handle (must not be NULL)
+/// @param[out] info Receives the layout (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS on success, error code on failure
+CBSDK_API cbsdk_result_t cbsdk_continuous_reader_get_info(
+    cbsdk_continuous_reader_t reader,
+    cbsdk_continuous_file_info_t* info);
+
+/// Get the channel (electrode) id of each column
+/// @param reader Reader handle (must not be NULL)
+/// @param[out] ids Receives the ids (must not be NULL)
+/// @param[in,out] count On input: size of ids array. On output: ids written.
+/// @return CBSDK_RESULT_SUCCESS on success, error code on failure
+CBSDK_API cbsdk_result_t cbsdk_continuous_reader_get_channel_ids(
+    cbsdk_continuous_reader_t reader,
+    uint16_t* ids,
+    uint32_t* count);
+
+/// Find the rows whose timestamps fall in [t0, t1)
+/// @param reader Reader handle (must not be NULL)
+/// @param[out] first Receives the first row (must not be NULL)
+/// @param[out] count Receives the number of rows (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS on success, error code on failure
+CBSDK_API cbsdk_result_t cbsdk_continuous_reader_find_range(
+    cbsdk_continuous_reader_t reader,
+    uint64_t t0,
+    uint64_t t1,
+    uint64_t* first,
+    uint64_t* count);
+
+/// Copy selected channels of rows [first, first + count), row-major
+/// @param reader Reader handle (must not be NULL)
+/// @param channel_ids Channels to copy, in output column order (NULL with n_ids 0: every channel)
+/// @param n_ids Number of channel ids
+/// @param first First row
+/// @param count Number of rows
+/// @param[out] samples Receives count * columns samples (can be NULL)
+/// @param[out] timestamps Receives count timestamps (can be NULL)
+/// @return CBSDK_RESULT_SUCCESS on success, CBSDK_RESULT_INVALID_PARAMETER if a channel is not
+///         in the file or the rows are out of range
+CBSDK_API cbsdk_result_t cbsdk_continuous_reader_read(
+    cbsdk_continuous_reader_t reader,
+    const uint16_t* channel_ids,
+    uint32_t n_ids,
+    uint64_t first,
+    uint64_t count,
+    int16_t* samples,
+    uint64_t* timestamps);
+
+/// Get a zero-copy view of rows [first, first + count) of an uncompressed file
+/// Row r, column c is the little-endian int16 at data + r * row_stride + 2 * c; it may be
+/// unaligned.  The view is valid until the reader is closed.
+/// @param reader Reader handle (must not be NULL)
+/// @param[out] data Receives the address of the first row (must not be NULL)
+/// @param[out] row_stride Receives the bytes between rows (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS on success, CBSDK_RESULT_INVALID_PARAMETER if the rows span
+///         index segments or the file is compressed (use cbsdk_continuous_reader_read())
+CBSDK_API cbsdk_result_t cbsdk_continuous_reader_view(
+    cbsdk_continuous_reader_t reader,
+    uint64_t first,
+    uint64_t count,
+    const void** data,
+    size_t* row_stride);
+
+/// Open a NEV file
+/// @param path File path (must not be NULL)
+/// @param[out] reader Receives the handle (must not be NULL); release with cbsdk_event_reader_close()
+/// @return CBSDK_RESULT_SUCCESS on success, CBSDK_RESULT_FILE_ERROR if the file cannot be read
+CBSDK_API cbsdk_result_t cbsdk_event_reader_open(const char* path, cbsdk_event_reader_t* reader);
+
+/// Close a NEV file (NULL is ignored)
+CBSDK_API void cbsdk_event_reader_close(cbsdk_event_reader_t reader);
+
+/// Get the layout of a NEV file
+/// @param reader Reader handle (must not be NULL)
+/// @param[out] info Receives the layout (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS on success, error code on failure
+CBSDK_API cbsdk_result_t cbsdk_event_reader_get_info(cbsdk_event_reader_t reader, cbsdk_event_file_info_t* info);
+
+/// Find the packets whose timestamps fall in [t0, t1)
+/// @param reader Reader handle (must not be NULL)
+/// @param[out] first Receives the first packet (must not be NULL)
+/// @param[out] count Receives the number of packets (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS on success, error code on failure
+CBSDK_API cbsdk_result_t cbsdk_event_reader_find_range(
+    cbsdk_event_reader_t reader,
+    uint64_t t0,
+    uint64_t t1,
+    uint64_t* first,
+    uint64_t* count);
+
+/// Copy packets [first, first + count) whose packet id is in @p packet_ids
+/// Each output array must hold count entries (waveforms: count * waveform_samples).
+/// @param reader Reader handle (must not be NULL)
+/// @param packet_ids Packet ids to keep (NULL with n_ids 0: every packet)
+/// @param n_ids Number of packet ids
+/// @param[out] timestamps Receives timestamps (can be NULL)
+/// @param[out] out_ids Receives packet ids (can be NULL)
+/// @param[out] units Receives units / digital insertion reasons (can be NULL)
+/// @param[out] waveforms Receives payload words (can be NULL)
+/// @param[out] n_out Receives the number of packets copied (must not be NULL)
+/// @return CBSDK_RESULT_SUCCESS on success, CBSDK_RESULT_INVALID_PARAMETER if out of range
+CBSDK_API cbsdk_result_t cbsdk_event_reader_read(
+    cbsdk_event_reader_t reader,
+    uint64_t first,
+    uint64_t count,
+    const uint16_t* packet_ids,
+    uint32_t n_ids,
+    uint64_t* timestamps,
+    uint16_t* out_ids,
+    uint8_t* units,
+    int16_t* waveforms,
+    uint64_t* n_out);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Spike Sorting
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1097,6 +2154,131 @@ CBSDK_API cbsdk_result_t cbsdk_session_set_spike_extraction(
     cbproto_channel_type_t chan_type,
     bool enabled);
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous Channel Configuration
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Non-blocking counterparts of the bulk channel setters.  They do not pre-sync or wait:
+// packets are sent immediately and completion is tracked per channel by matching the
+// device's CHANREP echoes, so many changes can be in flight at once.  Each function takes
+// an optional completion callback and an optional out-handle; pass NULL for either.  A
+// returned handle must be released with cbsdk_config_op_destroy() (releasing does not
+// cancel the operation or its callback).  Channel selection matches
+// cbsdk_session_set_sample_group().
+
+/// Asynchronous cbsdk_session_set_sample_group()
+/// @param timeout_ms Deadline for every channel to be acknowledged
+/// @param callback Optional completion callback (NULL for none)
+/// @param user_data Passed to @p callback
+/// @param[out] op Optional operation handle (NULL if not needed)
+/// @return CBSDK_RESULT_SUCCESS if the packets were sent, error code otherwise
+CBSDK_API cbsdk_result_t cbsdk_session_set_sample_group_async(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    cbproto_group_rate_t rate,
+    bool disable_others,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op);
+
+/// Asynchronous cbsdk_session_set_ac_input_coupling()
+/// @see cbsdk_session_set_sample_group_async() for the common parameters
+CBSDK_API cbsdk_result_t cbsdk_session_set_ac_input_coupling_async(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    bool enabled,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op);
+
+/// Asynchronous cbsdk_session_set_spike_sorting()
+/// @see cbsdk_session_set_sample_group_async() for the common parameters
+CBSDK_API cbsdk_result_t cbsdk_session_set_spike_sorting_async(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    uint32_t sort_options,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op);
+
+/// Asynchronous cbsdk_session_set_spike_extraction()
+/// @see cbsdk_session_set_sample_group_async() for the common parameters
+CBSDK_API cbsdk_result_t cbsdk_session_set_spike_extraction_async(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    bool enabled,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op);
+
+/// Asynchronous cbsdk_session_set_channel_config()
+/// @param chaninfo Complete channel info packet (type must be a CHANSET* variant)
+/// @see cbsdk_session_set_sample_group_async() for the common parameters
+CBSDK_API cbsdk_result_t cbsdk_session_set_channel_config_async(
+    cbsdk_session_t session,
+    const cbPKT_CHANINFO* chaninfo,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op);
+
+/// Block until an asynchronous operation finishes or @p timeout_ms elapses
+/// @param op Operation handle (must not be NULL)
+/// @param timeout_ms Maximum time to wait (the operation keeps its own deadline)
+/// @return CBSDK_RESULT_SUCCESS if acknowledged, CBSDK_RESULT_TIMEOUT if still pending or
+///         its deadline passed, CBSDK_RESULT_INTERNAL_ERROR if it failed otherwise
+CBSDK_API cbsdk_result_t cbsdk_config_op_wait(cbsdk_config_op_t op, uint32_t timeout_ms);
+
+/// Number of channels an operation is still waiting on (0 for NULL or finished operations)
+CBSDK_API uint32_t cbsdk_config_op_pending_channels(cbsdk_config_op_t op);
+
+/// Release an operation handle (can be NULL)
+CBSDK_API void cbsdk_config_op_destroy(cbsdk_config_op_t op);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Configuration Transactions
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Between begin and commit, the blocking bulk setters (set_sample_group,
+// set_spike_sorting, set_spike_extraction, set_ac_input_coupling) and
+// set_channel_config only record their changes.  Commit syncs once and sends a
+// single merged CHANSET* per touched channel.
+
+/// Start staging channel configuration changes
+/// @return CBSDK_RESULT_SUCCESS, or CBSDK_RESULT_ALREADY_RUNNING if a transaction is open
+CBSDK_API cbsdk_result_t cbsdk_session_begin_config_transaction(cbsdk_session_t session);
+
+/// Send the staged changes and wait for every sent channel to be acknowledged.
+/// The transaction is closed whether or not this succeeds.
+/// @param session Session handle (must not be NULL)
+/// @param skip_unchanged Omit channels whose merged result equals their freshly synced state
+/// @param timeout_ms Deadline for the sync and for the acknowledgements
+/// @param[out] n_sent Optional number of CHANSET* packets sent
+/// @param[out] n_skipped Optional number of channels omitted by @p skip_unchanged
+/// @return CBSDK_RESULT_SUCCESS, CBSDK_RESULT_NOT_RUNNING if no transaction is open,
+///         CBSDK_RESULT_INTERNAL_ERROR on sync/send failure or timeout
+CBSDK_API cbsdk_result_t cbsdk_session_commit_config_transaction(
+    cbsdk_session_t session,
+    bool skip_unchanged,
+    uint32_t timeout_ms,
+    uint32_t* n_sent,
+    uint32_t* n_skipped);
+
+/// Discard the staged changes (no-op if no transaction is open)
+CBSDK_API void cbsdk_session_abort_config_transaction(cbsdk_session_t session);
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Clock Synchronization
 ///////////////////////////////////////////////////////////////////////////////////////////////////
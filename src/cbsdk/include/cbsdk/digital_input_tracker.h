@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   digital_input_tracker.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Digital input event log with per-bit edge decoding
+///
+/// A DigitalInputTracker keeps the current word of every digital (or serial) input channel
+/// and logs each input packet as a 24-byte event: time, channel, the new word and the bits
+/// that rose and fell.  Events live in a fixed ring numbered by sequence, so a poller reads
+/// "everything since my cursor" in one call, and each event links to the previous one of its
+/// channel, so "the word at time t" walks only that channel's events.
+/// SdkSession::startDigitalInputTracking() feeds one from the event path.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_DIGITAL_INPUT_TRACKER_H
+#define CBSDK_DIGITAL_INPUT_TRACKER_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace cbsdk {
+
+/// One digital input packet, decoded against the channel's previous word
+struct DigitalInputEvent {
+    uint64_t time = 0;          ///< Device time of the packet
+    uint32_t chan_id = 0;
+    uint32_t value = 0;         ///< Word after the packet
+    uint32_t rising = 0;        ///< Bits that went from 0 to 1
+    uint32_t falling = 0;       ///< Bits that went from 1 to 0
+};
+
+/// Counters of a DigitalInputTracker
+struct DigitalInputStats {
+    uint64_t events = 0;            ///< Packets logged since creation
+    uint64_t edges_rising = 0;      ///< Rising bit edges since creation
+    uint64_t edges_falling = 0;     ///< Falling bit edges since creation
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Current words and a timestamped event log of digital inputs
+///
+/// Every channel starts at word 0, so its first packet reports the bits set in it as rising.
+/// Events must be added in time order per channel.  Not thread-safe.
+///
+class DigitalInputTracker {
+public:
+    /// @param capacity Events the log holds
+    /// @return Error if @p capacity is 0
+    static cbutil::Result<DigitalInputTracker> create(size_t capacity);
+
+    DigitalInputTracker(DigitalInputTracker&&) noexcept;
+    DigitalInputTracker& operator=(DigitalInputTracker&&) noexcept;
+    DigitalInputTracker(const DigitalInputTracker&) = delete;
+    DigitalInputTracker& operator=(const DigitalInputTracker&) = delete;
+    ~DigitalInputTracker();
+
+    /// Log one input packet
+    /// @param chan_id Channel ID (at least 1)
+    /// @param value Word the packet read
+    /// @return The decoded event
+    DigitalInputEvent add(uint32_t chan_id, uint64_t time, uint32_t value);
+
+    /// Copy the events from sequence number @p cursor on (oldest first)
+    /// @param[in,out] cursor Sequence number of the first event wanted (0 for the oldest
+    ///                ever); moved past the events copied.  If the log no longer holds it,
+    ///                reading starts at the oldest event held.
+    /// @param skipped Receives the number of events overwritten before the cursor reached
+    ///                them (may be null)
+    /// @return Number of events copied
+    size_t read(uint64_t& cursor, DigitalInputEvent* out, size_t max_events, uint64_t* skipped = nullptr);
+
+    /// Word of @p chan_id at each of @p times: that of its last event at or before the time
+    /// @return Number of times answered exactly.  A time before the channel's oldest event
+    ///         still in the log, when older ones were overwritten, reads the word from before
+    ///         that event instead.
+    size_t stateAt(uint32_t chan_id, const uint64_t* times, size_t n_times, uint32_t* values) const;
+
+    /// @return Current word of @p chan_id (0 if it has sent nothing)
+    [[nodiscard]] uint32_t current(uint32_t chan_id) const;
+
+    /// @return Sequence number the next event will get (events logged so far)
+    [[nodiscard]] uint64_t sequence() const;
+
+    [[nodiscard]] size_t capacity() const;
+    [[nodiscard]] DigitalInputStats stats() const;
+
+private:
+    DigitalInputTracker();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_DIGITAL_INPUT_TRACKER_H
@@ -0,0 +1,104 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   epoch_extractor.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Peri-event epochs (fixed windows of continuous data around events)
+///
+/// An EpochExtractor keeps a bounded history of one sample group in a ring of rows.  Each
+/// event is anchored at its trigger sample, the first sample at or after the event's time,
+/// and cuts the window of pre_samples before it and post_samples from it on.  Once the post
+/// window has arrived the epoch is assembled into one contiguous block (at most two copies
+/// out of the ring) and handed to a sink; nothing else is copied and nothing is allocated
+/// after create().  Events may arrive before or after their trigger sample, as long as they
+/// are at most max_delay_samples late.  SdkSession::createEpochStream() runs one per stream
+/// against a device group and its event packets.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_EPOCH_EXTRACTOR_H
+#define CBSDK_EPOCH_EXTRACTOR_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace cbsdk {
+
+/// Window and history of an EpochExtractor
+struct EpochConfig {
+    size_t pre_samples = 300;           ///< Samples before the trigger sample, e.g. 10 ms at 30 kHz
+    size_t post_samples = 600;          ///< Samples from the trigger sample on (at least 1)
+    size_t max_delay_samples = 3000;    ///< How many samples late an event may arrive
+    size_t max_pending = 64;            ///< Events waiting for their post window at once
+};
+
+/// The event an epoch is cut around
+struct EpochEvent {
+    uint64_t time = 0;          ///< Device time of the event
+    uint64_t trigger_time = 0;  ///< Device time of the trigger sample (set by the extractor)
+    uint32_t chan_id = 0;       ///< Channel the event came from (0 for a comment)
+    uint32_t value = 0;         ///< Spike unit, digital/serial input value, or 0 for a comment
+};
+
+/// Counters of an EpochExtractor
+struct EpochStats {
+    uint64_t epochs = 0;            ///< Epochs handed to the sink
+    uint64_t events_late = 0;       ///< Events whose window had left the history (dropped)
+    uint64_t events_dropped = 0;    ///< Events over max_pending, or pending at a clock restart
+};
+
+/// Receives one epoch: @p samples is row-major [pre_samples + post_samples][channels]
+/// with one timestamp per row; both are valid only during the call
+using EpochSink = std::function<void(const EpochEvent& event, const int16_t* samples, const uint64_t* timestamps)>;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Fixed pre/post windows of a sample group around events
+///
+/// Samples are row-major int16 [n_samples][n_channels], as the batch callbacks deliver them,
+/// with non-decreasing timestamps; a timestamp that goes back is a device clock restart and
+/// clears the history.  Not thread-safe.
+///
+class EpochExtractor {
+public:
+    /// @param channel_count Channels per sample (at least 1)
+    /// @return Error if post_samples, channel_count or max_pending is 0
+    static cbutil::Result<EpochExtractor> create(const EpochConfig& config, size_t channel_count);
+
+    EpochExtractor(EpochExtractor&&) noexcept;
+    EpochExtractor& operator=(EpochExtractor&&) noexcept;
+    EpochExtractor(const EpochExtractor&) = delete;
+    EpochExtractor& operator=(const EpochExtractor&) = delete;
+    ~EpochExtractor();
+
+    /// Queue an event; its epoch goes to a later addSamples() sink, or to none if the
+    /// window has already left the history
+    void addEvent(const EpochEvent& event);
+
+    /// Append @p n_samples rows and hand every epoch whose post window they complete to @p sink
+    /// @param timestamps Device timestamp of each row
+    void addSamples(const int16_t* samples, const uint64_t* timestamps, size_t n_samples,
+                    const EpochSink& sink);
+
+    /// Forget the history and pending events
+    void reset();
+
+    /// @return Rows per epoch (pre_samples + post_samples)
+    [[nodiscard]] size_t epochLength() const;
+    [[nodiscard]] size_t pendingCount() const;
+    [[nodiscard]] const EpochConfig& config() const;
+    [[nodiscard]] size_t channelCount() const;
+    [[nodiscard]] EpochStats stats() const;
+
+private:
+    EpochExtractor();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_EPOCH_EXTRACTOR_H
@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   file_reader.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Memory-mapped readers for recorded continuous and event files
+///
+/// ContinuousFileReader reads NSx 2.2/2.3/3.0 files (Central's and cbsdk::Recorder's) and the
+/// compressed ".cbz" files of cbsdk/continuous_codec.h; EventFileReader reads NEV 2.x/3.0.
+/// Uncompressed files are memory-mapped, so opening one touches only its headers and reads
+/// fault in just the pages they need.
+///
+/// On open, each reader builds a sparse timestamp index rather than one entry per sample:
+///  - NSx: one segment per run of identically laid-out data packets.  A file of single-sample
+///    packets (Central's PTP recordings, the Recorder's output) is usually one segment; its
+///    packet headers are sampled by galloping search instead of walked one by one, and the
+///    timestamps within a segment are read straight from the mapping.
+///  - cbz: the chunk index stored at the end of the file.
+///  - NEV: the timestamp of every INDEX_STRIDE-th packet.
+/// Timestamps are assumed non-decreasing through a file, as they are in recordings made
+/// without a clock reset.
+///
+/// A reader is not thread-safe; open one per thread (the OS shares the mapped pages).
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_FILE_READER_H
+#define CBSDK_FILE_READER_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cbsdk {
+
+/// Rows [first, first + count) of a file
+struct SampleRange {
+    uint64_t first = 0;
+    uint64_t count = 0;
+};
+
+/// A run of rows with a uniform layout (one entry of the sparse index)
+struct ContinuousFileSegment {
+    uint64_t first_sample = 0;      ///< Index of the segment's first row in the file
+    uint64_t sample_count = 0;
+    uint64_t first_timestamp = 0;
+    uint64_t last_timestamp = 0;
+};
+
+/// Zero-copy view of consecutive rows inside the mapping
+///
+/// Samples are little-endian int16 and, in NSx 3.0 files of single-sample packets (13-byte
+/// packet headers), not 2-byte aligned: read them with memcpy or sample().
+struct SampleView {
+    const uint8_t* data = nullptr;  ///< Channel 0 of the first row
+    size_t rows = 0;
+    size_t row_stride = 0;          ///< Bytes from one row to the next
+    size_t channel_count = 0;       ///< Consecutive int16 samples per row
+
+    /// @return Sample of column @p channel in row @p row
+    [[nodiscard]] int16_t sample(size_t row, size_t channel) const;
+};
+
+/// Selected channels of a time range, row-major
+struct ContinuousData {
+    std::vector<uint16_t> channel_ids;  ///< Column order
+    std::vector<uint64_t> timestamps;   ///< One per row
+    std::vector<int16_t> samples;       ///< [timestamps.size()][channel_ids.size()]
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Reader of an NSx or compressed continuous file
+///
+class ContinuousFileReader {
+public:
+    /// Open a file; the format is detected from its header, not its extension
+    static cbutil::Result<ContinuousFileReader> open(const std::string& path);
+
+    ContinuousFileReader(ContinuousFileReader&&) noexcept;
+    ContinuousFileReader& operator=(ContinuousFileReader&&) noexcept;
+    ContinuousFileReader(const ContinuousFileReader&) = delete;
+    ContinuousFileReader& operator=(const ContinuousFileReader&) = delete;
+    ~ContinuousFileReader();
+
+    /// @return Channel (electrode) id of each column
+    [[nodiscard]] const std::vector<uint16_t>& channelIds() const;
+
+    /// @return Sample group label from the header (e.g. "30 kS/s")
+    [[nodiscard]] const std::string& label() const;
+
+    /// @return Sample period in 1/30000 s
+    [[nodiscard]] uint32_t period() const;
+
+    /// @return Timestamp ticks per second
+    [[nodiscard]] uint32_t timeResolution() const;
+
+    /// @return Rows in the file
+    [[nodiscard]] uint64_t sampleCount() const;
+
+    /// @return The sparse index
+    [[nodiscard]] const std::vector<ContinuousFileSegment>& segments() const;
+
+    /// @return Whether the file is a compressed (.cbz) file; such files have no zero-copy views
+    [[nodiscard]] bool isCompressed() const;
+
+    /// Rows whose timestamps fall in [t0, t1)
+    cbutil::Result<SampleRange> findRange(uint64_t t0, uint64_t t1);
+
+    /// Zero-copy view of rows [first, first + count), which must lie in one segment
+    cbutil::Result<SampleView> view(uint64_t first, size_t count);
+
+    /// Copy selected channels of rows [first, first + count)
+    /// @param channel_ids Channels to copy, in output column order (empty: every channel)
+    /// @param samples Receives [count][columns] samples (nullptr to skip)
+    /// @param timestamps Receives count timestamps (nullptr to skip)
+    /// @return Error if a channel is not in the file or the rows are out of range
+    cbutil::Result<void> readSamples(const std::vector<uint16_t>& channel_ids, uint64_t first, size_t count,
+                                     int16_t* samples, uint64_t* timestamps);
+
+    /// Copy selected channels of the rows whose timestamps fall in [t0, t1)
+    cbutil::Result<ContinuousData> read(const std::vector<uint16_t>& channel_ids, uint64_t t0, uint64_t t1);
+
+private:
+    ContinuousFileReader();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/// Events of a time range, one entry per packet in every vector
+struct EventData {
+    std::vector<uint64_t> timestamps;
+    std::vector<uint16_t> packet_ids;   ///< Electrode id; 0 for digital input
+    std::vector<uint8_t> units;         ///< Sorted unit (spikes) or insertion reason (digital input)
+    std::vector<int16_t> waveforms;     ///< [n][waveformSamples()]: spike waveform, or the digital value in column 0
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Reader of a NEV file
+///
+class EventFileReader {
+public:
+    /// Packets between two sparse index entries
+    static constexpr uint64_t INDEX_STRIDE = 1024;
+
+    /// Open a NEV 2.x or 3.0 file
+    static cbutil::Result<EventFileReader> open(const std::string& path);
+
+    EventFileReader(EventFileReader&&) noexcept;
+    EventFileReader& operator=(EventFileReader&&) noexcept;
+    EventFileReader(const EventFileReader&) = delete;
+    EventFileReader& operator=(const EventFileReader&) = delete;
+    ~EventFileReader();
+
+    /// @return Complete packets in the file
+    [[nodiscard]] uint64_t packetCount() const;
+
+    /// @return Size of every packet
+    [[nodiscard]] uint32_t packetSize() const;
+
+    /// @return int16 words after the packet id, unit and reserved bytes
+    [[nodiscard]] uint32_t waveformSamples() const;
+
+    /// @return Timestamp ticks per second
+    [[nodiscard]] uint32_t timeResolution() const;
+
+    /// @return Timestamp of packet @p index
+    [[nodiscard]] uint64_t timestamp(uint64_t index) const;
+
+    /// @return Raw bytes of packet @p index inside the mapping (packetSize() bytes)
+    [[nodiscard]] const uint8_t* packet(uint64_t index) const;
+
+    /// Packets whose timestamps fall in [t0, t1)
+    [[nodiscard]] SampleRange findRange(uint64_t t0, uint64_t t1) const;
+
+    /// Copy packets [first, first + count) whose packet id is in @p packet_ids
+    /// @param packet_ids Packet ids to keep (empty: every packet)
+    cbutil::Result<EventData> readPackets(const std::vector<uint16_t>& packet_ids, uint64_t first,
+                                          uint64_t count) const;
+
+    /// Copy the packets of [t0, t1) whose packet id is in @p packet_ids (empty: every packet)
+    [[nodiscard]] EventData read(const std::vector<uint16_t>& packet_ids, uint64_t t0, uint64_t t1) const;
+
+private:
+    EventFileReader();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_FILE_READER_H
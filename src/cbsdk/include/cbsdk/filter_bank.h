@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   filter_bank.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Host-side streaming IIR (biquad cascade) filtering of continuous group data
+///
+/// The device filters each channel before it is sampled (cbPKT_FILTINFO); these filters run
+/// after, on the host, for streams that need more: a line-noise notch on the raw group, or
+/// splitting one stream into LFP and spike bands.  Filters are designed from the same
+/// high-pass / low-pass corner (mHz), order and type fields cbPKT_FILTINFO uses, and applied
+/// by BiquadFilterBank to whole batches of samples at once.
+///
+/// BiquadFilterBank keeps its state channel-contiguous per section and runs every section
+/// across all channels of a sample before moving on, so the inner loop is SIMD over channels
+/// (SSE2, two channels per instruction, in double precision: float loses too much at corners
+/// far below the sample rate).  Attach one to a sample group with
+/// SdkSession::registerFilteredGroupBatchCallback().
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_FILTER_BANK_H
+#define CBSDK_FILTER_BANK_H
+
+#include <cbproto/cbproto.h>
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cbsdk {
+
+/// Second-order IIR section, normalised so a0 = 1
+///
+///   y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] - a1 y[n-1] - a2 y[n-2]
+struct Biquad {
+    double b0 = 1.0;
+    double b1 = 0.0;
+    double b2 = 0.0;
+    double a1 = 0.0;
+    double a2 = 0.0;
+};
+
+/// What to design; frequency fields are in mHz like cbPKT_FILTINFO (0 disables that stage)
+struct FilterSpec {
+    uint32_t hpfreq = 0;        ///< High-pass corner
+    uint32_t hporder = 0;       ///< High-pass order (1-16)
+    uint32_t hptype = cbFILTTYPE_BUTTERWORTH;
+    uint32_t lpfreq = 0;        ///< Low-pass corner
+    uint32_t lporder = 0;       ///< Low-pass order (1-16)
+    uint32_t lptype = cbFILTTYPE_BUTTERWORTH;
+    uint32_t notch_freq = 0;    ///< Notch centre (e.g. 60000 for 60 Hz line noise)
+    uint32_t notch_bandwidth = 2000;    ///< Notch -3 dB width
+
+    /// Corners, orders and types of a device filter description
+    static FilterSpec fromFiltInfo(const cbPKT_FILTINFO& info);
+};
+
+/// Largest order accepted for a high- or low-pass stage
+constexpr uint32_t FILTER_MAX_ORDER = 16;
+
+/// Design the biquad cascade for @p spec at @p sample_rate_hz
+///
+/// High- and low-pass stages are Butterworth (the type fields must be 0 or include
+/// cbFILTTYPE_BUTTERWORTH), made digital by the bilinear transform with pre-warped corners.
+/// Odd orders end in a first-order section (b2 = a2 = 0).  Sections are ordered high-pass,
+/// low-pass, notch.
+/// @return Error if a corner is at or above Nyquist, an order is out of range or a type is
+///         not Butterworth; an empty cascade if every stage is disabled
+cbutil::Result<std::vector<Biquad>> designFilter(const FilterSpec& spec, double sample_rate_hz);
+
+/// @return Complex gain magnitude of @p sections at @p freq_hz (for checking a design)
+double filterMagnitude(const std::vector<Biquad>& sections, double freq_hz, double sample_rate_hz);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Streaming biquad cascade applied to every channel of a sample group
+///
+/// Samples are row-major int16 [n_samples][n_channels], as the batch callbacks deliver them.
+/// Filter state persists across calls, so consecutive batches filter as one stream.  Not
+/// thread-safe; one bank serves one stream.
+///
+class BiquadFilterBank {
+public:
+    /// @param sections Cascade to apply (empty: pass-through)
+    /// @param channel_count Channels per sample (at least 1)
+    static cbutil::Result<BiquadFilterBank> create(std::vector<Biquad> sections, size_t channel_count);
+
+    BiquadFilterBank(BiquadFilterBank&&) noexcept;
+    BiquadFilterBank& operator=(BiquadFilterBank&&) noexcept;
+    BiquadFilterBank(const BiquadFilterBank&) = delete;
+    BiquadFilterBank& operator=(const BiquadFilterBank&) = delete;
+    ~BiquadFilterBank();
+
+    /// Filter @p n_samples rows, rounding and saturating to int16 (@p out may equal @p in)
+    void process(const int16_t* in, size_t n_samples, int16_t* out);
+
+    /// Filter @p n_samples rows without rounding
+    void process(const int16_t* in, size_t n_samples, float* out);
+
+    /// Clear the filter state, as if no samples had been seen
+    void reset();
+
+    [[nodiscard]] size_t channelCount() const;
+    [[nodiscard]] const std::vector<Biquad>& sections() const;
+
+private:
+    BiquadFilterBank();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_FILTER_BANK_H
@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   nsx_nev_format.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  On-disk structures of the Blackrock NSx 3.0 and NEV 3.0 file formats
+///
+/// These are the formats Central writes with 64-bit (PTP) timestamps, so files produced by
+/// cbsdk::Recorder open in the standard Blackrock tools (NPMK, neo, brPY).  All structures are
+/// packed and little-endian.
+///
+/// NSx (continuous, one file per sample group, ".ns1" ... ".ns6"):
+/// @code
+///   NsxBasicHeader                         314 bytes
+///   NsxChannelHeader[channel_count]        66 bytes each
+///   { NsxDataHeader; int16 data[num_points][channel_count]; }   -- repeated
+/// @endcode
+///
+/// NEV (events, ".nev"):
+/// @code
+///   NevBasicHeader                         336 bytes
+///   Nev*ExtHeader[extended_header_count]   32 bytes each
+///   fixed-size packets of bytes_per_packet bytes (spike or digital input)
+/// @endcode
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_NSX_NEV_FORMAT_H
+#define CBSDK_NSX_NEV_FORMAT_H
+
+#include <cstdint>
+
+namespace cbsdk {
+namespace fileformat {
+
+#pragma pack(push, 1)
+
+/// Windows SYSTEMTIME, as stored in both basic headers (UTC)
+struct FileTime {
+    uint16_t year;
+    uint16_t month;
+    uint16_t day_of_week;       ///< 0 = Sunday
+    uint16_t day;
+    uint16_t hour;
+    uint16_t minute;
+    uint16_t second;
+    uint16_t millisecond;
+};
+static_assert(sizeof(FileTime) == 16, "FileTime layout is part of the file format");
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// NSx 3.0
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// File type ID of NSx 3.0 files
+constexpr char NSX_FILE_TYPE_ID[8] = {'B', 'R', 'S', 'M', 'P', 'G', 'R', 'P'};
+
+/// Basic header of an NSx file
+struct NsxBasicHeader {
+    char file_type_id[8];           ///< NSX_FILE_TYPE_ID
+    uint8_t major_version;          ///< 3
+    uint8_t minor_version;          ///< 0
+    uint32_t bytes_in_headers;      ///< Basic + extended headers; data starts at this offset
+    char label[16];                 ///< Sample group label (e.g. "30 kS/s")
+    char comment[256];
+    uint32_t period;                ///< Sample period in 1/30000 s
+    uint32_t time_resolution;       ///< Timestamp ticks per second (1e9 for ns timestamps)
+    FileTime time_origin;           ///< Wall-clock time the recording started
+    uint32_t channel_count;
+};
+static_assert(sizeof(NsxBasicHeader) == 314, "NsxBasicHeader layout is part of the file format");
+
+/// Extended ("CC") header describing one NSx channel, in data order
+struct NsxChannelHeader {
+    char type[2];                   ///< "CC"
+    uint16_t electrode_id;          ///< 1-based channel ID
+    char label[16];
+    uint8_t physical_connector;     ///< Bank (1 = A)
+    uint8_t connector_pin;          ///< Terminal within the bank
+    int16_t min_digital_value;
+    int16_t max_digital_value;
+    int16_t min_analog_value;
+    int16_t max_analog_value;
+    char units[16];                 ///< Analog units (e.g. "uV")
+    uint32_t high_freq_corner;      ///< High-pass corner in mHz
+    uint32_t high_freq_order;
+    uint16_t high_filter_type;
+    uint32_t low_freq_corner;       ///< Low-pass corner in mHz
+    uint32_t low_freq_order;
+    uint16_t low_filter_type;
+};
+static_assert(sizeof(NsxChannelHeader) == 66, "NsxChannelHeader layout is part of the file format");
+
+/// Header of one NSx data packet; followed by num_points samples of every channel
+struct NsxDataHeader {
+    uint8_t header;                 ///< Always 1
+    uint64_t timestamp;             ///< Time of the first sample
+    uint32_t num_points;            ///< Samples per channel in this packet
+};
+static_assert(sizeof(NsxDataHeader) == 13, "NsxDataHeader layout is part of the file format");
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// NEV 3.0
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// File type ID of NEV 3.0 files
+constexpr char NEV_FILE_TYPE_ID[8] = {'B', 'R', 'E', 'V', 'E', 'N', 'T', 'S'};
+
+/// NevBasicHeader::flags bit: every spike waveform is stored as 16-bit samples
+constexpr uint16_t NEV_FLAG_WAVEFORMS_16BIT = 0x0001;
+
+/// Basic header of a NEV file
+struct NevBasicHeader {
+    char file_type_id[8];           ///< NEV_FILE_TYPE_ID
+    uint8_t major_version;          ///< 3
+    uint8_t minor_version;          ///< 0
+    uint16_t flags;                 ///< NEV_FLAG_*
+    uint32_t bytes_in_headers;      ///< Basic + extended headers; packets start at this offset
+    uint32_t bytes_per_packet;      ///< Size of every data packet
+    uint32_t time_resolution;       ///< Timestamp ticks per second (1e9 for ns timestamps)
+    uint32_t sample_resolution;     ///< Waveform sample rate (30000)
+    FileTime time_origin;           ///< Wall-clock time the recording started
+    char application[32];           ///< Name of the writing application
+    char comment[200];
+    char reserved[52];
+    uint32_t processor_timestamp;   ///< Low 32 bits of the first device timestamp
+    uint32_t extended_header_count;
+};
+static_assert(sizeof(NevBasicHeader) == 336, "NevBasicHeader layout is part of the file format");
+
+/// "NEUEVWAV": waveform format of one electrode
+struct NevWaveformExtHeader {
+    char id[8];                     ///< "NEUEVWAV"
+    uint16_t electrode_id;
+    uint8_t physical_connector;
+    uint8_t connector_pin;
+    uint16_t digitization_factor;   ///< nV per LSB
+    uint16_t energy_threshold;
+    int16_t high_threshold;         ///< uV
+    int16_t low_threshold;          ///< uV
+    uint8_t sorted_unit_count;
+    uint8_t bytes_per_sample;       ///< 2
+    uint16_t spike_width;           ///< Samples per waveform
+    char reserved[8];
+};
+static_assert(sizeof(NevWaveformExtHeader) == 32, "NevWaveformExtHeader layout is part of the file format");
+
+/// "NEUEVLBL": label of one electrode
+struct NevLabelExtHeader {
+    char id[8];                     ///< "NEUEVLBL"
+    uint16_t electrode_id;
+    char label[16];
+    char reserved[6];
+};
+static_assert(sizeof(NevLabelExtHeader) == 32, "NevLabelExtHeader layout is part of the file format");
+
+/// "NEUEVFLT": spike filter of one electrode
+struct NevFilterExtHeader {
+    char id[8];                     ///< "NEUEVFLT"
+    uint16_t electrode_id;
+    uint32_t high_freq_corner;      ///< mHz
+    uint32_t high_freq_order;
+    uint16_t high_filter_type;
+    uint32_t low_freq_corner;       ///< mHz
+    uint32_t low_freq_order;
+    uint16_t low_filter_type;
+    char reserved[2];
+};
+static_assert(sizeof(NevFilterExtHeader) == 32, "NevFilterExtHeader layout is part of the file format");
+
+/// "DIGLABEL": the digital input port
+struct NevDigitalLabelExtHeader {
+    char id[8];                     ///< "DIGLABEL"
+    char label[16];
+    uint8_t mode;                   ///< 0 = serial, 1 = parallel
+    char reserved[7];
+};
+static_assert(sizeof(NevDigitalLabelExtHeader) == 32, "NevDigitalLabelExtHeader layout is part of the file format");
+
+/// Start of every NEV data packet
+struct NevPacketHeader {
+    uint64_t timestamp;
+    uint16_t packet_id;             ///< 0 = digital input, 1..2048 = electrode of a spike
+};
+static_assert(sizeof(NevPacketHeader) == 10, "NevPacketHeader layout is part of the file format");
+
+/// Spike packet; followed by the waveform (spike_width int16 samples), then zero padding
+struct NevSpikePacket {
+    NevPacketHeader header;
+    uint8_t unit;                   ///< Sorted unit (0 = unsorted, 255 = noise)
+    uint8_t reserved;
+};
+static_assert(sizeof(NevSpikePacket) == 12, "NevSpikePacket layout is part of the file format");
+
+/// NevDigitalPacket::reason bits
+constexpr uint8_t NEV_DIGITAL_REASON_PARALLEL = 0x01;   ///< Parallel port value changed
+constexpr uint8_t NEV_DIGITAL_REASON_SERIAL = 0x80;     ///< Value came from the serial port
+
+/// Digital input packet; followed by zero padding up to bytes_per_packet
+struct NevDigitalPacket {
+    NevPacketHeader header;         ///< packet_id = 0
+    uint8_t reason;                 ///< NEV_DIGITAL_REASON_*
+    uint8_t reserved;
+    uint16_t value;                 ///< Value read from the port
+};
+static_assert(sizeof(NevDigitalPacket) == 14, "NevDigitalPacket layout is part of the file format");
+
+#pragma pack(pop)
+
+} // namespace fileformat
+} // namespace cbsdk
+
+#endif // CBSDK_NSX_NEV_FORMAT_H
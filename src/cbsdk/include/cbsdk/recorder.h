@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   recorder.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  In-process NSx/NEV recorder
+///
+/// Records continuous sample groups to NSx 3.0 files and spike / digital input events to a
+/// NEV 3.0 file (see cbsdk/nsx_nev_format.h), without Central.  Normally driven by
+/// SdkSession::startRecording(), which feeds it every dispatched packet batch.
+///
+/// write() only copies the packets into an in-memory buffer.  A dedicated writer thread swaps
+/// that buffer out, formats the packets and appends them to each file through large
+/// page-aligned buffers written with O_DIRECT (FILE_FLAG_NO_BUFFERING on Windows, F_NOCACHE on
+/// macOS), so neither the page cache nor a slow disk ever stalls the packet path.  If the disk
+/// falls too far behind, packets are counted as dropped instead.
+///
+/// With RecordingOptions::compress_continuous the groups are written losslessly compressed
+/// (cbsdk/continuous_codec.h) to "<base>.cbz<N>" instead, typically around half the NSx size;
+/// the NEV file is unchanged.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_RECORDER_H
+#define CBSDK_RECORDER_H
+
+#include <cbproto/cbproto.h>
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cbsdk {
+
+/// One recorded channel: its configuration when the recording started
+struct RecordingChannel {
+    cbPKT_CHANINFO info{};              ///< Channel configuration (chan, label, bank/term, scalin, caps)
+    cbFILTDESC continuous_filter{};     ///< Filter of the continuous stream (info.smpfilter)
+    cbFILTDESC spike_filter{};          ///< Filter of the spike stream (info.spkfilter)
+};
+
+/// One continuous sample group, written to "<base>.ns<group_id>" (or "<base>.cbz<group_id>")
+struct RecordingGroup {
+    uint32_t group_id = 0;                  ///< 1-6
+    uint32_t period = 1;                    ///< Sample period in 1/30000 s
+    std::vector<RecordingChannel> channels; ///< In the order of the group packet samples
+};
+
+/// What a recording contains; fixed for the lifetime of a Recorder
+struct RecordingLayout {
+    std::vector<RecordingGroup> groups;             ///< Groups with at least one channel
+    std::vector<RecordingChannel> event_channels;   ///< Channels whose spikes / digital inputs go to the NEV file
+    uint32_t spike_length = 48;                     ///< Samples per spike waveform
+};
+
+/// Recording options
+struct RecordingOptions {
+    /// Default backlog limit before packets are dropped
+    static constexpr size_t DEFAULT_MAX_PENDING_BYTES = 256 * 1024 * 1024;
+
+    /// Default size of each file's aligned write buffer
+    static constexpr size_t DEFAULT_WRITE_BUFFER_BYTES = 4 * 1024 * 1024;
+
+    std::string comment;                                    ///< Stored in every file header
+    size_t max_pending_bytes = DEFAULT_MAX_PENDING_BYTES;   ///< Backlog limit before packets are dropped
+    size_t write_buffer_bytes = DEFAULT_WRITE_BUFFER_BYTES; ///< Per-file write size (rounded up to 4 KiB)
+    bool direct_io = true;                                  ///< Bypass the page cache where the filesystem allows it
+    bool compress_continuous = false;                       ///< Write groups with the lossless continuous codec
+    uint32_t compress_chunk_samples = 4096;                 ///< Rows per compressed chunk (random-access granularity)
+};
+
+/// Recorder counters
+struct RecorderStats {
+    uint64_t continuous_packets = 0;        ///< Group packets written to NSx files
+    uint64_t spike_packets = 0;             ///< Spike packets written to the NEV file
+    uint64_t digital_packets = 0;           ///< Digital input packets written to the NEV file
+    uint64_t bytes_written = 0;             ///< File bytes written, headers included
+    uint64_t continuous_raw_bytes = 0;      ///< Uncompressed size of the compressed groups (0 unless compressing)
+    uint64_t continuous_encoded_bytes = 0;  ///< Encoded size of the compressed groups
+    uint64_t packets_dropped = 0;           ///< Packets discarded because the writer fell too far behind
+    uint64_t write_errors = 0;              ///< Failed writes (e.g. disk full); the recording stops on the first one
+    uint64_t pending_bytes = 0;             ///< Packet bytes waiting for the writer thread
+    bool direct_io = false;                 ///< Whether the files bypass the page cache
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief NSx/NEV file writer with a background disk thread
+///
+class Recorder {
+public:
+    /// Create the files, write their headers and start the writer thread
+    ///
+    /// Creates "<base_path>.nev" plus one "<base_path>.ns<N>" (or ".cbz<N>" when compressing) per
+    /// layout group (truncating existing files).  Timestamps are stored as they arrive, in nanoseconds.
+    /// @param base_path Output path without extension
+    /// @param layout Channels to record
+    /// @param options Recording options
+    /// @return Recorder on success, error if a file cannot be created
+    static cbutil::Result<Recorder> open(const std::string& base_path, const RecordingLayout& layout,
+                                         const RecordingOptions& options = {});
+
+    Recorder(Recorder&&) noexcept;
+    Recorder& operator=(Recorder&&) noexcept;
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /// Writes everything queued and closes the files
+    ~Recorder();
+
+    /// Queue a batch of packets (thread-safe, never blocks on disk)
+    ///
+    /// Packets that belong to no recorded group or event channel are skipped.
+    /// @param packets Packets in arrival order
+    /// @param count Number of packets
+    void write(const cbPKT_GENERIC* packets, size_t count);
+
+    /// Write everything queued so far, stop the writer thread and close the files
+    void close();
+
+    /// @return Snapshot of the counters
+    [[nodiscard]] RecorderStats stats() const;
+
+    /// @return Paths of the files being written, NEV first
+    [[nodiscard]] const std::vector<std::string>& files() const;
+
+private:
+    Recorder();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_RECORDER_H
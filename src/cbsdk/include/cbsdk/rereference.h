@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   rereference.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Re-referencing (common average / median, or per-electrode) of continuous group data
+///
+/// A Rereferencer subtracts a reference from every column of a batch: the mean or median, per
+/// sample, of the pool of columns the column belongs to (common average reference when the
+/// pool is every front-end channel, bank-wise when pools are banks), or the sample of one
+/// other column (a reference electrode).  SdkSession::createRereferencedGroup() builds the
+/// pools from channel metadata and publishes the result as a virtual sample group, so one
+/// pass serves every consumer.
+///
+/// Each batch is transposed to a channel-major float block first, so pool sums and
+/// subtractions run along samples, four per SSE instruction.  Medians are taken per sample
+/// with a selection over the pool's values.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_REREFERENCE_H
+#define CBSDK_REREFERENCE_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cbsdk {
+
+/// How a pool's reference is computed
+enum class ReferenceStatistic : uint32_t {
+    MEAN   = 0,     ///< Average of the pool (CAR)
+    MEDIAN = 1,     ///< Median of the pool; robust to a few noisy or saturated channels
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Re-references every row of a sample group batch in place
+///
+/// Samples are row-major int16 [n_samples][n_channels], as the batch callbacks deliver them.
+/// Results are rounded and saturated to int16.  Stateless between batches; not thread-safe
+/// (it reuses scratch buffers), so one Rereferencer serves one stream.
+///
+class Rereferencer {
+public:
+    /// Reference each column to a statistic of its pool
+    /// @param pools Pool id of each column (any value; columns with equal ids share a pool),
+    ///              or -1 for a column that is neither referenced nor part of a reference
+    /// @return Error if @p pools is empty
+    static cbutil::Result<Rereferencer> createPooled(std::vector<int32_t> pools, ReferenceStatistic statistic);
+
+    /// Reference each column to one other column
+    /// @param references Column whose sample is subtracted from each column, or -1 for none
+    /// @return Error if @p references is empty or names a column out of range
+    static cbutil::Result<Rereferencer> createElectrode(std::vector<int32_t> references);
+
+    Rereferencer(Rereferencer&&) noexcept;
+    Rereferencer& operator=(Rereferencer&&) noexcept;
+    Rereferencer(const Rereferencer&) = delete;
+    Rereferencer& operator=(const Rereferencer&) = delete;
+    ~Rereferencer();
+
+    /// Re-reference @p n_samples rows of channelCount() columns in place
+    void process(int16_t* samples, size_t n_samples);
+
+    [[nodiscard]] size_t channelCount() const;
+
+    /// @return Number of distinct pools (0 for electrode referencing)
+    [[nodiscard]] size_t poolCount() const;
+
+private:
+    Rereferencer();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_REREFERENCE_H
@@ -0,0 +1,98 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   resampler.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Streaming polyphase FIR resampling of continuous group data
+///
+/// Turns a sample group into one at a rational fraction of its rate (up / down), e.g. 1 kHz
+/// LFP from the 30 kHz raw group with up = 1, down = 30.  The anti-aliasing low-pass is the
+/// Kaiser-windowed sinc scipy.signal.resample_poly uses, split into @c up polyphase branches
+/// so only the taps that meet a real input sample are evaluated, once per output sample.
+///
+/// Input rows are converted to float and kept channel-contiguous, so every tap is one
+/// multiply-add across a whole block of channels (SSE, four channels per instruction).
+/// SdkSession::createResampledGroup() runs one on the callback thread and publishes its
+/// output as a virtual sample group.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_RESAMPLER_H
+#define CBSDK_RESAMPLER_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cbsdk {
+
+/// Largest up or down factor (after reducing up / down to lowest terms)
+constexpr uint32_t RESAMPLER_MAX_FACTOR = 256;
+
+/// Design the anti-aliasing FIR for resampling by @p up / @p down
+///
+/// 20 * max(up, down) + 1 taps of a sinc with its cutoff at the lower of the two Nyquist
+/// rates, under a Kaiser window (beta 5), scaled by @p up so the DC gain is 1.
+/// @return Error if a factor is 0 or above RESAMPLER_MAX_FACTOR
+cbutil::Result<std::vector<float>> designResamplerTaps(uint32_t up, uint32_t down);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Streaming rational resampler applied to every channel of a sample group
+///
+/// Samples are row-major int16 [n_samples][n_channels], as the batch callbacks deliver them.
+/// Consecutive calls resample one stream: output sample k represents input position
+/// k * down / up, and is produced as soon as the filter has seen the input it needs, i.e.
+/// groupDelay() input samples later.  Output timestamps are interpolated from the input
+/// timestamps at that position, so they are the time the sample represents, not the time it
+/// was produced.  Not thread-safe; one resampler serves one stream.
+///
+class PolyphaseResampler {
+public:
+    /// @param up Interpolation factor (1 for pure decimation)
+    /// @param down Decimation factor
+    /// @param channel_count Channels per sample (at least 1)
+    static cbutil::Result<PolyphaseResampler> create(uint32_t up, uint32_t down, size_t channel_count);
+
+    /// @param taps Filter at up times the input rate (DC gain up); length at least 1
+    static cbutil::Result<PolyphaseResampler> create(uint32_t up, uint32_t down, std::vector<float> taps,
+                                                     size_t channel_count);
+
+    PolyphaseResampler(PolyphaseResampler&&) noexcept;
+    PolyphaseResampler& operator=(PolyphaseResampler&&) noexcept;
+    PolyphaseResampler(const PolyphaseResampler&) = delete;
+    PolyphaseResampler& operator=(const PolyphaseResampler&) = delete;
+    ~PolyphaseResampler();
+
+    /// Upper bound on the samples one process() call of @p n_samples rows can produce
+    [[nodiscard]] size_t maxOutput(size_t n_samples) const;
+
+    /// Resample @p n_samples rows, rounding and saturating to int16
+    /// @param timestamps Device timestamp of each input row
+    /// @param out Receives up to maxOutput(n_samples) rows
+    /// @param out_timestamps Receives one timestamp per output row
+    /// @return Number of rows written
+    size_t process(const int16_t* in, const uint64_t* timestamps, size_t n_samples, int16_t* out,
+                   uint64_t* out_timestamps);
+
+    /// Forget all input, as if no samples had been seen
+    void reset();
+
+    [[nodiscard]] uint32_t up() const;
+    [[nodiscard]] uint32_t down() const;
+    [[nodiscard]] size_t channelCount() const;
+
+    /// @return Input samples between an input and the output that represents the same time
+    [[nodiscard]] double groupDelay() const;
+
+private:
+    PolyphaseResampler();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_RESAMPLER_H
@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   sample_layout.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Transposition and physical-unit scaling of batches of continuous samples
+///
+/// Group packets carry one sample of every channel, so batches are naturally sample-major
+/// int16 [n_samples][n_channels].  Most analyses want each channel's samples contiguous, in
+/// physical units.  These kernels do both in one pass over cache-sized blocks of samples,
+/// walking each block in small tiles transposed in SSE2 registers: eight channels by eight
+/// samples for int16, four by four for float, where each row of the tile is widened and
+/// mapped through its channels' gains and offsets as one vector (loaded once per block
+/// rather than per sample) before the transpose.  SdkSession::registerScaledGroupBatchCallback()
+/// runs them on the batches it delivers.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_SAMPLE_LAYOUT_H
+#define CBSDK_SAMPLE_LAYOUT_H
+
+#include <cbproto/cbproto.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace cbsdk {
+
+/// Order of the samples in a batch
+enum class SampleLayout : uint32_t {
+    SAMPLE_MAJOR = 0,   ///< [n_samples][n_channels], as the group packets carry them
+    CHANNEL_MAJOR = 1,  ///< [n_channels][n_samples]: each channel's samples contiguous
+};
+
+/// Affine map of a channel from digital steps to physical units: value = raw * gain + offset
+struct ChannelScale {
+    float gain = 1.0f;
+    float offset = 0.0f;
+};
+
+/// Scale of a channel's input scaling (cbPKT_CHANINFO::scalin)
+///
+/// Voltages are given in µV whatever the channel's unit ("mV" and "V" are converted); other
+/// units (e.g. "MPa") are kept.  A scaling with no digital span maps to raw steps.
+ChannelScale channelScale(const cbSCALING& scaling);
+
+/// Transpose a sample-major batch to channel-major
+/// @param in [n_samples][n_channels]
+/// @param out [n_channels][n_samples]; must not overlap @p in
+void transposeSamples(const int16_t* in, size_t n_samples, size_t n_channels, int16_t* out);
+
+/// Convert a sample-major batch to float physical units
+/// @param in [n_samples][n_channels]
+/// @param scales One per channel (column of @p in)
+/// @param layout Order to write @p out in
+/// @param out n_samples * n_channels values
+void scaleSamples(const int16_t* in, size_t n_samples, size_t n_channels, const ChannelScale* scales,
+                  SampleLayout layout, float* out);
+
+} // namespace cbsdk
+
+#endif // CBSDK_SAMPLE_LAYOUT_H
@@ -30,6 +30,17 @@
 // Protocol types (from upstream)
 #include <cbproto/cbproto.h>
 #include <cbutil/result.h>
+#include <cbsdk/recorder.h>
+#include <cbsdk/filter_bank.h>
+#include <cbsdk/sample_layout.h>
+#include <cbsdk/resampler.h>
+#include <cbsdk/rereference.h>
+#include <cbsdk/spike_detector.h>
+#include <cbsdk/spike_binner.h>
+#include <cbsdk/band_power.h>
+#include <cbsdk/epoch_extractor.h>
+#include <cbsdk/digital_input_tracker.h>
+#include <cbsdk/spike_sorter.h>
 
 namespace cbsdk {
 
@@ -128,6 +139,7 @@ struct SdkConfig {
     int recv_buffer_size = 6000000;           ///< UDP receive buffer (6MB)
     bool non_blocking = false;                ///< Non-blocking sockets (false = blocking, better for dedicated receive thread)
     bool autorun = true;                     ///< Automatically start device (full handshake). If false, only requests configuration.
+    uint32_t latency_sample_interval = 64;   ///< Time every Nth data packet for getLatencyStats() (0 = off)
 
     // Optional custom device configuration (overrides device_type mapping)
     // Used rarely for non-standard network configurations
@@ -135,6 +147,11 @@ struct SdkConfig {
     std::optional<std::string> custom_client_address;   ///< Override client IP
     std::optional<uint16_t> custom_device_port;         ///< Override device port
     std::optional<uint16_t> custom_client_port;         ///< Override client port
+
+    // Capture and replay of raw device datagrams (STANDALONE mode only)
+    std::optional<std::string> capture_path;  ///< Record every received datagram, from the handshake on
+    std::optional<std::string> replay_path;   ///< Replay this capture instead of connecting to a device
+    double replay_speed = 1.0;                ///< Replay pace relative to the recording (0 = as fast as possible)
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -156,6 +173,7 @@ struct SdkStats {
     uint64_t packets_dropped = 0;                ///< Dropped due to queue overflow
     uint64_t queue_current_depth = 0;            ///< Current queue usage
     uint64_t queue_max_depth = 0;                ///< Peak queue usage
+    uint64_t queue_capacity = 0;                 ///< Packets the queue holds
 
     // Transmit statistics (STANDALONE mode only)
     uint64_t packets_sent_to_device = 0;         ///< Packets sent to device
@@ -165,6 +183,12 @@ struct SdkStats {
     uint64_t receive_errors = 0;                 ///< Socket receive errors
     uint64_t send_errors = 0;                    ///< Socket send errors
 
+    // CPU time consumed by each session thread so far, sampled every 100 ms
+    // (0 for threads this mode does not run, or where the platform does not report it)
+    uint64_t receive_thread_cpu_ns = 0;
+    uint64_t callback_thread_cpu_ns = 0;
+    uint64_t send_thread_cpu_ns = 0;
+
     void reset() {
         packets_received_from_device = 0;
         bytes_received_from_device = 0;
@@ -174,13 +198,42 @@ struct SdkStats {
         packets_dropped = 0;
         queue_current_depth = 0;
         queue_max_depth = 0;
+        queue_capacity = 0;
         packets_sent_to_device = 0;
         shmem_store_errors = 0;
         receive_errors = 0;
         send_errors = 0;
+        receive_thread_cpu_ns = 0;
+        callback_thread_cpu_ns = 0;
+        send_thread_cpu_ns = 0;
     }
 };
 
+/// Latency percentiles of one pipeline stage, in nanoseconds (all zero until count > 0)
+struct LatencySummary {
+    uint64_t count = 0;    ///< Sampled packets
+    uint64_t min_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p90_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    uint64_t max_ns = 0;
+    double mean_ns = 0;
+};
+
+/// Per-stage latency of sampled data packets (STANDALONE mode only)
+///
+/// Every SdkConfig::latency_sample_interval-th data packet is timed through the pipeline.
+/// Stages that start at the device timestamp need clock sync and stay empty until an offset
+/// is available.  Percentiles come from HDR-style histograms (bins 3-6% wide).
+struct LatencyStats {
+    LatencySummary device_to_arrival;    ///< Device timestamp -> datagram accepted by the socket
+    LatencySummary arrival_to_store;     ///< Socket -> written to shared memory
+    LatencySummary store_to_dequeue;     ///< Shared memory -> picked up by the callback thread
+    LatencySummary dequeue_to_callback;  ///< Callback thread -> the packet's user callbacks returned
+    LatencySummary device_to_callback;   ///< Whole pipeline: device timestamp -> callbacks returned
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Channel Type (for typed event callbacks)
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -216,6 +269,159 @@ enum class SampleRate : uint32_t {
     SR_RAW  = 6   ///< 30 kHz raw (unfiltered)
 };
 
+/// @return Samples per second of a sampling group (0 for NONE)
+constexpr double sampleRateHz(const SampleRate rate) {
+    switch (rate) {
+        case SampleRate::SR_500:   return 500.0;
+        case SampleRate::SR_1kHz:  return 1000.0;
+        case SampleRate::SR_2kHz:  return 2000.0;
+        case SampleRate::SR_10kHz: return 10000.0;
+        case SampleRate::SR_30kHz:
+        case SampleRate::SR_RAW:   return 30000.0;
+        default:                   return 0.0;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Virtual Sample Groups
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Identifies a virtual sample group (never 0)
+using VirtualGroupId = uint32_t;
+
+/// What a virtual sample group does to its source
+enum class VirtualGroupKind : uint32_t {
+    RESAMPLED     = 0,  ///< Resampled by a PolyphaseResampler
+    REREFERENCED  = 1,  ///< Re-referenced by a Rereferencer, at the source rate
+};
+
+/// Which channels a re-referenced group subtracts from each channel
+enum class ReferenceScheme : uint32_t {
+    COMMON    = 0,  ///< All front-end channels of the group form one pool
+    BANK      = 1,  ///< One pool per bank (cbPKT_CHANINFO::bank)
+    HEADSTAGE = 2,  ///< One pool per headstage of the loaded channel maps (position[3], see loadChannelMap())
+    ELECTRODE = 3,  ///< Each channel's own reference electrode (cbPKT_CHANINFO::refelecchan)
+};
+
+/// Description and counters of a virtual sample group
+struct VirtualGroupInfo {
+    VirtualGroupKind kind = VirtualGroupKind::RESAMPLED;
+    SampleRate source = SampleRate::NONE;   ///< Group it is derived from
+    uint32_t up = 1;                        ///< Resampling factors, in lowest terms
+    uint32_t down = 1;
+    double sample_rate_hz = 0;              ///< Output rate: sampleRateHz(source) * up / down
+    double group_delay = 0;                 ///< Filter delay, in source samples
+    size_t channel_count = 0;               ///< Channels per sample (0 until data arrives)
+    size_t buffer_capacity = 0;             ///< Samples the ring buffer holds
+    size_t buffered = 0;                    ///< Samples waiting in the ring buffer
+    uint64_t samples_produced = 0;          ///< Output samples since creation
+    uint64_t samples_overwritten = 0;       ///< Samples dropped from a full ring buffer unread
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Band Power
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Identifies a band power stream (never 0)
+using BandPowerStreamId = uint32_t;
+
+/// Description and counters of a band power stream
+struct BandPowerStreamInfo {
+    SampleRate source = SampleRate::NONE;   ///< Device group it is computed from (or that of source_virtual)
+    VirtualGroupId source_virtual = 0;      ///< Virtual group it is computed from (0: the device group)
+    double sample_rate_hz = 0;              ///< Rate of the input samples
+    size_t window = 0;                      ///< FFT length, in input samples
+    size_t hop = 0;                         ///< Input samples between feature vectors
+    size_t band_count = 0;
+    size_t channel_count = 0;               ///< Channels per vector (0 until data arrives)
+    size_t buffer_capacity = 0;             ///< Vectors the ring buffer holds
+    size_t buffered = 0;                    ///< Vectors waiting in the ring buffer
+    uint64_t frames_produced = 0;           ///< Vectors since creation
+    uint64_t frames_overwritten = 0;        ///< Vectors dropped from a full ring buffer unread
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Peri-Event Epochs
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Identifies an epoch stream (never 0)
+using EpochStreamId = uint32_t;
+
+/// Event packets that cut epochs (see SdkSession::createEpochStream())
+struct EpochTriggers {
+    std::vector<uint32_t> channels;     ///< Event channels that trigger: digital/serial inputs (cbPKT_DINP)
+                                        ///< or spiking channels (cbPKT_SPK, device or host-detected)
+    uint32_t unit_mask = 0xFFFFFFFF;    ///< Spike units that trigger (bit u = unit u)
+    bool comments = false;              ///< Comments (cbPKT_COMMENT) trigger too
+};
+
+/// Description and counters of an epoch stream
+struct EpochStreamInfo {
+    SampleRate source = SampleRate::NONE;   ///< Device group the epochs are cut from
+    size_t pre_samples = 0;
+    size_t post_samples = 0;
+    size_t channel_count = 0;               ///< Channels per row (0 until data arrives)
+    size_t pending = 0;                     ///< Events waiting for their post window
+    size_t buffer_capacity = 0;             ///< Epochs the ring buffer holds
+    size_t buffered = 0;                    ///< Epochs waiting in the ring buffer
+    uint64_t epochs_produced = 0;           ///< Epochs since creation
+    uint64_t epochs_overwritten = 0;        ///< Epochs dropped from a full ring buffer unread
+    uint64_t events_late = 0;               ///< Events whose window had left the history
+    uint64_t events_dropped = 0;            ///< Events over max_pending, or pending at a clock restart
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Host Spike Detection
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Settings of host-side spike detection (see SdkSession::startSpikeDetection())
+struct SpikeDetectionConfig {
+    SampleRate source = SampleRate::SR_RAW;     ///< Group to detect on
+    std::vector<Biquad> filter;                 ///< Applied before detection, e.g. a 250 Hz high-pass
+                                                ///< from designFilter() (empty: detect on the samples as sent)
+    SpikeThreshold threshold = SpikeThreshold::rms(-4.5f);  ///< Initial threshold of the front-end channels
+    uint32_t refractory_samples = 30;           ///< Minimum samples between spikes on a channel
+    uint32_t rms_window = 30000;                ///< Samples the RMS thresholds average over
+};
+
+/// Parameters of host-side spike sorting (see SdkSession::startSpikeSorting())
+struct SpikeSortingConfig {
+    float gate = 9.21f;                         ///< Largest squared Mahalanobis distance to a unit
+                                                ///< (chi-square with 2 degrees of freedom at 99 %)
+    size_t threads = 0;                         ///< Worker threads besides the callback thread's
+    bool device_spikes = true;                  ///< Also sort unsorted device-extracted spikes
+                                                ///< (false: host-detected spikes only)
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Batch Formats
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// How many samples a batch callback receives at a time
+///
+/// By default a callback gets whatever the callback thread drained in one go (up to 32
+/// packets in STANDALONE, 128 in CLIENT).  A policy buffers the subscription's rows in the
+/// SDK and re-cuts them: max_samples = 1 delivers every sample as soon as it is drained,
+/// min_samples = max_samples = N delivers blocks of exactly N, and max_delay_us bounds how
+/// long a short block may wait.  If the group's channel count changes, rows still buffered
+/// are delivered at once in their old shape (a short block included) before the new rows.
+struct BatchPolicy {
+    size_t min_samples = 0;                     ///< Hold rows until this many are buffered (0: none)
+    size_t max_samples = 0;                     ///< Split larger blocks (0: no limit; else >= min_samples)
+    uint32_t max_delay_us = 0;                  ///< Deliver a short block once its oldest row has
+                                                ///< waited this long on the host (0: no limit;
+                                                ///< else min_samples >= 2)
+};
+
+/// Shape of the samples a formatted batch callback receives (see
+/// SdkSession::registerFormattedGroupBatchCallback() and registerScaledGroupBatchCallback())
+struct GroupBatchFormat {
+    std::vector<uint32_t> chan_ids;             ///< Channels to deliver, in this order (empty: the whole group)
+    std::vector<Biquad> sections;               ///< Host-side filter applied first (empty: none)
+    SampleLayout layout = SampleLayout::SAMPLE_MAJOR;
+    BatchPolicy policy;                         ///< Block sizes to deliver (default: as drained)
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Channel Info Field (for bulk getters)
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -265,6 +471,34 @@ using GroupCallback = std::function<void(const cbPKT_GROUP& pkt)>;
 using GroupBatchCallback = std::function<void(const int16_t* samples, size_t n_samples,
                                               size_t n_channels, const uint64_t* timestamps)>;
 
+/// Scaled batch callback — a group's samples in physical units (µV for voltages).
+/// @param samples n_samples × n_channels floats, in the layout of the registration's format
+/// @param n_samples Number of samples (packets) in this batch
+/// @param n_channels Number of channels per sample
+/// @param timestamps Device timestamp for each sample (array of n_samples)
+using ScaledGroupBatchCallback = std::function<void(const float* samples, size_t n_samples,
+                                                    size_t n_channels, const uint64_t* timestamps)>;
+
+/// Band power callback — the feature vectors one batch completed (see createBandPowerStream()).
+/// @param features Band power [n_frames × n_channels × n_bands], row-major
+/// @param timestamps Device timestamp of the newest sample in each vector's window
+using BandPowerCallback = std::function<void(const float* features, size_t n_frames, size_t n_channels,
+                                             size_t n_bands, const uint64_t* timestamps)>;
+
+/// Epoch callback — one completed peri-event window (see createEpochStream()).
+/// @param event The triggering event
+/// @param samples Contiguous int16 sample data [n_samples × n_channels], row-major
+/// @param n_samples pre_samples + post_samples
+/// @param timestamps Device timestamp of each row
+using EpochCallback = std::function<void(const EpochEvent& event, const int16_t* samples, size_t n_samples,
+                                         size_t n_channels, const uint64_t* timestamps)>;
+
+/// Spike bin callback — one completed bin of spike counts (see startSpikeBinning()).
+/// @param start_time Device time the bin starts at (a multiple of the bin width)
+/// @param counts Spike counts [n_channels × n_units], row-major (row = channel ID - 1)
+using SpikeBinCallback = std::function<void(uint64_t start_time, const uint32_t* counts,
+                                            size_t n_channels, size_t n_units)>;
+
 /// Config callback for system/configuration packets (chid & 0x8000)
 /// @param pkt The received config packet
 using ConfigCallback = std::function<void(const cbPKT_GENERIC& pkt)>;
@@ -278,6 +512,65 @@ using RunlevelCallback = std::function<void(uint32_t runlevel)>;
 /// @param error_message Description of the error
 using ErrorCallback = std::function<void(const std::string& error_message)>;
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous Configuration
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Completion callback for an asynchronous configuration operation.
+/// Runs on the thread that observed the final CHANREP (or the deadline), so keep it short.
+/// @param result Ok once every channel acknowledged; error on timeout, send failure or shutdown
+using ConfigCompletionCallback = std::function<void(const Result<void>& result)>;
+
+struct ConfigOperationState;
+class ConfigTracker;
+class ConfigTransaction;
+
+/// Outcome of SdkSession::commitConfigTransaction()
+struct ConfigCommitStats {
+    size_t channels = 0;  ///< Distinct channels touched by the transaction's setters
+    size_t sent = 0;      ///< CHANSET* packets sent (at most one per channel)
+    size_t skipped = 0;   ///< Channels omitted because nothing changed (skipUnchanged only)
+};
+
+/// Handle to an in-flight asynchronous configuration change (see SdkSession::*Async()).
+///
+/// Completion is tracked per channel: the operation finishes when every channel it changed
+/// has echoed the CHANREP* answering its CHANSET* type, instead of waiting on a global SYSREP
+/// barrier.  Copies share the
+/// same operation; dropping every handle does not cancel it.
+class ConfigOperation {
+public:
+    /// Invalid handle
+    ConfigOperation() = default;
+
+    /// Whether this handle refers to an operation
+    bool valid() const;
+
+    /// Whether the operation has finished (successfully or not)
+    bool done() const;
+
+    /// Whether the operation failed because its deadline passed
+    bool timedOut() const;
+
+    /// Number of channels still awaiting acknowledgement
+    uint32_t pendingChannels() const;
+
+    /// Block until the operation finishes or @p timeout_ms elapses.
+    /// Timing out here does not cancel the operation; it keeps its own deadline.
+    /// @return The operation's result, or an error if it is still pending
+    Result<void> wait(uint32_t timeout_ms = 5000) const;
+
+    /// Register a completion callback.  Runs immediately (on the caller's thread) if the
+    /// operation has already finished.
+    void onComplete(ConfigCompletionCallback callback) const;
+
+private:
+    friend class ConfigTracker;
+    explicit ConfigOperation(std::shared_ptr<ConfigOperationState> state);
+
+    std::shared_ptr<ConfigOperationState> m_state;
+};
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // SdkSession - Main API
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -376,6 +669,71 @@ public:
     /// @return Handle for unregistration
     CallbackHandle registerGroupBatchCallback(SampleRate rate, GroupBatchCallback callback) const;
 
+    /// Register a batch callback that receives the group's samples after a host-side filter.
+    /// Each registration has its own filter state (see cbsdk/filter_bank.h), created on the
+    /// first batch and reset if the group's channel count changes.  Samples are rounded and
+    /// saturated to int16.
+    /// @param rate Sample rate to match (SR_500 through SR_RAW)
+    /// @param sections Cascade to apply, e.g. from designFilter(spec, sampleRateHz(rate))
+    /// @param callback Function receiving the filtered (samples, n_samples, n_channels, timestamps)
+    /// @return Handle for unregistration
+    CallbackHandle registerFilteredGroupBatchCallback(SampleRate rate, std::vector<Biquad> sections,
+                                                      GroupBatchCallback callback) const;
+
+    /// Register a batch callback that receives only some channels of a group.
+    /// Only the subscribed columns are copied out of each group packet, so the cost of the
+    /// callback scales with @p chan_ids rather than with the group.  Columns arrive in the
+    /// order of @p chan_ids.  The channels are looked up in the group when registering:
+    /// register again after changing group membership (batches whose channel count no longer
+    /// matches are skipped).
+    /// @param rate Sample rate to match (SR_500 through SR_RAW)
+    /// @param chan_ids 1-based channel IDs, each a member of the group
+    /// @param callback Function receiving (samples, n_samples, chan_ids.size(), timestamps)
+    /// @return Handle for unregistration, or error if @p chan_ids is empty or names a channel
+    ///         that is not in the group
+    Result<CallbackHandle> registerGroupBatchCallback(SampleRate rate, const std::vector<uint32_t>& chan_ids,
+                                                     GroupBatchCallback callback) const;
+
+    /// Register a batch callback that receives some channels of a group after a host-side
+    /// filter, which runs on those channels only (see the two overloads above)
+    /// @return Handle for unregistration, or error if @p chan_ids is empty or names a channel
+    ///         that is not in the group
+    Result<CallbackHandle> registerFilteredGroupBatchCallback(SampleRate rate, const std::vector<uint32_t>& chan_ids,
+                                                             std::vector<Biquad> sections,
+                                                             GroupBatchCallback callback) const;
+
+    /// Register a batch callback that receives int16 samples in the shape of @p format.
+    /// Channels, filter and layout combine as in the overloads above; CHANNEL_MAJOR batches
+    /// are transposed by the SDK (see cbsdk/sample_layout.h) after filtering.
+    ///
+    /// With a BatchPolicy, filtered rows are buffered per registration and delivered in the
+    /// blocks it asks for.  Blocks held for max_delay_us are flushed by the callback thread,
+    /// which checks about every millisecond even without new packets.  Buffered rows are
+    /// dropped on unregistering, and delivered early when the group's channel count changes.
+    /// @param rate Sample rate to match (SR_500 through SR_RAW)
+    /// @param format Channels, filter, layout and batching to deliver
+    /// @param callback Function receiving (samples, n_samples, n_channels, timestamps)
+    /// @return Handle for unregistration, or error if a channel of @p format is not in the group,
+    ///         the group has no channels, or the policy's max_samples is below its min_samples
+    ///         or it sets max_delay_us with min_samples below 2
+    Result<CallbackHandle> registerFormattedGroupBatchCallback(SampleRate rate, const GroupBatchFormat& format,
+                                                              GroupBatchCallback callback) const;
+
+    /// Register a batch callback that receives float samples in physical units.
+    /// Each channel's input scaling (cbPKT_CHANINFO::scalin, see channelScale()) is read when
+    /// registering, like the channel list: register again after changing a channel's scaling
+    /// or the group's membership.  Filtering runs on the int16 samples, then the batch is
+    /// scaled and, for CHANNEL_MAJOR, transposed in the same pass.
+    /// Batching follows @p format's policy as for registerFormattedGroupBatchCallback().
+    /// @param rate Sample rate to match (SR_500 through SR_RAW)
+    /// @param format Channels, filter, layout and batching to deliver
+    /// @param callback Function receiving (samples, n_samples, n_channels, timestamps)
+    /// @return Handle for unregistration, or error if a channel of @p format is not in the group,
+    ///         the group has no channels, or the policy's max_samples is below its min_samples
+    ///         or it sets max_delay_us with min_samples below 2
+    Result<CallbackHandle> registerScaledGroupBatchCallback(SampleRate rate, const GroupBatchFormat& format,
+                                                           ScaledGroupBatchCallback callback) const;
+
     /// Register callback for config/system packets
     /// @param packet_type Packet type to match (e.g. cbPKTTYPE_COMMENTREP, cbPKTTYPE_SYSREPRUNLEV)
     /// @param callback Function to call for matching config packets
@@ -400,6 +758,317 @@ public:
     /// @param callback Function to call when errors occur
     void setErrorCallback(ErrorCallback callback);
 
+    ///--------------------------------------------------------------------------------------------
+    /// Virtual Sample Groups
+    ///--------------------------------------------------------------------------------------------
+
+    /// Derive a sample group at @p up / @p down times the rate of @p source
+    ///
+    /// A PolyphaseResampler (see cbsdk/resampler.h) runs on the callback thread against each
+    /// batch of the source group, before the batch callbacks.  Its output goes to a ring buffer
+    /// of @p buffer_samples samples (oldest overwritten first; drain it with
+    /// readVirtualGroup()) and to the group's own batch callbacks.  The resampler restarts if
+    /// the source group's channel count changes.
+    /// @param source Group to resample (SR_500 through SR_RAW)
+    /// @param up Interpolation factor, e.g. 1
+    /// @param down Decimation factor, e.g. 30 for 1 kHz from SR_RAW
+    /// @param buffer_samples Ring buffer capacity in output samples (0: no buffering)
+    /// @return Id of the new group, or error for an invalid source or factor
+    Result<VirtualGroupId> createResampledGroup(SampleRate source, uint32_t up, uint32_t down,
+                                                size_t buffer_samples);
+
+    /// Derive a sample group that is @p source re-referenced
+    ///
+    /// Pools (or, for ELECTRODE, reference columns) are built from the group's channel list
+    /// and channel metadata when the group is created; only front-end channels are pooled,
+    /// and channels without a pool or reference pass through unchanged.  Like
+    /// createResampledGroup(), it runs once per batch on the callback thread, whatever the
+    /// number of subscribers, and fills a ring buffer and the group's batch callbacks.  The
+    /// plan describes the configuration at creation: recreate the group after changing group
+    /// membership, banks or the channel map (batches whose channel count no longer matches
+    /// are skipped).
+    /// @param source Group to re-reference (SR_500 through SR_RAW)
+    /// @param scheme Pools to reference each channel to
+    /// @param statistic Mean or median of each pool (ignored for ELECTRODE)
+    /// @param buffer_samples Ring buffer capacity in samples (0: no buffering)
+    /// @return Id of the new group, or error if @p source is invalid or has no channels
+    Result<VirtualGroupId> createRereferencedGroup(SampleRate source, ReferenceScheme scheme,
+                                                   ReferenceStatistic statistic, size_t buffer_samples);
+
+    /// Stop a virtual group and drop its batch callbacks
+    /// @return Error if @p group does not exist
+    Result<void> destroyVirtualGroup(VirtualGroupId group);
+
+    /// Register a batch callback for a virtual group's output
+    /// @param group Id from createResampledGroup() or createRereferencedGroup()
+    /// @param callback Function receiving (samples, n_samples, n_channels, timestamps)
+    /// @return Handle for unregistration, or 0 if @p group does not exist
+    CallbackHandle registerVirtualGroupBatchCallback(VirtualGroupId group, GroupBatchCallback callback) const;
+
+    /// @return Description and counters of @p group, or error if it does not exist
+    Result<VirtualGroupInfo> getVirtualGroupInfo(VirtualGroupId group) const;
+
+    /// Move the oldest buffered samples of @p group out of its ring buffer
+    /// @param group Id from createResampledGroup() or createRereferencedGroup()
+    /// @param samples Receives row-major [n][channel_count] samples
+    /// @param timestamps Receives one timestamp per sample (may be null)
+    /// @param max_samples Rows @p samples can hold
+    /// @param max_channels Channels per row @p samples can hold
+    /// @param[out] n_channels Channels per row written
+    /// @return Number of rows written, or error if @p group does not exist or has more
+    ///         than @p max_channels channels
+    Result<size_t> readVirtualGroup(VirtualGroupId group, int16_t* samples, uint64_t* timestamps,
+                                    size_t max_samples, size_t max_channels, size_t& n_channels) const;
+
+    ///--------------------------------------------------------------------------------------------
+    /// Band Power
+    ///--------------------------------------------------------------------------------------------
+
+    /// Compute per-channel band power of a sample group
+    ///
+    /// A BandPowerEngine (see cbsdk/band_power.h) runs on the callback thread against each
+    /// batch of the source group.  Every @c hop samples it produces a feature vector of
+    /// [channels][bands] floats, which goes to a ring buffer of @p buffer_frames vectors
+    /// (drain it with readBandPower()) and to the stream's callbacks.  The engine restarts if
+    /// the source's channel count changes.
+    /// @param source Group to analyse (SR_500 through SR_RAW)
+    /// @param config Window, hop and bands
+    /// @param buffer_frames Ring buffer capacity in vectors (0: no buffering)
+    /// @return Id of the new stream, or error for an invalid source, window, hop or band
+    Result<BandPowerStreamId> createBandPowerStream(SampleRate source, const BandPowerConfig& config,
+                                                    size_t buffer_frames);
+
+    /// Compute per-channel band power of a virtual group's output, e.g. 1 kHz LFP from
+    /// createResampledGroup(); the stream gets no input once that group is destroyed
+    /// @return Id of the new stream, or error if @p source does not exist or @p config is invalid
+    Result<BandPowerStreamId> createBandPowerStream(VirtualGroupId source, const BandPowerConfig& config,
+                                                    size_t buffer_frames);
+
+    /// Stop a band power stream and drop its callbacks
+    /// @return Error if @p stream does not exist
+    Result<void> destroyBandPowerStream(BandPowerStreamId stream);
+
+    /// Register a callback for a band power stream's feature vectors
+    /// @param stream Id from createBandPowerStream()
+    /// @param callback Function receiving (features, n_frames, n_channels, n_bands, timestamps)
+    /// @return Handle for unregistration, or 0 if @p stream does not exist
+    CallbackHandle registerBandPowerCallback(BandPowerStreamId stream, BandPowerCallback callback) const;
+
+    /// @return Description and counters of @p stream, or error if it does not exist
+    Result<BandPowerStreamInfo> getBandPowerStreamInfo(BandPowerStreamId stream) const;
+
+    /// Move the oldest buffered feature vectors of @p stream out of its ring buffer
+    /// @param stream Id from createBandPowerStream()
+    /// @param features Receives row-major [n][channel_count][band_count] band power
+    /// @param timestamps Receives one timestamp per vector (may be null)
+    /// @param max_frames Vectors @p features can hold
+    /// @param max_channels Channels per vector @p features can hold
+    /// @param[out] n_channels Channels per vector written
+    /// @return Number of vectors written, or error if @p stream does not exist or has more
+    ///         than @p max_channels channels
+    Result<size_t> readBandPower(BandPowerStreamId stream, float* features, uint64_t* timestamps,
+                                 size_t max_frames, size_t max_channels, size_t& n_channels) const;
+
+    ///--------------------------------------------------------------------------------------------
+    /// Peri-Event Epochs
+    ///--------------------------------------------------------------------------------------------
+
+    /// Cut fixed windows of a sample group around events
+    ///
+    /// An EpochExtractor (see cbsdk/epoch_extractor.h) keeps a bounded history of @p source on
+    /// the callback thread.  Every event packet matching @p triggers anchors a window of
+    /// config.pre_samples rows before its trigger sample and config.post_samples from it on;
+    /// once the post window has arrived the epoch goes, as one contiguous block, to the
+    /// stream's callbacks and to a ring buffer of @p buffer_epochs epochs (drain it with
+    /// readEpochs()).  The history restarts if the source's channel count changes.
+    /// @param source Group to cut from (SR_500 through SR_RAW)
+    /// @param config Window, allowed event delay and pending events, in samples of @p source
+    /// @param triggers Event packets that cut an epoch
+    /// @param buffer_epochs Ring buffer capacity in epochs (0: no buffering)
+    /// @return Id of the new stream, or error for an invalid source or config
+    Result<EpochStreamId> createEpochStream(SampleRate source, const EpochConfig& config,
+                                            const EpochTriggers& triggers, size_t buffer_epochs);
+
+    /// Stop an epoch stream and drop its callbacks
+    /// @return Error if @p stream does not exist
+    Result<void> destroyEpochStream(EpochStreamId stream);
+
+    /// Register a callback for an epoch stream's epochs
+    /// @param stream Id from createEpochStream()
+    /// @param callback Function receiving (event, samples, n_samples, n_channels, timestamps)
+    /// @return Handle for unregistration, or 0 if @p stream does not exist
+    CallbackHandle registerEpochCallback(EpochStreamId stream, EpochCallback callback) const;
+
+    /// @return Description and counters of @p stream, or error if it does not exist
+    Result<EpochStreamInfo> getEpochStreamInfo(EpochStreamId stream) const;
+
+    /// Move the oldest buffered epochs of @p stream out of its ring buffer
+    /// @param stream Id from createEpochStream()
+    /// @param samples Receives row-major [n][pre_samples + post_samples][channel_count] samples
+    /// @param events Receives the triggering event of each epoch (may be null)
+    /// @param max_epochs Epochs @p samples can hold
+    /// @param max_channels Channels per row @p samples can hold
+    /// @param[out] n_channels Channels per row written
+    /// @return Number of epochs written, or error if @p stream does not exist or has more
+    ///         than @p max_channels channels
+    Result<size_t> readEpochs(EpochStreamId stream, int16_t* samples, EpochEvent* events,
+                              size_t max_epochs, size_t max_channels, size_t& n_channels) const;
+
+    ///--------------------------------------------------------------------------------------------
+    /// Host Spike Detection
+    ///--------------------------------------------------------------------------------------------
+
+    /// Detect spikes on the host from a sample group (replacing any detection already running)
+    ///
+    /// A ThresholdSpikeDetector (see cbsdk/spike_detector.h) runs on the callback thread against
+    /// each batch of @p config.source, after the optional filter.  Waveforms are cut with the
+    /// device's spike length and pretrigger (getSpikeLength(), getSpikePretrigger()) and each
+    /// spike is dispatched as an unsorted cbPKT_SPK (chid = channel, time = crossing sample)
+    /// to the packet and event callbacks, after the batch's own packets.  Host spikes are not
+    /// written to local recordings.  Other channels of the group than front-end ones start
+    /// with detection off; turn device extraction off (setSpikeExtraction()) to avoid
+    /// receiving spikes twice.  The channel list is taken when detection starts: restart it
+    /// after changing group membership (batches whose channel count no longer matches are
+    /// skipped).
+    /// @return Error if the source group is invalid or has no channels, or a parameter is invalid
+    Result<void> startSpikeDetection(const SpikeDetectionConfig& config);
+
+    /// Stop host spike detection (no-op if not running)
+    void stopSpikeDetection();
+
+    /// @return true if host spike detection is running
+    [[nodiscard]] bool isSpikeDetectionRunning() const;
+
+    /// Change the host detection threshold of one channel
+    /// @param chan_id 1-based channel ID in the detected group
+    /// @return Error if detection is not running, @p chan_id is not detected on, or
+    ///         @p threshold is invalid
+    Result<void> setSpikeDetectionThreshold(uint32_t chan_id, SpikeThreshold threshold);
+
+    /// @param chan_id 1-based channel ID in the detected group
+    /// @return Level currently compared against (0 while off or while an RMS threshold is
+    ///         arming), or error if detection is not running or @p chan_id is not detected on
+    Result<int16_t> getSpikeDetectionLevel(uint32_t chan_id) const;
+
+    ///--------------------------------------------------------------------------------------------
+    /// Spike Binning
+    ///--------------------------------------------------------------------------------------------
+
+    /// Count spikes into bins of device time (replacing any binning already running)
+    ///
+    /// A SpikeBinner (see cbsdk/spike_binner.h) counts every spike packet the session
+    /// dispatches, device-extracted or host-detected, by channel and unit on the callback
+    /// thread.  Each batch's newest timestamp drives bin closing; closed bins go to the
+    /// spike bin callbacks and to a history drained with readSpikeBins().
+    /// @param config Bin width, latency for late spikes, matrix shape (channel_count at most
+    ///               cbNUM_ANALOG_CHANS) and history size
+    /// @return Error if @p config is invalid
+    Result<void> startSpikeBinning(const SpikeBinnerConfig& config);
+
+    /// Stop spike binning and drop its open and buffered bins (no-op if not running)
+    void stopSpikeBinning();
+
+    /// @return true if spike binning is running
+    [[nodiscard]] bool isSpikeBinningRunning() const;
+
+    /// Register a callback for every closed spike bin (also across restarts of binning)
+    /// @param callback Function receiving (start_time, counts, n_channels, n_units)
+    /// @return Handle for unregistration
+    CallbackHandle registerSpikeBinCallback(SpikeBinCallback callback) const;
+
+    /// Move the oldest closed bins out of the binning history
+    /// @param counts Receives [n][channel_count][unit_count] counts
+    /// @param start_times Receives each bin's start time (may be null)
+    /// @param max_bins Bins @p counts can hold
+    /// @return Number of bins written, or error if binning is not running
+    Result<size_t> readSpikeBins(uint32_t* counts, uint64_t* start_times, size_t max_bins) const;
+
+    /// @return Counters of the running binning, or error if binning is not running
+    Result<SpikeBinnerStats> getSpikeBinningStats() const;
+
+    ///--------------------------------------------------------------------------------------------
+    /// Digital Input Tracking
+    ///--------------------------------------------------------------------------------------------
+
+    /// Log digital and serial input packets with their bit edges (restarting any tracking
+    /// already running)
+    ///
+    /// A DigitalInputTracker (see cbsdk/digital_input_tracker.h) decodes every input packet the
+    /// session dispatches against its channel's previous word, before the packet callbacks run.
+    /// Pollers read the log with a cursor (readDigitalInputEvents()) and ask for the word at
+    /// given times (getDigitalInputState()) instead of taking a callback per packet.  Words
+    /// start at 0 when tracking starts.
+    /// @param buffer_events Events the log holds
+    /// @return Error if @p buffer_events is 0
+    Result<void> startDigitalInputTracking(size_t buffer_events);
+
+    /// Stop digital input tracking and drop its log (no-op if not running)
+    void stopDigitalInputTracking();
+
+    /// @return true if digital input tracking is running
+    [[nodiscard]] bool isDigitalInputTrackingRunning() const;
+
+    /// Copy the logged input events from @p cursor on (oldest first)
+    /// @param[in,out] cursor Sequence number of the first event wanted (0 for the oldest);
+    ///                moved past the events copied
+    /// @param events Receives the events
+    /// @param max_events Events @p events can hold
+    /// @param skipped Receives the number of events overwritten before the cursor reached
+    ///                them (may be null)
+    /// @return Number of events copied, or error if tracking is not running
+    Result<size_t> readDigitalInputEvents(uint64_t& cursor, DigitalInputEvent* events, size_t max_events,
+                                          uint64_t* skipped = nullptr) const;
+
+    /// Word of an input channel at each of @p times (device time)
+    /// @param chan_id 1-based channel ID of a digital or serial input
+    /// @param values Receives one word per time
+    /// @return Number of times answered exactly (see DigitalInputTracker::stateAt()), or error
+    ///         if tracking is not running
+    Result<size_t> getDigitalInputState(uint32_t chan_id, const uint64_t* times, size_t n_times,
+                                        uint32_t* values) const;
+
+    /// @param chan_id 1-based channel ID of a digital or serial input
+    /// @return Current word of @p chan_id, or error if tracking is not running
+    Result<uint32_t> getDigitalInputWord(uint32_t chan_id) const;
+
+    /// @return Counters of the running tracking, or error if tracking is not running
+    Result<DigitalInputStats> getDigitalInputStats() const;
+
+    ///--------------------------------------------------------------------------------------------
+    /// Host Spike Sorting
+    ///--------------------------------------------------------------------------------------------
+
+    /// Classify spikes on the host with the device's sort models (restarting any sorting
+    /// already running)
+    ///
+    /// A SpikeSorter (see cbsdk/spike_sorter.h) runs on the callback thread, before the packet
+    /// callbacks, on the host-detected spikes and (with @p config.device_spikes) on device
+    /// spikes that arrive unsorted.  Each spike of a modelled channel gets its feature pattern
+    /// (fPattern) and unit (type: 1-5, 0 for unsorted, 255 for noise), so callbacks, spike
+    /// binning and epochs see sorted events.  Models start as the device's PCA bases, unit
+    /// models and noise boundaries and follow the model packets the device sends while sorting
+    /// runs; setSpikeSortModel() overrides a channel.  Local recordings keep the spikes as
+    /// they arrived.  The spike length is taken when sorting starts: restart it after
+    /// setSpikeLength() (shorter waveforms are left unsorted).
+    /// @return Error if a parameter is invalid
+    Result<void> startSpikeSorting(const SpikeSortingConfig& config = {});
+
+    /// Stop host spike sorting (no-op if not running)
+    void stopSpikeSorting();
+
+    /// @return true if host spike sorting is running
+    [[nodiscard]] bool isSpikeSortingRunning() const;
+
+    /// Replace the sort model of one channel until the device sends a new one
+    /// @param chan_id 1-based channel ID
+    /// @param model Basis of at least getSpikeLength() rows, units and noise boundary
+    /// @return Error if sorting is not running or @p model is invalid
+    ///         (see SpikeSorter::setModel())
+    Result<void> setSpikeSortModel(uint32_t chan_id, const ChannelSortModel& model);
+
+    /// @return Counters of the running sorting, or error if sorting is not running
+    Result<SpikeSorterStats> getSpikeSortingStats() const;
+
     ///--------------------------------------------------------------------------------------------
     /// Statistics & Monitoring
     ///--------------------------------------------------------------------------------------------
@@ -408,7 +1077,19 @@ public:
     /// @return Copy of current statistics
     SdkStats getStats() const;
 
-    /// Reset statistics counters to zero
+    /// Get the statistics of the STANDALONE session that owns the device
+    ///
+    /// The owner publishes its counters to shared memory every 100 ms (see cbshm/stats_segment.h),
+    /// so a CLIENT can tell whether the receiver is dropping packets.  In STANDALONE mode this
+    /// is the same as getStats().
+    /// @return Owner statistics, or nullopt if the owner publishes none (Central, or owner gone)
+    std::optional<SdkStats> getOwnerStats() const;
+
+    /// Get per-stage latency percentiles (see LatencyStats)
+    /// @return Snapshot of the latency histograms
+    LatencyStats getLatencyStats() const;
+
+    /// Reset statistics counters and latency histograms to zero
     void resetStats();
 
     ///--------------------------------------------------------------------------------------------
@@ -533,7 +1214,8 @@ public:
     /// the new configuration.  Always sends a CHANSET* packet for every
     /// in-scope channel — never skips channels that look already configured,
     /// since the local cache may be stale due to dropped CHANREP packets
-    /// from a concurrent client.
+    /// from a concurrent client.  Inside a configuration transaction the
+    /// change is staged instead (see beginConfigTransaction()).
     ///
     /// Channel selection has two modes:
     /// - @p chans is nullptr: configure the first @p nChans channels of
@@ -595,10 +1277,101 @@ public:
 
     /// Set full channel configuration by packet (fire-and-forget).
     /// Call sync() before reading back state that depends on this configuration.
+    /// Inside a configuration transaction a CHANSET* packet is staged (replacing whatever
+    /// earlier setters staged for that channel) instead of being sent.
     /// @param chaninfo Complete channel info packet to send
     /// @return Result indicating success or error
     Result<void> setChannelConfig(const cbPKT_CHANINFO& chaninfo);
 
+    ///--------------------------------------------------------------------------------------------
+    /// Configuration Transactions
+    ///--------------------------------------------------------------------------------------------
+    ///
+    /// Between beginConfigTransaction() and commitConfigTransaction(), the blocking channel
+    /// setters above (setSampleGroup, setSpikeSorting, setSpikeExtraction,
+    /// setACInputCoupling, setChannelConfig) neither sync nor send: they record the call.
+    /// Commit syncs once, resolves each recorded setter's channels (by-type selections and
+    /// disableOthers included) against the synced configuration, replays each channel's
+    /// changes in order onto its freshly synced chaninfo and sends one CHANSET* per channel,
+    /// so a setup script of N setters costs one round trip and at most one packet per
+    /// channel instead of N of each.  The *Async setters are not affected by an open transaction.
+    ///
+    /// Transactions are per session, not per thread: setters called from any thread while
+    /// one is open are staged into it.
+
+    /// Start staging channel configuration changes
+    /// @return Error if a transaction is already open
+    Result<void> beginConfigTransaction();
+
+    /// Send the staged changes and wait until every sent channel is acknowledged.
+    ///
+    /// By default every touched channel is sent, matching the setters' always-send rule
+    /// (which protects against a stale cache).  Commit syncs before comparing, so with
+    /// @p skipUnchanged channels whose merged result equals their freshly synced chaninfo
+    /// can be omitted safely.  The transaction is closed whether or not commit succeeds.
+    ///
+    /// @param skipUnchanged Omit channels the staged changes leave as they already are
+    /// @param timeout_ms Deadline for the sync and, separately, for the acknowledgements
+    /// @return Packet counts, or error (no transaction open, sync/send failure, timeout)
+    Result<ConfigCommitStats> commitConfigTransaction(bool skipUnchanged = false,
+                                                      uint32_t timeout_ms = 5000);
+
+    /// Discard the staged changes and close the transaction (no-op if none is open)
+    void abortConfigTransaction();
+
+    /// Whether a configuration transaction is open
+    bool inConfigTransaction() const;
+
+    ///--------------------------------------------------------------------------------------------
+    /// Asynchronous Channel Configuration
+    ///--------------------------------------------------------------------------------------------
+    ///
+    /// Non-blocking counterparts of the bulk setters.  They neither pre-sync nor wait: the
+    /// packets are sent immediately and the returned ConfigOperation completes once every
+    /// changed channel has echoed a CHANREP*.  Many operations can be in flight at once and
+    /// awaited together.  While a channel has changes in flight from this session, later
+    /// asynchronous changes seed from the last chaninfo sent for it rather than the shared
+    /// memory cache, so pipelined changes to the same channel compose.  Changes made
+    /// concurrently by other clients are not seen until their CHANREP lands — call sync()
+    /// first if that matters.
+    ///
+    /// Channel selection matches the blocking setters (see setSampleGroup()).
+
+    /// Asynchronous setSampleGroup()
+    /// @param timeout_ms Deadline for every channel to be acknowledged
+    /// @return Operation handle, or error if the packets could not be sent
+    Result<ConfigOperation> setSampleGroupAsync(uint32_t nChans, ChannelType chanType,
+                                                SampleRate rate, bool disableOthers = false,
+                                                const uint32_t* chans = nullptr,
+                                                uint32_t timeout_ms = 5000);
+
+    /// Asynchronous setSpikeSorting()
+    /// @param timeout_ms Deadline for every channel to be acknowledged
+    Result<ConfigOperation> setSpikeSortingAsync(uint32_t nChans, ChannelType chanType,
+                                                 uint32_t sortOptions,
+                                                 const uint32_t* chans = nullptr,
+                                                 uint32_t timeout_ms = 5000);
+
+    /// Asynchronous setSpikeExtraction()
+    /// @param timeout_ms Deadline for every channel to be acknowledged
+    Result<ConfigOperation> setSpikeExtractionAsync(uint32_t nChans, ChannelType chanType,
+                                                    bool enabled,
+                                                    const uint32_t* chans = nullptr,
+                                                    uint32_t timeout_ms = 5000);
+
+    /// Asynchronous setACInputCoupling()
+    /// @param timeout_ms Deadline for every channel to be acknowledged
+    Result<ConfigOperation> setACInputCouplingAsync(uint32_t nChans, ChannelType chanType,
+                                                    bool enabled,
+                                                    const uint32_t* chans = nullptr,
+                                                    uint32_t timeout_ms = 5000);
+
+    /// Asynchronous setChannelConfig()
+    /// @param chaninfo Complete channel info packet (must be a CHANSET* type)
+    /// @param timeout_ms Deadline for the channel to be acknowledged
+    Result<ConfigOperation> setChannelConfigAsync(const cbPKT_CHANINFO& chaninfo,
+                                                  uint32_t timeout_ms = 5000);
+
     ///--------------------------------------------------------------------------------------------
     /// Comments
     ///--------------------------------------------------------------------------------------------
@@ -809,6 +1582,51 @@ public:
     /// @return Uncertainty in nanoseconds, or nullopt if no sync data available
     std::optional<int64_t> getClockUncertaintyNs() const;
 
+    ///--------------------------------------------------------------------------------------------
+    /// Capture & Replay
+    ///--------------------------------------------------------------------------------------------
+
+    /// Start recording every datagram received from the device to a capture file
+    /// (raw wire format plus host receive time; see cbdev/capture.h).  Replaying the file with
+    /// SdkConfig::replay_path drives the same receive, shared memory and callback path.
+    /// Only available in STANDALONE mode.
+    /// @param path Output file (truncated)
+    /// @return Result indicating success or error
+    Result<void> startCapture(const std::string& path);
+
+    /// Flush and close the capture file (no-op if not capturing)
+    void stopCapture();
+
+    /// Whether a replay session has delivered the last datagram of its capture
+    /// @return true at the end of a replay; always false for live sessions
+    bool isReplayFinished() const;
+
+    ///--------------------------------------------------------------------------------------------
+    /// Local Recording
+    ///--------------------------------------------------------------------------------------------
+
+    /// Record continuous groups and spike / digital input events to NSx/NEV files in-process
+    ///
+    /// Snapshots the current group lists and channel configuration, creates "<base_path>.nev"
+    /// and one "<base_path>.ns<group>" per group with channels, and from then on hands every
+    /// dispatched packet to a Recorder (see cbsdk/recorder.h) whose own thread does all disk
+    /// I/O.  Works in STANDALONE and CLIENT mode.  The file headers describe the configuration
+    /// at start; restart the recording after changing group membership.
+    /// @param base_path Output path without extension
+    /// @param options Recording options
+    /// @return Error if already recording or a file cannot be created
+    Result<void> startRecording(const std::string& base_path, const RecordingOptions& options = {});
+
+    /// Write out everything queued and close the files (no-op if not recording)
+    void stopRecording();
+
+    /// @return true while a local recording is running
+    bool isRecording() const;
+
+    /// Counters of the running recording, or of the last one after stopRecording()
+    /// @return Recorder counters (all zero if nothing was recorded yet)
+    RecorderStats getRecordingStats() const;
+
 
     ///--------------------------------------------------------------------------------------------
     /// Packet Transmission
@@ -895,6 +1713,15 @@ private:
     Result<void> sendFileCfgPacket(uint32_t options, uint32_t recording,
                                    const std::string& filename, const std::string& comment);
 
+    /// Stage @p collect_edits into the open transaction, or sync, collect and send its edits
+    /// now (shared helper for the blocking channel setters).  Either way it runs after a sync,
+    /// so target channels resolve against the refreshed configuration.
+    Result<void> applyChannelEdits(std::function<ConfigTransaction()> collect_edits);
+
+    /// Register CHANSET* packets with the config tracker, then send them
+    /// (shared helper for the *Async setters and commitConfigTransaction)
+    Result<ConfigOperation> sendTracked(const std::vector<cbPKT_GENERIC>& packets, uint32_t timeout_ms);
+
     /// Platform-specific implementation
     struct Impl;
     std::unique_ptr<Impl> m_impl;
@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   spike_binner.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Binned spike counts (channels x units per time bin) for real-time decoders
+///
+/// A SpikeBinner counts spikes into bins of device time: bin k covers
+/// [k * bin_width, (k + 1) * bin_width), so bins line up with the device clock whatever
+/// time binning started.  Each bin is a [channel][unit] count matrix.  A bin stays open
+/// until device time has passed its end by the configured latency, so spikes that arrive
+/// late (host-detected spikes, a second instrument) still land in the bin their timestamp
+/// belongs to; spikes older than every open bin are counted as late and dropped.
+///
+/// Open bins live in a fixed ring of matrices and closed bins are copied to a fixed ring of
+/// history, so counting a spike is an index computation and an increment: nothing is
+/// allocated after create().  SdkSession::startSpikeBinning() feeds one from the event path
+/// and publishes closed bins to callbacks and to readSpikeBins().
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_SPIKE_BINNER_H
+#define CBSDK_SPIKE_BINNER_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace cbsdk {
+
+/// Shape and timing of a SpikeBinner
+struct SpikeBinnerConfig {
+    uint64_t bin_width = 20'000'000;    ///< Bin length in device time units (ns), e.g. 20 ms
+    uint64_t latency = 10'000'000;      ///< How long after its end a bin accepts late spikes
+    size_t channel_count = 272;         ///< Matrix rows: channel IDs 1..channel_count
+    size_t unit_count = 6;              ///< Matrix columns: unit 0 (unsorted) .. unit_count - 1
+    size_t buffer_bins = 500;           ///< Closed bins kept for readBins()
+};
+
+/// Counters of a SpikeBinner
+struct SpikeBinnerStats {
+    uint64_t spikes_counted = 0;    ///< Spikes added to a bin
+    uint64_t spikes_late = 0;       ///< Spikes older than every open bin (dropped)
+    uint64_t spikes_ignored = 0;    ///< Spikes on a channel or unit outside the matrix (e.g. noise)
+    uint64_t bins_closed = 0;       ///< Bins closed since creation (including empty ones)
+    uint64_t bins_skipped = 0;      ///< Empty bins of long gaps in device time never closed
+    uint64_t bins_overwritten = 0;  ///< Closed bins dropped from the history before readBins()
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Streaming spike counter into fixed-width bins of device time
+///
+/// Feed it spikes with addSpike() and the progress of device time with advance() (any
+/// packet's timestamp will do); closed bins come out of readBins() and, independently,
+/// takeClosed().  Not thread-safe.
+///
+class SpikeBinner {
+public:
+    /// @return Error if a dimension or the bin width is 0, or latency is not below
+    ///         buffer_bins bins
+    static cbutil::Result<SpikeBinner> create(const SpikeBinnerConfig& config);
+
+    SpikeBinner(SpikeBinner&&) noexcept;
+    SpikeBinner& operator=(SpikeBinner&&) noexcept;
+    SpikeBinner(const SpikeBinner&) = delete;
+    SpikeBinner& operator=(const SpikeBinner&) = delete;
+    ~SpikeBinner();
+
+    /// Count one spike
+    /// @param chan_id 1-based channel ID
+    /// @param unit Sorted unit (0 = unsorted)
+    /// @param time Device timestamp of the spike
+    void addSpike(uint32_t chan_id, uint32_t unit, uint64_t time);
+
+    /// Close every bin that ended at least latency before @p now
+    void advance(uint64_t now);
+
+    /// Move the oldest closed bins out of the history
+    /// @param counts Receives [n][channel_count][unit_count] counts
+    /// @param start_times Receives each bin's start time (may be null)
+    /// @return Number of bins written
+    size_t readBins(uint32_t* counts, uint64_t* start_times, size_t max_bins);
+
+    /// Like readBins(), with its own cursor: bins closed since the last takeClosed(), for
+    /// delivering every bin to callbacks whatever readBins() consumes
+    size_t takeClosed(uint32_t* counts, uint64_t* start_times, size_t max_bins);
+
+    /// @return Closed bins readBins() would return
+    [[nodiscard]] size_t buffered() const;
+
+    /// Drop every open and closed bin and restart with the next timestamp (counters are kept)
+    void reset();
+
+    [[nodiscard]] const SpikeBinnerConfig& config() const;
+    [[nodiscard]] SpikeBinnerStats stats() const;
+
+private:
+    SpikeBinner();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_SPIKE_BINNER_H
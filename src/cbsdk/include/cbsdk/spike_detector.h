@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   spike_detector.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Host-side threshold-crossing spike detection on continuous group data
+///
+/// For sessions that turn device spike extraction off (SdkSession::setSpikeExtraction()) and
+/// detect on the host instead, usually on the raw group after a high-pass filter
+/// (cbsdk/filter_bank.h).  Each channel has its own threshold: a fixed level, or a multiple
+/// of the channel's running RMS.  A spike is a crossing of the threshold (downward for a
+/// negative level, upward for a positive one) at least the refractory period after the
+/// channel's previous spike; its waveform is cut like the device's, starting pretrigger
+/// samples before the crossing.
+///
+/// Batches are kept row-major with rows padded to eight channels, so each row is compared
+/// against every threshold eight channels per SSE2 instruction and only rows with a crossing
+/// are looked at channel by channel.  SdkSession::startSpikeDetection() runs one on a sample
+/// group and publishes the spikes as cbPKT_SPK events.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_SPIKE_DETECTOR_H
+#define CBSDK_SPIKE_DETECTOR_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cbsdk {
+
+/// How a channel's threshold is set
+enum class ThresholdMode : uint32_t {
+    OFF   = 0,  ///< No detection on the channel
+    LEVEL = 1,  ///< Fixed level, in raw sample units
+    RMS   = 2,  ///< Multiple of the channel's running RMS (e.g. -4.5)
+};
+
+/// Threshold of one channel; the sign of the level (or multiplier) selects the crossing direction
+struct SpikeThreshold {
+    ThresholdMode mode = ThresholdMode::OFF;
+    int16_t level = 0;              ///< LEVEL: crossing level (non-zero)
+    float rms_multiplier = 0.0f;    ///< RMS: level = multiplier * RMS (non-zero)
+
+    static SpikeThreshold off() { return {}; }
+    static SpikeThreshold fixed(const int16_t level) { return {ThresholdMode::LEVEL, level, 0.0f}; }
+    static SpikeThreshold rms(const float multiplier) { return {ThresholdMode::RMS, 0, multiplier}; }
+};
+
+/// Waveform and timing parameters of a ThresholdSpikeDetector
+struct SpikeDetectorConfig {
+    uint32_t spike_length = 48;         ///< Waveform samples (see SdkSession::getSpikeLength())
+    uint32_t pretrigger = 10;           ///< Waveform samples before the crossing (see getSpikePretrigger())
+    uint32_t refractory_samples = 30;   ///< Crossings closer than this to a channel's last spike are ignored
+    uint32_t rms_window = 30000;        ///< Samples the running RMS averages over; RMS thresholds
+                                        ///< arm once this many samples have been seen
+};
+
+/// One detected spike
+struct DetectedSpike {
+    uint32_t column = 0;        ///< Channel (column of the batches)
+    uint64_t timestamp = 0;     ///< Time of the crossing sample
+    int16_t level = 0;          ///< Threshold that was crossed
+    const int16_t* wave = nullptr;  ///< spike_length samples; valid until the next process() or reset()
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Streaming threshold-crossing detector over every channel of a sample group
+///
+/// Samples are row-major int16 [n_samples][n_channels], as the batch callbacks deliver them.
+/// A spike is reported by the process() call whose batch completes its waveform, so it lags
+/// the crossing by up to spike_length - pretrigger samples.  Not thread-safe; one detector
+/// serves one stream.
+///
+class ThresholdSpikeDetector {
+public:
+    /// @param config Waveform and timing parameters
+    /// @param channel_count Channels per sample (at least 1)
+    /// @param threshold Initial threshold of every channel
+    /// @return Error if a parameter is out of range (spike_length 1..128, pretrigger below it,
+    ///         rms_window at least 1) or @p threshold is invalid
+    static cbutil::Result<ThresholdSpikeDetector> create(const SpikeDetectorConfig& config, size_t channel_count,
+                                                         SpikeThreshold threshold);
+
+    ThresholdSpikeDetector(ThresholdSpikeDetector&&) noexcept;
+    ThresholdSpikeDetector& operator=(ThresholdSpikeDetector&&) noexcept;
+    ThresholdSpikeDetector(const ThresholdSpikeDetector&) = delete;
+    ThresholdSpikeDetector& operator=(const ThresholdSpikeDetector&) = delete;
+    ~ThresholdSpikeDetector();
+
+    /// Change the threshold of @p column (takes effect from the next batch)
+    /// @return Error if @p column is out of range or @p threshold is invalid
+    cbutil::Result<void> setThreshold(size_t column, SpikeThreshold threshold);
+
+    /// Detect over @p n_samples rows
+    /// @param timestamps One timestamp per row
+    /// @param[out] spikes Replaced with the spikes whose waveforms completed, in time order per channel
+    /// @return Number of spikes
+    size_t process(const int16_t* samples, const uint64_t* timestamps, size_t n_samples,
+                   std::vector<DetectedSpike>& spikes);
+
+    /// Forget buffered samples, pending spikes and RMS estimates (thresholds are kept)
+    void reset();
+
+    /// @return Level currently compared against on @p column (0 if off or not yet armed)
+    [[nodiscard]] int16_t level(size_t column) const;
+
+    /// @return Running RMS of @p column, in raw sample units
+    [[nodiscard]] double rms(size_t column) const;
+
+    [[nodiscard]] size_t channelCount() const;
+    [[nodiscard]] const SpikeDetectorConfig& config() const;
+
+private:
+    ThresholdSpikeDetector();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_SPIKE_DETECTOR_H
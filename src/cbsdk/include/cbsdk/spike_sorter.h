@@ -0,0 +1,123 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   spike_sorter.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Online classification of spike waveforms with the device's sort models
+///
+/// A channel's model is what the device keeps for its own sorting: a PCA basis of three
+/// vectors (cbPKT_FS_BASIS), up to cbMAXUNITS Gaussian clusters in the plane of the first
+/// two components (cbPKT_SS_MODELSET) and an ellipsoidal noise boundary in the full
+/// three-dimensional feature space (cbPKT_SS_NOISE_BOUNDARY).  A waveform is projected onto
+/// the basis (eight samples per SSE2 step), which gives its feature pattern; a pattern
+/// inside the noise boundary is noise, otherwise it joins the most likely unit whose
+/// Mahalanobis distance is within the gate, or stays unsorted.
+///
+/// Channels are sharded over a pool of worker threads, each classifying the spikes of its
+/// own channels, so large bursts sort in parallel while every model is only touched by one
+/// thread.  SdkSession::startSpikeSorting() runs one on the spikes the session dispatches.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_SPIKE_SORTER_H
+#define CBSDK_SPIKE_SORTER_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace cbsdk {
+
+/// Unit number of a spike classified as noise (as in cbPKT_SPK)
+constexpr uint32_t SORT_UNIT_NOISE = 255;
+
+/// One cluster of a sort model, a Gaussian over the first two pattern components
+struct SortUnit {
+    uint32_t unit = 1;                  ///< Unit number assigned (1..5, or SORT_UNIT_NOISE)
+    float mean[2] = {};                 ///< Cluster centre (mu_x)
+    float inv_covariance[2][2] = {};    ///< Inverse covariance (Sigma_x_inv)
+    float log_determinant = 0.0f;       ///< log |covariance|; favours tighter clusters on ties
+};
+
+/// Sort model of one channel
+struct ChannelSortModel {
+    std::vector<float> basis;           ///< Row-major [points][3] PCA basis (at least spike_length rows)
+    std::vector<SortUnit> units;        ///< Clusters (empty: only the noise boundary applies)
+    bool has_noise_boundary = false;
+    float noise_center[3] = {};         ///< Centre of the noise ellipsoid
+    float noise_axes[3][3] = {};        ///< Semi-axes of the noise ellipsoid (one per row)
+};
+
+/// Parameters of a SpikeSorter
+struct SpikeSorterConfig {
+    uint32_t spike_length = 48;         ///< Waveform samples projected (see SdkSession::getSpikeLength())
+    float gate = 9.21f;                 ///< Largest squared Mahalanobis distance to a unit's centre
+                                        ///< (chi-square with 2 degrees of freedom at 99 %)
+    size_t threads = 0;                 ///< Worker threads besides the caller's (0: sort inline)
+    size_t min_parallel_spikes = 256;   ///< Smaller calls sort inline (waking workers costs more)
+};
+
+/// One spike to classify
+struct SpikeToSort {
+    uint32_t chan_id = 0;
+    const int16_t* wave = nullptr;      ///< spike_length samples
+    float pattern[3] = {};              ///< Set by sort(): the waveform's feature pattern
+    uint32_t unit = 0;                  ///< Set by sort(): unit, 0 (unsorted) or SORT_UNIT_NOISE
+    bool modelled = false;              ///< Set by sort(): false if the channel has no model
+};
+
+/// Counters of a SpikeSorter
+struct SpikeSorterStats {
+    uint64_t spikes_sorted = 0;         ///< Spikes assigned to a unit
+    uint64_t spikes_noise = 0;          ///< Spikes classified as noise
+    uint64_t spikes_unsorted = 0;       ///< Modelled spikes that matched no unit
+    uint64_t spikes_unmodelled = 0;     ///< Spikes on channels without a model (left as they were)
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Classifier of spike waveforms against per-channel sort models
+///
+/// setModel() and sort() must not run concurrently; sort() itself fans out to the workers
+/// and returns once every spike is classified.
+///
+class SpikeSorter {
+public:
+    /// @return Error if spike_length is 0 or above 128 (cbMAX_PNTS) or gate is not positive
+    static cbutil::Result<SpikeSorter> create(const SpikeSorterConfig& config);
+
+    SpikeSorter(SpikeSorter&&) noexcept;
+    SpikeSorter& operator=(SpikeSorter&&) noexcept;
+    SpikeSorter(const SpikeSorter&) = delete;
+    SpikeSorter& operator=(const SpikeSorter&) = delete;
+    ~SpikeSorter();   ///< Stops the workers
+
+    /// Install the model of a channel, replacing any it had
+    /// @param chan_id 1-based channel ID
+    /// @return Error if @p chan_id is 0, the basis has fewer than spike_length rows or is all
+    ///         zeros, or a unit's covariance is not positive definite
+    cbutil::Result<void> setModel(uint32_t chan_id, const ChannelSortModel& model);
+
+    /// Remove the model of a channel; its spikes are left unmodelled
+    void clearModel(uint32_t chan_id);
+
+    /// @return true if @p chan_id has a model
+    [[nodiscard]] bool hasModel(uint32_t chan_id) const;
+
+    /// Classify @p n_spikes spikes in place
+    void sort(SpikeToSort* spikes, size_t n_spikes);
+
+    [[nodiscard]] const SpikeSorterConfig& config() const;
+    [[nodiscard]] SpikeSorterStats stats() const;
+
+private:
+    SpikeSorter();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_SPIKE_SORTER_H
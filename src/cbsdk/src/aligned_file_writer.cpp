@@ -0,0 +1,242 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   aligned_file_writer.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Append-only aligned file writer (O_DIRECT / FILE_FLAG_NO_BUFFERING / F_NOCACHE)
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Platform headers MUST be included first
+#include "platform_first.h"
+
+#ifdef _WIN32
+    #include <malloc.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <errno.h>
+    #include <cstdlib>
+#endif
+
+#include "aligned_file_writer.h"
+#include <algorithm>
+#include <cstring>
+
+namespace cbsdk {
+
+namespace {
+
+void* allocAligned(const size_t size) {
+#ifdef _WIN32
+    return _aligned_malloc(size, AlignedFileWriter::BLOCK_SIZE);
+#else
+    void* p = nullptr;
+    return posix_memalign(&p, AlignedFileWriter::BLOCK_SIZE, size) == 0 ? p : nullptr;
+#endif
+}
+
+void freeAligned(void* p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+size_t roundUp(const size_t n) {
+    return (n + AlignedFileWriter::BLOCK_SIZE - 1) / AlignedFileWriter::BLOCK_SIZE * AlignedFileWriter::BLOCK_SIZE;
+}
+
+} // anonymous namespace
+
+struct AlignedFileWriter::Impl {
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+#else
+    int fd = -1;
+#endif
+    bool direct = false;
+    bool failed = false;
+    uint8_t* buffer = nullptr;
+    size_t capacity = 0;
+    size_t used = 0;
+    uint64_t logical_size = 0;
+
+    bool isOpen() const {
+#ifdef _WIN32
+        return file != INVALID_HANDLE_VALUE;
+#else
+        return fd >= 0;
+#endif
+    }
+
+    /// Write @p size bytes from the aligned buffer at the current file position
+    bool writeChunk(const uint8_t* data, size_t size) {
+        while (size > 0) {
+#ifdef _WIN32
+            DWORD written = 0;
+            const DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+            if (!WriteFile(file, data, chunk, &written, nullptr) || written == 0) {
+                return false;
+            }
+#else
+            const ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+#ifdef O_DIRECT
+                // Some filesystems accept O_DIRECT at open() but reject the writes
+                if (errno == EINVAL && direct) {
+                    const int flags = fcntl(fd, F_GETFL);
+                    if (flags >= 0 && fcntl(fd, F_SETFL, flags & ~O_DIRECT) == 0) {
+                        direct = false;
+                        continue;
+                    }
+                }
+#endif
+                return false;
+            }
+#endif
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    bool finish() {
+        if (!isOpen()) {
+            return !failed;
+        }
+        bool ok = !failed;
+        if (ok && used > 0) {
+            if (direct) {
+                // Unbuffered writes must cover whole blocks; trim the padding afterwards
+                const size_t padded = roundUp(used);
+                std::memset(buffer + used, 0, padded - used);
+                ok = writeChunk(buffer, padded);
+#ifdef _WIN32
+                FILE_END_OF_FILE_INFO eof{};
+                eof.EndOfFile.QuadPart = static_cast<LONGLONG>(logical_size);
+                ok = ok && SetFileInformationByHandle(file, FileEndOfFileInfo, &eof, sizeof(eof));
+#else
+                ok = ok && ftruncate(fd, static_cast<off_t>(logical_size)) == 0;
+#endif
+            } else {
+                ok = writeChunk(buffer, used);
+            }
+            used = 0;
+        }
+#ifdef _WIN32
+        CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+#else
+        ok = ::close(fd) == 0 && ok;
+        fd = -1;
+#endif
+        failed = !ok;
+        return ok;
+    }
+
+    ~Impl() {
+        finish();
+        freeAligned(buffer);
+    }
+};
+
+AlignedFileWriter::AlignedFileWriter() = default;
+AlignedFileWriter::AlignedFileWriter(AlignedFileWriter&&) noexcept = default;
+AlignedFileWriter& AlignedFileWriter::operator=(AlignedFileWriter&&) noexcept = default;
+AlignedFileWriter::~AlignedFileWriter() = default;
+
+cbutil::Result<AlignedFileWriter> AlignedFileWriter::open(const std::string& path, const size_t buffer_bytes,
+                                                          const bool direct_io) {
+    auto impl = std::make_unique<Impl>();
+    impl->capacity = roundUp(std::max<size_t>(buffer_bytes, BLOCK_SIZE));
+    impl->buffer = static_cast<uint8_t*>(allocAligned(impl->capacity));
+    if (!impl->buffer) {
+        return cbutil::Result<AlignedFileWriter>::error("Failed to allocate write buffer for " + path);
+    }
+
+#ifdef _WIN32
+    const auto create = [&](const DWORD flags) {
+        return CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+                           FILE_ATTRIBUTE_NORMAL | flags, nullptr);
+    };
+    if (direct_io) {
+        impl->file = create(FILE_FLAG_NO_BUFFERING);
+        impl->direct = impl->file != INVALID_HANDLE_VALUE;
+    }
+    if (impl->file == INVALID_HANDLE_VALUE) {
+        impl->file = create(0);
+    }
+    if (impl->file == INVALID_HANDLE_VALUE) {
+        return cbutil::Result<AlignedFileWriter>::error("Failed to create " + path +
+                                                        " (err=" + std::to_string(GetLastError()) + ")");
+    }
+#else
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+#ifdef O_DIRECT
+    if (direct_io) {
+        impl->fd = ::open(path.c_str(), flags | O_DIRECT, 0644);
+        impl->direct = impl->fd >= 0;   // EINVAL: the filesystem does not support O_DIRECT
+    }
+#endif
+    if (impl->fd < 0) {
+        impl->fd = ::open(path.c_str(), flags, 0644);
+    }
+    if (impl->fd < 0) {
+        return cbutil::Result<AlignedFileWriter>::error("Failed to create " + path + ": " + strerror(errno));
+    }
+#if defined(__APPLE__) && defined(F_NOCACHE)
+    if (direct_io) {
+        impl->direct = fcntl(impl->fd, F_NOCACHE, 1) == 0;
+    }
+#endif
+#endif
+
+    AlignedFileWriter writer;
+    writer.m_impl = std::move(impl);
+    return cbutil::Result<AlignedFileWriter>::ok(std::move(writer));
+}
+
+bool AlignedFileWriter::append(const void* data, size_t size) {
+    if (!m_impl || m_impl->failed || !m_impl->isOpen()) {
+        return false;
+    }
+    const auto* src = static_cast<const uint8_t*>(data);
+    m_impl->logical_size += size;
+    while (size > 0) {
+        const size_t n = std::min(size, m_impl->capacity - m_impl->used);
+        std::memcpy(m_impl->buffer + m_impl->used, src, n);
+        m_impl->used += n;
+        src += n;
+        size -= n;
+        if (m_impl->used == m_impl->capacity) {
+            if (!m_impl->writeChunk(m_impl->buffer, m_impl->capacity)) {
+                m_impl->failed = true;
+                return false;
+            }
+            m_impl->used = 0;
+        }
+    }
+    return true;
+}
+
+bool AlignedFileWriter::finish() {
+    return m_impl ? m_impl->finish() : false;
+}
+
+uint64_t AlignedFileWriter::size() const {
+    return m_impl ? m_impl->logical_size : 0;
+}
+
+bool AlignedFileWriter::isDirect() const {
+    return m_impl && m_impl->direct;
+}
+
+} // namespace cbsdk
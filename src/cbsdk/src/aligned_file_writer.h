@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   aligned_file_writer.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Append-only file with a large page-aligned buffer and optional unbuffered I/O
+///
+/// Appends are collected in one aligned buffer and written in whole-buffer chunks.  With
+/// direct I/O the file is opened O_DIRECT (Linux), FILE_FLAG_NO_BUFFERING (Windows) or with
+/// F_NOCACHE (macOS), so sustained recording does not fill the page cache and trigger
+/// writeback stalls elsewhere in the process.  Filesystems that refuse unbuffered I/O (tmpfs,
+/// some network mounts) fall back to ordinary buffered writes.
+///
+/// Unbuffered writes must be multiples of the block size, so finish() zero-pads the last chunk
+/// and then truncates the file back to its logical size.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_ALIGNED_FILE_WRITER_H
+#define CBSDK_ALIGNED_FILE_WRITER_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cbsdk {
+
+class AlignedFileWriter {
+public:
+    /// Alignment of the buffer and of every unbuffered write
+    static constexpr size_t BLOCK_SIZE = 4096;
+
+    /// Create (truncate) a file
+    /// @param path Output path
+    /// @param buffer_bytes Buffer size (rounded up to BLOCK_SIZE)
+    /// @param direct_io Try to bypass the page cache
+    static cbutil::Result<AlignedFileWriter> open(const std::string& path, size_t buffer_bytes, bool direct_io);
+
+    AlignedFileWriter(AlignedFileWriter&&) noexcept;
+    AlignedFileWriter& operator=(AlignedFileWriter&&) noexcept;
+    AlignedFileWriter(const AlignedFileWriter&) = delete;
+    AlignedFileWriter& operator=(const AlignedFileWriter&) = delete;
+
+    /// Calls finish()
+    ~AlignedFileWriter();
+
+    /// Append bytes, writing out the buffer each time it fills
+    /// @return false on a write error (the file is unusable afterwards)
+    bool append(const void* data, size_t size);
+
+    /// Write the buffered tail, trim the padding and close the file
+    /// @return false on a write error
+    bool finish();
+
+    /// @return Bytes appended so far
+    [[nodiscard]] uint64_t size() const;
+
+    /// @return Whether writes bypass the page cache
+    [[nodiscard]] bool isDirect() const;
+
+private:
+    AlignedFileWriter();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_ALIGNED_FILE_WRITER_H
@@ -0,0 +1,322 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   band_power.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Streaming band power via a channel-parallel FFT
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/band_power.h"
+
+#include <cbutil/simd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace cbsdk {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+/// Channels per SIMD step; transform rows are padded to a multiple of this
+constexpr size_t LANES = 4;
+
+constexpr size_t MIN_WINDOW = 16;
+
+/// Radix-2 butterfly across a row of channels: a, b = a + w b, a - w b
+void butterfly(float* ar, float* ai, float* br, float* bi, const float wr, const float wi, const size_t stride) {
+    size_t c = 0;
+#ifdef CBUTIL_HAVE_SSE2
+    const __m128 vwr = _mm_set1_ps(wr);
+    const __m128 vwi = _mm_set1_ps(wi);
+    for (; c < stride; c += LANES) {
+        const __m128 xr = _mm_loadu_ps(br + c);
+        const __m128 xi = _mm_loadu_ps(bi + c);
+        const __m128 tr = _mm_sub_ps(_mm_mul_ps(vwr, xr), _mm_mul_ps(vwi, xi));
+        const __m128 ti = _mm_add_ps(_mm_mul_ps(vwr, xi), _mm_mul_ps(vwi, xr));
+        const __m128 yr = _mm_loadu_ps(ar + c);
+        const __m128 yi = _mm_loadu_ps(ai + c);
+        _mm_storeu_ps(br + c, _mm_sub_ps(yr, tr));
+        _mm_storeu_ps(bi + c, _mm_sub_ps(yi, ti));
+        _mm_storeu_ps(ar + c, _mm_add_ps(yr, tr));
+        _mm_storeu_ps(ai + c, _mm_add_ps(yi, ti));
+    }
+#endif
+    for (; c < stride; ++c) {
+        const float tr = wr * br[c] - wi * bi[c];
+        const float ti = wr * bi[c] + wi * br[c];
+        br[c] = ar[c] - tr;
+        bi[c] = ai[c] - ti;
+        ar[c] += tr;
+        ai[c] += ti;
+    }
+}
+
+/// Add weight * |X_k|^2 to @p acc, where X_k is rebuilt from bins k and m - k of the packed
+/// transform: X_k = (Z_k + conj Z_{m-k}) / 2 + W^k (Z_k - conj Z_{m-k}) / 2i, W = e^{-2 pi i / N}
+void accumulateBin(const float* ar, const float* ai, const float* br, const float* bi, const float wr,
+                   const float wi, const float weight, float* acc, const size_t stride) {
+    size_t c = 0;
+#ifdef CBUTIL_HAVE_SSE2
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 vwr = _mm_set1_ps(wr);
+    const __m128 vwi = _mm_set1_ps(wi);
+    const __m128 vweight = _mm_set1_ps(weight);
+    for (; c < stride; c += LANES) {
+        const __m128 zr = _mm_loadu_ps(ar + c);
+        const __m128 zi = _mm_loadu_ps(ai + c);
+        const __m128 yr = _mm_loadu_ps(br + c);
+        const __m128 yi = _mm_loadu_ps(bi + c);
+        const __m128 er = _mm_mul_ps(half, _mm_add_ps(zr, yr));
+        const __m128 ei = _mm_mul_ps(half, _mm_sub_ps(zi, yi));
+        const __m128 or_ = _mm_mul_ps(half, _mm_add_ps(zi, yi));
+        const __m128 oi = _mm_mul_ps(half, _mm_sub_ps(yr, zr));
+        const __m128 xr = _mm_add_ps(er, _mm_sub_ps(_mm_mul_ps(vwr, or_), _mm_mul_ps(vwi, oi)));
+        const __m128 xi = _mm_add_ps(ei, _mm_add_ps(_mm_mul_ps(vwr, oi), _mm_mul_ps(vwi, or_)));
+        const __m128 p = _mm_add_ps(_mm_mul_ps(xr, xr), _mm_mul_ps(xi, xi));
+        _mm_storeu_ps(acc + c, _mm_add_ps(_mm_loadu_ps(acc + c), _mm_mul_ps(vweight, p)));
+    }
+#endif
+    for (; c < stride; ++c) {
+        const float er = 0.5f * (ar[c] + br[c]);
+        const float ei = 0.5f * (ai[c] - bi[c]);
+        const float or_ = 0.5f * (ai[c] + bi[c]);
+        const float oi = 0.5f * (br[c] - ar[c]);
+        const float xr = er + wr * or_ - wi * oi;
+        const float xi = ei + wr * oi + wi * or_;
+        acc[c] += weight * (xr * xr + xi * xi);
+    }
+}
+
+} // anonymous namespace
+
+struct BandPowerEngine::Impl {
+    BandPowerConfig config;
+    double sample_rate_hz = 0.0;
+    size_t channels = 0;
+    size_t stride = 0;                  // channels padded to LANES
+    size_t n = 0;                       // window
+    size_t m = 0;                       // complex FFT length, n / 2
+
+    std::vector<int16_t> ring;          // [n][channels]; the oldest row is at head once full
+    size_t head = 0;
+    uint64_t seen = 0;
+    std::vector<int64_t> sums;          // per channel, over the ring
+
+    std::vector<float> hann;            // [n]
+    std::vector<uint32_t> bit_reverse;  // [m]
+    std::vector<float> twiddle_re;      // [m / 2]: e^{-2 pi i k / m}
+    std::vector<float> twiddle_im;
+    std::vector<float> unpack_re;       // [m + 1]: e^{-2 pi i k / n}
+    std::vector<float> unpack_im;
+    std::vector<std::pair<size_t, size_t>> bins;    // first and last bin of each band
+    float scale = 0.0f;                 // 1 / (n * sum of hann^2)
+
+    std::vector<float> re;              // [m][stride]
+    std::vector<float> im;
+    std::vector<float> mean;            // [stride]
+    std::vector<float> acc;             // [stride]
+
+    void transform() {
+        for (size_t len = 2; len <= m; len <<= 1) {
+            const size_t half = len / 2;
+            const size_t step = m / len;
+            for (size_t start = 0; start < m; start += len) {
+                for (size_t j = 0; j < half; ++j) {
+                    const size_t a = (start + j) * stride;
+                    const size_t b = (start + j + half) * stride;
+                    butterfly(&re[a], &im[a], &re[b], &im[b], twiddle_re[j * step], twiddle_im[j * step], stride);
+                }
+            }
+        }
+    }
+
+    /// Compute one feature vector from the full ring into @p out
+    void computeFrame(float* out) {
+        for (size_t c = 0; c < channels; ++c) {
+            mean[c] = static_cast<float>(static_cast<double>(sums[c]) / static_cast<double>(n));
+        }
+        // Even samples into the real part, odd into the imaginary part, in bit-reversed order
+        for (size_t i = 0; i < m; ++i) {
+            const int16_t* even = &ring[((head + 2 * i) % n) * channels];
+            const int16_t* odd = &ring[((head + 2 * i + 1) % n) * channels];
+            const float we = hann[2 * i];
+            const float wo = hann[2 * i + 1];
+            float* dst_re = &re[bit_reverse[i] * stride];
+            float* dst_im = &im[bit_reverse[i] * stride];
+            for (size_t c = 0; c < channels; ++c) {
+                dst_re[c] = (even[c] - mean[c]) * we;
+                dst_im[c] = (odd[c] - mean[c]) * wo;
+            }
+        }
+        transform();
+
+        const size_t n_bands = bins.size();
+        for (size_t b = 0; b < n_bands; ++b) {
+            std::fill(acc.begin(), acc.end(), 0.0f);
+            for (size_t k = bins[b].first; k <= bins[b].second; ++k) {
+                const size_t zk = (k % m) * stride;
+                const size_t zmk = ((m - k) % m) * stride;
+                const float weight = (k == 0 || k == m) ? scale : 2.0f * scale;
+                accumulateBin(&re[zk], &im[zk], &re[zmk], &im[zmk], unpack_re[k], unpack_im[k], weight,
+                              acc.data(), stride);
+            }
+            for (size_t c = 0; c < channels; ++c) {
+                out[c * n_bands + b] = acc[c];
+            }
+        }
+    }
+};
+
+BandPowerEngine::BandPowerEngine() = default;
+BandPowerEngine::BandPowerEngine(BandPowerEngine&&) noexcept = default;
+BandPowerEngine& BandPowerEngine::operator=(BandPowerEngine&&) noexcept = default;
+BandPowerEngine::~BandPowerEngine() = default;
+
+cbutil::Result<BandPowerEngine> BandPowerEngine::create(const BandPowerConfig& config, const double sample_rate_hz,
+                                                        const size_t channel_count) {
+    using R = cbutil::Result<BandPowerEngine>;
+    const size_t n = config.window;
+    if (n < MIN_WINDOW || n > BAND_POWER_MAX_WINDOW || (n & (n - 1)) != 0) {
+        return R::error("Window must be a power of two from " + std::to_string(MIN_WINDOW) + " to " +
+                        std::to_string(BAND_POWER_MAX_WINDOW));
+    }
+    if (config.hop == 0) {
+        return R::error("Hop must be at least 1 sample");
+    }
+    if (!(sample_rate_hz > 0.0)) {
+        return R::error("Sample rate must be positive");
+    }
+    if (channel_count == 0) {
+        return R::error("Channel count must be at least 1");
+    }
+    if (config.bands.empty()) {
+        return R::error("At least one band is required");
+    }
+
+    auto impl = std::make_unique<Impl>();
+    impl->config = config;
+    impl->sample_rate_hz = sample_rate_hz;
+    impl->channels = channel_count;
+    impl->stride = (channel_count + LANES - 1) / LANES * LANES;
+    impl->n = n;
+    impl->m = n / 2;
+    const size_t m = impl->m;
+
+    const double bin_hz = sample_rate_hz / static_cast<double>(n);
+    for (const auto& band : config.bands) {
+        if (!(band.low_hz >= 0.0 && band.low_hz <= band.high_hz && band.high_hz <= sample_rate_hz / 2)) {
+            return R::error("Band edges must satisfy 0 <= low <= high <= Nyquist");
+        }
+        const auto first = static_cast<size_t>(std::ceil(band.low_hz / bin_hz - 1e-9));
+        const auto last = std::min(m, static_cast<size_t>(std::floor(band.high_hz / bin_hz + 1e-9)));
+        if (first > last) {
+            return R::error("Band " + std::to_string(band.low_hz) + "-" + std::to_string(band.high_hz) +
+                            " Hz holds no frequency bin; lengthen the window");
+        }
+        impl->bins.emplace_back(first, last);
+    }
+
+    impl->hann.resize(n);
+    double sum_sq = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const double w = 0.5 - 0.5 * std::cos(2.0 * PI * static_cast<double>(i) / static_cast<double>(n));
+        impl->hann[i] = static_cast<float>(w);
+        sum_sq += w * w;
+    }
+    impl->scale = static_cast<float>(1.0 / (static_cast<double>(n) * sum_sq));
+
+    size_t bits = 0;
+    while ((size_t{1} << bits) < m) {
+        ++bits;
+    }
+    impl->bit_reverse.resize(m);
+    for (size_t i = 0; i < m; ++i) {
+        size_t r = 0;
+        for (size_t b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        impl->bit_reverse[i] = static_cast<uint32_t>(r);
+    }
+    impl->twiddle_re.resize(m / 2);
+    impl->twiddle_im.resize(m / 2);
+    for (size_t k = 0; k < m / 2; ++k) {
+        const double a = -2.0 * PI * static_cast<double>(k) / static_cast<double>(m);
+        impl->twiddle_re[k] = static_cast<float>(std::cos(a));
+        impl->twiddle_im[k] = static_cast<float>(std::sin(a));
+    }
+    impl->unpack_re.resize(m + 1);
+    impl->unpack_im.resize(m + 1);
+    for (size_t k = 0; k <= m; ++k) {
+        const double a = -2.0 * PI * static_cast<double>(k) / static_cast<double>(n);
+        impl->unpack_re[k] = static_cast<float>(std::cos(a));
+        impl->unpack_im[k] = static_cast<float>(std::sin(a));
+    }
+
+    impl->ring.assign(n * channel_count, 0);
+    impl->sums.assign(channel_count, 0);
+    impl->re.assign(m * impl->stride, 0.0f);
+    impl->im.assign(m * impl->stride, 0.0f);
+    impl->mean.assign(impl->stride, 0.0f);
+    impl->acc.assign(impl->stride, 0.0f);
+
+    BandPowerEngine engine;
+    engine.m_impl = std::move(impl);
+    return R::ok(std::move(engine));
+}
+
+size_t BandPowerEngine::maxOutput(const size_t n_samples) const {
+    return n_samples / m_impl->config.hop + 1;
+}
+
+size_t BandPowerEngine::process(const int16_t* in, const uint64_t* timestamps, const size_t n_samples, float* out,
+                                uint64_t* out_timestamps) {
+    auto& s = *m_impl;
+    const size_t width = s.channels * s.bins.size();
+    size_t produced = 0;
+    for (size_t r = 0; r < n_samples; ++r) {
+        const int16_t* row = in + r * s.channels;
+        int16_t* slot = &s.ring[s.head * s.channels];
+        for (size_t c = 0; c < s.channels; ++c) {
+            s.sums[c] += row[c] - slot[c];      // the slot holds zeros until the ring fills
+            slot[c] = row[c];
+        }
+        s.head = (s.head + 1) % s.n;
+        ++s.seen;
+        if (s.seen >= s.n && (s.seen - s.n) % s.config.hop == 0) {
+            s.computeFrame(out + produced * width);
+            out_timestamps[produced] = timestamps[r];
+            ++produced;
+        }
+    }
+    return produced;
+}
+
+void BandPowerEngine::reset() {
+    auto& s = *m_impl;
+    std::fill(s.ring.begin(), s.ring.end(), int16_t{0});
+    std::fill(s.sums.begin(), s.sums.end(), int64_t{0});
+    s.head = 0;
+    s.seen = 0;
+}
+
+const BandPowerConfig& BandPowerEngine::config() const {
+    return m_impl->config;
+}
+
+double BandPowerEngine::sampleRateHz() const {
+    return m_impl->sample_rate_hz;
+}
+
+size_t BandPowerEngine::channelCount() const {
+    return m_impl->channels;
+}
+
+size_t BandPowerEngine::bandCount() const {
+    return m_impl->bins.size();
+}
+
+} // namespace cbsdk
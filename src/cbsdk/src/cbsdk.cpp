@@ -14,6 +14,8 @@
 
 #include "cbsdk/cbsdk.h"
 #include "cbsdk/sdk_session.h"
+#include "cbsdk/file_reader.h"
+#include <algorithm>
 #include <chrono>
 #include <csignal>
 #include <cstdlib>
@@ -21,6 +23,7 @@
 #include <memory>
 #include <mutex>
 #include <set>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Session Tracking & Cleanup (forward declarations; bodies after cbsdk_session_impl)
@@ -214,6 +217,18 @@ static void to_c_stats(const cbsdk::SdkStats& cpp_stats, cbsdk_stats_t* c_stats)
     c_stats->send_errors = cpp_stats.send_errors;
 }
 
+/// Convert C++ latency summary to C latency summary
+static void to_c_latency(const cbsdk::LatencySummary& cpp, cbsdk_latency_summary_t* c) {
+    c->count = cpp.count;
+    c->min_ns = cpp.min_ns;
+    c->p50_ns = cpp.p50_ns;
+    c->p90_ns = cpp.p90_ns;
+    c->p99_ns = cpp.p99_ns;
+    c->p999_ns = cpp.p999_ns;
+    c->max_ns = cpp.max_ns;
+    c->mean_ns = cpp.mean_ns;
+}
+
 /// Convert C chaninfo field enum to C++ ChanInfoField enum
 static cbsdk::ChanInfoField to_cpp_chaninfo_field(cbsdk_chaninfo_field_t c_field) {
     switch (c_field) {
@@ -248,6 +263,38 @@ static cbsdk::ChannelType to_cpp_channel_type(cbproto_channel_type_t c_type) {
     }
 }
 
+/// Build a batch format from the C registration arguments; false if the filter cannot be designed
+static bool to_cpp_batch_format(cbproto_group_rate_t rate, const uint32_t* chan_ids, uint32_t n_chans,
+                                const cbsdk_filter_spec_t* spec, cbsdk_sample_layout_t layout,
+                                const cbsdk_batch_policy_t* policy, cbsdk::GroupBatchFormat& format) {
+    if (chan_ids) {
+        format.chan_ids.assign(chan_ids, chan_ids + n_chans);
+    }
+    format.layout = static_cast<cbsdk::SampleLayout>(layout);
+    if (policy) {
+        format.policy.min_samples = policy->min_samples;
+        format.policy.max_samples = policy->max_samples;
+        format.policy.max_delay_us = policy->max_delay_us;
+    }
+    if (spec) {
+        cbsdk::FilterSpec cpp_spec;
+        cpp_spec.hpfreq = spec->hpfreq;
+        cpp_spec.hporder = spec->hporder;
+        cpp_spec.hptype = spec->hptype;
+        cpp_spec.lpfreq = spec->lpfreq;
+        cpp_spec.lporder = spec->lporder;
+        cpp_spec.lptype = spec->lptype;
+        cpp_spec.notch_freq = spec->notch_freq;
+        cpp_spec.notch_bandwidth = spec->notch_bandwidth;
+        auto sections = cbsdk::designFilter(cpp_spec, cbsdk::sampleRateHz(static_cast<cbsdk::SampleRate>(rate)));
+        if (sections.isError()) {
+            return false;
+        }
+        format.sections = std::move(sections.value());
+    }
+    return true;
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // C API Implementation
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -269,6 +316,53 @@ cbsdk_config_t cbsdk_config_default(void) {
     return config;
 }
 
+cbsdk_spike_detection_config_t cbsdk_spike_detection_config_default(void) {
+    cbsdk_spike_detection_config_t config{};
+    config.source = CBPROTO_GROUP_RATE_RAW;
+    config.filter.hpfreq = 250000;
+    config.filter.hporder = 4;
+    config.filter.hptype = cbFILTTYPE_BUTTERWORTH;
+    config.filter.lptype = cbFILTTYPE_BUTTERWORTH;
+    config.filter.notch_bandwidth = 2000;
+    config.threshold.mode = CBSDK_THRESHOLD_RMS;
+    config.threshold.rms_multiplier = -4.5f;
+    config.refractory_samples = 30;
+    config.rms_window = 30000;
+    return config;
+}
+
+cbsdk_epoch_config_t cbsdk_epoch_config_default(void) {
+    const cbsdk::EpochConfig defaults;
+    cbsdk_epoch_config_t config{};
+    config.source = CBPROTO_GROUP_RATE_RAW;
+    config.pre_samples = static_cast<uint32_t>(defaults.pre_samples);
+    config.post_samples = static_cast<uint32_t>(defaults.post_samples);
+    config.max_delay_samples = static_cast<uint32_t>(defaults.max_delay_samples);
+    config.max_pending = static_cast<uint32_t>(defaults.max_pending);
+    config.unit_mask = cbsdk::EpochTriggers{}.unit_mask;
+    return config;
+}
+
+cbsdk_spike_binning_config_t cbsdk_spike_binning_config_default(void) {
+    const cbsdk::SpikeBinnerConfig defaults;
+    cbsdk_spike_binning_config_t config{};
+    config.bin_width = defaults.bin_width;
+    config.latency = defaults.latency;
+    config.channel_count = static_cast<uint32_t>(defaults.channel_count);
+    config.unit_count = static_cast<uint32_t>(defaults.unit_count);
+    config.buffer_bins = static_cast<uint32_t>(defaults.buffer_bins);
+    return config;
+}
+
+cbsdk_spike_sorting_config_t cbsdk_spike_sorting_config_default(void) {
+    const cbsdk::SpikeSortingConfig defaults;
+    cbsdk_spike_sorting_config_t config{};
+    config.gate = defaults.gate;
+    config.threads = static_cast<uint32_t>(defaults.threads);
+    config.device_spikes = defaults.device_spikes;
+    return config;
+}
+
 cbsdk_result_t cbsdk_session_create(cbsdk_session_t* session, const cbsdk_config_t* config) {
     if (!session || !config) {
         return CBSDK_RESULT_INVALID_PARAMETER;
@@ -434,6 +528,23 @@ void cbsdk_session_get_stats(cbsdk_session_t session, cbsdk_stats_t* stats) {
     }
 }
 
+void cbsdk_session_get_latency_stats(cbsdk_session_t session, cbsdk_latency_stats_t* stats) {
+    if (!session || !session->cpp_session || !stats) {
+        return;
+    }
+
+    try {
+        const cbsdk::LatencyStats cpp_stats = session->cpp_session->getLatencyStats();
+        to_c_latency(cpp_stats.device_to_arrival, &stats->device_to_arrival);
+        to_c_latency(cpp_stats.arrival_to_store, &stats->arrival_to_store);
+        to_c_latency(cpp_stats.store_to_dequeue, &stats->store_to_dequeue);
+        to_c_latency(cpp_stats.dequeue_to_callback, &stats->dequeue_to_callback);
+        to_c_latency(cpp_stats.device_to_callback, &stats->device_to_callback);
+    } catch (...) {
+        std::memset(stats, 0, sizeof(cbsdk_latency_stats_t));
+    }
+}
+
 void cbsdk_session_reset_stats(cbsdk_session_t session) {
     if (session && session->cpp_session) {
         try {
@@ -460,6 +571,10 @@ const char* cbsdk_get_error_message(cbsdk_result_t result) {
             return "Device connection error";
         case CBSDK_RESULT_INTERNAL_ERROR:
             return "Internal error";
+        case CBSDK_RESULT_TIMEOUT:
+            return "Operation timed out";
+        case CBSDK_RESULT_FILE_ERROR:
+            return "File missing, unreadable or not in a known format";
         default:
             return "Unknown error";
     }
@@ -559,6 +674,147 @@ cbsdk_callback_handle_t cbsdk_session_register_group_batch_callback(
     }
 }
 
+cbsdk_callback_handle_t cbsdk_session_register_filtered_group_batch_callback(
+    cbsdk_session_t session,
+    cbproto_group_rate_t rate,
+    const cbsdk_filter_spec_t* spec,
+    cbsdk_group_batch_callback_fn callback,
+    void* user_data) {
+    if (!session || !session->cpp_session || !spec || !callback) {
+        return 0;
+    }
+    try {
+        cbsdk::FilterSpec cpp_spec;
+        cpp_spec.hpfreq = spec->hpfreq;
+        cpp_spec.hporder = spec->hporder;
+        cpp_spec.hptype = spec->hptype;
+        cpp_spec.lpfreq = spec->lpfreq;
+        cpp_spec.lporder = spec->lporder;
+        cpp_spec.lptype = spec->lptype;
+        cpp_spec.notch_freq = spec->notch_freq;
+        cpp_spec.notch_bandwidth = spec->notch_bandwidth;
+        const auto sample_rate = static_cast<cbsdk::SampleRate>(rate);
+        auto sections = cbsdk::designFilter(cpp_spec, cbsdk::sampleRateHz(sample_rate));
+        if (sections.isError()) {
+            return 0;
+        }
+        return session->cpp_session->registerFilteredGroupBatchCallback(
+            sample_rate, std::move(sections.value()),
+            [callback, user_data](const int16_t* samples, size_t n_samples,
+                                   size_t n_channels, const uint64_t* timestamps) {
+                callback(samples, n_samples, n_channels, timestamps, user_data);
+            }
+        );
+    } catch (...) {
+        return 0;
+    }
+}
+
+cbsdk_callback_handle_t cbsdk_session_register_channel_group_batch_callback(
+    cbsdk_session_t session,
+    cbproto_group_rate_t rate,
+    const uint32_t* chan_ids,
+    uint32_t n_chans,
+    const cbsdk_filter_spec_t* spec,
+    cbsdk_group_batch_callback_fn callback,
+    void* user_data) {
+    if (!session || !session->cpp_session || !chan_ids || !callback) {
+        return 0;
+    }
+    try {
+        const auto sample_rate = static_cast<cbsdk::SampleRate>(rate);
+        const std::vector<uint32_t> channels(chan_ids, chan_ids + n_chans);
+        auto cpp_callback = [callback, user_data](const int16_t* samples, size_t n_samples,
+                                                   size_t n_channels, const uint64_t* timestamps) {
+            callback(samples, n_samples, n_channels, timestamps, user_data);
+        };
+        auto handle = cbsdk::Result<cbsdk::CallbackHandle>::ok(0);
+        if (spec) {
+            cbsdk::FilterSpec cpp_spec;
+            cpp_spec.hpfreq = spec->hpfreq;
+            cpp_spec.hporder = spec->hporder;
+            cpp_spec.hptype = spec->hptype;
+            cpp_spec.lpfreq = spec->lpfreq;
+            cpp_spec.lporder = spec->lporder;
+            cpp_spec.lptype = spec->lptype;
+            cpp_spec.notch_freq = spec->notch_freq;
+            cpp_spec.notch_bandwidth = spec->notch_bandwidth;
+            auto sections = cbsdk::designFilter(cpp_spec, cbsdk::sampleRateHz(sample_rate));
+            if (sections.isError()) {
+                return 0;
+            }
+            handle = session->cpp_session->registerFilteredGroupBatchCallback(
+                sample_rate, channels, std::move(sections.value()), std::move(cpp_callback));
+        } else {
+            handle = session->cpp_session->registerGroupBatchCallback(sample_rate, channels,
+                                                                      std::move(cpp_callback));
+        }
+        return handle.isOk() ? handle.value() : 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
+cbsdk_callback_handle_t cbsdk_session_register_formatted_group_batch_callback(
+    cbsdk_session_t session,
+    cbproto_group_rate_t rate,
+    const uint32_t* chan_ids,
+    uint32_t n_chans,
+    const cbsdk_filter_spec_t* spec,
+    cbsdk_sample_layout_t layout,
+    const cbsdk_batch_policy_t* policy,
+    cbsdk_group_batch_callback_fn callback,
+    void* user_data) {
+    if (!session || !session->cpp_session || !callback || layout > CBSDK_CHANNEL_MAJOR) {
+        return 0;
+    }
+    try {
+        cbsdk::GroupBatchFormat format;
+        if (!to_cpp_batch_format(rate, chan_ids, n_chans, spec, layout, policy, format)) {
+            return 0;
+        }
+        auto handle = session->cpp_session->registerFormattedGroupBatchCallback(
+            static_cast<cbsdk::SampleRate>(rate), format,
+            [callback, user_data](const int16_t* samples, size_t n_samples, size_t n_channels,
+                                  const uint64_t* timestamps) {
+                callback(samples, n_samples, n_channels, timestamps, user_data);
+            });
+        return handle.isOk() ? handle.value() : 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
+cbsdk_callback_handle_t cbsdk_session_register_scaled_group_batch_callback(
+    cbsdk_session_t session,
+    cbproto_group_rate_t rate,
+    const uint32_t* chan_ids,
+    uint32_t n_chans,
+    const cbsdk_filter_spec_t* spec,
+    cbsdk_sample_layout_t layout,
+    const cbsdk_batch_policy_t* policy,
+    cbsdk_scaled_group_batch_callback_fn callback,
+    void* user_data) {
+    if (!session || !session->cpp_session || !callback || layout > CBSDK_CHANNEL_MAJOR) {
+        return 0;
+    }
+    try {
+        cbsdk::GroupBatchFormat format;
+        if (!to_cpp_batch_format(rate, chan_ids, n_chans, spec, layout, policy, format)) {
+            return 0;
+        }
+        auto handle = session->cpp_session->registerScaledGroupBatchCallback(
+            static_cast<cbsdk::SampleRate>(rate), format,
+            [callback, user_data](const float* samples, size_t n_samples, size_t n_channels,
+                                  const uint64_t* timestamps) {
+                callback(samples, n_samples, n_channels, timestamps, user_data);
+            });
+        return handle.isOk() ? handle.value() : 0;
+    } catch (...) {
+        return 0;
+    }
+}
+
 cbsdk_callback_handle_t cbsdk_session_register_config_callback(
     cbsdk_session_t session,
     uint16_t packet_type,
@@ -1541,80 +1797,1419 @@ cbsdk_result_t cbsdk_session_close_central_file_dialog(cbsdk_session_t session)
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-// AC Input Coupling
+// Local Recording
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-cbsdk_result_t cbsdk_session_set_ac_input_coupling(
+cbsdk_result_t cbsdk_session_start_recording(
     cbsdk_session_t session,
-    uint32_t n_chans,
-    const uint32_t* chans,
-    cbproto_channel_type_t chan_type,
-    bool enabled) {
-    if (!session || !session->cpp_session) {
+    const char* base_path,
+    const char* comment) {
+    if (!session || !session->cpp_session || !base_path) {
         return CBSDK_RESULT_INVALID_PARAMETER;
     }
     try {
-        auto result = session->cpp_session->setACInputCoupling(
-            n_chans, to_cpp_channel_type(chan_type), enabled, chans);
+        if (session->cpp_session->isRecording()) {
+            return CBSDK_RESULT_ALREADY_RUNNING;
+        }
+        cbsdk::RecordingOptions options;
+        options.comment = comment ? comment : "";
+        auto result = session->cpp_session->startRecording(base_path, options);
         return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INTERNAL_ERROR;
     } catch (...) {
         return CBSDK_RESULT_INTERNAL_ERROR;
     }
 }
 
+void cbsdk_session_stop_recording(cbsdk_session_t session) {
+    if (session && session->cpp_session) {
+        try {
+            session->cpp_session->stopRecording();
+        } catch (...) {
+            // Swallow exceptions
+        }
+    }
+}
+
+bool cbsdk_session_is_recording(cbsdk_session_t session) {
+    if (!session || !session->cpp_session) {
+        return false;
+    }
+    try {
+        return session->cpp_session->isRecording();
+    } catch (...) {
+        return false;
+    }
+}
+
+void cbsdk_session_get_recording_stats(cbsdk_session_t session, cbsdk_recording_stats_t* stats) {
+    if (!session || !session->cpp_session || !stats) {
+        return;
+    }
+
+    try {
+        const cbsdk::RecorderStats cpp_stats = session->cpp_session->getRecordingStats();
+        stats->continuous_packets = cpp_stats.continuous_packets;
+        stats->spike_packets = cpp_stats.spike_packets;
+        stats->digital_packets = cpp_stats.digital_packets;
+        stats->bytes_written = cpp_stats.bytes_written;
+        stats->packets_dropped = cpp_stats.packets_dropped;
+        stats->write_errors = cpp_stats.write_errors;
+        stats->pending_bytes = cpp_stats.pending_bytes;
+        stats->direct_io = cpp_stats.direct_io;
+    } catch (...) {
+        std::memset(stats, 0, sizeof(cbsdk_recording_stats_t));
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
-// Spike Sorting
+// Virtual Sample Groups
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-cbsdk_result_t cbsdk_session_set_spike_sorting(
+cbsdk_result_t cbsdk_session_create_resampled_group(
     cbsdk_session_t session,
-    uint32_t n_chans,
-    const uint32_t* chans,
-    cbproto_channel_type_t chan_type,
-    uint32_t sort_options) {
+    cbproto_group_rate_t source,
+    uint32_t up,
+    uint32_t down,
+    uint32_t buffer_samples,
+    uint32_t* group) {
+    if (!session || !session->cpp_session || !group) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->createResampledGroup(
+            static_cast<cbsdk::SampleRate>(source), up, down, buffer_samples);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *group = result.value();
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_create_rereferenced_group(
+    cbsdk_session_t session,
+    cbproto_group_rate_t source,
+    cbsdk_reference_scheme_t scheme,
+    cbsdk_reference_statistic_t statistic,
+    uint32_t buffer_samples,
+    uint32_t* group) {
+    if (!session || !session->cpp_session || !group || scheme > CBSDK_REFERENCE_ELECTRODE ||
+        statistic > CBSDK_REFERENCE_MEDIAN) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->createRereferencedGroup(
+            static_cast<cbsdk::SampleRate>(source), static_cast<cbsdk::ReferenceScheme>(scheme),
+            static_cast<cbsdk::ReferenceStatistic>(statistic), buffer_samples);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *group = result.value();
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_destroy_virtual_group(cbsdk_session_t session, uint32_t group) {
     if (!session || !session->cpp_session) {
         return CBSDK_RESULT_INVALID_PARAMETER;
     }
     try {
-        auto result = session->cpp_session->setSpikeSorting(
-            n_chans, to_cpp_channel_type(chan_type), sort_options, chans);
-        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INTERNAL_ERROR;
+        auto result = session->cpp_session->destroyVirtualGroup(group);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
     } catch (...) {
         return CBSDK_RESULT_INTERNAL_ERROR;
     }
 }
 
-cbsdk_result_t cbsdk_session_set_channel_spike_sorting(
-    cbsdk_session_t session, uint32_t chan_id, uint32_t sort_options, int auto_sync) {
-    // Use CHANSETSPK (firmware reads spkopts+spkfilter).  Earlier revisions
-    // used CHANSETSPKTHR, which only reads spkthrlevel and would silently
-    // ignore the spkopts update we want here.
-    return modify_and_send_chaninfo(session, chan_id, cbPKTTYPE_CHANSETSPK,
-        [sort_options](cbPKT_CHANINFO& ci) {
-            ci.spkopts &= ~cbAINPSPK_ALLSORT;
-            ci.spkopts |= sort_options;
-        },
-        auto_sync != 0);
+cbsdk_callback_handle_t cbsdk_session_register_virtual_group_batch_callback(
+    cbsdk_session_t session,
+    uint32_t group,
+    cbsdk_group_batch_callback_fn callback,
+    void* user_data) {
+    if (!session || !session->cpp_session || !callback) {
+        return 0;
+    }
+    try {
+        return session->cpp_session->registerVirtualGroupBatchCallback(
+            group,
+            [callback, user_data](const int16_t* samples, size_t n_samples,
+                                   size_t n_channels, const uint64_t* timestamps) {
+                callback(samples, n_samples, n_channels, timestamps, user_data);
+            }
+        );
+    } catch (...) {
+        return 0;
+    }
 }
 
-cbsdk_result_t cbsdk_session_set_spike_extraction(
+cbsdk_result_t cbsdk_session_get_virtual_group_info(
     cbsdk_session_t session,
-    uint32_t n_chans,
-    const uint32_t* chans,
-    cbproto_channel_type_t chan_type,
-    bool enabled) {
+    uint32_t group,
+    cbsdk_virtual_group_info_t* info) {
+    if (!session || !session->cpp_session || !info) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->getVirtualGroupInfo(group);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        const auto& cpp_info = result.value();
+        info->kind = static_cast<uint32_t>(cpp_info.kind);
+        info->source = static_cast<cbproto_group_rate_t>(cpp_info.source);
+        info->up = cpp_info.up;
+        info->down = cpp_info.down;
+        info->sample_rate_hz = cpp_info.sample_rate_hz;
+        info->group_delay = cpp_info.group_delay;
+        info->channel_count = static_cast<uint32_t>(cpp_info.channel_count);
+        info->buffer_capacity = static_cast<uint32_t>(cpp_info.buffer_capacity);
+        info->buffered = static_cast<uint32_t>(cpp_info.buffered);
+        info->samples_produced = cpp_info.samples_produced;
+        info->samples_overwritten = cpp_info.samples_overwritten;
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_read_virtual_group(
+    cbsdk_session_t session,
+    uint32_t group,
+    int16_t* samples,
+    uint64_t* timestamps,
+    uint32_t max_channels,
+    uint32_t* n_samples,
+    uint32_t* n_channels) {
+    if (!session || !session->cpp_session || !samples || !n_samples || !n_channels) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        size_t channels = 0;
+        auto result = session->cpp_session->readVirtualGroup(
+            group, samples, timestamps, *n_samples, max_channels, channels);
+        *n_channels = static_cast<uint32_t>(channels);
+        if (result.isError()) {
+            *n_samples = 0;
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *n_samples = static_cast<uint32_t>(result.value());
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Band Power
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+cbsdk_result_t cbsdk_session_create_band_power_stream(
+    cbsdk_session_t session,
+    const cbsdk_band_power_config_t* config,
+    const cbsdk_frequency_band_t* bands,
+    uint32_t n_bands,
+    uint32_t buffer_frames,
+    uint32_t* stream) {
+    if (!session || !session->cpp_session || !config || !bands || !stream) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        cbsdk::BandPowerConfig cpp_config;
+        cpp_config.window = config->window;
+        cpp_config.hop = config->hop;
+        for (uint32_t i = 0; i < n_bands; ++i) {
+            cpp_config.bands.push_back({bands[i].low_hz, bands[i].high_hz});
+        }
+        auto result = config->virtual_group != 0
+            ? session->cpp_session->createBandPowerStream(config->virtual_group, cpp_config, buffer_frames)
+            : session->cpp_session->createBandPowerStream(static_cast<cbsdk::SampleRate>(config->source),
+                                                          cpp_config, buffer_frames);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *stream = result.value();
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_destroy_band_power_stream(cbsdk_session_t session, uint32_t stream) {
     if (!session || !session->cpp_session) {
         return CBSDK_RESULT_INVALID_PARAMETER;
     }
     try {
-        auto result = session->cpp_session->setSpikeExtraction(
-            n_chans, to_cpp_channel_type(chan_type), enabled, chans);
-        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INTERNAL_ERROR;
+        auto result = session->cpp_session->destroyBandPowerStream(stream);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
     } catch (...) {
         return CBSDK_RESULT_INTERNAL_ERROR;
     }
 }
 
+cbsdk_callback_handle_t cbsdk_session_register_band_power_callback(
+    cbsdk_session_t session,
+    uint32_t stream,
+    cbsdk_band_power_callback_fn callback,
+    void* user_data) {
+    if (!session || !session->cpp_session || !callback) {
+        return 0;
+    }
+    try {
+        return session->cpp_session->registerBandPowerCallback(
+            stream,
+            [callback, user_data](const float* features, size_t n_frames, size_t n_channels,
+                                   size_t n_bands, const uint64_t* timestamps) {
+                callback(features, n_frames, n_channels, n_bands, timestamps, user_data);
+            }
+        );
+    } catch (...) {
+        return 0;
+    }
+}
+
+cbsdk_result_t cbsdk_session_get_band_power_info(
+    cbsdk_session_t session,
+    uint32_t stream,
+    cbsdk_band_power_info_t* info) {
+    if (!session || !session->cpp_session || !info) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->getBandPowerStreamInfo(stream);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        const auto& cpp_info = result.value();
+        info->source = static_cast<cbproto_group_rate_t>(cpp_info.source);
+        info->virtual_group = cpp_info.source_virtual;
+        info->sample_rate_hz = cpp_info.sample_rate_hz;
+        info->window = static_cast<uint32_t>(cpp_info.window);
+        info->hop = static_cast<uint32_t>(cpp_info.hop);
+        info->band_count = static_cast<uint32_t>(cpp_info.band_count);
+        info->channel_count = static_cast<uint32_t>(cpp_info.channel_count);
+        info->buffer_capacity = static_cast<uint32_t>(cpp_info.buffer_capacity);
+        info->buffered = static_cast<uint32_t>(cpp_info.buffered);
+        info->frames_produced = cpp_info.frames_produced;
+        info->frames_overwritten = cpp_info.frames_overwritten;
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_read_band_power(
+    cbsdk_session_t session,
+    uint32_t stream,
+    float* features,
+    uint64_t* timestamps,
+    uint32_t max_channels,
+    uint32_t* n_frames,
+    uint32_t* n_channels) {
+    if (!session || !session->cpp_session || !features || !n_frames || !n_channels) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        size_t channels = 0;
+        auto result = session->cpp_session->readBandPower(
+            stream, features, timestamps, *n_frames, max_channels, channels);
+        *n_channels = static_cast<uint32_t>(channels);
+        if (result.isError()) {
+            *n_frames = 0;
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *n_frames = static_cast<uint32_t>(result.value());
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Peri-Event Epochs
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static cbsdk_epoch_event_t to_c_epoch_event(const cbsdk::EpochEvent& event) {
+    cbsdk_epoch_event_t c_event;
+    c_event.time = event.time;
+    c_event.trigger_time = event.trigger_time;
+    c_event.chan_id = event.chan_id;
+    c_event.value = event.value;
+    return c_event;
+}
+
+cbsdk_result_t cbsdk_session_create_epoch_stream(
+    cbsdk_session_t session,
+    const cbsdk_epoch_config_t* config,
+    const uint32_t* channels,
+    uint32_t n_channels,
+    uint32_t buffer_epochs,
+    uint32_t* stream) {
+    if (!session || !session->cpp_session || !config || (!channels && n_channels > 0) || !stream) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        cbsdk::EpochConfig cpp_config;
+        cpp_config.pre_samples = config->pre_samples;
+        cpp_config.post_samples = config->post_samples;
+        cpp_config.max_delay_samples = config->max_delay_samples;
+        cpp_config.max_pending = config->max_pending;
+        cbsdk::EpochTriggers triggers;
+        triggers.channels.assign(channels, channels + n_channels);
+        triggers.unit_mask = config->unit_mask;
+        triggers.comments = config->comments;
+        auto result = session->cpp_session->createEpochStream(
+            static_cast<cbsdk::SampleRate>(config->source), cpp_config, triggers, buffer_epochs);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *stream = result.value();
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_destroy_epoch_stream(cbsdk_session_t session, uint32_t stream) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->destroyEpochStream(stream);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_callback_handle_t cbsdk_session_register_epoch_callback(
+    cbsdk_session_t session,
+    uint32_t stream,
+    cbsdk_epoch_callback_fn callback,
+    void* user_data) {
+    if (!session || !session->cpp_session || !callback) {
+        return 0;
+    }
+    try {
+        return session->cpp_session->registerEpochCallback(
+            stream,
+            [callback, user_data](const cbsdk::EpochEvent& event, const int16_t* samples, size_t n_samples,
+                                   size_t n_channels, const uint64_t* timestamps) {
+                const cbsdk_epoch_event_t c_event = to_c_epoch_event(event);
+                callback(&c_event, samples, n_samples, n_channels, timestamps, user_data);
+            }
+        );
+    } catch (...) {
+        return 0;
+    }
+}
+
+cbsdk_result_t cbsdk_session_get_epoch_info(
+    cbsdk_session_t session,
+    uint32_t stream,
+    cbsdk_epoch_info_t* info) {
+    if (!session || !session->cpp_session || !info) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->getEpochStreamInfo(stream);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        const auto& cpp_info = result.value();
+        info->source = static_cast<cbproto_group_rate_t>(cpp_info.source);
+        info->pre_samples = static_cast<uint32_t>(cpp_info.pre_samples);
+        info->post_samples = static_cast<uint32_t>(cpp_info.post_samples);
+        info->channel_count = static_cast<uint32_t>(cpp_info.channel_count);
+        info->pending = static_cast<uint32_t>(cpp_info.pending);
+        info->buffer_capacity = static_cast<uint32_t>(cpp_info.buffer_capacity);
+        info->buffered = static_cast<uint32_t>(cpp_info.buffered);
+        info->epochs_produced = cpp_info.epochs_produced;
+        info->epochs_overwritten = cpp_info.epochs_overwritten;
+        info->events_late = cpp_info.events_late;
+        info->events_dropped = cpp_info.events_dropped;
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_read_epochs(
+    cbsdk_session_t session,
+    uint32_t stream,
+    int16_t* samples,
+    cbsdk_epoch_event_t* events,
+    uint32_t max_channels,
+    uint32_t* n_epochs,
+    uint32_t* n_channels) {
+    if (!session || !session->cpp_session || !samples || !n_epochs || !n_channels) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        std::vector<cbsdk::EpochEvent> cpp_events(events ? *n_epochs : 0);
+        size_t channels = 0;
+        auto result = session->cpp_session->readEpochs(
+            stream, samples, events ? cpp_events.data() : nullptr, *n_epochs, max_channels, channels);
+        *n_channels = static_cast<uint32_t>(channels);
+        if (result.isError()) {
+            *n_epochs = 0;
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *n_epochs = static_cast<uint32_t>(result.value());
+        for (uint32_t i = 0; events && i < *n_epochs; ++i) {
+            events[i] = to_c_epoch_event(cpp_events[i]);
+        }
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Host Spike Detection
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static cbsdk::SpikeThreshold to_cpp_threshold(const cbsdk_spike_threshold_t& threshold) {
+    cbsdk::SpikeThreshold cpp_threshold;
+    cpp_threshold.mode = static_cast<cbsdk::ThresholdMode>(threshold.mode);
+    cpp_threshold.level = threshold.level;
+    cpp_threshold.rms_multiplier = threshold.rms_multiplier;
+    return cpp_threshold;
+}
+
+cbsdk_result_t cbsdk_session_start_spike_detection(
+    cbsdk_session_t session,
+    const cbsdk_spike_detection_config_t* config) {
+    if (!session || !session->cpp_session || !config || config->threshold.mode > CBSDK_THRESHOLD_RMS) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        cbsdk::FilterSpec spec;
+        spec.hpfreq = config->filter.hpfreq;
+        spec.hporder = config->filter.hporder;
+        spec.hptype = config->filter.hptype;
+        spec.lpfreq = config->filter.lpfreq;
+        spec.lporder = config->filter.lporder;
+        spec.lptype = config->filter.lptype;
+        spec.notch_freq = config->filter.notch_freq;
+        spec.notch_bandwidth = config->filter.notch_bandwidth;
+
+        cbsdk::SpikeDetectionConfig cpp_config;
+        cpp_config.source = static_cast<cbsdk::SampleRate>(config->source);
+        auto sections = cbsdk::designFilter(spec, cbsdk::sampleRateHz(cpp_config.source));
+        if (sections.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        cpp_config.filter = std::move(sections.value());
+        cpp_config.threshold = to_cpp_threshold(config->threshold);
+        cpp_config.refractory_samples = config->refractory_samples;
+        cpp_config.rms_window = config->rms_window;
+        auto result = session->cpp_session->startSpikeDetection(cpp_config);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+void cbsdk_session_stop_spike_detection(cbsdk_session_t session) {
+    if (session && session->cpp_session) {
+        try {
+            session->cpp_session->stopSpikeDetection();
+        } catch (...) {
+            // Swallow exceptions
+        }
+    }
+}
+
+bool cbsdk_session_is_spike_detection_running(cbsdk_session_t session) {
+    if (!session || !session->cpp_session) {
+        return false;
+    }
+    try {
+        return session->cpp_session->isSpikeDetectionRunning();
+    } catch (...) {
+        return false;
+    }
+}
+
+cbsdk_result_t cbsdk_session_set_spike_detection_threshold(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    const cbsdk_spike_threshold_t* threshold) {
+    if (!session || !session->cpp_session || !threshold || threshold->mode > CBSDK_THRESHOLD_RMS) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->setSpikeDetectionThreshold(chan_id, to_cpp_threshold(*threshold));
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_get_spike_detection_level(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    int16_t* level) {
+    if (!session || !session->cpp_session || !level) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->getSpikeDetectionLevel(chan_id);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *level = result.value();
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Spike Binning
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+cbsdk_result_t cbsdk_session_start_spike_binning(
+    cbsdk_session_t session,
+    const cbsdk_spike_binning_config_t* config) {
+    if (!session || !session->cpp_session || !config) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        cbsdk::SpikeBinnerConfig cpp_config;
+        cpp_config.bin_width = config->bin_width;
+        cpp_config.latency = config->latency;
+        cpp_config.channel_count = config->channel_count;
+        cpp_config.unit_count = config->unit_count;
+        cpp_config.buffer_bins = config->buffer_bins;
+        auto result = session->cpp_session->startSpikeBinning(cpp_config);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+void cbsdk_session_stop_spike_binning(cbsdk_session_t session) {
+    if (session && session->cpp_session) {
+        try {
+            session->cpp_session->stopSpikeBinning();
+        } catch (...) {
+            // Swallow exceptions
+        }
+    }
+}
+
+bool cbsdk_session_is_spike_binning_running(cbsdk_session_t session) {
+    if (!session || !session->cpp_session) {
+        return false;
+    }
+    try {
+        return session->cpp_session->isSpikeBinningRunning();
+    } catch (...) {
+        return false;
+    }
+}
+
+cbsdk_callback_handle_t cbsdk_session_register_spike_bin_callback(
+    cbsdk_session_t session,
+    cbsdk_spike_bin_callback_fn callback,
+    void* user_data) {
+    if (!session || !session->cpp_session || !callback) {
+        return 0;
+    }
+    try {
+        return session->cpp_session->registerSpikeBinCallback(
+            [callback, user_data](uint64_t start_time, const uint32_t* counts,
+                                   size_t n_channels, size_t n_units) {
+                callback(start_time, counts, n_channels, n_units, user_data);
+            }
+        );
+    } catch (...) {
+        return 0;
+    }
+}
+
+cbsdk_result_t cbsdk_session_read_spike_bins(
+    cbsdk_session_t session,
+    uint32_t* counts,
+    uint64_t* start_times,
+    uint32_t* n_bins) {
+    if (!session || !session->cpp_session || !counts || !n_bins) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->readSpikeBins(counts, start_times, *n_bins);
+        if (result.isError()) {
+            *n_bins = 0;
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *n_bins = static_cast<uint32_t>(result.value());
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_get_spike_binning_stats(
+    cbsdk_session_t session,
+    cbsdk_spike_binning_stats_t* stats) {
+    if (!session || !session->cpp_session || !stats) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->getSpikeBinningStats();
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        const auto& s = result.value();
+        stats->spikes_counted = s.spikes_counted;
+        stats->spikes_late = s.spikes_late;
+        stats->spikes_ignored = s.spikes_ignored;
+        stats->bins_closed = s.bins_closed;
+        stats->bins_skipped = s.bins_skipped;
+        stats->bins_overwritten = s.bins_overwritten;
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Digital Input Tracking
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+cbsdk_result_t cbsdk_session_start_digital_input_tracking(
+    cbsdk_session_t session,
+    uint32_t buffer_events) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->startDigitalInputTracking(buffer_events);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+void cbsdk_session_stop_digital_input_tracking(cbsdk_session_t session) {
+    if (session && session->cpp_session) {
+        try {
+            session->cpp_session->stopDigitalInputTracking();
+        } catch (...) {
+            // Swallow exceptions
+        }
+    }
+}
+
+bool cbsdk_session_is_digital_input_tracking_running(cbsdk_session_t session) {
+    if (!session || !session->cpp_session) {
+        return false;
+    }
+    try {
+        return session->cpp_session->isDigitalInputTrackingRunning();
+    } catch (...) {
+        return false;
+    }
+}
+
+cbsdk_result_t cbsdk_session_read_digital_input_events(
+    cbsdk_session_t session,
+    uint64_t* cursor,
+    cbsdk_digital_input_event_t* events,
+    uint32_t* n_events,
+    uint64_t* skipped) {
+    if (!session || !session->cpp_session || !cursor || !events || !n_events) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        std::vector<cbsdk::DigitalInputEvent> cpp_events(*n_events);
+        auto result = session->cpp_session->readDigitalInputEvents(*cursor, cpp_events.data(), *n_events, skipped);
+        if (result.isError()) {
+            *n_events = 0;
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *n_events = static_cast<uint32_t>(result.value());
+        for (uint32_t i = 0; i < *n_events; ++i) {
+            events[i].time = cpp_events[i].time;
+            events[i].chan_id = cpp_events[i].chan_id;
+            events[i].value = cpp_events[i].value;
+            events[i].rising = cpp_events[i].rising;
+            events[i].falling = cpp_events[i].falling;
+        }
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_get_digital_input_state(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    const uint64_t* times,
+    uint32_t n_times,
+    uint32_t* values,
+    uint32_t* n_exact) {
+    if (!session || !session->cpp_session || !times || !values) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->getDigitalInputState(chan_id, times, n_times, values);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        if (n_exact) {
+            *n_exact = static_cast<uint32_t>(result.value());
+        }
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_get_digital_input_word(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    uint32_t* value) {
+    if (!session || !session->cpp_session || !value) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->getDigitalInputWord(chan_id);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *value = result.value();
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_get_digital_input_stats(
+    cbsdk_session_t session,
+    cbsdk_digital_input_stats_t* stats) {
+    if (!session || !session->cpp_session || !stats) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->getDigitalInputStats();
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        const auto& s = result.value();
+        stats->events = s.events;
+        stats->edges_rising = s.edges_rising;
+        stats->edges_falling = s.edges_falling;
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Host Spike Sorting
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+cbsdk_result_t cbsdk_session_start_spike_sorting(
+    cbsdk_session_t session,
+    const cbsdk_spike_sorting_config_t* config) {
+    if (!session || !session->cpp_session || !config) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        cbsdk::SpikeSortingConfig cpp_config;
+        cpp_config.gate = config->gate;
+        cpp_config.threads = config->threads;
+        cpp_config.device_spikes = config->device_spikes;
+        auto result = session->cpp_session->startSpikeSorting(cpp_config);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+void cbsdk_session_stop_spike_sorting(cbsdk_session_t session) {
+    if (session && session->cpp_session) {
+        try {
+            session->cpp_session->stopSpikeSorting();
+        } catch (...) {
+            // Swallow exceptions
+        }
+    }
+}
+
+bool cbsdk_session_is_spike_sorting_running(cbsdk_session_t session) {
+    if (!session || !session->cpp_session) {
+        return false;
+    }
+    try {
+        return session->cpp_session->isSpikeSortingRunning();
+    } catch (...) {
+        return false;
+    }
+}
+
+cbsdk_result_t cbsdk_session_set_spike_sort_model(
+    cbsdk_session_t session,
+    uint32_t chan_id,
+    const float* basis,
+    uint32_t n_points,
+    const cbsdk_sort_unit_t* units,
+    uint32_t n_units,
+    const float* noise_center,
+    const float* noise_axes) {
+    if (!session || !session->cpp_session || !basis || (n_units > 0 && !units) ||
+        (noise_center && !noise_axes)) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        cbsdk::ChannelSortModel model;
+        model.basis.assign(basis, basis + size_t{n_points} * 3);
+        for (uint32_t i = 0; i < n_units; ++i) {
+            cbsdk::SortUnit unit;
+            unit.unit = units[i].unit;
+            std::copy_n(units[i].mean, 2, unit.mean);
+            std::copy_n(&units[i].inv_covariance[0][0], 4, &unit.inv_covariance[0][0]);
+            unit.log_determinant = units[i].log_determinant;
+            model.units.push_back(unit);
+        }
+        if (noise_center) {
+            model.has_noise_boundary = true;
+            std::copy_n(noise_center, 3, model.noise_center);
+            std::copy_n(noise_axes, 9, &model.noise_axes[0][0]);
+        }
+        auto result = session->cpp_session->setSpikeSortModel(chan_id, model);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_get_spike_sorting_stats(
+    cbsdk_session_t session,
+    cbsdk_spike_sorting_stats_t* stats) {
+    if (!session || !session->cpp_session || !stats) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->getSpikeSortingStats();
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        const auto& s = result.value();
+        stats->spikes_sorted = s.spikes_sorted;
+        stats->spikes_noise = s.spikes_noise;
+        stats->spikes_unsorted = s.spikes_unsorted;
+        stats->spikes_unmodelled = s.spikes_unmodelled;
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Recorded File Access
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct cbsdk_continuous_reader_impl {
+    cbsdk::ContinuousFileReader reader;
+};
+
+struct cbsdk_event_reader_impl {
+    cbsdk::EventFileReader reader;
+};
+
+/// Channel or packet id filter from a C array (empty: everything)
+static std::vector<uint16_t> id_filter(const uint16_t* ids, uint32_t n_ids) {
+    return ids ? std::vector<uint16_t>(ids, ids + n_ids) : std::vector<uint16_t>{};
+}
+
+cbsdk_result_t cbsdk_continuous_reader_open(const char* path, cbsdk_continuous_reader_t* reader) {
+    if (!path || !reader) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto opened = cbsdk::ContinuousFileReader::open(path);
+        if (opened.isError()) {
+            return CBSDK_RESULT_FILE_ERROR;
+        }
+        *reader = new cbsdk_continuous_reader_impl{std::move(opened.value())};
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+void cbsdk_continuous_reader_close(cbsdk_continuous_reader_t reader) {
+    delete reader;
+}
+
+cbsdk_result_t cbsdk_continuous_reader_get_info(
+    cbsdk_continuous_reader_t reader,
+    cbsdk_continuous_file_info_t* info) {
+    if (!reader || !info) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    const auto& r = reader->reader;
+    info->channel_count = static_cast<uint32_t>(r.channelIds().size());
+    info->sample_count = r.sampleCount();
+    info->period = r.period();
+    info->time_resolution = r.timeResolution();
+    info->segment_count = static_cast<uint32_t>(r.segments().size());
+    info->compressed = r.isCompressed();
+    return CBSDK_RESULT_SUCCESS;
+}
+
+cbsdk_result_t cbsdk_continuous_reader_get_channel_ids(
+    cbsdk_continuous_reader_t reader,
+    uint16_t* ids,
+    uint32_t* count) {
+    if (!reader || !ids || !count) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    const auto& channel_ids = reader->reader.channelIds();
+    const uint32_t n = std::min(*count, static_cast<uint32_t>(channel_ids.size()));
+    std::memcpy(ids, channel_ids.data(), n * sizeof(uint16_t));
+    *count = n;
+    return CBSDK_RESULT_SUCCESS;
+}
+
+cbsdk_result_t cbsdk_continuous_reader_find_range(
+    cbsdk_continuous_reader_t reader,
+    uint64_t t0,
+    uint64_t t1,
+    uint64_t* first,
+    uint64_t* count) {
+    if (!reader || !first || !count) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto range = reader->reader.findRange(t0, t1);
+        if (range.isError()) {
+            return CBSDK_RESULT_FILE_ERROR;
+        }
+        *first = range.value().first;
+        *count = range.value().count;
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_continuous_reader_read(
+    cbsdk_continuous_reader_t reader,
+    const uint16_t* channel_ids,
+    uint32_t n_ids,
+    uint64_t first,
+    uint64_t count,
+    int16_t* samples,
+    uint64_t* timestamps) {
+    if (!reader || (n_ids > 0 && !channel_ids)) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = reader->reader.readSamples(id_filter(channel_ids, n_ids), first,
+                                                 static_cast<size_t>(count), samples, timestamps);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INVALID_PARAMETER;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_continuous_reader_view(
+    cbsdk_continuous_reader_t reader,
+    uint64_t first,
+    uint64_t count,
+    const void** data,
+    size_t* row_stride) {
+    if (!reader || !data || !row_stride) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto view = reader->reader.view(first, static_cast<size_t>(count));
+        if (view.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        *data = view.value().data;
+        *row_stride = view.value().row_stride;
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_event_reader_open(const char* path, cbsdk_event_reader_t* reader) {
+    if (!path || !reader) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto opened = cbsdk::EventFileReader::open(path);
+        if (opened.isError()) {
+            return CBSDK_RESULT_FILE_ERROR;
+        }
+        *reader = new cbsdk_event_reader_impl{std::move(opened.value())};
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+void cbsdk_event_reader_close(cbsdk_event_reader_t reader) {
+    delete reader;
+}
+
+cbsdk_result_t cbsdk_event_reader_get_info(cbsdk_event_reader_t reader, cbsdk_event_file_info_t* info) {
+    if (!reader || !info) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    const auto& r = reader->reader;
+    info->packet_count = r.packetCount();
+    info->bytes_per_packet = r.packetSize();
+    info->time_resolution = r.timeResolution();
+    info->waveform_samples = r.waveformSamples();
+    return CBSDK_RESULT_SUCCESS;
+}
+
+cbsdk_result_t cbsdk_event_reader_find_range(
+    cbsdk_event_reader_t reader,
+    uint64_t t0,
+    uint64_t t1,
+    uint64_t* first,
+    uint64_t* count) {
+    if (!reader || !first || !count) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    const cbsdk::SampleRange range = reader->reader.findRange(t0, t1);
+    *first = range.first;
+    *count = range.count;
+    return CBSDK_RESULT_SUCCESS;
+}
+
+cbsdk_result_t cbsdk_event_reader_read(
+    cbsdk_event_reader_t reader,
+    uint64_t first,
+    uint64_t count,
+    const uint16_t* packet_ids,
+    uint32_t n_ids,
+    uint64_t* timestamps,
+    uint16_t* out_ids,
+    uint8_t* units,
+    int16_t* waveforms,
+    uint64_t* n_out) {
+    if (!reader || !n_out || (n_ids > 0 && !packet_ids)) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = reader->reader.readPackets(id_filter(packet_ids, n_ids), first, count);
+        if (result.isError()) {
+            return CBSDK_RESULT_INVALID_PARAMETER;
+        }
+        const auto& data = result.value();
+        const size_t n = data.timestamps.size();
+        if (timestamps) std::copy(data.timestamps.begin(), data.timestamps.end(), timestamps);
+        if (out_ids) std::copy(data.packet_ids.begin(), data.packet_ids.end(), out_ids);
+        if (units) std::copy(data.units.begin(), data.units.end(), units);
+        if (waveforms) std::copy(data.waveforms.begin(), data.waveforms.end(), waveforms);
+        *n_out = n;
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// AC Input Coupling
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+cbsdk_result_t cbsdk_session_set_ac_input_coupling(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    bool enabled) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->setACInputCoupling(
+            n_chans, to_cpp_channel_type(chan_type), enabled, chans);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INTERNAL_ERROR;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Spike Sorting
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+cbsdk_result_t cbsdk_session_set_spike_sorting(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    uint32_t sort_options) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->setSpikeSorting(
+            n_chans, to_cpp_channel_type(chan_type), sort_options, chans);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INTERNAL_ERROR;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_set_channel_spike_sorting(
+    cbsdk_session_t session, uint32_t chan_id, uint32_t sort_options, int auto_sync) {
+    // Use CHANSETSPK (firmware reads spkopts+spkfilter).  Earlier revisions
+    // used CHANSETSPKTHR, which only reads spkthrlevel and would silently
+    // ignore the spkopts update we want here.
+    return modify_and_send_chaninfo(session, chan_id, cbPKTTYPE_CHANSETSPK,
+        [sort_options](cbPKT_CHANINFO& ci) {
+            ci.spkopts &= ~cbAINPSPK_ALLSORT;
+            ci.spkopts |= sort_options;
+        },
+        auto_sync != 0);
+}
+
+cbsdk_result_t cbsdk_session_set_spike_extraction(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    bool enabled) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->setSpikeExtraction(
+            n_chans, to_cpp_channel_type(chan_type), enabled, chans);
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_INTERNAL_ERROR;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous Channel Configuration
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Internal operation handle (opaque to C users)
+struct cbsdk_config_op_impl {
+    cbsdk::ConfigOperation op;
+};
+
+/// Map a finished (or still pending) operation to a C result code
+static cbsdk_result_t config_op_result(const cbsdk::ConfigOperation& op, const cbsdk::Result<void>& result) {
+    if (result.isOk()) return CBSDK_RESULT_SUCCESS;
+    if (!op.done() || op.timedOut()) return CBSDK_RESULT_TIMEOUT;
+    return CBSDK_RESULT_INTERNAL_ERROR;
+}
+
+/// Shared tail of the *_async functions: attach the C callback and hand out the handle
+static cbsdk_result_t finish_async(
+    cbsdk::Result<cbsdk::ConfigOperation>&& result,
+    cbsdk_config_complete_fn callback, void* user_data, cbsdk_config_op_t* op) {
+    if (result.isError()) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+    auto& cpp_op = result.value();
+    if (callback) {
+        cpp_op.onComplete([cpp_op, callback, user_data](const cbsdk::Result<void>& r) {
+            callback(config_op_result(cpp_op, r), user_data);
+        });
+    }
+    if (op) {
+        *op = new cbsdk_config_op_impl{cpp_op};
+    }
+    return CBSDK_RESULT_SUCCESS;
+}
+
+cbsdk_result_t cbsdk_session_set_sample_group_async(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    cbproto_group_rate_t rate,
+    bool disable_others,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        return finish_async(session->cpp_session->setSampleGroupAsync(
+            n_chans, to_cpp_channel_type(chan_type), static_cast<cbsdk::SampleRate>(rate),
+            disable_others, chans, timeout_ms), callback, user_data, op);
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_set_ac_input_coupling_async(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    bool enabled,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        return finish_async(session->cpp_session->setACInputCouplingAsync(
+            n_chans, to_cpp_channel_type(chan_type), enabled, chans, timeout_ms),
+            callback, user_data, op);
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_set_spike_sorting_async(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    uint32_t sort_options,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        return finish_async(session->cpp_session->setSpikeSortingAsync(
+            n_chans, to_cpp_channel_type(chan_type), sort_options, chans, timeout_ms),
+            callback, user_data, op);
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_set_spike_extraction_async(
+    cbsdk_session_t session,
+    uint32_t n_chans,
+    const uint32_t* chans,
+    cbproto_channel_type_t chan_type,
+    bool enabled,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        return finish_async(session->cpp_session->setSpikeExtractionAsync(
+            n_chans, to_cpp_channel_type(chan_type), enabled, chans, timeout_ms),
+            callback, user_data, op);
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_set_channel_config_async(
+    cbsdk_session_t session,
+    const cbPKT_CHANINFO* chaninfo,
+    uint32_t timeout_ms,
+    cbsdk_config_complete_fn callback,
+    void* user_data,
+    cbsdk_config_op_t* op) {
+    if (!session || !session->cpp_session || !chaninfo) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        return finish_async(session->cpp_session->setChannelConfigAsync(*chaninfo, timeout_ms),
+                            callback, user_data, op);
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_config_op_wait(cbsdk_config_op_t op, uint32_t timeout_ms) {
+    if (!op) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        return config_op_result(op->op, op->op.wait(timeout_ms));
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+uint32_t cbsdk_config_op_pending_channels(cbsdk_config_op_t op) {
+    return op ? op->op.pendingChannels() : 0;
+}
+
+void cbsdk_config_op_destroy(cbsdk_config_op_t op) {
+    delete op;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Configuration Transactions
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+cbsdk_result_t cbsdk_session_begin_config_transaction(cbsdk_session_t session) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        auto result = session->cpp_session->beginConfigTransaction();
+        return result.isOk() ? CBSDK_RESULT_SUCCESS : CBSDK_RESULT_ALREADY_RUNNING;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+cbsdk_result_t cbsdk_session_commit_config_transaction(
+    cbsdk_session_t session,
+    bool skip_unchanged,
+    uint32_t timeout_ms,
+    uint32_t* n_sent,
+    uint32_t* n_skipped) {
+    if (!session || !session->cpp_session) {
+        return CBSDK_RESULT_INVALID_PARAMETER;
+    }
+    try {
+        if (!session->cpp_session->inConfigTransaction()) {
+            return CBSDK_RESULT_NOT_RUNNING;
+        }
+        auto result = session->cpp_session->commitConfigTransaction(skip_unchanged, timeout_ms);
+        if (result.isError()) {
+            return CBSDK_RESULT_INTERNAL_ERROR;
+        }
+        if (n_sent) *n_sent = static_cast<uint32_t>(result.value().sent);
+        if (n_skipped) *n_skipped = static_cast<uint32_t>(result.value().skipped);
+        return CBSDK_RESULT_SUCCESS;
+    } catch (...) {
+        return CBSDK_RESULT_INTERNAL_ERROR;
+    }
+}
+
+void cbsdk_session_abort_config_transaction(cbsdk_session_t session) {
+    if (!session || !session->cpp_session) {
+        return;
+    }
+    try {
+        session->cpp_session->abortConfigTransaction();
+    } catch (...) {
+        // Swallow exceptions
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Clock Synchronization
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,250 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   config_tracker.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Per-channel acknowledgement tracking for asynchronous configuration
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "config_tracker.h"
+#include <algorithm>
+
+namespace cbsdk {
+
+/// True for the CHANSET* family (0xC0-0xCF), whose replies are the CHANREP* family
+static bool isChanSet(const cbPKT_HEADER& hdr) {
+    return (hdr.chid & cbPKTCHAN_CONFIGURATION) && (hdr.type & 0xF0) == cbPKTTYPE_CHANSET;
+}
+
+/// The CHANREP* type the device answers a CHANSET* type with (e.g. CHANSETSMP → CHANREPSMP)
+static uint16_t replyType(const uint16_t set_type) {
+    return static_cast<uint16_t>(set_type & ~0x80);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ConfigOperation
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConfigOperation::ConfigOperation(std::shared_ptr<ConfigOperationState> state)
+    : m_state(std::move(state)) {}
+
+bool ConfigOperation::valid() const {
+    return m_state != nullptr;
+}
+
+bool ConfigOperation::done() const {
+    if (!m_state) return false;
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->done;
+}
+
+bool ConfigOperation::timedOut() const {
+    if (!m_state) return false;
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->timed_out;
+}
+
+uint32_t ConfigOperation::pendingChannels() const {
+    return m_state ? m_state->pending_channels.load(std::memory_order_acquire) : 0;
+}
+
+Result<void> ConfigOperation::wait(const uint32_t timeout_ms) const {
+    if (!m_state) {
+        return Result<void>::error("Invalid configuration operation");
+    }
+    std::unique_lock<std::mutex> lock(m_state->mutex);
+    if (!m_state->cv.wait_for(lock, std::chrono::milliseconds(timeout_ms),
+                              [this] { return m_state->done; })) {
+        return Result<void>::error("Timed out waiting for configuration (" +
+                                   std::to_string(pendingChannels()) + " channels pending)");
+    }
+    if (!m_state->error.empty()) {
+        return Result<void>::error(m_state->error);
+    }
+    return Result<void>::ok();
+}
+
+void ConfigOperation::onComplete(ConfigCompletionCallback callback) const {
+    if (!m_state || !callback) return;
+    std::unique_lock<std::mutex> lock(m_state->mutex);
+    if (!m_state->done) {
+        m_state->callbacks.push_back(std::move(callback));
+        return;
+    }
+    const auto result = m_state->error.empty() ? Result<void>::ok()
+                                               : Result<void>::error(m_state->error);
+    lock.unlock();
+    callback(result);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ConfigTracker
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+ConfigTracker::~ConfigTracker() {
+    cancelAll("Session closed");
+}
+
+ConfigOperation ConfigTracker::begin(const std::vector<cbPKT_GENERIC>& packets,
+                                     const std::chrono::milliseconds timeout) {
+    auto state = std::make_shared<ConfigOperationState>();
+    state->timeout_ms = static_cast<uint32_t>(timeout.count());
+    state->deadline = std::chrono::steady_clock::now() + timeout;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& pkt : packets) {
+        if (!isChanSet(pkt.cbpkt_header)) continue;
+        const auto& ci = reinterpret_cast<const cbPKT_CHANINFO&>(pkt);
+        if (ci.chan == 0 || ci.chan > cbMAXCHANS) continue;
+        const auto chan = static_cast<uint16_t>(ci.chan);
+        auto& expected = state->remaining[chan];
+        if (expected.empty()) {
+            state->pending_channels.fetch_add(1, std::memory_order_relaxed);
+        }
+        expected.push_back(replyType(ci.cbpkt_header.type));
+        m_inflight[chan]++;
+        m_shadow[chan] = ci;
+    }
+
+    if (state->remaining.empty()) {
+        state->done = true;  // Nothing to wait for
+    } else {
+        m_ops.push_back(state);
+        m_count.store(m_ops.size(), std::memory_order_release);
+    }
+    return ConfigOperation(std::move(state));
+}
+
+void ConfigTracker::fail(const ConfigOperation& op, const std::string& error) {
+    const auto& state = op.m_state;
+    if (!state) return;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto it = std::find(m_ops.begin(), m_ops.end(), state);
+        if (it == m_ops.end()) return;  // Already finished
+        releaseChannels(*state);
+        m_ops.erase(it);
+        m_count.store(m_ops.size(), std::memory_order_release);
+    }
+    finish(state, false, error);
+}
+
+void ConfigTracker::acknowledge(const cbPKT_CHANINFO& reply) {
+    if (m_count.load(std::memory_order_acquire) == 0) return;
+
+    StatePtr completed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (reply.chan == 0 || reply.chan > cbMAXCHANS) return;
+        const auto key = static_cast<uint16_t>(reply.chan);
+        const auto inflight = m_inflight.find(key);
+        if (inflight == m_inflight.end()) return;  // Not ours (another client, or unsolicited)
+
+        // The device applies packets in order, so a reply to one of ours belongs to the oldest
+        // operation still waiting on this channel, and is of the type it expects next.
+        const auto it = std::find_if(m_ops.begin(), m_ops.end(), [key](const StatePtr& state) {
+            const auto rem = state->remaining.find(key);
+            return rem != state->remaining.end() && !rem->second.empty();
+        });
+        if (it == m_ops.end()) return;
+        auto& expected = (*it)->remaining[key];
+        if (expected.front() != reply.cbpkt_header.type) return;  // Another client's, or unrelated
+        expected.pop_front();
+        if (expected.empty() && (*it)->pending_channels.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            completed = *it;
+            m_ops.erase(it);
+            m_count.store(m_ops.size(), std::memory_order_release);
+        }
+
+        if (--inflight->second == 0) {
+            m_inflight.erase(inflight);
+            m_shadow.erase(key);  // Cache now reflects the last change we sent
+        }
+    }
+    if (completed) {
+        finish(completed, false, {});
+    }
+}
+
+void ConfigTracker::expire() {
+    if (m_count.load(std::memory_order_acquire) == 0) return;
+
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<StatePtr> expired;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto it = m_ops.begin(); it != m_ops.end();) {
+            if ((*it)->deadline <= now) {
+                releaseChannels(**it);
+                expired.push_back(*it);
+                it = m_ops.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        m_count.store(m_ops.size(), std::memory_order_release);
+    }
+    for (const auto& state : expired) {
+        finish(state, true,
+               "Configuration not acknowledged within " + std::to_string(state->timeout_ms) +
+               " ms (" + std::to_string(state->pending_channels.load()) + " channels pending)");
+    }
+}
+
+void ConfigTracker::cancelAll(const std::string& error) {
+    std::deque<StatePtr> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        cancelled.swap(m_ops);
+        m_inflight.clear();
+        m_shadow.clear();
+        m_count.store(0, std::memory_order_release);
+    }
+    for (const auto& state : cancelled) {
+        finish(state, false, error);
+    }
+}
+
+bool ConfigTracker::shadow(const uint32_t chan, cbPKT_CHANINFO& out) const {
+    if (m_count.load(std::memory_order_acquire) == 0) return false;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_shadow.find(static_cast<uint16_t>(chan));
+    if (it == m_shadow.end()) return false;
+    out = it->second;
+    return true;
+}
+
+void ConfigTracker::releaseChannels(ConfigOperationState& state) {
+    for (const auto& [chan, expected] : state.remaining) {
+        const auto count = static_cast<uint32_t>(expected.size());
+        if (count == 0) continue;
+        const auto it = m_inflight.find(chan);
+        if (it == m_inflight.end()) continue;
+        it->second = it->second > count ? it->second - count : 0;
+        if (it->second == 0) {
+            m_inflight.erase(it);
+            m_shadow.erase(chan);
+        }
+    }
+}
+
+void ConfigTracker::finish(const StatePtr& state, const bool timed_out, const std::string& error) {
+    std::vector<ConfigCompletionCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->done) return;
+        state->done = true;
+        state->timed_out = timed_out;
+        state->error = error;
+        callbacks.swap(state->callbacks);
+    }
+    state->cv.notify_all();
+
+    const auto result = error.empty() ? Result<void>::ok() : Result<void>::error(error);
+    for (const auto& cb : callbacks) {
+        cb(result);
+    }
+}
+
+} // namespace cbsdk
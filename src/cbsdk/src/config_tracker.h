@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   config_tracker.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Per-channel acknowledgement tracking for asynchronous configuration
+///
+/// The blocking setters use a SYSREP barrier (SdkSession::sync()) to learn that the device
+/// applied a change.  The asynchronous setters instead register the CHANSET* packets they
+/// are about to send with a ConfigTracker, which expects one reply per packet and channel:
+/// the CHANREP* matching the packet's CHANSET* type.  The device applies packets in order, so
+/// a reply retires the oldest outstanding acknowledgement for its channel only if it is of
+/// the type that acknowledgement expects; other CHANREP*s (another client's changes, or
+/// replies to unrelated requests) are ignored.  An operation completes once all of its
+/// channels have been acknowledged.
+///
+/// While a channel has changes in flight, the tracker also keeps a "shadow" copy of the
+/// last chaninfo sent for it.  Later asynchronous changes seed from the shadow rather than
+/// from the (not yet updated) shared-memory cache, so pipelined changes to the same channel
+/// do not revert each other.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_CONFIG_TRACKER_H
+#define CBSDK_CONFIG_TRACKER_H
+
+#include "cbsdk/sdk_session.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace cbsdk {
+
+/// Shared state behind a ConfigOperation handle
+struct ConfigOperationState {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::unordered_map<uint16_t, std::deque<uint16_t>> remaining;  ///< chan → expected reply types,
+                                                                   ///< in send order (tracker lock)
+    std::atomic<uint32_t> pending_channels{0};         ///< Channels with remaining > 0
+    std::chrono::steady_clock::time_point deadline;
+    uint32_t timeout_ms = 0;
+    bool done = false;                                 ///< done..callbacks guarded by mutex
+    bool timed_out = false;
+    std::string error;                                 ///< Empty on success
+    std::vector<ConfigCompletionCallback> callbacks;   ///< Fired once, when done is set
+};
+
+/// Tracks in-flight asynchronous configuration operations for one SdkSession
+class ConfigTracker {
+public:
+    ConfigTracker() = default;
+    ~ConfigTracker();
+
+    ConfigTracker(const ConfigTracker&) = delete;
+    ConfigTracker& operator=(const ConfigTracker&) = delete;
+
+    /// Register packets that are about to be sent and return the operation tracking them.
+    /// Call before sending so an early CHANREP cannot be missed.  Packets that are not
+    /// CHANSET* for a valid channel are ignored; an operation with nothing to track is
+    /// returned already completed.
+    /// @param packets Outgoing CHANSET* packets
+    /// @param timeout Time allowed for every channel to be acknowledged
+    ConfigOperation begin(const std::vector<cbPKT_GENERIC>& packets, std::chrono::milliseconds timeout);
+
+    /// Fail an operation whose packets could not be sent
+    void fail(const ConfigOperation& op, const std::string& error);
+
+    /// Record a CHANREP* reply (its chan and type are used)
+    void acknowledge(const cbPKT_CHANINFO& reply);
+
+    /// Fail every operation whose deadline has passed.  Cheap when nothing is in flight.
+    void expire();
+
+    /// Fail every in-flight operation (session shutting down)
+    void cancelAll(const std::string& error);
+
+    /// Copy of the most recently sent, not yet acknowledged chaninfo for a channel
+    /// @return true if @p chan has changes in flight and @p out was filled
+    bool shadow(uint32_t chan, cbPKT_CHANINFO& out) const;
+
+    /// Number of operations in flight
+    size_t inFlight() const { return m_count.load(std::memory_order_acquire); }
+
+private:
+    using StatePtr = std::shared_ptr<ConfigOperationState>;
+
+    /// Remove @p state's outstanding acknowledgements from the per-channel counters
+    /// (m_mutex held)
+    void releaseChannels(ConfigOperationState& state);
+
+    /// Mark an operation finished and run its callbacks (m_mutex NOT held)
+    static void finish(const StatePtr& state, bool timed_out, const std::string& error);
+
+    mutable std::mutex m_mutex;
+    std::deque<StatePtr> m_ops;                          ///< In issue order
+    std::unordered_map<uint16_t, uint32_t> m_inflight;   ///< chan → outstanding acks (all ops)
+    std::unordered_map<uint16_t, cbPKT_CHANINFO> m_shadow;
+    std::atomic<size_t> m_count{0};
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_CONFIG_TRACKER_H
@@ -0,0 +1,75 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   config_transaction.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Per-channel accumulation of chaninfo edits for batched configuration
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "config_transaction.h"
+#include <cstring>
+#include <iterator>
+
+namespace cbsdk {
+
+void ConfigTransaction::stage(const uint32_t chan, ChanInfoEdit edit) {
+    if (chan == 0 || chan > cbMAXCHANS || !edit) return;
+    m_edits[chan].push_back(std::move(edit));
+}
+
+void ConfigTransaction::merge(ConfigTransaction&& other) {
+    for (auto& [chan, edits] : other.m_edits) {
+        auto& mine = m_edits[chan];
+        mine.insert(mine.end(), std::make_move_iterator(edits.begin()),
+                    std::make_move_iterator(edits.end()));
+    }
+    other.m_edits.clear();
+}
+
+std::vector<cbPKT_GENERIC> ConfigTransaction::build(
+    const ChanInfoSeed& seed, const bool skipUnchanged, size_t* skipped) const {
+    // Everything after the header: the header's type/time legitimately differ from the seed
+    constexpr size_t kBodyOffset = cbPKT_HEADER_SIZE;
+    constexpr size_t kBodySize = sizeof(cbPKT_CHANINFO) - cbPKT_HEADER_SIZE;
+
+    std::vector<cbPKT_GENERIC> packets;
+    packets.reserve(m_edits.size());
+    size_t n_skipped = 0;
+
+    for (const auto& [chan, edits] : m_edits) {
+        cbPKT_CHANINFO base;
+        if (!seed(chan, base)) continue;
+
+        cbPKT_CHANINFO ci = base;
+        ci.chan = chan;
+        uint16_t type = 0;
+        bool mixed = false;
+        for (const auto& edit : edits) {
+            edit(ci);
+            if (type == 0) {
+                type = ci.cbpkt_header.type;
+            } else if (ci.cbpkt_header.type != type) {
+                mixed = true;
+            }
+        }
+        ci.chan = chan;  // A whole-packet edit must not retarget the channel
+        ci.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+        ci.cbpkt_header.type = mixed ? cbPKTTYPE_CHANSET : type;
+
+        if (skipUnchanged &&
+            std::memcmp(reinterpret_cast<const uint8_t*>(&ci) + kBodyOffset,
+                        reinterpret_cast<const uint8_t*>(&base) + kBodyOffset, kBodySize) == 0) {
+            ++n_skipped;
+            continue;
+        }
+        cbPKT_GENERIC pkt = {};  // cbPKT_CHANINFO is shorter than cbPKT_GENERIC
+        std::memcpy(&pkt, &ci, sizeof(ci));
+        packets.push_back(pkt);
+    }
+
+    if (skipped) *skipped = n_skipped;
+    return packets;
+}
+
+} // namespace cbsdk
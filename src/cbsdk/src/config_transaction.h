@@ -0,0 +1,71 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   config_transaction.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Per-channel accumulation of chaninfo edits for batched configuration
+///
+/// Every bulk setter is expressed as a set of (channel, edit) pairs, where an edit is a
+/// function that applies one setter's field changes to a chaninfo.  Outside a transaction
+/// the edits are turned into packets immediately.  Inside one they accumulate here, and
+/// commit replays each channel's edits in order onto a single freshly seeded chaninfo, so
+/// any number of setters cost one CHANSET* per channel.
+///
+/// Edits are replayed rather than stored as pre-built packets so that commit can seed from
+/// the cache *after* its sync: fields no setter touched are never sent stale.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_CONFIG_TRANSACTION_H
+#define CBSDK_CONFIG_TRANSACTION_H
+
+#include <cbproto/cbproto.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace cbsdk {
+
+/// Applies one setter's field changes (and its preferred CHANSET* type) to a chaninfo
+using ChanInfoEdit = std::function<void(cbPKT_CHANINFO&)>;
+
+/// Seeds the chaninfo an edit list is applied to
+/// @return false if the channel has no known chaninfo (it is then skipped)
+using ChanInfoSeed = std::function<bool(uint32_t chan, cbPKT_CHANINFO& out)>;
+
+/// Ordered per-channel edit lists
+class ConfigTransaction {
+public:
+    /// Append an edit for a 1-based channel id
+    void stage(uint32_t chan, ChanInfoEdit edit);
+
+    /// Append every edit of @p other after this transaction's edits
+    void merge(ConfigTransaction&& other);
+
+    /// Whether no edits are staged
+    bool empty() const { return m_edits.empty(); }
+
+    /// Number of distinct channels with staged edits
+    size_t channelCount() const { return m_edits.size(); }
+
+    /// Build one CHANSET* packet per channel, in channel order.
+    ///
+    /// Each channel's edits are applied in staging order to its seed.  If they all chose
+    /// the same packet type that type is kept; otherwise the packet is sent as a full
+    /// cbPKTTYPE_CHANSET so the device applies every merged field.
+    ///
+    /// @param seed Supplies the starting chaninfo for each channel
+    /// @param skipUnchanged Omit channels whose merged chaninfo equals the seed
+    /// @param[out] skipped Optional count of channels omitted by @p skipUnchanged
+    std::vector<cbPKT_GENERIC> build(const ChanInfoSeed& seed, bool skipUnchanged = false,
+                                     size_t* skipped = nullptr) const;
+
+private:
+    std::map<uint32_t, std::vector<ChanInfoEdit>> m_edits;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_CONFIG_TRANSACTION_H
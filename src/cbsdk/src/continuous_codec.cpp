@@ -0,0 +1,943 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   continuous_codec.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Lossless chunked codec for continuous sample-group data
+///
+/// Chunk payload:
+/// @code
+///   timestamp stream:  uint64 base_delta, uint8 k, Rice(zigzag(delta - base_delta)) x (n - 1)
+///   uint32 channel_offsets[channel_count]   -- relative to the first channel stream
+///   channel stream:    uint8 order, uint8 k, order raw 16-bit warm-up samples,
+///                      Rice(zigzag(residual)) x (n - order)
+/// @endcode
+/// Bit streams are LSB-first.  A Rice code is q zero bits, a one bit, then the k low bits; a
+/// quotient of RICE_ESCAPE or more is written as RICE_ESCAPE zeros, a one and the raw value.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/continuous_codec.h"
+
+#include <cbutil/simd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+namespace cbsdk {
+
+namespace {
+
+/// Quotient at which a Rice code switches to a raw value
+constexpr unsigned RICE_ESCAPE = 24;
+
+/// Largest Rice parameter the encoder picks
+constexpr unsigned MAX_RICE_K = 20;
+
+/// Width of an escaped residual (order-2 residuals of int16 need 19 bits after zigzag)
+constexpr unsigned RESIDUAL_RAW_BITS = 20;
+
+/// Per-channel stream header: predictor order and Rice parameter
+constexpr size_t CHANNEL_HEADER_BYTES = 2;
+
+/// Timestamp stream header: base delta and Rice parameter
+constexpr size_t TIMESTAMP_HEADER_BYTES = sizeof(uint64_t) + 1;
+
+unsigned countTrailingZeros(const uint64_t v) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, v);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(v));
+#endif
+}
+
+/// floor(log2(v)) for v > 0
+unsigned floorLog2(uint64_t v) {
+    unsigned n = 0;
+    while (v >>= 1) {
+        ++n;
+    }
+    return n;
+}
+
+uint32_t zigzag(const int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+int32_t unzigzag(const uint32_t v) {
+    return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1);
+}
+
+uint64_t zigzag64(const int64_t v) {
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+int64_t unzigzag64(const uint64_t v) {
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+/// Rice parameter for values whose mean is @p sum / @p count (the usual k ~ log2(mean * ln 2))
+unsigned riceParameter(const uint64_t sum, const uint64_t count) {
+    if (count == 0) {
+        return 0;
+    }
+    const uint64_t scaled = sum * 69 / (count * 100);
+    return scaled == 0 ? 0 : std::min(floorLog2(scaled), MAX_RICE_K);
+}
+
+/// LSB-first bit writer into a buffer sized for the worst case
+class BitWriter {
+public:
+    explicit BitWriter(uint8_t* p) : m_p(p) {}
+
+    /// Append the low @p bits bits of @p v (bits <= 32, v < 2^bits)
+    void put(const uint64_t v, const unsigned bits) {
+        m_acc |= v << m_n;
+        m_n += bits;
+        if (m_n >= 32) {
+            const auto word = static_cast<uint32_t>(m_acc);
+            std::memcpy(m_p, &word, sizeof(word));
+            m_p += sizeof(word);
+            m_acc >>= 32;
+            m_n -= 32;
+        }
+    }
+
+    void putRice(const uint32_t v, const unsigned k, const unsigned raw_bits) {
+        const uint32_t q = v >> k;
+        if (q < RICE_ESCAPE) {
+            // Unary terminator followed by the low bits, as one code of at most 45 bits
+            const uint64_t code = (uint64_t{1} << q) | (uint64_t{v & ((uint32_t{1} << k) - 1)} << (q + 1));
+            const unsigned length = q + 1 + k;
+            if (length <= 32) {
+                put(code, length);
+            } else {
+                put(code & 0xFFFFFFFFu, 32);
+                put(code >> 32, length - 32);
+            }
+        } else {
+            put(uint64_t{1} << RICE_ESCAPE, RICE_ESCAPE + 1);
+            put(v, raw_bits);
+        }
+    }
+
+    void putRice64(const uint64_t v, const unsigned k) {
+        const uint64_t q = v >> k;
+        if (q < RICE_ESCAPE) {
+            put(uint64_t{1} << q, static_cast<unsigned>(q) + 1);
+            put(v & ((uint64_t{1} << k) - 1), k);
+        } else {
+            put(uint64_t{1} << RICE_ESCAPE, RICE_ESCAPE + 1);
+            put(v & 0xFFFFFFFFu, 32);
+            put(v >> 32, 32);
+        }
+    }
+
+    /// Write out the partial byte; @return one past the last byte written
+    uint8_t* flush() {
+        while (m_n > 0) {
+            *m_p++ = static_cast<uint8_t>(m_acc);
+            m_acc >>= 8;
+            m_n = m_n > 8 ? m_n - 8 : 0;
+        }
+        m_acc = 0;
+        return m_p;
+    }
+
+private:
+    uint8_t* m_p;
+    uint64_t m_acc = 0;
+    unsigned m_n = 0;
+};
+
+/// LSB-first bit reader; reading past @p end sets the overrun flag instead of faulting
+class BitReader {
+public:
+    BitReader(const uint8_t* p, const uint8_t* end) : m_start(p), m_p(p), m_end(end) {}
+
+    /// Make at least 56 bits available (fewer at the end of the buffer)
+    void refill() {
+        if (m_end - m_p >= 8) {
+            uint64_t word;
+            std::memcpy(&word, m_p, sizeof(word));
+            m_acc |= word << m_n;
+            m_p += (63 - m_n) >> 3;
+            m_n |= 56;
+        } else {
+            while (m_n <= 56 && m_p < m_end) {
+                m_acc |= uint64_t{*m_p++} << m_n;
+                m_n += 8;
+            }
+        }
+    }
+
+    /// Consume @p bits bits (<= 32) after a refill()
+    uint32_t get(const unsigned bits) {
+        if (bits > m_n) {
+            m_overrun = true;
+            m_acc = 0;
+            m_n = 0;
+            return 0;
+        }
+        const auto v = static_cast<uint32_t>(m_acc & ((uint64_t{1} << bits) - 1));
+        m_acc >>= bits;
+        m_n -= bits;
+        return v;
+    }
+
+    uint32_t getRice(const unsigned k, const unsigned raw_bits) {
+        refill();
+        const uint64_t window = m_acc & ((uint64_t{1} << (RICE_ESCAPE + 1)) - 1);
+        if (window == 0) {
+            m_overrun = true;
+            m_acc = 0;
+            m_n = 0;
+            return 0;
+        }
+        const unsigned q = countTrailingZeros(window);
+        get(q + 1);
+        if (q == RICE_ESCAPE) {
+            return get(raw_bits);
+        }
+        return (q << k) | get(k);
+    }
+
+    uint64_t getRice64(const unsigned k) {
+        refill();
+        const uint64_t window = m_acc & ((uint64_t{1} << (RICE_ESCAPE + 1)) - 1);
+        if (window == 0) {
+            m_overrun = true;
+            m_acc = 0;
+            m_n = 0;
+            return 0;
+        }
+        const unsigned q = countTrailingZeros(window);
+        get(q + 1);
+        refill();
+        if (q == RICE_ESCAPE) {
+            const uint64_t lo = get(32);
+            refill();
+            return lo | (uint64_t{get(32)} << 32);
+        }
+        if (k <= 32) {
+            return (uint64_t{q} << k) | get(k);
+        }
+        const uint64_t lo = get(32);
+        refill();
+        return (uint64_t{q} << k) | lo | (uint64_t{get(k - 32)} << 32);
+    }
+
+    /// @return Whether the reader ran past its end, or past @p limit bytes from its start
+    [[nodiscard]] bool overran(const size_t limit) const {
+        const auto consumed_bits = static_cast<uint64_t>(m_p - m_start) * 8 - m_n;
+        return m_overrun || consumed_bits > uint64_t{limit} * 8;
+    }
+
+private:
+    const uint8_t* m_start;
+    const uint8_t* m_p;
+    const uint8_t* m_end;
+    uint64_t m_acc = 0;
+    unsigned m_n = 0;
+    bool m_overrun = false;
+};
+
+/// Sums of |residual| of the order 0, 1 and 2 predictors over rows 2..n-1, per channel
+///
+/// Walks the chunk one row at a time across all channels, so the arithmetic runs on whole
+/// vectors of channels.
+void predictorCosts(const int16_t* frames, const uint32_t n, const uint32_t channels,
+                    uint32_t* cost0, uint32_t* cost1, uint32_t* cost2) {
+    std::fill(cost0, cost0 + channels, 0u);
+    std::fill(cost1, cost1 + channels, 0u);
+    std::fill(cost2, cost2 + channels, 0u);
+    if (n < 3) {
+        return;
+    }
+
+    uint32_t c = 0;
+#ifdef CBUTIL_HAVE_SSE2
+    const auto widen_lo = [](const __m128i v) { return _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16); };
+    const auto widen_hi = [](const __m128i v) { return _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16); };
+    const auto abs32 = [](const __m128i v) {
+        const __m128i sign = _mm_srai_epi32(v, 31);
+        return _mm_sub_epi32(_mm_xor_si128(v, sign), sign);
+    };
+    for (; c + 8 <= channels; c += 8) {
+        __m128i a0l = _mm_setzero_si128(), a0h = _mm_setzero_si128();
+        __m128i a1l = _mm_setzero_si128(), a1h = _mm_setzero_si128();
+        __m128i a2l = _mm_setzero_si128(), a2h = _mm_setzero_si128();
+        const auto load = [&](const uint32_t row) {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(frames + size_t{row} * channels + c));
+        };
+        __m128i p2 = load(0);
+        __m128i p1 = load(1);
+        __m128i p2l = widen_lo(p2), p2h = widen_hi(p2);
+        __m128i p1l = widen_lo(p1), p1h = widen_hi(p1);
+        for (uint32_t r = 2; r < n; ++r) {
+            const __m128i x = load(r);
+            const __m128i xl = widen_lo(x), xh = widen_hi(x);
+            const __m128i d1l = _mm_sub_epi32(xl, p1l), d1h = _mm_sub_epi32(xh, p1h);
+            const __m128i d2l = _mm_sub_epi32(d1l, _mm_sub_epi32(p1l, p2l));
+            const __m128i d2h = _mm_sub_epi32(d1h, _mm_sub_epi32(p1h, p2h));
+            a0l = _mm_add_epi32(a0l, abs32(xl));
+            a0h = _mm_add_epi32(a0h, abs32(xh));
+            a1l = _mm_add_epi32(a1l, abs32(d1l));
+            a1h = _mm_add_epi32(a1h, abs32(d1h));
+            a2l = _mm_add_epi32(a2l, abs32(d2l));
+            a2h = _mm_add_epi32(a2h, abs32(d2h));
+            p2l = p1l;
+            p2h = p1h;
+            p1l = xl;
+            p1h = xh;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cost0 + c), a0l);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cost0 + c + 4), a0h);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cost1 + c), a1l);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cost1 + c + 4), a1h);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cost2 + c), a2l);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(cost2 + c + 4), a2h);
+    }
+#endif
+    // Remaining channels (all of them without SSE2); the inner loop is contiguous in channels
+    // so the compiler vectorises it on other targets
+    for (uint32_t r = 2; r < n; ++r) {
+        const int16_t* x = frames + size_t{r} * channels;
+        const int16_t* p1 = x - channels;
+        const int16_t* p2 = p1 - channels;
+        for (uint32_t i = c; i < channels; ++i) {
+            const int32_t d1 = int32_t{x[i]} - p1[i];
+            const int32_t d2 = d1 - (int32_t{p1[i]} - p2[i]);
+            cost0[i] += static_cast<uint32_t>(std::abs(int32_t{x[i]}));
+            cost1[i] += static_cast<uint32_t>(std::abs(d1));
+            cost2[i] += static_cast<uint32_t>(std::abs(d2));
+        }
+    }
+}
+
+/// Copy channels [c0, c0 + count) of row-major @p frames into channel-major @p columns
+///
+/// Tiled so both sides stay in cache; the per-channel Rice coder then reads contiguous memory.
+void transpose(const int16_t* frames, const uint32_t n, const uint32_t channels, int16_t* columns) {
+    constexpr uint32_t TILE = 32;
+    for (uint32_t r0 = 0; r0 < n; r0 += TILE) {
+        const uint32_t r1 = std::min(r0 + TILE, n);
+        for (uint32_t c0 = 0; c0 < channels; c0 += TILE) {
+            const uint32_t c1 = std::min(c0 + TILE, channels);
+            for (uint32_t c = c0; c < c1; ++c) {
+                int16_t* col = columns + size_t{c} * n;
+                for (uint32_t r = r0; r < r1; ++r) {
+                    col[r] = frames[size_t{r} * channels + c];
+                }
+            }
+        }
+    }
+}
+
+/// Worst-case payload size of a chunk
+size_t maxPayloadBytes(const uint32_t n, const uint32_t channels) {
+    // Timestamp codes are at most 25 + 64 bits, residual codes at most 25 + 20 bits
+    const size_t ts = TIMESTAMP_HEADER_BYTES + size_t{n} * 12 + 8;
+    const size_t per_channel = CHANNEL_HEADER_BYTES + size_t{n} * 6 + 8;
+    return ts + size_t{channels} * (sizeof(uint32_t) + per_channel);
+}
+
+/// Encode the timestamp stream; @return one past its last byte
+uint8_t* encodeTimestamps(const uint64_t* ts, const uint32_t n, uint8_t* p) {
+    const uint64_t base = n > 1 ? (ts[n - 1] - ts[0]) / (n - 1) : 0;
+    uint64_t sum = 0;
+    for (uint32_t i = 1; i < n; ++i) {
+        sum += std::min<uint64_t>(zigzag64(static_cast<int64_t>(ts[i] - ts[i - 1] - base)), UINT32_MAX);
+    }
+    const auto k = static_cast<uint8_t>(riceParameter(sum, n > 1 ? n - 1 : 0));
+
+    std::memcpy(p, &base, sizeof(base));
+    p[sizeof(base)] = k;
+    BitWriter bits(p + TIMESTAMP_HEADER_BYTES);
+    for (uint32_t i = 1; i < n; ++i) {
+        bits.putRice64(zigzag64(static_cast<int64_t>(ts[i] - ts[i - 1] - base)), k);
+    }
+    return bits.flush();
+}
+
+/// Encode one channel's stream from its @p n contiguous samples; @return one past its last byte
+uint8_t* encodeChannel(const int16_t* x, const uint32_t n, const unsigned order, const uint64_t cost, uint8_t* p) {
+    // zigzag(e) ~ 2|e|; the costs cover rows 2..n-1
+    const unsigned k = riceParameter(2 * cost, n > 2 ? n - 2 : 0);
+    p[0] = static_cast<uint8_t>(order);
+    p[1] = static_cast<uint8_t>(k);
+    BitWriter bits(p + CHANNEL_HEADER_BYTES);
+    for (uint32_t r = 0; r < order; ++r) {
+        bits.put(static_cast<uint16_t>(x[r]), 16);
+    }
+    switch (order) {
+        case 0:
+            for (uint32_t r = 0; r < n; ++r) {
+                bits.putRice(zigzag(x[r]), k, RESIDUAL_RAW_BITS);
+            }
+            break;
+        case 1:
+            for (uint32_t r = 1; r < n; ++r) {
+                bits.putRice(zigzag(int32_t{x[r]} - x[r - 1]), k, RESIDUAL_RAW_BITS);
+            }
+            break;
+        default:
+            for (uint32_t r = 2; r < n; ++r) {
+                bits.putRice(zigzag(int32_t{x[r]} - 2 * int32_t{x[r - 1]} + x[r - 2]), k, RESIDUAL_RAW_BITS);
+            }
+            break;
+    }
+    return bits.flush();
+}
+
+/// Encode a chunk into @p scratch; @return its size
+size_t encodeChunkInto(const int16_t* frames, const uint64_t* timestamps, const uint32_t n, const uint32_t channels,
+                       const uint64_t first_sample, std::vector<uint8_t>& scratch, std::vector<uint32_t>& costs,
+                       std::vector<int16_t>& columns) {
+    const size_t bound = sizeof(ContinuousChunkHeader) + maxPayloadBytes(n, channels);
+    if (scratch.size() < bound) {
+        scratch.resize(bound);
+    }
+    costs.resize(size_t{channels} * 3);
+    uint32_t* cost0 = costs.data();
+    uint32_t* cost1 = cost0 + channels;
+    uint32_t* cost2 = cost1 + channels;
+    predictorCosts(frames, n, channels, cost0, cost1, cost2);
+    columns.resize(size_t{n} * channels);
+    transpose(frames, n, channels, columns.data());
+
+    uint8_t* const payload = scratch.data() + sizeof(ContinuousChunkHeader);
+    uint8_t* p = encodeTimestamps(timestamps, n, payload);
+    const auto timestamp_bytes = static_cast<uint32_t>(p - payload);
+
+    uint8_t* const offsets = p;
+    uint8_t* const streams = offsets + size_t{channels} * sizeof(uint32_t);
+    p = streams;
+    for (uint32_t c = 0; c < channels; ++c) {
+        const auto offset = static_cast<uint32_t>(p - streams);
+        std::memcpy(offsets + size_t{c} * sizeof(uint32_t), &offset, sizeof(offset));
+
+        unsigned order = 0;
+        uint64_t cost = cost0[c];
+        if (n > 2) {
+            if (cost1[c] < cost) {
+                order = 1;
+                cost = cost1[c];
+            }
+            if (cost2[c] < cost) {
+                order = 2;
+                cost = cost2[c];
+            }
+        }
+        p = encodeChannel(&columns[size_t{c} * n], n, order, cost, p);
+    }
+
+    ContinuousChunkHeader hdr{};
+    std::memcpy(hdr.magic, CONTINUOUS_CHUNK_MAGIC, sizeof(hdr.magic));
+    hdr.sample_count = n;
+    hdr.payload_bytes = static_cast<uint32_t>(p - payload);
+    hdr.timestamp_bytes = timestamp_bytes;
+    hdr.first_sample = first_sample;
+    hdr.first_timestamp = timestamps[0];
+    std::memcpy(scratch.data(), &hdr, sizeof(hdr));
+    return sizeof(hdr) + hdr.payload_bytes;
+}
+
+using VoidResult = cbutil::Result<void>;
+
+VoidResult decodeTimestamps(const uint8_t* p, const size_t size, const uint32_t n, const uint64_t first,
+                            uint64_t* out) {
+    if (size < TIMESTAMP_HEADER_BYTES) {
+        return VoidResult::error("Truncated timestamp stream");
+    }
+    uint64_t base;
+    std::memcpy(&base, p, sizeof(base));
+    const unsigned k = p[sizeof(base)];
+    if (k > 63) {
+        return VoidResult::error("Corrupt timestamp stream");
+    }
+    BitReader bits(p + TIMESTAMP_HEADER_BYTES, p + size);
+    uint64_t ts = first;
+    out[0] = ts;
+    for (uint32_t i = 1; i < n; ++i) {
+        ts += base + static_cast<uint64_t>(unzigzag64(bits.getRice64(k)));
+        out[i] = ts;
+    }
+    if (bits.overran(size - TIMESTAMP_HEADER_BYTES)) {
+        return VoidResult::error("Corrupt timestamp stream");
+    }
+    return VoidResult::ok();
+}
+
+VoidResult decodeChannel(const uint8_t* p, const size_t size, const uint32_t n, const uint32_t channels,
+                         const uint32_t c, int16_t* frames) {
+    if (size < CHANNEL_HEADER_BYTES) {
+        return VoidResult::error("Truncated channel stream");
+    }
+    const unsigned order = p[0];
+    const unsigned k = p[1];
+    if (order > 2 || order > n || k > MAX_RICE_K) {
+        return VoidResult::error("Corrupt channel stream");
+    }
+    BitReader bits(p + CHANNEL_HEADER_BYTES, p + size);
+    int16_t* out = frames + c;
+    int32_t p1 = 0;
+    int32_t p2 = 0;
+    for (uint32_t r = 0; r < order; ++r) {
+        bits.refill();
+        p2 = p1;
+        p1 = static_cast<int16_t>(bits.get(16));
+        out[size_t{r} * channels] = static_cast<int16_t>(p1);
+    }
+    switch (order) {
+        case 0:
+            for (uint32_t r = 0; r < n; ++r) {
+                out[size_t{r} * channels] = static_cast<int16_t>(unzigzag(bits.getRice(k, RESIDUAL_RAW_BITS)));
+            }
+            break;
+        case 1:
+            for (uint32_t r = 1; r < n; ++r) {
+                p1 += unzigzag(bits.getRice(k, RESIDUAL_RAW_BITS));
+                out[size_t{r} * channels] = static_cast<int16_t>(p1);
+            }
+            break;
+        default:
+            for (uint32_t r = 2; r < n; ++r) {
+                const int32_t x = 2 * p1 - p2 + unzigzag(bits.getRice(k, RESIDUAL_RAW_BITS));
+                p2 = p1;
+                p1 = x;
+                out[size_t{r} * channels] = static_cast<int16_t>(x);
+            }
+            break;
+    }
+    if (bits.overran(size - CHANNEL_HEADER_BYTES)) {
+        return VoidResult::error("Corrupt channel stream");
+    }
+    return VoidResult::ok();
+}
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Chunk codec
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void encodeContinuousChunk(const int16_t* frames, const uint64_t* timestamps, const uint32_t sample_count,
+                           const uint32_t channel_count, const uint64_t first_sample, std::vector<uint8_t>& out) {
+    if (!frames || !timestamps || sample_count == 0 || sample_count > CONTINUOUS_MAX_CHUNK_SAMPLES ||
+        channel_count == 0) {
+        return;
+    }
+    thread_local std::vector<uint8_t> scratch;
+    thread_local std::vector<uint32_t> costs;
+    thread_local std::vector<int16_t> columns;
+    const size_t size = encodeChunkInto(frames, timestamps, sample_count, channel_count, first_sample, scratch, costs,
+                                        columns);
+    out.insert(out.end(), scratch.begin(), scratch.begin() + static_cast<std::ptrdiff_t>(size));
+}
+
+cbutil::Result<void> decodeContinuousChunk(const uint8_t* chunk, const size_t size, const uint32_t channel_count,
+                                           int16_t* frames, uint64_t* timestamps) {
+    if (!chunk || size < sizeof(ContinuousChunkHeader)) {
+        return VoidResult::error("Truncated chunk header");
+    }
+    ContinuousChunkHeader hdr;
+    std::memcpy(&hdr, chunk, sizeof(hdr));
+    if (std::memcmp(hdr.magic, CONTINUOUS_CHUNK_MAGIC, sizeof(hdr.magic)) != 0 || hdr.sample_count == 0 ||
+        hdr.sample_count > CONTINUOUS_MAX_CHUNK_SAMPLES) {
+        return VoidResult::error("Corrupt chunk header");
+    }
+    const size_t table_bytes = size_t{channel_count} * sizeof(uint32_t);
+    if (size - sizeof(hdr) < hdr.payload_bytes || hdr.payload_bytes < size_t{hdr.timestamp_bytes} + table_bytes) {
+        return VoidResult::error("Truncated chunk");
+    }
+    const uint8_t* payload = chunk + sizeof(hdr);
+
+    if (timestamps) {
+        auto r = decodeTimestamps(payload, hdr.timestamp_bytes, hdr.sample_count, hdr.first_timestamp, timestamps);
+        if (r.isError()) {
+            return r;
+        }
+    }
+    if (!frames) {
+        return VoidResult::ok();
+    }
+
+    const uint8_t* offsets = payload + hdr.timestamp_bytes;
+    const uint8_t* streams = offsets + table_bytes;
+    const size_t streams_bytes = hdr.payload_bytes - hdr.timestamp_bytes - table_bytes;
+    for (uint32_t c = 0; c < channel_count; ++c) {
+        uint32_t begin;
+        uint32_t end = static_cast<uint32_t>(streams_bytes);
+        std::memcpy(&begin, offsets + size_t{c} * sizeof(uint32_t), sizeof(begin));
+        if (c + 1 < channel_count) {
+            std::memcpy(&end, offsets + size_t{c + 1} * sizeof(uint32_t), sizeof(end));
+        }
+        if (begin > end || end > streams_bytes) {
+            return VoidResult::error("Corrupt channel offsets");
+        }
+        auto r = decodeChannel(streams + begin, end - begin, hdr.sample_count, channel_count, c, frames);
+        if (r.isError()) {
+            return r;
+        }
+    }
+    return VoidResult::ok();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ContinuousEncoder
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ContinuousEncoder::Impl {
+    uint32_t channels = 0;
+    uint32_t chunk_samples = 0;
+    std::vector<int16_t> frames;
+    std::vector<uint64_t> timestamps;
+    uint32_t rows = 0;
+    bool finished = false;
+
+    std::vector<ContinuousChunkIndexEntry> index;
+    ContinuousCodecStats stats;
+
+    std::vector<uint8_t> scratch;
+    std::vector<uint32_t> costs;
+    std::vector<int16_t> columns;
+
+    void emit(const uint8_t* data, const size_t size, std::vector<uint8_t>& out) {
+        out.insert(out.end(), data, data + size);
+        stats.encoded_bytes += size;
+    }
+
+    void flushChunk(std::vector<uint8_t>& out) {
+        if (rows == 0) {
+            return;
+        }
+        ContinuousChunkIndexEntry entry{};
+        entry.file_offset = stats.encoded_bytes;
+        entry.first_sample = stats.samples - rows;
+        entry.first_timestamp = timestamps[0];
+        entry.last_timestamp = timestamps[rows - 1];
+        index.push_back(entry);
+
+        const size_t size = encodeChunkInto(frames.data(), timestamps.data(), rows, channels, entry.first_sample,
+                                            scratch, costs, columns);
+        emit(scratch.data(), size, out);
+        ++stats.chunks;
+        rows = 0;
+    }
+};
+
+ContinuousEncoder::ContinuousEncoder() = default;
+ContinuousEncoder::ContinuousEncoder(ContinuousEncoder&&) noexcept = default;
+ContinuousEncoder& ContinuousEncoder::operator=(ContinuousEncoder&&) noexcept = default;
+ContinuousEncoder::~ContinuousEncoder() = default;
+
+cbutil::Result<ContinuousEncoder> ContinuousEncoder::create(const std::vector<uint16_t>& channel_ids,
+                                                            const uint32_t period, const std::string& label,
+                                                            std::vector<uint8_t>& out, const uint32_t chunk_samples,
+                                                            const uint32_t time_resolution) {
+    if (channel_ids.empty()) {
+        return cbutil::Result<ContinuousEncoder>::error("No channels to encode");
+    }
+    if (chunk_samples == 0 || chunk_samples > CONTINUOUS_MAX_CHUNK_SAMPLES) {
+        return cbutil::Result<ContinuousEncoder>::error("Chunk size must be 1-" +
+                                                        std::to_string(CONTINUOUS_MAX_CHUNK_SAMPLES) + " samples");
+    }
+
+    auto impl = std::make_unique<Impl>();
+    impl->channels = static_cast<uint32_t>(channel_ids.size());
+    impl->chunk_samples = chunk_samples;
+    impl->frames.resize(size_t{chunk_samples} * impl->channels);
+    impl->timestamps.resize(chunk_samples);
+
+    const size_t ids_bytes = channel_ids.size() * sizeof(uint16_t);
+    const size_t header_size = (sizeof(ContinuousFileHeader) + ids_bytes + 7) / 8 * 8;
+    ContinuousFileHeader hdr{};
+    std::memcpy(hdr.magic, CONTINUOUS_FILE_MAGIC, sizeof(hdr.magic));
+    hdr.format_version = CONTINUOUS_FORMAT_VERSION;
+    hdr.header_size = static_cast<uint32_t>(header_size);
+    hdr.channel_count = impl->channels;
+    hdr.chunk_samples = chunk_samples;
+    hdr.period = std::max<uint32_t>(period, 1);
+    hdr.time_resolution = time_resolution;
+    std::memcpy(hdr.label, label.data(), std::min(label.size(), sizeof(hdr.label)));
+    hdr.start_unix_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+
+    std::vector<uint8_t> bytes(header_size, 0);
+    std::memcpy(bytes.data(), &hdr, sizeof(hdr));
+    std::memcpy(bytes.data() + sizeof(hdr), channel_ids.data(), ids_bytes);
+    impl->emit(bytes.data(), bytes.size(), out);
+
+    ContinuousEncoder encoder;
+    encoder.m_impl = std::move(impl);
+    return cbutil::Result<ContinuousEncoder>::ok(std::move(encoder));
+}
+
+void ContinuousEncoder::push(const uint64_t timestamp, const int16_t* frame, std::vector<uint8_t>& out) {
+    if (!m_impl || m_impl->finished || !frame) {
+        return;
+    }
+    auto& s = *m_impl;
+    std::memcpy(&s.frames[size_t{s.rows} * s.channels], frame, size_t{s.channels} * sizeof(int16_t));
+    s.timestamps[s.rows] = timestamp;
+    ++s.rows;
+    ++s.stats.samples;
+    s.stats.raw_bytes += size_t{s.channels} * sizeof(int16_t) + sizeof(uint64_t);
+    if (s.rows == s.chunk_samples) {
+        s.flushChunk(out);
+    }
+}
+
+void ContinuousEncoder::finish(std::vector<uint8_t>& out) {
+    if (!m_impl || m_impl->finished) {
+        return;
+    }
+    auto& s = *m_impl;
+    s.flushChunk(out);
+    s.finished = true;
+
+    ContinuousFileFooter footer{};
+    footer.index_offset = s.stats.encoded_bytes;
+    footer.chunk_count = s.index.size();
+    footer.sample_count = s.stats.samples;
+    std::memcpy(footer.magic, CONTINUOUS_INDEX_MAGIC, sizeof(footer.magic));
+    s.emit(reinterpret_cast<const uint8_t*>(s.index.data()), s.index.size() * sizeof(ContinuousChunkIndexEntry), out);
+    s.emit(reinterpret_cast<const uint8_t*>(&footer), sizeof(footer), out);
+}
+
+uint32_t ContinuousEncoder::channelCount() const {
+    return m_impl ? m_impl->channels : 0;
+}
+
+ContinuousCodecStats ContinuousEncoder::stats() const {
+    return m_impl ? m_impl->stats : ContinuousCodecStats{};
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ContinuousReader
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ContinuousReader::Impl {
+    std::ifstream file;
+    uint64_t file_size = 0;
+    ContinuousFileHeader header{};
+    std::vector<uint16_t> channel_ids;
+    std::vector<ContinuousChunkIndexEntry> index;
+    uint64_t sample_count = 0;
+    bool had_index = false;
+
+    // Most recently decoded chunk
+    size_t cached = SIZE_MAX;
+    std::vector<uint8_t> chunk_bytes;
+    std::vector<int16_t> frames;
+    std::vector<uint64_t> timestamps;
+
+    bool readAt(const uint64_t offset, void* dst, const size_t size) {
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(static_cast<char*>(dst), static_cast<std::streamsize>(size));
+        return static_cast<size_t>(file.gcount()) == size;
+    }
+
+    uint64_t chunkRows(const size_t i) const {
+        const uint64_t end = i + 1 < index.size() ? index[i + 1].first_sample : sample_count;
+        return end - index[i].first_sample;
+    }
+
+    /// Read and decode chunk @p i into the cache
+    VoidResult load(const size_t i, const bool with_samples) {
+        if (cached == i && (!with_samples || !frames.empty())) {
+            return VoidResult::ok();
+        }
+        ContinuousChunkHeader hdr;
+        if (!readAt(index[i].file_offset, &hdr, sizeof(hdr))) {
+            return VoidResult::error("Truncated chunk at offset " + std::to_string(index[i].file_offset));
+        }
+        chunk_bytes.resize(sizeof(hdr) + hdr.payload_bytes);
+        if (!readAt(index[i].file_offset, chunk_bytes.data(), chunk_bytes.size())) {
+            return VoidResult::error("Truncated chunk at offset " + std::to_string(index[i].file_offset));
+        }
+        if (hdr.sample_count != chunkRows(i)) {
+            return VoidResult::error("Chunk " + std::to_string(i) + " does not match the index");
+        }
+        timestamps.resize(hdr.sample_count);
+        frames.resize(with_samples ? size_t{hdr.sample_count} * header.channel_count : 0);
+        cached = SIZE_MAX;
+        auto r = decodeContinuousChunk(chunk_bytes.data(), chunk_bytes.size(), header.channel_count,
+                                       with_samples ? frames.data() : nullptr, timestamps.data());
+        if (r.isError()) {
+            return r;
+        }
+        cached = i;
+        return VoidResult::ok();
+    }
+
+    /// Rebuild the index by walking the chunk headers (file without a footer)
+    VoidResult scan() {
+        index.clear();
+        sample_count = 0;
+        uint64_t offset = header.header_size;
+        ContinuousChunkHeader hdr;
+        while (offset + sizeof(hdr) <= file_size && readAt(offset, &hdr, sizeof(hdr))) {
+            if (std::memcmp(hdr.magic, CONTINUOUS_CHUNK_MAGIC, sizeof(hdr.magic)) != 0 ||
+                hdr.first_sample != sample_count || offset + sizeof(hdr) + hdr.payload_bytes > file_size) {
+                break;  // end of the complete chunks
+            }
+            ContinuousChunkIndexEntry entry{offset, hdr.first_sample, hdr.first_timestamp, hdr.first_timestamp};
+            index.push_back(entry);
+            sample_count += hdr.sample_count;
+            if (load(index.size() - 1, false).isError()) {
+                index.pop_back();
+                sample_count -= hdr.sample_count;
+                break;
+            }
+            index.back().last_timestamp = timestamps.back();
+            offset += sizeof(hdr) + hdr.payload_bytes;
+        }
+        cached = SIZE_MAX;
+        return VoidResult::ok();
+    }
+};
+
+ContinuousReader::ContinuousReader() = default;
+ContinuousReader::ContinuousReader(ContinuousReader&&) noexcept = default;
+ContinuousReader& ContinuousReader::operator=(ContinuousReader&&) noexcept = default;
+ContinuousReader::~ContinuousReader() = default;
+
+cbutil::Result<ContinuousReader> ContinuousReader::open(const std::string& path) {
+    using R = cbutil::Result<ContinuousReader>;
+    auto impl = std::make_unique<Impl>();
+    impl->file.open(path, std::ios::binary);
+    if (!impl->file) {
+        return R::error("Failed to open " + path);
+    }
+    impl->file.seekg(0, std::ios::end);
+    impl->file_size = static_cast<uint64_t>(impl->file.tellg());
+
+    auto& hdr = impl->header;
+    if (!impl->readAt(0, &hdr, sizeof(hdr)) ||
+        std::memcmp(hdr.magic, CONTINUOUS_FILE_MAGIC, sizeof(hdr.magic)) != 0) {
+        return R::error(path + " is not a compressed continuous file");
+    }
+    if (hdr.format_version != CONTINUOUS_FORMAT_VERSION) {
+        return R::error(path + " has unsupported format version " + std::to_string(hdr.format_version));
+    }
+    if (hdr.channel_count == 0 ||
+        hdr.header_size < sizeof(hdr) + size_t{hdr.channel_count} * sizeof(uint16_t) ||
+        hdr.header_size > impl->file_size) {
+        return R::error(path + " has a corrupt header");
+    }
+    impl->channel_ids.resize(hdr.channel_count);
+    if (!impl->readAt(sizeof(hdr), impl->channel_ids.data(), impl->channel_ids.size() * sizeof(uint16_t))) {
+        return R::error(path + " has a corrupt header");
+    }
+
+    ContinuousFileFooter footer{};
+    if (impl->file_size >= hdr.header_size + sizeof(footer) &&
+        impl->readAt(impl->file_size - sizeof(footer), &footer, sizeof(footer)) &&
+        std::memcmp(footer.magic, CONTINUOUS_INDEX_MAGIC, sizeof(footer.magic)) == 0 &&
+        footer.index_offset >= hdr.header_size &&
+        footer.chunk_count <= (impl->file_size - sizeof(footer)) / sizeof(ContinuousChunkIndexEntry) &&
+        footer.index_offset + footer.chunk_count * sizeof(ContinuousChunkIndexEntry) + sizeof(footer) ==
+            impl->file_size) {
+        impl->index.resize(footer.chunk_count);
+        if (impl->readAt(footer.index_offset, impl->index.data(), impl->index.size() * sizeof(ContinuousChunkIndexEntry))) {
+            impl->sample_count = footer.sample_count;
+            impl->had_index = true;
+        }
+    }
+    if (!impl->had_index) {
+        impl->scan();
+    }
+
+    ContinuousReader reader;
+    reader.m_impl = std::move(impl);
+    return R::ok(std::move(reader));
+}
+
+const ContinuousFileHeader& ContinuousReader::header() const {
+    return m_impl->header;
+}
+
+const std::vector<uint16_t>& ContinuousReader::channelIds() const {
+    return m_impl->channel_ids;
+}
+
+uint64_t ContinuousReader::sampleCount() const {
+    return m_impl ? m_impl->sample_count : 0;
+}
+
+const std::vector<ContinuousChunkIndexEntry>& ContinuousReader::chunks() const {
+    return m_impl->index;
+}
+
+bool ContinuousReader::hadIndex() const {
+    return m_impl && m_impl->had_index;
+}
+
+cbutil::Result<void> ContinuousReader::read(uint64_t first_sample, size_t count, int16_t* samples,
+                                            uint64_t* timestamps) {
+    if (!m_impl) {
+        return VoidResult::error("Reader is not open");
+    }
+    auto& s = *m_impl;
+    if (first_sample > s.sample_count || count > s.sample_count - first_sample) {
+        return VoidResult::error("Samples " + std::to_string(first_sample) + "+" + std::to_string(count) +
+                                 " are outside the file (" + std::to_string(s.sample_count) + " samples)");
+    }
+    const size_t channels = s.header.channel_count;
+    while (count > 0) {
+        const auto it = std::upper_bound(s.index.begin(), s.index.end(), first_sample,
+            [](const uint64_t v, const ContinuousChunkIndexEntry& e) { return v < e.first_sample; });
+        const auto i = static_cast<size_t>(it - s.index.begin()) - 1;
+        auto r = s.load(i, samples != nullptr);
+        if (r.isError()) {
+            return r;
+        }
+        const auto row = static_cast<size_t>(first_sample - s.index[i].first_sample);
+        const size_t n = std::min<size_t>(count, s.timestamps.size() - row);
+        if (samples) {
+            std::memcpy(samples, &s.frames[row * channels], n * channels * sizeof(int16_t));
+            samples += n * channels;
+        }
+        if (timestamps) {
+            std::memcpy(timestamps, &s.timestamps[row], n * sizeof(uint64_t));
+            timestamps += n;
+        }
+        first_sample += n;
+        count -= n;
+    }
+    return VoidResult::ok();
+}
+
+cbutil::Result<uint64_t> ContinuousReader::sampleAtOrAfter(const uint64_t timestamp) {
+    if (!m_impl) {
+        return cbutil::Result<uint64_t>::error("Reader is not open");
+    }
+    auto& s = *m_impl;
+    const auto it = std::lower_bound(s.index.begin(), s.index.end(), timestamp,
+        [](const ContinuousChunkIndexEntry& e, const uint64_t v) { return e.last_timestamp < v; });
+    if (it == s.index.end()) {
+        return cbutil::Result<uint64_t>::ok(s.sample_count);
+    }
+    const auto i = static_cast<size_t>(it - s.index.begin());
+    auto r = s.load(i, false);
+    if (r.isError()) {
+        return cbutil::Result<uint64_t>::error(r.error());
+    }
+    const auto row = std::lower_bound(s.timestamps.begin(), s.timestamps.end(), timestamp) - s.timestamps.begin();
+    return cbutil::Result<uint64_t>::ok(s.index[i].first_sample + static_cast<uint64_t>(row));
+}
+
+} // namespace cbsdk
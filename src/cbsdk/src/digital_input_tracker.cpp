@@ -0,0 +1,157 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   digital_input_tracker.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Digital input event log with per-bit edge decoding
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/digital_input_tracker.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace cbsdk {
+
+namespace {
+
+constexpr uint64_t NONE = UINT64_MAX;
+
+/// Set bits of @p v (edge words rarely have more than one or two)
+uint64_t countBits(uint32_t v) {
+    uint64_t n = 0;
+    for (; v != 0; v &= v - 1) {
+        ++n;
+    }
+    return n;
+}
+
+} // anonymous namespace
+
+struct DigitalInputTracker::Impl {
+    struct Channel {
+        uint32_t word = 0;
+        uint64_t last = NONE;           // sequence number of its latest event
+    };
+
+    std::vector<DigitalInputEvent> log;     // event q lives in slot q % capacity
+    std::vector<uint64_t> previous;         // per slot: the channel's event before it, or NONE
+    uint64_t next = 0;                      // sequence number of the next event
+    std::vector<Channel> channels;          // index = channel ID
+    DigitalInputStats stats;
+
+    uint64_t oldest() const {
+        return next > log.size() ? next - log.size() : 0;
+    }
+
+    bool held(const uint64_t seq) const {
+        return seq != NONE && seq >= oldest();
+    }
+};
+
+DigitalInputTracker::DigitalInputTracker() = default;
+DigitalInputTracker::DigitalInputTracker(DigitalInputTracker&&) noexcept = default;
+DigitalInputTracker& DigitalInputTracker::operator=(DigitalInputTracker&&) noexcept = default;
+DigitalInputTracker::~DigitalInputTracker() = default;
+
+cbutil::Result<DigitalInputTracker> DigitalInputTracker::create(const size_t capacity) {
+    using R = cbutil::Result<DigitalInputTracker>;
+    if (capacity == 0) {
+        return R::error("Event log capacity must be positive");
+    }
+    auto impl = std::make_unique<Impl>();
+    impl->log.assign(capacity, DigitalInputEvent{});
+    impl->previous.assign(capacity, NONE);
+
+    DigitalInputTracker tracker;
+    tracker.m_impl = std::move(impl);
+    return R::ok(std::move(tracker));
+}
+
+DigitalInputEvent DigitalInputTracker::add(const uint32_t chan_id, const uint64_t time, const uint32_t value) {
+    auto& s = *m_impl;
+    if (chan_id >= s.channels.size()) {
+        s.channels.resize(chan_id + 1);
+    }
+    auto& channel = s.channels[chan_id];
+    DigitalInputEvent event;
+    event.time = time;
+    event.chan_id = chan_id;
+    event.value = value;
+    event.rising = value & ~channel.word;
+    event.falling = channel.word & ~value;
+
+    const auto slot = static_cast<size_t>(s.next % s.log.size());
+    s.log[slot] = event;
+    s.previous[slot] = channel.last;
+    channel.last = s.next++;
+    channel.word = value;
+
+    ++s.stats.events;
+    s.stats.edges_rising += countBits(event.rising);
+    s.stats.edges_falling += countBits(event.falling);
+    return event;
+}
+
+size_t DigitalInputTracker::read(uint64_t& cursor, DigitalInputEvent* out, const size_t max_events,
+                                 uint64_t* skipped) {
+    const auto& s = *m_impl;
+    const uint64_t oldest = s.oldest();
+    if (skipped) {
+        *skipped = cursor < oldest ? oldest - cursor : 0;
+    }
+    cursor = std::min(std::max(cursor, oldest), s.next);
+    const auto n = static_cast<size_t>(std::min<uint64_t>(max_events, s.next - cursor));
+    for (size_t i = 0; i < n; ++i, ++cursor) {
+        out[i] = s.log[static_cast<size_t>(cursor % s.log.size())];
+    }
+    return n;
+}
+
+size_t DigitalInputTracker::stateAt(const uint32_t chan_id, const uint64_t* times, const size_t n_times,
+                                    uint32_t* values) const {
+    const auto& s = *m_impl;
+    if (chan_id >= s.channels.size() || !s.held(s.channels[chan_id].last)) {
+        // Nothing of the channel in the log: its word has not changed since the oldest event
+        const bool exact = chan_id >= s.channels.size() || s.channels[chan_id].last == NONE;
+        std::fill_n(values, n_times, current(chan_id));
+        return exact ? n_times : 0;
+    }
+    size_t exact = 0;
+    for (size_t i = 0; i < n_times; ++i) {
+        uint64_t seq = s.channels[chan_id].last;
+        uint64_t earliest = seq;
+        while (s.held(seq) && s.log[static_cast<size_t>(seq % s.log.size())].time > times[i]) {
+            earliest = seq;
+            seq = s.previous[static_cast<size_t>(seq % s.log.size())];
+        }
+        if (s.held(seq)) {
+            values[i] = s.log[static_cast<size_t>(seq % s.log.size())].value;
+            ++exact;
+        } else {
+            const auto& first = s.log[static_cast<size_t>(earliest % s.log.size())];
+            values[i] = first.value ^ first.rising ^ first.falling;
+            exact += seq == NONE ? 1 : 0;
+        }
+    }
+    return exact;
+}
+
+uint32_t DigitalInputTracker::current(const uint32_t chan_id) const {
+    return chan_id < m_impl->channels.size() ? m_impl->channels[chan_id].word : 0;
+}
+
+uint64_t DigitalInputTracker::sequence() const {
+    return m_impl->next;
+}
+
+size_t DigitalInputTracker::capacity() const {
+    return m_impl->log.size();
+}
+
+DigitalInputStats DigitalInputTracker::stats() const {
+    return m_impl->stats;
+}
+
+} // namespace cbsdk
@@ -0,0 +1,221 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   epoch_extractor.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Peri-event epochs of continuous data
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/epoch_extractor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace cbsdk {
+
+struct EpochExtractor::Impl {
+    struct Pending {
+        EpochEvent event;
+        uint64_t trigger = 0;           // absolute row of the trigger sample
+        bool resolved = false;
+    };
+
+    EpochConfig config;
+    size_t channels = 0;
+    size_t length = 0;                  // pre + post
+    size_t capacity = 0;                // rows of history
+
+    std::vector<int16_t> ring;          // [capacity][channels]; row r lives in slot r % capacity
+    std::vector<uint64_t> ring_ts;
+    uint64_t total = 0;                 // rows written so far
+    uint64_t first = 0;                 // first row since the last clock restart
+    uint64_t last_ts = 0;
+
+    std::vector<Pending> pending;
+    std::vector<int16_t> epoch;         // [length][channels], assembled for the sink
+    std::vector<uint64_t> epoch_ts;
+    EpochStats stats;
+
+    uint64_t oldest() const {
+        return std::max(first, total > capacity ? total - capacity : 0);
+    }
+
+    /// Find the trigger sample of @p p among the rows held
+    /// @return false if the window has already left the history
+    bool resolve(Pending& p) {
+        uint64_t lo = oldest();
+        uint64_t hi = total;
+        while (lo < hi) {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            if (ring_ts[mid % capacity] < p.event.time) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo < oldest() + config.pre_samples) {
+            return false;
+        }
+        p.trigger = lo;
+        p.event.trigger_time = ring_ts[lo % capacity];
+        p.resolved = true;
+        return true;
+    }
+
+    /// Copy @p n rows starting at absolute row @p start out of the ring
+    void copyOut(const uint64_t start, const size_t n, int16_t* out, uint64_t* out_ts) const {
+        const auto slot = static_cast<size_t>(start % capacity);
+        const size_t head = std::min(n, capacity - slot);
+        std::memcpy(out, &ring[slot * channels], head * channels * sizeof(int16_t));
+        std::memcpy(out + head * channels, ring.data(), (n - head) * channels * sizeof(int16_t));
+        std::memcpy(out_ts, &ring_ts[slot], head * sizeof(uint64_t));
+        std::memcpy(out_ts + head, ring_ts.data(), (n - head) * sizeof(uint64_t));
+    }
+
+    void append(const int16_t* samples, const uint64_t* timestamps, const size_t n) {
+        const auto slot = static_cast<size_t>(total % capacity);
+        const size_t head = std::min(n, capacity - slot);
+        std::memcpy(&ring[slot * channels], samples, head * channels * sizeof(int16_t));
+        std::memcpy(ring.data(), samples + head * channels, (n - head) * channels * sizeof(int16_t));
+        std::memcpy(&ring_ts[slot], timestamps, head * sizeof(uint64_t));
+        std::memcpy(ring_ts.data(), timestamps + head, (n - head) * sizeof(uint64_t));
+        total += n;
+        last_ts = timestamps[n - 1];
+    }
+
+    /// Hand every epoch whose post window is in the history to @p sink
+    void complete(const EpochSink& sink) {
+        auto done = [&](const Pending& p) {
+            if (!p.resolved || p.trigger + config.post_samples > total) {
+                return false;
+            }
+            copyOut(p.trigger - config.pre_samples, length, epoch.data(), epoch_ts.data());
+            ++stats.epochs;
+            if (sink) {
+                sink(p.event, epoch.data(), epoch_ts.data());
+            }
+            return true;
+        };
+        pending.erase(std::remove_if(pending.begin(), pending.end(), done), pending.end());
+    }
+};
+
+EpochExtractor::EpochExtractor() = default;
+EpochExtractor::EpochExtractor(EpochExtractor&&) noexcept = default;
+EpochExtractor& EpochExtractor::operator=(EpochExtractor&&) noexcept = default;
+EpochExtractor::~EpochExtractor() = default;
+
+cbutil::Result<EpochExtractor> EpochExtractor::create(const EpochConfig& config, const size_t channel_count) {
+    using R = cbutil::Result<EpochExtractor>;
+    if (config.post_samples == 0) {
+        return R::error("Post window must hold at least one sample");
+    }
+    if (channel_count == 0 || config.max_pending == 0) {
+        return R::error("Channel count and pending events must be positive");
+    }
+    auto impl = std::make_unique<Impl>();
+    impl->config = config;
+    impl->channels = channel_count;
+    impl->length = config.pre_samples + config.post_samples;
+    impl->capacity = impl->length + config.max_delay_samples;
+    impl->ring.assign(impl->capacity * channel_count, 0);
+    impl->ring_ts.assign(impl->capacity, 0);
+    impl->pending.reserve(config.max_pending);
+    impl->epoch.assign(impl->length * channel_count, 0);
+    impl->epoch_ts.assign(impl->length, 0);
+
+    EpochExtractor extractor;
+    extractor.m_impl = std::move(impl);
+    return R::ok(std::move(extractor));
+}
+
+void EpochExtractor::addEvent(const EpochEvent& event) {
+    auto& s = *m_impl;
+    if (s.pending.size() >= s.config.max_pending) {
+        ++s.stats.events_dropped;
+        return;
+    }
+    Impl::Pending p;
+    p.event = event;
+    if (s.total > s.first && event.time <= s.last_ts && !s.resolve(p)) {
+        ++s.stats.events_late;
+        return;
+    }
+    s.pending.push_back(p);
+}
+
+void EpochExtractor::addSamples(const int16_t* samples, const uint64_t* timestamps, const size_t n_samples,
+                                const EpochSink& sink) {
+    auto& s = *m_impl;
+    s.complete(sink);   // events that arrived after their post window
+    size_t i = 0;
+    while (i < n_samples) {
+        if (s.total > s.first && timestamps[i] < s.last_ts) {
+            s.stats.events_dropped += s.pending.size();
+            s.pending.clear();
+            s.first = s.total;
+        }
+        // Stop before the next clock restart, after the next trigger sample, and at the
+        // next end of a window, so the history never overwrites a pending window
+        size_t step = 1;
+        while (i + step < n_samples && timestamps[i + step] >= timestamps[i + step - 1]) {
+            ++step;
+        }
+        for (const auto& p : s.pending) {
+            if (p.resolved) {
+                step = std::min<size_t>(step, static_cast<size_t>(p.trigger + s.config.post_samples - s.total));
+            } else {
+                for (size_t j = 0; j < step; ++j) {
+                    if (timestamps[i + j] >= p.event.time) {
+                        step = j + 1;
+                        break;
+                    }
+                }
+            }
+        }
+        s.append(samples + i * s.channels, timestamps + i, step);
+        i += step;
+        // A trigger sample just written has its window held, unless it lacks pre_samples
+        // of history before it (the first rows after creation or a clock restart)
+        size_t kept = 0;
+        for (auto& p : s.pending) {
+            if (!p.resolved && p.event.time <= s.last_ts && !s.resolve(p)) {
+                ++s.stats.events_late;
+                continue;
+            }
+            s.pending[kept++] = p;
+        }
+        s.pending.resize(kept);
+        s.complete(sink);
+    }
+}
+
+void EpochExtractor::reset() {
+    auto& s = *m_impl;
+    s.pending.clear();
+    s.first = s.total;
+}
+
+size_t EpochExtractor::epochLength() const {
+    return m_impl->length;
+}
+
+size_t EpochExtractor::pendingCount() const {
+    return m_impl->pending.size();
+}
+
+const EpochConfig& EpochExtractor::config() const {
+    return m_impl->config;
+}
+
+size_t EpochExtractor::channelCount() const {
+    return m_impl->channels;
+}
+
+EpochStats EpochExtractor::stats() const {
+    return m_impl->stats;
+}
+
+} // namespace cbsdk
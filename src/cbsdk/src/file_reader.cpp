@@ -0,0 +1,636 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   file_reader.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Memory-mapped readers for recorded continuous (NSx, cbz) and event (NEV) files
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/file_reader.h"
+#include "cbsdk/continuous_codec.h"
+#include "cbsdk/nsx_nev_format.h"
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <optional>
+
+namespace cbsdk {
+
+using namespace fileformat;
+
+namespace {
+
+template<typename T>
+T load(const uint8_t* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+/// Little-endian unsigned timestamp of 4 or 8 bytes
+uint64_t loadTimestamp(const uint8_t* p, const size_t bytes) {
+    return bytes == 4 ? load<uint32_t>(p) : load<uint64_t>(p);
+}
+
+/// File type ID of NSx 2.2/2.3 files (32-bit timestamps)
+constexpr char NSX22_FILE_TYPE_ID[8] = {'N', 'E', 'U', 'R', 'A', 'L', 'C', 'D'};
+
+/// File type ID of NEV 2.x files (32-bit timestamps)
+constexpr char NEV2_FILE_TYPE_ID[8] = {'N', 'E', 'U', 'R', 'A', 'L', 'E', 'V'};
+
+/// Rows decoded per step when copying out of a compressed file
+constexpr size_t COMPRESSED_READ_ROWS = 4096;
+
+/// Column of each requested channel id
+cbutil::Result<std::vector<size_t>> columnsOf(const std::vector<uint16_t>& wanted, const std::vector<uint16_t>& ids) {
+    std::vector<size_t> columns;
+    if (wanted.empty()) {
+        columns.resize(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i) {
+            columns[i] = i;
+        }
+        return cbutil::Result<std::vector<size_t>>::ok(std::move(columns));
+    }
+    for (const uint16_t id : wanted) {
+        const auto it = std::find(ids.begin(), ids.end(), id);
+        if (it == ids.end()) {
+            return cbutil::Result<std::vector<size_t>>::error("Channel " + std::to_string(id) + " is not in the file");
+        }
+        columns.push_back(static_cast<size_t>(it - ids.begin()));
+    }
+    return cbutil::Result<std::vector<size_t>>::ok(std::move(columns));
+}
+
+} // anonymous namespace
+
+int16_t SampleView::sample(const size_t row, const size_t channel) const {
+    return load<int16_t>(data + row * row_stride + channel * sizeof(int16_t));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ContinuousFileReader
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct ContinuousFileReader::Impl {
+    /// Where a segment's rows live in an NSx mapping
+    struct Layout {
+        uint64_t data_offset = 0;   ///< First sample of the first row
+        uint64_t row_stride = 0;
+        bool embedded = false;      ///< Each row has its own packet header and timestamp
+    };
+
+    std::optional<MappedFile> map;
+    std::optional<ContinuousReader> compressed;
+
+    std::vector<uint16_t> channel_ids;
+    std::string label;
+    uint32_t period = 1;
+    uint32_t time_resolution = 30000;
+    uint64_t sample_count = 0;
+    std::vector<ContinuousFileSegment> segments;
+    std::vector<Layout> layouts;        // parallel to segments (NSx only)
+    size_t timestamp_bytes = 8;
+
+    std::vector<int16_t> scratch;
+    std::vector<uint64_t> scratch_timestamps;
+
+    [[nodiscard]] size_t channelCount() const {
+        return channel_ids.size();
+    }
+
+    [[nodiscard]] size_t packetHeaderBytes() const {
+        return 1 + timestamp_bytes + sizeof(uint32_t);
+    }
+
+    /// Timestamp of row @p i of NSx segment @p s
+    [[nodiscard]] uint64_t timestampAt(const size_t s, const uint64_t i) const {
+        const auto& layout = layouts[s];
+        if (layout.embedded) {
+            const uint64_t at = layout.data_offset + i * layout.row_stride - timestamp_bytes - sizeof(uint32_t);
+            return loadTimestamp(map->data() + at, timestamp_bytes);
+        }
+        // Rows of a multi-sample packet are one period apart; split to keep the product in range
+        const uint64_t q = i * period;
+        return segments[s].first_timestamp + q / 30000 * time_resolution + q % 30000 * time_resolution / 30000;
+    }
+
+    /// Segment containing row @p row
+    [[nodiscard]] size_t segmentOf(const uint64_t row) const {
+        const auto it = std::upper_bound(segments.begin(), segments.end(), row,
+            [](const uint64_t v, const ContinuousFileSegment& seg) { return v < seg.first_sample; });
+        return static_cast<size_t>(it - segments.begin()) - 1;
+    }
+
+    /// Number of consecutive single-sample packets starting at @p offset
+    ///
+    /// Probes packets at doubling distances and binary-searches the first bad one, so a file of
+    /// uniform packets is indexed from O(log n) headers.  A probe is good if it is a complete
+    /// single-sample packet whose timestamp does not go backwards.
+    [[nodiscard]] uint64_t gallop(const uint64_t offset, const uint64_t stride, const uint64_t first_ts) const {
+        const uint8_t* base = map->data();
+        const uint64_t max_packets = (map->size() - offset) / stride;
+        uint64_t last_ts = first_ts;
+        const auto good = [&](const uint64_t k) {
+            const uint8_t* p = base + offset + k * stride;
+            if (p[0] != 1 || load<uint32_t>(p + 1 + timestamp_bytes) != 1) {
+                return false;
+            }
+            const uint64_t ts = loadTimestamp(p + 1, timestamp_bytes);
+            if (ts < last_ts) {
+                return false;
+            }
+            last_ts = ts;
+            return true;
+        };
+
+        uint64_t known = 1;     // packets [0, known) are good
+        uint64_t step = 1;
+        while (known < max_packets) {
+            const uint64_t probe = std::min(known + step, max_packets) - 1;
+            if (good(probe)) {
+                known = probe + 1;
+                step *= 2;
+                continue;
+            }
+            uint64_t lo = known;
+            uint64_t hi = probe;
+            while (lo < hi) {
+                const uint64_t mid = lo + (hi - lo) / 2;
+                if (good(mid)) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return lo;
+        }
+        return known;
+    }
+
+    cbutil::Result<void> indexNsx(const std::string& path) {
+        using R = cbutil::Result<void>;
+        const uint8_t* base = map->data();
+        const uint64_t size = map->size();
+        if (size < sizeof(NsxBasicHeader)) {
+            return R::error(path + " is too short for an NSx header");
+        }
+        const auto basic = load<NsxBasicHeader>(base);
+        if (std::memcmp(basic.file_type_id, NSX22_FILE_TYPE_ID, 8) == 0) {
+            timestamp_bytes = 4;
+        } else if (std::memcmp(basic.file_type_id, NSX_FILE_TYPE_ID, 8) == 0) {
+            timestamp_bytes = 8;
+        } else {
+            return R::error(path + " is not an NSx 2.2+ or compressed continuous file");
+        }
+        if (basic.channel_count == 0 || basic.time_resolution == 0 || basic.bytes_in_headers > size ||
+            sizeof(NsxBasicHeader) + uint64_t{basic.channel_count} * sizeof(NsxChannelHeader) > basic.bytes_in_headers) {
+            return R::error(path + " has a corrupt NSx header");
+        }
+        period = std::max<uint32_t>(basic.period, 1);
+        time_resolution = basic.time_resolution;
+        label.assign(basic.label, strnlen(basic.label, sizeof(basic.label)));
+        for (uint32_t i = 0; i < basic.channel_count; ++i) {
+            const uint8_t* cc = base + sizeof(NsxBasicHeader) + size_t{i} * sizeof(NsxChannelHeader);
+            channel_ids.push_back(load<uint16_t>(cc + offsetof(NsxChannelHeader, electrode_id)));
+        }
+
+        const uint64_t row_bytes = channelCount() * sizeof(int16_t);
+        const uint64_t header_bytes = packetHeaderBytes();
+        uint64_t offset = basic.bytes_in_headers;
+        while (offset + header_bytes <= size && base[offset] == 1) {
+            const uint64_t ts = loadTimestamp(base + offset + 1, timestamp_bytes);
+            const uint32_t points = load<uint32_t>(base + offset + 1 + timestamp_bytes);
+            const uint64_t data = offset + header_bytes;
+            const uint64_t available = (size - data) / row_bytes;
+            if (available == 0) {
+                break;
+            }
+
+            ContinuousFileSegment seg;
+            seg.first_sample = sample_count;
+            seg.first_timestamp = ts;
+            Layout layout;
+            layout.data_offset = data;
+            bool truncated = false;
+            if (points == 1) {
+                layout.row_stride = header_bytes + row_bytes;
+                layout.embedded = true;
+                seg.sample_count = gallop(offset, layout.row_stride, ts);
+                offset += seg.sample_count * layout.row_stride;
+            } else {
+                // Central leaves num_points at 0 when a recording is cut short: data runs to the end
+                layout.row_stride = row_bytes;
+                seg.sample_count = points == 0 ? available : std::min<uint64_t>(points, available);
+                truncated = seg.sample_count < points || points == 0;
+                offset = data + seg.sample_count * row_bytes;
+            }
+            segments.push_back(seg);
+            layouts.push_back(layout);
+            segments.back().last_timestamp = timestampAt(segments.size() - 1, seg.sample_count - 1);
+            sample_count += seg.sample_count;
+            if (truncated) {
+                break;
+            }
+        }
+        return R::ok();
+    }
+
+    void indexCompressed() {
+        const auto& reader = *compressed;
+        const auto& hdr = reader.header();
+        channel_ids = reader.channelIds();
+        label.assign(hdr.label, strnlen(hdr.label, sizeof(hdr.label)));
+        period = hdr.period;
+        time_resolution = hdr.time_resolution;
+        sample_count = reader.sampleCount();
+        const auto& chunks = reader.chunks();
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            ContinuousFileSegment seg;
+            seg.first_sample = chunks[i].first_sample;
+            seg.sample_count = (i + 1 < chunks.size() ? chunks[i + 1].first_sample : sample_count) - seg.first_sample;
+            seg.first_timestamp = chunks[i].first_timestamp;
+            seg.last_timestamp = chunks[i].last_timestamp;
+            segments.push_back(seg);
+        }
+    }
+
+    /// First row whose timestamp is >= @p t
+    cbutil::Result<uint64_t> sampleAtOrAfter(const uint64_t t) {
+        if (compressed) {
+            return compressed->sampleAtOrAfter(t);
+        }
+        const auto it = std::lower_bound(segments.begin(), segments.end(), t,
+            [](const ContinuousFileSegment& seg, const uint64_t v) { return seg.last_timestamp < v; });
+        if (it == segments.end()) {
+            return cbutil::Result<uint64_t>::ok(sample_count);
+        }
+        const auto s = static_cast<size_t>(it - segments.begin());
+        uint64_t lo = 0;
+        uint64_t hi = it->sample_count - 1;     // its last row is >= t
+        while (lo < hi) {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            if (timestampAt(s, mid) < t) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return cbutil::Result<uint64_t>::ok(it->first_sample + lo);
+    }
+};
+
+ContinuousFileReader::ContinuousFileReader() = default;
+ContinuousFileReader::ContinuousFileReader(ContinuousFileReader&&) noexcept = default;
+ContinuousFileReader& ContinuousFileReader::operator=(ContinuousFileReader&&) noexcept = default;
+ContinuousFileReader::~ContinuousFileReader() = default;
+
+cbutil::Result<ContinuousFileReader> ContinuousFileReader::open(const std::string& path) {
+    using R = cbutil::Result<ContinuousFileReader>;
+    auto mapped = MappedFile::open(path);
+    if (mapped.isError()) {
+        return R::error(mapped.error());
+    }
+
+    auto impl = std::make_unique<Impl>();
+    if (mapped.value().size() >= sizeof(CONTINUOUS_FILE_MAGIC) &&
+        std::memcmp(mapped.value().data(), CONTINUOUS_FILE_MAGIC, sizeof(CONTINUOUS_FILE_MAGIC)) == 0) {
+        // Compressed chunks are decoded, not viewed: read them through the codec's reader
+        auto reader = ContinuousReader::open(path);
+        if (reader.isError()) {
+            return R::error(reader.error());
+        }
+        impl->compressed.emplace(std::move(reader.value()));
+        impl->indexCompressed();
+    } else {
+        impl->map.emplace(std::move(mapped.value()));
+        auto indexed = impl->indexNsx(path);
+        if (indexed.isError()) {
+            return R::error(indexed.error());
+        }
+    }
+
+    ContinuousFileReader reader;
+    reader.m_impl = std::move(impl);
+    return R::ok(std::move(reader));
+}
+
+const std::vector<uint16_t>& ContinuousFileReader::channelIds() const {
+    return m_impl->channel_ids;
+}
+
+const std::string& ContinuousFileReader::label() const {
+    return m_impl->label;
+}
+
+uint32_t ContinuousFileReader::period() const {
+    return m_impl->period;
+}
+
+uint32_t ContinuousFileReader::timeResolution() const {
+    return m_impl->time_resolution;
+}
+
+uint64_t ContinuousFileReader::sampleCount() const {
+    return m_impl ? m_impl->sample_count : 0;
+}
+
+const std::vector<ContinuousFileSegment>& ContinuousFileReader::segments() const {
+    return m_impl->segments;
+}
+
+bool ContinuousFileReader::isCompressed() const {
+    return m_impl && m_impl->compressed.has_value();
+}
+
+cbutil::Result<SampleRange> ContinuousFileReader::findRange(const uint64_t t0, const uint64_t t1) {
+    using R = cbutil::Result<SampleRange>;
+    auto first = m_impl->sampleAtOrAfter(t0);
+    if (first.isError()) {
+        return R::error(first.error());
+    }
+    SampleRange range;
+    range.first = first.value();
+    if (t1 > t0) {
+        auto end = m_impl->sampleAtOrAfter(t1);
+        if (end.isError()) {
+            return R::error(end.error());
+        }
+        range.count = end.value() - range.first;
+    }
+    return R::ok(range);
+}
+
+cbutil::Result<SampleView> ContinuousFileReader::view(const uint64_t first, const size_t count) {
+    using R = cbutil::Result<SampleView>;
+    auto& s = *m_impl;
+    if (s.compressed) {
+        return R::error("Compressed files have no zero-copy views; use readSamples()");
+    }
+    if (first > s.sample_count || count > s.sample_count - first) {
+        return R::error("Samples " + std::to_string(first) + "+" + std::to_string(count) + " are outside the file");
+    }
+    SampleView v;
+    v.channel_count = s.channelCount();
+    v.rows = count;
+    if (count == 0) {
+        return R::ok(v);
+    }
+    const size_t seg = s.segmentOf(first);
+    const auto& segment = s.segments[seg];
+    if (first + count > segment.first_sample + segment.sample_count) {
+        return R::error("Samples " + std::to_string(first) + "+" + std::to_string(count) +
+                        " span segments " + std::to_string(seg) + "+; read them with readSamples()");
+    }
+    v.row_stride = s.layouts[seg].row_stride;
+    v.data = s.map->data() + s.layouts[seg].data_offset + (first - segment.first_sample) * v.row_stride;
+    return R::ok(v);
+}
+
+cbutil::Result<void> ContinuousFileReader::readSamples(const std::vector<uint16_t>& channel_ids, uint64_t first,
+                                                       size_t count, int16_t* samples, uint64_t* timestamps) {
+    using R = cbutil::Result<void>;
+    auto& s = *m_impl;
+    if (first > s.sample_count || count > s.sample_count - first) {
+        return R::error("Samples " + std::to_string(first) + "+" + std::to_string(count) +
+                        " are outside the file (" + std::to_string(s.sample_count) + " samples)");
+    }
+    auto columns_result = columnsOf(channel_ids, s.channel_ids);
+    if (columns_result.isError()) {
+        return R::error(columns_result.error());
+    }
+    const auto& columns = columns_result.value();
+    const size_t channels = s.channelCount();
+    const bool all_columns = channel_ids.empty();
+
+    if (s.compressed) {
+        while (count > 0) {
+            const size_t n = std::min(count, COMPRESSED_READ_ROWS);
+            s.scratch.resize(n * channels);
+            auto r = s.compressed->read(first, n, samples ? s.scratch.data() : nullptr, timestamps);
+            if (r.isError()) {
+                return r;
+            }
+            if (samples) {
+                for (size_t row = 0; row < n; ++row) {
+                    const int16_t* src = &s.scratch[row * channels];
+                    for (const size_t c : columns) {
+                        *samples++ = src[c];
+                    }
+                }
+            }
+            if (timestamps) {
+                timestamps += n;
+            }
+            first += n;
+            count -= n;
+        }
+        return R::ok();
+    }
+
+    const uint8_t* base = s.map->data();
+    size_t seg = count > 0 ? s.segmentOf(first) : 0;
+    while (count > 0) {
+        const auto& segment = s.segments[seg];
+        const auto& layout = s.layouts[seg];
+        const uint64_t offset = first - segment.first_sample;
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(count, segment.sample_count - offset));
+        const uint8_t* row_ptr = base + layout.data_offset + offset * layout.row_stride;
+        if (samples) {
+            if (all_columns && !layout.embedded) {
+                std::memcpy(samples, row_ptr, n * channels * sizeof(int16_t));
+                samples += n * channels;
+            } else if (all_columns) {
+                for (size_t row = 0; row < n; ++row, row_ptr += layout.row_stride) {
+                    std::memcpy(samples, row_ptr, channels * sizeof(int16_t));
+                    samples += channels;
+                }
+            } else {
+                for (size_t row = 0; row < n; ++row, row_ptr += layout.row_stride) {
+                    for (const size_t c : columns) {
+                        *samples++ = load<int16_t>(row_ptr + c * sizeof(int16_t));
+                    }
+                }
+            }
+        }
+        if (timestamps) {
+            for (size_t row = 0; row < n; ++row) {
+                *timestamps++ = s.timestampAt(seg, offset + row);
+            }
+        }
+        first += n;
+        count -= n;
+        ++seg;
+    }
+    return R::ok();
+}
+
+cbutil::Result<ContinuousData> ContinuousFileReader::read(const std::vector<uint16_t>& channel_ids, const uint64_t t0,
+                                                          const uint64_t t1) {
+    using R = cbutil::Result<ContinuousData>;
+    auto range = findRange(t0, t1);
+    if (range.isError()) {
+        return R::error(range.error());
+    }
+    ContinuousData data;
+    data.channel_ids = channel_ids.empty() ? m_impl->channel_ids : channel_ids;
+    data.timestamps.resize(range.value().count);
+    data.samples.resize(range.value().count * data.channel_ids.size());
+    auto r = readSamples(channel_ids, range.value().first, range.value().count, data.samples.data(),
+                         data.timestamps.data());
+    if (r.isError()) {
+        return R::error(r.error());
+    }
+    return R::ok(std::move(data));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// EventFileReader
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct EventFileReader::Impl {
+    MappedFile map;
+    uint64_t packets_offset = 0;
+    uint32_t packet_size = 0;
+    uint32_t time_resolution = 30000;
+    size_t timestamp_bytes = 8;
+    uint64_t packet_count = 0;
+    std::vector<uint64_t> sparse;       // timestamp of every INDEX_STRIDE-th packet
+
+    explicit Impl(MappedFile&& m) : map(std::move(m)) {}
+
+    [[nodiscard]] const uint8_t* packet(const uint64_t i) const {
+        return map.data() + packets_offset + i * packet_size;
+    }
+
+    [[nodiscard]] uint64_t timestamp(const uint64_t i) const {
+        return loadTimestamp(packet(i), timestamp_bytes);
+    }
+
+    /// First packet whose timestamp is >= @p t
+    [[nodiscard]] uint64_t lowerBound(const uint64_t t) const {
+        // sparse[j - 1] < t <= sparse[j] puts the answer in ((j - 1) * stride, j * stride]
+        const auto j = static_cast<uint64_t>(std::lower_bound(sparse.begin(), sparse.end(), t) - sparse.begin());
+        uint64_t lo = j == 0 ? 0 : (j - 1) * INDEX_STRIDE;
+        uint64_t hi = std::min(j * INDEX_STRIDE, packet_count);
+        while (lo < hi) {
+            const uint64_t mid = lo + (hi - lo) / 2;
+            if (timestamp(mid) < t) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+};
+
+EventFileReader::EventFileReader() = default;
+EventFileReader::EventFileReader(EventFileReader&&) noexcept = default;
+EventFileReader& EventFileReader::operator=(EventFileReader&&) noexcept = default;
+EventFileReader::~EventFileReader() = default;
+
+cbutil::Result<EventFileReader> EventFileReader::open(const std::string& path) {
+    using R = cbutil::Result<EventFileReader>;
+    auto mapped = MappedFile::open(path);
+    if (mapped.isError()) {
+        return R::error(mapped.error());
+    }
+    auto impl = std::make_unique<Impl>(std::move(mapped.value()));
+    const uint64_t size = impl->map.size();
+    if (size < sizeof(NevBasicHeader)) {
+        return R::error(path + " is too short for a NEV header");
+    }
+    const auto basic = load<NevBasicHeader>(impl->map.data());
+    if (std::memcmp(basic.file_type_id, NEV2_FILE_TYPE_ID, 8) == 0) {
+        impl->timestamp_bytes = 4;
+    } else if (std::memcmp(basic.file_type_id, NEV_FILE_TYPE_ID, 8) == 0) {
+        impl->timestamp_bytes = 8;
+    } else {
+        return R::error(path + " is not a NEV file");
+    }
+    if (basic.bytes_per_packet < impl->timestamp_bytes + 4 || basic.bytes_in_headers > size ||
+        basic.time_resolution == 0) {
+        return R::error(path + " has a corrupt NEV header");
+    }
+    impl->packets_offset = basic.bytes_in_headers;
+    impl->packet_size = basic.bytes_per_packet;
+    impl->time_resolution = basic.time_resolution;
+    impl->packet_count = (size - impl->packets_offset) / impl->packet_size;
+    for (uint64_t i = 0; i < impl->packet_count; i += INDEX_STRIDE) {
+        impl->sparse.push_back(impl->timestamp(i));
+    }
+
+    EventFileReader reader;
+    reader.m_impl = std::move(impl);
+    return R::ok(std::move(reader));
+}
+
+uint64_t EventFileReader::packetCount() const {
+    return m_impl ? m_impl->packet_count : 0;
+}
+
+uint32_t EventFileReader::packetSize() const {
+    return m_impl->packet_size;
+}
+
+uint32_t EventFileReader::waveformSamples() const {
+    return static_cast<uint32_t>((m_impl->packet_size - m_impl->timestamp_bytes - 4) / sizeof(int16_t));
+}
+
+uint32_t EventFileReader::timeResolution() const {
+    return m_impl->time_resolution;
+}
+
+uint64_t EventFileReader::timestamp(const uint64_t index) const {
+    return m_impl->timestamp(index);
+}
+
+const uint8_t* EventFileReader::packet(const uint64_t index) const {
+    return m_impl->packet(index);
+}
+
+SampleRange EventFileReader::findRange(const uint64_t t0, const uint64_t t1) const {
+    SampleRange range;
+    range.first = m_impl->lowerBound(t0);
+    if (t1 > t0) {
+        range.count = m_impl->lowerBound(t1) - range.first;
+    }
+    return range;
+}
+
+cbutil::Result<EventData> EventFileReader::readPackets(const std::vector<uint16_t>& packet_ids, const uint64_t first,
+                                                       const uint64_t count) const {
+    using R = cbutil::Result<EventData>;
+    const auto& s = *m_impl;
+    if (first > s.packet_count || count > s.packet_count - first) {
+        return R::error("Packets " + std::to_string(first) + "+" + std::to_string(count) + " are outside the file");
+    }
+    const size_t words = waveformSamples();
+    const size_t id_offset = s.timestamp_bytes;
+    EventData data;
+    for (uint64_t i = first; i < first + count; ++i) {
+        const uint8_t* p = s.packet(i);
+        const auto id = load<uint16_t>(p + id_offset);
+        if (!packet_ids.empty() && std::find(packet_ids.begin(), packet_ids.end(), id) == packet_ids.end()) {
+            continue;
+        }
+        data.timestamps.push_back(loadTimestamp(p, s.timestamp_bytes));
+        data.packet_ids.push_back(id);
+        data.units.push_back(p[id_offset + 2]);
+        const size_t at = data.waveforms.size();
+        data.waveforms.resize(at + words);
+        std::memcpy(&data.waveforms[at], p + id_offset + 4, words * sizeof(int16_t));
+    }
+    return R::ok(std::move(data));
+}
+
+EventData EventFileReader::read(const std::vector<uint16_t>& packet_ids, const uint64_t t0, const uint64_t t1) const {
+    const auto range = findRange(t0, t1);
+    auto data = readPackets(packet_ids, range.first, range.count);
+    return data.isOk() ? std::move(data.value()) : EventData{};
+}
+
+} // namespace cbsdk
@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   filter_bank.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Biquad filter design and the streaming filter bank
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/filter_bank.h"
+
+#include <cbutil/simd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <string>
+
+namespace cbsdk {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+/// Channels per SIMD step; state rows are padded to a multiple of this
+constexpr size_t LANES = 2;
+
+/// MXCSR flush-to-zero and denormals-are-zero bits
+constexpr unsigned MXCSR_FTZ_DAZ = 0x8040;
+
+Biquad normalized(const double b0, const double b1, const double b2, const double a0, const double a1,
+                  const double a2) {
+    Biquad q;
+    q.b0 = b0 / a0;
+    q.b1 = b1 / a0;
+    q.b2 = b2 / a0;
+    q.a1 = a1 / a0;
+    q.a2 = a2 / a0;
+    return q;
+}
+
+bool isButterworth(const uint32_t type) {
+    return type == 0 || (type & cbFILTTYPE_BUTTERWORTH) != 0;
+}
+
+/// Append a Butterworth high- or low-pass of @p order at @p corner_hz
+void appendButterworth(std::vector<Biquad>& out, const uint32_t order, const double corner_hz,
+                       const double sample_rate_hz, const bool highpass) {
+    const double w0 = 2.0 * PI * corner_hz / sample_rate_hz;
+    const double cos_w0 = std::cos(w0);
+    const double sin_w0 = std::sin(w0);
+
+    // Conjugate pole pairs; their Q follows from the pole angles on the Butterworth circle
+    for (uint32_t k = 1; k <= order / 2; ++k) {
+        const double q = 1.0 / (2.0 * std::sin((2.0 * k - 1.0) * PI / (2.0 * order)));
+        const double alpha = sin_w0 / (2.0 * q);
+        if (highpass) {
+            const double b = (1.0 + cos_w0) / 2.0;
+            out.push_back(normalized(b, -2.0 * b, b, 1.0 + alpha, -2.0 * cos_w0, 1.0 - alpha));
+        } else {
+            const double b = (1.0 - cos_w0) / 2.0;
+            out.push_back(normalized(b, 2.0 * b, b, 1.0 + alpha, -2.0 * cos_w0, 1.0 - alpha));
+        }
+    }
+
+    // The real pole of an odd order
+    if (order % 2 == 1) {
+        const double k = std::tan(w0 / 2.0);
+        Biquad q;
+        q.a1 = (k - 1.0) / (k + 1.0);
+        q.b0 = highpass ? 1.0 / (1.0 + k) : k / (1.0 + k);
+        q.b1 = highpass ? -q.b0 : q.b0;
+        out.push_back(q);
+    }
+}
+
+cbutil::Result<void> checkStage(const char* name, const uint32_t freq_mhz, const uint32_t order, const uint32_t type,
+                                const double sample_rate_hz) {
+    using R = cbutil::Result<void>;
+    if (order == 0 || order > FILTER_MAX_ORDER) {
+        return R::error(std::string(name) + " order must be 1-" + std::to_string(FILTER_MAX_ORDER));
+    }
+    if (!isButterworth(type)) {
+        return R::error(std::string(name) + " type must be Butterworth");
+    }
+    if (freq_mhz / 1000.0 >= sample_rate_hz / 2.0) {
+        return R::error(std::string(name) + " corner must be below " + std::to_string(sample_rate_hz / 2.0) + " Hz");
+    }
+    return R::ok();
+}
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Design
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+FilterSpec FilterSpec::fromFiltInfo(const cbPKT_FILTINFO& info) {
+    FilterSpec spec;
+    spec.hpfreq = info.hpfreq;
+    spec.hporder = info.hporder;
+    spec.hptype = info.hptype;
+    spec.lpfreq = info.lpfreq;
+    spec.lporder = info.lporder;
+    spec.lptype = info.lptype;
+    spec.notch_freq = 0;
+    return spec;
+}
+
+cbutil::Result<std::vector<Biquad>> designFilter(const FilterSpec& spec, const double sample_rate_hz) {
+    using R = cbutil::Result<std::vector<Biquad>>;
+    if (!(sample_rate_hz > 0.0)) {
+        return R::error("Sample rate must be positive");
+    }
+    std::vector<Biquad> sections;
+    if (spec.hpfreq != 0) {
+        auto ok = checkStage("High-pass", spec.hpfreq, spec.hporder, spec.hptype, sample_rate_hz);
+        if (ok.isError()) {
+            return R::error(ok.error());
+        }
+        appendButterworth(sections, spec.hporder, spec.hpfreq / 1000.0, sample_rate_hz, true);
+    }
+    if (spec.lpfreq != 0) {
+        auto ok = checkStage("Low-pass", spec.lpfreq, spec.lporder, spec.lptype, sample_rate_hz);
+        if (ok.isError()) {
+            return R::error(ok.error());
+        }
+        appendButterworth(sections, spec.lporder, spec.lpfreq / 1000.0, sample_rate_hz, false);
+    }
+    if (spec.notch_freq != 0) {
+        const double f0 = spec.notch_freq / 1000.0;
+        if (f0 >= sample_rate_hz / 2.0 || spec.notch_bandwidth == 0) {
+            return R::error("Notch must be below Nyquist with a non-zero bandwidth");
+        }
+        const double w0 = 2.0 * PI * f0 / sample_rate_hz;
+        const double alpha = std::sin(w0) * spec.notch_bandwidth / (2.0 * spec.notch_freq);   // sin(w0) / 2Q
+        const double cos_w0 = std::cos(w0);
+        sections.push_back(normalized(1.0, -2.0 * cos_w0, 1.0, 1.0 + alpha, -2.0 * cos_w0, 1.0 - alpha));
+    }
+    return R::ok(std::move(sections));
+}
+
+double filterMagnitude(const std::vector<Biquad>& sections, const double freq_hz, const double sample_rate_hz) {
+    const std::complex<double> z1 = std::polar(1.0, -2.0 * PI * freq_hz / sample_rate_hz);
+    const std::complex<double> z2 = z1 * z1;
+    std::complex<double> h = 1.0;
+    for (const auto& q : sections) {
+        h *= (q.b0 + q.b1 * z1 + q.b2 * z2) / (1.0 + q.a1 * z1 + q.a2 * z2);
+    }
+    return std::abs(h);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// BiquadFilterBank
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct BiquadFilterBank::Impl {
+    std::vector<Biquad> sections;
+    size_t channels = 0;
+    size_t padded = 0;              // channels rounded up to LANES
+    std::vector<double> z1;         // [section][padded]: transposed direct form II state
+    std::vector<double> z2;
+    std::vector<double> work;       // [padded]: the sample being filtered
+
+    /// Run every section over work[] in place
+    void filterRow() {
+        double* w = work.data();
+        for (size_t s = 0; s < sections.size(); ++s) {
+            const Biquad& q = sections[s];
+            double* s1 = &z1[s * padded];
+            double* s2 = &z2[s * padded];
+#ifdef CBUTIL_HAVE_SSE2
+            const __m128d b0 = _mm_set1_pd(q.b0);
+            const __m128d b1 = _mm_set1_pd(q.b1);
+            const __m128d b2 = _mm_set1_pd(q.b2);
+            const __m128d a1 = _mm_set1_pd(q.a1);
+            const __m128d a2 = _mm_set1_pd(q.a2);
+            for (size_t c = 0; c < padded; c += LANES) {
+                const __m128d x = _mm_loadu_pd(w + c);
+                const __m128d y = _mm_add_pd(_mm_mul_pd(b0, x), _mm_loadu_pd(s1 + c));
+                _mm_storeu_pd(s1 + c, _mm_add_pd(_mm_sub_pd(_mm_mul_pd(b1, x), _mm_mul_pd(a1, y)),
+                                                 _mm_loadu_pd(s2 + c)));
+                _mm_storeu_pd(s2 + c, _mm_sub_pd(_mm_mul_pd(b2, x), _mm_mul_pd(a2, y)));
+                _mm_storeu_pd(w + c, y);
+            }
+#else
+            for (size_t c = 0; c < padded; ++c) {
+                const double x = w[c];
+                const double y = q.b0 * x + s1[c];
+                s1[c] = q.b1 * x - q.a1 * y + s2[c];
+                s2[c] = q.b2 * x - q.a2 * y;
+                w[c] = y;
+            }
+#endif
+        }
+    }
+
+    template<typename Store>
+    void run(const int16_t* in, const size_t n_samples, Store&& store) {
+#ifdef CBUTIL_HAVE_SSE2
+        // A channel that goes quiet decays its state into denormals, which are very slow
+        const unsigned csr = _mm_getcsr();
+        _mm_setcsr(csr | MXCSR_FTZ_DAZ);
+#endif
+        for (size_t r = 0; r < n_samples; ++r) {
+            const int16_t* x = in + r * channels;
+            for (size_t c = 0; c < channels; ++c) {
+                work[c] = x[c];
+            }
+            filterRow();
+            store(r);
+        }
+#ifdef CBUTIL_HAVE_SSE2
+        _mm_setcsr(csr);
+#endif
+    }
+};
+
+BiquadFilterBank::BiquadFilterBank() = default;
+BiquadFilterBank::BiquadFilterBank(BiquadFilterBank&&) noexcept = default;
+BiquadFilterBank& BiquadFilterBank::operator=(BiquadFilterBank&&) noexcept = default;
+BiquadFilterBank::~BiquadFilterBank() = default;
+
+cbutil::Result<BiquadFilterBank> BiquadFilterBank::create(std::vector<Biquad> sections, const size_t channel_count) {
+    if (channel_count == 0) {
+        return cbutil::Result<BiquadFilterBank>::error("Filter bank needs at least one channel");
+    }
+    auto impl = std::make_unique<Impl>();
+    impl->sections = std::move(sections);
+    impl->channels = channel_count;
+    impl->padded = (channel_count + LANES - 1) / LANES * LANES;
+    impl->z1.assign(impl->sections.size() * impl->padded, 0.0);
+    impl->z2.assign(impl->sections.size() * impl->padded, 0.0);
+    impl->work.assign(impl->padded, 0.0);
+
+    BiquadFilterBank bank;
+    bank.m_impl = std::move(impl);
+    return cbutil::Result<BiquadFilterBank>::ok(std::move(bank));
+}
+
+void BiquadFilterBank::process(const int16_t* in, const size_t n_samples, int16_t* out) {
+    auto& s = *m_impl;
+    s.run(in, n_samples, [&](const size_t r) {
+        int16_t* y = out + r * s.channels;
+        for (size_t c = 0; c < s.channels; ++c) {
+            const double v = std::min(std::max(s.work[c], -32768.0), 32767.0);
+            y[c] = static_cast<int16_t>(v < 0.0 ? v - 0.5 : v + 0.5);
+        }
+    });
+}
+
+void BiquadFilterBank::process(const int16_t* in, const size_t n_samples, float* out) {
+    auto& s = *m_impl;
+    s.run(in, n_samples, [&](const size_t r) {
+        float* y = out + r * s.channels;
+        for (size_t c = 0; c < s.channels; ++c) {
+            y[c] = static_cast<float>(s.work[c]);
+        }
+    });
+}
+
+void BiquadFilterBank::reset() {
+    std::fill(m_impl->z1.begin(), m_impl->z1.end(), 0.0);
+    std::fill(m_impl->z2.begin(), m_impl->z2.end(), 0.0);
+}
+
+size_t BiquadFilterBank::channelCount() const {
+    return m_impl->channels;
+}
+
+const std::vector<Biquad>& BiquadFilterBank::sections() const {
+    return m_impl->sections;
+}
+
+} // namespace cbsdk
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   mapped_file.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Read-only memory mapping of a whole file (mmap / MapViewOfFile)
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Platform headers MUST be included first
+#include "platform_first.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #include <errno.h>
+#endif
+
+#include "mapped_file.h"
+#include <cstring>
+
+namespace cbsdk {
+
+struct MappedFile::Impl {
+    const uint8_t* data = nullptr;
+    uint64_t size = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+
+    ~Impl() {
+#ifdef _WIN32
+        if (data) {
+            UnmapViewOfFile(data);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+#else
+        if (data) {
+            munmap(const_cast<uint8_t*>(data), static_cast<size_t>(size));
+        }
+#endif
+    }
+};
+
+MappedFile::MappedFile() = default;
+MappedFile::MappedFile(MappedFile&&) noexcept = default;
+MappedFile& MappedFile::operator=(MappedFile&&) noexcept = default;
+MappedFile::~MappedFile() = default;
+
+cbutil::Result<MappedFile> MappedFile::open(const std::string& path) {
+    using R = cbutil::Result<MappedFile>;
+    auto impl = std::make_unique<Impl>();
+
+#ifdef _WIN32
+    impl->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (impl->file == INVALID_HANDLE_VALUE) {
+        return R::error("Failed to open " + path + " (err=" + std::to_string(GetLastError()) + ")");
+    }
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(impl->file, &size)) {
+        return R::error("Failed to stat " + path + " (err=" + std::to_string(GetLastError()) + ")");
+    }
+    impl->size = static_cast<uint64_t>(size.QuadPart);
+    if (impl->size > 0) {
+        impl->mapping = CreateFileMappingA(impl->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!impl->mapping) {
+            return R::error("Failed to map " + path + " (err=" + std::to_string(GetLastError()) + ")");
+        }
+        impl->data = static_cast<const uint8_t*>(MapViewOfFile(impl->mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!impl->data) {
+            return R::error("Failed to map " + path + " (err=" + std::to_string(GetLastError()) + ")");
+        }
+    }
+#else
+    int flags = O_RDONLY;
+#ifdef O_CLOEXEC
+    flags |= O_CLOEXEC;
+#endif
+    const int fd = ::open(path.c_str(), flags);
+    if (fd < 0) {
+        return R::error("Failed to open " + path + ": " + strerror(errno));
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0) {
+        const int err = errno;
+        ::close(fd);
+        return R::error("Failed to stat " + path + ": " + strerror(err));
+    }
+    impl->size = static_cast<uint64_t>(st.st_size);
+    if (impl->size > 0) {
+        void* p = mmap(nullptr, static_cast<size_t>(impl->size), PROT_READ, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            const int err = errno;
+            ::close(fd);
+            return R::error("Failed to map " + path + ": " + strerror(err));
+        }
+        impl->data = static_cast<const uint8_t*>(p);
+    }
+    ::close(fd);   // the mapping keeps the file open
+#endif
+
+    MappedFile file;
+    file.m_impl = std::move(impl);
+    return R::ok(std::move(file));
+}
+
+const uint8_t* MappedFile::data() const {
+    return m_impl ? m_impl->data : nullptr;
+}
+
+uint64_t MappedFile::size() const {
+    return m_impl ? m_impl->size : 0;
+}
+
+} // namespace cbsdk
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   mapped_file.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Read-only memory mapping of a whole file
+///
+/// Pages are faulted in on first access, so opening a multi-gigabyte recording costs nothing
+/// until data is read, and several readers of the same file share the page cache.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_MAPPED_FILE_H
+#define CBSDK_MAPPED_FILE_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cbsdk {
+
+class MappedFile {
+public:
+    /// Map @p path read-only (an empty file maps to a null pointer and size 0)
+    static cbutil::Result<MappedFile> open(const std::string& path);
+
+    MappedFile(MappedFile&&) noexcept;
+    MappedFile& operator=(MappedFile&&) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Unmaps the file; pointers into it become invalid
+    ~MappedFile();
+
+    /// @return First byte of the mapping
+    [[nodiscard]] const uint8_t* data() const;
+
+    /// @return File size in bytes
+    [[nodiscard]] uint64_t size() const;
+
+private:
+    MappedFile();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsdk
+
+#endif // CBSDK_MAPPED_FILE_H
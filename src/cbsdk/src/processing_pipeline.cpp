@@ -0,0 +1,624 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   processing_pipeline.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Host-side batch stages of an SdkSession
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Platform headers MUST be included first (before cbproto)
+#include "platform_first.h"
+
+#include "processing_pipeline.h"
+#include <cbproto/packet_traits.h>
+
+namespace cbsdk {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Stages
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Whether @p chid (1-based) is a digital or serial input, per @p types
+static bool isDigitalInput(const ChannelTypeTable* types, const uint16_t chid) {
+    if (!types || chid < 1 || chid > cbMAXCHANS) return false;
+    const ChannelType type = (*types)[chid - 1];
+    return type == ChannelType::DIGITAL_IN || type == ChannelType::SERIAL;
+}
+
+/// Gather the samples of group @p group_id from @p packets into row-major @p samples
+/// @param[out] n_channels Channels per row (that of the first matching packet)
+/// @return Number of rows gathered
+static size_t gatherGroup(const cbPKT_GENERIC* packets, const size_t count, const uint8_t group_id,
+                          int16_t* samples, uint64_t* timestamps, size_t& n_channels) {
+    size_t n = 0;
+    n_channels = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (packets[i].cbpkt_header.chid == 0 &&
+            packets[i].cbpkt_header.type == group_id) {
+            const auto& grp = reinterpret_cast<const cbPKT_GROUP&>(packets[i]);
+            size_t nc = static_cast<size_t>(grp.cbpkt_header.dlen) * 2;
+            if (nc == 0) continue;
+            if (n == 0) n_channels = nc;
+            else if (nc != n_channels) continue;  // skip mismatched (shouldn't happen)
+            std::memcpy(&samples[n * n_channels], grp.data, n_channels * sizeof(int16_t));
+            timestamps[n] = grp.cbpkt_header.time;
+            n++;
+        }
+    }
+    return n;
+}
+
+Result<std::shared_ptr<const GroupProjection>> projectGroup(const uint16_t* list, const uint32_t n,
+                                                            const std::vector<uint32_t>& chan_ids) {
+    using R = Result<std::shared_ptr<const GroupProjection>>;
+    if (chan_ids.empty()) {
+        return R::error("No channels to subscribe to");
+    }
+    auto projection = std::make_shared<GroupProjection>();
+    projection->group_dlen = (n + 1) / 2;
+    projection->width = chan_ids.size();
+    for (const uint32_t chan_id : chan_ids) {
+        const auto column = static_cast<uint16_t>(std::find(list, list + n, chan_id) - list);
+        if (column == n) {
+            return R::error("Channel " + std::to_string(chan_id) + " is not in the group");
+        }
+        auto& runs = projection->runs;
+        if (!runs.empty() && runs.back().first + runs.back().second == column) {
+            ++runs.back().second;
+        } else {
+            runs.emplace_back(column, uint16_t{1});
+        }
+    }
+    return R::ok(std::move(projection));
+}
+
+/// Like gatherGroup(), but copy only the columns of @p projection into dense rows of
+/// projection.width samples; packets of another width than when registered are skipped
+static size_t gatherProjection(const cbPKT_GENERIC* packets, const size_t count, const uint8_t group_id,
+                               const GroupProjection& projection, int16_t* samples, uint64_t* timestamps) {
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (packets[i].cbpkt_header.chid != 0 || packets[i].cbpkt_header.type != group_id ||
+            packets[i].cbpkt_header.dlen != projection.group_dlen) {
+            continue;
+        }
+        const int16_t* data = reinterpret_cast<const cbPKT_GROUP&>(packets[i]).data;
+        int16_t* row = &samples[n * projection.width];
+        for (const auto& [first, length] : projection.runs) {
+            if (length == 1) {
+                *row = data[first];
+            } else {
+                std::memcpy(row, data + first, length * sizeof(int16_t));
+            }
+            row += length;
+        }
+        timestamps[n] = packets[i].cbpkt_header.time;
+        n++;
+    }
+    return n;
+}
+
+/// Hand a gathered (and filtered) batch to a formatted callback in its layout and units
+static void deliverFormatted(GroupBatchOutput& output, const GroupBatchCallback& cb, const int16_t* samples,
+                             const size_t n, const size_t n_channels, const uint64_t* timestamps) {
+    if (output.scaled_cb) {
+        if (output.scales.size() != n_channels) {
+            return;  // stale scaling
+        }
+        output.values.resize(n * n_channels);
+        scaleSamples(samples, n, n_channels, output.scales.data(), output.layout, output.values.data());
+        output.scaled_cb(output.values.data(), n, n_channels, timestamps);
+    } else if (cb) {
+        if (output.layout == SampleLayout::CHANNEL_MAJOR) {
+            output.transposed.resize(n * n_channels);
+            transposeSamples(samples, n, n_channels, output.transposed.data());
+            samples = output.transposed.data();
+        }
+        cb(samples, n, n_channels, timestamps);
+    }
+}
+
+/// Hand rows to a batch callback, formatted if it asked for a layout or units
+static void deliverBatch(const GroupBatchCB& bcb, const int16_t* samples, const size_t n,
+                         const size_t n_channels, const uint64_t* timestamps) {
+    if (bcb.output) {
+        deliverFormatted(*bcb.output, bcb.cb, samples, n, n_channels, timestamps);
+    } else if (bcb.cb) {
+        bcb.cb(samples, n, n_channels, timestamps);
+    }
+}
+
+/// Add @p n rows to a batching callback's buffer and deliver the blocks its policy says are
+/// due at @p now (n = 0 only checks max_delay_us).  While nothing is buffered, due blocks
+/// are delivered straight from @p samples and only the remainder is copied.  Rows buffered
+/// in another channel count are delivered first, short blocks included.
+static void accumulateBatch(const GroupBatchCB& bcb, const int16_t* samples, const size_t n,
+                            const size_t n_channels, const uint64_t* timestamps,
+                            const std::chrono::steady_clock::time_point now) {
+    auto& acc = *bcb.accumulator;
+    if (n > 0 && acc.n_channels != n_channels) {
+        const size_t buffered = acc.timestamps.size();
+        const size_t block = acc.policy.max_samples > 0 ? acc.policy.max_samples : buffered;
+        for (size_t head = 0; head < buffered; head += block) {
+            deliverBatch(bcb, acc.samples.data() + head * acc.n_channels, std::min(block, buffered - head),
+                         acc.n_channels, acc.timestamps.data() + head);
+        }
+        acc.samples.clear();
+        acc.timestamps.clear();
+        acc.arrivals.clear();
+        acc.n_channels = n_channels;
+    }
+    const bool direct = acc.timestamps.empty();
+    if (!direct && n > 0) {
+        acc.samples.insert(acc.samples.end(), samples, samples + n * n_channels);
+        acc.timestamps.insert(acc.timestamps.end(), timestamps, timestamps + n);
+        acc.arrivals.insert(acc.arrivals.end(), n, now);
+    }
+    const int16_t* rows = direct ? samples : acc.samples.data();
+    const uint64_t* row_ts = direct ? timestamps : acc.timestamps.data();
+    const size_t available = direct ? n : acc.timestamps.size();
+
+    const auto& policy = acc.policy;
+    const size_t min_rows = std::max<size_t>(policy.min_samples, 1);
+    const auto max_delay = std::chrono::microseconds(policy.max_delay_us);
+    size_t head = 0;
+    while (head < available) {
+        const size_t pending = available - head;
+        const bool late = policy.max_delay_us > 0 && !direct && now - acc.arrivals[head] >= max_delay;
+        if (pending < min_rows && !late) break;
+        const size_t take = policy.max_samples > 0 ? std::min(pending, policy.max_samples) : pending;
+        deliverBatch(bcb, rows + head * acc.n_channels, take, acc.n_channels, row_ts + head);
+        head += take;
+    }
+
+    if (direct) {
+        acc.samples.assign(samples + head * n_channels, samples + n * n_channels);
+        acc.timestamps.assign(timestamps + head, timestamps + n);
+        acc.arrivals.assign(n - head, now);
+    } else if (head > 0) {
+        const auto rows_done = static_cast<std::ptrdiff_t>(head);
+        acc.samples.erase(acc.samples.begin(),
+                          acc.samples.begin() + rows_done * static_cast<std::ptrdiff_t>(acc.n_channels));
+        acc.timestamps.erase(acc.timestamps.begin(), acc.timestamps.begin() + rows_done);
+        acc.arrivals.erase(acc.arrivals.begin(), acc.arrivals.begin() + rows_done);
+    }
+}
+
+/// Run host spike detection on one batch of its group and fill @p sd.packets with the spikes
+static void detectSpikes(SpikeDetection& sd, int16_t* samples, const uint64_t* timestamps, const size_t n,
+                         const size_t n_channels) {
+    sd.packets.clear();
+    if (n == 0 || n_channels != sd.channels.size()) {
+        return;  // stale channel list
+    }
+    if (sd.filter) {
+        sd.filter->process(samples, n, samples);
+    }
+    std::lock_guard<std::mutex> lock(sd.mutex);
+    const uint32_t len = sd.detector->config().spike_length;
+    sd.packets.resize(sd.detector->process(samples, timestamps, n, sd.spikes));
+    for (size_t i = 0; i < sd.spikes.size(); ++i) {
+        const auto& spike = sd.spikes[i];
+        auto& spk = reinterpret_cast<cbPKT_SPK&>(sd.packets[i]);
+        spk.cbpkt_header = {};
+        spk.cbpkt_header.time = spike.timestamp;
+        spk.cbpkt_header.chid = sd.channels[spike.column];
+        spk.cbpkt_header.type = 0;  // unsorted
+        spk.cbpkt_header.dlen = static_cast<uint16_t>(cbPKTDLEN_SPKSHORT + (len + 1) / 2);
+        spk.fPattern[0] = spk.fPattern[1] = spk.fPattern[2] = 0.0f;
+        std::memcpy(spk.wave, spike.wave, len * sizeof(int16_t));
+        std::fill(spk.wave + len, spk.wave + cbMAX_PNTS, int16_t{0});
+        const auto [lo, hi] = std::minmax_element(spike.wave, spike.wave + len);
+        spk.nPeak = *hi;
+        spk.nValley = *lo;
+    }
+}
+
+/// Feed one batch of its source to a band power stream; publish the feature vectors it completes
+static void computeBandPower(BandPowerStream& bp, const int16_t* samples, const uint64_t* timestamps,
+                             const size_t n, const size_t n_channels, const std::vector<BandPowerCB>& callbacks) {
+    if (!bp.engine || bp.engine->channelCount() != n_channels) {
+        auto created = BandPowerEngine::create(bp.config, bp.sample_rate_hz, n_channels);
+        bp.engine.emplace(std::move(created.value()));
+    }
+    const size_t n_bands = bp.engine->bandCount();
+    bp.out.resize(bp.engine->maxOutput(n) * n_channels * n_bands);
+    bp.out_ts.resize(bp.engine->maxOutput(n));
+    const size_t produced = bp.engine->process(samples, timestamps, n, bp.out.data(), bp.out_ts.data());
+    if (produced == 0) {
+        return;
+    }
+    bp.ring.push(bp.out.data(), bp.out_ts.data(), produced, n_channels * n_bands);
+    for (const auto& cb : callbacks) {
+        if (cb.stream == bp.id && cb.cb) {
+            cb.cb(bp.out.data(), produced, n_channels, n_bands, bp.out_ts.data());
+        }
+    }
+}
+
+/// Queue the trigger events of a batch (and its host-detected spikes) on an epoch stream,
+/// then feed it the batch's samples of its group, publishing the epochs they complete
+static void cutEpochs(EpochStream& es, const cbPKT_GENERIC* packets, const size_t count,
+                      const SpikeDetection* detection, const std::vector<EpochCB>& callbacks,
+                      const ChannelTypeTable* types) {
+    es.samples.resize(count * cbNUM_ANALOG_CHANS);
+    es.timestamps.resize(count);
+    size_t n_channels = 0;
+    const size_t n = gatherGroup(packets, count, es.source_group, es.samples.data(), es.timestamps.data(),
+                                 n_channels);
+    if (n > 0 && (!es.extractor || es.extractor->channelCount() != n_channels)) {
+        auto created = EpochExtractor::create(es.config, n_channels);
+        es.extractor.emplace(std::move(created.value()));
+    }
+    if (!es.extractor) {
+        return;  // no samples yet, so no window to cut
+    }
+    const auto add = [&es, types](const cbPKT_GENERIC& pkt) {
+        const uint16_t chid = pkt.cbpkt_header.chid;
+        EpochEvent event;
+        event.time = pkt.cbpkt_header.time;
+        if (cbproto::classifyPacket(chid) == cbproto::PacketClass::CONFIG) {
+            if (!es.comments || pkt.cbpkt_header.type != cbPKTTYPE_COMMENTREP) return;
+        } else if (chid <= cbMAXCHANS && es.channels[chid]) {
+            event.chan_id = chid;
+            if (chid <= cbNUM_ANALOG_CHANS) {
+                const uint32_t unit = pkt.cbpkt_header.type;
+                if (unit >= 32 || !(es.unit_mask & (1u << unit))) return;
+                event.value = unit;
+            } else if (isDigitalInput(types, chid)) {
+                event.value = reinterpret_cast<const cbPKT_DINP&>(pkt).valueRead;
+            } else {
+                return;  // analog or audio output
+            }
+        } else {
+            return;
+        }
+        es.extractor->addEvent(event);
+    };
+    for (size_t i = 0; i < count; i++) {
+        add(packets[i]);
+    }
+    if (detection) {
+        for (const auto& pkt : detection->packets) {
+            add(pkt);
+        }
+    }
+    es.callbacks = &callbacks;
+    es.extractor->addSamples(es.samples.data(), es.timestamps.data(), n, es.sink);
+    std::lock_guard<std::mutex> lock(es.ring.mutex);
+    es.pending = es.extractor->pendingCount();
+    es.stats = es.extractor->stats();
+}
+
+/// Count the spikes of a batch (and its host-detected spikes), close the bins the batch's
+/// timestamps have passed, and hand them to @p callbacks
+static void binSpikes(SpikeBinning& sb, const cbPKT_GENERIC* packets, const size_t count,
+                      const SpikeDetection* detection, const std::vector<SpikeBinCB>& callbacks) {
+    size_t n_closed = 0;
+    {
+        std::lock_guard<std::mutex> lock(sb.mutex);
+        auto& binner = *sb.binner;
+        uint64_t now = 0;
+        const auto add = [&binner](const cbPKT_GENERIC& pkt) {
+            if (cbproto::classifyPacket(pkt.cbpkt_header.chid) == cbproto::PacketClass::EVENT) {
+                binner.addSpike(pkt.cbpkt_header.chid, pkt.cbpkt_header.type, pkt.cbpkt_header.time);
+            }
+        };
+        for (size_t i = 0; i < count; i++) {
+            add(packets[i]);
+            now = std::max<uint64_t>(now, packets[i].cbpkt_header.time);
+        }
+        if (detection) {
+            for (const auto& pkt : detection->packets) {
+                add(pkt);
+            }
+        }
+        binner.advance(now);
+        n_closed = binner.takeClosed(sb.closed_counts.data(), sb.closed_starts.data(),
+                                     sb.closed_starts.size());
+    }
+    const size_t channels = sb.binner->config().channel_count;
+    const size_t units = sb.binner->config().unit_count;
+    for (size_t b = 0; b < n_closed; ++b) {
+        for (const auto& cb : callbacks) {
+            if (cb.cb) cb.cb(sb.closed_starts[b], &sb.closed_counts[b * channels * units], channels, units);
+        }
+    }
+}
+
+/// Log the digital and serial input packets of a batch
+static void trackDigitalInputs(DigitalInputTracking& dt, const cbPKT_GENERIC* packets, const size_t count,
+                               const ChannelTypeTable* types) {
+    std::lock_guard<std::mutex> lock(dt.mutex);
+    for (size_t i = 0; i < count; i++) {
+        const uint16_t chid = packets[i].cbpkt_header.chid;
+        if (isDigitalInput(types, chid)) {
+            dt.tracker->add(chid, packets[i].cbpkt_header.time,
+                            reinterpret_cast<const cbPKT_DINP&>(packets[i]).valueRead);
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Spike Sorting Models
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+cbPKT_FS_BASIS copyBasisPacket(const cbPKT_GENERIC& pkt) {
+    cbPKT_FS_BASIS basis{};
+    const size_t bytes = std::min({sizeof(cbPKT_GENERIC), sizeof(basis),
+                                   cbPKT_HEADER_SIZE + size_t{pkt.cbpkt_header.dlen} * 4});
+    std::memcpy(&basis, &pkt, bytes);
+    return basis;
+}
+
+uint32_t foldSortPacket(std::vector<ChannelSortModel>& models, const cbPKT_FS_BASIS& pkt) {
+    if (pkt.chan < 1 || pkt.chan > cbNUM_ANALOG_CHANS) return 0;
+    models[pkt.chan].basis.assign(&pkt.basis[0][0], &pkt.basis[0][0] + cbMAX_PNTS * 3);
+    return pkt.chan;
+}
+
+/// chan is 0-based in unit model packets.  Units that are not valid or whose covariance is
+/// degenerate are dropped.
+uint32_t foldSortPacket(std::vector<ChannelSortModel>& models, const cbPKT_SS_MODELSET& pkt) {
+    if (pkt.chan >= cbNUM_ANALOG_CHANS) return 0;
+    auto& units = models[pkt.chan + 1].units;
+    units.erase(std::remove_if(units.begin(), units.end(),
+                               [&pkt](const SortUnit& u) { return u.unit == pkt.unit_number; }),
+                units.end());
+    const auto& inv = pkt.Sigma_x_inv;
+    const bool numbered = (pkt.unit_number >= 1 && pkt.unit_number <= cbMAXUNITS) ||
+                          pkt.unit_number == SORT_UNIT_NOISE;
+    if (pkt.valid && numbered && inv[0][0] > 0.0f && inv[0][0] * inv[1][1] - inv[0][1] * inv[1][0] > 0.0f) {
+        SortUnit unit;
+        unit.unit = pkt.unit_number;
+        std::copy_n(pkt.mu_x, 2, unit.mean);
+        std::copy_n(&inv[0][0], 4, &unit.inv_covariance[0][0]);
+        unit.log_determinant = pkt.log_determinant_Sigma_x;
+        units.push_back(unit);
+    }
+    return pkt.chan + 1;
+}
+
+/// All-zero axes mean the channel has no noise boundary
+uint32_t foldSortPacket(std::vector<ChannelSortModel>& models, const cbPKT_SS_NOISE_BOUNDARY& pkt) {
+    if (pkt.chan < 1 || pkt.chan > cbNUM_ANALOG_CHANS) return 0;
+    auto& model = models[pkt.chan];
+    model.has_noise_boundary = true;
+    for (size_t k = 0; k < 3; ++k) {
+        model.noise_center[k] = pkt.afc[k];
+        std::copy_n(pkt.afS[k], 3, model.noise_axes[k]);
+        model.has_noise_boundary &= pkt.afS[k][0] != 0.0f || pkt.afS[k][1] != 0.0f || pkt.afS[k][2] != 0.0f;
+    }
+    return pkt.chan;
+}
+
+/// Fold a sort packet of a batch into the models
+/// @return Channel ID of the model changed, or 0 if @p pkt is not a sort packet
+static uint32_t foldSortPacket(std::vector<ChannelSortModel>& models, const cbPKT_GENERIC& pkt) {
+    if (cbproto::isMalformedConfigPacket(pkt.cbpkt_header)) {
+        return 0;
+    }
+    switch (cbproto::packetTraits(pkt.cbpkt_header).slot) {
+    case cbproto::ConfigSlot::FS_BASIS:
+        return foldSortPacket(models, copyBasisPacket(pkt));
+    case cbproto::ConfigSlot::SS_MODEL:
+        return foldSortPacket(models, reinterpret_cast<const cbPKT_SS_MODELSET&>(pkt));
+    case cbproto::ConfigSlot::SS_NOISE_BOUNDARY:
+        return foldSortPacket(models, reinterpret_cast<const cbPKT_SS_NOISE_BOUNDARY&>(pkt));
+    default:
+        return 0;
+    }
+}
+
+void applySortModel(SpikeSorter& sorter, const uint32_t chan_id, const ChannelSortModel& model) {
+    if (model.basis.empty() || sorter.setModel(chan_id, model).isError()) {
+        sorter.clearModel(chan_id);
+    }
+}
+
+/// Fold the sort packets of a batch into the models, then classify the batch's unsorted
+/// spikes (and its host-detected ones) in place
+static void sortSpikes(SpikeSorting& ss, cbPKT_GENERIC* packets, const size_t count, SpikeDetection* detection) {
+    std::lock_guard<std::mutex> lock(ss.mutex);
+    auto& sorter = *ss.sorter;
+    // Waveforms shorter than the sorter's spike length (dlen counts 32-bit words) are skipped
+    const uint32_t min_dlen = cbPKTDLEN_SPKSHORT + (sorter.config().spike_length + 1) / 2;
+    ss.spikes.clear();
+    ss.targets.clear();
+    const auto add = [&ss, min_dlen](cbPKT_GENERIC& pkt) {
+        if (pkt.cbpkt_header.dlen < min_dlen) return;
+        SpikeToSort spike;
+        spike.chan_id = pkt.cbpkt_header.chid;
+        spike.wave = reinterpret_cast<const cbPKT_SPK&>(pkt).wave;
+        ss.spikes.push_back(spike);
+        ss.targets.push_back(&pkt);
+    };
+    for (size_t i = 0; i < count; i++) {
+        auto& pkt = packets[i];
+        const uint16_t chid = pkt.cbpkt_header.chid;
+        if (cbproto::classifyPacket(chid) == cbproto::PacketClass::CONFIG) {
+            if (const uint32_t chan_id = foldSortPacket(ss.models, pkt)) {
+                applySortModel(sorter, chan_id, ss.models[chan_id]);
+            }
+        } else if (ss.device_spikes && chid >= 1 && chid <= cbNUM_ANALOG_CHANS && pkt.cbpkt_header.type == 0) {
+            add(pkt);
+        }
+    }
+    if (detection) {
+        for (auto& pkt : detection->packets) {
+            add(pkt);
+        }
+    }
+    if (ss.spikes.empty()) return;
+
+    sorter.sort(ss.spikes.data(), ss.spikes.size());
+    for (size_t i = 0; i < ss.spikes.size(); ++i) {
+        const auto& spike = ss.spikes[i];
+        if (!spike.modelled) continue;
+        auto& spk = reinterpret_cast<cbPKT_SPK&>(*ss.targets[i]);
+        std::copy_n(spike.pattern, 3, spk.fPattern);
+        spk.cbpkt_header.type = static_cast<uint16_t>(spike.unit);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// ProcessingPipeline
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void ProcessingPipeline::processBatch(cbPKT_GENERIC* packets, const size_t count,
+                                      const ChannelTypeTable* types) const {
+    // Local recording only copies the batch; the recorder's thread writes it out
+    if (recorder) {
+        recorder->write(packets, count);
+    }
+
+    if (!group_batch_callbacks.empty() || !virtual_groups.empty() || !band_power_streams.empty() ||
+        spike_detection) {
+        // Temp buffers — sized for max batch (128 packets × 272 channels)
+        // ~70KB on stack, well within typical thread stack limits.
+        int16_t sample_buf[128 * cbNUM_ANALOG_CHANS];
+        uint64_t ts_buf[128];
+
+        // Virtual groups first: their stages need the unfiltered source samples
+        for (const auto& vg : virtual_groups) {
+            size_t n_channels = 0;
+            const size_t n = gatherGroup(packets, count, vg->source_group, sample_buf, ts_buf, n_channels);
+            if (n == 0) continue;
+
+            const int16_t* out = sample_buf;
+            const uint64_t* out_ts = ts_buf;
+            size_t produced = n;
+            if (vg->kind == VirtualGroupKind::REREFERENCED) {
+                if (vg->rereferencer->channelCount() != n_channels) continue;  // stale plan
+                vg->rereferencer->process(sample_buf, n);
+            } else {
+                if (!vg->resampler || vg->resampler->channelCount() != n_channels) {
+                    auto created = PolyphaseResampler::create(vg->up, vg->down, n_channels);
+                    vg->resampler.emplace(std::move(created.value()));
+                }
+                vg->out.resize(vg->resampler->maxOutput(n) * n_channels);
+                vg->out_ts.resize(vg->resampler->maxOutput(n));
+                produced = vg->resampler->process(sample_buf, ts_buf, n, vg->out.data(), vg->out_ts.data());
+                out = vg->out.data();
+                out_ts = vg->out_ts.data();
+            }
+            if (produced == 0) continue;
+            vg->ring.push(out, out_ts, produced, n_channels);
+            for (const auto& vcb : virtual_batch_callbacks) {
+                if (vcb.group == vg->id && vcb.cb) {
+                    vcb.cb(out, produced, n_channels, out_ts);
+                }
+            }
+            for (const auto& bp : band_power_streams) {
+                if (bp->source_virtual == vg->id) {
+                    computeBandPower(*bp, out, out_ts, produced, n_channels, band_power_callbacks);
+                }
+            }
+        }
+
+        for (const auto& bp : band_power_streams) {
+            if (bp->source_virtual != 0) continue;
+            size_t n_channels = 0;
+            const size_t n = gatherGroup(packets, count, bp->source_group, sample_buf, ts_buf, n_channels);
+            if (n > 0) {
+                computeBandPower(*bp, sample_buf, ts_buf, n, n_channels, band_power_callbacks);
+            }
+        }
+
+        for (const auto& bcb : group_batch_callbacks) {
+            size_t n_channels = 0;
+            size_t n = 0;
+            if (bcb.projection) {
+                n_channels = bcb.projection->width;
+                n = gatherProjection(packets, count, bcb.group_id, *bcb.projection, sample_buf, ts_buf);
+            } else {
+                n = gatherGroup(packets, count, bcb.group_id, sample_buf, ts_buf, n_channels);
+            }
+
+            if (n > 0 && bcb.filter) {
+                auto& filter = *bcb.filter;
+                if (!filter.bank || filter.bank->channelCount() != n_channels) {
+                    auto created = BiquadFilterBank::create(filter.sections, n_channels);
+                    filter.bank.emplace(std::move(created.value()));
+                }
+                filter.bank->process(sample_buf, n, sample_buf);
+            }
+            if (n > 0 && bcb.accumulator) {
+                accumulateBatch(bcb, sample_buf, n, n_channels, ts_buf, std::chrono::steady_clock::now());
+            } else if (n > 0) {
+                deliverBatch(bcb, sample_buf, n, n_channels, ts_buf);
+            }
+        }
+
+        if (spike_detection) {
+            size_t n_channels = 0;
+            const size_t n = gatherGroup(packets, count, spike_detection->source_group, sample_buf, ts_buf,
+                                         n_channels);
+            detectSpikes(*spike_detection, sample_buf, ts_buf, n, n_channels);
+        }
+    }
+
+    // Spikes are sorted before the packet callbacks, so callbacks, bins and epochs see units
+    if (spike_sorting) {
+        sortSpikes(*spike_sorting, packets, count, spike_detection.get());
+    }
+
+    // Inputs are logged before the packet callbacks, so a callback's queries see its packet
+    if (digital_inputs) {
+        trackDigitalInputs(*digital_inputs, packets, count, types);
+    }
+}
+
+void ProcessingPipeline::finishBatch(const cbPKT_GENERIC* packets, const size_t count,
+                                     const ChannelTypeTable* types) const {
+    // Spike bins the batch completed
+    if (spike_binning) {
+        binSpikes(*spike_binning, packets, count, spike_detection.get(), spike_bin_callbacks);
+    }
+
+    // Epochs whose post window the batch completed
+    for (const auto& es : epoch_streams) {
+        cutEpochs(*es, packets, count, spike_detection.get(), epoch_callbacks, types);
+    }
+}
+
+void ProcessingPipeline::flushBatchAccumulators(const std::chrono::steady_clock::time_point now) const {
+    if (accumulating == 0) {
+        return;
+    }
+    for (const auto& bcb : group_batch_callbacks) {
+        if (bcb.accumulator && bcb.accumulator->policy.max_delay_us > 0) {
+            accumulateBatch(bcb, nullptr, 0, bcb.accumulator->n_channels, nullptr, now);
+        }
+    }
+}
+
+std::shared_ptr<VirtualGroup> ProcessingPipeline::findVirtualGroup(const VirtualGroupId id) const {
+    for (const auto& group : virtual_groups) {
+        if (group->id == id) {
+            return group;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<BandPowerStream> ProcessingPipeline::findBandPowerStream(const BandPowerStreamId id) const {
+    for (const auto& stream : band_power_streams) {
+        if (stream->id == id) {
+            return stream;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<EpochStream> ProcessingPipeline::findEpochStream(const EpochStreamId id) const {
+    for (const auto& stream : epoch_streams) {
+        if (stream->id == id) {
+            return stream;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace cbsdk
@@ -0,0 +1,288 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   processing_pipeline.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Host-side batch stages of an SdkSession
+///
+/// Everything SdkSession runs on a whole batch before and after its per-packet callbacks:
+/// local recording, virtual groups, band power, batch callbacks, host spike detection and
+/// sorting, digital input tracking, spike binning and epochs.  The session publishes the set
+/// of stages as an immutable ProcessingPipeline; registration copies it, edits the copy and
+/// swaps it in, so the dispatching thread reads it with a single atomic load and no lock.
+/// The per-stage state the pipeline points to (filters, resamplers, rings) is still mutable:
+/// its scratch buffers belong to the dispatching thread and its own mutexes guard what user
+/// threads read.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSDK_PROCESSING_PIPELINE_H
+#define CBSDK_PROCESSING_PIPELINE_H
+
+#include "cbsdk/sdk_session.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace cbsdk {
+
+/// Channel type of each channel by 0-based index, as cached by the session
+using ChannelTypeTable = std::array<ChannelType, cbMAXCHANS>;
+
+/// Host-side filter of a filtered batch callback; only the dispatching thread touches bank
+struct GroupFilter {
+    std::vector<Biquad> sections;
+    std::optional<BiquadFilterBank> bank;
+};
+
+/// Columns of a group a batch callback subscribes to, as runs of adjacent columns
+struct GroupProjection {
+    size_t group_dlen = 0;              // dlen of the group's packets when registered
+    size_t width = 0;                   // columns delivered
+    std::vector<std::pair<uint16_t, uint16_t>> runs;   // (first column, length), in output order
+};
+
+/// Layout and units a formatted batch callback receives, with its scratch buffers
+struct GroupBatchOutput {
+    SampleLayout layout = SampleLayout::SAMPLE_MAJOR;
+    std::vector<ChannelScale> scales;   // one per delivered column (scaled callbacks only)
+    ScaledGroupBatchCallback scaled_cb;
+    std::vector<int16_t> transposed;
+    std::vector<float> values;
+};
+
+/// Rows a batch callback with a BatchPolicy has not been handed yet
+struct BatchAccumulator {
+    BatchPolicy policy;
+    size_t n_channels = 0;
+    std::vector<int16_t> samples;       // buffered rows
+    std::vector<uint64_t> timestamps;
+    std::vector<std::chrono::steady_clock::time_point> arrivals;   // when each row was buffered
+};
+
+struct GroupBatchCB  { CallbackHandle handle; uint8_t group_id; GroupBatchCallback cb;
+                       std::shared_ptr<GroupFilter> filter{};
+                       std::shared_ptr<const GroupProjection> projection{};
+                       std::shared_ptr<GroupBatchOutput> output{};
+                       std::shared_ptr<BatchAccumulator> accumulator{}; };
+struct VirtualBatchCB { CallbackHandle handle; VirtualGroupId group; GroupBatchCallback cb; };
+struct SpikeBinCB   { CallbackHandle handle; SpikeBinCallback cb; };
+struct BandPowerCB  { CallbackHandle handle; BandPowerStreamId stream; BandPowerCallback cb; };
+struct EpochCB      { CallbackHandle handle; EpochStreamId stream; EpochCallback cb; };
+
+/// Ring buffer of stamped rows produced on the dispatching thread and drained by user threads
+/// (virtual groups, band power and epoch streams).  A change of row width drops what is buffered.
+template <typename T, typename Stamp = uint64_t>
+struct FrameRing {
+    mutable std::mutex mutex;
+    std::vector<T> rows;                // [capacity][width]
+    std::vector<Stamp> ts;
+    size_t capacity = 0;
+    size_t width = 0;
+    size_t head = 0;                    // oldest buffered row
+    size_t buffered = 0;
+    uint64_t produced = 0;
+    uint64_t overwritten = 0;
+
+    /// Append @p n rows, overwriting the oldest when full
+    void push(const T* data, const Stamp* timestamps, const size_t n, const size_t n_width) {
+        std::lock_guard<std::mutex> lock(mutex);
+        produced += n;
+        if (n_width != width) {
+            width = n_width;
+            rows.assign(capacity * width, T{});
+            ts.assign(capacity, Stamp{});
+            head = 0;
+            buffered = 0;
+        }
+        if (capacity == 0) {
+            return;
+        }
+        for (size_t r = 0; r < n; ++r) {
+            const size_t slot = (head + buffered) % capacity;
+            std::memcpy(&rows[slot * width], data + r * width, width * sizeof(T));
+            ts[slot] = timestamps[r];
+            if (buffered == capacity) {
+                head = (head + 1) % capacity;
+                ++overwritten;
+            } else {
+                ++buffered;
+            }
+        }
+    }
+
+    /// Move up to @p max_rows of the oldest rows out (caller holds mutex)
+    size_t pop(T* out, Stamp* out_ts, const size_t max_rows) {
+        const size_t n = std::min(max_rows, buffered);
+        for (size_t r = 0; r < n; ++r) {
+            const size_t slot = (head + r) % capacity;
+            std::memcpy(out + r * width, &rows[slot * width], width * sizeof(T));
+            if (out_ts) {
+                out_ts[r] = ts[slot];
+            }
+        }
+        if (n > 0) {
+            head = (head + n) % capacity;
+            buffered -= n;
+        }
+        return n;
+    }
+};
+
+/// A group derived from a device group (see SdkSession::createResampledGroup()).  Only the
+/// dispatching thread touches the resampler and scratch buffers.
+struct VirtualGroup {
+    VirtualGroupId id = 0;
+    VirtualGroupKind kind = VirtualGroupKind::RESAMPLED;
+    uint8_t source_group = 0;
+    uint32_t up = 1;
+    uint32_t down = 1;
+    double group_delay = 0;
+    std::optional<PolyphaseResampler> resampler;
+    std::optional<Rereferencer> rereferencer;   // planned at creation
+    std::vector<int16_t> out;
+    std::vector<uint64_t> out_ts;
+    FrameRing<int16_t> ring;            // rows of one sample per channel
+};
+
+/// Band power features of a device or virtual group (see SdkSession::createBandPowerStream()).
+/// Only the dispatching thread touches the engine and scratch buffers.
+struct BandPowerStream {
+    BandPowerStreamId id = 0;
+    uint8_t source_group = 0;           // used when source_virtual is 0
+    VirtualGroupId source_virtual = 0;
+    double sample_rate_hz = 0;
+    BandPowerConfig config;
+    std::optional<BandPowerEngine> engine;  // made for the first batch's channel count
+    std::vector<float> out;
+    std::vector<uint64_t> out_ts;
+    FrameRing<float> ring;              // rows of [channels][bands] features
+};
+
+/// Peri-event epochs of a device group (see SdkSession::createEpochStream()).  Only the
+/// dispatching thread touches the extractor and scratch buffers; ring.mutex also guards
+/// pending and stats.
+struct EpochStream {
+    EpochStreamId id = 0;
+    uint8_t source_group = 0;
+    EpochConfig config;
+    std::vector<bool> channels;         // [cbMAXCHANS + 1]: channel IDs that trigger
+    uint32_t unit_mask = 0;
+    bool comments = false;
+    std::optional<EpochExtractor> extractor;    // made for the first batch's channel count
+    EpochSink sink;                     // publishes to ring and *callbacks
+    const std::vector<EpochCB>* callbacks = nullptr;
+    std::vector<int16_t> samples;
+    std::vector<uint64_t> timestamps;
+    FrameRing<int16_t, EpochEvent> ring;    // rows of [pre + post][channels] samples
+    size_t pending = 0;
+    EpochStats stats;
+};
+
+/// Host spike detection (see SdkSession::startSpikeDetection()).  mutex guards the detector,
+/// whose thresholds are changed from user threads; filter, spikes and packets belong to the
+/// dispatching thread.
+struct SpikeDetection {
+    uint8_t source_group = 0;
+    std::vector<uint16_t> channels;     // channel ID of each column
+    std::optional<BiquadFilterBank> filter;
+    mutable std::mutex mutex;
+    std::optional<ThresholdSpikeDetector> detector;
+    std::vector<DetectedSpike> spikes;
+    std::vector<cbPKT_GENERIC> packets;
+
+    /// @return Column of @p chan_id, or channels.size() if not detected on
+    size_t column(const uint32_t chan_id) const {
+        return static_cast<size_t>(std::find(channels.begin(), channels.end(), chan_id) - channels.begin());
+    }
+};
+
+/// Spike binning (see SdkSession::startSpikeBinning()).  mutex guards the binner, which user
+/// threads read from; the closed_* buffers belong to the dispatching thread.
+struct SpikeBinning {
+    mutable std::mutex mutex;
+    std::optional<SpikeBinner> binner;
+    std::vector<uint32_t> closed_counts;    // bins taken for the callbacks
+    std::vector<uint64_t> closed_starts;
+};
+
+/// Digital input tracking (see SdkSession::startDigitalInputTracking()).  mutex guards the
+/// tracker, which user threads query.
+struct DigitalInputTracking {
+    mutable std::mutex mutex;
+    std::optional<DigitalInputTracker> tracker;
+};
+
+/// Host spike sorting (see SdkSession::startSpikeSorting()).  mutex guards the sorter and the
+/// models, which user threads replace; spikes and targets belong to the dispatching thread.
+struct SpikeSorting {
+    bool device_spikes = true;
+    mutable std::mutex mutex;
+    std::optional<SpikeSorter> sorter;
+    std::vector<ChannelSortModel> models;   // index = channel ID, assembled from sort packets
+    std::vector<SpikeToSort> spikes;
+    std::vector<cbPKT_GENERIC*> targets;    // packet of each spike
+};
+
+/// The batch stages of a session, in the order a batch runs through them
+struct ProcessingPipeline {
+    std::shared_ptr<Recorder> recorder;
+    std::vector<std::shared_ptr<VirtualGroup>> virtual_groups;
+    std::vector<VirtualBatchCB> virtual_batch_callbacks;
+    std::vector<std::shared_ptr<BandPowerStream>> band_power_streams;
+    std::vector<BandPowerCB> band_power_callbacks;
+    std::vector<GroupBatchCB> group_batch_callbacks;
+    size_t accumulating = 0;            // group_batch_callbacks with a BatchPolicy
+    std::shared_ptr<SpikeDetection> spike_detection;
+    std::shared_ptr<SpikeSorting> spike_sorting;
+    std::shared_ptr<DigitalInputTracking> digital_inputs;
+    std::shared_ptr<SpikeBinning> spike_binning;
+    std::vector<SpikeBinCB> spike_bin_callbacks;
+    std::vector<std::shared_ptr<EpochStream>> epoch_streams;
+    std::vector<EpochCB> epoch_callbacks;
+
+    /// Run the stages that precede the per-packet callbacks: record the batch, feed virtual
+    /// groups and band power, deliver batch callbacks, then detect and sort spikes (in place,
+    /// so the callbacks see units) and log digital inputs
+    /// @param types Channel types, or nullptr while the session has none cached
+    void processBatch(cbPKT_GENERIC* packets, size_t count, const ChannelTypeTable* types) const;
+
+    /// Run the stages that follow the per-packet callbacks: close spike bins and cut epochs
+    void finishBatch(const cbPKT_GENERIC* packets, size_t count, const ChannelTypeTable* types) const;
+
+    /// Deliver buffered blocks that have waited max_delay_us, whether or not their group sent
+    /// anything since; called from the dispatching thread's loop
+    void flushBatchAccumulators(std::chrono::steady_clock::time_point now) const;
+
+    std::shared_ptr<VirtualGroup> findVirtualGroup(VirtualGroupId id) const;
+    std::shared_ptr<BandPowerStream> findBandPowerStream(BandPowerStreamId id) const;
+    std::shared_ptr<EpochStream> findEpochStream(EpochStreamId id) const;
+};
+
+/// Map channel IDs to the columns of a group (@p list, its @p n channels), coalescing
+/// adjacent columns into runs
+Result<std::shared_ptr<const GroupProjection>> projectGroup(const uint16_t* list, uint32_t n,
+                                                            const std::vector<uint32_t>& chan_ids);
+
+/// Copy a PCA basis packet.  A full cbPKT_FS_BASIS is larger than cbPKT_GENERIC, so only
+/// the rows the packet carries are read; the rest stay zero.
+cbPKT_FS_BASIS copyBasisPacket(const cbPKT_GENERIC& pkt);
+
+/// Fold a sort packet (PCA basis, unit model or noise boundary) into the model of its channel
+/// @return Channel ID of the model changed, or 0 if the packet is for no analog channel
+uint32_t foldSortPacket(std::vector<ChannelSortModel>& models, const cbPKT_FS_BASIS& pkt);
+uint32_t foldSortPacket(std::vector<ChannelSortModel>& models, const cbPKT_SS_MODELSET& pkt);
+uint32_t foldSortPacket(std::vector<ChannelSortModel>& models, const cbPKT_SS_NOISE_BOUNDARY& pkt);
+
+/// Install the assembled model of @p chan_id, or clear it while it has no usable basis
+void applySortModel(SpikeSorter& sorter, uint32_t chan_id, const ChannelSortModel& model);
+
+} // namespace cbsdk
+
+#endif // CBSDK_PROCESSING_PIPELINE_H
@@ -0,0 +1,615 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   recorder.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  In-process NSx/NEV recorder (background writer thread)
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Platform headers MUST be included first
+#include "platform_first.h"
+
+#include "cbsdk/recorder.h"
+#include "cbsdk/continuous_codec.h"
+#include "cbsdk/nsx_nev_format.h"
+#include "aligned_file_writer.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace cbsdk {
+
+using namespace fileformat;
+
+namespace {
+
+/// Timestamps are stored as the SDK delivers them: nanoseconds
+constexpr uint32_t TIME_RESOLUTION = 1'000'000'000;
+
+/// Rate that NSx periods and NEV waveforms are expressed in
+constexpr uint32_t SAMPLE_RESOLUTION = 30000;
+
+/// What the recorder does with an event packet, by channel
+enum class EventKind : uint8_t { NONE, SPIKE, DIGITAL, SERIAL };
+
+/// Largest NEV packet: spike header plus a cbMAX_PNTS waveform
+constexpr size_t MAX_NEV_PACKET = sizeof(NevSpikePacket) + cbMAX_PNTS * sizeof(int16_t);
+
+/// Copy a possibly unterminated string into a fixed-size, zero-filled field
+void copyField(char* dst, const size_t dst_size, const char* src, const size_t src_size) {
+    std::memset(dst, 0, dst_size);
+    size_t n = 0;
+    while (n < src_size && n < dst_size && src[n] != '\0') {
+        ++n;
+    }
+    std::memcpy(dst, src, n);
+}
+
+void copyField(char* dst, const size_t dst_size, const std::string& src) {
+    copyField(dst, dst_size, src.c_str(), src.size());
+}
+
+int16_t clamp16(const int32_t v) {
+    return static_cast<int16_t>(std::clamp<int32_t>(v, INT16_MIN, INT16_MAX));
+}
+
+uint16_t clampU16(const int64_t v) {
+    return static_cast<uint16_t>(std::clamp<int64_t>(v, 0, UINT16_MAX));
+}
+
+/// Current UTC time as a SYSTEMTIME
+FileTime utcNow() {
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t t = std::chrono::system_clock::to_time_t(now);
+    std::tm tm{};
+#ifdef _WIN32
+    gmtime_s(&tm, &t);
+#else
+    gmtime_r(&t, &tm);
+#endif
+    const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+    FileTime ft{};
+    ft.year = static_cast<uint16_t>(tm.tm_year + 1900);
+    ft.month = static_cast<uint16_t>(tm.tm_mon + 1);
+    ft.day_of_week = static_cast<uint16_t>(tm.tm_wday);
+    ft.day = static_cast<uint16_t>(tm.tm_mday);
+    ft.hour = static_cast<uint16_t>(tm.tm_hour);
+    ft.minute = static_cast<uint16_t>(tm.tm_min);
+    ft.second = static_cast<uint16_t>(tm.tm_sec);
+    ft.millisecond = static_cast<uint16_t>(ms);
+    return ft;
+}
+
+/// Nanovolts per digital step of a channel's scaling (0 if unknown)
+uint16_t digitizationNv(const cbSCALING& s) {
+    const int32_t dig_span = static_cast<int32_t>(s.digmax) - s.digmin;
+    if (dig_span <= 0) {
+        return 0;
+    }
+    double unit_nv = 1000.0;                        // "uV"
+    if (s.anaunit[0] == 'm' && s.anaunit[1] == 'V') {
+        unit_nv = 1e6;
+    } else if (s.anaunit[0] == 'V') {
+        unit_nv = 1e9;
+    }
+    const double nv = unit_nv * (static_cast<double>(s.anamax) - s.anamin) / dig_span;
+    return clampU16(static_cast<int64_t>(nv + 0.5));
+}
+
+/// NSx label of a sample group, e.g. "30 kS/s"
+std::string groupLabel(const RecordingGroup& group) {
+    if (group.group_id == 6) {
+        return "raw";
+    }
+    const uint32_t rate = SAMPLE_RESOLUTION / std::max<uint32_t>(group.period, 1);
+    char label[16];
+    if (rate >= 1000 && rate % 1000 == 0) {
+        std::snprintf(label, sizeof(label), "%u kS/s", rate / 1000);
+    } else {
+        std::snprintf(label, sizeof(label), "%u S/s", rate);
+    }
+    return label;
+}
+
+std::vector<uint8_t> nsxHeaders(const RecordingGroup& group, const RecordingOptions& options, const FileTime& origin) {
+    const size_t n = group.channels.size();
+    std::vector<uint8_t> out(sizeof(NsxBasicHeader) + n * sizeof(NsxChannelHeader));
+
+    NsxBasicHeader basic{};
+    std::memcpy(basic.file_type_id, NSX_FILE_TYPE_ID, sizeof(basic.file_type_id));
+    basic.major_version = 3;
+    basic.minor_version = 0;
+    basic.bytes_in_headers = static_cast<uint32_t>(out.size());
+    copyField(basic.label, sizeof(basic.label), groupLabel(group));
+    copyField(basic.comment, sizeof(basic.comment), options.comment);
+    basic.period = std::max<uint32_t>(group.period, 1);
+    basic.time_resolution = TIME_RESOLUTION;
+    basic.time_origin = origin;
+    basic.channel_count = static_cast<uint32_t>(n);
+    std::memcpy(out.data(), &basic, sizeof(basic));
+
+    for (size_t i = 0; i < n; ++i) {
+        const auto& ch = group.channels[i];
+        NsxChannelHeader cc{};
+        cc.type[0] = 'C';
+        cc.type[1] = 'C';
+        cc.electrode_id = static_cast<uint16_t>(ch.info.chan);
+        copyField(cc.label, sizeof(cc.label), ch.info.label, sizeof(ch.info.label));
+        cc.physical_connector = static_cast<uint8_t>(ch.info.bank);
+        cc.connector_pin = static_cast<uint8_t>(ch.info.term);
+        cc.min_digital_value = ch.info.scalin.digmin;
+        cc.max_digital_value = ch.info.scalin.digmax;
+        cc.min_analog_value = clamp16(ch.info.scalin.anamin);
+        cc.max_analog_value = clamp16(ch.info.scalin.anamax);
+        copyField(cc.units, sizeof(cc.units), ch.info.scalin.anaunit, sizeof(ch.info.scalin.anaunit));
+        cc.high_freq_corner = ch.continuous_filter.hpfreq;
+        cc.high_freq_order = ch.continuous_filter.hporder;
+        cc.high_filter_type = static_cast<uint16_t>(ch.continuous_filter.hptype);
+        cc.low_freq_corner = ch.continuous_filter.lpfreq;
+        cc.low_freq_order = ch.continuous_filter.lporder;
+        cc.low_filter_type = static_cast<uint16_t>(ch.continuous_filter.lptype);
+        std::memcpy(&out[sizeof(NsxBasicHeader) + i * sizeof(NsxChannelHeader)], &cc, sizeof(cc));
+    }
+    return out;
+}
+
+EventKind classifyEventChannel(const cbPKT_CHANINFO& info) {
+    if (info.chancaps & cbCHAN_DINP) {
+        return (info.dinpcaps & cbDINP_SERIALMASK) ? EventKind::SERIAL : EventKind::DIGITAL;
+    }
+    if (info.chancaps & cbCHAN_AINP) {
+        return EventKind::SPIKE;
+    }
+    return EventKind::NONE;
+}
+
+std::vector<uint8_t> nevHeaders(const RecordingLayout& layout, const RecordingOptions& options,
+                                const FileTime& origin, const uint32_t bytes_per_packet) {
+    std::vector<uint8_t> ext;
+    const auto add = [&ext](const auto& header) {
+        const auto* bytes = reinterpret_cast<const uint8_t*>(&header);
+        ext.insert(ext.end(), bytes, bytes + sizeof(header));
+    };
+
+    for (const auto& ch : layout.event_channels) {
+        const auto& info = ch.info;
+        const EventKind kind = classifyEventChannel(info);
+        if (kind == EventKind::SPIKE) {
+            NevWaveformExtHeader wav{};
+            std::memcpy(wav.id, "NEUEVWAV", sizeof(wav.id));
+            wav.electrode_id = static_cast<uint16_t>(info.chan);
+            wav.physical_connector = static_cast<uint8_t>(info.bank);
+            wav.connector_pin = static_cast<uint8_t>(info.term);
+            wav.digitization_factor = digitizationNv(info.scalin);
+            wav.high_threshold = info.amplrejpos;
+            wav.low_threshold = info.amplrejneg;
+            wav.bytes_per_sample = sizeof(int16_t);
+            wav.spike_width = static_cast<uint16_t>(layout.spike_length);
+            add(wav);
+
+            NevLabelExtHeader lbl{};
+            std::memcpy(lbl.id, "NEUEVLBL", sizeof(lbl.id));
+            lbl.electrode_id = static_cast<uint16_t>(info.chan);
+            copyField(lbl.label, sizeof(lbl.label), info.label, sizeof(info.label));
+            add(lbl);
+
+            NevFilterExtHeader flt{};
+            std::memcpy(flt.id, "NEUEVFLT", sizeof(flt.id));
+            flt.electrode_id = static_cast<uint16_t>(info.chan);
+            flt.high_freq_corner = ch.spike_filter.hpfreq;
+            flt.high_freq_order = ch.spike_filter.hporder;
+            flt.high_filter_type = static_cast<uint16_t>(ch.spike_filter.hptype);
+            flt.low_freq_corner = ch.spike_filter.lpfreq;
+            flt.low_freq_order = ch.spike_filter.lporder;
+            flt.low_filter_type = static_cast<uint16_t>(ch.spike_filter.lptype);
+            add(flt);
+        } else if (kind != EventKind::NONE) {
+            NevDigitalLabelExtHeader dig{};
+            std::memcpy(dig.id, "DIGLABEL", sizeof(dig.id));
+            copyField(dig.label, sizeof(dig.label), info.label, sizeof(info.label));
+            dig.mode = kind == EventKind::SERIAL ? 0 : 1;
+            add(dig);
+        }
+    }
+
+    NevBasicHeader basic{};
+    std::memcpy(basic.file_type_id, NEV_FILE_TYPE_ID, sizeof(basic.file_type_id));
+    basic.major_version = 3;
+    basic.minor_version = 0;
+    basic.flags = NEV_FLAG_WAVEFORMS_16BIT;
+    basic.bytes_in_headers = static_cast<uint32_t>(sizeof(NevBasicHeader) + ext.size());
+    basic.bytes_per_packet = bytes_per_packet;
+    basic.time_resolution = TIME_RESOLUTION;
+    basic.sample_resolution = SAMPLE_RESOLUTION;
+    basic.time_origin = origin;
+    copyField(basic.application, sizeof(basic.application), std::string("CereLink"));
+    copyField(basic.comment, sizeof(basic.comment), options.comment);
+    basic.extended_header_count = static_cast<uint32_t>(ext.size() / 32);
+
+    std::vector<uint8_t> out(sizeof(basic));
+    std::memcpy(out.data(), &basic, sizeof(basic));
+    out.insert(out.end(), ext.begin(), ext.end());
+    return out;
+}
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Recorder::Impl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct Recorder::Impl {
+    RecordingOptions options;
+    uint32_t spike_length = 48;
+    uint32_t nev_packet_bytes = 0;
+
+    // Routing tables: group id -> NSx file (-1 = not recorded), channel id -> event kind
+    std::array<int, cbMAXGROUPS + 1> group_file{};
+    std::array<uint32_t, cbMAXGROUPS + 1> group_channels{};
+    std::array<EventKind, cbMAXCHANS + 1> event_kind{};
+
+    // Files (touched only by the writer thread once it runs)
+    std::optional<AlignedFileWriter> nev;
+    std::vector<AlignedFileWriter> nsx;
+    std::vector<std::optional<ContinuousEncoder>> encoders;    // parallel to nsx when compressing
+    std::vector<uint8_t> encoded;
+    std::vector<int16_t> frame;
+    std::vector<std::string> paths;
+    bool direct_io = false;
+
+    // Producer side: packet bytes are appended to `front`, the writer thread swaps it out
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<uint8_t> front;
+    bool stop_requested = false;
+    bool failed = false;
+
+    std::thread thread;
+
+    std::atomic<uint64_t> continuous_packets{0};
+    std::atomic<uint64_t> spike_packets{0};
+    std::atomic<uint64_t> digital_packets{0};
+    std::atomic<uint64_t> bytes_written{0};
+    std::atomic<uint64_t> continuous_raw_bytes{0};
+    std::atomic<uint64_t> continuous_encoded_bytes{0};
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<uint64_t> write_errors{0};
+    std::atomic<uint64_t> pending_bytes{0};
+
+    /// Initial capacity of the front and back buffers
+    size_t initialBufferBytes() const {
+        return std::min<size_t>(options.max_pending_bytes, 8 * 1024 * 1024);
+    }
+
+    bool isRecorded(const cbPKT_HEADER& hdr) const {
+        if (hdr.chid == 0) {
+            return hdr.type <= cbMAXGROUPS && group_file[hdr.type] >= 0;
+        }
+        return hdr.chid <= cbMAXCHANS && event_kind[hdr.chid] != EventKind::NONE;
+    }
+
+    /// Format one packet into its file (writer thread)
+    bool writePacket(const uint8_t* bytes, const size_t size) {
+        cbPKT_HEADER hdr;
+        std::memcpy(&hdr, bytes, sizeof(hdr));
+
+        if (hdr.chid == 0) {
+            const auto index = static_cast<size_t>(group_file[hdr.type]);
+            auto& file = nsx[index];
+            const size_t nchans = group_channels[hdr.type];
+            const size_t have = std::min(nchans, (size_t{hdr.dlen} * 4) / sizeof(int16_t));
+
+            if (auto& encoder = encoders[index]) {
+                frame.assign(nchans, 0);
+                std::memcpy(frame.data(), bytes + cbPKT_HEADER_SIZE, have * sizeof(int16_t));
+                encoder->push(hdr.time, frame.data(), encoded);
+                continuous_packets.fetch_add(1, std::memory_order_relaxed);
+                return flushEncoded(file);
+            }
+
+            NsxDataHeader dh{};
+            dh.header = 1;
+            dh.timestamp = hdr.time;
+            dh.num_points = 1;
+            bool ok = file.append(&dh, sizeof(dh)) &&
+                      file.append(bytes + cbPKT_HEADER_SIZE, have * sizeof(int16_t));
+            if (have < nchans) {
+                static constexpr int16_t zeros[cbNUM_ANALOG_CHANS] = {};
+                ok = ok && file.append(zeros, (nchans - have) * sizeof(int16_t));
+            }
+            continuous_packets.fetch_add(1, std::memory_order_relaxed);
+            return ok;
+        }
+
+        uint8_t out[MAX_NEV_PACKET] = {};
+        NevPacketHeader ph{hdr.time, 0};
+        const EventKind kind = event_kind[hdr.chid];
+        if (kind == EventKind::SPIKE) {
+            ph.packet_id = hdr.chid;
+            NevSpikePacket sp{ph, static_cast<uint8_t>(std::min<uint16_t>(hdr.type, 255)), 0};
+            std::memcpy(out, &sp, sizeof(sp));
+            constexpr size_t wave_offset = offsetof(cbPKT_SPK, wave);
+            const size_t available = size > wave_offset ? (size - wave_offset) / sizeof(int16_t) : 0;
+            const size_t samples = std::min<size_t>(available, spike_length);
+            std::memcpy(out + sizeof(sp), bytes + wave_offset, samples * sizeof(int16_t));
+            spike_packets.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            cbPKT_DINP dinp{};
+            std::memcpy(&dinp, bytes, std::min(size, sizeof(dinp)));
+            NevDigitalPacket dp{ph,
+                                kind == EventKind::SERIAL ? NEV_DIGITAL_REASON_SERIAL : NEV_DIGITAL_REASON_PARALLEL,
+                                0, static_cast<uint16_t>(dinp.valueRead)};
+            std::memcpy(out, &dp, sizeof(dp));
+            digital_packets.fetch_add(1, std::memory_order_relaxed);
+        }
+        return nev->append(out, nev_packet_bytes);
+    }
+
+    /// Append the encoder output to @p file and update the codec counters
+    bool flushEncoded(AlignedFileWriter& file) {
+        bool ok = true;
+        if (!encoded.empty()) {
+            ok = file.append(encoded.data(), encoded.size());
+            encoded.clear();
+        }
+        uint64_t raw = 0;
+        uint64_t coded = 0;
+        for (const auto& encoder : encoders) {
+            if (encoder) {
+                raw += encoder->stats().raw_bytes;
+                coded += encoder->stats().encoded_bytes;
+            }
+        }
+        continuous_raw_bytes.store(raw, std::memory_order_relaxed);
+        continuous_encoded_bytes.store(coded, std::memory_order_relaxed);
+        return ok;
+    }
+
+    uint64_t fileBytes() const {
+        uint64_t total = nev ? nev->size() : 0;
+        for (const auto& f : nsx) {
+            total += f.size();
+        }
+        return total;
+    }
+
+    void run() {
+        std::vector<uint8_t> back;
+        back.reserve(initialBufferBytes());
+        bool ok = true;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [this] { return stop_requested || !front.empty(); });
+                if (front.empty()) {
+                    break;  // stop requested and nothing left to write
+                }
+                back.swap(front);
+            }
+
+            size_t offset = 0;
+            while (offset + cbPKT_HEADER_SIZE <= back.size()) {
+                cbPKT_HEADER hdr;
+                std::memcpy(&hdr, &back[offset], sizeof(hdr));
+                const size_t size = cbPKT_HEADER_SIZE + size_t{hdr.dlen} * 4;
+                if (ok) {
+                    ok = writePacket(&back[offset], size);
+                    if (!ok) {
+                        write_errors.fetch_add(1, std::memory_order_relaxed);
+                        std::lock_guard<std::mutex> lock(mutex);
+                        failed = true;
+                    }
+                } else {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                offset += size;
+            }
+            pending_bytes.fetch_sub(back.size(), std::memory_order_relaxed);
+            bytes_written.store(fileBytes(), std::memory_order_relaxed);
+            back.clear();
+        }
+
+        bool closed = nev ? nev->finish() : true;
+        for (size_t i = 0; i < nsx.size(); ++i) {
+            if (auto& encoder = encoders[i]) {
+                // The chunk index and footer; after a write error the file stays recoverable
+                encoder->finish(encoded);
+                if (ok) {
+                    closed = flushEncoded(nsx[i]) && closed;
+                }
+                encoded.clear();
+            }
+            closed = nsx[i].finish() && closed;
+        }
+        if (ok && !closed) {
+            write_errors.fetch_add(1, std::memory_order_relaxed);
+        }
+        bytes_written.store(fileBytes(), std::memory_order_relaxed);
+    }
+
+    void shutdown() {
+        if (thread.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stop_requested = true;
+            }
+            cv.notify_one();
+            thread.join();
+        }
+    }
+
+    ~Impl() {
+        shutdown();
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Recorder
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Recorder::Recorder() = default;
+Recorder::Recorder(Recorder&&) noexcept = default;
+Recorder& Recorder::operator=(Recorder&&) noexcept = default;
+Recorder::~Recorder() = default;
+
+cbutil::Result<Recorder> Recorder::open(const std::string& base_path, const RecordingLayout& layout,
+                                        const RecordingOptions& options) {
+    if (base_path.empty()) {
+        return cbutil::Result<Recorder>::error("Recording path is empty");
+    }
+
+    auto impl = std::make_unique<Impl>();
+    impl->options = options;
+    impl->spike_length = std::clamp<uint32_t>(layout.spike_length, 1, cbMAX_PNTS);
+    impl->nev_packet_bytes = static_cast<uint32_t>(
+        std::max(sizeof(NevSpikePacket) + impl->spike_length * sizeof(int16_t), sizeof(NevDigitalPacket)));
+    impl->group_file.fill(-1);
+    impl->event_kind.fill(EventKind::NONE);
+
+    RecordingLayout effective = layout;
+    effective.spike_length = impl->spike_length;
+    for (const auto& ch : layout.event_channels) {
+        if (ch.info.chan >= 1 && ch.info.chan <= cbMAXCHANS) {
+            impl->event_kind[ch.info.chan] = classifyEventChannel(ch.info);
+        }
+    }
+
+    const FileTime origin = utcNow();
+    const auto create = [&](const std::string& path, const std::vector<uint8_t>& headers)
+        -> cbutil::Result<AlignedFileWriter> {
+        auto file = AlignedFileWriter::open(path, options.write_buffer_bytes, options.direct_io);
+        if (file.isError()) {
+            return file;
+        }
+        if (!file.value().append(headers.data(), headers.size())) {
+            return cbutil::Result<AlignedFileWriter>::error("Failed to write headers: " + path);
+        }
+        impl->paths.push_back(path);
+        return file;
+    };
+
+    auto nev = create(base_path + ".nev", nevHeaders(effective, options, origin, impl->nev_packet_bytes));
+    if (nev.isError()) {
+        return cbutil::Result<Recorder>::error(nev.error());
+    }
+    impl->direct_io = nev.value().isDirect();
+    impl->nev.emplace(std::move(nev.value()));
+
+    for (const auto& group : layout.groups) {
+        if (group.group_id == 0 || group.group_id > cbMAXGROUPS || group.channels.empty() ||
+            impl->group_file[group.group_id] >= 0) {
+            continue;
+        }
+        std::optional<ContinuousEncoder> encoder;
+        std::string path = base_path + ".ns" + std::to_string(group.group_id);
+        std::vector<uint8_t> headers;
+        if (options.compress_continuous) {
+            std::vector<uint16_t> ids;
+            for (const auto& ch : group.channels) {
+                ids.push_back(static_cast<uint16_t>(ch.info.chan));
+            }
+            auto created = ContinuousEncoder::create(ids, std::max<uint32_t>(group.period, 1), groupLabel(group),
+                                                     headers, options.compress_chunk_samples, TIME_RESOLUTION);
+            if (created.isError()) {
+                return cbutil::Result<Recorder>::error(created.error());
+            }
+            encoder.emplace(std::move(created.value()));
+            path = base_path + ".cbz" + std::to_string(group.group_id);
+        } else {
+            headers = nsxHeaders(group, options, origin);
+        }
+        auto nsx = create(path, headers);
+        if (nsx.isError()) {
+            return cbutil::Result<Recorder>::error(nsx.error());
+        }
+        impl->encoders.push_back(std::move(encoder));
+        impl->group_file[group.group_id] = static_cast<int>(impl->nsx.size());
+        impl->group_channels[group.group_id] = static_cast<uint32_t>(group.channels.size());
+        impl->nsx.push_back(std::move(nsx.value()));
+    }
+
+    impl->front.reserve(impl->initialBufferBytes());
+    impl->bytes_written.store(impl->fileBytes(), std::memory_order_relaxed);
+
+    Recorder recorder;
+    recorder.m_impl = std::move(impl);
+    Impl* p = recorder.m_impl.get();
+    recorder.m_impl->thread = std::thread([p] { p->run(); });
+    return cbutil::Result<Recorder>::ok(std::move(recorder));
+}
+
+void Recorder::write(const cbPKT_GENERIC* packets, const size_t count) {
+    if (!m_impl || !packets || count == 0) {
+        return;
+    }
+
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->mutex);
+        auto& buf = m_impl->front;
+        for (size_t i = 0; i < count; ++i) {
+            const auto& hdr = packets[i].cbpkt_header;
+            if (!m_impl->isRecorded(hdr)) {
+                continue;
+            }
+            const size_t size = std::min(cbPKT_HEADER_SIZE + size_t{hdr.dlen} * 4, sizeof(cbPKT_GENERIC));
+            if (m_impl->failed || m_impl->stop_requested ||
+                buf.size() + size > m_impl->options.max_pending_bytes) {
+                m_impl->dropped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            const size_t at = buf.size();
+            buf.resize(at + size);
+            std::memcpy(&buf[at], &packets[i], size);
+            // Keep the stored dlen consistent with the (possibly clamped) size
+            const auto dlen = static_cast<uint16_t>((size - cbPKT_HEADER_SIZE) / 4);
+            std::memcpy(&buf[at + offsetof(cbPKT_HEADER, dlen)], &dlen, sizeof(dlen));
+            m_impl->pending_bytes.fetch_add(size, std::memory_order_relaxed);
+            queued = true;
+        }
+    }
+    if (queued) {
+        m_impl->cv.notify_one();
+    }
+}
+
+void Recorder::close() {
+    if (m_impl) {
+        m_impl->shutdown();
+    }
+}
+
+RecorderStats Recorder::stats() const {
+    RecorderStats s;
+    if (m_impl) {
+        s.continuous_packets = m_impl->continuous_packets.load(std::memory_order_relaxed);
+        s.spike_packets = m_impl->spike_packets.load(std::memory_order_relaxed);
+        s.digital_packets = m_impl->digital_packets.load(std::memory_order_relaxed);
+        s.bytes_written = m_impl->bytes_written.load(std::memory_order_relaxed);
+        s.continuous_raw_bytes = m_impl->continuous_raw_bytes.load(std::memory_order_relaxed);
+        s.continuous_encoded_bytes = m_impl->continuous_encoded_bytes.load(std::memory_order_relaxed);
+        s.packets_dropped = m_impl->dropped.load(std::memory_order_relaxed);
+        s.write_errors = m_impl->write_errors.load(std::memory_order_relaxed);
+        s.pending_bytes = m_impl->pending_bytes.load(std::memory_order_relaxed);
+        s.direct_io = m_impl->direct_io;
+    }
+    return s;
+}
+
+const std::vector<std::string>& Recorder::files() const {
+    static const std::vector<std::string> none;
+    return m_impl ? m_impl->paths : none;
+}
+
+} // namespace cbsdk
@@ -0,0 +1,220 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   rereference.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Common average / median and electrode re-referencing
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/rereference.h"
+
+#include <cbutil/simd.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+namespace cbsdk {
+
+namespace {
+
+/// Samples per SIMD step; block rows are padded to a multiple of this
+constexpr size_t LANES = 4;
+
+/// Rows transposed at a time, bounding the scratch block
+constexpr size_t CHUNK_ROWS = 256;
+
+/// dst[i] += src[i] for i < n (n a multiple of LANES)
+void addRow(float* dst, const float* src, const size_t n) {
+    size_t i = 0;
+#ifdef CBUTIL_HAVE_SSE2
+    for (; i < n; i += LANES) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+/// dst[i] *= k for i < n (n a multiple of LANES)
+void scaleRow(float* dst, const float k, const size_t n) {
+    size_t i = 0;
+#ifdef CBUTIL_HAVE_SSE2
+    const __m128 kk = _mm_set1_ps(k);
+    for (; i < n; i += LANES) {
+        _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_loadu_ps(dst + i), kk));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] *= k;
+    }
+}
+
+/// dst[i] = a[i] - b[i] for i < n (n a multiple of LANES)
+void subtractRow(float* dst, const float* a, const float* b, const size_t n) {
+    size_t i = 0;
+#ifdef CBUTIL_HAVE_SSE2
+    for (; i < n; i += LANES) {
+        _mm_storeu_ps(dst + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] = a[i] - b[i];
+    }
+}
+
+int16_t toSample(const float v) {
+    const float clamped = std::min(std::max(v, -32768.0f), 32767.0f);
+    return static_cast<int16_t>(clamped < 0.0f ? clamped - 0.5f : clamped + 0.5f);
+}
+
+} // anonymous namespace
+
+struct Rereferencer::Impl {
+    size_t channels = 0;
+    bool electrode = false;
+    ReferenceStatistic statistic = ReferenceStatistic::MEAN;
+    std::vector<int32_t> pool_of;               // per column: pool index or -1
+    std::vector<std::vector<uint32_t>> members; // per pool: its columns
+    std::vector<int32_t> references;            // per column: reference column or -1
+
+    std::vector<float> block;       // [channels][stride]: the chunk, channel-major
+    std::vector<float> refs;        // [pools][stride]: each pool's reference per sample
+    std::vector<float> diff;        // [stride]: one re-referenced column
+    std::vector<float> values;      // one pool's values at one sample (median)
+
+    void poolReferences(const size_t n, const size_t stride) {
+        for (size_t p = 0; p < members.size(); ++p) {
+            float* ref = &refs[p * stride];
+            const auto& cols = members[p];
+            if (statistic == ReferenceStatistic::MEAN) {
+                std::fill_n(ref, stride, 0.0f);
+                for (const uint32_t c : cols) {
+                    addRow(ref, &block[c * stride], stride);
+                }
+                scaleRow(ref, 1.0f / static_cast<float>(cols.size()), stride);
+                continue;
+            }
+            const size_t mid = cols.size() / 2;
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t k = 0; k < cols.size(); ++k) {
+                    values[k] = block[cols[k] * stride + i];
+                }
+                std::nth_element(values.begin(), values.begin() + mid, values.begin() + cols.size());
+                float m = values[mid];
+                if (cols.size() % 2 == 0) {
+                    m = 0.5f * (m + *std::max_element(values.begin(), values.begin() + mid));
+                }
+                ref[i] = m;
+            }
+        }
+    }
+
+    void processChunk(int16_t* samples, const size_t n) {
+        const size_t stride = (n + LANES - 1) / LANES * LANES;
+        for (size_t r = 0; r < n; ++r) {
+            const int16_t* row = samples + r * channels;
+            for (size_t c = 0; c < channels; ++c) {
+                block[c * stride + r] = row[c];
+            }
+        }
+        if (!electrode) {
+            poolReferences(n, stride);
+        }
+        for (size_t c = 0; c < channels; ++c) {
+            const float* reference = nullptr;
+            if (electrode) {
+                reference = references[c] < 0 ? nullptr : &block[static_cast<size_t>(references[c]) * stride];
+            } else {
+                reference = pool_of[c] < 0 ? nullptr : &refs[static_cast<size_t>(pool_of[c]) * stride];
+            }
+            if (!reference) {
+                continue;
+            }
+            subtractRow(diff.data(), &block[c * stride], reference, stride);
+            for (size_t r = 0; r < n; ++r) {
+                samples[r * channels + c] = toSample(diff[r]);
+            }
+        }
+    }
+};
+
+Rereferencer::Rereferencer() = default;
+Rereferencer::Rereferencer(Rereferencer&&) noexcept = default;
+Rereferencer& Rereferencer::operator=(Rereferencer&&) noexcept = default;
+Rereferencer::~Rereferencer() = default;
+
+cbutil::Result<Rereferencer> Rereferencer::createPooled(std::vector<int32_t> pools,
+                                                        const ReferenceStatistic statistic) {
+    if (pools.empty()) {
+        return cbutil::Result<Rereferencer>::error("Re-referencing needs at least one channel");
+    }
+    auto impl = std::make_unique<Impl>();
+    impl->channels = pools.size();
+    impl->statistic = statistic;
+    impl->pool_of.assign(pools.size(), -1);
+
+    // Number pools in order of first appearance
+    std::map<int32_t, int32_t> index;
+    size_t largest = 0;
+    for (size_t c = 0; c < pools.size(); ++c) {
+        if (pools[c] < 0) {
+            continue;
+        }
+        const auto it = index.emplace(pools[c], static_cast<int32_t>(index.size())).first;
+        impl->pool_of[c] = it->second;
+        if (impl->members.size() <= static_cast<size_t>(it->second)) {
+            impl->members.emplace_back();
+        }
+        impl->members[it->second].push_back(static_cast<uint32_t>(c));
+        largest = std::max(largest, impl->members[it->second].size());
+    }
+    impl->values.resize(largest);
+    impl->block.assign(impl->channels * CHUNK_ROWS, 0.0f);
+    impl->refs.assign(impl->members.size() * CHUNK_ROWS, 0.0f);
+    impl->diff.assign(CHUNK_ROWS, 0.0f);
+
+    Rereferencer rereferencer;
+    rereferencer.m_impl = std::move(impl);
+    return cbutil::Result<Rereferencer>::ok(std::move(rereferencer));
+}
+
+cbutil::Result<Rereferencer> Rereferencer::createElectrode(std::vector<int32_t> references) {
+    using R = cbutil::Result<Rereferencer>;
+    if (references.empty()) {
+        return R::error("Re-referencing needs at least one channel");
+    }
+    for (const int32_t ref : references) {
+        if (ref >= static_cast<int32_t>(references.size())) {
+            return R::error("Reference column " + std::to_string(ref) + " is out of range");
+        }
+    }
+    auto impl = std::make_unique<Impl>();
+    impl->channels = references.size();
+    impl->electrode = true;
+    impl->references = std::move(references);
+    impl->block.assign(impl->channels * CHUNK_ROWS, 0.0f);
+    impl->diff.assign(CHUNK_ROWS, 0.0f);
+
+    Rereferencer rereferencer;
+    rereferencer.m_impl = std::move(impl);
+    return R::ok(std::move(rereferencer));
+}
+
+void Rereferencer::process(int16_t* samples, const size_t n_samples) {
+    for (size_t r = 0; r < n_samples; r += CHUNK_ROWS) {
+        m_impl->processChunk(samples + r * m_impl->channels, std::min(CHUNK_ROWS, n_samples - r));
+    }
+}
+
+size_t Rereferencer::channelCount() const {
+    return m_impl->channels;
+}
+
+size_t Rereferencer::poolCount() const {
+    return m_impl->members.size();
+}
+
+} // namespace cbsdk
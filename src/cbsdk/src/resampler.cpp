@@ -0,0 +1,310 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   resampler.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Polyphase FIR resampler
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/resampler.h"
+
+#include <cbutil/simd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <string>
+
+namespace cbsdk {
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+/// Channels per SIMD step; history rows are padded to a multiple of this
+constexpr size_t LANES = 4;
+
+/// Kaiser window shape (scipy.signal.resample_poly's default)
+constexpr double KAISER_BETA = 5.0;
+
+/// Taps on each side of the centre, per unit of max(up, down)
+constexpr uint32_t HALF_LENGTH_PER_FACTOR = 10;
+
+/// Zeroth-order modified Bessel function of the first kind
+double besselI0(const double x) {
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 64; ++k) {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+        if (term < sum * 1e-17) {
+            break;
+        }
+    }
+    return sum;
+}
+
+cbutil::Result<void> checkFactors(const uint32_t up, const uint32_t down) {
+    if (up == 0 || down == 0 || up > RESAMPLER_MAX_FACTOR || down > RESAMPLER_MAX_FACTOR) {
+        return cbutil::Result<void>::error("Resampling factors must be 1-" + std::to_string(RESAMPLER_MAX_FACTOR));
+    }
+    return cbutil::Result<void>::ok();
+}
+
+} // anonymous namespace
+
+cbutil::Result<std::vector<float>> designResamplerTaps(uint32_t up, uint32_t down) {
+    auto ok = checkFactors(up, down);
+    if (ok.isError()) {
+        return cbutil::Result<std::vector<float>>::error(ok.error());
+    }
+    const uint32_t g = std::gcd(up, down);
+    up /= g;
+    down /= g;
+
+    const uint32_t max_factor = std::max(up, down);
+    const size_t n_taps = 2 * HALF_LENGTH_PER_FACTOR * max_factor + 1;
+    const double centre = (n_taps - 1) / 2.0;
+    const double cutoff = 1.0 / max_factor;     // fraction of the upsampled Nyquist rate
+    const double i0_beta = besselI0(KAISER_BETA);
+
+    std::vector<double> h(n_taps);
+    double sum = 0.0;
+    for (size_t n = 0; n < n_taps; ++n) {
+        const double m = n - centre;
+        const double x = PI * cutoff * m;
+        const double sinc = m == 0.0 ? 1.0 : std::sin(x) / x;
+        const double r = m / centre;
+        h[n] = cutoff * sinc * besselI0(KAISER_BETA * std::sqrt(std::max(0.0, 1.0 - r * r))) / i0_beta;
+        sum += h[n];
+    }
+
+    std::vector<float> taps(n_taps);
+    for (size_t n = 0; n < n_taps; ++n) {
+        taps[n] = static_cast<float>(h[n] * up / sum);
+    }
+    return cbutil::Result<std::vector<float>>::ok(std::move(taps));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// PolyphaseResampler
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct PolyphaseResampler::Impl {
+    uint32_t up = 1;
+    uint32_t down = 1;
+    size_t channels = 0;
+    size_t padded = 0;              // channels rounded up to LANES
+    size_t branch_taps = 0;         // taps per polyphase branch
+    int64_t delay = 0;              // filter centre, in upsampled samples
+    std::vector<float> branches;    // [phase][branch_taps]: taps[phase + m * up]
+
+    // Input history: rows [first, first + rows) of the stream, float [row][padded]
+    std::vector<float> history;
+    std::vector<uint64_t> history_ts;
+    int64_t first = 0;
+    size_t rows = 0;
+    int64_t next_output = 0;        // index of the next output sample
+
+    std::vector<float> acc;         // [padded]: the output being computed
+
+    void clear() {
+        // branch_taps - 1 rows of silence before the stream starts
+        rows = branch_taps - 1;
+        first = -static_cast<int64_t>(rows);
+        history.assign(rows * padded, 0.0f);
+        history_ts.assign(rows, 0);
+        // The first output is the one representing input sample 0
+        next_output = (delay + down - 1) / down;
+    }
+
+    /// acc[] = branch @p phase applied to the rows ending at absolute row @p newest
+    void convolve(const uint32_t phase, const int64_t newest) {
+        const float* h = &branches[phase * branch_taps];
+        const float* x0 = &history[static_cast<size_t>(newest - first) * padded];
+        size_t c = 0;
+#ifdef CBUTIL_HAVE_SSE2
+        // Sixteen channels at a time keeps four accumulators in registers across all taps
+        for (; c + 4 * LANES <= padded; c += 4 * LANES) {
+            __m128 a0 = _mm_setzero_ps();
+            __m128 a1 = _mm_setzero_ps();
+            __m128 a2 = _mm_setzero_ps();
+            __m128 a3 = _mm_setzero_ps();
+            const float* x = x0 + c;
+            for (size_t m = 0; m < branch_taps; ++m, x -= padded) {
+                const __m128 k = _mm_set1_ps(h[m]);
+                a0 = _mm_add_ps(a0, _mm_mul_ps(k, _mm_loadu_ps(x)));
+                a1 = _mm_add_ps(a1, _mm_mul_ps(k, _mm_loadu_ps(x + LANES)));
+                a2 = _mm_add_ps(a2, _mm_mul_ps(k, _mm_loadu_ps(x + 2 * LANES)));
+                a3 = _mm_add_ps(a3, _mm_mul_ps(k, _mm_loadu_ps(x + 3 * LANES)));
+            }
+            _mm_storeu_ps(&acc[c], a0);
+            _mm_storeu_ps(&acc[c + LANES], a1);
+            _mm_storeu_ps(&acc[c + 2 * LANES], a2);
+            _mm_storeu_ps(&acc[c + 3 * LANES], a3);
+        }
+        for (; c < padded; c += LANES) {
+            __m128 a = _mm_setzero_ps();
+            const float* x = x0 + c;
+            for (size_t m = 0; m < branch_taps; ++m, x -= padded) {
+                a = _mm_add_ps(a, _mm_mul_ps(_mm_set1_ps(h[m]), _mm_loadu_ps(x)));
+            }
+            _mm_storeu_ps(&acc[c], a);
+        }
+#else
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        const float* x = x0;
+        for (size_t m = 0; m < branch_taps; ++m, x -= padded) {
+            for (c = 0; c < padded; ++c) {
+                acc[c] += h[m] * x[c];
+            }
+        }
+#endif
+    }
+
+    /// Timestamp of upsampled position @p pos, interpolated between input rows
+    uint64_t timestampAt(const int64_t pos) const {
+        const int64_t row = pos / up;
+        const auto frac = static_cast<uint64_t>(pos % up);
+        const size_t i = static_cast<size_t>(row - first);
+        const uint64_t t = history_ts[i];
+        if (frac == 0) {
+            return t;
+        }
+        // Step to the next row; at the newest row, assume the previous row's spacing
+        uint64_t step = 0;
+        if (i + 1 < rows) {
+            step = history_ts[i + 1] - t;
+        } else if (i > 0 && row > 0) {
+            step = t - history_ts[i - 1];
+        }
+        return t + step * frac / up;
+    }
+};
+
+PolyphaseResampler::PolyphaseResampler() = default;
+PolyphaseResampler::PolyphaseResampler(PolyphaseResampler&&) noexcept = default;
+PolyphaseResampler& PolyphaseResampler::operator=(PolyphaseResampler&&) noexcept = default;
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+cbutil::Result<PolyphaseResampler> PolyphaseResampler::create(const uint32_t up, const uint32_t down,
+                                                              const size_t channel_count) {
+    auto taps = designResamplerTaps(up, down);
+    if (taps.isError()) {
+        return cbutil::Result<PolyphaseResampler>::error(taps.error());
+    }
+    return create(up, down, std::move(taps.value()), channel_count);
+}
+
+cbutil::Result<PolyphaseResampler> PolyphaseResampler::create(uint32_t up, uint32_t down, std::vector<float> taps,
+                                                              const size_t channel_count) {
+    using R = cbutil::Result<PolyphaseResampler>;
+    auto ok = checkFactors(up, down);
+    if (ok.isError()) {
+        return R::error(ok.error());
+    }
+    if (taps.empty()) {
+        return R::error("Resampler needs at least one tap");
+    }
+    if (channel_count == 0) {
+        return R::error("Resampler needs at least one channel");
+    }
+    const uint32_t g = std::gcd(up, down);
+    up /= g;
+    down /= g;
+
+    auto impl = std::make_unique<Impl>();
+    impl->up = up;
+    impl->down = down;
+    impl->channels = channel_count;
+    impl->padded = (channel_count + LANES - 1) / LANES * LANES;
+    impl->branch_taps = (taps.size() + up - 1) / up;
+    impl->delay = static_cast<int64_t>(taps.size() - 1) / 2;
+    impl->branches.assign(up * impl->branch_taps, 0.0f);
+    for (size_t n = 0; n < taps.size(); ++n) {
+        impl->branches[(n % up) * impl->branch_taps + n / up] = taps[n];
+    }
+    impl->acc.assign(impl->padded, 0.0f);
+    impl->clear();
+
+    PolyphaseResampler resampler;
+    resampler.m_impl = std::move(impl);
+    return R::ok(std::move(resampler));
+}
+
+size_t PolyphaseResampler::maxOutput(const size_t n_samples) const {
+    return (n_samples * m_impl->up + m_impl->down - 1) / m_impl->down + 1;
+}
+
+size_t PolyphaseResampler::process(const int16_t* in, const uint64_t* timestamps, const size_t n_samples,
+                                   int16_t* out, uint64_t* out_timestamps) {
+    auto& s = *m_impl;
+
+    // Append the new rows to the history
+    s.history.resize((s.rows + n_samples) * s.padded, 0.0f);
+    s.history_ts.resize(s.rows + n_samples);
+    for (size_t r = 0; r < n_samples; ++r) {
+        float* dst = &s.history[(s.rows + r) * s.padded];
+        const int16_t* src = in + r * s.channels;
+        for (size_t c = 0; c < s.channels; ++c) {
+            dst[c] = src[c];
+        }
+        s.history_ts[s.rows + r] = timestamps[r];
+    }
+    s.rows += n_samples;
+    const int64_t newest = s.first + static_cast<int64_t>(s.rows) - 1;
+
+    // Every output whose newest input has arrived
+    size_t produced = 0;
+    for (;; ++s.next_output) {
+        const int64_t pos = s.next_output * s.down;
+        const int64_t row = pos / s.up;
+        if (row > newest) {
+            break;
+        }
+        s.convolve(static_cast<uint32_t>(pos % s.up), row);
+        int16_t* y = out + produced * s.channels;
+        for (size_t c = 0; c < s.channels; ++c) {
+            const float v = std::min(std::max(s.acc[c], -32768.0f), 32767.0f);
+            y[c] = static_cast<int16_t>(v < 0.0f ? v - 0.5f : v + 0.5f);
+        }
+        out_timestamps[produced] = s.timestampAt(pos - s.delay);
+        ++produced;
+    }
+
+    // Keep the rows the next output still reaches, plus one for timestamp spacing.  Rows are
+    // only discarded once there are as many stale ones as live ones, so the shift is amortised.
+    const int64_t next_row = s.next_output * s.down / s.up;
+    const int64_t keep_from = next_row - static_cast<int64_t>(s.branch_taps);
+    if (keep_from - s.first >= static_cast<int64_t>(s.branch_taps)) {
+        const auto drop = static_cast<size_t>(std::min<int64_t>(keep_from - s.first, s.rows));
+        s.history.erase(s.history.begin(), s.history.begin() + static_cast<std::ptrdiff_t>(drop * s.padded));
+        s.history_ts.erase(s.history_ts.begin(), s.history_ts.begin() + static_cast<std::ptrdiff_t>(drop));
+        s.rows -= drop;
+        s.first += static_cast<int64_t>(drop);
+    }
+    return produced;
+}
+
+void PolyphaseResampler::reset() {
+    m_impl->clear();
+}
+
+uint32_t PolyphaseResampler::up() const {
+    return m_impl->up;
+}
+
+uint32_t PolyphaseResampler::down() const {
+    return m_impl->down;
+}
+
+size_t PolyphaseResampler::channelCount() const {
+    return m_impl->channels;
+}
+
+double PolyphaseResampler::groupDelay() const {
+    return static_cast<double>(m_impl->delay) / m_impl->up;
+}
+
+} // namespace cbsdk
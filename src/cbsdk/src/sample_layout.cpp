@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   sample_layout.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Transposition and physical-unit scaling of batches of continuous samples
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/sample_layout.h"
+
+#include <cbutil/simd.h>
+
+#include <algorithm>
+
+namespace cbsdk {
+
+namespace {
+
+/// Samples per block: 64 rows of the widest group (272 channels) are 34 KB
+constexpr size_t BLOCK_SAMPLES = 64;
+
+/// Channels (and samples) per tile
+constexpr size_t TILE = 8;
+
+#ifdef CBUTIL_HAVE_SSE2
+/// Load the 8 x 8 tile at @p in (rows @p stride samples apart) and transpose it: col[k] gets
+/// the eight samples of the tile's channel k
+void loadTransposedTile(const int16_t* in, const size_t stride, __m128i col[TILE]) {
+    __m128i r[TILE];
+    for (size_t i = 0; i < TILE; ++i) {
+        r[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * stride));
+    }
+    const __m128i a0 = _mm_unpacklo_epi16(r[0], r[1]);
+    const __m128i a1 = _mm_unpackhi_epi16(r[0], r[1]);
+    const __m128i a2 = _mm_unpacklo_epi16(r[2], r[3]);
+    const __m128i a3 = _mm_unpackhi_epi16(r[2], r[3]);
+    const __m128i a4 = _mm_unpacklo_epi16(r[4], r[5]);
+    const __m128i a5 = _mm_unpackhi_epi16(r[4], r[5]);
+    const __m128i a6 = _mm_unpacklo_epi16(r[6], r[7]);
+    const __m128i a7 = _mm_unpackhi_epi16(r[6], r[7]);
+    const __m128i b0 = _mm_unpacklo_epi32(a0, a2);
+    const __m128i b1 = _mm_unpackhi_epi32(a0, a2);
+    const __m128i b2 = _mm_unpacklo_epi32(a1, a3);
+    const __m128i b3 = _mm_unpackhi_epi32(a1, a3);
+    const __m128i b4 = _mm_unpacklo_epi32(a4, a6);
+    const __m128i b5 = _mm_unpackhi_epi32(a4, a6);
+    const __m128i b6 = _mm_unpacklo_epi32(a5, a7);
+    const __m128i b7 = _mm_unpackhi_epi32(a5, a7);
+    col[0] = _mm_unpacklo_epi64(b0, b4);
+    col[1] = _mm_unpackhi_epi64(b0, b4);
+    col[2] = _mm_unpacklo_epi64(b1, b5);
+    col[3] = _mm_unpackhi_epi64(b1, b5);
+    col[4] = _mm_unpacklo_epi64(b2, b6);
+    col[5] = _mm_unpackhi_epi64(b2, b6);
+    col[6] = _mm_unpacklo_epi64(b3, b7);
+    col[7] = _mm_unpackhi_epi64(b3, b7);
+}
+
+/// Sign-extend the low (or high) four int16 of @p v to float
+__m128 widenLow(const __m128i v) {
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16));
+}
+__m128 widenHigh(const __m128i v) {
+    return _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16));
+}
+#endif
+
+float scale(const int16_t raw, const ChannelScale& s) {
+    return static_cast<float>(raw) * s.gain + s.offset;
+}
+
+/// Channel-major output of scaleSamples()
+///
+/// Tiles are four channels by four samples: each row of the tile is widened and scaled with
+/// the channels' gains and offsets as vectors (lanes are channels), then the tile is
+/// transposed in float registers and stored as four channel runs.
+void scaleToChannelMajor(const int16_t* in, const size_t n_samples, const size_t n_channels,
+                         const ChannelScale* scales, float* out) {
+    for (size_t s0 = 0; s0 < n_samples; s0 += BLOCK_SAMPLES) {
+        const size_t s_end = std::min(n_samples, s0 + BLOCK_SAMPLES);
+        size_t c = 0;
+#ifdef CBUTIL_HAVE_SSE2
+        for (; c + 4 <= n_channels; c += 4) {
+            const float* sc = reinterpret_cast<const float*>(scales + c);
+            const __m128 p0 = _mm_loadu_ps(sc), p1 = _mm_loadu_ps(sc + 4);
+            const __m128 gain = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 offset = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+            float* dst = out + c * n_samples;
+            size_t s = s0;
+            for (; s + 4 <= s_end; s += 4) {
+                const int16_t* src = in + s * n_channels + c;
+                __m128 r[4];
+                for (size_t i = 0; i < 4; ++i) {
+                    const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * n_channels));
+                    r[i] = _mm_add_ps(_mm_mul_ps(widenLow(v), gain), offset);
+                }
+                _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+                for (size_t k = 0; k < 4; ++k) {
+                    _mm_storeu_ps(dst + k * n_samples + s, r[k]);
+                }
+            }
+            for (; s < s_end; ++s) {
+                for (size_t k = 0; k < 4; ++k) {
+                    dst[k * n_samples + s] = scale(in[s * n_channels + c + k], scales[c + k]);
+                }
+            }
+        }
+#endif
+        for (; c < n_channels; ++c) {
+            for (size_t s = s0; s < s_end; ++s) {
+                out[c * n_samples + s] = scale(in[s * n_channels + c], scales[c]);
+            }
+        }
+    }
+}
+
+/// Sample-major output of scaleSamples()
+void scaleToSampleMajor(const int16_t* in, const size_t n_samples, const size_t n_channels,
+                        const ChannelScale* scales, float* out) {
+    for (size_t s0 = 0; s0 < n_samples; s0 += BLOCK_SAMPLES) {
+        const size_t s_end = std::min(n_samples, s0 + BLOCK_SAMPLES);
+        size_t c = 0;
+#ifdef CBUTIL_HAVE_SSE2
+        for (; c + TILE <= n_channels; c += TILE) {
+            // scales is {gain, offset} pairs: deinterleave the tile's eight into vectors
+            const float* sc = reinterpret_cast<const float*>(scales + c);
+            const __m128 p0 = _mm_loadu_ps(sc), p1 = _mm_loadu_ps(sc + 4);
+            const __m128 p2 = _mm_loadu_ps(sc + 8), p3 = _mm_loadu_ps(sc + 12);
+            const __m128 gain_lo = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 offset_lo = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+            const __m128 gain_hi = _mm_shuffle_ps(p2, p3, _MM_SHUFFLE(2, 0, 2, 0));
+            const __m128 offset_hi = _mm_shuffle_ps(p2, p3, _MM_SHUFFLE(3, 1, 3, 1));
+            for (size_t s = s0; s < s_end; ++s) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + s * n_channels + c));
+                float* dst = out + s * n_channels + c;
+                _mm_storeu_ps(dst, _mm_add_ps(_mm_mul_ps(widenLow(v), gain_lo), offset_lo));
+                _mm_storeu_ps(dst + 4, _mm_add_ps(_mm_mul_ps(widenHigh(v), gain_hi), offset_hi));
+            }
+        }
+#endif
+        for (; c < n_channels; ++c) {
+            for (size_t s = s0; s < s_end; ++s) {
+                out[s * n_channels + c] = scale(in[s * n_channels + c], scales[c]);
+            }
+        }
+    }
+}
+
+} // anonymous namespace
+
+static_assert(sizeof(ChannelScale) == 2 * sizeof(float), "scaleToSampleMajor() loads ChannelScale pairs");
+
+ChannelScale channelScale(const cbSCALING& scaling) {
+    const int32_t dig_span = static_cast<int32_t>(scaling.digmax) - scaling.digmin;
+    if (dig_span <= 0) {
+        return {};
+    }
+    double unit_uv = 1.0;                           // "uV", or not a voltage
+    if (scaling.anaunit[0] == 'm' && scaling.anaunit[1] == 'V') {
+        unit_uv = 1e3;
+    } else if (scaling.anaunit[0] == 'V') {
+        unit_uv = 1e6;
+    }
+    const double gain = unit_uv * (static_cast<double>(scaling.anamax) - scaling.anamin) / dig_span;
+    ChannelScale s;
+    s.gain = static_cast<float>(gain);
+    s.offset = static_cast<float>(unit_uv * scaling.anamin - gain * scaling.digmin);
+    return s;
+}
+
+void transposeSamples(const int16_t* in, const size_t n_samples, const size_t n_channels, int16_t* out) {
+    for (size_t s0 = 0; s0 < n_samples; s0 += BLOCK_SAMPLES) {
+        const size_t s_end = std::min(n_samples, s0 + BLOCK_SAMPLES);
+        size_t c = 0;
+#ifdef CBUTIL_HAVE_SSE2
+        for (; c + TILE <= n_channels; c += TILE) {
+            size_t s = s0;
+            for (; s + TILE <= s_end; s += TILE) {
+                __m128i col[TILE];
+                loadTransposedTile(in + s * n_channels + c, n_channels, col);
+                for (size_t k = 0; k < TILE; ++k) {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + (c + k) * n_samples + s), col[k]);
+                }
+            }
+            for (; s < s_end; ++s) {
+                for (size_t k = 0; k < TILE; ++k) {
+                    out[(c + k) * n_samples + s] = in[s * n_channels + c + k];
+                }
+            }
+        }
+#endif
+        for (; c < n_channels; ++c) {
+            for (size_t s = s0; s < s_end; ++s) {
+                out[c * n_samples + s] = in[s * n_channels + c];
+            }
+        }
+    }
+}
+
+void scaleSamples(const int16_t* in, const size_t n_samples, const size_t n_channels, const ChannelScale* scales,
+                  const SampleLayout layout, float* out) {
+    if (layout == SampleLayout::CHANNEL_MAJOR) {
+        scaleToChannelMajor(in, n_samples, n_channels, scales, out);
+    } else {
+        scaleToSampleMajor(in, n_samples, n_channels, scales, out);
+    }
+}
+
+} // namespace cbsdk
@@ -18,9 +18,15 @@
 
 #include "cbsdk/sdk_session.h"
 #include "cmp_parser.h"
+#include "config_tracker.h"
+#include "config_transaction.h"
+#include "processing_pipeline.h"
 #include "cbdev/device_factory.h"
 #include "cbdev/connection.h"
 #include "cbshm/shmem_session.h"
+#include "cbshm/stats_segment.h"
+#include <cbproto/packet_traits.h>
+#include <cbutil/latency_histogram.h>
 #include <ccfutils/ccf_config.h>
 #include <CCFUtils.h>
 #include <thread>
@@ -30,6 +36,7 @@
 #include <iostream>
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <set>
 #include <vector>
 #include <unordered_map>
@@ -260,17 +267,47 @@ struct SdkSession::Impl {
     struct PacketCB     { CallbackHandle handle; PacketCallback cb; };
     struct EventCB      { CallbackHandle handle; ChannelType channel_type; EventCallback cb; };
     struct GroupCB       { CallbackHandle handle; uint8_t group_id; GroupCallback cb; };
-    struct GroupBatchCB  { CallbackHandle handle; uint8_t group_id; GroupBatchCallback cb; };
     struct ConfigCB     { CallbackHandle handle; uint16_t packet_type; ConfigCallback cb; };
     struct RunlevelCB   { CallbackHandle handle; RunlevelCallback cb; };
 
     std::vector<PacketCB>     packet_callbacks;
     std::vector<EventCB>      event_callbacks;
     std::vector<GroupCB>       group_callbacks;
-    std::vector<GroupBatchCB>  group_batch_callbacks;
     std::vector<ConfigCB>     config_callbacks;
     std::vector<RunlevelCB>   runlevel_callbacks;
 
+    // Batch stages (see processing_pipeline.h).  Published as an immutable snapshot: the
+    // dispatching thread reads it with one atomic load, registration edits a copy under
+    // user_callback_mutex and swaps it in.
+    std::shared_ptr<const ProcessingPipeline> pipeline = std::make_shared<const ProcessingPipeline>();
+    VirtualGroupId next_virtual_group = 1;
+    BandPowerStreamId next_band_power_stream = 1;
+    EpochStreamId next_epoch_stream = 1;
+    static constexpr auto BATCH_FLUSH_INTERVAL = std::chrono::milliseconds(1);   // max_delay_us resolution
+
+    std::shared_ptr<const ProcessingPipeline> loadPipeline() const {
+        return std::atomic_load_explicit(&pipeline, std::memory_order_acquire);
+    }
+
+    /// Publish a copy of the pipeline changed by @p edit (caller holds user_callback_mutex)
+    template <typename Edit>
+    void editPipeline(Edit&& edit) {
+        auto next = std::make_shared<ProcessingPipeline>(*loadPipeline());
+        edit(*next);
+        next->accumulating = static_cast<size_t>(
+            std::count_if(next->group_batch_callbacks.begin(), next->group_batch_callbacks.end(),
+                          [](const GroupBatchCB& cb) { return cb.accumulator != nullptr; }));
+        std::atomic_store_explicit(&pipeline, std::shared_ptr<const ProcessingPipeline>(std::move(next)),
+                                   std::memory_order_release);
+    }
+
+    VirtualGroupId addVirtualGroup(std::shared_ptr<VirtualGroup> group) {
+        std::lock_guard<std::mutex> lock(user_callback_mutex);
+        group->id = next_virtual_group++;
+        editPipeline([&](ProcessingPipeline& p) { p.virtual_groups.push_back(group); });
+        return group->id;
+    }
+
     /// Atomically update device_runlevel; fire registered callbacks if the
     /// value changed.  Called from the receive thread (STANDALONE) or the
     /// shmem-receive thread (CLIENT) — both paths converge here.
@@ -291,8 +328,21 @@ struct SdkSession::Impl {
     ErrorCallback error_callback;
     std::mutex user_callback_mutex;
 
+    // Local NSx/NEV recording (see startRecording()).  The recorder is a pipeline stage;
+    // recording_mutex serializes start/stop.
+    std::mutex recording_mutex;
+    RecorderStats last_recording_stats;
+
+    // In-flight asynchronous configuration (acknowledged by CHANREP*, see config_tracker.h)
+    ConfigTracker config_tracker;
+
+    // Open configuration transaction, if any (see beginConfigTransaction()): the staged setter
+    // calls, each collecting its edits when the transaction commits
+    mutable std::mutex txn_mutex;
+    std::optional<std::vector<std::function<ConfigTransaction()>>> txn;
+
     // Channel type cache — pre-computed at config time, avoids per-packet getChanInfo() (Phase 3, Fix 10)
-    std::array<ChannelType, cbMAXCHANS> channel_type_cache;
+    ChannelTypeTable channel_type_cache;
     bool channel_cache_valid = false;
 
     // CMP (channel mapping) overlay. Keyed by cmpKey(bank, term) →
@@ -426,6 +476,81 @@ struct SdkSession::Impl {
     };
     AtomicStats stats;
 
+    // Published stats (see cbshm/stats_segment.h).  STANDALONE owns the segment and the
+    // send thread publishes into it; a NATIVE CLIENT maps it read-only on first use.
+    mutable std::optional<cbshm::StatsSegment> stats_segment;
+    mutable std::mutex stats_segment_mutex;     // CLIENT lazy open only
+    std::atomic<uint64_t> receive_thread_cpu_ns{0};
+    std::atomic<uint64_t> callback_thread_cpu_ns{0};
+    std::atomic<uint64_t> send_thread_cpu_ns{0};
+    std::chrono::steady_clock::time_point last_receive_cpu_sample{};   // Receive thread only
+    static constexpr auto STATS_PUBLISH_INTERVAL = std::chrono::milliseconds(100);
+
+    /// Copy the counters into the stats segment (send thread only)
+    void publishStats() {
+        const SdkStats s = stats.snapshot();
+        cbshm::NativeStatsBuffer out{};
+        out.publish_steady_ns = steadyNs(std::chrono::steady_clock::now());
+        const auto last_recv = device_session->getLastReceiveTime();
+        out.last_datagram_steady_ns =
+            last_recv == std::chrono::steady_clock::time_point{} ? 0 : steadyNs(last_recv);
+        out.packets_received_from_device = s.packets_received_from_device;
+        out.bytes_received_from_device = s.bytes_received_from_device;
+        out.packets_stored_to_shmem = s.packets_stored_to_shmem;
+        out.packets_queued_for_callback = s.packets_queued_for_callback;
+        out.packets_delivered_to_callback = s.packets_delivered_to_callback;
+        out.packets_dropped = s.packets_dropped;
+        out.queue_current_depth = packet_queue.size();
+        out.queue_max_depth = s.queue_max_depth;
+        out.queue_capacity = packet_queue.capacity();
+        out.packets_sent_to_device = s.packets_sent_to_device;
+        out.shmem_store_errors = s.shmem_store_errors;
+        out.receive_errors = s.receive_errors;
+        out.send_errors = s.send_errors;
+        out.receive_thread_cpu_ns = receive_thread_cpu_ns.load(std::memory_order_relaxed);
+        out.callback_thread_cpu_ns = callback_thread_cpu_ns.load(std::memory_order_relaxed);
+        out.send_thread_cpu_ns = send_thread_cpu_ns.load(std::memory_order_relaxed);
+        stats_segment->publish(out);
+    }
+
+    // Latency instrumentation (see LatencyStats).  The receive thread times every
+    // config.latency_sample_interval-th data packet up to its shmem store and hands the
+    // sample to the callback thread, which finds the packet again by its queue position.
+    struct LatencySample {
+        uint64_t seq;              // Position in packet_queue (successful pushes before it)
+        int64_t device_local_ns;   // Device timestamp on the host steady clock (INT64_MIN = no sync)
+        int64_t stored_ns;         // Host steady time after the shmem store
+    };
+    struct LatencyHistograms {
+        cbutil::LatencyHistogram device_to_arrival;
+        cbutil::LatencyHistogram arrival_to_store;
+        cbutil::LatencyHistogram store_to_dequeue;
+        cbutil::LatencyHistogram dequeue_to_callback;
+        cbutil::LatencyHistogram device_to_callback;
+
+        void reset() {
+            device_to_arrival.reset();
+            arrival_to_store.reset();
+            store_to_dequeue.reset();
+            dequeue_to_callback.reset();
+            device_to_callback.reset();
+        }
+    };
+    LatencyHistograms latency;
+    SPSCQueue<LatencySample, 1024> latency_samples;
+    uint64_t queue_push_seq = 0;        // Receive thread only
+    uint64_t queue_pop_seq = 0;         // Callback thread only
+    uint32_t latency_countdown = 0;     // Receive thread only
+
+    static int64_t steadyNs(std::chrono::steady_clock::time_point tp) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(tp.time_since_epoch()).count();
+    }
+
+    /// Record a non-negative interval (clock-sync error can make short ones come out negative)
+    static void recordInterval(cbutil::LatencyHistogram& hist, int64_t from_ns, int64_t to_ns) {
+        hist.record(to_ns > from_ns ? static_cast<uint64_t>(to_ns - from_ns) : 0);
+    }
+
     // Running state
     std::atomic<bool> is_running{false};
 
@@ -472,50 +597,91 @@ struct SdkSession::Impl {
         }
     }
 
-    /// Dispatch a batch of packets: first fire batch group callbacks, then per-packet callbacks.
-    /// Called from both STANDALONE callback thread and CLIENT shmem receive thread.
-    void dispatchBatch(cbPKT_GENERIC* packets, size_t count) {
-        // Phase 1: batch group callbacks (one invocation per group_id per batch)
-        std::vector<GroupBatchCB> snap_batch;
-        {
-            std::lock_guard<std::mutex> lock(user_callback_mutex);
-            snap_batch = group_batch_callbacks;
-        }
-
-        if (!snap_batch.empty()) {
-            // Temp buffers — sized for max batch (128 packets × 272 channels)
-            // ~70KB on stack, well within typical thread stack limits.
-            int16_t sample_buf[128 * cbNUM_ANALOG_CHANS];
-            uint64_t ts_buf[128];
-
-            for (const auto& bcb : snap_batch) {
-                size_t n = 0;
-                size_t n_channels = 0;
-
-                for (size_t i = 0; i < count; i++) {
-                    if (packets[i].cbpkt_header.chid == 0 &&
-                        packets[i].cbpkt_header.type == bcb.group_id) {
-                        const auto& grp = reinterpret_cast<const cbPKT_GROUP&>(packets[i]);
-                        size_t nc = static_cast<size_t>(grp.cbpkt_header.dlen) * 2;
-                        if (nc == 0) continue;
-                        if (n == 0) n_channels = nc;
-                        else if (nc != n_channels) continue;  // skip mismatched (shouldn't happen)
-                        std::memcpy(&sample_buf[n * n_channels], grp.data, n_channels * sizeof(int16_t));
-                        ts_buf[n] = grp.cbpkt_header.time;
-                        n++;
-                    }
-                }
-
-                if (n > 0 && bcb.cb) {
-                    bcb.cb(sample_buf, n, n_channels, ts_buf);
+    /// Resolve @p format against the group's current channels and scaling, and add a batch
+    /// callback for it (@p cb for int16 samples, or @p scaled_cb for physical units)
+    static Result<CallbackHandle> addFormattedBatchCallback(const SdkSession& session, const SampleRate rate,
+                                                            const GroupBatchFormat& format, GroupBatchCallback cb,
+                                                            ScaledGroupBatchCallback scaled_cb) {
+        uint16_t list[cbNUM_ANALOG_CHANS];
+        const uint32_t n = session.getGroupChannelList(static_cast<uint32_t>(rate), list, cbNUM_ANALOG_CHANS);
+        const auto& policy = format.policy;
+        if (policy.max_samples > 0 && policy.max_samples < policy.min_samples) {
+            return Result<CallbackHandle>::error("max_samples must be at least min_samples");
+        }
+        if (policy.max_delay_us > 0 && policy.min_samples < 2) {
+            return Result<CallbackHandle>::error("max_delay_us needs min_samples of at least 2");
+        }
+        std::vector<uint32_t> chan_ids = format.chan_ids;
+        if (chan_ids.empty()) {
+            chan_ids.assign(list, list + n);
+        }
+        auto projection = projectGroup(list, n, chan_ids);
+        if (projection.isError()) {
+            return Result<CallbackHandle>::error(projection.error());
+        }
+        std::shared_ptr<GroupFilter> filter;
+        if (!format.sections.empty()) {
+            filter = std::make_shared<GroupFilter>();
+            filter->sections = format.sections;
+        }
+        std::shared_ptr<GroupBatchOutput> output;
+        if (scaled_cb || format.layout != SampleLayout::SAMPLE_MAJOR) {
+            output = std::make_shared<GroupBatchOutput>();
+            output->layout = format.layout;
+            if (scaled_cb) {
+                output->scaled_cb = std::move(scaled_cb);
+                output->scales.reserve(chan_ids.size());
+                for (const uint32_t chan_id : chan_ids) {
+                    const cbPKT_CHANINFO* info = session.getChanInfo(chan_id);
+                    output->scales.push_back(info ? channelScale(info->scalin) : ChannelScale{});
                 }
             }
         }
+        std::shared_ptr<BatchAccumulator> accumulator;
+        if (policy.min_samples > 1 || policy.max_samples > 0) {   // max_delay_us implies min_samples > 1
+            accumulator = std::make_shared<BatchAccumulator>();
+            accumulator->policy = policy;
+        }
+        auto& impl = *session.m_impl;
+        std::lock_guard<std::mutex> lock(impl.user_callback_mutex);
+        const auto handle = impl.next_callback_handle++;
+        impl.editPipeline([&](ProcessingPipeline& p) {
+            p.group_batch_callbacks.push_back({handle, static_cast<uint8_t>(rate), std::move(cb), std::move(filter),
+                                               std::move(projection.value()), std::move(output),
+                                               std::move(accumulator)});
+        });
+        return Result<CallbackHandle>::ok(handle);
+    }
+
+    /// Dispatch a batch of packets: first fire batch group callbacks, then per-packet callbacks.
+    /// Called from both STANDALONE callback thread and CLIENT shmem receive thread.
+    /// @param timed_index Packet whose callbacks are timed (count = none)
+    /// @param timed_done Receives the host time that packet's last callback returned
+    void dispatchBatch(cbPKT_GENERIC* packets, size_t count, size_t timed_index = SIZE_MAX,
+                       std::chrono::steady_clock::time_point* timed_done = nullptr) {
+        const auto stages = loadPipeline();
+        const ChannelTypeTable* types = channel_cache_valid ? &channel_type_cache : nullptr;
+
+        // Phase 1: recording, derived streams, batch callbacks, host spike detection and sorting
+        stages->processBatch(packets, count, types);
 
         // Phase 2: per-packet dispatch (existing behavior, unchanged)
         for (size_t i = 0; i < count; i++) {
             dispatchPacket(packets[i]);
+            if (i == timed_index && timed_done) {
+                *timed_done = std::chrono::steady_clock::now();
+            }
+        }
+
+        // Phase 3: host-detected spikes, which complete with this batch but precede it in time
+        if (stages->spike_detection) {
+            for (const auto& pkt : stages->spike_detection->packets) {
+                dispatchPacket(pkt);
+            }
         }
+
+        // Phase 4: spike bins and epochs the batch completed
+        stages->finishBatch(packets, count, types);
     }
 
     /// Dispatch a single packet to all matching typed callbacks.
@@ -523,6 +689,7 @@ struct SdkSession::Impl {
     /// Snapshots each callback vector under lock, then dispatches without lock (Phase 2, Fix 6).
     void dispatchPacket(const cbPKT_GENERIC& pkt) {
         const uint16_t chid = pkt.cbpkt_header.chid;
+        const cbproto::PacketClass cls = cbproto::classifyPacket(chid);
 
         // Snapshot callback vectors under lock (fast: just copies a few pointers+sizes)
         std::vector<PacketCB> snap_packet;
@@ -533,12 +700,10 @@ struct SdkSession::Impl {
             std::lock_guard<std::mutex> lock(user_callback_mutex);
             snap_packet = packet_callbacks;
             // Only snapshot the vectors we'll actually need for this packet type
-            if (chid != 0 && !(chid & cbPKTCHAN_CONFIGURATION)) {
-                snap_event = event_callbacks;
-            } else if (chid == 0) {
-                snap_group = group_callbacks;
-            } else if (chid & cbPKTCHAN_CONFIGURATION) {
-                snap_config = config_callbacks;
+            switch (cls) {
+            case cbproto::PacketClass::EVENT:  snap_event = event_callbacks; break;
+            case cbproto::PacketClass::GROUP:  snap_group = group_callbacks; break;
+            case cbproto::PacketClass::CONFIG: snap_config = config_callbacks; break;
             }
         }
 
@@ -547,7 +712,7 @@ struct SdkSession::Impl {
             if (cb.cb) cb.cb(pkt);
         }
 
-        if (chid != 0 && !(chid & cbPKTCHAN_CONFIGURATION)) {
+        if (cls == cbproto::PacketClass::EVENT) {
             // Look up cached channel type (Phase 3, Fix 10)
             ChannelType pkt_chan_type = ChannelType::ANY;
             if (channel_cache_valid && chid >= 1 && chid <= cbMAXCHANS) {
@@ -558,13 +723,13 @@ struct SdkSession::Impl {
                     if (cb.cb) cb.cb(pkt);
                 }
             }
-        } else if (chid == 0) {
+        } else if (cls == cbproto::PacketClass::GROUP) {
             for (const auto& cb : snap_group) {
                 if (pkt.cbpkt_header.type == cb.group_id) {
                     if (cb.cb) cb.cb(reinterpret_cast<const cbPKT_GROUP&>(pkt));
                 }
             }
-        } else if (chid & cbPKTCHAN_CONFIGURATION) {
+        } else {
             for (const auto& cb : snap_config) {
                 if (pkt.cbpkt_header.type == cb.packet_type) {
                     if (cb.cb) cb.cb(pkt);
@@ -831,9 +996,22 @@ Result<SdkSession> SdkSession::create(const SdkConfig& config) {
         }
     }
 
+    if (config.replay_path.has_value() && !is_standalone) {
+        return Result<SdkSession>::error(
+            "Cannot replay a capture while another session owns this device's shared memory");
+    }
+
     session.m_impl->shmem_session = std::move(shmem_result.value());
     session.m_impl->standalone = is_standalone;
 
+    // Publish stats for monitors; best effort, the session works without them
+    if (is_standalone) {
+        auto stats_result = cbshm::StatsSegment::create(getNativeSegmentName(config.device_type, "stats"));
+        if (stats_result.isOk()) {
+            session.m_impl->stats_segment = std::move(stats_result.value());
+        }
+    }
+
     // Create device session only in STANDALONE mode
     if (is_standalone) {
         // Map SDK DeviceType to cbdev DeviceType
@@ -880,6 +1058,10 @@ Result<SdkSession> SdkSession::create(const SdkConfig& config) {
 
         dev_config.recv_buffer_size = config.recv_buffer_size;
         dev_config.non_blocking = config.non_blocking;
+        if (config.replay_path.has_value()) {
+            dev_config.replay_path = config.replay_path.value();
+            dev_config.replay_speed = config.replay_speed;
+        }
 
         auto dev_result = cbdev::createDeviceSession(dev_config);
         if (dev_result.isError()) {
@@ -887,6 +1069,14 @@ Result<SdkSession> SdkSession::create(const SdkConfig& config) {
         }
         session.m_impl->device_session = std::move(dev_result.value());
 
+        // Capture from the first datagram so the file holds the handshake's config flood
+        if (config.capture_path.has_value()) {
+            auto capture_result = session.m_impl->device_session->startCapture(config.capture_path.value());
+            if (capture_result.isError()) {
+                return Result<SdkSession>::error("Failed to start capture: " + capture_result.error());
+            }
+        }
+
         // TODO [Phase 3]: Config parsing now happens in SDK receive thread, not DeviceSession
         // DeviceSession no longer has setConfigBuffer() method
         // Config buffer management is now SDK's responsibility
@@ -928,10 +1118,29 @@ Result<void> SdkSession::start() {
             // This is the callback thread - runs user callbacks (can be slow)
             constexpr size_t MAX_BATCH = 32;
             cbPKT_GENERIC packets[MAX_BATCH];
+            Impl::LatencySample sample{};
+            bool has_sample = false;
+            auto last_cpu_sample = std::chrono::steady_clock::now();
+            auto last_batch_flush = last_cpu_sample;
 
             while (impl->callback_thread_running.load()) {
                 size_t count = 0;
 
+                // Fail asynchronous config operations that outlived their deadline
+                impl->config_tracker.expire();
+
+                const auto now = std::chrono::steady_clock::now();
+                if (now - last_cpu_sample >= Impl::STATS_PUBLISH_INTERVAL) {
+                    impl->callback_thread_cpu_ns.store(cbshm::currentThreadCpuNs(), std::memory_order_relaxed);
+                    last_cpu_sample = now;
+                }
+
+                // Deliver held batches whose max_delay_us ran out while their group was quiet
+                if (now - last_batch_flush >= Impl::BATCH_FLUSH_INTERVAL) {
+                    impl->loadPipeline()->flushBatchAccumulators(now);
+                    last_batch_flush = now;
+                }
+
                 // Drain available packets from queue (non-blocking)
                 while (count < MAX_BATCH && impl->packet_queue.pop(packets[count])) {
                     count++;
@@ -942,8 +1151,36 @@ Result<void> SdkSession::start() {
 
                     impl->stats.packets_delivered_to_callback.fetch_add(count, std::memory_order_relaxed);
 
+                    // Find a latency sample that belongs to this batch (older ones were dropped
+                    // from the queue or arrived after a reset; newer ones wait for their batch)
+                    const uint64_t first_seq = impl->queue_pop_seq;
+                    impl->queue_pop_seq += count;
+                    if (!has_sample) {
+                        has_sample = impl->latency_samples.pop(sample);
+                    }
+                    while (has_sample && sample.seq < first_seq) {
+                        has_sample = impl->latency_samples.pop(sample);
+                    }
+                    size_t timed_index = SIZE_MAX;
+                    std::chrono::steady_clock::time_point dequeued{}, done{};
+                    if (has_sample && sample.seq < impl->queue_pop_seq) {
+                        timed_index = static_cast<size_t>(sample.seq - first_seq);
+                        dequeued = std::chrono::steady_clock::now();
+                    }
+
                     // Dispatch batch (fires batch group callbacks, then per-packet callbacks)
-                    impl->dispatchBatch(packets, count);
+                    impl->dispatchBatch(packets, count, timed_index, &done);
+
+                    if (timed_index != SIZE_MAX) {
+                        const int64_t dequeued_ns = Impl::steadyNs(dequeued);
+                        const int64_t done_ns = Impl::steadyNs(done);
+                        Impl::recordInterval(impl->latency.store_to_dequeue, sample.stored_ns, dequeued_ns);
+                        Impl::recordInterval(impl->latency.dequeue_to_callback, dequeued_ns, done_ns);
+                        if (sample.device_local_ns != INT64_MIN) {
+                            Impl::recordInterval(impl->latency.device_to_callback, sample.device_local_ns, done_ns);
+                        }
+                        has_sample = false;
+                    }
                 } else {
                     // No packets available - wait for notification
                     impl->callback_thread_waiting.store(true, std::memory_order_release);
@@ -964,41 +1201,71 @@ Result<void> SdkSession::start() {
                     return;
                 }
 
+                const auto& traits = cbproto::packetTraits(pkt.cbpkt_header);
+
                 // Check for SYSREP packets (handshake responses)
-                if ((pkt.cbpkt_header.type & 0xF0) == cbPKTTYPE_SYSREP) {
+                if (traits.slot == cbproto::ConfigSlot::SYSINFO) {
                     const auto* sysinfo = reinterpret_cast<const cbPKT_SYSINFO*>(&pkt);
                     impl->updateRunlevel(sysinfo->runlevel);
                     if (pkt.cbpkt_header.type == cbPKTTYPE_SYSREPRUNLEV) {
                         impl->received_sysrepRunlev.store(true, std::memory_order_release);
                     }
+                    // Replay skips the handshake; the recorded config flood ends with SYSREP
+                    if (pkt.cbpkt_header.type == cbPKTTYPE_SYSREP && impl->config.replay_path.has_value()) {
+                        impl->rebuildChannelTypeCache();
+                    }
                     impl->received_sysrep.store(true, std::memory_order_release);
                     impl->handshake_cv.notify_all();
                 }
 
+                // Latency sampling: time every Nth data packet through the pipeline
+                const uint32_t sample_interval = impl->config.latency_sample_interval;
+                const bool sampled = sample_interval != 0 &&
+                                     traits.cls != cbproto::PacketClass::CONFIG &&
+                                     ++impl->latency_countdown >= sample_interval;
+
                 // Store to shared memory
                 auto store_result = impl->shmem_session->storePacket(pkt);
 
+                Impl::LatencySample sample{};
+                if (sampled) {
+                    impl->latency_countdown = 0;
+                    const int64_t arrival_ns = Impl::steadyNs(impl->device_session->getLastReceiveTime());
+                    sample.stored_ns = Impl::steadyNs(std::chrono::steady_clock::now());
+                    sample.device_local_ns = INT64_MIN;
+                    if (auto local = impl->device_session->toLocalTime(pkt.cbpkt_header.time)) {
+                        sample.device_local_ns = Impl::steadyNs(*local);
+                        Impl::recordInterval(impl->latency.device_to_arrival, sample.device_local_ns, arrival_ns);
+                    }
+                    Impl::recordInterval(impl->latency.arrival_to_store, arrival_ns, sample.stored_ns);
+                }
+
                 // Mirror config reply packets to shmem so CLIENT processes
-                // can read device configuration (chaninfo, procinfo, sysinfo, groupinfo).
-                if (pkt.cbpkt_header.type == cbPKTTYPE_PROCREP) {
+                // can read device configuration (chaninfo, procinfo, sysinfo, groupinfo,
+                // and the spike sorting models).
+                switch (traits.slot) {
+                case cbproto::ConfigSlot::PROCINFO: {
                     const auto* procinfo = reinterpret_cast<const cbPKT_PROCINFO*>(&pkt);
                     impl->shmem_session->setProcInfo(
                         cbproto::InstrumentId::fromPacketField(pkt.cbpkt_header.instrument),
                         *procinfo);
+                    break;
                 }
-                if ((pkt.cbpkt_header.type & 0xF0) == cbPKTTYPE_SYSREP) {
+                case cbproto::ConfigSlot::SYSINFO: {
                     const auto* sysinfo = reinterpret_cast<const cbPKT_SYSINFO*>(&pkt);
                     impl->shmem_session->setSysInfo(*sysinfo);
+                    break;
                 }
-                if (pkt.cbpkt_header.type == cbPKTTYPE_GROUPREP) {
+                case cbproto::ConfigSlot::GROUPINFO: {
                     const auto* groupinfo = reinterpret_cast<const cbPKT_GROUPINFO*>(&pkt);
                     if (groupinfo->group >= 1 && groupinfo->group <= cbMAXGROUPS) {
                         impl->shmem_session->setGroupInfo(
                             cbproto::InstrumentId::fromPacketField(pkt.cbpkt_header.instrument),
                             groupinfo->group - 1, *groupinfo);
                     }
+                    break;
                 }
-                if ((pkt.cbpkt_header.type & 0xF0) == cbPKTTYPE_CHANREP) {
+                case cbproto::ConfigSlot::CHANINFO: {
                     auto chaninfo_copy = *reinterpret_cast<const cbPKT_CHANINFO*>(&pkt);
                     // Apply CMP overlay (position + label) before writing to
                     // shmem so locally-supplied geometry and labels survive
@@ -1022,14 +1289,52 @@ Result<void> SdkSession::start() {
                     }
                     if (chaninfo_copy.chan >= 1 && chaninfo_copy.chan <= cbMAXCHANS) {
                         impl->shmem_session->setChanInfo(chaninfo_copy.chan - 1, chaninfo_copy);
+                        // Acknowledge after the mirror so completion implies a fresh cache
+                        impl->config_tracker.acknowledge(chaninfo_copy);
+                    }
+                    break;
+                }
+                case cbproto::ConfigSlot::FS_BASIS: {
+                    const auto basis = copyBasisPacket(pkt);
+                    if (basis.chan >= 1 && basis.chan <= cbMAXCHANS) {   // chan 0: a request
+                        impl->shmem_session->setFeatureBasis(basis.chan - 1, basis);
+                    }
+                    break;
+                }
+                case cbproto::ConfigSlot::SS_MODEL: {
+                    // chan is 0-based here; noise (unit 255) goes in the last slot, as in cbdev
+                    const auto* model = reinterpret_cast<const cbPKT_SS_MODELSET*>(&pkt);
+                    const uint32_t slot = model->unit_number == 255 ? cbMAXUNITS + 1 : model->unit_number;
+                    if (model->chan < cbMAXCHANS && slot <= cbMAXUNITS + 1) {
+                        impl->shmem_session->setSortModel(model->chan, slot, *model);
                     }
+                    break;
+                }
+                case cbproto::ConfigSlot::SS_NOISE_BOUNDARY: {
+                    const auto* boundary = reinterpret_cast<const cbPKT_SS_NOISE_BOUNDARY*>(&pkt);
+                    if (boundary->chan >= 1 && boundary->chan <= cbMAXCHANS) {
+                        impl->shmem_session->setNoiseBoundary(boundary->chan - 1, *boundary);
+                    }
+                    break;
+                }
+                default:
+                    break;
                 }
 
                 // Queue for callback
                 bool queued = impl->packet_queue.push(pkt);
+                if (queued) {
+                    if (sampled) {
+                        sample.seq = impl->queue_push_seq;
+                        impl->latency_samples.push(sample);
+                    }
+                    impl->queue_push_seq++;
+                }
 
                 // Update stats with atomic increments (no mutex needed)
                 impl->stats.packets_received_from_device.fetch_add(1, std::memory_order_relaxed);
+                impl->stats.bytes_received_from_device.fetch_add(
+                    cbPKT_HEADER_SIZE + pkt.cbpkt_header.dlen * 4u, std::memory_order_relaxed);
                 if (store_result.isOk()) {
                     impl->stats.packets_stored_to_shmem.fetch_add(1, std::memory_order_relaxed);
                 } else {
@@ -1069,6 +1374,12 @@ Result<void> SdkSession::start() {
                     impl->last_clock_probe_time = now;
                 }
 
+                // This callback runs on the device receive thread
+                if (now - impl->last_receive_cpu_sample >= Impl::STATS_PUBLISH_INTERVAL) {
+                    impl->receive_thread_cpu_ns.store(cbshm::currentThreadCpuNs(), std::memory_order_relaxed);
+                    impl->last_receive_cpu_sample = now;
+                }
+
                 // Cross-device clock consensus.  Devices that share one PTP
                 // clock should report the same device->host offset.  Each device
                 // publishes its own (independent) estimate; here we combine this
@@ -1178,9 +1489,20 @@ Result<void> SdkSession::start() {
         // Start device send thread - dequeues from shmem and sends to device
         m_impl->device_send_thread_running.store(true);
         m_impl->device_send_thread = std::make_unique<std::thread>([impl]() {
+            auto last_publish = std::chrono::steady_clock::time_point{};
             while (impl->device_send_thread_running.load()) {
                 bool has_packets = false;
 
+                // Sample CPU time and publish stats for other processes (see cbshm/stats_segment.h)
+                const auto now = std::chrono::steady_clock::now();
+                if (now - last_publish >= Impl::STATS_PUBLISH_INTERVAL) {
+                    impl->send_thread_cpu_ns.store(cbshm::currentThreadCpuNs(), std::memory_order_relaxed);
+                    if (impl->stats_segment) {
+                        impl->publishStats();
+                    }
+                    last_publish = now;
+                }
+
                 // Try to dequeue and send all available packets
 #ifdef _WIN32
                 bool timer_raised = false;
@@ -1230,12 +1552,19 @@ Result<void> SdkSession::start() {
 
         // Perform handshaking based on autorun flag
         Result<void> handshake_result;
-        if (m_impl->config.autorun) {
+        if (m_impl->config.replay_path.has_value()) {
+            // Nothing to handshake with: the capture replays the original session's replies
+            handshake_result = Result<void>::ok();
+        } else if (m_impl->config.autorun) {
             // Fully start device to RUNNING state (includes requestConfiguration)
             handshake_result = performStartupHandshake(500);
         } else {
             // Just request configuration without changing runlevel
             handshake_result = requestConfiguration(500);
+            if (handshake_result.isOk()) {
+                // performStartupHandshake() does this on the autorun path
+                m_impl->rebuildChannelTypeCache();
+            }
         }
 
         // Send initial clock probe immediately after handshake so clock
@@ -1278,9 +1607,18 @@ Result<void> SdkSession::start() {
             // CLIENT mode receive thread: reads from Central's cbRECbuffer, dispatches to callbacks
             constexpr size_t MAX_BATCH = 128;
             cbPKT_GENERIC packets[MAX_BATCH];
+            auto last_batch_flush = std::chrono::steady_clock::now();
 
             while (impl->shmem_receive_thread_running.load()) {
-                auto wait_result = impl->shmem_session->waitForData(250);
+                impl->config_tracker.expire();
+                const auto now = std::chrono::steady_clock::now();
+                if (now - last_batch_flush >= Impl::BATCH_FLUSH_INTERVAL) {
+                    impl->loadPipeline()->flushBatchAccumulators(now);
+                    last_batch_flush = now;
+                }
+                // Wake often enough to flush held batches while Central is quiet
+                const bool batching = impl->loadPipeline()->accumulating > 0;
+                auto wait_result = impl->shmem_session->waitForData(batching ? 1 : 250);
                 if (wait_result.isError()) {
                     std::lock_guard<std::mutex> lock(impl->user_callback_mutex);
                     if (impl->error_callback) {
@@ -1317,7 +1655,11 @@ Result<void> SdkSession::start() {
                         impl->stats.packets_delivered_to_callback.fetch_add(packets_read, std::memory_order_relaxed);
                         // CLIENT mode: scan packets for clock sync replies and CMP overlays
                         for (size_t i = 0; i < packets_read; i++) {
-                            if (packets[i].cbpkt_header.type == cbPKTTYPE_NPLAYREP) {
+                            if (cbproto::isMalformedConfigPacket(packets[i].cbpkt_header)) {
+                                continue;   // Shorter than its slot's struct
+                            }
+                            const auto slot = cbproto::packetTraits(packets[i].cbpkt_header).slot;
+                            if (slot == cbproto::ConfigSlot::NPLAY) {
                                 // Complete pending clock sync probe
                                 constexpr uint64_t STALENESS_CORRECTION_NS = 165000;
                                 std::lock_guard<std::mutex> lock(impl->clock_probe_mutex);
@@ -1334,8 +1676,12 @@ Result<void> SdkSession::start() {
                                     impl->pending_clock_probe.active = false;
                                 }
                             }
+                            if (slot == cbproto::ConfigSlot::CHANINFO) {
+                                impl->config_tracker.acknowledge(
+                                    reinterpret_cast<const cbPKT_CHANINFO&>(packets[i]));
+                            }
                             // Check for SYSREP packets (handshake responses)
-                            if ((packets[i].cbpkt_header.type & 0xF0) == cbPKTTYPE_SYSREP) {
+                            if (slot == cbproto::ConfigSlot::SYSINFO) {
                                 const auto* sysinfo = reinterpret_cast<const cbPKT_SYSINFO*>(&packets[i]);
                                 impl->updateRunlevel(sysinfo->runlevel);
                                 if (packets[i].cbpkt_header.type == cbPKTTYPE_SYSREPRUNLEV) {
@@ -1394,6 +1740,7 @@ void SdkSession::stop() {
 
     m_impl->is_running.store(false);
     m_impl->shutting_down.store(true, std::memory_order_release);
+    m_impl->config_tracker.cancelAll("Session stopped");
 
     // Stop device threads (if STANDALONE mode)
     if (m_impl->device_session) {
@@ -1434,6 +1781,9 @@ void SdkSession::stop() {
     if (m_impl->callback_thread && m_impl->callback_thread->joinable()) {
         m_impl->callback_thread->join();
     }
+
+    // Nothing feeds the recorder any more; flush and close its files
+    stopRecording();
 }
 
 bool SdkSession::isRunning() const {
@@ -1466,10 +1816,79 @@ CallbackHandle SdkSession::registerGroupBatchCallback(const SampleRate rate, Gro
     const uint8_t group_id = static_cast<uint8_t>(rate);
     std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
     const auto handle = m_impl->next_callback_handle++;
-    m_impl->group_batch_callbacks.push_back({handle, group_id, std::move(callback)});
+    m_impl->editPipeline([&](ProcessingPipeline& p) {
+        p.group_batch_callbacks.push_back({handle, group_id, std::move(callback)});
+    });
     return handle;
 }
 
+CallbackHandle SdkSession::registerFilteredGroupBatchCallback(const SampleRate rate, std::vector<Biquad> sections,
+                                                              GroupBatchCallback callback) const {
+    const uint8_t group_id = static_cast<uint8_t>(rate);
+    auto filter = std::make_shared<GroupFilter>();
+    filter->sections = std::move(sections);
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    const auto handle = m_impl->next_callback_handle++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) {
+        p.group_batch_callbacks.push_back({handle, group_id, std::move(callback), std::move(filter)});
+    });
+    return handle;
+}
+
+Result<CallbackHandle> SdkSession::registerGroupBatchCallback(const SampleRate rate,
+                                                              const std::vector<uint32_t>& chan_ids,
+                                                              GroupBatchCallback callback) const {
+    uint16_t list[cbNUM_ANALOG_CHANS];
+    const uint32_t n = getGroupChannelList(static_cast<uint32_t>(rate), list, cbNUM_ANALOG_CHANS);
+    auto projection = projectGroup(list, n, chan_ids);
+    if (projection.isError()) {
+        return Result<CallbackHandle>::error(projection.error());
+    }
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    const auto handle = m_impl->next_callback_handle++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) {
+        p.group_batch_callbacks.push_back(
+            {handle, static_cast<uint8_t>(rate), std::move(callback), nullptr, std::move(projection.value())});
+    });
+    return Result<CallbackHandle>::ok(handle);
+}
+
+Result<CallbackHandle> SdkSession::registerFilteredGroupBatchCallback(const SampleRate rate,
+                                                                      const std::vector<uint32_t>& chan_ids,
+                                                                      std::vector<Biquad> sections,
+                                                                      GroupBatchCallback callback) const {
+    uint16_t list[cbNUM_ANALOG_CHANS];
+    const uint32_t n = getGroupChannelList(static_cast<uint32_t>(rate), list, cbNUM_ANALOG_CHANS);
+    auto projection = projectGroup(list, n, chan_ids);
+    if (projection.isError()) {
+        return Result<CallbackHandle>::error(projection.error());
+    }
+    auto filter = std::make_shared<GroupFilter>();
+    filter->sections = std::move(sections);
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    const auto handle = m_impl->next_callback_handle++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) {
+        p.group_batch_callbacks.push_back({handle, static_cast<uint8_t>(rate), std::move(callback),
+                                           std::move(filter), std::move(projection.value())});
+    });
+    return Result<CallbackHandle>::ok(handle);
+}
+
+Result<CallbackHandle> SdkSession::registerFormattedGroupBatchCallback(const SampleRate rate,
+                                                                       const GroupBatchFormat& format,
+                                                                       GroupBatchCallback callback) const {
+    return Impl::addFormattedBatchCallback(*this, rate, format, std::move(callback), nullptr);
+}
+
+Result<CallbackHandle> SdkSession::registerScaledGroupBatchCallback(const SampleRate rate,
+                                                                    const GroupBatchFormat& format,
+                                                                    ScaledGroupBatchCallback callback) const {
+    if (!callback) {
+        return Result<CallbackHandle>::error("No callback");
+    }
+    return Impl::addFormattedBatchCallback(*this, rate, format, nullptr, std::move(callback));
+}
+
 CallbackHandle SdkSession::registerConfigCallback(const uint16_t packet_type, ConfigCallback callback) const {
     std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
     const auto handle = m_impl->next_callback_handle++;
@@ -1494,9 +1913,15 @@ void SdkSession::unregisterCallback(CallbackHandle handle) const {
     erase_by_handle(m_impl->packet_callbacks);
     erase_by_handle(m_impl->event_callbacks);
     erase_by_handle(m_impl->group_callbacks);
-    erase_by_handle(m_impl->group_batch_callbacks);
     erase_by_handle(m_impl->config_callbacks);
     erase_by_handle(m_impl->runlevel_callbacks);
+    m_impl->editPipeline([&](ProcessingPipeline& p) {
+        erase_by_handle(p.group_batch_callbacks);
+        erase_by_handle(p.virtual_batch_callbacks);
+        erase_by_handle(p.spike_bin_callbacks);
+        erase_by_handle(p.band_power_callbacks);
+        erase_by_handle(p.epoch_callbacks);
+    });
 }
 
 void SdkSession::setErrorCallback(ErrorCallback callback) {
@@ -1504,14 +1929,728 @@ void SdkSession::setErrorCallback(ErrorCallback callback) {
     m_impl->error_callback = std::move(callback);
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Virtual Sample Groups
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result<VirtualGroupId> SdkSession::createResampledGroup(const SampleRate source, const uint32_t up,
+                                                        const uint32_t down, const size_t buffer_samples) {
+    if (sampleRateHz(source) == 0.0) {
+        return Result<VirtualGroupId>::error("Invalid source sample rate");
+    }
+    // Validate the factors now; the resampler itself waits for the first batch's channel count
+    auto probe = PolyphaseResampler::create(up, down, 1);
+    if (probe.isError()) {
+        return Result<VirtualGroupId>::error(probe.error());
+    }
+    auto group = std::make_shared<VirtualGroup>();
+    group->source_group = static_cast<uint8_t>(source);
+    group->up = probe.value().up();
+    group->down = probe.value().down();
+    group->group_delay = probe.value().groupDelay();
+    group->ring.capacity = buffer_samples;
+    return Result<VirtualGroupId>::ok(m_impl->addVirtualGroup(std::move(group)));
+}
+
+Result<VirtualGroupId> SdkSession::createRereferencedGroup(const SampleRate source, const ReferenceScheme scheme,
+                                                           const ReferenceStatistic statistic,
+                                                           const size_t buffer_samples) {
+    if (sampleRateHz(source) == 0.0) {
+        return Result<VirtualGroupId>::error("Invalid source sample rate");
+    }
+    uint16_t list[cbNUM_ANALOG_CHANS];
+    const uint32_t n = getGroupChannelList(static_cast<uint32_t>(source), list, cbNUM_ANALOG_CHANS);
+    if (n == 0) {
+        return Result<VirtualGroupId>::error("Source group has no channels");
+    }
+
+    // One plan entry per column of the group's batches
+    std::vector<int32_t> plan(n, -1);
+    for (uint32_t col = 0; col < n; ++col) {
+        const auto* ci = getChanInfo(list[col]);
+        if (!ci || classifyChannelByCaps(*ci) != ChannelType::FRONTEND) continue;
+        switch (scheme) {
+            case ReferenceScheme::COMMON:    plan[col] = 0; break;
+            case ReferenceScheme::BANK:      plan[col] = static_cast<int32_t>(ci->bank); break;
+            case ReferenceScheme::HEADSTAGE: plan[col] = ci->position[3]; break;
+            case ReferenceScheme::ELECTRODE: {
+                const auto* ref = std::find(list, list + n, ci->refelecchan);
+                if (ci->refelecchan != 0 && ref != list + n && ref != list + col) {
+                    plan[col] = static_cast<int32_t>(ref - list);
+                }
+                break;
+            }
+        }
+    }
+    auto rereferencer = scheme == ReferenceScheme::ELECTRODE
+        ? Rereferencer::createElectrode(std::move(plan))
+        : Rereferencer::createPooled(std::move(plan), statistic);
+    if (rereferencer.isError()) {
+        return Result<VirtualGroupId>::error(rereferencer.error());
+    }
+
+    auto group = std::make_shared<VirtualGroup>();
+    group->kind = VirtualGroupKind::REREFERENCED;
+    group->source_group = static_cast<uint8_t>(source);
+    group->rereferencer.emplace(std::move(rereferencer.value()));
+    group->ring.capacity = buffer_samples;
+    return Result<VirtualGroupId>::ok(m_impl->addVirtualGroup(std::move(group)));
+}
+
+Result<void> SdkSession::destroyVirtualGroup(const VirtualGroupId group) {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    if (!m_impl->loadPipeline()->findVirtualGroup(group)) {
+        return Result<void>::error("No such virtual group");
+    }
+    m_impl->editPipeline([group](ProcessingPipeline& p) {
+        auto& groups = p.virtual_groups;
+        groups.erase(std::remove_if(groups.begin(), groups.end(),
+                                    [group](const auto& g) { return g->id == group; }),
+                     groups.end());
+        auto& callbacks = p.virtual_batch_callbacks;
+        callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+                                       [group](const auto& cb) { return cb.group == group; }),
+                        callbacks.end());
+    });
+    return Result<void>::ok();
+}
+
+CallbackHandle SdkSession::registerVirtualGroupBatchCallback(const VirtualGroupId group,
+                                                             GroupBatchCallback callback) const {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    if (!m_impl->loadPipeline()->findVirtualGroup(group)) {
+        return 0;
+    }
+    const auto handle = m_impl->next_callback_handle++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) {
+        p.virtual_batch_callbacks.push_back({handle, group, std::move(callback)});
+    });
+    return handle;
+}
+
+Result<VirtualGroupInfo> SdkSession::getVirtualGroupInfo(const VirtualGroupId group) const {
+    const auto vg = m_impl->loadPipeline()->findVirtualGroup(group);
+    if (!vg) {
+        return Result<VirtualGroupInfo>::error("No such virtual group");
+    }
+    VirtualGroupInfo info;
+    info.kind = vg->kind;
+    info.source = static_cast<SampleRate>(vg->source_group);
+    info.up = vg->up;
+    info.down = vg->down;
+    info.sample_rate_hz = sampleRateHz(info.source) * vg->up / vg->down;
+    info.group_delay = vg->group_delay;
+    std::lock_guard<std::mutex> lock(vg->ring.mutex);
+    info.channel_count = vg->ring.width;
+    info.buffer_capacity = vg->ring.capacity;
+    info.buffered = vg->ring.buffered;
+    info.samples_produced = vg->ring.produced;
+    info.samples_overwritten = vg->ring.overwritten;
+    return Result<VirtualGroupInfo>::ok(info);
+}
+
+Result<size_t> SdkSession::readVirtualGroup(const VirtualGroupId group, int16_t* samples, uint64_t* timestamps,
+                                            const size_t max_samples, const size_t max_channels,
+                                            size_t& n_channels) const {
+    const auto vg = m_impl->loadPipeline()->findVirtualGroup(group);
+    if (!vg) {
+        return Result<size_t>::error("No such virtual group");
+    }
+    std::lock_guard<std::mutex> lock(vg->ring.mutex);
+    n_channels = vg->ring.width;
+    if (vg->ring.buffered > 0 && vg->ring.width > max_channels) {
+        return Result<size_t>::error("Virtual group has " + std::to_string(vg->ring.width) + " channels");
+    }
+    return Result<size_t>::ok(vg->ring.pop(samples, timestamps, max_samples));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Band Power
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result<BandPowerStreamId> SdkSession::createBandPowerStream(const SampleRate source, const BandPowerConfig& config,
+                                                            const size_t buffer_frames) {
+    const double rate = sampleRateHz(source);
+    if (rate == 0.0) {
+        return Result<BandPowerStreamId>::error("Invalid source sample rate");
+    }
+    auto probe = BandPowerEngine::create(config, rate, 1);
+    if (probe.isError()) {
+        return Result<BandPowerStreamId>::error(probe.error());
+    }
+    auto stream = std::make_shared<BandPowerStream>();
+    stream->source_group = static_cast<uint8_t>(source);
+    stream->sample_rate_hz = rate;
+    stream->config = config;
+    stream->ring.capacity = buffer_frames;
+
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    stream->id = m_impl->next_band_power_stream++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) { p.band_power_streams.push_back(stream); });
+    return Result<BandPowerStreamId>::ok(stream->id);
+}
+
+Result<BandPowerStreamId> SdkSession::createBandPowerStream(const VirtualGroupId source, const BandPowerConfig& config,
+                                                            const size_t buffer_frames) {
+    const auto vg = m_impl->loadPipeline()->findVirtualGroup(source);
+    if (!vg) {
+        return Result<BandPowerStreamId>::error("No such virtual group");
+    }
+    const double rate = sampleRateHz(static_cast<SampleRate>(vg->source_group)) * vg->up / vg->down;
+    auto probe = BandPowerEngine::create(config, rate, 1);
+    if (probe.isError()) {
+        return Result<BandPowerStreamId>::error(probe.error());
+    }
+    auto stream = std::make_shared<BandPowerStream>();
+    stream->source_group = vg->source_group;
+    stream->source_virtual = source;
+    stream->sample_rate_hz = rate;
+    stream->config = config;
+    stream->ring.capacity = buffer_frames;
+
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    stream->id = m_impl->next_band_power_stream++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) { p.band_power_streams.push_back(stream); });
+    return Result<BandPowerStreamId>::ok(stream->id);
+}
+
+Result<void> SdkSession::destroyBandPowerStream(const BandPowerStreamId stream) {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    if (!m_impl->loadPipeline()->findBandPowerStream(stream)) {
+        return Result<void>::error("No such band power stream");
+    }
+    m_impl->editPipeline([stream](ProcessingPipeline& p) {
+        auto& streams = p.band_power_streams;
+        streams.erase(std::remove_if(streams.begin(), streams.end(),
+                                     [stream](const auto& s) { return s->id == stream; }),
+                      streams.end());
+        auto& callbacks = p.band_power_callbacks;
+        callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+                                       [stream](const auto& cb) { return cb.stream == stream; }),
+                        callbacks.end());
+    });
+    return Result<void>::ok();
+}
+
+CallbackHandle SdkSession::registerBandPowerCallback(const BandPowerStreamId stream,
+                                                     BandPowerCallback callback) const {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    if (!m_impl->loadPipeline()->findBandPowerStream(stream)) {
+        return 0;
+    }
+    const auto handle = m_impl->next_callback_handle++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) {
+        p.band_power_callbacks.push_back({handle, stream, std::move(callback)});
+    });
+    return handle;
+}
+
+Result<BandPowerStreamInfo> SdkSession::getBandPowerStreamInfo(const BandPowerStreamId stream) const {
+    const auto bp = m_impl->loadPipeline()->findBandPowerStream(stream);
+    if (!bp) {
+        return Result<BandPowerStreamInfo>::error("No such band power stream");
+    }
+    BandPowerStreamInfo info;
+    info.source = static_cast<SampleRate>(bp->source_group);
+    info.source_virtual = bp->source_virtual;
+    info.sample_rate_hz = bp->sample_rate_hz;
+    info.window = bp->config.window;
+    info.hop = bp->config.hop;
+    info.band_count = bp->config.bands.size();
+    std::lock_guard<std::mutex> lock(bp->ring.mutex);
+    info.channel_count = bp->ring.width / info.band_count;
+    info.buffer_capacity = bp->ring.capacity;
+    info.buffered = bp->ring.buffered;
+    info.frames_produced = bp->ring.produced;
+    info.frames_overwritten = bp->ring.overwritten;
+    return Result<BandPowerStreamInfo>::ok(info);
+}
+
+Result<size_t> SdkSession::readBandPower(const BandPowerStreamId stream, float* features, uint64_t* timestamps,
+                                         const size_t max_frames, const size_t max_channels,
+                                         size_t& n_channels) const {
+    const auto bp = m_impl->loadPipeline()->findBandPowerStream(stream);
+    if (!bp) {
+        return Result<size_t>::error("No such band power stream");
+    }
+    std::lock_guard<std::mutex> lock(bp->ring.mutex);
+    n_channels = bp->ring.width / bp->config.bands.size();
+    if (bp->ring.buffered > 0 && n_channels > max_channels) {
+        return Result<size_t>::error("Band power stream has " + std::to_string(n_channels) + " channels");
+    }
+    return Result<size_t>::ok(bp->ring.pop(features, timestamps, max_frames));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Peri-Event Epochs
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result<EpochStreamId> SdkSession::createEpochStream(const SampleRate source, const EpochConfig& config,
+                                                    const EpochTriggers& triggers, const size_t buffer_epochs) {
+    if (sampleRateHz(source) == 0.0) {
+        return Result<EpochStreamId>::error("Invalid source sample rate");
+    }
+    auto probe = EpochExtractor::create(config, 1);
+    if (probe.isError()) {
+        return Result<EpochStreamId>::error(probe.error());
+    }
+    auto stream = std::make_shared<EpochStream>();
+    stream->source_group = static_cast<uint8_t>(source);
+    stream->config = config;
+    stream->channels.assign(cbMAXCHANS + 1, false);
+    for (const uint32_t chan_id : triggers.channels) {
+        if (chan_id == 0 || chan_id > cbMAXCHANS) {
+            return Result<EpochStreamId>::error("Invalid trigger channel " + std::to_string(chan_id));
+        }
+        stream->channels[chan_id] = true;
+    }
+    stream->unit_mask = triggers.unit_mask;
+    stream->comments = triggers.comments;
+    stream->ring.capacity = buffer_epochs;
+    stream->sink = [es = stream.get()](const EpochEvent& event, const int16_t* samples, const uint64_t* timestamps) {
+        const size_t n_samples = es->extractor->epochLength();
+        const size_t n_channels = es->extractor->channelCount();
+        es->ring.push(samples, &event, 1, n_samples * n_channels);
+        for (const auto& cb : *es->callbacks) {
+            if (cb.stream == es->id && cb.cb) {
+                cb.cb(event, samples, n_samples, n_channels, timestamps);
+            }
+        }
+    };
+
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    stream->id = m_impl->next_epoch_stream++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) { p.epoch_streams.push_back(stream); });
+    return Result<EpochStreamId>::ok(stream->id);
+}
+
+Result<void> SdkSession::destroyEpochStream(const EpochStreamId stream) {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    if (!m_impl->loadPipeline()->findEpochStream(stream)) {
+        return Result<void>::error("No such epoch stream");
+    }
+    m_impl->editPipeline([stream](ProcessingPipeline& p) {
+        auto& streams = p.epoch_streams;
+        streams.erase(std::remove_if(streams.begin(), streams.end(),
+                                     [stream](const auto& s) { return s->id == stream; }),
+                      streams.end());
+        auto& callbacks = p.epoch_callbacks;
+        callbacks.erase(std::remove_if(callbacks.begin(), callbacks.end(),
+                                       [stream](const auto& cb) { return cb.stream == stream; }),
+                        callbacks.end());
+    });
+    return Result<void>::ok();
+}
+
+CallbackHandle SdkSession::registerEpochCallback(const EpochStreamId stream, EpochCallback callback) const {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    if (!m_impl->loadPipeline()->findEpochStream(stream)) {
+        return 0;
+    }
+    const auto handle = m_impl->next_callback_handle++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) {
+        p.epoch_callbacks.push_back({handle, stream, std::move(callback)});
+    });
+    return handle;
+}
+
+Result<EpochStreamInfo> SdkSession::getEpochStreamInfo(const EpochStreamId stream) const {
+    const auto es = m_impl->loadPipeline()->findEpochStream(stream);
+    if (!es) {
+        return Result<EpochStreamInfo>::error("No such epoch stream");
+    }
+    EpochStreamInfo info;
+    info.source = static_cast<SampleRate>(es->source_group);
+    info.pre_samples = es->config.pre_samples;
+    info.post_samples = es->config.post_samples;
+    std::lock_guard<std::mutex> lock(es->ring.mutex);
+    info.channel_count = es->ring.width / (info.pre_samples + info.post_samples);
+    info.pending = es->pending;
+    info.buffer_capacity = es->ring.capacity;
+    info.buffered = es->ring.buffered;
+    info.epochs_produced = es->ring.produced;
+    info.epochs_overwritten = es->ring.overwritten;
+    info.events_late = es->stats.events_late;
+    info.events_dropped = es->stats.events_dropped;
+    return Result<EpochStreamInfo>::ok(info);
+}
+
+Result<size_t> SdkSession::readEpochs(const EpochStreamId stream, int16_t* samples, EpochEvent* events,
+                                      const size_t max_epochs, const size_t max_channels,
+                                      size_t& n_channels) const {
+    const auto es = m_impl->loadPipeline()->findEpochStream(stream);
+    if (!es) {
+        return Result<size_t>::error("No such epoch stream");
+    }
+    std::lock_guard<std::mutex> lock(es->ring.mutex);
+    n_channels = es->ring.width / (es->config.pre_samples + es->config.post_samples);
+    if (es->ring.buffered > 0 && n_channels > max_channels) {
+        return Result<size_t>::error("Epoch stream has " + std::to_string(n_channels) + " channels");
+    }
+    return Result<size_t>::ok(es->ring.pop(samples, events, max_epochs));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Host Spike Detection
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result<void> SdkSession::startSpikeDetection(const SpikeDetectionConfig& config) {
+    if (sampleRateHz(config.source) == 0.0) {
+        return Result<void>::error("Invalid source sample rate");
+    }
+    uint16_t list[cbNUM_ANALOG_CHANS];
+    const uint32_t n = getGroupChannelList(static_cast<uint32_t>(config.source), list, cbNUM_ANALOG_CHANS);
+    if (n == 0) {
+        return Result<void>::error("Source group has no channels");
+    }
+
+    SpikeDetectorConfig detector_config;
+    if (const uint32_t spike_length = getSpikeLength(); spike_length > 0) {
+        detector_config.spike_length = std::min<uint32_t>(spike_length, cbMAX_PNTS);
+        detector_config.pretrigger = std::min(getSpikePretrigger(), detector_config.spike_length - 1);
+    }
+    detector_config.refractory_samples = config.refractory_samples;
+    detector_config.rms_window = config.rms_window;
+    auto detector = ThresholdSpikeDetector::create(detector_config, n, config.threshold);
+    if (detector.isError()) {
+        return Result<void>::error(detector.error());
+    }
+
+    auto detection = std::make_shared<SpikeDetection>();
+    detection->source_group = static_cast<uint8_t>(config.source);
+    detection->channels.assign(list, list + n);
+    for (uint32_t col = 0; col < n; ++col) {
+        const auto* ci = getChanInfo(list[col]);
+        if (!ci || classifyChannelByCaps(*ci) != ChannelType::FRONTEND) {
+            (void)detector.value().setThreshold(col, SpikeThreshold::off());
+        }
+    }
+    detection->detector.emplace(std::move(detector.value()));
+    if (!config.filter.empty()) {
+        auto filter = BiquadFilterBank::create(config.filter, n);
+        if (filter.isError()) {
+            return Result<void>::error(filter.error());
+        }
+        detection->filter.emplace(std::move(filter.value()));
+    }
+
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    m_impl->editPipeline([&](ProcessingPipeline& p) { p.spike_detection = std::move(detection); });
+    return Result<void>::ok();
+}
+
+void SdkSession::stopSpikeDetection() {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    m_impl->editPipeline([](ProcessingPipeline& p) { p.spike_detection.reset(); });
+}
+
+bool SdkSession::isSpikeDetectionRunning() const {
+    return m_impl->loadPipeline()->spike_detection != nullptr;
+}
+
+Result<void> SdkSession::setSpikeDetectionThreshold(const uint32_t chan_id, const SpikeThreshold threshold) {
+    const auto detection = m_impl->loadPipeline()->spike_detection;
+    if (!detection) {
+        return Result<void>::error("Spike detection is not running");
+    }
+    const size_t col = detection->column(chan_id);
+    if (col == detection->channels.size()) {
+        return Result<void>::error("Channel " + std::to_string(chan_id) + " is not in the detected group");
+    }
+    std::lock_guard<std::mutex> lock(detection->mutex);
+    return detection->detector->setThreshold(col, threshold);
+}
+
+Result<int16_t> SdkSession::getSpikeDetectionLevel(const uint32_t chan_id) const {
+    const auto detection = m_impl->loadPipeline()->spike_detection;
+    if (!detection) {
+        return Result<int16_t>::error("Spike detection is not running");
+    }
+    const size_t col = detection->column(chan_id);
+    if (col == detection->channels.size()) {
+        return Result<int16_t>::error("Channel " + std::to_string(chan_id) + " is not in the detected group");
+    }
+    std::lock_guard<std::mutex> lock(detection->mutex);
+    return Result<int16_t>::ok(detection->detector->level(col));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Spike Binning
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result<void> SdkSession::startSpikeBinning(const SpikeBinnerConfig& config) {
+    if (config.channel_count > cbNUM_ANALOG_CHANS) {
+        return Result<void>::error("Spike bins cover at most " + std::to_string(cbNUM_ANALOG_CHANS) + " channels");
+    }
+    auto binner = SpikeBinner::create(config);
+    if (binner.isError()) {
+        return Result<void>::error(binner.error());
+    }
+    auto binning = std::make_shared<SpikeBinning>();
+    binning->binner.emplace(std::move(binner.value()));
+    binning->closed_counts.assign(config.buffer_bins * config.channel_count * config.unit_count, 0u);
+    binning->closed_starts.assign(config.buffer_bins, 0);
+
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    m_impl->editPipeline([&](ProcessingPipeline& p) { p.spike_binning = std::move(binning); });
+    return Result<void>::ok();
+}
+
+void SdkSession::stopSpikeBinning() {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    m_impl->editPipeline([](ProcessingPipeline& p) { p.spike_binning.reset(); });
+}
+
+bool SdkSession::isSpikeBinningRunning() const {
+    return m_impl->loadPipeline()->spike_binning != nullptr;
+}
+
+CallbackHandle SdkSession::registerSpikeBinCallback(SpikeBinCallback callback) const {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    const auto handle = m_impl->next_callback_handle++;
+    m_impl->editPipeline([&](ProcessingPipeline& p) {
+        p.spike_bin_callbacks.push_back({handle, std::move(callback)});
+    });
+    return handle;
+}
+
+Result<size_t> SdkSession::readSpikeBins(uint32_t* counts, uint64_t* start_times, const size_t max_bins) const {
+    const auto binning = m_impl->loadPipeline()->spike_binning;
+    if (!binning) {
+        return Result<size_t>::error("Spike binning is not running");
+    }
+    std::lock_guard<std::mutex> lock(binning->mutex);
+    return Result<size_t>::ok(binning->binner->readBins(counts, start_times, max_bins));
+}
+
+Result<SpikeBinnerStats> SdkSession::getSpikeBinningStats() const {
+    const auto binning = m_impl->loadPipeline()->spike_binning;
+    if (!binning) {
+        return Result<SpikeBinnerStats>::error("Spike binning is not running");
+    }
+    std::lock_guard<std::mutex> lock(binning->mutex);
+    return Result<SpikeBinnerStats>::ok(binning->binner->stats());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Digital Input Tracking
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result<void> SdkSession::startDigitalInputTracking(const size_t buffer_events) {
+    auto tracker = DigitalInputTracker::create(buffer_events);
+    if (tracker.isError()) {
+        return Result<void>::error(tracker.error());
+    }
+    auto tracking = std::make_shared<DigitalInputTracking>();
+    tracking->tracker.emplace(std::move(tracker.value()));
+
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    m_impl->editPipeline([&](ProcessingPipeline& p) { p.digital_inputs = std::move(tracking); });
+    return Result<void>::ok();
+}
+
+void SdkSession::stopDigitalInputTracking() {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    m_impl->editPipeline([](ProcessingPipeline& p) { p.digital_inputs.reset(); });
+}
+
+bool SdkSession::isDigitalInputTrackingRunning() const {
+    return m_impl->loadPipeline()->digital_inputs != nullptr;
+}
+
+Result<size_t> SdkSession::readDigitalInputEvents(uint64_t& cursor, DigitalInputEvent* events,
+                                                  const size_t max_events, uint64_t* skipped) const {
+    const auto tracking = m_impl->loadPipeline()->digital_inputs;
+    if (!tracking) {
+        return Result<size_t>::error("Digital input tracking is not running");
+    }
+    std::lock_guard<std::mutex> lock(tracking->mutex);
+    return Result<size_t>::ok(tracking->tracker->read(cursor, events, max_events, skipped));
+}
+
+Result<size_t> SdkSession::getDigitalInputState(const uint32_t chan_id, const uint64_t* times, const size_t n_times,
+                                                uint32_t* values) const {
+    const auto tracking = m_impl->loadPipeline()->digital_inputs;
+    if (!tracking) {
+        return Result<size_t>::error("Digital input tracking is not running");
+    }
+    std::lock_guard<std::mutex> lock(tracking->mutex);
+    return Result<size_t>::ok(tracking->tracker->stateAt(chan_id, times, n_times, values));
+}
+
+Result<uint32_t> SdkSession::getDigitalInputWord(const uint32_t chan_id) const {
+    const auto tracking = m_impl->loadPipeline()->digital_inputs;
+    if (!tracking) {
+        return Result<uint32_t>::error("Digital input tracking is not running");
+    }
+    std::lock_guard<std::mutex> lock(tracking->mutex);
+    return Result<uint32_t>::ok(tracking->tracker->current(chan_id));
+}
+
+Result<DigitalInputStats> SdkSession::getDigitalInputStats() const {
+    const auto tracking = m_impl->loadPipeline()->digital_inputs;
+    if (!tracking) {
+        return Result<DigitalInputStats>::error("Digital input tracking is not running");
+    }
+    std::lock_guard<std::mutex> lock(tracking->mutex);
+    return Result<DigitalInputStats>::ok(tracking->tracker->stats());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Host Spike Sorting
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+Result<void> SdkSession::startSpikeSorting(const SpikeSortingConfig& config) {
+    SpikeSorterConfig sorter_config;
+    sorter_config.spike_length = getSpikeLength();
+    sorter_config.gate = config.gate;
+    sorter_config.threads = config.threads;
+    auto created = SpikeSorter::create(sorter_config);
+    if (created.isError()) {
+        return Result<void>::error(created.error());
+    }
+    auto sorting = std::make_shared<SpikeSorting>();
+    sorting->device_spikes = config.device_spikes;
+    sorting->sorter.emplace(std::move(created.value()));
+    sorting->models.resize(cbNUM_ANALOG_CHANS + 1);
+
+    // Start from the models the device has sent (mirrored into shmem in both modes)
+    if (m_impl->shmem_session) {
+        const auto& shmem = *m_impl->shmem_session;
+        for (uint32_t chan = 0; chan < cbNUM_ANALOG_CHANS; ++chan) {
+            if (auto basis = shmem.getFeatureBasis(chan); basis.isOk() && basis.value().chan == chan + 1) {
+                foldSortPacket(sorting->models, basis.value());
+            }
+            for (uint32_t slot = 1; slot < cbMAXUNITS + 2; ++slot) {
+                if (auto model = shmem.getSortModel(chan, slot); model.isOk() && model.value().valid) {
+                    foldSortPacket(sorting->models, model.value());
+                }
+            }
+            if (auto boundary = shmem.getNoiseBoundary(chan); boundary.isOk() && boundary.value().chan == chan + 1) {
+                foldSortPacket(sorting->models, boundary.value());
+            }
+            applySortModel(*sorting->sorter, chan + 1, sorting->models[chan + 1]);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    m_impl->editPipeline([&](ProcessingPipeline& p) { p.spike_sorting = std::move(sorting); });
+    return Result<void>::ok();
+}
+
+void SdkSession::stopSpikeSorting() {
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    m_impl->editPipeline([](ProcessingPipeline& p) { p.spike_sorting.reset(); });
+}
+
+bool SdkSession::isSpikeSortingRunning() const {
+    return m_impl->loadPipeline()->spike_sorting != nullptr;
+}
+
+Result<void> SdkSession::setSpikeSortModel(const uint32_t chan_id, const ChannelSortModel& model) {
+    const auto sorting = m_impl->loadPipeline()->spike_sorting;
+    if (!sorting) {
+        return Result<void>::error("Spike sorting is not running");
+    }
+    std::lock_guard<std::mutex> lock(sorting->mutex);
+    auto installed = sorting->sorter->setModel(chan_id, model);
+    if (installed.isError()) {
+        return installed;
+    }
+    if (chan_id < sorting->models.size()) {
+        sorting->models[chan_id] = model;   // device packets update it from here
+    }
+    return Result<void>::ok();
+}
+
+Result<SpikeSorterStats> SdkSession::getSpikeSortingStats() const {
+    const auto sorting = m_impl->loadPipeline()->spike_sorting;
+    if (!sorting) {
+        return Result<SpikeSorterStats>::error("Spike sorting is not running");
+    }
+    std::lock_guard<std::mutex> lock(sorting->mutex);
+    return Result<SpikeSorterStats>::ok(sorting->sorter->stats());
+}
+
 SdkStats SdkSession::getStats() const {
     SdkStats stats = m_impl->stats.snapshot();
     stats.queue_current_depth = m_impl->packet_queue.size();
+    stats.queue_capacity = m_impl->packet_queue.capacity();
+    stats.receive_thread_cpu_ns = m_impl->receive_thread_cpu_ns.load(std::memory_order_relaxed);
+    stats.callback_thread_cpu_ns = m_impl->callback_thread_cpu_ns.load(std::memory_order_relaxed);
+    stats.send_thread_cpu_ns = m_impl->send_thread_cpu_ns.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::optional<SdkStats> SdkSession::getOwnerStats() const {
+    if (m_impl->standalone) {
+        return getStats();
+    }
+    if (!m_impl->shmem_session || m_impl->shmem_session->getLayout() != cbshm::ShmemLayout::NATIVE) {
+        return std::nullopt;  // Central does not publish stats
+    }
+
+    std::lock_guard<std::mutex> lock(m_impl->stats_segment_mutex);
+    if (!m_impl->stats_segment) {
+        auto result = cbshm::StatsSegment::open(getNativeSegmentName(m_impl->config.device_type, "stats"));
+        if (result.isError()) {
+            return std::nullopt;
+        }
+        m_impl->stats_segment = std::move(result.value());
+    }
+    if (!m_impl->stats_segment->isOwnerAlive()) {
+        m_impl->stats_segment.reset();  // Reopen once a new owner has published
+        return std::nullopt;
+    }
+
+    const cbshm::NativeStatsBuffer published = m_impl->stats_segment->read();
+    SdkStats stats;
+    stats.packets_received_from_device = published.packets_received_from_device;
+    stats.bytes_received_from_device = published.bytes_received_from_device;
+    stats.packets_stored_to_shmem = published.packets_stored_to_shmem;
+    stats.packets_queued_for_callback = published.packets_queued_for_callback;
+    stats.packets_delivered_to_callback = published.packets_delivered_to_callback;
+    stats.packets_dropped = published.packets_dropped;
+    stats.queue_current_depth = published.queue_current_depth;
+    stats.queue_max_depth = published.queue_max_depth;
+    stats.queue_capacity = published.queue_capacity;
+    stats.packets_sent_to_device = published.packets_sent_to_device;
+    stats.shmem_store_errors = published.shmem_store_errors;
+    stats.receive_errors = published.receive_errors;
+    stats.send_errors = published.send_errors;
+    stats.receive_thread_cpu_ns = published.receive_thread_cpu_ns;
+    stats.callback_thread_cpu_ns = published.callback_thread_cpu_ns;
+    stats.send_thread_cpu_ns = published.send_thread_cpu_ns;
+    return stats;
+}
+
+LatencyStats SdkSession::getLatencyStats() const {
+    const auto summarize = [](const cbutil::LatencyHistogram& hist) {
+        LatencySummary s;
+        s.count = hist.count();
+        if (s.count == 0) return s;
+        s.min_ns = hist.min();
+        s.p50_ns = hist.valueAtPercentile(50.0);
+        s.p90_ns = hist.valueAtPercentile(90.0);
+        s.p99_ns = hist.valueAtPercentile(99.0);
+        s.p999_ns = hist.valueAtPercentile(99.9);
+        s.max_ns = hist.max();
+        s.mean_ns = hist.mean();
+        return s;
+    };
+
+    LatencyStats stats;
+    stats.device_to_arrival = summarize(m_impl->latency.device_to_arrival);
+    stats.arrival_to_store = summarize(m_impl->latency.arrival_to_store);
+    stats.store_to_dequeue = summarize(m_impl->latency.store_to_dequeue);
+    stats.dequeue_to_callback = summarize(m_impl->latency.dequeue_to_callback);
+    stats.device_to_callback = summarize(m_impl->latency.device_to_callback);
     return stats;
 }
 
 void SdkSession::resetStats() {
     m_impl->stats.reset();
+    m_impl->latency.reset();
 }
 
 const SdkConfig& SdkSession::getConfig() const {
@@ -1819,21 +2958,6 @@ Result<std::vector<int32_t>> SdkSession::getChannelPositions(
     return Result<std::vector<int32_t>>::ok(std::move(positions));
 }
 
-/// Helper: map cbsdk::ChannelType to cbdev::ChannelType
-static cbdev::ChannelType toDevChannelType(const ChannelType chanType) {
-    switch (chanType) {
-        case ChannelType::FRONTEND:    return cbdev::ChannelType::FRONTEND;
-        case ChannelType::ANALOG_IN:   return cbdev::ChannelType::ANALOG_IN;
-        case ChannelType::ANALOG_OUT:  return cbdev::ChannelType::ANALOG_OUT;
-        case ChannelType::AUDIO:       return cbdev::ChannelType::AUDIO;
-        case ChannelType::DIGITAL_IN:  return cbdev::ChannelType::DIGITAL_IN;
-        case ChannelType::SERIAL:      return cbdev::ChannelType::SERIAL;
-        case ChannelType::DIGITAL_OUT: return cbdev::ChannelType::DIGITAL_OUT;
-        default:                       return cbdev::ChannelType::FRONTEND;
-    }
-}
-
-
 // Resolve (nChans, chans) into the explicit set of 1-based channel ids to
 // configure.  When @p chans is non-null, it's the verbatim list (length
 // nChans).  When @p chans is null, walk channel ids in ascending order and
@@ -1858,25 +2982,52 @@ static std::vector<uint32_t> resolveTargetChans(
     return result;
 }
 
-Result<void> SdkSession::setSampleGroup(
-    const uint32_t nChans, const ChannelType chanType, const SampleRate rate,
-    const bool disableOthers, const uint32_t* chans) {
-    // Pre-sync: ensure local chaninfo cache is up to date before we seed
-    // outgoing CHANSET* packets from it.  Stale cache would re-send obsolete
-    // values for fields we don't explicitly modify here.
-    if (auto r = sync(5000); r.isError()) return r;
+// A setter's channel selection, owning a copy of an explicit list so that a staged setter
+// can be resolved at commit, after the caller's array is gone
+struct ChannelSelection {
+    uint32_t nChans;
+    ChannelType chanType;
+    bool listed;
+    std::vector<uint32_t> chans;
 
-    const uint32_t group_id = static_cast<uint32_t>(rate);
-    const std::vector<uint32_t> targets = resolveTargetChans(*this, nChans, chanType, chans);
-
-    // Build a packet for `chan` with `grp` as its target group.
-    // Always sends the full chaninfo (seeded from local cache), so a stale
-    // CHANREP can't leave us stuck against a concurrent change.
-    auto build_packet = [this](uint32_t chan, uint32_t grp) -> std::optional<cbPKT_CHANINFO> {
-        const cbPKT_CHANINFO* base = getChanInfo(chan);
-        if (!base || base->chan == 0) return std::nullopt;
-        cbPKT_CHANINFO chaninfo = *base;
-        chaninfo.chan = chan;
+    ChannelSelection(const uint32_t n, const ChannelType type, const uint32_t* list)
+        : nChans(n), chanType(type), listed(list != nullptr),
+          chans(list ? std::vector<uint32_t>(list, list + n) : std::vector<uint32_t>{}) {}
+
+    std::vector<uint32_t> resolve(const SdkSession& session) const {
+        return resolveTargetChans(session, nChans, chanType, listed ? chans.data() : nullptr);
+    }
+};
+
+// Seed an outgoing CHANSET* packet for @p chan: the last chaninfo this session sent
+// if the channel still has asynchronous changes in flight, else the local cache.
+static bool seedChanInfo(const SdkSession& session, const ConfigTracker& tracker,
+                         uint32_t chan, cbPKT_CHANINFO& out) {
+    if (tracker.shadow(chan, out)) {
+        return true;
+    }
+    const cbPKT_CHANINFO* base = session.getChanInfo(chan);
+    if (!base || base->chan == 0) return false;
+    out = *base;
+    return true;
+}
+
+// Turn staged edits into one CHANSET* packet per channel, seeded via seedChanInfo().
+// Always sends the full chaninfo, so a stale CHANREP can't leave us stuck against a
+// concurrent change.
+static std::vector<cbPKT_GENERIC> buildEditPackets(
+    const SdkSession& session, const ConfigTracker& tracker, const ConfigTransaction& edits,
+    const bool skipUnchanged = false, size_t* skipped = nullptr) {
+    return edits.build(
+        [&session, &tracker](const uint32_t chan, cbPKT_CHANINFO& out) {
+            return seedChanInfo(session, tracker, chan, out);
+        },
+        skipUnchanged, skipped);
+}
+
+// Edit applied by setSampleGroup to move a channel to group `grp` (0 = disabled).
+static ChanInfoEdit sampleGroupEdit(const uint32_t grp) {
+    return [grp](cbPKT_CHANINFO& chaninfo) {
         if (grp > 0 && grp < 6) {
             chaninfo.cbpkt_header.type = cbPKTTYPE_CHANSETSMP;
             chaninfo.smpgroup = grp;
@@ -1894,31 +3045,108 @@ Result<void> SdkSession::setSampleGroup(
             chaninfo.smpgroup = 0;
             chaninfo.ainpopts &= ~cbAINP_RAWSTREAM;
         }
-        return chaninfo;
     };
+}
+
+// Collect the edits for setSampleGroup / setSampleGroupAsync.  Targets are moved to
+// `rate`, then — if disableOthers — every other matching channel is disabled.
+static ConfigTransaction sampleGroupEdits(
+    const SdkSession& session, const ChannelSelection& selection, const SampleRate rate,
+    const bool disableOthers) {
+    const uint32_t group_id = static_cast<uint32_t>(rate);
+    const std::vector<uint32_t> targets = selection.resolve(session);
 
-    // Build the packet vector.  Targets first (configured to `rate`), then
-    // — if disableOthers — every other matching channel set to disabled.
-    std::vector<cbPKT_GENERIC> packets;
-    packets.reserve(targets.size() + (disableOthers ? cbMAXCHANS : 0));
+    ConfigTransaction edits;
     for (uint32_t chan : targets) {
-        if (auto pkt = build_packet(chan, group_id); pkt) {
-            packets.push_back(reinterpret_cast<const cbPKT_GENERIC&>(*pkt));
-        }
+        edits.stage(chan, sampleGroupEdit(group_id));
     }
     if (disableOthers) {
         std::set<uint32_t> target_set(targets.begin(), targets.end());
         for (uint32_t chan = 1; chan <= cbMAXCHANS; ++chan) {
             if (target_set.count(chan)) continue;
-            const cbPKT_CHANINFO* ci = getChanInfo(chan);
-            if (!ci || classifyChannelByCaps(*ci) != chanType) continue;
-            if (auto pkt = build_packet(chan, 0u); pkt) {
-                packets.push_back(reinterpret_cast<const cbPKT_GENERIC&>(*pkt));
-            }
+            const cbPKT_CHANINFO* ci = session.getChanInfo(chan);
+            if (!ci || classifyChannelByCaps(*ci) != selection.chanType) continue;
+            edits.stage(chan, sampleGroupEdit(0u));
         }
     }
+    return edits;
+}
+
+// Collect the per-channel edits for the three "configure-each" bulk setters
+// that don't have disable_others semantics: setSpikeSorting,
+// setSpikeExtraction, setACInputCoupling (and their *Async variants).
+// Stages @p mutate for every resolved target channel.
+template<typename Mutate>
+static ConfigTransaction bulkSetterEdits(
+    const SdkSession& session, const ChannelSelection& selection, Mutate&& mutate) {
+    ConfigTransaction edits;
+    for (uint32_t chan : selection.resolve(session)) {
+        edits.stage(chan, mutate);
+    }
+    return edits;
+}
 
-    return sendBulkPackets(packets);
+/// Field updates shared by the blocking and asynchronous bulk setters
+static auto spikeSortingMutator(const uint32_t sortOptions) {
+    return [sortOptions](cbPKT_CHANINFO& ci) {
+        // Use CHANSET so the firmware applies spkopts.  CHANSETSPKTHR
+        // (used by older revisions) only reads spkthrlevel and would
+        // silently ignore the spkopts modification.
+        ci.cbpkt_header.type = cbPKTTYPE_CHANSET;
+        ci.spkopts &= ~cbAINPSPK_ALLSORT;
+        ci.spkopts |= sortOptions;
+    };
+}
+
+static auto spikeExtractionMutator(const bool enabled) {
+    return [enabled](cbPKT_CHANINFO& ci) {
+        ci.cbpkt_header.type = cbPKTTYPE_CHANSETSPK;
+        ci.spkopts &= ~cbAINPSPK_EXTRACT;
+        if (enabled) ci.spkopts |= cbAINPSPK_EXTRACT;
+    };
+}
+
+static auto acInputCouplingMutator(const bool enabled) {
+    return [enabled](cbPKT_CHANINFO& ci) {
+        ci.cbpkt_header.type = cbPKTTYPE_CHANSETAINP;
+        if (enabled) ci.ainpopts |= cbAINP_OFFSET_CORRECT;
+        else         ci.ainpopts &= ~cbAINP_OFFSET_CORRECT;
+    };
+}
+
+// Blocking bulk setters are fire-and-forget on the response side — caller
+// can call sync() if it needs to read back state.  Outside a transaction they
+// pre-sync so the local chaninfo cache is up to date before we seed outgoing
+// CHANSET* packets from it (a stale cache would re-send obsolete values for
+// fields we don't explicitly modify) and before resolving which channels a by-type
+// selection targets.  Inside one, the call is only staged: commit collects its edits
+// after its own sync, so by-type selections and disableOthers see the configuration the
+// packets are seeded from.
+Result<void> SdkSession::applyChannelEdits(std::function<ConfigTransaction()> collect_edits) {
+    {
+        std::lock_guard<std::mutex> lock(m_impl->txn_mutex);
+        if (m_impl->txn) {
+            m_impl->txn->push_back(std::move(collect_edits));
+            return Result<void>::ok();
+        }
+    }
+    if (auto r = sync(5000); r.isError()) return r;
+    return sendBulkPackets(buildEditPackets(*this, m_impl->config_tracker, collect_edits()));
+}
+
+Result<void> SdkSession::setSampleGroup(
+    const uint32_t nChans, const ChannelType chanType, const SampleRate rate,
+    const bool disableOthers, const uint32_t* chans) {
+    return applyChannelEdits([this, selection = ChannelSelection(nChans, chanType, chans), rate, disableOthers] {
+        return sampleGroupEdits(*this, selection, rate, disableOthers);
+    });
+}
+
+Result<ConfigOperation> SdkSession::setSampleGroupAsync(
+    const uint32_t nChans, const ChannelType chanType, const SampleRate rate,
+    const bool disableOthers, const uint32_t* chans, const uint32_t timeout_ms) {
+    return sendTracked(buildEditPackets(*this, m_impl->config_tracker,
+        sampleGroupEdits(*this, {nChans, chanType, chans}, rate, disableOthers)), timeout_ms);
 }
 
 // Bulk-send a vector of packets using the most efficient path:
@@ -1940,75 +3168,163 @@ Result<void> SdkSession::sendBulkPackets(const std::vector<cbPKT_GENERIC>& packe
     return Result<void>::ok();
 }
 
-// Helper for the three "configure-each" bulk setters that don't have
-// disable_others semantics: setSpikeSorting, setSpikeExtraction,
-// setACInputCoupling.  Pre-syncs, iterates the resolved target list,
-// builds a packet per chan via @p mutate, and sends.  Fire-and-forget
-// on the response side — caller can call sync() if it needs to read
-// back state.
-template<typename Mutate>
-static Result<void> applyBulkSetter(
-    SdkSession& session, uint32_t nChans, ChannelType chanType,
-    const uint32_t* chans, Mutate&& mutate) {
-    if (auto r = session.sync(5000); r.isError()) return r;
-
-    const std::vector<uint32_t> targets = resolveTargetChans(session, nChans, chanType, chans);
-    std::vector<cbPKT_GENERIC> packets;
-    packets.reserve(targets.size());
-    for (uint32_t chan : targets) {
-        const cbPKT_CHANINFO* base = session.getChanInfo(chan);
-        if (!base || base->chan == 0) continue;
-        cbPKT_CHANINFO chaninfo = *base;
-        chaninfo.chan = chan;
-        mutate(chaninfo);
-        packets.push_back(reinterpret_cast<const cbPKT_GENERIC&>(chaninfo));
+Result<ConfigOperation> SdkSession::sendTracked(
+    const std::vector<cbPKT_GENERIC>& packets, const uint32_t timeout_ms) {
+    // Register before sending so an early CHANREP can't slip past the tracker
+    auto op = m_impl->config_tracker.begin(packets, std::chrono::milliseconds(timeout_ms));
+    if (auto r = sendBulkPackets(packets); r.isError()) {
+        m_impl->config_tracker.fail(op, r.error());
+        return Result<ConfigOperation>::error(r.error());
     }
-
-    return session.sendBulkPackets(packets);
+    return Result<ConfigOperation>::ok(std::move(op));
 }
 
 Result<void> SdkSession::setSpikeSorting(
     const uint32_t nChans, const ChannelType chanType, const uint32_t sortOptions,
     const uint32_t* chans) {
-    return applyBulkSetter(*this, nChans, chanType, chans,
-        [sortOptions](cbPKT_CHANINFO& ci) {
-            // Use CHANSET so the firmware applies spkopts.  CHANSETSPKTHR
-            // (used by older revisions) only reads spkthrlevel and would
-            // silently ignore the spkopts modification.
-            ci.cbpkt_header.type = cbPKTTYPE_CHANSET;
-            ci.spkopts &= ~cbAINPSPK_ALLSORT;
-            ci.spkopts |= sortOptions;
-        });
+    return applyChannelEdits([this, selection = ChannelSelection(nChans, chanType, chans),
+                              mutate = spikeSortingMutator(sortOptions)] {
+        return bulkSetterEdits(*this, selection, mutate);
+    });
 }
 
 Result<void> SdkSession::setSpikeExtraction(
     const uint32_t nChans, const ChannelType chanType, const bool enabled,
     const uint32_t* chans) {
-    return applyBulkSetter(*this, nChans, chanType, chans,
-        [enabled](cbPKT_CHANINFO& ci) {
-            ci.cbpkt_header.type = cbPKTTYPE_CHANSETSPK;
-            ci.spkopts &= ~cbAINPSPK_EXTRACT;
-            if (enabled) ci.spkopts |= cbAINPSPK_EXTRACT;
-        });
+    return applyChannelEdits([this, selection = ChannelSelection(nChans, chanType, chans),
+                              mutate = spikeExtractionMutator(enabled)] {
+        return bulkSetterEdits(*this, selection, mutate);
+    });
 }
 
 Result<void> SdkSession::setACInputCoupling(
     const uint32_t nChans, const ChannelType chanType, const bool enabled,
     const uint32_t* chans) {
-    return applyBulkSetter(*this, nChans, chanType, chans,
-        [enabled](cbPKT_CHANINFO& ci) {
-            ci.cbpkt_header.type = cbPKTTYPE_CHANSETAINP;
-            if (enabled) ci.ainpopts |= cbAINP_OFFSET_CORRECT;
-            else         ci.ainpopts &= ~cbAINP_OFFSET_CORRECT;
-        });
+    return applyChannelEdits([this, selection = ChannelSelection(nChans, chanType, chans),
+                              mutate = acInputCouplingMutator(enabled)] {
+        return bulkSetterEdits(*this, selection, mutate);
+    });
+}
+
+Result<ConfigOperation> SdkSession::setSpikeSortingAsync(
+    const uint32_t nChans, const ChannelType chanType, const uint32_t sortOptions,
+    const uint32_t* chans, const uint32_t timeout_ms) {
+    return sendTracked(buildEditPackets(*this, m_impl->config_tracker, bulkSetterEdits(
+        *this, {nChans, chanType, chans}, spikeSortingMutator(sortOptions))), timeout_ms);
+}
+
+Result<ConfigOperation> SdkSession::setSpikeExtractionAsync(
+    const uint32_t nChans, const ChannelType chanType, const bool enabled,
+    const uint32_t* chans, const uint32_t timeout_ms) {
+    return sendTracked(buildEditPackets(*this, m_impl->config_tracker, bulkSetterEdits(
+        *this, {nChans, chanType, chans}, spikeExtractionMutator(enabled))), timeout_ms);
+}
+
+Result<ConfigOperation> SdkSession::setACInputCouplingAsync(
+    const uint32_t nChans, const ChannelType chanType, const bool enabled,
+    const uint32_t* chans, const uint32_t timeout_ms) {
+    return sendTracked(buildEditPackets(*this, m_impl->config_tracker, bulkSetterEdits(
+        *this, {nChans, chanType, chans}, acInputCouplingMutator(enabled))), timeout_ms);
 }
 
 Result<void> SdkSession::setChannelConfig(const cbPKT_CHANINFO& chaninfo) {
+    {
+        // Inside a transaction the packet replaces the channel's staged state wholesale;
+        // later setters in the same transaction still apply on top of it.
+        std::lock_guard<std::mutex> lock(m_impl->txn_mutex);
+        if (m_impl->txn && (chaninfo.cbpkt_header.type & 0xF0) == cbPKTTYPE_CHANSET &&
+            chaninfo.chan != 0 && chaninfo.chan <= cbMAXCHANS) {
+            m_impl->txn->push_back([chaninfo] {
+                ConfigTransaction edits;
+                edits.stage(chaninfo.chan, [chaninfo](cbPKT_CHANINFO& ci) { ci = chaninfo; });
+                return edits;
+            });
+            return Result<void>::ok();
+        }
+    }
     if (m_impl->device_session)
         return m_impl->device_session->setChannelConfig(chaninfo);
     return sendPacket(reinterpret_cast<const cbPKT_GENERIC&>(chaninfo));
 }
 
+Result<ConfigOperation> SdkSession::setChannelConfigAsync(
+    const cbPKT_CHANINFO& chaninfo, const uint32_t timeout_ms) {
+    if ((chaninfo.cbpkt_header.type & 0xF0) != cbPKTTYPE_CHANSET ||
+        chaninfo.chan == 0 || chaninfo.chan > cbMAXCHANS) {
+        return Result<ConfigOperation>::error("setChannelConfigAsync requires a CHANSET* packet for a valid channel");
+    }
+    cbPKT_GENERIC pkt = {};
+    std::memcpy(&pkt, &chaninfo, sizeof(chaninfo));
+    pkt.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    return sendTracked({pkt}, timeout_ms);
+}
+
+///--------------------------------------------------------------------------------------------
+/// Configuration Transactions
+///--------------------------------------------------------------------------------------------
+
+Result<void> SdkSession::beginConfigTransaction() {
+    std::lock_guard<std::mutex> lock(m_impl->txn_mutex);
+    if (m_impl->txn) {
+        return Result<void>::error("A configuration transaction is already open");
+    }
+    m_impl->txn.emplace();
+    return Result<void>::ok();
+}
+
+bool SdkSession::inConfigTransaction() const {
+    std::lock_guard<std::mutex> lock(m_impl->txn_mutex);
+    return m_impl->txn.has_value();
+}
+
+void SdkSession::abortConfigTransaction() {
+    std::lock_guard<std::mutex> lock(m_impl->txn_mutex);
+    m_impl->txn.reset();
+}
+
+Result<ConfigCommitStats> SdkSession::commitConfigTransaction(
+    const bool skipUnchanged, const uint32_t timeout_ms) {
+    std::vector<std::function<ConfigTransaction()>> staged;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->txn_mutex);
+        if (!m_impl->txn) {
+            return Result<ConfigCommitStats>::error("No configuration transaction is open");
+        }
+        staged = std::move(*m_impl->txn);
+        m_impl->txn.reset();
+    }
+
+    ConfigCommitStats stats;
+    if (staged.empty()) {
+        return Result<ConfigCommitStats>::ok(stats);
+    }
+
+    // The one sync of the transaction: resolve every staged setter's channels, and seed
+    // every merged packet (and, with skipUnchanged, compare against) chaninfo that
+    // reflects all prior changes.
+    if (auto r = sync(timeout_ms); r.isError()) {
+        return Result<ConfigCommitStats>::error(r.error());
+    }
+    ConfigTransaction edits;
+    for (const auto& collect_edits : staged) {
+        edits.merge(collect_edits());
+    }
+    stats.channels = edits.channelCount();
+    const auto packets = buildEditPackets(*this, m_impl->config_tracker, edits,
+                                          skipUnchanged, &stats.skipped);
+    stats.sent = packets.size();
+
+    // Completion is each channel's CHANREP, not a trailing SYSREP barrier
+    auto op = sendTracked(packets, timeout_ms);
+    if (op.isError()) {
+        return Result<ConfigCommitStats>::error(op.error());
+    }
+    if (auto r = op.value().wait(timeout_ms); r.isError()) {
+        return Result<ConfigCommitStats>::error(r.error());
+    }
+    return Result<ConfigCommitStats>::ok(stats);
+}
+
 ///--------------------------------------------------------------------------------------------
 /// Comments
 ///--------------------------------------------------------------------------------------------
@@ -2581,6 +3897,119 @@ std::optional<int64_t> SdkSession::getClockUncertaintyNs() const {
     return m_impl->client_clock_sync.getUncertaintyNs();
 }
 
+Result<void> SdkSession::startCapture(const std::string& path) {
+    if (!m_impl->device_session) {
+        return Result<void>::error("Capture is only available in STANDALONE mode");
+    }
+    auto r = m_impl->device_session->startCapture(path);
+    if (r.isError())
+        return Result<void>::error(r.error());
+    return Result<void>::ok();
+}
+
+void SdkSession::stopCapture() {
+    if (m_impl->device_session)
+        m_impl->device_session->stopCapture();
+}
+
+bool SdkSession::isReplayFinished() const {
+    return m_impl->device_session && m_impl->device_session->isReplayFinished();
+}
+
+Result<void> SdkSession::startRecording(const std::string& base_path, const RecordingOptions& options) {
+    std::lock_guard<std::mutex> recording_lock(m_impl->recording_mutex);
+    if (m_impl->loadPipeline()->recorder) {
+        return Result<void>::error("A recording is already running");
+    }
+
+    const auto filterOf = [this](const uint32_t filter_id) {
+        cbFILTDESC desc{};
+        if (const auto* fi = getFilterInfo(filter_id)) {
+            std::memcpy(desc.label, fi->label, sizeof(desc.label));
+            desc.hpfreq = fi->hpfreq;
+            desc.hporder = fi->hporder;
+            desc.hptype = fi->hptype;
+            desc.lpfreq = fi->lpfreq;
+            desc.lporder = fi->lporder;
+            desc.lptype = fi->lptype;
+        }
+        return desc;
+    };
+    const auto channelOf = [&](const uint32_t chan) {
+        RecordingChannel rc;
+        if (const auto* ci = getChanInfo(chan)) {
+            rc.info = *ci;
+            rc.continuous_filter = filterOf(ci->smpfilter);
+            rc.spike_filter = filterOf(ci->spkfilter);
+        }
+        rc.info.chan = chan;
+        return rc;
+    };
+
+    RecordingLayout layout;
+    if (const uint32_t spike_length = getSpikeLength(); spike_length > 0) {
+        layout.spike_length = spike_length;
+    }
+    for (uint32_t group_id = 1; group_id <= cbMAXGROUPS; ++group_id) {
+        uint16_t list[cbNUM_ANALOG_CHANS];
+        const uint32_t n = getGroupChannelList(group_id, list, cbNUM_ANALOG_CHANS);
+        if (n == 0) {
+            continue;
+        }
+        RecordingGroup group;
+        group.group_id = group_id;
+        const auto* gi = getGroupInfo(group_id);
+        if (gi && gi->period > 0) {
+            group.period = gi->period;
+        }
+        for (uint32_t i = 0; i < n; ++i) {
+            group.channels.push_back(channelOf(list[i]));
+        }
+        layout.groups.push_back(std::move(group));
+    }
+    for (uint32_t chan = 1; chan <= cbMAXCHANS; ++chan) {
+        const auto* ci = getChanInfo(chan);
+        if (!ci || (ci->chancaps & cbCHAN_EXISTS) == 0 || (ci->chancaps & (cbCHAN_AINP | cbCHAN_DINP)) == 0) {
+            continue;
+        }
+        layout.event_channels.push_back(channelOf(chan));
+    }
+
+    auto result = Recorder::open(base_path, layout, options);
+    if (result.isError()) {
+        return Result<void>::error(result.error());
+    }
+    auto recorder = std::make_shared<Recorder>(std::move(result.value()));
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    m_impl->editPipeline([&](ProcessingPipeline& p) { p.recorder = std::move(recorder); });
+    return Result<void>::ok();
+}
+
+void SdkSession::stopRecording() {
+    std::lock_guard<std::mutex> recording_lock(m_impl->recording_mutex);
+    std::shared_ptr<Recorder> recorder;
+    {
+        std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+        m_impl->editPipeline([&](ProcessingPipeline& p) { recorder.swap(p.recorder); });
+    }
+    if (recorder) {
+        // A dispatch still holding a snapshot only sees its packets counted as dropped
+        recorder->close();
+        std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+        m_impl->last_recording_stats = recorder->stats();
+    }
+}
+
+bool SdkSession::isRecording() const {
+    return m_impl->loadPipeline()->recorder != nullptr;
+}
+
+RecorderStats SdkSession::getRecordingStats() const {
+    const auto recorder = m_impl->loadPipeline()->recorder;
+    std::lock_guard<std::mutex> lock(m_impl->user_callback_mutex);
+    return recorder ? recorder->stats() : m_impl->last_recording_stats;
+}
+
 Result<void> SdkSession::sendPacket(const cbPKT_GENERIC& pkt) {
     // Enqueue packet to shared memory transmit buffer
     // Works in both STANDALONE and CLIENT modes:
@@ -0,0 +1,194 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   spike_binner.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Binned spike counts for real-time decoders
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/spike_binner.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace cbsdk {
+
+struct SpikeBinner::Impl {
+    SpikeBinnerConfig config;
+    size_t cells = 0;                   // channel_count * unit_count
+    size_t open_slots = 0;              // bins that can be open at once
+
+    std::vector<uint32_t> open;         // [open_slots][cells]; bin k lives in slot k % open_slots
+    std::vector<uint32_t> history;      // [buffer_bins][cells]; closed bin q lives in slot q % buffer_bins
+    std::vector<uint64_t> history_start;
+
+    bool started = false;
+    uint64_t next_close = 0;            // oldest open bin
+    uint64_t closed = 0;                // bins closed so far (sequence number of the next one)
+    uint64_t read_cursor = 0;
+    uint64_t take_cursor = 0;
+    SpikeBinnerStats stats;
+
+    void start(const uint64_t time) {
+        next_close = (time > config.latency ? time - config.latency : 0) / config.bin_width;
+        started = true;
+    }
+
+    void restart(const uint64_t time) {
+        std::fill(open.begin(), open.end(), 0u);
+        start(time);
+    }
+
+    void closeOne() {
+        uint32_t* src = &open[(next_close % open_slots) * cells];
+        const size_t dst = static_cast<size_t>(closed % config.buffer_bins);
+        std::memcpy(&history[dst * cells], src, cells * sizeof(uint32_t));
+        std::fill_n(src, cells, 0u);
+        history_start[dst] = next_close * config.bin_width;
+        ++closed;
+        ++next_close;
+        ++stats.bins_closed;
+    }
+
+    /// Close every bin before bin @p target
+    void closeUpTo(const uint64_t target) {
+        if (target <= next_close) {
+            return;
+        }
+        // Across a long gap only the open bins hold counts; of the empty ones after them,
+        // close just those the history can still hold
+        if (target - next_close > open_slots + config.buffer_bins) {
+            for (size_t i = 0; i < open_slots; ++i) {
+                closeOne();
+            }
+            const uint64_t skip = target - next_close - config.buffer_bins;
+            next_close += skip;
+            stats.bins_skipped += skip;
+        }
+        while (next_close < target) {
+            closeOne();
+        }
+    }
+
+    /// A device clock restart shows as a time further back than the history reaches
+    bool isRestart(const uint64_t bin) const {
+        return bin + open_slots + config.buffer_bins < next_close;
+    }
+
+    size_t read(uint64_t& cursor, uint32_t* counts, uint64_t* start_times, const size_t max_bins,
+                uint64_t* overwritten) {
+        if (closed - cursor > config.buffer_bins) {
+            if (overwritten) {
+                *overwritten += closed - cursor - config.buffer_bins;
+            }
+            cursor = closed - config.buffer_bins;
+        }
+        const auto n = static_cast<size_t>(std::min<uint64_t>(max_bins, closed - cursor));
+        for (size_t i = 0; i < n; ++i, ++cursor) {
+            const size_t slot = static_cast<size_t>(cursor % config.buffer_bins);
+            std::memcpy(counts + i * cells, &history[slot * cells], cells * sizeof(uint32_t));
+            if (start_times) {
+                start_times[i] = history_start[slot];
+            }
+        }
+        return n;
+    }
+};
+
+SpikeBinner::SpikeBinner() = default;
+SpikeBinner::SpikeBinner(SpikeBinner&&) noexcept = default;
+SpikeBinner& SpikeBinner::operator=(SpikeBinner&&) noexcept = default;
+SpikeBinner::~SpikeBinner() = default;
+
+cbutil::Result<SpikeBinner> SpikeBinner::create(const SpikeBinnerConfig& config) {
+    using R = cbutil::Result<SpikeBinner>;
+    if (config.bin_width == 0) {
+        return R::error("Bin width must be positive");
+    }
+    if (config.channel_count == 0 || config.unit_count == 0 || config.buffer_bins == 0) {
+        return R::error("Channel count, unit count and buffer size must be positive");
+    }
+    if (config.latency / config.bin_width >= config.buffer_bins) {
+        return R::error("Latency must be shorter than the buffered bins");
+    }
+    auto impl = std::make_unique<Impl>();
+    impl->config = config;
+    impl->cells = config.channel_count * config.unit_count;
+    impl->open_slots = static_cast<size_t>(config.latency / config.bin_width) + 3;
+    impl->open.assign(impl->open_slots * impl->cells, 0u);
+    impl->history.assign(config.buffer_bins * impl->cells, 0u);
+    impl->history_start.assign(config.buffer_bins, 0);
+
+    SpikeBinner binner;
+    binner.m_impl = std::move(impl);
+    return R::ok(std::move(binner));
+}
+
+void SpikeBinner::addSpike(const uint32_t chan_id, const uint32_t unit, const uint64_t time) {
+    auto& s = *m_impl;
+    if (chan_id == 0 || chan_id > s.config.channel_count || unit >= s.config.unit_count) {
+        ++s.stats.spikes_ignored;
+        return;
+    }
+    if (!s.started) {
+        s.start(time);
+    }
+    const uint64_t bin = time / s.config.bin_width;
+    if (bin < s.next_close) {
+        if (!s.isRestart(bin)) {
+            ++s.stats.spikes_late;
+            return;
+        }
+        s.restart(time);
+    }
+    // A spike past the open bins means device time moved on without advance()
+    if (bin >= s.next_close + s.open_slots) {
+        s.closeUpTo(bin - s.open_slots + 1);
+    }
+    ++s.open[(bin % s.open_slots) * s.cells + (chan_id - 1) * s.config.unit_count + unit];
+    ++s.stats.spikes_counted;
+}
+
+void SpikeBinner::advance(const uint64_t now) {
+    auto& s = *m_impl;
+    if (!s.started) {
+        s.start(now);
+    } else if (s.isRestart(now / s.config.bin_width)) {
+        s.restart(now);
+    }
+    if (now >= s.config.latency) {
+        s.closeUpTo((now - s.config.latency) / s.config.bin_width);
+    }
+}
+
+size_t SpikeBinner::readBins(uint32_t* counts, uint64_t* start_times, const size_t max_bins) {
+    return m_impl->read(m_impl->read_cursor, counts, start_times, max_bins, &m_impl->stats.bins_overwritten);
+}
+
+size_t SpikeBinner::takeClosed(uint32_t* counts, uint64_t* start_times, const size_t max_bins) {
+    return m_impl->read(m_impl->take_cursor, counts, start_times, max_bins, nullptr);
+}
+
+size_t SpikeBinner::buffered() const {
+    return static_cast<size_t>(std::min<uint64_t>(m_impl->closed - m_impl->read_cursor, m_impl->config.buffer_bins));
+}
+
+void SpikeBinner::reset() {
+    auto& s = *m_impl;
+    std::fill(s.open.begin(), s.open.end(), 0u);
+    s.started = false;
+    s.read_cursor = s.closed;
+    s.take_cursor = s.closed;
+}
+
+const SpikeBinnerConfig& SpikeBinner::config() const {
+    return m_impl->config;
+}
+
+SpikeBinnerStats SpikeBinner::stats() const {
+    return m_impl->stats;
+}
+
+} // namespace cbsdk
@@ -0,0 +1,340 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   spike_detector.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Host-side threshold-crossing spike detection
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/spike_detector.h"
+
+#include <cbproto/cbproto.h>
+#include <cbutil/simd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace cbsdk {
+
+namespace {
+
+/// Channels per SIMD step; buffered rows are padded to a multiple of this
+constexpr size_t LANES = 8;
+
+constexpr int16_t SAMPLE_MIN = std::numeric_limits<int16_t>::min();
+constexpr int16_t SAMPLE_MAX = std::numeric_limits<int16_t>::max();
+
+cbutil::Result<void> checkThreshold(const SpikeThreshold& threshold) {
+    switch (threshold.mode) {
+        case ThresholdMode::OFF:
+            return cbutil::Result<void>::ok();
+        case ThresholdMode::LEVEL:
+            if (threshold.level == 0) {
+                return cbutil::Result<void>::error("Threshold level must not be 0");
+            }
+            return cbutil::Result<void>::ok();
+        case ThresholdMode::RMS:
+            if (threshold.rms_multiplier == 0.0f || !std::isfinite(threshold.rms_multiplier)) {
+                return cbutil::Result<void>::error("RMS multiplier must be finite and non-zero");
+            }
+            return cbutil::Result<void>::ok();
+    }
+    return cbutil::Result<void>::error("Invalid threshold mode");
+}
+
+} // anonymous namespace
+
+struct ThresholdSpikeDetector::Impl {
+    struct Pending {
+        uint32_t column;
+        uint64_t trigger;       // absolute row of the crossing
+        int16_t level;
+    };
+
+    SpikeDetectorConfig config;
+    size_t channels = 0;
+    size_t padded = 0;
+
+    std::vector<SpikeThreshold> thresholds;
+    std::vector<int16_t> levels;        // [channels]: level compared against, 0 = none
+    std::vector<int16_t> lo;            // [padded]: beyond if sample < lo ...
+    std::vector<int16_t> hi;            // [padded]: ... or sample > hi
+    std::vector<int16_t> prev;          // [padded]: 0xFFFF where the last row was beyond
+
+    std::vector<double> mean_square;    // [channels]
+    std::vector<float> acc;             // [padded]: one batch's sum of squares
+    uint64_t seen = 0;
+
+    std::vector<int16_t> history;       // [rows][padded]: samples not yet needed by any waveform dropped
+    std::vector<uint64_t> history_ts;
+    size_t rows = 0;
+    uint64_t first = 0;                 // absolute row of history row 0
+    std::vector<uint64_t> next_allowed; // [channels]: first absolute row a crossing may trigger
+    std::vector<Pending> pending;       // crossings waiting for the rest of their waveform
+    std::vector<int16_t> waves;
+
+    void clear() {
+        std::fill(prev.begin(), prev.end(), int16_t{0});
+        std::fill(mean_square.begin(), mean_square.end(), 0.0);
+        std::fill(next_allowed.begin(), next_allowed.end(), uint64_t{0});
+        seen = 0;
+        history.clear();
+        history_ts.clear();
+        rows = 0;
+        first = 0;
+        pending.clear();
+        waves.clear();
+        for (size_t c = 0; c < channels; ++c) {
+            refreshLevel(c);
+        }
+    }
+
+    /// Recompute the level of @p c from its threshold and RMS estimate
+    void refreshLevel(const size_t c) {
+        const auto& t = thresholds[c];
+        int16_t level = 0;
+        if (t.mode == ThresholdMode::LEVEL) {
+            level = t.level;
+        } else if (t.mode == ThresholdMode::RMS && seen >= config.rms_window) {
+            const double v = std::clamp(std::round(t.rms_multiplier * std::sqrt(mean_square[c])), -32767.0, 32767.0);
+            level = static_cast<int16_t>(v);
+            if (level == 0) {
+                level = t.rms_multiplier < 0.0f ? int16_t{-1} : int16_t{1};
+            }
+        }
+        if (level != levels[c]) {
+            // The channel must come back inside the new level before it can cross it
+            prev[c] = static_cast<int16_t>(-1);
+        }
+        levels[c] = level;
+        lo[c] = level < 0 ? static_cast<int16_t>(level + 1) : SAMPLE_MIN;
+        hi[c] = level > 0 ? static_cast<int16_t>(level - 1) : SAMPLE_MAX;
+    }
+
+    /// Fold @p n rows starting at @p row into the running RMS
+    void updateRms(const int16_t* row, const size_t n) {
+        std::fill(acc.begin(), acc.end(), 0.0f);
+        for (size_t r = 0; r < n; ++r, row += padded) {
+            size_t c = 0;
+#ifdef CBUTIL_HAVE_SSE2
+            for (; c < padded; c += LANES) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + c));
+                const __m128 a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+                const __m128 b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+                _mm_storeu_ps(&acc[c], _mm_add_ps(_mm_loadu_ps(&acc[c]), _mm_mul_ps(a, a)));
+                _mm_storeu_ps(&acc[c + 4], _mm_add_ps(_mm_loadu_ps(&acc[c + 4]), _mm_mul_ps(b, b)));
+            }
+#endif
+            for (; c < padded; ++c) {
+                acc[c] += static_cast<float>(row[c]) * static_cast<float>(row[c]);
+            }
+        }
+        // Cumulative average until the window is full, exponential after
+        const bool warm = seen >= config.rms_window;
+        const double alpha = warm ? std::min(1.0, static_cast<double>(n) / config.rms_window)
+                                  : static_cast<double>(n) / static_cast<double>(seen + n);
+        for (size_t c = 0; c < channels; ++c) {
+            mean_square[c] += alpha * (acc[c] / static_cast<double>(n) - mean_square[c]);
+        }
+        seen += n;
+        for (size_t c = 0; c < channels; ++c) {
+            if (thresholds[c].mode == ThresholdMode::RMS) {
+                refreshLevel(c);
+            }
+        }
+    }
+
+    void trigger(const size_t c, const uint64_t row) {
+        if (c >= channels || row < next_allowed[c] || row < first + config.pretrigger) {
+            return;
+        }
+        next_allowed[c] = row + config.refractory_samples;
+        pending.push_back({static_cast<uint32_t>(c), row, levels[c]});
+    }
+
+    /// Find crossings in history rows [from, from + n)
+    void scan(const size_t from, const size_t n) {
+        for (size_t r = from; r < from + n; ++r) {
+            const int16_t* row = &history[r * padded];
+            const uint64_t abs_row = first + r;
+#ifdef CBUTIL_HAVE_SSE2
+            for (size_t c = 0; c < padded; c += LANES) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + c));
+                const __m128i beyond = _mm_or_si128(
+                    _mm_cmplt_epi16(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&lo[c]))),
+                    _mm_cmpgt_epi16(x, _mm_loadu_si128(reinterpret_cast<const __m128i*>(&hi[c]))));
+                auto* p = reinterpret_cast<__m128i*>(&prev[c]);
+                const __m128i crossed = _mm_andnot_si128(_mm_loadu_si128(p), beyond);
+                _mm_storeu_si128(p, beyond);
+                const int mask = _mm_movemask_epi8(crossed);
+                if (mask == 0) {
+                    continue;
+                }
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    if (mask & (1 << (2 * lane))) {
+                        trigger(c + lane, abs_row);
+                    }
+                }
+            }
+#else
+            for (size_t c = 0; c < channels; ++c) {
+                const int16_t beyond = (row[c] < lo[c] || row[c] > hi[c]) ? int16_t{-1} : int16_t{0};
+                if (beyond && !prev[c]) {
+                    trigger(c, abs_row);
+                }
+                prev[c] = beyond;
+            }
+#endif
+        }
+    }
+
+    /// Move the waveforms of pending spikes that are now complete into @p spikes
+    void emit(std::vector<DetectedSpike>& spikes) {
+        const uint64_t end = first + rows;
+        const uint32_t len = config.spike_length;
+        size_t ready = 0;
+        // Crossings are found in row order and all waveforms have the same length, so they
+        // complete in the order they were found
+        while (ready < pending.size() && pending[ready].trigger - config.pretrigger + len <= end) {
+            ++ready;
+        }
+        waves.resize(ready * len);
+        spikes.resize(ready);
+        for (size_t i = 0; i < ready; ++i) {
+            const auto& p = pending[i];
+            const size_t start = static_cast<size_t>(p.trigger - config.pretrigger - first);
+            int16_t* wave = &waves[i * len];
+            for (uint32_t k = 0; k < len; ++k) {
+                wave[k] = history[(start + k) * padded + p.column];
+            }
+            spikes[i] = {p.column, history_ts[static_cast<size_t>(p.trigger - first)], p.level, wave};
+        }
+        pending.erase(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(ready));
+    }
+
+    /// Drop rows no pending or future waveform reaches; only once there are as many stale
+    /// rows as live ones, so the shift is amortised
+    void compact() {
+        const uint64_t end = first + rows;
+        const uint64_t keep_from = pending.empty()
+            ? (end > config.pretrigger ? end - config.pretrigger : 0)
+            : pending.front().trigger - config.pretrigger;
+        if (keep_from <= first) {
+            return;
+        }
+        const auto stale = static_cast<size_t>(keep_from - first);
+        if (stale < rows - stale) {
+            return;
+        }
+        history.erase(history.begin(), history.begin() + static_cast<std::ptrdiff_t>(stale * padded));
+        history_ts.erase(history_ts.begin(), history_ts.begin() + static_cast<std::ptrdiff_t>(stale));
+        rows -= stale;
+        first = keep_from;
+    }
+};
+
+ThresholdSpikeDetector::ThresholdSpikeDetector() = default;
+ThresholdSpikeDetector::ThresholdSpikeDetector(ThresholdSpikeDetector&&) noexcept = default;
+ThresholdSpikeDetector& ThresholdSpikeDetector::operator=(ThresholdSpikeDetector&&) noexcept = default;
+ThresholdSpikeDetector::~ThresholdSpikeDetector() = default;
+
+cbutil::Result<ThresholdSpikeDetector> ThresholdSpikeDetector::create(const SpikeDetectorConfig& config,
+                                                                      const size_t channel_count,
+                                                                      const SpikeThreshold threshold) {
+    using R = cbutil::Result<ThresholdSpikeDetector>;
+    if (channel_count == 0) {
+        return R::error("Spike detection needs at least one channel");
+    }
+    if (config.spike_length == 0 || config.spike_length > cbMAX_PNTS) {
+        return R::error("Spike length must be 1-" + std::to_string(cbMAX_PNTS));
+    }
+    if (config.pretrigger >= config.spike_length) {
+        return R::error("Pretrigger must be shorter than the spike length");
+    }
+    if (config.rms_window == 0) {
+        return R::error("RMS window must be at least one sample");
+    }
+    if (auto ok = checkThreshold(threshold); ok.isError()) {
+        return R::error(ok.error());
+    }
+
+    auto impl = std::make_unique<Impl>();
+    impl->config = config;
+    impl->channels = channel_count;
+    impl->padded = (channel_count + LANES - 1) / LANES * LANES;
+    impl->thresholds.assign(channel_count, threshold);
+    impl->levels.assign(channel_count, 0);
+    impl->lo.assign(impl->padded, SAMPLE_MIN);
+    impl->hi.assign(impl->padded, SAMPLE_MAX);
+    impl->prev.assign(impl->padded, 0);
+    impl->mean_square.assign(channel_count, 0.0);
+    impl->acc.assign(impl->padded, 0.0f);
+    impl->next_allowed.assign(channel_count, 0);
+    impl->clear();
+
+    ThresholdSpikeDetector detector;
+    detector.m_impl = std::move(impl);
+    return R::ok(std::move(detector));
+}
+
+cbutil::Result<void> ThresholdSpikeDetector::setThreshold(const size_t column, const SpikeThreshold threshold) {
+    if (column >= m_impl->channels) {
+        return cbutil::Result<void>::error("Column " + std::to_string(column) + " is out of range");
+    }
+    if (auto ok = checkThreshold(threshold); ok.isError()) {
+        return ok;
+    }
+    m_impl->thresholds[column] = threshold;
+    m_impl->refreshLevel(column);
+    return cbutil::Result<void>::ok();
+}
+
+size_t ThresholdSpikeDetector::process(const int16_t* samples, const uint64_t* timestamps, const size_t n_samples,
+                                       std::vector<DetectedSpike>& spikes) {
+    auto& s = *m_impl;
+    spikes.clear();
+    if (n_samples == 0) {
+        return 0;
+    }
+    const size_t from = s.rows;
+    s.history.resize((s.rows + n_samples) * s.padded);
+    for (size_t r = 0; r < n_samples; ++r) {
+        int16_t* row = &s.history[(from + r) * s.padded];
+        std::memcpy(row, samples + r * s.channels, s.channels * sizeof(int16_t));
+        std::fill(row + s.channels, row + s.padded, int16_t{0});
+    }
+    s.history_ts.insert(s.history_ts.end(), timestamps, timestamps + n_samples);
+    s.rows += n_samples;
+
+    s.updateRms(&s.history[from * s.padded], n_samples);
+    s.scan(from, n_samples);
+    s.emit(spikes);
+    s.compact();
+    return spikes.size();
+}
+
+void ThresholdSpikeDetector::reset() {
+    m_impl->clear();
+}
+
+int16_t ThresholdSpikeDetector::level(const size_t column) const {
+    return column < m_impl->channels ? m_impl->levels[column] : int16_t{0};
+}
+
+double ThresholdSpikeDetector::rms(const size_t column) const {
+    return column < m_impl->channels ? std::sqrt(m_impl->mean_square[column]) : 0.0;
+}
+
+size_t ThresholdSpikeDetector::channelCount() const {
+    return m_impl->channels;
+}
+
+const SpikeDetectorConfig& ThresholdSpikeDetector::config() const {
+    return m_impl->config;
+}
+
+} // namespace cbsdk
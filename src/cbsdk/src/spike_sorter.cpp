@@ -0,0 +1,310 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   spike_sorter.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Online classification of spike waveforms with the device's sort models
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "cbsdk/spike_sorter.h"
+
+#include <cbproto/cbproto.h>
+#include <cbutil/simd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace cbsdk {
+
+namespace {
+
+/// A model prepared for classification
+struct PreparedModel {
+    std::vector<float> basis;           // planar [3][spike_length]
+    std::vector<SortUnit> units;
+    bool has_noise_boundary = false;
+    float noise_center[3] = {};
+    float noise_scaled[3][3] = {};      // axis / |axis|^2: inside iff the projections' squares sum to <= 1
+};
+
+#ifdef CBUTIL_HAVE_SSE2
+float horizontalSum(const __m128 v) {
+    const __m128 pairs = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, 1)));
+}
+#endif
+
+/// Project @p len samples of @p wave onto the three planar basis vectors of @p basis
+void project(const float* basis, const size_t len, const int16_t* wave, float* pattern) {
+    const float* b0 = basis;
+    const float* b1 = basis + len;
+    const float* b2 = basis + 2 * len;
+    size_t i = 0;
+    float p0 = 0.0f, p1 = 0.0f, p2 = 0.0f;
+#ifdef CBUTIL_HAVE_SSE2
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps();
+    for (; i + 8 <= len; i += 8) {
+        const __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(wave + i));
+        // Sign-extend the eight samples to two vectors of four int32, then convert
+        const __m128 lo = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(w, w), 16));
+        const __m128 hi = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(w, w), 16));
+        acc0 = _mm_add_ps(acc0, _mm_add_ps(_mm_mul_ps(lo, _mm_loadu_ps(b0 + i)), _mm_mul_ps(hi, _mm_loadu_ps(b0 + i + 4))));
+        acc1 = _mm_add_ps(acc1, _mm_add_ps(_mm_mul_ps(lo, _mm_loadu_ps(b1 + i)), _mm_mul_ps(hi, _mm_loadu_ps(b1 + i + 4))));
+        acc2 = _mm_add_ps(acc2, _mm_add_ps(_mm_mul_ps(lo, _mm_loadu_ps(b2 + i)), _mm_mul_ps(hi, _mm_loadu_ps(b2 + i + 4))));
+    }
+    p0 = horizontalSum(acc0);
+    p1 = horizontalSum(acc1);
+    p2 = horizontalSum(acc2);
+#endif
+    for (; i < len; ++i) {
+        const auto s = static_cast<float>(wave[i]);
+        p0 += s * b0[i];
+        p1 += s * b1[i];
+        p2 += s * b2[i];
+    }
+    pattern[0] = p0;
+    pattern[1] = p1;
+    pattern[2] = p2;
+}
+
+} // anonymous namespace
+
+struct SpikeSorter::Impl {
+    SpikeSorterConfig config;
+    std::vector<std::unique_ptr<PreparedModel>> models;     // index = channel ID
+    std::vector<SpikeSorterStats> shard_stats;              // one per shard; shard 0 is the caller
+
+    // Worker pool: shard w + 1 belongs to workers[w]
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable work_cv;
+    std::condition_variable done_cv;
+    uint64_t generation = 0;
+    size_t remaining = 0;
+    bool stopping = false;
+    SpikeToSort* job = nullptr;
+    size_t job_size = 0;
+
+    ~Impl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        work_cv.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void classify(SpikeToSort& spike, SpikeSorterStats& stats) const {
+        const PreparedModel* model = spike.chan_id < models.size() ? models[spike.chan_id].get() : nullptr;
+        if (!model || !spike.wave) {
+            spike.modelled = false;
+            ++stats.spikes_unmodelled;
+            return;
+        }
+        spike.modelled = true;
+        float* p = spike.pattern;
+        project(model->basis.data(), config.spike_length, spike.wave, p);
+
+        if (model->has_noise_boundary) {
+            const float d[3] = {p[0] - model->noise_center[0], p[1] - model->noise_center[1],
+                                p[2] - model->noise_center[2]};
+            float q = 0.0f;
+            for (const auto& axis : model->noise_scaled) {
+                const float t = d[0] * axis[0] + d[1] * axis[1] + d[2] * axis[2];
+                q += t * t;
+            }
+            if (q <= 1.0f) {
+                spike.unit = SORT_UNIT_NOISE;
+                ++stats.spikes_noise;
+                return;
+            }
+        }
+
+        float best = std::numeric_limits<float>::infinity();
+        uint32_t unit = 0;
+        for (const auto& u : model->units) {
+            const float dx = p[0] - u.mean[0];
+            const float dy = p[1] - u.mean[1];
+            const float d2 = dx * (u.inv_covariance[0][0] * dx + u.inv_covariance[0][1] * dy) +
+                             dy * (u.inv_covariance[1][0] * dx + u.inv_covariance[1][1] * dy);
+            if (d2 <= config.gate && d2 + u.log_determinant < best) {
+                best = d2 + u.log_determinant;
+                unit = u.unit;
+            }
+        }
+        spike.unit = unit;
+        if (unit == 0) {
+            ++stats.spikes_unsorted;
+        } else if (unit == SORT_UNIT_NOISE) {
+            ++stats.spikes_noise;
+        } else {
+            ++stats.spikes_sorted;
+        }
+    }
+
+    /// Classify the spikes of the channels of shard @p shard (of @p shards)
+    void classifyShard(SpikeToSort* spikes, const size_t n, const size_t shard, const size_t shards) {
+        auto& stats = shard_stats[shard];
+        for (size_t i = 0; i < n; ++i) {
+            if (spikes[i].chan_id % shards == shard) {
+                classify(spikes[i], stats);
+            }
+        }
+    }
+
+    void work(const size_t shard, const size_t shards) {
+        uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work_cv.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+            }
+            classifyShard(job, job_size, shard, shards);
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (--remaining == 0) {
+                    done_cv.notify_one();
+                }
+            }
+        }
+    }
+};
+
+SpikeSorter::SpikeSorter() = default;
+SpikeSorter::SpikeSorter(SpikeSorter&&) noexcept = default;
+SpikeSorter& SpikeSorter::operator=(SpikeSorter&&) noexcept = default;
+SpikeSorter::~SpikeSorter() = default;
+
+cbutil::Result<SpikeSorter> SpikeSorter::create(const SpikeSorterConfig& config) {
+    using R = cbutil::Result<SpikeSorter>;
+    if (config.spike_length == 0 || config.spike_length > cbMAX_PNTS) {
+        return R::error("Spike length must be between 1 and " + std::to_string(cbMAX_PNTS));
+    }
+    if (!(config.gate > 0.0f)) {
+        return R::error("Gate must be positive");
+    }
+    auto impl = std::make_unique<Impl>();
+    impl->config = config;
+    impl->shard_stats.resize(config.threads + 1);
+    Impl* p = impl.get();
+    impl->workers.reserve(config.threads);
+    for (size_t w = 0; w < config.threads; ++w) {
+        impl->workers.emplace_back([p, w, shards = config.threads + 1] { p->work(w + 1, shards); });
+    }
+
+    SpikeSorter sorter;
+    sorter.m_impl = std::move(impl);
+    return R::ok(std::move(sorter));
+}
+
+cbutil::Result<void> SpikeSorter::setModel(const uint32_t chan_id, const ChannelSortModel& model) {
+    using R = cbutil::Result<void>;
+    auto& s = *m_impl;
+    const size_t len = s.config.spike_length;
+    if (chan_id == 0) {
+        return R::error("Channel ID must be at least 1");
+    }
+    if (model.basis.size() < len * 3) {
+        return R::error("Basis must have a row per waveform sample");
+    }
+    if (std::all_of(model.basis.begin(), model.basis.begin() + static_cast<std::ptrdiff_t>(len * 3),
+                    [](const float v) { return v == 0.0f; })) {
+        return R::error("Basis is all zeros");
+    }
+    for (const auto& u : model.units) {
+        if ((u.unit == 0 || u.unit > cbMAXUNITS) && u.unit != SORT_UNIT_NOISE) {
+            return R::error("Unit numbers must be 1 to " + std::to_string(cbMAXUNITS) + " or noise");
+        }
+        const float det = u.inv_covariance[0][0] * u.inv_covariance[1][1] -
+                          u.inv_covariance[0][1] * u.inv_covariance[1][0];
+        if (!(u.inv_covariance[0][0] > 0.0f) || !(det > 0.0f)) {
+            return R::error("Unit covariance must be positive definite");
+        }
+    }
+
+    auto prepared = std::make_unique<PreparedModel>();
+    prepared->basis.resize(len * 3);
+    for (size_t i = 0; i < len; ++i) {
+        for (size_t k = 0; k < 3; ++k) {
+            prepared->basis[k * len + i] = model.basis[i * 3 + k];
+        }
+    }
+    prepared->units = model.units;
+    prepared->has_noise_boundary = model.has_noise_boundary;
+    if (model.has_noise_boundary) {
+        for (size_t k = 0; k < 3; ++k) {
+            const float* axis = model.noise_axes[k];
+            const float norm2 = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+            if (!(norm2 > 0.0f)) {
+                return R::error("Noise boundary axes must be non-zero");
+            }
+            prepared->noise_center[k] = model.noise_center[k];
+            for (size_t j = 0; j < 3; ++j) {
+                prepared->noise_scaled[k][j] = axis[j] / norm2;
+            }
+        }
+    }
+
+    if (chan_id >= s.models.size()) {
+        s.models.resize(chan_id + 1);
+    }
+    s.models[chan_id] = std::move(prepared);
+    return R::ok();
+}
+
+void SpikeSorter::clearModel(const uint32_t chan_id) {
+    if (chan_id < m_impl->models.size()) {
+        m_impl->models[chan_id].reset();
+    }
+}
+
+bool SpikeSorter::hasModel(const uint32_t chan_id) const {
+    return chan_id < m_impl->models.size() && m_impl->models[chan_id] != nullptr;
+}
+
+void SpikeSorter::sort(SpikeToSort* spikes, const size_t n_spikes) {
+    auto& s = *m_impl;
+    if (s.workers.empty() || n_spikes < s.config.min_parallel_spikes) {
+        s.classifyShard(spikes, n_spikes, 0, 1);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.job = spikes;
+        s.job_size = n_spikes;
+        s.remaining = s.workers.size();
+        ++s.generation;
+    }
+    s.work_cv.notify_all();
+    s.classifyShard(spikes, n_spikes, 0, s.workers.size() + 1);
+    std::unique_lock<std::mutex> lock(s.mutex);
+    s.done_cv.wait(lock, [&s] { return s.remaining == 0; });
+}
+
+const SpikeSorterConfig& SpikeSorter::config() const {
+    return m_impl->config;
+}
+
+SpikeSorterStats SpikeSorter::stats() const {
+    SpikeSorterStats total;
+    for (const auto& st : m_impl->shard_stats) {
+        total.spikes_sorted += st.spikes_sorted;
+        total.spikes_noise += st.spikes_noise;
+        total.spikes_unsorted += st.spikes_unsorted;
+        total.spikes_unmodelled += st.spikes_unmodelled;
+    }
+    return total;
+}
+
+} // namespace cbsdk
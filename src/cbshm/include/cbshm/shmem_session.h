@@ -160,6 +160,22 @@ public:
     /// @return cbPKT_CHANINFO structure on success
     Result<cbPKT_CHANINFO> getChanInfo(uint32_t channel) const;
 
+    /// @brief Get the spike sorting PCA basis of a channel
+    /// @param channel Channel number (0-based)
+    /// @return cbPKT_FS_BASIS structure on success (chan 0 if the device never sent one)
+    Result<cbPKT_FS_BASIS> getFeatureBasis(uint32_t channel) const;
+
+    /// @brief Get a spike sorting unit model of a channel
+    /// @param channel Channel number (0-based)
+    /// @param slot Unit slot (0 to cbMAXUNITS + 1; noise, unit 255, lives in cbMAXUNITS + 1)
+    /// @return cbPKT_SS_MODELSET structure on success
+    Result<cbPKT_SS_MODELSET> getSortModel(uint32_t channel, uint32_t slot) const;
+
+    /// @brief Get the spike sorting noise boundary of a channel
+    /// @param channel Channel number (0-based)
+    /// @return cbPKT_SS_NOISE_BOUNDARY structure on success
+    Result<cbPKT_SS_NOISE_BOUNDARY> getNoiseBoundary(uint32_t channel) const;
+
     /// @}
 
     ///////////////////////////////////////////////////////////////////////////
@@ -192,6 +208,25 @@ public:
     /// @return Result indicating success or failure
     Result<void> setChanInfo(uint32_t channel, const cbPKT_CHANINFO& info);
 
+    /// @brief Set the spike sorting PCA basis of a channel
+    /// @param channel Channel number (0-based)
+    /// @param basis cbPKT_FS_BASIS structure to write
+    /// @return Result indicating success or failure
+    Result<void> setFeatureBasis(uint32_t channel, const cbPKT_FS_BASIS& basis);
+
+    /// @brief Set a spike sorting unit model of a channel
+    /// @param channel Channel number (0-based)
+    /// @param slot Unit slot (0 to cbMAXUNITS + 1; noise, unit 255, lives in cbMAXUNITS + 1)
+    /// @param model cbPKT_SS_MODELSET structure to write
+    /// @return Result indicating success or failure
+    Result<void> setSortModel(uint32_t channel, uint32_t slot, const cbPKT_SS_MODELSET& model);
+
+    /// @brief Set the spike sorting noise boundary of a channel
+    /// @param channel Channel number (0-based)
+    /// @param boundary cbPKT_SS_NOISE_BOUNDARY structure to write
+    /// @return Result indicating success or failure
+    Result<void> setNoiseBoundary(uint32_t channel, const cbPKT_SS_NOISE_BOUNDARY& boundary);
+
     /// @brief Set system information (sysfreq, spike length, etc.)
     /// @param info cbPKT_SYSINFO structure to write
     /// @return Result indicating success or failure
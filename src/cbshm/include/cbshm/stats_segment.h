@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   stats_segment.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Published session statistics in a small shared memory segment
+///
+/// A STANDALONE session owns the device and is the only process that knows whether the
+/// receiver keeps up.  It publishes its counters, callback queue depth, per-thread CPU time
+/// and last-datagram time into "cbshm_{device}_stats" next to the native config segment.
+/// Any process (a CLIENT session, the cbstat tool) can map it read-only and poll it.
+///
+/// The segment is a flat array of 64-bit words written with relaxed stores by a single
+/// publisher thread, so readers never block the owner and see each field untorn.  Fields
+/// are not published as one atomic snapshot; consecutive counters can be one update apart.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSHM_STATS_SEGMENT_H
+#define CBSHM_STATS_SEGMENT_H
+
+#include <cbutil/result.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cbshm {
+
+/// "CBST" - identifies a stats segment
+constexpr uint32_t NATIVE_STATS_MAGIC = 0x54534243;
+
+/// Bumped whenever NativeStatsBuffer changes layout
+constexpr uint32_t NATIVE_STATS_VERSION = 1;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Layout of the stats segment
+///
+/// Times are std::chrono::steady_clock nanoseconds, which every process on the host shares
+/// (the same convention as NativeConfigBuffer::clock_offset_ns).
+///
+struct NativeStatsBuffer {
+    uint32_t magic;                             ///< NATIVE_STATS_MAGIC
+    uint32_t version;                           ///< NATIVE_STATS_VERSION
+    uint32_t owner_pid;                         ///< PID of the publishing STANDALONE process
+    uint32_t reserved;
+
+    uint64_t publish_count;                     ///< Number of publishes so far (heartbeat)
+    int64_t  publish_steady_ns;                 ///< Time of the last publish
+    int64_t  last_datagram_steady_ns;           ///< Time the last datagram arrived (0 = none yet)
+
+    // Counters (same meaning as cbsdk::SdkStats)
+    uint64_t packets_received_from_device;
+    uint64_t bytes_received_from_device;
+    uint64_t packets_stored_to_shmem;
+    uint64_t packets_queued_for_callback;
+    uint64_t packets_delivered_to_callback;
+    uint64_t packets_dropped;
+    uint64_t queue_current_depth;
+    uint64_t queue_max_depth;
+    uint64_t queue_capacity;                    ///< Capacity of the callback queue
+    uint64_t packets_sent_to_device;
+    uint64_t shmem_store_errors;
+    uint64_t receive_errors;
+    uint64_t send_errors;
+
+    // CPU time consumed by each session thread so far
+    uint64_t receive_thread_cpu_ns;
+    uint64_t callback_thread_cpu_ns;
+    uint64_t send_thread_cpu_ns;
+};
+
+static_assert(sizeof(NativeStatsBuffer) % sizeof(uint64_t) == 0,
+              "NativeStatsBuffer is published word by word");
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Owner or read-only view of a stats segment
+///
+class StatsSegment {
+public:
+    /// @brief Create the segment (STANDALONE owner); it is removed again on destruction
+    /// @param name Segment name (e.g., "cbshm_hub1_stats")
+    static cbutil::Result<StatsSegment> create(const std::string& name);
+
+    /// @brief Map an existing segment read-only
+    /// @param name Segment name
+    /// @return Error if the segment does not exist or is not a compatible stats segment
+    static cbutil::Result<StatsSegment> open(const std::string& name);
+
+    ~StatsSegment();
+    StatsSegment(StatsSegment&& other) noexcept;
+    StatsSegment& operator=(StatsSegment&& other) noexcept;
+    StatsSegment(const StatsSegment&) = delete;
+    StatsSegment& operator=(const StatsSegment&) = delete;
+
+    /// @brief Publish new values (owner only; one publishing thread at a time)
+    ///
+    /// Copies everything after the header with relaxed stores and bumps publish_count.
+    /// The header fields and publish_count of @p values are ignored.
+    void publish(const NativeStatsBuffer& values);
+
+    /// @brief Read the current values with relaxed loads
+    NativeStatsBuffer read() const;
+
+    /// @brief Check whether the publishing process still exists
+    /// @return false only if the owner is confirmed dead
+    bool isOwnerAlive() const;
+
+private:
+    StatsSegment();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+/// @brief CPU time consumed by the calling thread so far
+/// @return Nanoseconds of user + system time (0 if the platform cannot report it)
+uint64_t currentThreadCpuNs();
+
+} // namespace cbshm
+
+#endif // CBSHM_STATS_SEGMENT_H
@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   tick_converter.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Precomputed fixed-point conversion between device clock ticks and nanoseconds
+///
+/// Non-Gemini NSPs stamp packets in sysfreq clock ticks (30 kHz) while the rest of
+/// CereLink works in nanoseconds.  The conversion is floor(t * num / den) with
+/// num/den = 1e9/sysfreq reduced by their gcd.  Rather than re-deriving the ratio and
+/// issuing a hardware 64-bit divide per packet, TickConverter precomputes a multiply-high
+/// reciprocal for den once and reproduces the exact integer result of t * num / den.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSHM_TICK_CONVERTER_H
+#define CBSHM_TICK_CONVERTER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>  // std::gcd
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace cbshm {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Exact unsigned 64-bit division by a run-time constant
+///
+/// Uses the Granlund–Montgomery round-down reciprocal: for a divisor d > 1 with
+/// l = ceil(log2 d) and m = floor(2^64 * (2^l - d) / d) + 1,
+///   n / d == (((n - mulhi(m, n)) >> 1) + mulhi(m, n)) >> (l - 1)
+/// for every 64-bit n.  Divisors are limited to 32 bits (sysfreq and 1e9 both fit).
+///
+class ConstDivider {
+public:
+    ConstDivider() = default;
+
+    /// @param d Divisor (1 to 2^32 - 1; 0 is treated as 1)
+    explicit ConstDivider(uint32_t d) : m_d(d == 0 ? 1 : d) {
+        if (m_d == 1) {
+            return;
+        }
+        uint32_t l = 0;
+        while ((uint64_t(1) << l) < m_d) {
+            ++l;
+        }
+        // m = floor(2^64 * (2^l - d) / d) + 1, by 64 steps of binary long division.
+        // The remainder stays below d < 2^32, so no step overflows.
+        uint64_t rem = (uint64_t(1) << l) - m_d;
+        uint64_t q = 0;
+        for (int bit = 0; bit < 64; ++bit) {
+            rem <<= 1;
+            q <<= 1;
+            if (rem >= m_d) {
+                rem -= m_d;
+                q |= 1;
+            }
+        }
+        m_magic = q + 1;
+        m_shift = l - 1;
+    }
+
+    /// @brief Divisor this instance was built for
+    uint32_t divisor() const { return m_d; }
+
+    /// @brief Compute n / d (identical to the hardware divide for every n)
+    uint64_t divide(uint64_t n) const {
+        if (m_d == 1) {
+            return n;
+        }
+        const uint64_t hi = mulhi(m_magic, n);
+        return (((n - hi) >> 1) + hi) >> m_shift;
+    }
+
+    /// @brief High 64 bits of the 128-bit product a * b
+    static uint64_t mulhi(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return __umulh(a, b);
+#else
+        const uint64_t a_lo = a & 0xFFFFFFFFu, a_hi = a >> 32;
+        const uint64_t b_lo = b & 0xFFFFFFFFu, b_hi = b >> 32;
+        const uint64_t lo_lo = a_lo * b_lo;
+        const uint64_t hi_lo = a_hi * b_lo;
+        const uint64_t lo_hi = a_lo * b_hi;
+        const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+        return a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+    }
+
+private:
+    uint64_t m_magic = 0;
+    uint32_t m_shift = 0;
+    uint32_t m_d = 1;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Cached tick <-> nanosecond conversion for one sysfreq
+///
+/// Results are bit-identical to the historical expressions
+///   ticks → ns: t * (1e9/g) / (sysfreq/g)
+///   ns → ticks: t * (sysfreq/g) / (1e9/g)
+/// whenever the intermediate product does not overflow 64 bits (i.e. for any
+/// timestamp below ~190 years of uptime), and remain exact beyond that.
+///
+class TickConverter {
+public:
+    static constexpr uint64_t NS_PER_SEC = 1000000000;
+
+    /// @brief Identity converter (nanosecond timestamps)
+    TickConverter() = default;
+
+    /// @param sysfreq Device clock frequency in Hz (0 falls back to 30000)
+    explicit TickConverter(uint32_t sysfreq) {
+        if (sysfreq == 0) sysfreq = 30000;
+        const uint64_t g = std::gcd(NS_PER_SEC, uint64_t(sysfreq));
+        m_sysfreq = sysfreq;
+        m_ns_num = static_cast<uint32_t>(NS_PER_SEC / g);
+        m_tick_num = static_cast<uint32_t>(sysfreq / g);
+        m_div_ticks = ConstDivider(m_tick_num);   // ticks → ns divides by sysfreq/g
+        m_div_ns = ConstDivider(m_ns_num);        // ns → ticks divides by 1e9/g
+    }
+
+    /// @brief Clock frequency this converter was built for (0 for the identity converter)
+    uint32_t sysfreq() const { return m_sysfreq; }
+
+    /// @brief Reduced numerator of the ticks → ns ratio (1e9 / g)
+    uint64_t nsPerTickNum() const { return m_ns_num; }
+
+    /// @brief Reduced denominator of the ticks → ns ratio (sysfreq / g)
+    uint64_t nsPerTickDen() const { return m_tick_num; }
+
+    /// @brief Convert device clock ticks to nanoseconds
+    uint64_t ticksToNs(uint64_t ticks) const {
+        return scale(ticks, m_ns_num, m_div_ticks);
+    }
+
+    /// @brief Convert nanoseconds to device clock ticks
+    uint64_t nsToTicks(uint64_t ns) const {
+        return scale(ns, m_tick_num, m_div_ns);
+    }
+
+    /// @brief Convert a strided run of tick timestamps to nanoseconds in place
+    ///
+    /// Designed for the header time field of consecutive packets
+    /// (stride = sizeof(cbPKT_GENERIC)), so a whole readReceiveBuffer() batch is
+    /// converted with one hoisted divisor check and no per-packet setup.  Timestamps
+    /// are accessed with memcpy, so packed (unaligned) header fields are fine.
+    /// @param first  Pointer to the first timestamp
+    /// @param stride Distance in bytes between consecutive timestamps
+    /// @param count  Number of timestamps to convert
+    void ticksToNsBatch(void* first, size_t stride, size_t count) const {
+        auto* p = static_cast<unsigned char*>(first);
+        uint64_t t;
+        if (m_div_ticks.divisor() == 1) {
+            for (size_t i = 0; i < count; ++i, p += stride) {
+                std::memcpy(&t, p, sizeof(t));
+                t *= m_ns_num;
+                std::memcpy(p, &t, sizeof(t));
+            }
+            return;
+        }
+        for (size_t i = 0; i < count; ++i, p += stride) {
+            std::memcpy(&t, p, sizeof(t));
+            t = scale(t, m_ns_num, m_div_ticks);
+            std::memcpy(p, &t, sizeof(t));
+        }
+    }
+
+private:
+    /// floor(t * num / d) without a 128-bit intermediate:
+    ///   t = q*d + r  ⇒  t*num/d = q*num + (r*num)/d,  with r*num < d*num < 2^64
+    static uint64_t scale(uint64_t t, uint64_t num, const ConstDivider& div) {
+        const uint64_t q = div.divide(t);
+        const uint64_t r = t - q * div.divisor();
+        return q * num + div.divide(r * num);
+    }
+
+    uint32_t m_sysfreq = 0;
+    uint32_t m_ns_num = 1;
+    uint32_t m_tick_num = 1;
+    ConstDivider m_div_ticks;
+    ConstDivider m_div_ns;
+};
+
+} // namespace cbshm
+
+#endif // CBSHM_TICK_CONVERTER_H
@@ -28,10 +28,14 @@
 #include <cbshm/shmem_session.h>
 #include <cbshm/central_types.h>
 #include <cbshm/native_types.h>
+#include <cbshm/tick_converter.h>
 #include <cbproto/packet_translator.h>
 #include <atomic>
+#include <cstddef>
 #include <cstring>
-#include <numeric>  // std::gcd
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace cbshm {
 
@@ -144,6 +148,22 @@ struct ShmemSession::Impl {
     // Detected protocol version for CENTRAL_COMPAT mode
     cbproto_protocol_version_t compat_protocol;
 
+    // CENTRAL_COMPAT timestamp conversion, cached per Gemini flag and sysfreq.
+    // Non-Gemini devices stamp in clock ticks.
+    struct TickConversion {
+        bool ts_in_ticks = false;
+        uint32_t sysfreq = 0;  // as read from sysinfo (the converter maps 0 to 30 kHz)
+        TickConverter converter;
+    };
+    // The receive-buffer reader, enqueuePacket() and getLastTime() convert on
+    // different threads, so each change publishes a new immutable snapshot.
+    // Snapshots are kept until the session is destroyed (one per distinct Gemini
+    // flag / sysfreq seen), so a reader holding an old one never sees it freed or
+    // half-written.
+    std::atomic<const TickConversion*> tick_conversion;
+    std::mutex tick_conversion_mutex;
+    std::vector<std::unique_ptr<const TickConversion>> tick_conversions;
+
     // Typed accessors for config buffer
     CentralConfigBuffer* centralCfg() { return static_cast<CentralConfigBuffer*>(cfg_buffer_raw); }
     const CentralConfigBuffer* centralCfg() const { return static_cast<const CentralConfigBuffer*>(cfg_buffer_raw); }
@@ -221,7 +241,11 @@ struct ShmemSession::Impl {
         , rec_tailwrap(0)
         , instrument_filter(-1)
         , compat_protocol(CBPROTO_PROTOCOL_CURRENT)
-    {}
+        , tick_conversion(nullptr)
+    {
+        tick_conversions.push_back(std::make_unique<const TickConversion>());
+        tick_conversion.store(tick_conversions.back().get(), std::memory_order_release);
+    }
 
     ~Impl() {
         close();
@@ -607,6 +631,7 @@ struct ShmemSession::Impl {
 
         // Detect protocol version for CENTRAL_COMPAT mode
         detectCompatProtocol();
+        tickConversion(true);
 
         return Result<void>::ok();
     }
@@ -808,6 +833,39 @@ struct ShmemSession::Impl {
             compat_protocol = CBPROTO_PROTOCOL_CURRENT;
         }
     }
+
+    /// @brief The tick<->ns conversion for the live Gemini flag
+    ///
+    /// Only CENTRAL_COMPAT carries device-native (tick) timestamps; every other
+    /// layout already stores nanoseconds and keeps the identity converter.  Central
+    /// may flip the Gemini flag at any time, so it is re-read on every call.  sysfreq
+    /// is re-read only when @p reread_sysfreq is set: Central updates sysinfo before
+    /// forwarding the SYSREP that announces a new clock, and packets ahead of that
+    /// SYSREP are still stamped at the old one.
+    const TickConversion& tickConversion(bool reread_sysfreq = false) {
+        const TickConversion* current = tick_conversion.load(std::memory_order_acquire);
+        if (layout != ShmemLayout::CENTRAL_COMPAT || !status_buffer_raw || !cfg_buffer_raw) {
+            return *current;
+        }
+        TickConversion next;
+        next.ts_in_ticks = static_cast<const CentralPCStatus*>(status_buffer_raw)->m_nGeminiSystem == 0;
+        next.sysfreq = reread_sysfreq ? legacyCfg()->sysinfo.sysfreq : current->sysfreq;
+        if (next.ts_in_ticks == current->ts_in_ticks && next.sysfreq == current->sysfreq) {
+            return *current;
+        }
+        next.converter = TickConverter(next.sysfreq);
+
+        std::lock_guard<std::mutex> lock(tick_conversion_mutex);
+        for (const auto& known : tick_conversions) {
+            if (known->ts_in_ticks == next.ts_in_ticks && known->sysfreq == next.sysfreq) {
+                tick_conversion.store(known.get(), std::memory_order_release);
+                return *known;
+            }
+        }
+        tick_conversions.push_back(std::make_unique<const TickConversion>(next));
+        tick_conversion.store(tick_conversions.back().get(), std::memory_order_release);
+        return *tick_conversions.back();
+    }
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1037,6 +1095,69 @@ Result<cbPKT_CHANINFO> ShmemSession::getChanInfo(uint32_t channel) const {
     }
 }
 
+Result<cbPKT_FS_BASIS> ShmemSession::getFeatureBasis(uint32_t channel) const {
+    if (!isOpen()) {
+        return Result<cbPKT_FS_BASIS>::error("Session not open");
+    }
+
+    uint32_t max_chans = (m_impl->layout == ShmemLayout::NATIVE) ? NATIVE_MAXCHANS : CENTRAL_cbMAXCHANS;
+
+    if (channel >= max_chans) {
+        return Result<cbPKT_FS_BASIS>::error("Channel index out of range");
+    }
+
+    if (m_impl->layout == ShmemLayout::NATIVE) {
+        return Result<cbPKT_FS_BASIS>::ok(m_impl->nativeCfg()->asBasis[channel]);
+    } else if (m_impl->layout == ShmemLayout::CENTRAL_COMPAT) {
+        return Result<cbPKT_FS_BASIS>::ok(m_impl->legacyCfg()->isSortingOptions.asBasis[channel]);
+    } else {
+        return Result<cbPKT_FS_BASIS>::ok(m_impl->centralCfg()->isSortingOptions.asBasis[channel]);
+    }
+}
+
+Result<cbPKT_SS_MODELSET> ShmemSession::getSortModel(uint32_t channel, uint32_t slot) const {
+    if (!isOpen()) {
+        return Result<cbPKT_SS_MODELSET>::error("Session not open");
+    }
+
+    uint32_t max_chans = (m_impl->layout == ShmemLayout::NATIVE) ? NATIVE_MAXCHANS : CENTRAL_cbMAXCHANS;
+
+    if (channel >= max_chans) {
+        return Result<cbPKT_SS_MODELSET>::error("Channel index out of range");
+    }
+    if (slot >= cbMAXUNITS + 2) {
+        return Result<cbPKT_SS_MODELSET>::error("Unit slot out of range");
+    }
+
+    if (m_impl->layout == ShmemLayout::NATIVE) {
+        return Result<cbPKT_SS_MODELSET>::ok(m_impl->nativeCfg()->asSortModel[channel][slot]);
+    } else if (m_impl->layout == ShmemLayout::CENTRAL_COMPAT) {
+        return Result<cbPKT_SS_MODELSET>::ok(m_impl->legacyCfg()->isSortingOptions.asSortModel[channel][slot]);
+    } else {
+        return Result<cbPKT_SS_MODELSET>::ok(m_impl->centralCfg()->isSortingOptions.asSortModel[channel][slot]);
+    }
+}
+
+Result<cbPKT_SS_NOISE_BOUNDARY> ShmemSession::getNoiseBoundary(uint32_t channel) const {
+    if (!isOpen()) {
+        return Result<cbPKT_SS_NOISE_BOUNDARY>::error("Session not open");
+    }
+
+    uint32_t max_chans = (m_impl->layout == ShmemLayout::NATIVE) ? NATIVE_MAXCHANS : CENTRAL_cbMAXCHANS;
+
+    if (channel >= max_chans) {
+        return Result<cbPKT_SS_NOISE_BOUNDARY>::error("Channel index out of range");
+    }
+
+    if (m_impl->layout == ShmemLayout::NATIVE) {
+        return Result<cbPKT_SS_NOISE_BOUNDARY>::ok(m_impl->nativeCfg()->pktNoiseBoundary[channel]);
+    } else if (m_impl->layout == ShmemLayout::CENTRAL_COMPAT) {
+        return Result<cbPKT_SS_NOISE_BOUNDARY>::ok(m_impl->legacyCfg()->isSortingOptions.pktNoiseBoundary[channel]);
+    } else {
+        return Result<cbPKT_SS_NOISE_BOUNDARY>::ok(m_impl->centralCfg()->isSortingOptions.pktNoiseBoundary[channel]);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Configuration Write Operations
 
@@ -1147,6 +1268,75 @@ Result<void> ShmemSession::setChanInfo(uint32_t channel, const cbPKT_CHANINFO& i
     return Result<void>::ok();
 }
 
+Result<void> ShmemSession::setFeatureBasis(uint32_t channel, const cbPKT_FS_BASIS& basis) {
+    if (!isOpen()) {
+        return Result<void>::error("Session not open");
+    }
+
+    uint32_t max_chans = (m_impl->layout == ShmemLayout::NATIVE) ? NATIVE_MAXCHANS : CENTRAL_cbMAXCHANS;
+
+    if (channel >= max_chans) {
+        return Result<void>::error("Channel index out of range");
+    }
+
+    if (m_impl->layout == ShmemLayout::NATIVE) {
+        m_impl->nativeCfg()->asBasis[channel] = basis;
+    } else if (m_impl->layout == ShmemLayout::CENTRAL_COMPAT) {
+        m_impl->legacyCfg()->isSortingOptions.asBasis[channel] = basis;
+    } else {
+        m_impl->centralCfg()->isSortingOptions.asBasis[channel] = basis;
+    }
+
+    return Result<void>::ok();
+}
+
+Result<void> ShmemSession::setSortModel(uint32_t channel, uint32_t slot, const cbPKT_SS_MODELSET& model) {
+    if (!isOpen()) {
+        return Result<void>::error("Session not open");
+    }
+
+    uint32_t max_chans = (m_impl->layout == ShmemLayout::NATIVE) ? NATIVE_MAXCHANS : CENTRAL_cbMAXCHANS;
+
+    if (channel >= max_chans) {
+        return Result<void>::error("Channel index out of range");
+    }
+    if (slot >= cbMAXUNITS + 2) {
+        return Result<void>::error("Unit slot out of range");
+    }
+
+    if (m_impl->layout == ShmemLayout::NATIVE) {
+        m_impl->nativeCfg()->asSortModel[channel][slot] = model;
+    } else if (m_impl->layout == ShmemLayout::CENTRAL_COMPAT) {
+        m_impl->legacyCfg()->isSortingOptions.asSortModel[channel][slot] = model;
+    } else {
+        m_impl->centralCfg()->isSortingOptions.asSortModel[channel][slot] = model;
+    }
+
+    return Result<void>::ok();
+}
+
+Result<void> ShmemSession::setNoiseBoundary(uint32_t channel, const cbPKT_SS_NOISE_BOUNDARY& boundary) {
+    if (!isOpen()) {
+        return Result<void>::error("Session not open");
+    }
+
+    uint32_t max_chans = (m_impl->layout == ShmemLayout::NATIVE) ? NATIVE_MAXCHANS : CENTRAL_cbMAXCHANS;
+
+    if (channel >= max_chans) {
+        return Result<void>::error("Channel index out of range");
+    }
+
+    if (m_impl->layout == ShmemLayout::NATIVE) {
+        m_impl->nativeCfg()->pktNoiseBoundary[channel] = boundary;
+    } else if (m_impl->layout == ShmemLayout::CENTRAL_COMPAT) {
+        m_impl->legacyCfg()->isSortingOptions.pktNoiseBoundary[channel] = boundary;
+    } else {
+        m_impl->centralCfg()->isSortingOptions.pktNoiseBoundary[channel] = boundary;
+    }
+
+    return Result<void>::ok();
+}
+
 Result<void> ShmemSession::setSysInfo(const cbPKT_SYSINFO& info) {
     if (!isOpen()) {
         return Result<void>::error("Session not open");
@@ -1290,6 +1480,7 @@ Result<void> ShmemSession::enqueuePacket(const cbPKT_GENERIC& pkt) {
     // In CENTRAL_COMPAT mode with an older protocol, translate to the legacy format
     const bool needs_translation = (m_impl->layout == ShmemLayout::CENTRAL_COMPAT &&
                                      m_impl->compat_protocol != CBPROTO_PROTOCOL_CURRENT);
+    const auto& ticks = m_impl->tickConversion();
 
     const uint8_t* write_data;
     uint32_t write_size_bytes;
@@ -1314,12 +1505,8 @@ Result<void> ShmemSession::enqueuePacket(const cbPKT_GENERIC& pkt) {
             dest_hdr.time = pkt.cbpkt_header.time;
             // Non-Gemini: convert nanosecond timestamp back to device clock ticks.
             // Central's xmt consumer expects device-native format.
-            auto gemini = isGeminiSystem();
-            if (gemini.isOk() && !gemini.value() && dest_hdr.time != 0) {
-                uint32_t sysfreq = m_impl->legacyCfg()->sysinfo.sysfreq;
-                if (sysfreq == 0) sysfreq = 30000;
-                uint64_t g = std::gcd(uint64_t(1000000000), uint64_t(sysfreq));
-                dest_hdr.time = dest_hdr.time * (sysfreq / g) / (1000000000 / g);
+            if (ticks.ts_in_ticks && dest_hdr.time != 0) {
+                dest_hdr.time = ticks.converter.nsToTicks(dest_hdr.time);
             }
             dest_hdr.chid = pkt.cbpkt_header.chid;
             dest_hdr.type = static_cast<uint8_t>(pkt.cbpkt_header.type);
@@ -1337,27 +1524,19 @@ Result<void> ShmemSession::enqueuePacket(const cbPKT_GENERIC& pkt) {
             auto& dest_hdr = *reinterpret_cast<cbPKT_HEADER*>(translated_buf);
             dest_hdr.dlen = static_cast<uint16_t>(dest_dlen);
             // Non-Gemini: convert nanosecond timestamp back to device clock ticks.
-            auto gemini = isGeminiSystem();
-            if (gemini.isOk() && !gemini.value() && dest_hdr.time != 0) {
-                uint32_t sysfreq = m_impl->legacyCfg()->sysinfo.sysfreq;
-                if (sysfreq == 0) sysfreq = 30000;
-                uint64_t g = std::gcd(uint64_t(1000000000), uint64_t(sysfreq));
-                dest_hdr.time = dest_hdr.time * (sysfreq / g) / (1000000000 / g);
+            if (ticks.ts_in_ticks && dest_hdr.time != 0) {
+                dest_hdr.time = ticks.converter.nsToTicks(dest_hdr.time);
             }
             write_size_bytes = cbPKT_HEADER_SIZE + dest_dlen * 4;
         }
         write_data = translated_buf;
     } else if (m_impl->layout == ShmemLayout::CENTRAL_COMPAT && m_impl->status_buffer_raw) {
         // Protocol is CURRENT but device may be non-Gemini — still need ns→ticks conversion.
-        auto gemini = isGeminiSystem();
-        if (gemini.isOk() && !gemini.value() && pkt.cbpkt_header.time != 0) {
+        if (ticks.ts_in_ticks && pkt.cbpkt_header.time != 0) {
             std::memcpy(translated_buf, &pkt,
                         (cbPKT_HEADER_32SIZE + pkt.cbpkt_header.dlen) * sizeof(uint32_t));
             auto& dest_hdr = *reinterpret_cast<cbPKT_HEADER*>(translated_buf);
-            uint32_t sysfreq = m_impl->legacyCfg()->sysinfo.sysfreq;
-            if (sysfreq == 0) sysfreq = 30000;
-            uint64_t g = std::gcd(uint64_t(1000000000), uint64_t(sysfreq));
-            dest_hdr.time = dest_hdr.time * (sysfreq / g) / (1000000000 / g);
+            dest_hdr.time = ticks.converter.nsToTicks(dest_hdr.time);
             write_data = translated_buf;
         } else {
             write_data = reinterpret_cast<const uint8_t*>(&pkt);
@@ -1698,6 +1877,7 @@ Result<void> ShmemSession::setGeminiSystem(bool is_gemini) {
     } else {
         static_cast<CentralPCStatus*>(m_impl->status_buffer_raw)->m_nGeminiSystem = is_gemini ? 1 : 0;
     }
+    m_impl->tickConversion(true);
 
     return Result<void>::ok();
 }
@@ -1893,14 +2073,9 @@ PROCTIME ShmemSession::getLastTime() const {
     // In CENTRAL_COMPAT mode, Central writes lasttime using the device's native
     // timestamp unit.  Non-Gemini devices use clock ticks; convert to nanoseconds
     // for consistency with readReceiveBuffer() which translates packet timestamps.
-    if (t != 0 && m_impl->layout == ShmemLayout::CENTRAL_COMPAT) {
-        auto gemini = isGeminiSystem();
-        if (gemini.isOk() && !gemini.value()) {
-            uint32_t sysfreq = m_impl->legacyCfg()->sysinfo.sysfreq;
-            if (sysfreq == 0) sysfreq = 30000;
-            uint64_t g = std::gcd(uint64_t(1000000000), uint64_t(sysfreq));
-            t = t * (1000000000 / g) / (sysfreq / g);
-        }
+    const auto& ticks = m_impl->tickConversion();
+    if (t != 0 && ticks.ts_in_ticks) {
+        t = ticks.converter.ticksToNs(t);
     }
     return t;
 }
@@ -1956,21 +2131,19 @@ Result<void> ShmemSession::readReceiveBuffer(cbPKT_GENERIC* packets, size_t max_
     // conversion to nanoseconds.  This applies regardless of protocol version —
     // a non-Gemini device with protocol 4.2+ still uses tick-based timestamps.
     // (Protocol 3.11 handles conversion inline with its hardcoded 30 kHz factor.)
-    uint64_t ts_num = 1, ts_den = 1;
-    bool needs_ts_conversion = false;
-    if (m_impl->layout == ShmemLayout::CENTRAL_COMPAT &&
-        m_impl->compat_protocol != CBPROTO_PROTOCOL_311 &&
-        m_impl->status_buffer_raw) {
-        auto gemini = isGeminiSystem();
-        if (gemini.isOk() && !gemini.value()) {
-            uint32_t sysfreq = m_impl->legacyCfg()->sysinfo.sysfreq;
-            if (sysfreq == 0) sysfreq = 30000;
-            uint64_t g = std::gcd(uint64_t(1000000000), uint64_t(sysfreq));
-            ts_num = 1000000000 / g;
-            ts_den = sysfreq / g;
-            needs_ts_conversion = (ts_den > 1);
+    // The converter is cached (see tickConversion) and applied once per run of
+    // packets: a SYSREP ends the run stamped at the old sysfreq.
+    const auto convertTicks = [this, packets](const Impl::TickConversion& ticks, size_t from, size_t to) {
+        if (to > from && ticks.ts_in_ticks && m_impl->compat_protocol != CBPROTO_PROTOCOL_311 &&
+            ticks.converter.nsPerTickDen() > 1) {
+            ticks.converter.ticksToNsBatch(
+                reinterpret_cast<uint8_t*>(packets + from) + offsetof(cbPKT_HEADER, time),
+                sizeof(cbPKT_GENERIC), to - from);
         }
-    }
+    };
+    const Impl::TickConversion* ticks = &m_impl->tickConversion();
+    size_t converted = 0;
+    Result<void> status = Result<void>::ok();
 
     uint8_t raw_buf[cbPKT_MAX_SIZE];
 
@@ -1983,7 +2156,8 @@ Result<void> ShmemSession::readReceiveBuffer(cbPKT_GENERIC* packets, size_t max_
             (m_impl->rec_tailwrap + 1 < head_wrap)) {
             m_impl->rec_tailindex = head_index;
             m_impl->rec_tailwrap = head_wrap;
-            return Result<void>::error("Receive buffer overrun - data lost");
+            status = Result<void>::error("Receive buffer overrun - data lost");
+            break;
         }
 
         // Parse the packet header to determine packet size based on protocol version.
@@ -2101,11 +2275,14 @@ Result<void> ShmemSession::readReceiveBuffer(cbPKT_GENERIC* packets, size_t max_
             }
         }
 
-        // Non-Gemini CENTRAL_COMPAT: convert header timestamp from clock ticks to nanoseconds.
-        // Applied after both translation and non-translation paths.
-        if (needs_ts_conversion) {
-            packets[packets_read].cbpkt_header.time =
-                packets[packets_read].cbpkt_header.time * ts_num / ts_den;
+        // Central updates sysinfo before forwarding SYSREP; the packets read so far
+        // keep the old sysfreq, the SYSREP and those after it take the new one.
+        const auto& read_hdr = packets[packets_read].cbpkt_header;
+        if (m_impl->layout == ShmemLayout::CENTRAL_COMPAT && (read_hdr.chid & cbPKTCHAN_CONFIGURATION) &&
+            (read_hdr.type & 0xF0) == cbPKTTYPE_SYSREP) {
+            convertTicks(*ticks, converted, packets_read);
+            converted = packets_read;
+            ticks = &m_impl->tickConversion(true);
         }
 
         // Advance tail past this packet (consumed from ring buffer regardless of filter)
@@ -2126,7 +2303,11 @@ Result<void> ShmemSession::readReceiveBuffer(cbPKT_GENERIC* packets, size_t max_
         packets_read++;
     }
 
-    return Result<void>::ok();
+    // Non-Gemini CENTRAL_COMPAT: convert header timestamps from clock ticks to nanoseconds.
+    // Applied after both translation and non-translation paths.
+    convertTicks(*ticks, converted, packets_read);
+
+    return status;
 }
 
 Result<void> ShmemSession::getReceiveBufferStats(uint32_t& received, uint32_t& available) const {
@@ -0,0 +1,272 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   stats_segment.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Published session statistics segment (Windows file mapping / POSIX shm)
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Platform headers MUST be included first
+#include "platform_first.h"
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <signal.h>
+    #include <time.h>
+    #include <errno.h>
+#endif
+
+#include <cbshm/stats_segment.h>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+
+namespace cbshm {
+
+namespace {
+
+constexpr size_t STATS_WORDS = sizeof(NativeStatsBuffer) / sizeof(uint64_t);
+
+/// First word after the header (magic, version, owner_pid, reserved)
+constexpr size_t STATS_FIRST_VALUE_WORD = offsetof(NativeStatsBuffer, publish_count) / sizeof(uint64_t);
+
+// Relaxed 64-bit loads/stores on the mapped words; see the u32 helpers in shmem_session.cpp.
+// 64-bit aligned accesses are single-copy atomic on every supported (64-bit) target.
+inline void shm_store_relaxed_u64(uint64_t* p, uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_store_n(p, v, __ATOMIC_RELAXED);
+#else
+    *reinterpret_cast<volatile uint64_t*>(p) = v;
+#endif
+}
+
+inline uint64_t shm_load_relaxed_u64(const uint64_t* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(p, __ATOMIC_RELAXED);
+#else
+    return *reinterpret_cast<const volatile uint64_t*>(p);
+#endif
+}
+
+std::string posixName(const std::string& name) {
+    return (!name.empty() && name[0] == '/') ? name : ("/" + name);
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// StatsSegment::Impl
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct StatsSegment::Impl {
+    std::string name;
+    bool owner = false;
+    void* mapped = nullptr;
+#ifdef _WIN32
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+
+    uint64_t* words() const { return static_cast<uint64_t*>(mapped); }
+    const NativeStatsBuffer* header() const { return static_cast<const NativeStatsBuffer*>(mapped); }
+
+    cbutil::Result<void> map(const bool create) {
+        const size_t size = sizeof(NativeStatsBuffer);
+#ifdef _WIN32
+        if (create) {
+            mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                         0, static_cast<DWORD>(size), name.c_str());
+        } else {
+            mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+        }
+        if (!mapping) {
+            return cbutil::Result<void>::error("Failed to create/open stats segment '" + name +
+                                               "' (err=" + std::to_string(GetLastError()) + ")");
+        }
+        mapped = MapViewOfFile(mapping, create ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, size);
+        if (!mapped) {
+            return cbutil::Result<void>::error("Failed to map stats segment '" + name +
+                                               "' (err=" + std::to_string(GetLastError()) + ")");
+        }
+#else
+        const std::string pname = posixName(name);
+        if (create) {
+            shm_unlink(pname.c_str());  // Clean up any previous
+            fd = shm_open(pname.c_str(), O_CREAT | O_RDWR, 0644);
+        } else {
+            fd = shm_open(pname.c_str(), O_RDONLY, 0);
+        }
+        if (fd < 0) {
+            return cbutil::Result<void>::error("Failed to open stats segment '" + name + "': " + strerror(errno));
+        }
+        if (create) {
+            if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+                return cbutil::Result<void>::error("Failed to set size for '" + name + "': " + strerror(errno));
+            }
+        } else {
+            struct stat st{};
+            if (fstat(fd, &st) < 0 || st.st_size < static_cast<off_t>(size)) {
+                return cbutil::Result<void>::error("Stats segment '" + name + "' is too small");
+            }
+        }
+        void* ptr = mmap(nullptr, size, create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+        if (ptr == MAP_FAILED) {
+            return cbutil::Result<void>::error("Failed to map stats segment '" + name + "'");
+        }
+        mapped = ptr;
+#endif
+        return cbutil::Result<void>::ok();
+    }
+
+    ~Impl() {
+#ifdef _WIN32
+        if (mapped) UnmapViewOfFile(mapped);
+        if (mapping) CloseHandle(mapping);
+#else
+        if (mapped) munmap(mapped, sizeof(NativeStatsBuffer));
+        if (fd >= 0) {
+            ::close(fd);
+            if (owner) shm_unlink(posixName(name).c_str());
+        }
+#endif
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// StatsSegment
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+StatsSegment::StatsSegment() : m_impl(std::make_unique<Impl>()) {}
+StatsSegment::~StatsSegment() = default;
+StatsSegment::StatsSegment(StatsSegment&& other) noexcept = default;
+StatsSegment& StatsSegment::operator=(StatsSegment&& other) noexcept = default;
+
+cbutil::Result<StatsSegment> StatsSegment::create(const std::string& name) {
+    StatsSegment segment;
+    segment.m_impl->name = name;
+    segment.m_impl->owner = true;
+    auto r = segment.m_impl->map(true);
+    if (r.isError()) {
+        return cbutil::Result<StatsSegment>::error(r.error());
+    }
+
+    auto* buf = static_cast<NativeStatsBuffer*>(segment.m_impl->mapped);
+    std::memset(buf, 0, sizeof(NativeStatsBuffer));
+    buf->version = NATIVE_STATS_VERSION;
+#ifdef _WIN32
+    buf->owner_pid = GetCurrentProcessId();
+#else
+    buf->owner_pid = static_cast<uint32_t>(getpid());
+#endif
+    // Magic last: a reader that sees it also sees a fully initialized header
+    std::atomic_thread_fence(std::memory_order_release);
+    buf->magic = NATIVE_STATS_MAGIC;
+    return cbutil::Result<StatsSegment>::ok(std::move(segment));
+}
+
+cbutil::Result<StatsSegment> StatsSegment::open(const std::string& name) {
+    StatsSegment segment;
+    segment.m_impl->name = name;
+    auto r = segment.m_impl->map(false);
+    if (r.isError()) {
+        return cbutil::Result<StatsSegment>::error(r.error());
+    }
+
+    const auto* buf = segment.m_impl->header();
+    if (buf->magic != NATIVE_STATS_MAGIC) {
+        return cbutil::Result<StatsSegment>::error("Not a stats segment: " + name);
+    }
+    if (buf->version != NATIVE_STATS_VERSION) {
+        return cbutil::Result<StatsSegment>::error("Unsupported stats segment version " +
+                                                   std::to_string(buf->version));
+    }
+    return cbutil::Result<StatsSegment>::ok(std::move(segment));
+}
+
+void StatsSegment::publish(const NativeStatsBuffer& values) {
+    if (!m_impl || !m_impl->owner || !m_impl->mapped) {
+        return;
+    }
+
+    uint64_t src[STATS_WORDS];
+    std::memcpy(src, &values, sizeof(src));
+    uint64_t* dst = m_impl->words();
+
+    constexpr size_t count_word = offsetof(NativeStatsBuffer, publish_count) / sizeof(uint64_t);
+    for (size_t i = STATS_FIRST_VALUE_WORD; i < STATS_WORDS; ++i) {
+        if (i != count_word) {
+            shm_store_relaxed_u64(&dst[i], src[i]);
+        }
+    }
+    shm_store_relaxed_u64(&dst[count_word], shm_load_relaxed_u64(&dst[count_word]) + 1);
+}
+
+NativeStatsBuffer StatsSegment::read() const {
+    NativeStatsBuffer out{};
+    if (!m_impl || !m_impl->mapped) {
+        return out;
+    }
+
+    uint64_t words[STATS_WORDS];
+    const uint64_t* src = m_impl->words();
+    for (size_t i = 0; i < STATS_WORDS; ++i) {
+        words[i] = shm_load_relaxed_u64(&src[i]);
+    }
+    std::memcpy(&out, words, sizeof(out));
+    return out;
+}
+
+bool StatsSegment::isOwnerAlive() const {
+    if (!m_impl || !m_impl->mapped) {
+        return false;
+    }
+    if (m_impl->owner) {
+        return true;
+    }
+
+    const uint32_t pid = m_impl->header()->owner_pid;
+    if (pid == 0) {
+        return true;
+    }
+#ifdef _WIN32
+    HANDLE h = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+    if (h) {
+        CloseHandle(h);
+        return true;
+    }
+    return false;
+#else
+    // EPERM means the process exists but we lack permission to signal it
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Thread CPU time
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+uint64_t currentThreadCpuNs() {
+#ifdef _WIN32
+    FILETIME creation, exit_time, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit_time, &kernel, &user)) {
+        return 0;
+    }
+    const auto to_u64 = [](const FILETIME& ft) {
+        return (static_cast<uint64_t>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+    };
+    return (to_u64(kernel) + to_u64(user)) * 100;  // FILETIME is in 100 ns units
+#else
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ull + static_cast<uint64_t>(ts.tv_nsec);
+#endif
+}
+
+} // namespace cbshm
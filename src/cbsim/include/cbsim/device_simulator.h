@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   device_simulator.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Synthetic Gemini-style device for end-to-end load testing
+///
+/// DeviceSimulator listens on a UDP port and speaks the current protocol well enough for an
+/// unmodified DeviceSession / SdkSession to connect to it: it answers protocol detection and
+/// the startup handshake (SYSSETRUNLEV), REQCONFIGALL, nPlay clock probes (NPLAYSET) and
+/// CHANSET* requests, and streams synthetic continuous, spike and digital input data to the client.
+///
+/// Usage:
+/// @code
+///   cbsim::SimulatorConfig config;
+///   config.port = 0;                      // pick a free port
+///   config.groups = {{5, 256}, {2, 16}};  // 256 ch @ 30 kHz + 16 ch @ 1 kHz
+///   auto sim = cbsim::DeviceSimulator::create(config);
+///   sim.value().start();
+///
+///   auto params = cbdev::ConnectionParams::custom("127.0.0.1", "127.0.0.1", 0, sim.value().port());
+///   // ... connect DeviceSession / SdkSession with params ...
+/// @endcode
+///
+/// It is a test tool, not an emulation of firmware timing: data is generated on a single thread
+/// and paced in 1 ms steps (or unthrottled), and only the current protocol is spoken.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBSIM_DEVICE_SIMULATOR_H
+#define CBSIM_DEVICE_SIMULATOR_H
+
+#include <cbutil/result.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cbsim {
+
+template<typename T>
+using Result = cbutil::Result<T>;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Configuration
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// One continuously sampled group: @p channels consecutive channels at sample group @p group
+struct GroupStream {
+    uint32_t group = 5;       ///< Sample group (1-6: 500 Hz, 1 kHz, 2 kHz, 10 kHz, 30 kHz, raw)
+    uint32_t channels = 96;   ///< Number of channels in the group
+};
+
+/// Simulator configuration
+struct SimulatorConfig {
+    // Network
+    std::string address = "127.0.0.1";  ///< Address to bind (the "device" address)
+    uint16_t port = 51001;               ///< Port to bind (0 = any free port, see DeviceSimulator::port())
+    std::string client_address;          ///< Fixed stream destination (empty = reply to the last peer)
+    uint16_t client_port = 0;            ///< Fixed stream destination port (used with client_address)
+
+    // Streams
+    /// Continuous groups.  Channels are assigned in order (the first group gets channels 1..n,
+    /// the next one n+1..), up to cbNUM_ANALOG_CHANS in total; channels past cbNUM_FE_CHANS are
+    /// reported as analog inputs.
+    std::vector<GroupStream> groups = {GroupStream{}};
+    double spike_rate_hz = 10.0;         ///< Mean spike rate per front-end channel (Poisson; 0 = none)
+    double digital_rate_hz = 0.0;        ///< Digital input packets per second: a 16-bit counter on the
+                                         ///< first digital input channel, which is then reported as a
+                                         ///< digital input (0 = none)
+    size_t max_datagram_bytes = 8192;    ///< Aggregate packets into datagrams up to this size
+    double speed = 1.0;                  ///< Device clock rate relative to real time (0 = unthrottled)
+    bool heartbeat = true;               ///< Send SYSHEARTBEAT every 10 ms of device time
+
+    // State
+    uint32_t initial_runlevel = 50;      ///< Runlevel at start (cbRUNLEVEL_RUNNING); data only flows when RUNNING
+    uint32_t seed = 0xCE7E11C5u;         ///< Seed for synthetic waveforms and spike times
+};
+
+/// Counters, updated by the simulator thread
+struct SimulatorStats {
+    uint64_t datagrams_sent = 0;     ///< Datagrams sent (stream and replies)
+    uint64_t packets_sent = 0;       ///< Packets sent (stream and replies)
+    uint64_t bytes_sent = 0;         ///< Datagram bytes sent
+    uint64_t group_packets = 0;      ///< Continuous (group) packets sent
+    uint64_t spike_packets = 0;      ///< Spike packets sent
+    uint64_t digital_packets = 0;    ///< Digital input packets sent
+    uint64_t requests_received = 0;  ///< Packets received from clients
+    uint64_t config_requests = 0;    ///< REQCONFIGALL requests answered
+    uint64_t clock_probes = 0;       ///< NPLAYSET probes echoed
+    uint64_t send_errors = 0;        ///< Failed sendto() calls (e.g. ENOBUFS at max rate)
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Loopback device emulator
+///
+/// Owns one UDP socket and one worker thread.  Not copyable.
+///
+class DeviceSimulator {
+public:
+    /// Validate the configuration and bind the socket
+    /// @param config Simulator configuration
+    /// @return Simulator (stopped) on success, error on invalid config or bind failure
+    static Result<DeviceSimulator> create(const SimulatorConfig& config);
+
+    DeviceSimulator(DeviceSimulator&&) noexcept;
+    DeviceSimulator& operator=(DeviceSimulator&&) noexcept;
+    DeviceSimulator(const DeviceSimulator&) = delete;
+    DeviceSimulator& operator=(const DeviceSimulator&) = delete;
+
+    /// Stops the worker thread and closes the socket
+    ~DeviceSimulator();
+
+    /// Start answering requests and streaming
+    Result<void> start();
+
+    /// Stop the worker thread (the socket stays bound; start() may be called again)
+    void stop();
+
+    /// @return true while the worker thread is running
+    [[nodiscard]] bool isRunning() const;
+
+    /// @return The bound port (useful when SimulatorConfig::port is 0)
+    [[nodiscard]] uint16_t port() const;
+
+    /// @return Current runlevel (changed by SYSSETRUNLEV)
+    [[nodiscard]] uint32_t runlevel() const;
+
+    /// @return Total number of simulated channels
+    [[nodiscard]] uint32_t channelCount() const;
+
+    /// @return Snapshot of the counters
+    [[nodiscard]] SimulatorStats stats() const;
+
+private:
+    DeviceSimulator();
+
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+} // namespace cbsim
+
+#endif // CBSIM_DEVICE_SIMULATOR_H
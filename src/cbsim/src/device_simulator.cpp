@@ -0,0 +1,770 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   device_simulator.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Synthetic Gemini-style device for end-to-end load testing
+///
+/// A single worker thread alternates between servicing client requests and emitting the data
+/// that is due on the device clock.  All device state (channel table, group membership, sample
+/// cursors) is owned by that thread; the public accessors only read atomics.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Platform headers MUST be included first (before cbproto, which uses #pragma pack)
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+        #define WIN32_LEAN_AND_MEAN
+    #endif
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #include <windows.h>
+    typedef SOCKET SocketHandle;
+    typedef int socklen_t;
+    #define INVALID_SOCKET_VALUE INVALID_SOCKET
+#else
+    #include <sys/socket.h>
+    #include <sys/select.h>
+    #include <netinet/in.h>
+    #include <arpa/inet.h>
+    #include <unistd.h>
+    typedef int SocketHandle;
+    #define INVALID_SOCKET_VALUE -1
+#endif
+
+#include <cbsim/device_simulator.h>
+#include <cbproto/cbproto.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <thread>
+
+namespace cbsim {
+
+namespace {
+
+constexpr uint32_t SYSFREQ = 30000;                   ///< Device sample clock (Hz)
+constexpr uint32_t SPIKE_LEN = 48;                    ///< Spike waveform samples
+constexpr uint32_t SPIKE_PRE = 10;                    ///< Spike pre-trigger samples
+constexpr uint64_t STEP_NS = 1000000;                 ///< Emission step (1 ms)
+constexpr uint64_t HEARTBEAT_NS = 10000000;           ///< SYSHEARTBEAT interval (10 ms)
+constexpr uint64_t MAX_CATCHUP_NS = 1000000000;       ///< Skip ahead instead of bursting after a stall
+constexpr uint64_t DEVICE_EPOCH_NS = 1000000000;      ///< Device clock at first start (non-zero)
+constexpr size_t WAVE_TABLE_LEN = SYSFREQ;            ///< One second of synthetic signal
+constexpr uint32_t NUM_STREAM_GROUPS = 6;             ///< Sample groups 1..6 can stream
+constexpr uint16_t DIGIN_CHAN = cbNUM_ANALOG_CHANS + cbNUM_ANALOGOUT_CHANS + 1;  ///< First digital input
+constexpr auto REPLY_PACING = std::chrono::microseconds(200);  ///< Gap between datagrams of one reply
+
+/// Sample rate (Hz) of sample group @p group, or 0 if it is not a streaming group
+uint32_t groupRate(uint32_t group) {
+    static constexpr uint32_t rates[NUM_STREAM_GROUPS + 1] = {0, 500, 1000, 2000, 10000, 30000, 30000};
+    return group <= NUM_STREAM_GROUPS ? rates[group] : 0;
+}
+
+const char* groupLabel(uint32_t group) {
+    static constexpr const char* labels[NUM_STREAM_GROUPS + 1] = {
+        "", "500 S/s", "1 kS/s", "2 kS/s", "10 kS/s", "30 kS/s", "Raw"};
+    return group <= NUM_STREAM_GROUPS ? labels[group] : "";
+}
+
+/// Wire length of a packet from its header
+size_t packetBytes(const cbPKT_HEADER& hdr) {
+    return cbPKT_HEADER_SIZE + static_cast<size_t>(hdr.dlen) * 4;
+}
+
+void closeSocket(SocketHandle sock) {
+#ifdef _WIN32
+    closesocket(sock);
+#else
+    close(sock);
+#endif
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+struct DeviceSimulator::Impl {
+    SimulatorConfig config;
+    SocketHandle sock = INVALID_SOCKET_VALUE;
+    uint16_t port = 0;
+    uint32_t total_channels = 0;
+
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::atomic<uint32_t> runlevel{cbRUNLEVEL_RUNNING};
+
+    // Counters
+    std::atomic<uint64_t> datagrams_sent{0};
+    std::atomic<uint64_t> packets_sent{0};
+    std::atomic<uint64_t> bytes_sent{0};
+    std::atomic<uint64_t> group_packets{0};
+    std::atomic<uint64_t> spike_packets{0};
+    std::atomic<uint64_t> digital_packets{0};
+    std::atomic<uint64_t> requests_received{0};
+    std::atomic<uint64_t> config_requests{0};
+    std::atomic<uint64_t> clock_probes{0};
+    std::atomic<uint64_t> send_errors{0};
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Device model (worker thread only once started)
+
+    std::vector<cbPKT_CHANINFO> chaninfo;                              ///< Index = chan - 1
+    cbPKT_CHANINFO digin_info{};                                       ///< The digital input DIGIN_CHAN
+    std::array<std::vector<uint16_t>, NUM_STREAM_GROUPS + 1> members;  ///< Channels per group
+    std::vector<uint16_t> spike_channels;                              ///< Front-end channels extracting spikes
+
+    std::array<uint64_t, NUM_STREAM_GROUPS + 1> cursor{};  ///< Next sample index per group
+    uint64_t stream_ns = DEVICE_EPOCH_NS;                  ///< Device time emitted so far
+    uint64_t next_heartbeat_ns = DEVICE_EPOCH_NS;
+    uint64_t next_digital_ns = DEVICE_EPOCH_NS;
+    uint32_t digital_word = 0;                             ///< Last digital input value sent
+    std::chrono::steady_clock::time_point wall_start;      ///< Wall time matching clock_base_ns
+    uint64_t clock_base_ns = DEVICE_EPOCH_NS;
+
+    sockaddr_in client{};
+    bool have_client = false;
+
+    std::mt19937 rng;
+    std::vector<int16_t> wave;                 ///< WAVE_TABLE_LEN samples of synthetic signal
+    std::array<int16_t, SPIKE_LEN> spike_template{};
+
+    std::vector<uint8_t> out;                  ///< Datagram being assembled
+    sockaddr_in out_dest{};
+    bool pace_replies = false;                 ///< Set while assembling a multi-datagram reply
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Setup
+
+    void initModel() {
+        rng.seed(config.seed);
+
+        // 10 Hz + 180 Hz tones plus noise, a little like a broadband recording
+        constexpr double pi = 3.14159265358979323846;
+        std::normal_distribution<double> noise(0.0, 40.0);
+        wave.resize(WAVE_TABLE_LEN);
+        for (size_t i = 0; i < WAVE_TABLE_LEN; ++i) {
+            const double t = static_cast<double>(i) / SYSFREQ;
+            wave[i] = static_cast<int16_t>(std::lround(
+                400.0 * std::sin(2 * pi * 10 * t) + 120.0 * std::sin(2 * pi * 180 * t) + noise(rng)));
+        }
+        for (uint32_t i = 0; i < SPIKE_LEN; ++i) {
+            const double x = (static_cast<double>(i) - SPIKE_PRE) / 3.0;
+            spike_template[i] = static_cast<int16_t>(std::lround(-900.0 * std::exp(-x * x) +
+                                                                 300.0 * std::exp(-(x - 3) * (x - 3) / 4)));
+        }
+
+        chaninfo.assign(total_channels, cbPKT_CHANINFO{});
+        uint32_t chan = 1;
+        for (const auto& gs : config.groups) {
+            for (uint32_t i = 0; i < gs.channels; ++i, ++chan) {
+                initChannel(chan, gs.group);
+            }
+        }
+        rebuildMembership();
+
+        digin_info.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+        digin_info.cbpkt_header.type = cbPKTTYPE_CHANREP;
+        digin_info.cbpkt_header.dlen = cbPKTDLEN_CHANINFO;
+        digin_info.chan = DIGIN_CHAN;
+        digin_info.proc = 1;
+        digin_info.chancaps = cbCHAN_EXISTS | cbCHAN_CONNECTED | cbCHAN_DINP;
+        digin_info.dinpcaps = cbDINP_16BIT | cbDINP_ANYBIT;
+        digin_info.dinpopts = cbDINP_16BIT | cbDINP_ANYBIT;
+        std::snprintf(digin_info.label, sizeof(digin_info.label), "digin");
+    }
+
+    void initChannel(uint32_t chan, uint32_t group) {
+        const bool frontend = chan <= cbNUM_FE_CHANS;
+        auto& ci = chaninfo[chan - 1];
+        ci = {};
+        ci.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+        ci.cbpkt_header.type = cbPKTTYPE_CHANREP;
+        ci.cbpkt_header.dlen = cbPKTDLEN_CHANINFO;
+        ci.chan = chan;
+        ci.proc = 1;
+        ci.bank = frontend ? (chan - 1) / cbCHAN_PER_BANK + 1 : cbNUM_FE_BANKS + 1;
+        ci.term = frontend ? (chan - 1) % cbCHAN_PER_BANK + 1 : chan - cbNUM_FE_CHANS;
+        ci.chancaps = cbCHAN_EXISTS | cbCHAN_CONNECTED | cbCHAN_AINP | (frontend ? cbCHAN_ISOLATED : 0);
+        cbSCALING scale = {};
+        scale.digmin = -32764;
+        scale.digmax = 32764;
+        scale.anamin = frontend ? -8191 : -5000;
+        scale.anamax = frontend ? 8191 : 5000;
+        scale.anagain = 1;
+        std::snprintf(scale.anaunit, sizeof(scale.anaunit), "%s", frontend ? "uV" : "mV");
+        ci.physcalin = scale;
+        ci.scalin = scale;
+        std::snprintf(ci.label, sizeof(ci.label), frontend ? "chan%u" : "ainp%u",
+                      frontend ? chan : chan - cbNUM_FE_CHANS);
+        ci.smpgroup = group;
+        ci.spkopts = frontend ? cbAINPSPK_EXTRACT : 0;
+        ci.spkthrlevel = -260;
+    }
+
+    /// Derive group lists and spike channels from the channel table
+    void rebuildMembership() {
+        for (auto& m : members) m.clear();
+        spike_channels.clear();
+        for (const auto& ci : chaninfo) {
+            if (groupRate(ci.smpgroup) > 0) {
+                members[ci.smpgroup].push_back(static_cast<uint16_t>(ci.chan));
+            }
+            if (ci.chan <= cbNUM_FE_CHANS && (ci.spkopts & cbAINPSPK_EXTRACT)) {
+                spike_channels.push_back(static_cast<uint16_t>(ci.chan));
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Clock
+
+    /// Time of sample @p k of group @p group
+    uint64_t sampleTime(uint32_t group, uint64_t k) const {
+        return DEVICE_EPOCH_NS + k * 1000000000ULL / groupRate(group);
+    }
+
+    /// Index of the first sample of @p group strictly after @p ns
+    uint64_t firstSampleAfter(uint32_t group, uint64_t ns) const {
+        if (ns < DEVICE_EPOCH_NS) return 0;
+        return (ns - DEVICE_EPOCH_NS) * groupRate(group) / 1000000000ULL + 1;
+    }
+
+    uint64_t deviceNow() const {
+        if (config.speed <= 0) return stream_ns;  // unthrottled: the clock is the data
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - wall_start).count();
+        return clock_base_ns + static_cast<uint64_t>(static_cast<double>(elapsed) * config.speed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Output
+
+    void beginDatagram(const sockaddr_in& dest) {
+        flush();
+        out_dest = dest;
+    }
+
+    void append(const void* pkt) {
+        const auto& hdr = *static_cast<const cbPKT_HEADER*>(pkt);
+        const size_t n = packetBytes(hdr);
+        if (!out.empty() && out.size() + n > config.max_datagram_bytes) {
+            flush();
+            // A REQCONFIGALL reply is a few hundred kB.  The device trickles it out over the
+            // link; sent back to back on loopback it overruns a default-sized receive buffer.
+            if (pace_replies) std::this_thread::sleep_for(REPLY_PACING);
+        }
+        const auto* bytes = static_cast<const uint8_t*>(pkt);
+        out.insert(out.end(), bytes, bytes + n);
+        packets_sent.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void flush() {
+        if (out.empty()) return;
+        const auto n = sendto(sock, reinterpret_cast<const char*>(out.data()), static_cast<int>(out.size()), 0,
+                              reinterpret_cast<const sockaddr*>(&out_dest), sizeof(out_dest));
+        if (n < 0) {
+            send_errors.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            datagrams_sent.fetch_add(1, std::memory_order_relaxed);
+            bytes_sent.fetch_add(out.size(), std::memory_order_relaxed);
+        }
+        out.clear();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Requests
+
+    /// Wait up to @p timeout_us for a datagram and handle everything that is queued
+    void serviceRequests(long timeout_us) {
+        std::vector<uint8_t> buf(cbCER_UDP_SIZE_MAX);
+        while (running.load(std::memory_order_relaxed)) {
+            fd_set readfds;
+            FD_ZERO(&readfds);
+            FD_SET(sock, &readfds);
+            timeval tv = {0, timeout_us};
+            if (select(static_cast<int>(sock) + 1, &readfds, nullptr, nullptr, &tv) <= 0) return;
+            timeout_us = 0;
+
+            sockaddr_in from{};
+            socklen_t len = sizeof(from);
+            const auto n = recvfrom(sock, reinterpret_cast<char*>(buf.data()), static_cast<int>(buf.size()), 0,
+                                    reinterpret_cast<sockaddr*>(&from), &len);
+            if (n <= 0) return;
+            handleDatagram(buf.data(), static_cast<size_t>(n), from);
+        }
+    }
+
+    void handleDatagram(const uint8_t* data, size_t size, const sockaddr_in& from) {
+        if (config.client_address.empty()) {
+            client = from;
+            have_client = true;
+        }
+        beginDatagram(from);
+        pace_replies = true;
+        size_t offset = 0;
+        while (offset + cbPKT_HEADER_SIZE <= size) {
+            const auto& hdr = *reinterpret_cast<const cbPKT_HEADER*>(data + offset);
+            const size_t n = packetBytes(hdr);
+            if (n > cbPKT_MAX_SIZE || offset + n > size) break;  // legacy-format probe or garbage
+            requests_received.fetch_add(1, std::memory_order_relaxed);
+            if (hdr.chid == cbPKTCHAN_CONFIGURATION) {
+                handleRequest(data + offset, n);
+            }
+            offset += n;
+        }
+        flush();
+        pace_replies = false;
+    }
+
+    void handleRequest(const uint8_t* pkt, size_t size) {
+        cbPKT_GENERIC req = {};
+        std::memcpy(&req, pkt, std::min(size, sizeof(req)));
+        const uint16_t type = req.cbpkt_header.type;
+
+        if (type == cbPKTTYPE_SYSSETRUNLEV) {
+            const auto& set = reinterpret_cast<const cbPKT_SYSINFO&>(req);
+            uint32_t level = runlevel.load();
+            switch (set.runlevel) {
+                case cbRUNLEVEL_HARDRESET: level = cbRUNLEVEL_STANDBY; break;
+                case cbRUNLEVEL_RESET:     level = cbRUNLEVEL_RUNNING; break;
+                case cbRUNLEVEL_RUNNING:   break;  // only RESET leaves STANDBY, like the NSP
+                default:                   level = set.runlevel; break;
+            }
+            setRunlevel(level);
+            appendSysInfo(cbPKTTYPE_SYSREPRUNLEV);
+        } else if (type == cbPKTTYPE_REQCONFIGALL) {
+            config_requests.fetch_add(1, std::memory_order_relaxed);
+            appendConfiguration();
+        } else if (type == cbPKTTYPE_NPLAYSET) {
+            // Clock probe: echo with the device time written into etime, as current firmware does
+            clock_probes.fetch_add(1, std::memory_order_relaxed);
+            auto& nplay = reinterpret_cast<cbPKT_NPLAY&>(req);
+            const uint64_t now = deviceNow();
+            nplay.cbpkt_header.type = cbPKTTYPE_NPLAYREP;
+            nplay.cbpkt_header.time = now;
+            nplay.etime = now;
+            append(&nplay);
+        } else if (type >= cbPKTTYPE_CHANSET && type <= cbPKTTYPE_CHANSETAUTOTHRESHOLD) {
+            const auto& set = reinterpret_cast<const cbPKT_CHANINFO&>(req);
+            if (set.chan == 0 || set.chan > total_channels) return;
+            auto& ci = chaninfo[set.chan - 1];
+            const uint32_t old_group = ci.smpgroup;
+            const uint32_t old_spkopts = ci.spkopts;
+            ci = set;
+            ci.cbpkt_header.time = deviceNow();
+            ci.cbpkt_header.type = static_cast<uint16_t>(type & ~0x80);
+            ci.cbpkt_header.dlen = cbPKTDLEN_CHANINFO;
+            if (ci.smpgroup != old_group || ci.spkopts != old_spkopts) {
+                rebuildMembership();
+                // A channel joining a group starts at that group's current sample
+                for (uint32_t g = 1; g <= NUM_STREAM_GROUPS; ++g) {
+                    cursor[g] = std::max(cursor[g], firstSampleAfter(g, stream_ns));
+                }
+            }
+            append(&ci);
+        } else if ((type & 0x80) && type < cbPKTTYPE_MASKED_REFLECTED) {
+            // Other setters: acknowledge by echoing as the matching reply
+            req.cbpkt_header.type = static_cast<uint16_t>(type & ~0x80);
+            req.cbpkt_header.time = deviceNow();
+            append(&req);
+        }
+    }
+
+    void setRunlevel(uint32_t level) {
+        const uint32_t prev = runlevel.exchange(level);
+        if (level == cbRUNLEVEL_RUNNING && prev != cbRUNLEVEL_RUNNING) {
+            resyncStream(deviceNow());
+        }
+    }
+
+    void appendSysInfo(uint16_t type) {
+        cbPKT_SYSINFO sys = {};
+        sys.cbpkt_header.time = deviceNow();
+        sys.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+        sys.cbpkt_header.type = type;
+        sys.cbpkt_header.dlen = cbPKTDLEN_SYSINFO;
+        sys.sysfreq = SYSFREQ;
+        sys.spikelen = SPIKE_LEN;
+        sys.spikepre = SPIKE_PRE;
+        sys.runlevel = runlevel.load();
+        append(&sys);
+    }
+
+    /// The REQCONFIGALL reply: marker, processor, banks, groups, channels, then the SYSREP barrier
+    void appendConfiguration() {
+        const uint64_t now = deviceNow();
+        cbPKT_GENERIC marker = {};
+        marker.cbpkt_header.time = now;
+        marker.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+        marker.cbpkt_header.type = cbPKTTYPE_REPCONFIGALL;
+        append(&marker);
+
+        const uint32_t fe_chans = std::min<uint32_t>(total_channels, cbNUM_FE_CHANS);
+        const uint32_t fe_banks = (fe_chans + cbCHAN_PER_BANK - 1) / cbCHAN_PER_BANK;
+        const uint32_t banks = fe_banks + (total_channels > cbNUM_FE_CHANS ? 1 : 0);
+
+        cbPKT_PROCINFO proc = {};
+        proc.cbpkt_header.time = now;
+        proc.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+        proc.cbpkt_header.type = cbPKTTYPE_PROCREP;
+        proc.cbpkt_header.dlen = cbPKTDLEN_PROCINFO;
+        proc.proc = 1;
+        std::snprintf(proc.ident, sizeof(proc.ident), "Gemini NSP Simulator");
+        proc.chanbase = 1;
+        proc.chancount = total_channels;
+        proc.bankcount = banks;
+        proc.groupcount = NUM_STREAM_GROUPS;
+        proc.version = (cbVERSION_MAJOR << 16) | cbVERSION_MINOR;
+        append(&proc);
+
+        for (uint32_t bank = 1; bank <= banks; ++bank) {
+            const bool frontend = bank <= fe_banks;
+            cbPKT_BANKINFO bi = {};
+            bi.cbpkt_header.time = now;
+            bi.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+            bi.cbpkt_header.type = cbPKTTYPE_BANKREP;
+            bi.cbpkt_header.dlen = cbPKTDLEN_BANKINFO;
+            bi.proc = 1;
+            bi.bank = frontend ? bank : cbNUM_FE_BANKS + 1;
+            bi.chanbase = frontend ? (bank - 1) * cbCHAN_PER_BANK + 1 : cbNUM_FE_CHANS + 1;
+            bi.chancount = frontend ? std::min<uint32_t>(cbCHAN_PER_BANK, fe_chans - (bank - 1) * cbCHAN_PER_BANK)
+                                    : total_channels - cbNUM_FE_CHANS;
+            std::snprintf(bi.ident, sizeof(bi.ident), "Simulated bank");
+            std::snprintf(bi.label, sizeof(bi.label), frontend ? "%c" : "Analog In",
+                          static_cast<char>('A' + bank - 1));
+            append(&bi);
+        }
+
+        for (uint32_t g = 1; g <= NUM_STREAM_GROUPS; ++g) {
+            cbPKT_GROUPINFO gi = {};
+            gi.cbpkt_header.time = now;
+            gi.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+            gi.cbpkt_header.type = cbPKTTYPE_GROUPREP;
+            gi.proc = 1;
+            gi.group = g;
+            std::snprintf(gi.label, sizeof(gi.label), "%s", groupLabel(g));
+            gi.period = SYSFREQ / groupRate(g);
+            gi.length = static_cast<uint32_t>(members[g].size());
+            std::copy(members[g].begin(), members[g].end(), gi.list);
+            gi.cbpkt_header.dlen = static_cast<uint16_t>(cbPKTDLEN_GROUPINFOSHORT + (gi.length + 1) / 2);
+            append(&gi);
+        }
+
+        for (auto& ci : chaninfo) {
+            ci.cbpkt_header.time = now;
+            ci.cbpkt_header.type = cbPKTTYPE_CHANREP;
+            append(&ci);
+        }
+        if (config.digital_rate_hz > 0) {
+            digin_info.cbpkt_header.time = now;
+            append(&digin_info);
+        }
+
+        appendSysInfo(cbPKTTYPE_SYSREP);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Stream
+
+    struct Event {
+        uint64_t time;
+        uint16_t kind;   ///< 0 = heartbeat, 1 = group, 2 = spike, 3 = digital input
+        uint16_t arg;    ///< Group or channel
+        uint64_t index;  ///< Sample index (groups)
+    };
+    std::vector<Event> events;
+
+    /// Jump the stream to @p ns without emitting the skipped data
+    void resyncStream(uint64_t ns) {
+        stream_ns = std::max(stream_ns, ns);
+        for (uint32_t g = 1; g <= NUM_STREAM_GROUPS; ++g) {
+            cursor[g] = std::max(cursor[g], firstSampleAfter(g, stream_ns));
+        }
+        next_heartbeat_ns = std::max(next_heartbeat_ns, stream_ns + HEARTBEAT_NS);
+        next_digital_ns = std::max(next_digital_ns, stream_ns + 1);
+    }
+
+    /// Emit everything in (stream_ns, target_ns], time ordered, then flush
+    void emitUntil(uint64_t target_ns) {
+        if (target_ns <= stream_ns) return;
+        if (target_ns - stream_ns > MAX_CATCHUP_NS) {
+            resyncStream(target_ns - STEP_NS);
+        }
+        events.clear();
+
+        if (config.heartbeat) {
+            for (; next_heartbeat_ns <= target_ns; next_heartbeat_ns += HEARTBEAT_NS) {
+                events.push_back({next_heartbeat_ns, 0, 0, 0});
+            }
+        }
+        for (uint32_t g = 1; g <= NUM_STREAM_GROUPS; ++g) {
+            if (members[g].empty()) continue;
+            for (; sampleTime(g, cursor[g]) <= target_ns; ++cursor[g]) {
+                events.push_back({sampleTime(g, cursor[g]), 1, static_cast<uint16_t>(g), cursor[g]});
+            }
+        }
+        if (config.spike_rate_hz > 0 && !spike_channels.empty()) {
+            const double span_s = static_cast<double>(target_ns - stream_ns) * 1e-9;
+            std::poisson_distribution<uint32_t> count(config.spike_rate_hz * spike_channels.size() * span_s);
+            std::uniform_int_distribution<uint64_t> when(stream_ns + 1, target_ns);
+            std::uniform_int_distribution<size_t> which(0, spike_channels.size() - 1);
+            for (uint32_t n = count(rng); n > 0; --n) {
+                events.push_back({when(rng), 2, spike_channels[which(rng)], 0});
+            }
+        }
+        if (config.digital_rate_hz > 0) {
+            const auto period = static_cast<uint64_t>(1e9 / config.digital_rate_hz);
+            for (; next_digital_ns <= target_ns; next_digital_ns += std::max<uint64_t>(period, 1)) {
+                events.push_back({next_digital_ns, 3, DIGIN_CHAN, 0});
+            }
+        }
+        std::stable_sort(events.begin(), events.end(),
+                         [](const Event& a, const Event& b) { return a.time < b.time; });
+
+        beginDatagram(client);
+        cbPKT_GENERIC pkt;
+        for (const auto& ev : events) {
+            switch (ev.kind) {
+                case 0: buildHeartbeat(pkt, ev.time); break;
+                case 1: buildGroup(pkt, ev.time, ev.arg, ev.index); break;
+                case 3: buildDigital(pkt, ev.time, ev.arg); break;
+                default: buildSpike(pkt, ev.time, ev.arg); break;
+            }
+            append(&pkt);
+        }
+        flush();
+        stream_ns = target_ns;
+    }
+
+    void buildHeartbeat(cbPKT_GENERIC& pkt, uint64_t time) {
+        pkt.cbpkt_header = {};
+        pkt.cbpkt_header.time = time;
+        pkt.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+        pkt.cbpkt_header.type = cbPKTTYPE_SYSHEARTBEAT;
+        pkt.cbpkt_header.dlen = cbPKTDLEN_SYSHEARTBEAT;
+    }
+
+    void buildGroup(cbPKT_GENERIC& pkt, uint64_t time, uint32_t group, uint64_t k) {
+        const auto& list = members[group];
+        auto& grp = reinterpret_cast<cbPKT_GROUP&>(pkt);
+        grp.cbpkt_header = {};
+        grp.cbpkt_header.time = time;
+        grp.cbpkt_header.chid = 0;
+        grp.cbpkt_header.type = static_cast<uint16_t>(group);
+        grp.cbpkt_header.dlen = static_cast<uint16_t>((list.size() + 1) / 2);
+        // Walk the table at the group's rate so every group carries the same underlying signal
+        const uint64_t pos = k * (SYSFREQ / groupRate(group));
+        for (size_t i = 0; i < list.size(); ++i) {
+            grp.data[i] = wave[(pos + list[i] * 211u) % WAVE_TABLE_LEN];
+        }
+        if (list.size() % 2) grp.data[list.size()] = 0;
+        group_packets.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void buildSpike(cbPKT_GENERIC& pkt, uint64_t time, uint16_t chan) {
+        auto& spk = reinterpret_cast<cbPKT_SPK&>(pkt);
+        spk.cbpkt_header = {};
+        spk.cbpkt_header.time = time;
+        spk.cbpkt_header.chid = chan;
+        spk.cbpkt_header.type = static_cast<uint16_t>(std::uniform_int_distribution<int>(1, 3)(rng));
+        spk.cbpkt_header.dlen = static_cast<uint16_t>(cbPKTDLEN_SPKSHORT + SPIKE_LEN / 2);
+        const float scale = 0.6f + 0.2f * spk.cbpkt_header.type;
+        spk.fPattern[0] = spk.fPattern[1] = spk.fPattern[2] = 0.0f;
+        spk.nPeak = std::numeric_limits<int16_t>::min();
+        spk.nValley = std::numeric_limits<int16_t>::max();
+        for (uint32_t i = 0; i < SPIKE_LEN; ++i) {
+            const auto v = static_cast<int16_t>(spike_template[i] * scale);
+            spk.wave[i] = v;
+            spk.nPeak = std::max(spk.nPeak, v);
+            spk.nValley = std::min(spk.nValley, v);
+        }
+        spike_packets.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /// The next value of a counter on digital input @p chan
+    void buildDigital(cbPKT_GENERIC& pkt, uint64_t time, uint16_t chan) {
+        auto& din = reinterpret_cast<cbPKT_DINP&>(pkt);
+        din.cbpkt_header = {};
+        din.cbpkt_header.time = time;
+        din.cbpkt_header.chid = chan;
+        din.cbpkt_header.dlen = static_cast<uint16_t>(sizeof(cbPKT_DINP) / 4 - cbPKT_HEADER_32SIZE);
+        const uint32_t next = (digital_word + 1) & 0xFFFF;
+        din.valueRead = next;
+        din.bitsChanged = next ^ digital_word;
+        din.eventType = DINP_EVENT_ANYBIT;
+        digital_word = next;
+        digital_packets.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////
+    // Worker
+
+    void run() {
+        clock_base_ns = stream_ns;
+        wall_start = std::chrono::steady_clock::now();
+        resyncStream(stream_ns);
+
+        while (running.load(std::memory_order_relaxed)) {
+            const bool streaming = have_client && runlevel.load() == cbRUNLEVEL_RUNNING;
+            const bool unthrottled = config.speed <= 0;
+            serviceRequests(streaming && unthrottled ? 0 : 1000);
+            if (!have_client || runlevel.load() != cbRUNLEVEL_RUNNING) {
+                if (!unthrottled) resyncStream(deviceNow());
+                continue;
+            }
+            emitUntil(unthrottled ? stream_ns + STEP_NS : deviceNow());
+        }
+        flush();
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// DeviceSimulator
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+DeviceSimulator::DeviceSimulator() = default;
+DeviceSimulator::DeviceSimulator(DeviceSimulator&&) noexcept = default;
+DeviceSimulator& DeviceSimulator::operator=(DeviceSimulator&&) noexcept = default;
+
+DeviceSimulator::~DeviceSimulator() {
+    if (!m_impl) return;
+    stop();
+    if (m_impl->sock != INVALID_SOCKET_VALUE) {
+        closeSocket(m_impl->sock);
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+}
+
+Result<DeviceSimulator> DeviceSimulator::create(const SimulatorConfig& config) {
+    uint32_t total = 0;
+    for (const auto& gs : config.groups) {
+        if (groupRate(gs.group) == 0) {
+            return Result<DeviceSimulator>::error("Invalid sample group " + std::to_string(gs.group) +
+                                                  " (expected 1-6)");
+        }
+        total += gs.channels;
+    }
+    if (total == 0 || total > cbNUM_ANALOG_CHANS) {
+        return Result<DeviceSimulator>::error("Channel count must be 1-" + std::to_string(cbNUM_ANALOG_CHANS) +
+                                              " (got " + std::to_string(total) + ")");
+    }
+    if (config.max_datagram_bytes < cbPKT_MAX_SIZE || config.max_datagram_bytes > cbCER_UDP_SIZE_MAX) {
+        return Result<DeviceSimulator>::error("Datagram size must be " + std::to_string(cbPKT_MAX_SIZE) + "-" +
+                                              std::to_string(cbCER_UDP_SIZE_MAX) + " bytes");
+    }
+    if (config.speed < 0 || config.spike_rate_hz < 0 || config.digital_rate_hz < 0) {
+        return Result<DeviceSimulator>::error("Speed, spike rate and digital rate must not be negative");
+    }
+
+    DeviceSimulator sim;
+    sim.m_impl = std::make_unique<Impl>();
+    auto& impl = *sim.m_impl;
+    impl.config = config;
+    impl.total_channels = total;
+    impl.runlevel = config.initial_runlevel;
+
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        return Result<DeviceSimulator>::error("WSAStartup failed");
+    }
+#endif
+
+    impl.sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (impl.sock == INVALID_SOCKET_VALUE) {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        return Result<DeviceSimulator>::error("Failed to create socket");
+    }
+    int sndbuf = 4 * 1024 * 1024;
+    setsockopt(impl.sock, SOL_SOCKET, SO_SNDBUF, reinterpret_cast<const char*>(&sndbuf), sizeof(sndbuf));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config.port);
+    if (inet_pton(AF_INET, config.address.c_str(), &addr.sin_addr) != 1) {
+        return Result<DeviceSimulator>::error("Invalid bind address: " + config.address);
+    }
+    if (bind(impl.sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        return Result<DeviceSimulator>::error("Failed to bind " + config.address + ":" +
+                                              std::to_string(config.port));
+    }
+    socklen_t len = sizeof(addr);
+    getsockname(impl.sock, reinterpret_cast<sockaddr*>(&addr), &len);
+    impl.port = ntohs(addr.sin_port);
+
+    if (!config.client_address.empty()) {
+        impl.client.sin_family = AF_INET;
+        impl.client.sin_port = htons(config.client_port);
+        if (inet_pton(AF_INET, config.client_address.c_str(), &impl.client.sin_addr) != 1) {
+            return Result<DeviceSimulator>::error("Invalid client address: " + config.client_address);
+        }
+        impl.have_client = true;
+    }
+
+    impl.initModel();
+    return Result<DeviceSimulator>::ok(std::move(sim));
+}
+
+Result<void> DeviceSimulator::start() {
+    if (!m_impl) return Result<void>::error("Simulator not initialized");
+    if (m_impl->running.exchange(true)) return Result<void>::error("Simulator already running");
+    m_impl->thread = std::thread([impl = m_impl.get()] { impl->run(); });
+    return Result<void>::ok();
+}
+
+void DeviceSimulator::stop() {
+    if (!m_impl) return;
+    m_impl->running = false;
+    if (m_impl->thread.joinable()) m_impl->thread.join();
+}
+
+bool DeviceSimulator::isRunning() const {
+    return m_impl && m_impl->running.load();
+}
+
+uint16_t DeviceSimulator::port() const {
+    return m_impl ? m_impl->port : 0;
+}
+
+uint32_t DeviceSimulator::runlevel() const {
+    return m_impl ? m_impl->runlevel.load() : 0;
+}
+
+uint32_t DeviceSimulator::channelCount() const {
+    return m_impl ? m_impl->total_channels : 0;
+}
+
+SimulatorStats DeviceSimulator::stats() const {
+    SimulatorStats s;
+    if (!m_impl) return s;
+    s.datagrams_sent = m_impl->datagrams_sent.load();
+    s.packets_sent = m_impl->packets_sent.load();
+    s.bytes_sent = m_impl->bytes_sent.load();
+    s.group_packets = m_impl->group_packets.load();
+    s.spike_packets = m_impl->spike_packets.load();
+    s.digital_packets = m_impl->digital_packets.load();
+    s.requests_received = m_impl->requests_received.load();
+    s.config_requests = m_impl->config_requests.load();
+    s.clock_probes = m_impl->clock_probes.load();
+    s.send_errors = m_impl->send_errors.load();
+    return s;
+}
+
+} // namespace cbsim
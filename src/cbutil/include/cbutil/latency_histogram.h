@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   latency_histogram.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Fixed-size HDR-style latency histogram
+///
+/// Values are binned log-linearly, as in HdrHistogram: every power-of-two range is split into
+/// SUB_BUCKETS / 2 equal bins, each 1/32 to 1/16 (3.1-6.25%) of the values it holds wide, so a
+/// percentile reads back at most one bin width above its true value, from nanoseconds up to
+/// about 18 minutes.  Storage is a fixed array of relaxed atomics, so one
+/// thread can record while another reads percentiles.  Recording never allocates or locks.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBUTIL_LATENCY_HISTOGRAM_H
+#define CBUTIL_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace cbutil {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @brief Lock-free log-linear histogram of nanosecond values
+///
+/// Intended for one recording thread at a time; readers may run concurrently and see a
+/// slightly stale but self-consistent enough view (counts are read bucket by bucket).
+///
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;                          ///< 2^5 linear bins per magnitude
+    static constexpr uint64_t SUB_BUCKETS = uint64_t{1} << SUB_BUCKET_BITS;
+    static constexpr uint64_t HALF_BUCKETS = SUB_BUCKETS / 2;
+    static constexpr unsigned MAX_VALUE_BITS = 40;                          ///< Values clamp at 2^40 ns (~18 min)
+    static constexpr uint64_t MAX_VALUE = (uint64_t{1} << MAX_VALUE_BITS) - 1;
+    static constexpr size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) * HALF_BUCKETS;
+
+    /// Record one value (values above MAX_VALUE are clamped)
+    void record(uint64_t value_ns) {
+        if (value_ns > MAX_VALUE) value_ns = MAX_VALUE;
+        m_counts[bucketIndex(value_ns)].fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value_ns, std::memory_order_relaxed);
+
+        uint64_t prev = m_max.load(std::memory_order_relaxed);
+        while (value_ns > prev && !m_max.compare_exchange_weak(prev, value_ns, std::memory_order_relaxed)) {}
+        prev = m_min.load(std::memory_order_relaxed);
+        while (value_ns < prev && !m_min.compare_exchange_weak(prev, value_ns, std::memory_order_relaxed)) {}
+    }
+
+    /// @return Number of recorded values
+    [[nodiscard]] uint64_t count() const { return m_total.load(std::memory_order_relaxed); }
+
+    /// @return Smallest recorded value (0 if empty)
+    [[nodiscard]] uint64_t min() const { return count() ? m_min.load(std::memory_order_relaxed) : 0; }
+
+    /// @return Largest recorded value (0 if empty)
+    [[nodiscard]] uint64_t max() const { return m_max.load(std::memory_order_relaxed); }
+
+    /// @return Mean of the recorded values (0 if empty)
+    [[nodiscard]] double mean() const {
+        const uint64_t n = count();
+        return n ? static_cast<double>(m_sum.load(std::memory_order_relaxed)) / static_cast<double>(n) : 0.0;
+    }
+
+    /// Value at or below which @p percentile percent of the recorded values fall
+    /// @param percentile 0-100
+    /// @return Upper edge of the bin holding that rank, capped at max(); 0 if empty
+    [[nodiscard]] uint64_t valueAtPercentile(double percentile) const {
+        const uint64_t n = count();
+        if (n == 0) return 0;
+        if (percentile < 0) percentile = 0;
+        if (percentile > 100) percentile = 100;
+
+        auto rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(n) + 0.5);
+        if (rank == 0) rank = 1;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += m_counts[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                const uint64_t edge = bucketUpperEdge(i);
+                const uint64_t top = max();
+                return edge < top ? edge : top;
+            }
+        }
+        return max();
+    }
+
+    /// Clear all counts
+    void reset() {
+        for (auto& c : m_counts) c.store(0, std::memory_order_relaxed);
+        m_total.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+        m_min.store(UINT64_MAX, std::memory_order_relaxed);
+    }
+
+    /// Bin index of a value (exposed for tests)
+    static size_t bucketIndex(const uint64_t value) {
+        const unsigned magnitude = value < SUB_BUCKETS ? 0 : msb(value) - (SUB_BUCKET_BITS - 1);
+        return static_cast<size_t>(magnitude * HALF_BUCKETS + (value >> magnitude));
+    }
+
+    /// Largest value that falls in bin @p index (exposed for tests)
+    static uint64_t bucketUpperEdge(const size_t index) {
+        if (index < SUB_BUCKETS) return index;
+        const uint64_t magnitude = index / HALF_BUCKETS - 1;
+        const uint64_t sub = index - magnitude * HALF_BUCKETS;
+        return ((sub + 1) << magnitude) - 1;
+    }
+
+private:
+    static unsigned msb(const uint64_t v) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+        unsigned long idx;
+        _BitScanReverse64(&idx, v);
+        return static_cast<unsigned>(idx);
+#elif defined(_MSC_VER)
+        // 32-bit MSVC has no _BitScanReverse64
+        unsigned long idx;
+        if (_BitScanReverse(&idx, static_cast<unsigned long>(v >> 32))) return static_cast<unsigned>(idx) + 32u;
+        _BitScanReverse(&idx, static_cast<unsigned long>(v));
+        return static_cast<unsigned>(idx);
+#else
+        return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#endif
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> m_counts{};
+    std::atomic<uint64_t> m_total{0};
+    std::atomic<uint64_t> m_sum{0};
+    std::atomic<uint64_t> m_max{0};
+    std::atomic<uint64_t> m_min{UINT64_MAX};
+};
+
+} // namespace cbutil
+
+#endif // CBUTIL_LATENCY_HISTOGRAM_H
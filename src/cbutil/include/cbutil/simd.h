@@ -0,0 +1,22 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   simd.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Compile-time SIMD detection shared by the signal processing kernels
+///
+/// Defines CBUTIL_HAVE_SSE2 (and includes <emmintrin.h>) when the target has SSE2: any x86-64
+/// build, or 32-bit x86 built with -msse2 / /arch:SSE2.  Kernels test the macro and keep a
+/// scalar path for every other target.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CBUTIL_SIMD_H
+#define CBUTIL_SIMD_H
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CBUTIL_HAVE_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+#endif // CBUTIL_SIMD_H
@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   bench_cbdev.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  DeviceSession config ingest and ClockSync conversion cost
+///
+/// The config benchmark feeds a synthetic REQCONFIGALL flood straight into
+/// updateConfigFromBuffer() on a loopback DeviceSession, so no device is needed.  The replay
+/// benchmark runs a capture file through the full receive path; set CERELINK_BENCH_CAPTURE to
+/// profile a recording from a real device instead of the synthetic one.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+#include "device_session_impl.h"
+#include <cbdev/capture.h>
+#include <cbdev/clock_sync.h>
+#include <cbdev/device_factory.h>
+#include "synthetic_packets.h"
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace cbdev;
+
+namespace {
+
+std::unique_ptr<DeviceSession> createLoopbackSession() {
+    auto params = ConnectionParams::custom("127.0.0.1", "127.0.0.1", 0, 0);
+    params.recv_buffer_size = 0;
+    auto result = DeviceSession::create(params);
+    if (result.isError()) return nullptr;
+    return std::make_unique<DeviceSession>(std::move(result.value()));
+}
+
+/// Prime a ClockSync with a steady run of symmetric 200 µs probes
+void primeClockSync(ClockSync& sync) {
+    const auto base = ClockSync::clock::now();
+    constexpr uint64_t device_epoch_ns = 5'000'000'000ULL;
+    for (int i = 0; i < 64; ++i) {
+        const auto t1 = base + std::chrono::milliseconds(100 * i);
+        const auto t4 = t1 + std::chrono::microseconds(200);
+        const auto t1_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - base).count();
+        sync.addProbeSample(t1, device_epoch_ns + t1_ns + 100'000, t4);
+    }
+}
+
+/// Path of the capture to replay: $CERELINK_BENCH_CAPTURE, or a synthetic one written once
+/// (config flood followed by ~1 s of 96-channel data in 8 KB datagrams)
+std::string replayCapturePath() {
+    if (const char* env = std::getenv("CERELINK_BENCH_CAPTURE")) {
+        return env;
+    }
+    static const std::string synthetic = [] {
+        const auto path = (std::filesystem::temp_directory_path() / "cerelink_bench.cbcap").string();
+        auto writer = CaptureWriter::open(path, ProtocolVersion::PROTOCOL_CURRENT);
+        if (writer.isError()) return std::string();
+        const auto now = std::chrono::steady_clock::now();
+        const auto flood = bench::makeConfigFlood();
+        for (size_t off = 0; off < flood.size(); off += cbCER_UDP_SIZE_MAX) {
+            const size_t n = std::min<size_t>(cbCER_UDP_SIZE_MAX, flood.size() - off);
+            writer.value().write(now, flood.data() + off, n);
+        }
+        std::vector<uint8_t> dgram;
+        for (const auto& pkt : bench::makeDataStream(37'500)) {
+            if (dgram.size() + cbPKT_HEADER_SIZE + pkt.cbpkt_header.dlen * 4 > 8192) {
+                writer.value().write(now, dgram.data(), dgram.size());
+                dgram.clear();
+            }
+            bench::appendPacket(dgram, pkt);
+        }
+        writer.value().write(now, dgram.data(), dgram.size());
+        writer.value().close();
+        return path;
+    }();
+    return synthetic;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Capture Replay
+/// @{
+
+/// Whole capture through createDeviceSession() replay + receivePackets(), as fast as possible
+static void BM_DeviceSession_ReplayCapture(benchmark::State& state) {
+    ConnectionParams params = ConnectionParams::forDevice(DeviceType::NSP);
+    params.replay_path = replayCapturePath();
+    params.replay_speed = 0;
+    if (params.replay_path.empty()) {
+        state.SkipWithError("Cannot write synthetic capture");
+        return;
+    }
+
+    uint8_t buffer[cbCER_UDP_SIZE_MAX];
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto result = createDeviceSession(params);
+        if (result.isError()) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        auto session = std::move(result.value());
+        state.ResumeTiming();
+
+        while (!session->isReplayFinished()) {
+            auto r = session->receivePackets(buffer, sizeof(buffer));
+            if (r.isOk()) bytes += r.value();
+        }
+    }
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(BM_DeviceSession_ReplayCapture)->Unit(benchmark::kMillisecond);
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Configuration Ingest
+/// @{
+
+/// One REQCONFIGALL reply flood (range(0) channels) through updateConfigFromBuffer()
+static void BM_DeviceSession_ConfigFlood(benchmark::State& state) {
+    auto session = createLoopbackSession();
+    if (!session) {
+        state.SkipWithError("Cannot create loopback device session");
+        return;
+    }
+    const auto nchans = static_cast<uint32_t>(state.range(0));
+    const auto flood = bench::makeConfigFlood(nchans);
+
+    for (auto _ : state) {
+        session->updateConfigFromBuffer(flood.data(), flood.size());
+    }
+    state.SetItemsProcessed(state.iterations() * (nchans + 3));
+    state.SetBytesProcessed(state.iterations() * flood.size());
+}
+BENCHMARK(BM_DeviceSession_ConfigFlood)->Arg(32)->Arg(cbMAXCHANS);
+
+/// Same flood with range(0) outstanding typed response waiters that never match
+static void BM_DeviceSession_ConfigFloodWithWaiters(benchmark::State& state) {
+    auto session = createLoopbackSession();
+    if (!session) {
+        state.SkipWithError("Cannot create loopback device session");
+        return;
+    }
+    std::vector<DeviceSession::ResponseWaiter> waiters;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        waiters.push_back(session->registerResponseWaiter(
+            {cbPKTTYPE_CHANREPSPKTHR},
+            [](const cbPKT_HEADER* hdr) { return hdr->type == cbPKTTYPE_CHANREPSPKTHR; }));
+    }
+    const auto flood = bench::makeConfigFlood();
+
+    for (auto _ : state) {
+        session->updateConfigFromBuffer(flood.data(), flood.size());
+    }
+    state.SetItemsProcessed(state.iterations() * (cbMAXCHANS + 3));
+}
+BENCHMARK(BM_DeviceSession_ConfigFloodWithWaiters)->Arg(1)->Arg(100);
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Clock Conversion
+/// @{
+
+static void BM_ClockSync_ToLocalTime(benchmark::State& state) {
+    ClockSync sync;
+    primeClockSync(sync);
+    uint64_t device_ns = 6'000'000'000ULL;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sync.toLocalTime(device_ns));
+        device_ns += bench::SAMPLE_NS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ClockSync_ToLocalTime);
+
+static void BM_ClockSync_ToDeviceTime(benchmark::State& state) {
+    ClockSync sync;
+    primeClockSync(sync);
+    auto local = ClockSync::clock::now();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sync.toDeviceTime(local));
+        local += std::chrono::nanoseconds(bench::SAMPLE_NS);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ClockSync_ToDeviceTime);
+
+static void BM_ClockSync_AddProbeSample(benchmark::State& state) {
+    ClockSync sync;
+    const auto base = ClockSync::clock::now();
+    int64_t i = 0;
+    for (auto _ : state) {
+        const auto t1 = base + std::chrono::milliseconds(100 * i);
+        const auto t1_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - base).count();
+        sync.addProbeSample(t1, 5'000'000'000ULL + t1_ns + 100'000, t1 + std::chrono::microseconds(200));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ClockSync_AddProbeSample);
+
+/// @}
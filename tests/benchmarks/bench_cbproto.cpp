@@ -0,0 +1,190 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   bench_cbproto.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  PacketTranslator throughput per protocol version
+///
+/// Each inbound benchmark walks a legacy-format datagram exactly as the DeviceSession_3xx
+/// receive loops do (header copy-convert, then translatePayload_*_to_current).  The legacy
+/// datagrams are produced from the same fixed-seed stream via the outbound translators,
+/// which are benchmarked in turn.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+#include <cbproto/packet_translator.h>
+#include "synthetic_packets.h"
+#include <vector>
+
+using namespace cbproto;
+
+namespace {
+
+constexpr size_t kStreamPackets = 256;
+
+/// Current-format stream plus one CHANREP, so a config translation is in every pass
+std::vector<cbPKT_GENERIC> makeMixedStream() {
+    auto packets = bench::makeDataStream(kStreamPackets);
+    std::mt19937 rng(bench::SEED);
+    packets.push_back(bench::makeChanRep(rng, 1));
+    return packets;
+}
+
+/// Encode a current-format stream as one protocol 3.11 byte stream
+std::vector<uint8_t> encode311(const std::vector<cbPKT_GENERIC>& packets) {
+    std::vector<uint8_t> out;
+    uint8_t buf[cbPKT_MAX_SIZE];
+    for (const auto& pkt : packets) {
+        auto& hdr = *reinterpret_cast<cbPKT_HEADER_311*>(buf);
+        hdr.time = static_cast<uint32_t>(pkt.cbpkt_header.time * 30000 / 1000000000);
+        hdr.chid = pkt.cbpkt_header.chid;
+        hdr.type = static_cast<uint8_t>(pkt.cbpkt_header.type);
+        hdr.dlen = static_cast<uint8_t>(PacketTranslator::translatePayload_current_to_311(pkt, buf));
+        out.insert(out.end(), buf, buf + HEADER_SIZE_311 + hdr.dlen * 4);
+    }
+    return out;
+}
+
+/// Encode a current-format stream as one protocol 4.0 byte stream
+std::vector<uint8_t> encode400(const std::vector<cbPKT_GENERIC>& packets) {
+    std::vector<uint8_t> out;
+    uint8_t buf[cbPKT_MAX_SIZE];
+    for (const auto& pkt : packets) {
+        auto& hdr = *reinterpret_cast<cbPKT_HEADER_400*>(buf);
+        hdr = {};
+        hdr.time = pkt.cbpkt_header.time;
+        hdr.chid = pkt.cbpkt_header.chid;
+        hdr.type = static_cast<uint8_t>(pkt.cbpkt_header.type);
+        hdr.dlen = pkt.cbpkt_header.dlen;
+        hdr.dlen = static_cast<uint16_t>(PacketTranslator::translatePayload_current_to_400(pkt, buf));
+        out.insert(out.end(), buf, buf + HEADER_SIZE_400 + hdr.dlen * 4);
+    }
+    return out;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Inbound (device → current)
+/// @{
+
+static void BM_Translate_311_to_current(benchmark::State& state) {
+    const auto src = encode311(makeMixedStream());
+    std::vector<uint8_t> dest(src.size() * 2 + cbPKT_MAX_SIZE);
+
+    for (auto _ : state) {
+        size_t s = 0, d = 0;
+        while (s + HEADER_SIZE_311 <= src.size()) {
+            const auto& sh = *reinterpret_cast<const cbPKT_HEADER_311*>(&src[s]);
+            auto& dh = *reinterpret_cast<cbPKT_HEADER*>(&dest[d]);
+            dh.time = static_cast<PROCTIME>(sh.time) * 1000000000 / 30000;
+            dh.chid = sh.chid;
+            dh.type = sh.type;
+            dh.dlen = sh.dlen;
+            dh.dlen = static_cast<uint16_t>(
+                PacketTranslator::translatePayload_311_to_current(&src[s], &dest[d]));
+            s += HEADER_SIZE_311 + sh.dlen * 4;
+            d += cbPKT_HEADER_SIZE + dh.dlen * 4;
+        }
+        benchmark::DoNotOptimize(dest.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (kStreamPackets + 1));
+    state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_Translate_311_to_current);
+
+static void BM_Translate_400_to_current(benchmark::State& state) {
+    const auto src = encode400(makeMixedStream());
+    std::vector<uint8_t> dest(src.size() * 2 + cbPKT_MAX_SIZE);
+
+    for (auto _ : state) {
+        size_t s = 0, d = 0;
+        while (s + HEADER_SIZE_400 <= src.size()) {
+            const auto& sh = *reinterpret_cast<const cbPKT_HEADER_400*>(&src[s]);
+            auto& dh = *reinterpret_cast<cbPKT_HEADER*>(&dest[d]);
+            dh.time = sh.time;
+            dh.chid = sh.chid;
+            dh.type = sh.type;
+            dh.dlen = sh.dlen;
+            dh.instrument = sh.instrument;
+            dh.dlen = static_cast<uint16_t>(
+                PacketTranslator::translatePayload_400_to_current(&src[s], &dest[d]));
+            s += HEADER_SIZE_400 + sh.dlen * 4;
+            d += cbPKT_HEADER_SIZE + dh.dlen * 4;
+        }
+        benchmark::DoNotOptimize(dest.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (kStreamPackets + 1));
+    state.SetBytesProcessed(state.iterations() * src.size());
+}
+BENCHMARK(BM_Translate_400_to_current);
+
+static void BM_Translate_410_to_current(benchmark::State& state) {
+    // 4.1 translates in place; re-copy the pristine datagram each pass
+    std::vector<uint8_t> pristine;
+    for (const auto& pkt : makeMixedStream()) bench::appendPacket(pristine, pkt);
+    std::vector<uint8_t> buf(pristine.size());
+
+    for (auto _ : state) {
+        std::memcpy(buf.data(), pristine.data(), pristine.size());
+        size_t off = 0;
+        while (off + cbPKT_HEADER_SIZE <= buf.size()) {
+            auto& hdr = *reinterpret_cast<cbPKT_HEADER*>(&buf[off]);
+            hdr.dlen = static_cast<uint16_t>(
+                PacketTranslator::translatePayload_410_to_current(&buf[off], &buf[off]));
+            off += cbPKT_HEADER_SIZE + hdr.dlen * 4;
+        }
+        benchmark::DoNotOptimize(buf.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * (kStreamPackets + 1));
+    state.SetBytesProcessed(state.iterations() * pristine.size());
+}
+BENCHMARK(BM_Translate_410_to_current);
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Outbound (current → device)
+/// @{
+
+static void BM_Translate_current_to_311(benchmark::State& state) {
+    const auto packets = makeMixedStream();
+    uint8_t dest[cbPKT_MAX_SIZE];
+    for (auto _ : state) {
+        for (const auto& pkt : packets) {
+            benchmark::DoNotOptimize(PacketTranslator::translatePayload_current_to_311(pkt, dest));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * packets.size());
+}
+BENCHMARK(BM_Translate_current_to_311);
+
+static void BM_Translate_current_to_400(benchmark::State& state) {
+    const auto packets = makeMixedStream();
+    uint8_t dest[cbPKT_MAX_SIZE];
+    for (auto _ : state) {
+        for (const auto& pkt : packets) {
+            benchmark::DoNotOptimize(PacketTranslator::translatePayload_current_to_400(pkt, dest));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * packets.size());
+}
+BENCHMARK(BM_Translate_current_to_400);
+
+static void BM_Translate_current_to_410(benchmark::State& state) {
+    const auto packets = makeMixedStream();
+    uint8_t dest[cbPKT_MAX_SIZE];
+    for (auto _ : state) {
+        for (const auto& pkt : packets) {
+            benchmark::DoNotOptimize(PacketTranslator::translatePayload_current_to_410(pkt, dest));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * packets.size());
+}
+BENCHMARK(BM_Translate_current_to_410);
+
+/// @}
@@ -0,0 +1,883 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   bench_cbsdk.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  SPSCQueue, SdkSession callback-dispatch, local recorder, continuous codec, host
+///         filter, resampler, re-referencing, spike detection, spike binning, band power,
+///         epoch extraction, digital input tracking, spike sorting and batch layout throughput
+///
+/// Dispatch is measured end to end on a STANDALONE SdkSession talking to a minimal
+/// loopback "device" that answers the startup handshake and then streams fixed-seed group
+/// datagrams.  Each iteration sends a burst and waits until the callback thread has
+/// dispatched all of it, so the number includes UDP receive, shmem store and the queue hop
+/// as well as dispatchBatch() itself; the callback-count sweep isolates the dispatch share.
+/// The batch policy benchmark sends the same bursts to one whole-group batch callback and
+/// compares delivery as drained with BatchPolicy blocks of 1, 64 and 256 samples.
+///
+/// The recorder benchmark writes one second of 256-channel 30 kHz data plus spikes to real
+/// NSx/NEV files per iteration and waits for the writer thread to drain, so it reports the
+/// sustained disk rate; "realtime" above 1 means the recorder keeps up with the device.
+///
+/// The codec benchmarks encode and decode 4096-row chunks of synthetic broadband neural data
+/// (bench::makeNeuralFrames) and uniform noise, reporting MB/s of raw int16 input and the
+/// compression "ratio" (raw / encoded bytes).
+///
+/// The filter benchmark runs a 4th-order band-pass plus notch (5 biquads) over 30-sample
+/// batches, the size dispatchBatch() delivers, and reports "realtime" as 30 kHz samples per
+/// second of CPU time over 30000.  The resampler benchmark does the same for 30 kHz -> 1 kHz
+/// decimation (a 601-tap polyphase FIR), and the re-referencing benchmark for a common
+/// average (mean) and a common median over every channel, and the spike detection benchmark
+/// for threshold crossings at -4.5 x RMS with 48-sample waveforms on pre-filtered data.
+///
+/// The spike binning benchmark feeds 20 ms bins of a 272 x 6 matrix with Poisson spikes at
+/// the given rate per channel, one millisecond of device time per iteration, advancing and
+/// taking closed bins each time as dispatchBatch() does.
+///
+/// The band power benchmark measures beta and high-gamma power either from 1 kHz LFP (256-sample
+/// window, a vector every 10 samples) or from the 30 kHz raw group (2048-sample window, a vector
+/// every 300 samples), reporting "realtime" at the input rate.
+///
+/// The epoch benchmark keeps the history of a 256-channel 30 kHz group in 30-sample batches
+/// and cuts a 10 ms + 20 ms window around events at the given rate per second.
+///
+/// The digital input benchmark is one poll of a task controller: 32 input packets logged,
+/// read back from a cursor, and the word of one channel looked up at 16 recent times.
+///
+/// The spike sorting benchmark classifies a burst of 48-sample waveforms spread over 256
+/// modelled channels (three units and a noise boundary each), inline or with worker threads.
+///
+/// The batch layout benchmark converts 30-sample batches of a 256-channel group to channel-major
+/// int16, channel-major µV and sample-major µV, against a naive per-element transpose and scale.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <benchmark/benchmark.h>
+#include <cbsdk/sdk_session.h>
+#include <cbsdk/recorder.h>
+#include <cbsdk/continuous_codec.h>
+#include <cbsdk/filter_bank.h>
+#include <cbsdk/resampler.h>
+#include <cbsdk/rereference.h>
+#include <cbsdk/spike_detector.h>
+#include <cbsdk/spike_binner.h>
+#include <cbsdk/band_power.h>
+#include <cbsdk/epoch_extractor.h>
+#include <cbsdk/digital_input_tracker.h>
+#include <cbsdk/spike_sorter.h>
+#include <cbsdk/sample_layout.h>
+#include "synthetic_packets.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+using socket_t = SOCKET;
+static void closeSocket(socket_t s) { closesocket(s); }
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+using socket_t = int;
+static constexpr socket_t INVALID_SOCKET = -1;
+static void closeSocket(socket_t s) { close(s); }
+#endif
+
+using namespace cbsdk;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name SPSCQueue
+/// @{
+
+/// Single-threaded push/pop round trip (the uncontended cost per packet)
+static void BM_SPSCQueue_PushPop(benchmark::State& state) {
+    static SPSCQueue<cbPKT_GENERIC, 16384> queue;
+    const auto burst = static_cast<size_t>(state.range(0));
+    const auto packets = bench::makeDataStream(burst);
+    cbPKT_GENERIC out;
+
+    for (auto _ : state) {
+        for (const auto& pkt : packets) queue.push(pkt);
+        for (size_t i = 0; i < burst; ++i) queue.pop(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+BENCHMARK(BM_SPSCQueue_PushPop)->Arg(1)->Arg(32)->Arg(1024);
+
+/// Producer thread pushing while the benchmark thread pops (the receive → callback hop)
+static void BM_SPSCQueue_ProducerConsumer(benchmark::State& state) {
+    static SPSCQueue<cbPKT_GENERIC, 16384> queue;
+    constexpr size_t kPerIteration = 4096;
+    const auto packets = bench::makeDataStream(256);
+    cbPKT_GENERIC out;
+
+    for (auto _ : state) {
+        std::thread producer([&] {
+            for (size_t i = 0; i < kPerIteration; ++i) {
+                while (!queue.push(packets[i % packets.size()])) std::this_thread::yield();
+            }
+        });
+        size_t popped = 0;
+        while (popped < kPerIteration) {
+            if (queue.pop(out)) ++popped;
+        }
+        producer.join();
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * kPerIteration);
+}
+BENCHMARK(BM_SPSCQueue_ProducerConsumer)->UseRealTime();
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Callback Dispatch
+/// @{
+
+namespace {
+
+/// Just enough of a device for SdkSession::create(): replies to runlevel requests (protocol
+/// detection) and REQCONFIGALL (config request), and can stream datagrams to the client.
+/// With @p group_chans, the config reply puts channels 1..group_chans in the 30 kHz group so
+/// batch callbacks can resolve it.
+class LoopbackDevice {
+public:
+    explicit LoopbackDevice(const uint32_t group_chans = 0) : m_group_chans(group_chans) {
+#ifdef _WIN32
+        WSADATA wsa;
+        WSAStartup(MAKEWORD(2, 2), &wsa);
+#endif
+        m_sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (m_sock == INVALID_SOCKET) return;
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t len = sizeof(addr);
+        if (bind(m_sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            getsockname(m_sock, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+            closeSocket(m_sock);
+            m_sock = INVALID_SOCKET;
+            return;
+        }
+        m_port = ntohs(addr.sin_port);
+#ifdef _WIN32
+        DWORD timeout = 50;
+#else
+        timeval timeout = {0, 50000};
+#endif
+        setsockopt(m_sock, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+        m_running = true;
+        m_thread = std::thread([this] { serve(); });
+    }
+
+    ~LoopbackDevice() {
+        m_running = false;
+        if (m_thread.joinable()) m_thread.join();
+        if (m_sock != INVALID_SOCKET) closeSocket(m_sock);
+    }
+
+    bool ok() const { return m_sock != INVALID_SOCKET; }
+    uint16_t port() const { return m_port; }
+
+    /// Send one datagram to the most recent client
+    void send(const std::vector<uint8_t>& datagram) {
+        const sockaddr_in client = m_client;
+        sendto(m_sock, reinterpret_cast<const char*>(datagram.data()), static_cast<int>(datagram.size()), 0,
+               reinterpret_cast<const sockaddr*>(&client), sizeof(client));
+    }
+
+private:
+    void serve() {
+        std::vector<uint8_t> buf(cbCER_UDP_SIZE_MAX);
+        while (m_running) {
+            sockaddr_in from = {};
+            socklen_t len = sizeof(from);
+            const auto n = recvfrom(m_sock, reinterpret_cast<char*>(buf.data()), static_cast<int>(buf.size()), 0,
+                                    reinterpret_cast<sockaddr*>(&from), &len);
+            if (n < static_cast<std::remove_cv_t<decltype(n)>>(cbPKT_HEADER_SIZE)) continue;
+            m_client = from;
+
+            const auto& hdr = *reinterpret_cast<const cbPKT_HEADER*>(buf.data());
+            if (hdr.chid != cbPKTCHAN_CONFIGURATION) continue;
+            std::vector<uint8_t> reply;
+            cbPKT_GENERIC pkt = {};
+            pkt.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+            if (hdr.type == cbPKTTYPE_SYSSETRUNLEV) {
+                pkt.cbpkt_header.type = cbPKTTYPE_SYSREPRUNLEV;
+                pkt.cbpkt_header.dlen = cbPKTDLEN_SYSINFO;
+                reinterpret_cast<cbPKT_SYSINFO&>(pkt).runlevel = cbRUNLEVEL_RUNNING;
+                bench::appendPacket(reply, pkt);
+            } else if (hdr.type == cbPKTTYPE_REQCONFIGALL) {
+                pkt.cbpkt_header.type = cbPKTTYPE_PROCREP;
+                pkt.cbpkt_header.dlen = cbPKTDLEN_PROCINFO;
+                reinterpret_cast<cbPKT_PROCINFO&>(pkt).version = (cbVERSION_MAJOR << 16) | cbVERSION_MINOR;
+                bench::appendPacket(reply, pkt);
+                for (uint32_t chan = 1; chan <= m_group_chans; ++chan) {
+                    if (reply.size() + sizeof(cbPKT_CHANINFO) > cbCER_UDP_SIZE_MAX) {
+                        sendto(m_sock, reinterpret_cast<const char*>(reply.data()), static_cast<int>(reply.size()),
+                               0, reinterpret_cast<const sockaddr*>(&from), len);
+                        reply.clear();
+                    }
+                    cbPKT_CHANINFO ci = {};
+                    ci.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+                    ci.cbpkt_header.type = cbPKTTYPE_CHANREP;
+                    ci.cbpkt_header.dlen = cbPKTDLEN_CHANINFO;
+                    ci.chan = chan;
+                    ci.smpgroup = 5;
+                    bench::appendPacket(reply, reinterpret_cast<const cbPKT_GENERIC&>(ci));
+                }
+                pkt = {};
+                pkt.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+                pkt.cbpkt_header.type = cbPKTTYPE_SYSREP;
+                pkt.cbpkt_header.dlen = cbPKTDLEN_SYSINFO;
+                reinterpret_cast<cbPKT_SYSINFO&>(pkt).runlevel = cbRUNLEVEL_RUNNING;
+                bench::appendPacket(reply, pkt);
+            } else {
+                continue;
+            }
+            sendto(m_sock, reinterpret_cast<const char*>(reply.data()), static_cast<int>(reply.size()), 0,
+                   reinterpret_cast<const sockaddr*>(&from), len);
+        }
+    }
+
+    const uint32_t m_group_chans;
+    socket_t m_sock = INVALID_SOCKET;
+    uint16_t m_port = 0;
+    std::atomic<bool> m_running{false};
+    sockaddr_in m_client = {};
+    std::thread m_thread;
+};
+
+} // namespace
+
+/// Burst of 8 datagrams × 32 group packets (96 channels) dispatched to range(0) group callbacks
+static void BM_SdkSession_DispatchGroupCallbacks(benchmark::State& state) {
+    LoopbackDevice device;
+    if (!device.ok()) {
+        state.SkipWithError("Cannot bind loopback device socket");
+        return;
+    }
+    SdkConfig config;
+    config.autorun = false;
+    config.custom_device_address = "127.0.0.1";
+    config.custom_client_address = "127.0.0.1";
+    config.custom_device_port = device.port();
+    config.custom_client_port = 0;
+    config.recv_buffer_size = 0;  // Loopback bursts are small; don't depend on rmem_max
+    auto result = SdkSession::create(config);
+    if (result.isError()) {
+        state.SkipWithError(("Cannot create loopback session: " + result.error()).c_str());
+        return;
+    }
+    auto session = std::make_unique<SdkSession>(std::move(result.value()));
+    if (!session->isStandalone()) {
+        state.SkipWithError("Another session owns the shared memory; run without Central/CereLink");
+        return;
+    }
+
+    std::atomic<uint64_t> seen{0};
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        session->registerGroupCallback(SampleRate::SR_30kHz, [&seen](const cbPKT_GROUP&) {
+            seen.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    // Always count delivery, even with zero group callbacks
+    std::atomic<uint64_t> delivered{0};
+    session->registerPacketCallback([&delivered](const cbPKT_GENERIC&) {
+        delivered.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    constexpr size_t kDatagrams = 8;
+    constexpr size_t kPerDatagram = 32;
+    std::mt19937 rng(bench::SEED);
+    std::vector<std::vector<uint8_t>> datagrams(kDatagrams);
+    uint64_t time = 1'000'000'000;
+    for (auto& dg : datagrams) {
+        for (size_t i = 0; i < kPerDatagram; ++i, time += bench::SAMPLE_NS) {
+            bench::appendPacket(dg, bench::makeGroupPacket(rng, time, 5, 96));
+        }
+    }
+
+    uint64_t expected = delivered.load();
+    for (auto _ : state) {
+        for (const auto& dg : datagrams) device.send(dg);
+        expected += kDatagrams * kPerDatagram;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (delivered.load(std::memory_order_relaxed) < expected) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                state.SkipWithError("Timed out waiting for dispatch (packets dropped?)");
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kDatagrams * kPerDatagram);
+    state.counters["group_callbacks"] = static_cast<double>(state.range(0));
+}
+BENCHMARK(BM_SdkSession_DispatchGroupCallbacks)->Arg(0)->Arg(1)->Arg(8)->Arg(32)->UseRealTime();
+
+/// The same bursts through one batch callback on the whole 96-channel group, delivered as
+/// drained (range(0) = 0) or re-cut by a BatchPolicy into blocks of exactly range(0) samples
+static void BM_SdkSession_BatchPolicy(benchmark::State& state) {
+    constexpr uint32_t kChans = 96;
+    LoopbackDevice device(kChans);
+    if (!device.ok()) {
+        state.SkipWithError("Cannot bind loopback device socket");
+        return;
+    }
+    SdkConfig config;
+    config.autorun = false;
+    config.custom_device_address = "127.0.0.1";
+    config.custom_client_address = "127.0.0.1";
+    config.custom_device_port = device.port();
+    config.custom_client_port = 0;
+    config.recv_buffer_size = 0;
+    auto result = SdkSession::create(config);
+    if (result.isError()) {
+        state.SkipWithError(("Cannot create loopback session: " + result.error()).c_str());
+        return;
+    }
+    auto session = std::make_unique<SdkSession>(std::move(result.value()));
+    if (!session->isStandalone()) {
+        state.SkipWithError("Another session owns the shared memory; run without Central/CereLink");
+        return;
+    }
+
+    std::atomic<uint64_t> rows{0}, calls{0};
+    const auto count = [&rows, &calls](const int16_t*, size_t n, size_t, const uint64_t*) {
+        rows.fetch_add(n, std::memory_order_relaxed);
+        calls.fetch_add(1, std::memory_order_relaxed);
+    };
+    const auto block = static_cast<size_t>(state.range(0));
+    if (block == 0) {
+        session->registerGroupBatchCallback(SampleRate::SR_30kHz, count);
+    } else {
+        GroupBatchFormat format;
+        format.policy = {block, block, 0};
+        auto handle = session->registerFormattedGroupBatchCallback(SampleRate::SR_30kHz, format, count);
+        if (handle.isError()) {
+            state.SkipWithError(("Cannot register batch callback: " + handle.error()).c_str());
+            return;
+        }
+    }
+
+    // A whole number of blocks per burst, so nothing is left buffered between iterations
+    constexpr size_t kDatagrams = 8;
+    constexpr size_t kPerDatagram = 32;
+    std::mt19937 rng(bench::SEED);
+    std::vector<std::vector<uint8_t>> datagrams(kDatagrams);
+    uint64_t time = 1'000'000'000;
+    for (auto& dg : datagrams) {
+        for (size_t i = 0; i < kPerDatagram; ++i, time += bench::SAMPLE_NS) {
+            bench::appendPacket(dg, bench::makeGroupPacket(rng, time, 5, kChans));
+        }
+    }
+
+    uint64_t expected = rows.load();
+    const uint64_t first_call = calls.load();
+    for (auto _ : state) {
+        for (const auto& dg : datagrams) device.send(dg);
+        expected += kDatagrams * kPerDatagram;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (rows.load(std::memory_order_relaxed) < expected) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                state.SkipWithError("Timed out waiting for dispatch (packets dropped?)");
+                break;
+            }
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kDatagrams * kPerDatagram);
+    state.counters["calls_per_burst"] = benchmark::Counter(static_cast<double>(calls.load() - first_call),
+                                                           benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SdkSession_BatchPolicy)->ArgName("block")->Arg(0)->Arg(1)->Arg(64)->Arg(256)->UseRealTime();
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Local Recording
+/// @{
+
+/// One second of 256-channel 30 kHz group data plus spikes, recorded in 32-packet batches
+/// (the callback thread's batch size) with direct I/O off (0) or on (1)
+static void BM_Recorder_SustainedWrite(benchmark::State& state) {
+    constexpr uint32_t nchans = 256;
+    static const auto stream = [] {
+        // makeDataStream() adds a spike after roughly every fourth sample
+        return bench::makeDataStream(30000 * 5 / 4, nchans);
+    }();
+
+    RecordingLayout layout;
+    RecordingGroup group;
+    group.group_id = 5;
+    for (uint32_t chan = 1; chan <= nchans; ++chan) {
+        RecordingChannel ch;
+        ch.info.chan = chan;
+        ch.info.chancaps = cbCHAN_EXISTS | cbCHAN_CONNECTED | cbCHAN_AINP | cbCHAN_ISOLATED;
+        ch.info.scalin = {-32764, 32764, -8191, 8191, 1, "uV"};
+        group.channels.push_back(ch);
+        layout.event_channels.push_back(ch);
+    }
+    layout.groups.push_back(group);
+
+    RecordingOptions options;
+    options.direct_io = state.range(0) != 0;
+    const auto base = (std::filesystem::temp_directory_path() / "cerelink_bench_recording").string();
+
+    uint64_t samples = 0;
+    uint64_t bytes = 0;
+    uint64_t dropped = 0;
+    bool direct = false;
+    for (auto _ : state) {
+        auto result = Recorder::open(base, layout, options);
+        if (result.isError()) {
+            state.SkipWithError(result.error().c_str());
+            return;
+        }
+        auto& recorder = result.value();
+        for (size_t i = 0; i < stream.size(); i += 32) {
+            recorder.write(&stream[i], std::min<size_t>(32, stream.size() - i));
+        }
+        recorder.close();
+
+        const auto stats = recorder.stats();
+        samples += stats.continuous_packets;
+        bytes += stats.bytes_written;
+        dropped += stats.packets_dropped;
+        direct = stats.direct_io;
+    }
+    std::remove((base + ".nev").c_str());
+    std::remove((base + ".ns5").c_str());
+
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+    state.SetItemsProcessed(static_cast<int64_t>(samples));
+    state.counters["realtime"] = benchmark::Counter(static_cast<double>(samples) / 30000.0,
+                                                    benchmark::Counter::kIsRate);
+    state.counters["dropped"] = static_cast<double>(dropped);
+    state.counters["direct_io"] = direct ? 1 : 0;
+}
+BENCHMARK(BM_Recorder_SustainedWrite)->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Continuous Codec
+/// @{
+
+namespace {
+
+constexpr uint32_t kCodecRows = cbsdk::ContinuousEncoder::DEFAULT_CHUNK_SAMPLES;
+
+/// Arg 0: channels; arg 1: 0 = synthetic neural data, 1 = uniform noise (incompressible-ish)
+std::vector<int16_t> codecInput(const benchmark::State& state) {
+    const auto nchans = static_cast<uint32_t>(state.range(0));
+    if (state.range(1) == 0) {
+        return bench::makeNeuralFrames(kCodecRows, nchans);
+    }
+    std::mt19937 rng(bench::SEED);
+    std::uniform_int_distribution<int> sample(-2000, 2000);
+    std::vector<int16_t> frames(size_t{kCodecRows} * nchans);
+    for (auto& v : frames) {
+        v = static_cast<int16_t>(sample(rng));
+    }
+    return frames;
+}
+
+std::vector<uint64_t> codecTimestamps() {
+    std::vector<uint64_t> ts(kCodecRows);
+    for (uint32_t i = 0; i < kCodecRows; ++i) {
+        ts[i] = 1'000'000'000 + uint64_t{i} * 1'000'000'000 / 30000;     // 33333/33334 ns jitter
+    }
+    return ts;
+}
+
+} // namespace
+
+static void BM_ContinuousCodec_Encode(benchmark::State& state) {
+    const auto nchans = static_cast<uint32_t>(state.range(0));
+    const auto frames = codecInput(state);
+    const auto ts = codecTimestamps();
+    std::vector<uint8_t> out;
+    out.reserve(frames.size() * sizeof(int16_t) * 2);
+    for (auto _ : state) {
+        out.clear();
+        cbsdk::encodeContinuousChunk(frames.data(), ts.data(), kCodecRows, nchans, 0, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    const double raw = static_cast<double>(frames.size() * sizeof(int16_t));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw));
+    state.counters["ratio"] = raw / static_cast<double>(out.size());
+}
+BENCHMARK(BM_ContinuousCodec_Encode)->Args({256, 0})->Args({256, 1})->Args({32, 0})->Unit(benchmark::kMicrosecond);
+
+static void BM_ContinuousCodec_Decode(benchmark::State& state) {
+    const auto nchans = static_cast<uint32_t>(state.range(0));
+    const auto frames = codecInput(state);
+    const auto ts = codecTimestamps();
+    std::vector<uint8_t> chunk;
+    cbsdk::encodeContinuousChunk(frames.data(), ts.data(), kCodecRows, nchans, 0, chunk);
+    std::vector<int16_t> decoded(frames.size());
+    std::vector<uint64_t> decoded_ts(kCodecRows);
+    for (auto _ : state) {
+        auto r = cbsdk::decodeContinuousChunk(chunk.data(), chunk.size(), nchans, decoded.data(), decoded_ts.data());
+        if (r.isError() || decoded != frames) {
+            state.SkipWithError("Round trip mismatch");
+            break;
+        }
+    }
+    const double raw = static_cast<double>(frames.size() * sizeof(int16_t));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * raw));
+    state.counters["ratio"] = raw / static_cast<double>(chunk.size());
+}
+BENCHMARK(BM_ContinuousCodec_Decode)->Args({256, 0})->Args({256, 1})->Args({32, 0})->Unit(benchmark::kMicrosecond);
+
+/// @}
+
+/// @name Host Filter Bank
+/// @{
+
+static void BM_BiquadFilterBank(benchmark::State& state) {
+    const auto nchans = static_cast<uint32_t>(state.range(0));
+    constexpr size_t kBatch = 30;
+    constexpr size_t kRows = 30000;
+    const auto frames = bench::makeNeuralFrames(kRows, nchans);
+    cbsdk::FilterSpec spec;
+    spec.hpfreq = 250000;
+    spec.hporder = 2;
+    spec.lpfreq = 5000000;
+    spec.lporder = 2;
+    spec.notch_freq = 60000;
+    auto sections = cbsdk::designFilter(spec, 30000.0);
+    auto bank = cbsdk::BiquadFilterBank::create(sections.value(), nchans);
+    std::vector<int16_t> out(kBatch * nchans);
+    size_t row = 0;
+    for (auto _ : state) {
+        bank.value().process(&frames[row * nchans], kBatch, out.data());
+        benchmark::DoNotOptimize(out.data());
+        row = (row + kBatch) % kRows;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatch));
+    state.counters["realtime"] = benchmark::Counter(static_cast<double>(state.iterations() * kBatch) / 30000.0,
+                                                    benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_BiquadFilterBank)->Arg(256)->Arg(32)->Unit(benchmark::kMicrosecond);
+
+static void BM_PolyphaseResampler(benchmark::State& state) {
+    const auto nchans = static_cast<uint32_t>(state.range(0));
+    constexpr size_t kBatch = 30;
+    constexpr size_t kRows = 30000;
+    const auto frames = bench::makeNeuralFrames(kRows, nchans);
+    std::vector<uint64_t> ts(kRows);
+    for (size_t i = 0; i < kRows; ++i) {
+        ts[i] = i * 33333;
+    }
+    auto resampler = cbsdk::PolyphaseResampler::create(1, 30, nchans);
+    std::vector<int16_t> out(resampler.value().maxOutput(kBatch) * nchans);
+    std::vector<uint64_t> out_ts(resampler.value().maxOutput(kBatch));
+    size_t row = 0;
+    for (auto _ : state) {
+        resampler.value().process(&frames[row * nchans], &ts[row], kBatch, out.data(), out_ts.data());
+        benchmark::DoNotOptimize(out.data());
+        row = (row + kBatch) % kRows;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatch));
+    state.counters["realtime"] = benchmark::Counter(static_cast<double>(state.iterations() * kBatch) / 30000.0,
+                                                    benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_PolyphaseResampler)->Arg(256)->Arg(32)->Unit(benchmark::kMicrosecond);
+
+static void BM_Rereferencer(benchmark::State& state) {
+    const auto nchans = static_cast<uint32_t>(state.range(0));
+    const auto statistic = static_cast<cbsdk::ReferenceStatistic>(state.range(1));
+    constexpr size_t kBatch = 30;
+    constexpr size_t kRows = 30000;
+    const auto frames = bench::makeNeuralFrames(kRows, nchans);
+    auto rereferencer = cbsdk::Rereferencer::createPooled(std::vector<int32_t>(nchans, 0), statistic);
+    std::vector<int16_t> batch(kBatch * nchans);
+    size_t row = 0;
+    for (auto _ : state) {
+        std::copy_n(&frames[row * nchans], batch.size(), batch.data());
+        rereferencer.value().process(batch.data(), kBatch);
+        benchmark::DoNotOptimize(batch.data());
+        row = (row + kBatch) % kRows;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatch));
+    state.counters["realtime"] = benchmark::Counter(static_cast<double>(state.iterations() * kBatch) / 30000.0,
+                                                    benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_Rereferencer)->ArgNames({"chans", "median"})->Args({256, 0})->Args({256, 1})->Args({32, 0})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ThresholdSpikeDetector(benchmark::State& state) {
+    const auto nchans = static_cast<uint32_t>(state.range(0));
+    constexpr size_t kBatch = 30;
+    constexpr size_t kRows = 30000;
+    // Detect on the spike band, as startSpikeDetection() does after its high-pass
+    auto frames = bench::makeNeuralFrames(kRows, nchans);
+    cbsdk::FilterSpec spec;
+    spec.hpfreq = 250000;
+    spec.hporder = 4;
+    auto highpass = cbsdk::BiquadFilterBank::create(cbsdk::designFilter(spec, 30000.0).value(), nchans);
+    highpass.value().process(frames.data(), kRows, frames.data());
+    std::vector<uint64_t> ts(kRows);
+    for (size_t i = 0; i < kRows; ++i) {
+        ts[i] = i * 33333;
+    }
+    auto detector = cbsdk::ThresholdSpikeDetector::create(cbsdk::SpikeDetectorConfig{}, nchans,
+                                                          cbsdk::SpikeThreshold::rms(-4.5f));
+    std::vector<cbsdk::DetectedSpike> spikes;
+    size_t row = 0;
+    uint64_t detected = 0;
+    for (auto _ : state) {
+        detected += detector.value().process(&frames[row * nchans], &ts[row], kBatch, spikes);
+        row = (row + kBatch) % kRows;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatch));
+    state.counters["spikes/s"] = benchmark::Counter(static_cast<double>(detected) * 30000.0 /
+                                                    static_cast<double>(state.iterations() * kBatch));
+    state.counters["realtime"] = benchmark::Counter(static_cast<double>(state.iterations() * kBatch) / 30000.0,
+                                                    benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ThresholdSpikeDetector)->Arg(256)->Arg(32)->Unit(benchmark::kMicrosecond);
+
+static void BM_SpikeBinner(benchmark::State& state) {
+    const double rate_hz = static_cast<double>(state.range(0));
+    constexpr size_t kChannels = 256;
+    constexpr uint64_t kStep = 1'000'000;       // 1 ms of device time per iteration
+    constexpr size_t kSteps = 1000;
+    // Pre-generate one second of spikes: (chan_id, unit, time) per millisecond step
+    struct Spike { uint32_t chan_id; uint32_t unit; uint64_t offset; };
+    std::mt19937 rng(42);
+    std::poisson_distribution<uint32_t> count(rate_hz * kChannels * 1e-3);
+    std::uniform_int_distribution<uint32_t> chan(1, kChannels), unit(0, 5);
+    std::uniform_int_distribution<uint64_t> offset(0, kStep - 1);
+    std::vector<std::vector<Spike>> steps(kSteps);
+    for (auto& step : steps) {
+        step.resize(count(rng));
+        for (auto& spike : step) {
+            spike = {chan(rng), unit(rng), offset(rng)};
+        }
+    }
+    auto binner = cbsdk::SpikeBinner::create(cbsdk::SpikeBinnerConfig{});
+    const auto& config = binner.value().config();
+    std::vector<uint32_t> counts(config.buffer_bins * config.channel_count * config.unit_count);
+    std::vector<uint64_t> starts(config.buffer_bins);
+    uint64_t now = 0;
+    uint64_t spikes = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        for (const auto& spike : steps[i]) {
+            binner.value().addSpike(spike.chan_id, spike.unit, now + spike.offset);
+        }
+        spikes += steps[i].size();
+        now += kStep;
+        binner.value().advance(now);
+        benchmark::DoNotOptimize(binner.value().takeClosed(counts.data(), starts.data(), starts.size()));
+        i = (i + 1) % kSteps;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(spikes));
+    state.counters["realtime"] = benchmark::Counter(static_cast<double>(state.iterations()) / 1000.0,
+                                                    benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SpikeBinner)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+static void BM_BandPowerEngine(benchmark::State& state) {
+    const auto nchans = static_cast<uint32_t>(state.range(0));
+    const bool raw = state.range(1) != 0;
+    const double rate = raw ? 30000.0 : 1000.0;
+    const size_t batch = raw ? 30 : 1;
+    constexpr size_t kRows = 30000;
+    const auto frames = bench::makeNeuralFrames(kRows, nchans);
+    std::vector<uint64_t> ts(kRows);
+    for (size_t i = 0; i < kRows; ++i) {
+        ts[i] = i * 33333;
+    }
+    cbsdk::BandPowerConfig config;
+    config.window = raw ? 2048 : 256;
+    config.hop = raw ? 300 : 10;
+    config.bands = {{13.0, 30.0}, {70.0, 150.0}};
+    auto engine = cbsdk::BandPowerEngine::create(config, rate, nchans);
+    std::vector<float> out(engine.value().maxOutput(batch) * nchans * config.bands.size());
+    std::vector<uint64_t> out_ts(engine.value().maxOutput(batch));
+    size_t row = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(engine.value().process(&frames[row * nchans], &ts[row], batch, out.data(),
+                                                        out_ts.data()));
+        row = (row + batch) % kRows;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * batch));
+    state.counters["realtime"] = benchmark::Counter(static_cast<double>(state.iterations() * batch) / rate,
+                                                    benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_BandPowerEngine)->ArgNames({"chans", "raw"})->Args({256, 0})->Args({256, 1})->Args({32, 0})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_EpochExtractor(benchmark::State& state) {
+    constexpr uint32_t kChans = 256;
+    constexpr size_t kBatch = 30;
+    constexpr size_t kRows = 30000;
+    const auto rows_per_event = static_cast<uint64_t>(30000 / state.range(0));
+    const auto frames = bench::makeNeuralFrames(kRows, kChans);
+    cbsdk::EpochConfig config;
+    auto extractor = cbsdk::EpochExtractor::create(config, kChans);
+    uint64_t epochs = 0;
+    const cbsdk::EpochSink sink = [&epochs](const cbsdk::EpochEvent&, const int16_t* samples, const uint64_t*) {
+        benchmark::DoNotOptimize(samples);
+        ++epochs;
+    };
+    std::vector<uint64_t> ts(kBatch);
+    uint64_t total = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < kBatch; ++i) {
+            ts[i] = (total + i) * 33333;
+        }
+        if (total % rows_per_event < kBatch) {
+            cbsdk::EpochEvent event;
+            event.time = ts[kBatch / 2];
+            event.chan_id = 1;
+            extractor.value().addEvent(event);
+        }
+        extractor.value().addSamples(&frames[(total % kRows) * kChans], ts.data(), kBatch, sink);
+        total += kBatch;
+    }
+    benchmark::DoNotOptimize(epochs);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatch));
+    state.counters["realtime"] = benchmark::Counter(static_cast<double>(state.iterations() * kBatch) / 30000.0,
+                                                    benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_EpochExtractor)->ArgName("events_per_s")->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+/// One poll of a task controller: log a batch of input packets, read them from a cursor and
+/// look up the word of one channel at a handful of times
+static void BM_DigitalInputPoll(benchmark::State& state) {
+    constexpr size_t kEvents = 32;
+    constexpr size_t kQueries = 16;
+    auto tracker = cbsdk::DigitalInputTracker::create(65536);
+    std::vector<cbsdk::DigitalInputEvent> events(kEvents);
+    std::vector<uint64_t> times(kQueries);
+    std::vector<uint32_t> values(kQueries);
+    uint64_t cursor = 0;
+    uint64_t t = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < kEvents; ++i, t += 1000) {
+            tracker.value().add(static_cast<uint32_t>(cbNUM_ANALOG_CHANS + 1 + i % 2), t,
+                                static_cast<uint32_t>(t >> 10));
+        }
+        benchmark::DoNotOptimize(tracker.value().read(cursor, events.data(), kEvents));
+        for (size_t q = 0; q < kQueries; ++q) {
+            times[q] = t - 2000 * (q + 1);
+        }
+        benchmark::DoNotOptimize(tracker.value().stateAt(cbNUM_ANALOG_CHANS + 1, times.data(), kQueries,
+                                                         values.data()));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kEvents));
+}
+BENCHMARK(BM_DigitalInputPoll);
+
+/// Classify a burst of spikes on 256 channels; range(0) is the burst size, range(1) the worker
+/// threads besides the caller's
+static void BM_SpikeSorter(benchmark::State& state) {
+    constexpr uint32_t kLength = 48;
+    constexpr uint32_t kChannels = 256;
+    const auto n_spikes = static_cast<size_t>(state.range(0));
+    cbsdk::SpikeSorterConfig config;
+    config.spike_length = kLength;
+    config.threads = static_cast<size_t>(state.range(1));
+    auto sorter = cbsdk::SpikeSorter::create(config);
+
+    std::mt19937 rng(11);
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    cbsdk::ChannelSortModel model;
+    model.basis.resize(kLength * 3);
+    for (auto& b : model.basis) b = gauss(rng) / std::sqrt(static_cast<float>(kLength));
+    for (uint32_t u = 1; u <= 3; ++u) {
+        cbsdk::SortUnit unit;
+        unit.unit = u;
+        unit.mean[0] = 100.0f * static_cast<float>(u);
+        unit.mean[1] = -50.0f * static_cast<float>(u);
+        unit.inv_covariance[0][0] = unit.inv_covariance[1][1] = 1.0f / 2500.0f;
+        model.units.push_back(unit);
+    }
+    model.has_noise_boundary = true;
+    model.noise_axes[0][0] = model.noise_axes[1][1] = model.noise_axes[2][2] = 20.0f;
+    for (uint32_t chan = 1; chan <= kChannels; ++chan) {
+        sorter.value().setModel(chan, model);
+    }
+
+    std::vector<int16_t> waves(n_spikes * kLength);
+    for (auto& w : waves) w = static_cast<int16_t>(gauss(rng) * 200.0f);
+    std::vector<cbsdk::SpikeToSort> spikes(n_spikes);
+    for (size_t i = 0; i < n_spikes; ++i) {
+        spikes[i].chan_id = static_cast<uint32_t>(1 + i % kChannels);
+        spikes[i].wave = &waves[i * kLength];
+    }
+    for (auto _ : state) {
+        sorter.value().sort(spikes.data(), n_spikes);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n_spikes));
+}
+BENCHMARK(BM_SpikeSorter)->ArgNames({"spikes", "threads"})
+    ->Args({64, 0})->Args({4096, 0})->Args({4096, 1})->Args({4096, 3})->UseRealTime();
+
+/// Reshape a 30 x 256 batch; range(0): 0 naive transpose and scale, 1 transposeSamples(),
+/// 2 scaleSamples() channel-major, 3 scaleSamples() sample-major
+static void BM_SampleLayout(benchmark::State& state) {
+    constexpr size_t kSamples = 30;
+    constexpr size_t kChannels = 256;
+    const auto mode = state.range(0);
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> dist(-2000, 2000);
+    std::vector<int16_t> in(kSamples * kChannels);
+    for (auto& v : in) v = static_cast<int16_t>(dist(rng));
+    std::vector<cbsdk::ChannelScale> scales(kChannels);
+    for (size_t c = 0; c < kChannels; ++c) {
+        scales[c].gain = 0.25f + 1e-3f * static_cast<float>(c);
+    }
+    std::vector<int16_t> transposed(in.size());
+    std::vector<float> out(in.size());
+
+    for (auto _ : state) {
+        switch (mode) {
+            case 0:
+                for (size_t c = 0; c < kChannels; ++c) {
+                    for (size_t s = 0; s < kSamples; ++s) {
+                        out[c * kSamples + s] = static_cast<float>(in[s * kChannels + c]) * scales[c].gain +
+                                                scales[c].offset;
+                    }
+                }
+                break;
+            case 1:
+                cbsdk::transposeSamples(in.data(), kSamples, kChannels, transposed.data());
+                break;
+            case 2:
+                cbsdk::scaleSamples(in.data(), kSamples, kChannels, scales.data(),
+                                    cbsdk::SampleLayout::CHANNEL_MAJOR, out.data());
+                break;
+            default:
+                cbsdk::scaleSamples(in.data(), kSamples, kChannels, scales.data(),
+                                    cbsdk::SampleLayout::SAMPLE_MAJOR, out.data());
+                break;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * in.size() * sizeof(int16_t)));
+}
+BENCHMARK(BM_SampleLayout)->ArgName("mode")->DenseRange(0, 3);
+
+/// @}
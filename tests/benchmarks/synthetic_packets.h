@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   synthetic_packets.h
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Deterministic synthetic traffic for the microbenchmarks
+///
+/// Every generator draws from a fixed-seed std::mt19937, so two builds benchmark byte-identical
+/// datagrams and their numbers can be compared directly.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef CERELINK_BENCH_SYNTHETIC_PACKETS_H
+#define CERELINK_BENCH_SYNTHETIC_PACKETS_H
+
+#include <cbproto/cbproto.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace bench {
+
+/// Seed shared by every generator
+constexpr uint32_t SEED = 0xCE7E11C5u;
+
+/// Nanoseconds per 30 kHz sample
+constexpr uint64_t SAMPLE_NS = 33333;
+
+/// A group (continuous data) packet for @p group with @p nchans int16 samples
+inline cbPKT_GENERIC makeGroupPacket(std::mt19937& rng, uint64_t time, uint16_t group, uint32_t nchans) {
+    cbPKT_GENERIC pkt = {};
+    pkt.cbpkt_header.time = time;
+    pkt.cbpkt_header.chid = 0;
+    pkt.cbpkt_header.type = group;
+    pkt.cbpkt_header.dlen = static_cast<uint16_t>((nchans + 1) / 2);
+    auto& grp = reinterpret_cast<cbPKT_GROUP&>(pkt);
+    std::uniform_int_distribution<int> sample(-2000, 2000);
+    for (uint32_t i = 0; i < nchans; ++i) {
+        grp.data[i] = static_cast<int16_t>(sample(rng));
+    }
+    return pkt;
+}
+
+/// A spike event packet on a random front-end channel
+inline cbPKT_GENERIC makeSpikePacket(std::mt19937& rng, uint64_t time) {
+    cbPKT_GENERIC pkt = {};
+    pkt.cbpkt_header.time = time;
+    pkt.cbpkt_header.chid = static_cast<uint16_t>(std::uniform_int_distribution<int>(1, 256)(rng));
+    pkt.cbpkt_header.type = static_cast<uint16_t>(std::uniform_int_distribution<int>(0, 5)(rng));
+    pkt.cbpkt_header.dlen = cbPKTDLEN_SPK;
+    auto& spk = reinterpret_cast<cbPKT_SPK&>(pkt);
+    std::uniform_int_distribution<int> sample(-500, 500);
+    for (int i = 0; i < cbMAX_PNTS; ++i) {
+        spk.wave[i] = static_cast<int16_t>(sample(rng));
+    }
+    return pkt;
+}
+
+/// A CHANREP for @p chan with randomised (but plausible) option fields
+inline cbPKT_GENERIC makeChanRep(std::mt19937& rng, uint32_t chan) {
+    cbPKT_GENERIC pkt = {};
+    auto& ci = reinterpret_cast<cbPKT_CHANINFO&>(pkt);
+    ci.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    ci.cbpkt_header.type = cbPKTTYPE_CHANREP;
+    ci.cbpkt_header.dlen = cbPKTDLEN_CHANINFO;
+    ci.chan = chan;
+    ci.proc = 1;
+    ci.bank = (chan - 1) / 32 + 1;
+    ci.term = (chan - 1) % 32 + 1;
+    ci.chancaps = cbCHAN_EXISTS | cbCHAN_CONNECTED | cbCHAN_ISOLATED | cbCHAN_AINP;
+    ci.smpgroup = static_cast<uint32_t>(std::uniform_int_distribution<int>(0, 6)(rng));
+    ci.spkopts = cbAINPSPK_EXTRACT;
+    ci.spkthrlevel = -std::uniform_int_distribution<int>(50, 400)(rng);
+    std::snprintf(ci.label, sizeof(ci.label), "chan%u", chan);
+    return pkt;
+}
+
+/// @p n datagram-ordered packets of mixed 30 kHz group data (96 channels) and spikes,
+/// roughly one spike per four samples — a busy front end's receive mix
+inline std::vector<cbPKT_GENERIC> makeDataStream(size_t n, uint32_t nchans = 96) {
+    std::mt19937 rng(SEED);
+    std::vector<cbPKT_GENERIC> packets;
+    packets.reserve(n);
+    uint64_t time = 1'000'000'000;
+    while (packets.size() < n) {
+        packets.push_back(makeGroupPacket(rng, time, 5, nchans));
+        if (packets.size() < n && std::uniform_int_distribution<int>(0, 3)(rng) == 0) {
+            packets.push_back(makeSpikePacket(rng, time));
+        }
+        time += SAMPLE_NS;
+    }
+    return packets;
+}
+
+/// Append one packet's wire bytes (header + dlen quadlets) to a datagram buffer
+inline void appendPacket(std::vector<uint8_t>& buf, const cbPKT_GENERIC& pkt) {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&pkt);
+    buf.insert(buf.end(), bytes, bytes + cbPKT_HEADER_SIZE + pkt.cbpkt_header.dlen * 4);
+}
+
+/// A REQCONFIGALL reply flood: config-all marker, PROCREP, one CHANREP per channel, then
+/// the SYSREP barrier, packed back to back as the device sends it
+inline std::vector<uint8_t> makeConfigFlood(uint32_t nchans = cbMAXCHANS) {
+    std::mt19937 rng(SEED);
+    std::vector<uint8_t> buf;
+
+    cbPKT_GENERIC pkt = {};
+    pkt.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    pkt.cbpkt_header.type = cbPKTTYPE_REPCONFIGALL;
+    appendPacket(buf, pkt);
+
+    pkt = {};
+    pkt.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    pkt.cbpkt_header.type = cbPKTTYPE_PROCREP;
+    pkt.cbpkt_header.dlen = cbPKTDLEN_PROCINFO;
+    appendPacket(buf, pkt);
+
+    for (uint32_t chan = 1; chan <= nchans; ++chan) {
+        appendPacket(buf, makeChanRep(rng, chan));
+    }
+
+    pkt = {};
+    pkt.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    pkt.cbpkt_header.type = cbPKTTYPE_SYSREP;
+    pkt.cbpkt_header.dlen = cbPKTDLEN_SYSINFO;
+    reinterpret_cast<cbPKT_SYSINFO&>(pkt).runlevel = cbRUNLEVEL_RUNNING;
+    appendPacket(buf, pkt);
+    return buf;
+}
+
+/// @p n rows of broadband 30 kHz neural-like data, row-major [n][nchans], at 0.25 uV per count:
+/// per-channel LFP oscillations, shared 60 Hz hum, ~5 uV rms noise and occasional spikes.
+/// Unlike makeGroupPacket()'s uniform samples this compresses like a real recording.
+inline std::vector<int16_t> makeNeuralFrames(size_t n, uint32_t nchans) {
+    std::mt19937 rng(SEED);
+    std::uniform_real_distribution<double> freq(2.0, 40.0);
+    std::uniform_real_distribution<double> amp(100.0, 600.0);
+    std::uniform_real_distribution<double> phase(0.0, 6.283185307179586);
+    std::normal_distribution<double> noise(0.0, 20.0);
+    std::bernoulli_distribution spike(10.0 / 30000.0);     // ~10 spikes/s per channel
+
+    struct Channel { double f[3], a[3], p[3]; int spike_at = -1; };
+    std::vector<Channel> chans(nchans);
+    for (auto& ch : chans) {
+        for (int k = 0; k < 3; ++k) {
+            ch.f[k] = freq(rng);
+            ch.a[k] = amp(rng) / (k + 1);
+            ch.p[k] = phase(rng);
+        }
+    }
+    // A biphasic 1.6 ms waveform
+    double waveform[48];
+    for (int i = 0; i < 48; ++i) {
+        const double t = (i - 12) / 4.0;
+        waveform[i] = -400.0 * std::exp(-t * t) + 150.0 * std::exp(-(t - 3.0) * (t - 3.0) / 4.0);
+    }
+
+    std::vector<int16_t> frames(n * nchans);
+    for (size_t r = 0; r < n; ++r) {
+        const double t = static_cast<double>(r) / 30000.0;
+        const double hum = 80.0 * std::sin(6.283185307179586 * 60.0 * t);
+        for (uint32_t c = 0; c < nchans; ++c) {
+            auto& ch = chans[c];
+            double v = hum + noise(rng);
+            for (int k = 0; k < 3; ++k) {
+                v += ch.a[k] * std::sin(6.283185307179586 * ch.f[k] * t + ch.p[k]);
+            }
+            if (ch.spike_at < 0 && spike(rng)) {
+                ch.spike_at = 0;
+            }
+            if (ch.spike_at >= 0) {
+                v += waveform[ch.spike_at];
+                ch.spike_at = ch.spike_at + 1 < 48 ? ch.spike_at + 1 : -1;
+            }
+            frames[r * nchans + c] = static_cast<int16_t>(std::lround(std::fmax(-32768.0, std::fmin(32767.0, v))));
+        }
+    }
+    return frames;
+}
+
+} // namespace bench
+
+#endif // CERELINK_BENCH_SYNTHETIC_PACKETS_H
@@ -8,6 +8,7 @@
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "packet_test_helpers.h"
+#include <cstddef>
 #include <cstring>
 #include <algorithm>
 
@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_band_power.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the streaming band power engine
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/band_power.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+struct Frames {
+    std::vector<float> features;
+    std::vector<uint64_t> timestamps;
+};
+
+/// Feed @p rows through @p engine in batches of 1, 2, ... 37 rows; timestamps are 1000 + row
+Frames run(BandPowerEngine& engine, const std::vector<int16_t>& rows) {
+    const size_t channels = engine.channelCount();
+    const size_t width = channels * engine.bandCount();
+    const size_t n = rows.size() / channels;
+    std::vector<uint64_t> ts(n);
+    for (size_t r = 0; r < n; ++r) {
+        ts[r] = 1000 + r;
+    }
+    Frames frames;
+    for (size_t r = 0, batch = 1; r < n; r += batch, batch = batch % 37 + 1) {
+        const size_t m = std::min(batch, n - r);
+        std::vector<float> out(engine.maxOutput(m) * width);
+        std::vector<uint64_t> out_ts(engine.maxOutput(m));
+        const size_t produced = engine.process(&rows[r * channels], &ts[r], m, out.data(), out_ts.data());
+        EXPECT_LE(produced, engine.maxOutput(m));
+        frames.features.insert(frames.features.end(), out.begin(), out.begin() + produced * width);
+        frames.timestamps.insert(frames.timestamps.end(), out_ts.begin(), out_ts.begin() + produced);
+    }
+    return frames;
+}
+
+/// Band power of the last @p window samples of @p x by a direct DFT
+double referencePower(const std::vector<double>& x, const size_t window, const double fs, const FrequencyBand& band) {
+    const size_t start = x.size() - window;
+    double mean = 0.0;
+    for (size_t i = 0; i < window; ++i) mean += x[start + i];
+    mean /= window;
+    double sum_sq = 0.0;
+    std::vector<double> w(window);
+    for (size_t i = 0; i < window; ++i) {
+        w[i] = 0.5 - 0.5 * std::cos(2.0 * PI * i / window);
+        sum_sq += w[i] * w[i];
+    }
+    double power = 0.0;
+    for (size_t k = 0; k <= window / 2; ++k) {
+        const double f = k * fs / window;
+        if (f < band.low_hz - 1e-9 || f > band.high_hz + 1e-9) continue;
+        double re = 0.0, im = 0.0;
+        for (size_t i = 0; i < window; ++i) {
+            const double v = (x[start + i] - mean) * w[i];
+            re += v * std::cos(2.0 * PI * k * i / window);
+            im -= v * std::sin(2.0 * PI * k * i / window);
+        }
+        power += (k == 0 || k == window / 2 ? 1.0 : 2.0) * (re * re + im * im);
+    }
+    return power / (window * sum_sq);
+}
+
+} // anonymous namespace
+
+TEST(BandPowerTest, SineReadsHalfItsSquaredAmplitude) {
+    const double fs = 1000.0;
+    BandPowerConfig config;
+    config.window = 256;
+    config.hop = 64;
+    config.bands = {{13.0, 30.0}, {70.0, 150.0}};
+    auto engine = BandPowerEngine::create(config, fs, 2);
+    ASSERT_TRUE(engine.isOk()) << engine.error();
+
+    // Column 0: 1000-unit 101.5625 Hz sine (bin 26) on a DC offset; column 1: 20 Hz sine
+    const size_t n = 2048;
+    std::vector<int16_t> rows(n * 2);
+    for (size_t r = 0; r < n; ++r) {
+        rows[r * 2] = static_cast<int16_t>(std::lround(3000.0 + 1000.0 * std::sin(2.0 * PI * 101.5625 * r / fs)));
+        rows[r * 2 + 1] = static_cast<int16_t>(std::lround(500.0 * std::sin(2.0 * PI * 20.0 * r / fs)));
+    }
+    const auto frames = run(engine.value(), rows);
+    ASSERT_EQ(frames.timestamps.size(), (n - 256) / 64 + 1);
+    const float* last = &frames.features[(frames.timestamps.size() - 1) * 4];
+    EXPECT_NEAR(last[0 * 2 + 1], 500000.0, 5000.0);     // channel 0, high gamma
+    EXPECT_LT(last[0 * 2 + 0], 50.0);                   // channel 0, beta: no DC leakage
+    EXPECT_NEAR(last[1 * 2 + 0], 125000.0, 2500.0);     // channel 1, beta
+    EXPECT_LT(last[1 * 2 + 1], 10.0);
+}
+
+TEST(BandPowerTest, MatchesDirectDft) {
+    const double fs = 30000.0;
+    const size_t channels = 7;          // one SIMD block plus padding
+    BandPowerConfig config;
+    config.window = 128;
+    config.hop = 40;
+    config.bands = {{0.0, 500.0}, {1000.0, 3000.0}, {14000.0, 15000.0}};
+    auto engine = BandPowerEngine::create(config, fs, channels);
+    ASSERT_TRUE(engine.isOk()) << engine.error();
+
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 300.0);
+    const size_t n = 1000;
+    std::vector<int16_t> rows(n * channels);
+    std::vector<std::vector<double>> columns(channels);
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t c = 0; c < channels; ++c) {
+            const auto v = static_cast<int16_t>(std::lround(noise(rng) + 100.0 * c));
+            rows[r * channels + c] = v;
+            columns[c].push_back(v);
+        }
+    }
+    const auto frames = run(engine.value(), rows);
+    ASSERT_EQ(frames.timestamps.size(), (n - 128) / 40 + 1);
+    const size_t last_row = 128 + (frames.timestamps.size() - 1) * 40;
+    EXPECT_EQ(frames.timestamps.front(), 1000u + 127u);
+    EXPECT_EQ(frames.timestamps.back(), 1000u + last_row - 1);
+
+    const float* last = &frames.features[(frames.timestamps.size() - 1) * channels * 3];
+    for (size_t c = 0; c < channels; ++c) {
+        const std::vector<double> x(columns[c].begin(), columns[c].begin() + last_row);
+        for (size_t b = 0; b < 3; ++b) {
+            const double expected = referencePower(x, 128, fs, config.bands[b]);
+            EXPECT_NEAR(last[c * 3 + b], expected, 1e-3 * expected + 1e-2) << "channel " << c << " band " << b;
+        }
+    }
+}
+
+TEST(BandPowerTest, ResetRefillsTheWindow) {
+    BandPowerConfig config;
+    config.window = 64;
+    config.hop = 16;
+    config.bands = {{10.0, 100.0}};
+    auto engine = BandPowerEngine::create(config, 1000.0, 1);
+    ASSERT_TRUE(engine.isOk());
+    const std::vector<int16_t> rows(100, 7);
+    EXPECT_EQ(run(engine.value(), rows).timestamps.size(), 3u);
+    engine.value().reset();
+    const std::vector<int16_t> few(63, 7);
+    EXPECT_EQ(run(engine.value(), few).timestamps.size(), 0u);
+}
+
+TEST(BandPowerTest, RejectsInvalidConfigs) {
+    BandPowerConfig config;
+    config.bands = {{13.0, 30.0}};
+    EXPECT_TRUE(BandPowerEngine::create(config, 1000.0, 0).isError());
+    EXPECT_TRUE(BandPowerEngine::create(config, 0.0, 4).isError());
+    config.window = 100;
+    EXPECT_TRUE(BandPowerEngine::create(config, 1000.0, 4).isError());
+    config.window = 256;
+    config.hop = 0;
+    EXPECT_TRUE(BandPowerEngine::create(config, 1000.0, 4).isError());
+    config.hop = 10;
+    config.bands = {};
+    EXPECT_TRUE(BandPowerEngine::create(config, 1000.0, 4).isError());
+    config.bands = {{30.0, 13.0}};
+    EXPECT_TRUE(BandPowerEngine::create(config, 1000.0, 4).isError());
+    config.bands = {{400.0, 600.0}};
+    EXPECT_TRUE(BandPowerEngine::create(config, 1000.0, 4).isError());
+    config.bands = {{10.0, 11.0}};     // between bins 2 (7.8 Hz) and 3 (11.7 Hz)
+    EXPECT_TRUE(BandPowerEngine::create(config, 1000.0, 4).isError());
+}
@@ -205,6 +205,23 @@ TEST_F(CbsdkCApiTest, Statistics_GetStats_NullStats) {
     cbsdk_session_destroy(session);
 }
 
+TEST_F(CbsdkCApiTest, Statistics_GetLatencyStats_NullArgs) {
+    cbsdk_latency_stats_t stats;
+    cbsdk_session_get_latency_stats(nullptr, &stats);
+    cbsdk_session_get_latency_stats(nullptr, nullptr);
+    // Should not crash
+}
+
+TEST_F(CbsdkCApiTest, Recording_NullArgs) {
+    EXPECT_EQ(cbsdk_session_start_recording(nullptr, "rec", nullptr), CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_session_stop_recording(nullptr);
+    EXPECT_FALSE(cbsdk_session_is_recording(nullptr));
+    cbsdk_recording_stats_t stats;
+    cbsdk_session_get_recording_stats(nullptr, &stats);
+    cbsdk_session_get_recording_stats(nullptr, nullptr);
+    // Should not crash
+}
+
 TEST_F(CbsdkCApiTest, Statistics_ResetStats) {
     cbsdk_config_t config = cbsdk_config_default();
     config.device_type = CBPROTO_DEVICE_TYPE_HUB1;
@@ -390,6 +407,34 @@ TEST_F(CbsdkCApiTest, SetChannelSampleGroup_NullSession) {
         CBSDK_RESULT_INVALID_PARAMETER);
 }
 
+TEST_F(CbsdkCApiTest, SetChannelSampleGroupAsync_NullSession) {
+    cbsdk_config_op_t op = nullptr;
+    EXPECT_EQ(cbsdk_session_set_sample_group_async(nullptr, 256u, /*chans=*/nullptr,
+        CBPROTO_CHANNEL_TYPE_FRONTEND, CBPROTO_GROUP_RATE_30000Hz, false,
+        1000, /*callback=*/nullptr, /*user_data=*/nullptr, &op),
+        CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(op, nullptr);
+}
+
+TEST_F(CbsdkCApiTest, SetChannelConfigAsync_NullSession) {
+    cbPKT_CHANINFO info = {};
+    EXPECT_EQ(cbsdk_session_set_channel_config_async(nullptr, &info, 1000, nullptr, nullptr, nullptr),
+              CBSDK_RESULT_INVALID_PARAMETER);
+}
+
+TEST_F(CbsdkCApiTest, ConfigOp_NullHandle) {
+    EXPECT_EQ(cbsdk_config_op_wait(nullptr, 0), CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_config_op_pending_channels(nullptr), 0u);
+    cbsdk_config_op_destroy(nullptr);  // Should not crash
+}
+
+TEST_F(CbsdkCApiTest, ConfigTransaction_NullSession) {
+    EXPECT_EQ(cbsdk_session_begin_config_transaction(nullptr), CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_session_commit_config_transaction(nullptr, false, 1000, nullptr, nullptr),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_session_abort_config_transaction(nullptr);  // Should not crash
+}
+
 TEST_F(CbsdkCApiTest, SetChannelConfig_NullSession) {
     cbPKT_CHANINFO info = {};
     EXPECT_EQ(cbsdk_session_set_channel_config(nullptr, &info), CBSDK_RESULT_INVALID_PARAMETER);
@@ -449,6 +494,207 @@ TEST_F(CbsdkCApiTest, SetRunlevel_NullSession) {
     EXPECT_EQ(cbsdk_session_set_runlevel(nullptr, 0), CBSDK_RESULT_INVALID_PARAMETER);
 }
 
+TEST_F(CbsdkCApiTest, FilteredGroupBatchCallback_NullArguments) {
+    cbsdk_filter_spec_t spec{};
+    spec.notch_freq = 60000;
+    spec.notch_bandwidth = 2000;
+    auto cb = [](const int16_t*, size_t, size_t, const uint64_t*, void*) {};
+    EXPECT_EQ(cbsdk_session_register_filtered_group_batch_callback(nullptr, CBPROTO_GROUP_RATE_RAW, &spec, cb, nullptr), 0u);
+}
+
+TEST_F(CbsdkCApiTest, ChannelGroupBatchCallback_NullArguments) {
+    const uint32_t chan_ids[] = {1, 2};
+    auto cb = [](const int16_t*, size_t, size_t, const uint64_t*, void*) {};
+    EXPECT_EQ(cbsdk_session_register_channel_group_batch_callback(nullptr, CBPROTO_GROUP_RATE_RAW, chan_ids, 2,
+                                                                  nullptr, cb, nullptr), 0u);
+}
+
+TEST_F(CbsdkCApiTest, FormattedGroupBatchCallbacks_NullArguments) {
+    auto cb = [](const int16_t*, size_t, size_t, const uint64_t*, void*) {};
+    auto scaled_cb = [](const float*, size_t, size_t, const uint64_t*, void*) {};
+    const cbsdk_batch_policy_t policy{30, 30, 0};
+    EXPECT_EQ(cbsdk_session_register_formatted_group_batch_callback(nullptr, CBPROTO_GROUP_RATE_RAW, nullptr, 0,
+                                                                    nullptr, CBSDK_CHANNEL_MAJOR, &policy, cb,
+                                                                    nullptr), 0u);
+    EXPECT_EQ(cbsdk_session_register_scaled_group_batch_callback(nullptr, CBPROTO_GROUP_RATE_RAW, nullptr, 0,
+                                                                 nullptr, CBSDK_SAMPLE_MAJOR, nullptr, scaled_cb,
+                                                                 nullptr), 0u);
+}
+
+TEST_F(CbsdkCApiTest, VirtualGroups_NullArguments) {
+    uint32_t group = 0;
+    EXPECT_EQ(cbsdk_session_create_resampled_group(nullptr, CBPROTO_GROUP_RATE_RAW, 1, 30, 1000, &group),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_session_create_rereferenced_group(nullptr, CBPROTO_GROUP_RATE_RAW, CBSDK_REFERENCE_COMMON,
+                                                      CBSDK_REFERENCE_MEDIAN, 1000, &group),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_session_destroy_virtual_group(nullptr, 1), CBSDK_RESULT_INVALID_PARAMETER);
+    auto cb = [](const int16_t*, size_t, size_t, const uint64_t*, void*) {};
+    EXPECT_EQ(cbsdk_session_register_virtual_group_batch_callback(nullptr, 1, cb, nullptr), 0u);
+    cbsdk_virtual_group_info_t info{};
+    EXPECT_EQ(cbsdk_session_get_virtual_group_info(nullptr, 1, &info), CBSDK_RESULT_INVALID_PARAMETER);
+    int16_t samples[4];
+    uint32_t n_samples = 1;
+    uint32_t n_channels = 0;
+    EXPECT_EQ(cbsdk_session_read_virtual_group(nullptr, 1, samples, nullptr, 4, &n_samples, &n_channels),
+              CBSDK_RESULT_INVALID_PARAMETER);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Band Power Tests (NULL safety)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CbsdkCApiTest, BandPower_NullArguments) {
+    cbsdk_band_power_config_t config{CBPROTO_GROUP_RATE_1000Hz, 0, 256, 50};
+    cbsdk_frequency_band_t band{13.0, 30.0};
+    uint32_t stream = 0;
+    EXPECT_EQ(cbsdk_session_create_band_power_stream(nullptr, &config, &band, 1, 100, &stream),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_session_destroy_band_power_stream(nullptr, 1), CBSDK_RESULT_INVALID_PARAMETER);
+    auto cb = [](const float*, size_t, size_t, size_t, const uint64_t*, void*) {};
+    EXPECT_EQ(cbsdk_session_register_band_power_callback(nullptr, 1, cb, nullptr), 0u);
+    cbsdk_band_power_info_t info{};
+    EXPECT_EQ(cbsdk_session_get_band_power_info(nullptr, 1, &info), CBSDK_RESULT_INVALID_PARAMETER);
+    float features[4];
+    uint32_t n_frames = 1;
+    uint32_t n_channels = 0;
+    EXPECT_EQ(cbsdk_session_read_band_power(nullptr, 1, features, nullptr, 4, &n_frames, &n_channels),
+              CBSDK_RESULT_INVALID_PARAMETER);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Peri-Event Epoch Tests (NULL safety)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CbsdkCApiTest, Epochs_NullArguments) {
+    cbsdk_epoch_config_t config = cbsdk_epoch_config_default();
+    EXPECT_EQ(config.source, CBPROTO_GROUP_RATE_RAW);
+    EXPECT_EQ(config.post_samples, 600u);
+    EXPECT_EQ(config.unit_mask, 0xFFFFFFFFu);
+    EXPECT_FALSE(config.comments);
+    const uint32_t channels[] = {1};
+    uint32_t stream = 0;
+    EXPECT_EQ(cbsdk_session_create_epoch_stream(nullptr, &config, channels, 1, 10, &stream),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_session_destroy_epoch_stream(nullptr, 1), CBSDK_RESULT_INVALID_PARAMETER);
+    auto cb = [](const cbsdk_epoch_event_t*, const int16_t*, size_t, size_t, const uint64_t*, void*) {};
+    EXPECT_EQ(cbsdk_session_register_epoch_callback(nullptr, 1, cb, nullptr), 0u);
+    cbsdk_epoch_info_t info{};
+    EXPECT_EQ(cbsdk_session_get_epoch_info(nullptr, 1, &info), CBSDK_RESULT_INVALID_PARAMETER);
+    int16_t samples[4];
+    uint32_t n_epochs = 1;
+    uint32_t n_channels = 0;
+    EXPECT_EQ(cbsdk_session_read_epochs(nullptr, 1, samples, nullptr, 4, &n_epochs, &n_channels),
+              CBSDK_RESULT_INVALID_PARAMETER);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Host Spike Detection Tests (NULL safety)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CbsdkCApiTest, SpikeDetection_NullArguments) {
+    cbsdk_spike_detection_config_t config = cbsdk_spike_detection_config_default();
+    EXPECT_EQ(config.source, CBPROTO_GROUP_RATE_RAW);
+    EXPECT_EQ(config.threshold.mode, CBSDK_THRESHOLD_RMS);
+    EXPECT_EQ(cbsdk_session_start_spike_detection(nullptr, &config), CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_session_stop_spike_detection(nullptr);  // Must not crash
+    EXPECT_FALSE(cbsdk_session_is_spike_detection_running(nullptr));
+    cbsdk_spike_threshold_t threshold{CBSDK_THRESHOLD_LEVEL, -100, 0.0f};
+    EXPECT_EQ(cbsdk_session_set_spike_detection_threshold(nullptr, 1, &threshold), CBSDK_RESULT_INVALID_PARAMETER);
+    int16_t level = 0;
+    EXPECT_EQ(cbsdk_session_get_spike_detection_level(nullptr, 1, &level), CBSDK_RESULT_INVALID_PARAMETER);
+}
+
+TEST_F(CbsdkCApiTest, SpikeBinning_NullArguments) {
+    cbsdk_spike_binning_config_t config = cbsdk_spike_binning_config_default();
+    EXPECT_EQ(config.bin_width, 20000000u);
+    EXPECT_EQ(config.channel_count, 272u);
+    EXPECT_EQ(cbsdk_session_start_spike_binning(nullptr, &config), CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_session_stop_spike_binning(nullptr);  // Must not crash
+    EXPECT_FALSE(cbsdk_session_is_spike_binning_running(nullptr));
+    EXPECT_EQ(cbsdk_session_register_spike_bin_callback(
+                  nullptr, [](uint64_t, const uint32_t*, size_t, size_t, void*) {}, nullptr), 0u);
+    uint32_t counts[6] = {};
+    uint32_t n_bins = 1;
+    EXPECT_EQ(cbsdk_session_read_spike_bins(nullptr, counts, nullptr, &n_bins), CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_spike_binning_stats_t stats{};
+    EXPECT_EQ(cbsdk_session_get_spike_binning_stats(nullptr, &stats), CBSDK_RESULT_INVALID_PARAMETER);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Digital Input Tracking Tests (NULL safety)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CbsdkCApiTest, DigitalInputs_NullArguments) {
+    EXPECT_EQ(cbsdk_session_start_digital_input_tracking(nullptr, 1024), CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_session_stop_digital_input_tracking(nullptr);  // Must not crash
+    EXPECT_FALSE(cbsdk_session_is_digital_input_tracking_running(nullptr));
+    cbsdk_digital_input_event_t events[4];
+    uint64_t cursor = 0;
+    uint32_t n_events = 4;
+    EXPECT_EQ(cbsdk_session_read_digital_input_events(nullptr, &cursor, events, &n_events, nullptr),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    const uint64_t times[] = {0};
+    uint32_t values[1];
+    EXPECT_EQ(cbsdk_session_get_digital_input_state(nullptr, 151, times, 1, values, nullptr),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    uint32_t word = 0;
+    EXPECT_EQ(cbsdk_session_get_digital_input_word(nullptr, 151, &word), CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_digital_input_stats_t stats{};
+    EXPECT_EQ(cbsdk_session_get_digital_input_stats(nullptr, &stats), CBSDK_RESULT_INVALID_PARAMETER);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Host Spike Sorting Tests (NULL safety)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CbsdkCApiTest, SpikeSorting_NullArguments) {
+    const cbsdk_spike_sorting_config_t config = cbsdk_spike_sorting_config_default();
+    EXPECT_FLOAT_EQ(config.gate, 9.21f);
+    EXPECT_TRUE(config.device_spikes);
+    EXPECT_EQ(cbsdk_session_start_spike_sorting(nullptr, &config), CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_session_stop_spike_sorting(nullptr);  // Must not crash
+    EXPECT_FALSE(cbsdk_session_is_spike_sorting_running(nullptr));
+    const float basis[48 * 3] = {1.0f};
+    EXPECT_EQ(cbsdk_session_set_spike_sort_model(nullptr, 1, basis, 48, nullptr, 0, nullptr, nullptr),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_spike_sorting_stats_t stats{};
+    EXPECT_EQ(cbsdk_session_get_spike_sorting_stats(nullptr, &stats), CBSDK_RESULT_INVALID_PARAMETER);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Recorded File Access Tests (NULL safety)
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(CbsdkCApiTest, FileReaders_NullArguments) {
+    cbsdk_continuous_reader_t continuous = nullptr;
+    cbsdk_event_reader_t events = nullptr;
+    EXPECT_EQ(cbsdk_continuous_reader_open(nullptr, &continuous), CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_continuous_reader_open("x.ns5", nullptr), CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_event_reader_open(nullptr, &events), CBSDK_RESULT_INVALID_PARAMETER);
+
+    uint64_t first = 0;
+    uint64_t count = 0;
+    cbsdk_continuous_file_info_t info{};
+    EXPECT_EQ(cbsdk_continuous_reader_get_info(nullptr, &info), CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_continuous_reader_find_range(nullptr, 0, 1, &first, &count), CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_continuous_reader_read(nullptr, nullptr, 0, 0, 0, nullptr, nullptr),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    EXPECT_EQ(cbsdk_event_reader_read(nullptr, 0, 0, nullptr, 0, nullptr, nullptr, nullptr, nullptr, &count),
+              CBSDK_RESULT_INVALID_PARAMETER);
+    cbsdk_continuous_reader_close(nullptr);
+    cbsdk_event_reader_close(nullptr);
+}
+
+TEST_F(CbsdkCApiTest, FileReaders_MissingFile) {
+    cbsdk_continuous_reader_t continuous = nullptr;
+    cbsdk_event_reader_t events = nullptr;
+    EXPECT_EQ(cbsdk_continuous_reader_open("/nonexistent/cerelink.ns5", &continuous), CBSDK_RESULT_FILE_ERROR);
+    EXPECT_EQ(cbsdk_event_reader_open("/nonexistent/cerelink.nev", &events), CBSDK_RESULT_FILE_ERROR);
+    EXPECT_EQ(continuous, nullptr);
+    EXPECT_EQ(events, nullptr);
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 // Error Handling Tests
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -461,6 +707,8 @@ TEST_F(CbsdkCApiTest, ErrorMessage_AllCodes) {
     EXPECT_STRNE(cbsdk_get_error_message(CBSDK_RESULT_SHMEM_ERROR), "");
     EXPECT_STRNE(cbsdk_get_error_message(CBSDK_RESULT_DEVICE_ERROR), "");
     EXPECT_STRNE(cbsdk_get_error_message(CBSDK_RESULT_INTERNAL_ERROR), "");
+    EXPECT_STRNE(cbsdk_get_error_message(CBSDK_RESULT_TIMEOUT), "");
+    EXPECT_STRNE(cbsdk_get_error_message(CBSDK_RESULT_FILE_ERROR), "");
 }
 
 TEST_F(CbsdkCApiTest, ErrorMessage_InvalidCode) {
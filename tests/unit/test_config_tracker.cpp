@@ -0,0 +1,252 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_config_tracker.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for per-channel acknowledgement tracking of async configuration
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include "config_tracker.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace cbsdk;
+using namespace std::chrono_literals;
+
+namespace {
+
+/// A CHANSET packet for one channel, as the bulk setters build them
+cbPKT_GENERIC makeChanSet(uint32_t chan, uint16_t type = cbPKTTYPE_CHANSETSMP, uint32_t smpgroup = 0) {
+    cbPKT_GENERIC pkt = {};
+    auto& ci = reinterpret_cast<cbPKT_CHANINFO&>(pkt);
+    ci.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    ci.cbpkt_header.type = type;
+    ci.cbpkt_header.dlen = cbPKTDLEN_CHANINFO;
+    ci.chan = chan;
+    ci.smpgroup = smpgroup;
+    return pkt;
+}
+
+/// The device's reply to makeChanSet(@p chan, @p type | 0x80)
+cbPKT_CHANINFO makeChanRep(uint32_t chan, uint16_t type = cbPKTTYPE_CHANREPSMP) {
+    cbPKT_CHANINFO ci = {};
+    ci.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    ci.cbpkt_header.type = type;
+    ci.cbpkt_header.dlen = cbPKTDLEN_CHANINFO;
+    ci.chan = chan;
+    return ci;
+}
+
+std::vector<cbPKT_GENERIC> makeChanSets(uint32_t first, uint32_t count) {
+    std::vector<cbPKT_GENERIC> packets;
+    for (uint32_t chan = first; chan < first + count; ++chan) {
+        packets.push_back(makeChanSet(chan));
+    }
+    return packets;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Completion Tests
+/// @{
+
+TEST(ConfigTrackerTest, DefaultOperationIsInvalid) {
+    ConfigOperation op;
+    EXPECT_FALSE(op.valid());
+    EXPECT_FALSE(op.done());
+    EXPECT_TRUE(op.wait(0).isError());
+}
+
+TEST(ConfigTrackerTest, EmptyOperationIsDone) {
+    ConfigTracker tracker;
+    cbPKT_GENERIC other = {};
+    other.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    other.cbpkt_header.type = cbPKTTYPE_SYSSETRUNLEV;
+
+    auto op = tracker.begin({other}, 1000ms);
+    EXPECT_TRUE(op.valid());
+    EXPECT_TRUE(op.done());
+    EXPECT_TRUE(op.wait(0).isOk());
+    EXPECT_EQ(tracker.inFlight(), 0u);
+}
+
+TEST(ConfigTrackerTest, CompletesWhenEveryChannelAcknowledged) {
+    ConfigTracker tracker;
+    auto op = tracker.begin(makeChanSets(1, 3), 1000ms);
+    EXPECT_EQ(op.pendingChannels(), 3u);
+    EXPECT_EQ(tracker.inFlight(), 1u);
+
+    tracker.acknowledge(makeChanRep(1));
+    tracker.acknowledge(makeChanRep(3));
+    tracker.acknowledge(makeChanRep(99));  // Not ours
+    EXPECT_FALSE(op.done());
+    EXPECT_EQ(op.pendingChannels(), 1u);
+
+    tracker.acknowledge(makeChanRep(2));
+    EXPECT_TRUE(op.done());
+    EXPECT_FALSE(op.timedOut());
+    EXPECT_TRUE(op.wait(0).isOk());
+    EXPECT_EQ(tracker.inFlight(), 0u);
+}
+
+TEST(ConfigTrackerTest, EchoesRetireOldestOperationFirst) {
+    ConfigTracker tracker;
+    auto first = tracker.begin(makeChanSets(5, 1), 1000ms);
+    auto second = tracker.begin(makeChanSets(5, 1), 1000ms);
+
+    tracker.acknowledge(makeChanRep(5));
+    EXPECT_TRUE(first.done());
+    EXPECT_FALSE(second.done());
+
+    tracker.acknowledge(makeChanRep(5));
+    EXPECT_TRUE(second.done());
+}
+
+TEST(ConfigTrackerTest, RepeatedChannelNeedsOneEchoPerPacket) {
+    ConfigTracker tracker;
+    auto op = tracker.begin({makeChanSet(2), makeChanSet(2, cbPKTTYPE_CHANSETAINP)}, 1000ms);
+    EXPECT_EQ(op.pendingChannels(), 1u);
+
+    tracker.acknowledge(makeChanRep(2));
+    EXPECT_FALSE(op.done());
+    tracker.acknowledge(makeChanRep(2, cbPKTTYPE_CHANREPAINP));
+    EXPECT_TRUE(op.done());
+}
+
+TEST(ConfigTrackerTest, OtherReplyTypesDoNotAcknowledge) {
+    ConfigTracker tracker;
+    auto op = tracker.begin({makeChanSet(4, cbPKTTYPE_CHANSETSPK), makeChanSet(4, cbPKTTYPE_CHANSETSMP)}, 1000ms);
+
+    // Replies to someone else's changes to the channel, or to a request for its state
+    tracker.acknowledge(makeChanRep(4, cbPKTTYPE_CHANREP));
+    tracker.acknowledge(makeChanRep(4, cbPKTTYPE_CHANREPSMP));    // Out of order: ours is SPK first
+    EXPECT_FALSE(op.done());
+    cbPKT_CHANINFO out = {};
+    EXPECT_TRUE(tracker.shadow(4, out));
+
+    tracker.acknowledge(makeChanRep(4, cbPKTTYPE_CHANREPSPK));
+    tracker.acknowledge(makeChanRep(4, cbPKTTYPE_CHANREPSMP));
+    EXPECT_TRUE(op.done());
+    EXPECT_FALSE(tracker.shadow(4, out));
+}
+
+TEST(ConfigTrackerTest, WaitWakesOnAcknowledge) {
+    ConfigTracker tracker;
+    auto op = tracker.begin(makeChanSets(1, 1), 5000ms);
+
+    std::thread acker([&] {
+        std::this_thread::sleep_for(20ms);
+        tracker.acknowledge(makeChanRep(1));
+    });
+    EXPECT_TRUE(op.wait(5000).isOk());
+    acker.join();
+}
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Shadow Tests
+/// @{
+
+TEST(ConfigTrackerTest, ShadowHoldsLastSentUntilAcknowledged) {
+    ConfigTracker tracker;
+    cbPKT_CHANINFO out = {};
+    EXPECT_FALSE(tracker.shadow(7, out));
+
+    auto a = tracker.begin({makeChanSet(7, cbPKTTYPE_CHANSETSMP, 2)}, 1000ms);
+    auto b = tracker.begin({makeChanSet(7, cbPKTTYPE_CHANSETSMP, 5)}, 1000ms);
+    ASSERT_TRUE(tracker.shadow(7, out));
+    EXPECT_EQ(out.smpgroup, 5u);
+
+    tracker.acknowledge(makeChanRep(7));
+    ASSERT_TRUE(tracker.shadow(7, out));  // b still in flight
+    EXPECT_EQ(out.smpgroup, 5u);
+
+    tracker.acknowledge(makeChanRep(7));
+    EXPECT_FALSE(tracker.shadow(7, out));
+}
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Failure Tests
+/// @{
+
+TEST(ConfigTrackerTest, ExpireTimesOutAndRunsCallback) {
+    ConfigTracker tracker;
+    auto op = tracker.begin(makeChanSets(1, 2), 0ms);
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    op.onComplete([calls](const Result<void>& r) {
+        EXPECT_TRUE(r.isError());
+        ++*calls;
+    });
+
+    tracker.acknowledge(makeChanRep(1));
+    tracker.expire();
+    EXPECT_TRUE(op.done());
+    EXPECT_TRUE(op.timedOut());
+    EXPECT_EQ(calls->load(), 1);
+
+    const auto result = op.wait(0);
+    ASSERT_TRUE(result.isError());
+    EXPECT_NE(result.error().find("1 channels pending"), std::string::npos) << result.error();
+
+    cbPKT_CHANINFO out = {};
+    EXPECT_FALSE(tracker.shadow(2, out));
+    EXPECT_EQ(tracker.inFlight(), 0u);
+}
+
+TEST(ConfigTrackerTest, ExpireLeavesLiveOperations) {
+    ConfigTracker tracker;
+    auto op = tracker.begin(makeChanSets(1, 1), 60000ms);
+    tracker.expire();
+    EXPECT_FALSE(op.done());
+    EXPECT_EQ(tracker.inFlight(), 1u);
+}
+
+TEST(ConfigTrackerTest, OnCompleteAfterDoneRunsImmediately) {
+    ConfigTracker tracker;
+    auto op = tracker.begin(makeChanSets(1, 1), 1000ms);
+    tracker.acknowledge(makeChanRep(1));
+
+    bool ran = false;
+    op.onComplete([&](const Result<void>& r) {
+        EXPECT_TRUE(r.isOk());
+        ran = true;
+    });
+    EXPECT_TRUE(ran);
+}
+
+TEST(ConfigTrackerTest, FailReleasesChannels) {
+    ConfigTracker tracker;
+    auto op = tracker.begin(makeChanSets(3, 1), 1000ms);
+    tracker.fail(op, "send failed");
+
+    EXPECT_TRUE(op.done());
+    EXPECT_FALSE(op.timedOut());
+    const auto result = op.wait(0);
+    ASSERT_TRUE(result.isError());
+    EXPECT_EQ(result.error(), "send failed");
+
+    cbPKT_CHANINFO out = {};
+    EXPECT_FALSE(tracker.shadow(3, out));
+    EXPECT_EQ(tracker.inFlight(), 0u);
+}
+
+TEST(ConfigTrackerTest, DestructorCancelsInFlight) {
+    ConfigOperation op;
+    {
+        ConfigTracker tracker;
+        op = tracker.begin(makeChanSets(1, 4), 60000ms);
+    }
+    EXPECT_TRUE(op.done());
+    EXPECT_TRUE(op.wait(0).isError());
+}
+
+/// @}
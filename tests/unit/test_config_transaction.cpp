@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_config_transaction.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for merging staged chaninfo edits into one packet per channel
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include "config_transaction.h"
+#include <array>
+
+using namespace cbsdk;
+
+namespace {
+
+/// A fake chaninfo cache: channel n starts in sample group 2 with no spike options
+struct FakeCache {
+    std::array<cbPKT_CHANINFO, cbMAXCHANS + 1> chans{};
+    int seeds = 0;
+
+    FakeCache() {
+        for (uint32_t chan = 1; chan <= cbMAXCHANS; ++chan) {
+            auto& ci = chans[chan];
+            ci.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+            ci.cbpkt_header.type = cbPKTTYPE_CHANREP;
+            ci.cbpkt_header.dlen = cbPKTDLEN_CHANINFO;
+            ci.chan = chan;
+            ci.smpgroup = 2;
+        }
+    }
+
+    ChanInfoSeed seed() {
+        return [this](uint32_t chan, cbPKT_CHANINFO& out) {
+            ++seeds;
+            if (chan == 0 || chan > cbMAXCHANS) return false;
+            out = chans[chan];
+            return true;
+        };
+    }
+};
+
+ChanInfoEdit setGroup(uint32_t grp) {
+    return [grp](cbPKT_CHANINFO& ci) {
+        ci.cbpkt_header.type = cbPKTTYPE_CHANSETSMP;
+        ci.smpgroup = grp;
+    };
+}
+
+ChanInfoEdit setExtract(bool enabled) {
+    return [enabled](cbPKT_CHANINFO& ci) {
+        ci.cbpkt_header.type = cbPKTTYPE_CHANSETSPK;
+        ci.spkopts &= ~cbAINPSPK_EXTRACT;
+        if (enabled) ci.spkopts |= cbAINPSPK_EXTRACT;
+    };
+}
+
+const cbPKT_CHANINFO& asChanInfo(const cbPKT_GENERIC& pkt) {
+    return reinterpret_cast<const cbPKT_CHANINFO&>(pkt);
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Merge Tests
+/// @{
+
+TEST(ConfigTransactionTest, EmptyBuildsNothing) {
+    ConfigTransaction txn;
+    FakeCache cache;
+    EXPECT_TRUE(txn.empty());
+    EXPECT_TRUE(txn.build(cache.seed()).empty());
+    EXPECT_EQ(cache.seeds, 0);
+}
+
+TEST(ConfigTransactionTest, InvalidChannelsAreIgnored) {
+    ConfigTransaction txn;
+    txn.stage(0, setGroup(1));
+    txn.stage(cbMAXCHANS + 1, setGroup(1));
+    txn.stage(1, nullptr);
+    EXPECT_TRUE(txn.empty());
+}
+
+TEST(ConfigTransactionTest, OnePacketPerChannelAcrossSetters) {
+    ConfigTransaction txn;
+    FakeCache cache;
+    for (uint32_t chan = 1; chan <= 4; ++chan) txn.stage(chan, setGroup(5));
+    for (uint32_t chan = 1; chan <= 4; ++chan) txn.stage(chan, setExtract(true));
+    EXPECT_EQ(txn.channelCount(), 4u);
+
+    const auto packets = txn.build(cache.seed());
+    ASSERT_EQ(packets.size(), 4u);
+    EXPECT_EQ(cache.seeds, 4);
+    for (uint32_t i = 0; i < 4; ++i) {
+        const auto& ci = asChanInfo(packets[i]);
+        EXPECT_EQ(ci.chan, i + 1);  // Channel order
+        EXPECT_EQ(ci.smpgroup, 5u);
+        EXPECT_TRUE(ci.spkopts & cbAINPSPK_EXTRACT);
+        EXPECT_EQ(ci.cbpkt_header.chid, cbPKTCHAN_CONFIGURATION);
+    }
+}
+
+TEST(ConfigTransactionTest, PacketTailBeyondChanInfoIsZero) {
+    ConfigTransaction txn;
+    txn.stage(3, setGroup(5));
+    FakeCache cache;
+    const auto packets = txn.build(cache.seed());
+    ASSERT_EQ(packets.size(), 1u);
+    EXPECT_EQ(asChanInfo(packets[0]).smpgroup, 5u);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&packets[0]);
+    for (size_t i = sizeof(cbPKT_CHANINFO); i < sizeof(cbPKT_GENERIC); ++i) {
+        ASSERT_EQ(bytes[i], 0u) << "byte " << i;
+    }
+}
+
+TEST(ConfigTransactionTest, LaterEditsWin) {
+    ConfigTransaction txn;
+    FakeCache cache;
+    txn.stage(3, setGroup(1));
+    txn.stage(3, setGroup(4));
+
+    const auto packets = txn.build(cache.seed());
+    ASSERT_EQ(packets.size(), 1u);
+    EXPECT_EQ(asChanInfo(packets[0]).smpgroup, 4u);
+}
+
+TEST(ConfigTransactionTest, PacketTypeKeptOrWidened) {
+    ConfigTransaction txn;
+    FakeCache cache;
+    txn.stage(1, setGroup(1));
+    txn.stage(1, setGroup(3));      // Same type twice
+    txn.stage(2, setGroup(1));
+    txn.stage(2, setExtract(true)); // Mixed types
+
+    const auto packets = txn.build(cache.seed());
+    ASSERT_EQ(packets.size(), 2u);
+    EXPECT_EQ(asChanInfo(packets[0]).cbpkt_header.type, cbPKTTYPE_CHANSETSMP);
+    EXPECT_EQ(asChanInfo(packets[1]).cbpkt_header.type, cbPKTTYPE_CHANSET);
+}
+
+TEST(ConfigTransactionTest, SeedIsReadAtBuildTime) {
+    // Fields no edit touches come from the cache as of build(), not as of stage()
+    ConfigTransaction txn;
+    FakeCache cache;
+    txn.stage(7, setExtract(true));
+    cache.chans[7].smpgroup = 6;
+
+    const auto packets = txn.build(cache.seed());
+    ASSERT_EQ(packets.size(), 1u);
+    EXPECT_EQ(asChanInfo(packets[0]).smpgroup, 6u);
+}
+
+TEST(ConfigTransactionTest, WholePacketEditKeepsChannel) {
+    ConfigTransaction txn;
+    FakeCache cache;
+    cbPKT_CHANINFO replacement = cache.chans[9];
+    replacement.cbpkt_header.type = cbPKTTYPE_CHANSETLABEL;
+    replacement.chan = 10;  // Mismatched on purpose
+    txn.stage(9, [replacement](cbPKT_CHANINFO& ci) { ci = replacement; });
+
+    const auto packets = txn.build(cache.seed());
+    ASSERT_EQ(packets.size(), 1u);
+    EXPECT_EQ(asChanInfo(packets[0]).chan, 9u);
+    EXPECT_EQ(asChanInfo(packets[0]).cbpkt_header.type, cbPKTTYPE_CHANSETLABEL);
+}
+
+TEST(ConfigTransactionTest, MergeAppendsInOrder) {
+    ConfigTransaction txn;
+    FakeCache cache;
+    txn.stage(1, setGroup(1));
+
+    ConfigTransaction more;
+    more.stage(1, setGroup(3));
+    more.stage(2, setGroup(3));
+    txn.merge(std::move(more));
+    EXPECT_TRUE(more.empty());
+    EXPECT_EQ(txn.channelCount(), 2u);
+
+    const auto packets = txn.build(cache.seed());
+    ASSERT_EQ(packets.size(), 2u);
+    EXPECT_EQ(asChanInfo(packets[0]).smpgroup, 3u);
+}
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Skip-Unchanged Tests
+/// @{
+
+TEST(ConfigTransactionTest, SkipUnchangedOmitsNoOps) {
+    ConfigTransaction txn;
+    FakeCache cache;
+    txn.stage(1, setGroup(2));      // Already in group 2
+    txn.stage(2, setGroup(3));      // Real change
+    txn.stage(3, setExtract(true));
+    txn.stage(3, setExtract(false)); // Net no-op
+
+    size_t skipped = 0;
+    const auto packets = txn.build(cache.seed(), true, &skipped);
+    ASSERT_EQ(packets.size(), 1u);
+    EXPECT_EQ(asChanInfo(packets[0]).chan, 2u);
+    EXPECT_EQ(skipped, 2u);
+
+    // Default mode still sends everything
+    EXPECT_EQ(txn.build(cache.seed()).size(), 3u);
+}
+
+TEST(ConfigTransactionTest, UnknownChannelsAreDropped) {
+    ConfigTransaction txn;
+    txn.stage(4, setGroup(1));
+    const auto packets = txn.build([](uint32_t, cbPKT_CHANINFO&) { return false; });
+    EXPECT_TRUE(packets.empty());
+}
+
+/// @}
@@ -0,0 +1,271 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_continuous_codec.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the lossless continuous codec and its chunked file format
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/continuous_codec.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+/// Slow sinusoids plus noise: smooth enough for the predictors to matter
+std::vector<int16_t> smoothFrames(const uint32_t n, const uint32_t channels, const uint32_t seed = 1) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> noise(0.0, 8.0);
+    std::vector<int16_t> frames(size_t{n} * channels);
+    for (uint32_t r = 0; r < n; ++r) {
+        for (uint32_t c = 0; c < channels; ++c) {
+            const double v = 500.0 * std::sin(0.002 * r * (c + 1)) + noise(rng);
+            frames[size_t{r} * channels + c] = static_cast<int16_t>(std::lround(v));
+        }
+    }
+    return frames;
+}
+
+std::vector<uint64_t> sampleTimes(const uint32_t n, const uint64_t start = 5'000'000) {
+    std::vector<uint64_t> ts(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        ts[i] = start + uint64_t{i} * 1'000'000'000 / 30000;
+    }
+    return ts;
+}
+
+/// Encode a whole file into memory
+std::vector<uint8_t> encodeFile(const std::vector<int16_t>& frames, const std::vector<uint64_t>& ts,
+                                const uint32_t channels, const uint32_t chunk_samples) {
+    std::vector<uint16_t> ids(channels);
+    for (uint32_t c = 0; c < channels; ++c) {
+        ids[c] = static_cast<uint16_t>(c + 1);
+    }
+    std::vector<uint8_t> out;
+    auto encoder = ContinuousEncoder::create(ids, 1, "30 kS/s", out, chunk_samples);
+    EXPECT_TRUE(encoder.isOk()) << encoder.error();
+    for (size_t r = 0; r < ts.size(); ++r) {
+        encoder.value().push(ts[r], &frames[r * channels], out);
+    }
+    encoder.value().finish(out);
+    EXPECT_EQ(encoder.value().stats().encoded_bytes, out.size());
+    return out;
+}
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Chunk codec
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Channel counts on both sides of the 8-channel vector width
+class ContinuousChunkTest : public ::testing::TestWithParam<uint32_t> {};
+
+TEST_P(ContinuousChunkTest, RoundTripsSmoothData) {
+    const uint32_t channels = GetParam();
+    const uint32_t n = 1000;
+    const auto frames = smoothFrames(n, channels);
+    const auto ts = sampleTimes(n);
+
+    std::vector<uint8_t> chunk;
+    encodeContinuousChunk(frames.data(), ts.data(), n, channels, 0, chunk);
+    EXPECT_LT(chunk.size(), frames.size() * sizeof(int16_t) / 2);
+
+    std::vector<int16_t> decoded(frames.size());
+    std::vector<uint64_t> decoded_ts(n);
+    auto r = decodeContinuousChunk(chunk.data(), chunk.size(), channels, decoded.data(), decoded_ts.data());
+    ASSERT_TRUE(r.isOk()) << r.error();
+    EXPECT_EQ(decoded, frames);
+    EXPECT_EQ(decoded_ts, ts);
+}
+
+INSTANTIATE_TEST_SUITE_P(ChannelCounts, ContinuousChunkTest, ::testing::Values(1u, 7u, 8u, 13u, 96u));
+
+TEST(ContinuousCodecTest, RoundTripsExtremesAndTimestampGaps) {
+    // Full-scale alternation forces escapes on every predictor; the gap forces a timestamp escape
+    const uint32_t channels = 9;
+    const uint32_t n = 300;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> any(INT16_MIN, INT16_MAX);
+    std::vector<int16_t> frames(size_t{n} * channels);
+    for (uint32_t r = 0; r < n; ++r) {
+        frames[size_t{r} * channels + 0] = (r & 1) ? INT16_MAX : INT16_MIN;
+        frames[size_t{r} * channels + 1] = 0;
+        for (uint32_t c = 2; c < channels; ++c) {
+            frames[size_t{r} * channels + c] = static_cast<int16_t>(any(rng));
+        }
+    }
+    auto ts = sampleTimes(n);
+    for (uint32_t i = 150; i < n; ++i) {
+        ts[i] += 3'600'000'000'000ull;     // an hour-long pause
+    }
+    ts[200] = ts[199];                     // a repeated timestamp
+
+    std::vector<uint8_t> chunk;
+    encodeContinuousChunk(frames.data(), ts.data(), n, channels, 42, chunk);
+    ContinuousChunkHeader hdr;
+    std::memcpy(&hdr, chunk.data(), sizeof(hdr));
+    EXPECT_EQ(hdr.sample_count, n);
+    EXPECT_EQ(hdr.first_sample, 42u);
+    EXPECT_EQ(hdr.first_timestamp, ts[0]);
+
+    std::vector<int16_t> decoded(frames.size());
+    std::vector<uint64_t> decoded_ts(n);
+    auto r = decodeContinuousChunk(chunk.data(), chunk.size(), channels, decoded.data(), decoded_ts.data());
+    ASSERT_TRUE(r.isOk()) << r.error();
+    EXPECT_EQ(decoded, frames);
+    EXPECT_EQ(decoded_ts, ts);
+}
+
+TEST(ContinuousCodecTest, RoundTripsShortChunks) {
+    for (uint32_t n = 1; n <= 3; ++n) {
+        const auto frames = smoothFrames(n, 5);
+        const auto ts = sampleTimes(n);
+        std::vector<uint8_t> chunk;
+        encodeContinuousChunk(frames.data(), ts.data(), n, 5, 0, chunk);
+        std::vector<int16_t> decoded(frames.size());
+        std::vector<uint64_t> decoded_ts(n);
+        auto r = decodeContinuousChunk(chunk.data(), chunk.size(), 5, decoded.data(), decoded_ts.data());
+        ASSERT_TRUE(r.isOk()) << "n=" << n << ": " << r.error();
+        EXPECT_EQ(decoded, frames) << "n=" << n;
+        EXPECT_EQ(decoded_ts, ts) << "n=" << n;
+    }
+}
+
+TEST(ContinuousCodecTest, RejectsTruncatedAndCorruptChunks) {
+    const uint32_t channels = 4;
+    const uint32_t n = 200;
+    const auto frames = smoothFrames(n, channels);
+    const auto ts = sampleTimes(n);
+    std::vector<uint8_t> chunk;
+    encodeContinuousChunk(frames.data(), ts.data(), n, channels, 0, chunk);
+
+    std::vector<int16_t> decoded(frames.size());
+    EXPECT_TRUE(decodeContinuousChunk(chunk.data(), chunk.size() - 1, channels, decoded.data(), nullptr).isError());
+    EXPECT_TRUE(decodeContinuousChunk(chunk.data(), 16, channels, decoded.data(), nullptr).isError());
+
+    auto bad_magic = chunk;
+    bad_magic[0] = 'X';
+    EXPECT_TRUE(decodeContinuousChunk(bad_magic.data(), bad_magic.size(), channels, decoded.data(), nullptr).isError());
+
+    // Shrink the last channel's stream so its codes run past the end
+    auto bad_offset = chunk;
+    ContinuousChunkHeader hdr;
+    std::memcpy(&hdr, chunk.data(), sizeof(hdr));
+    const size_t last = sizeof(hdr) + hdr.timestamp_bytes + (channels - 1) * sizeof(uint32_t);
+    const uint32_t streams_bytes = hdr.payload_bytes - hdr.timestamp_bytes - channels * sizeof(uint32_t);
+    const uint32_t near_end = streams_bytes - 2;
+    std::memcpy(&bad_offset[last], &near_end, sizeof(near_end));
+    EXPECT_TRUE(decodeContinuousChunk(bad_offset.data(), bad_offset.size(), channels, decoded.data(), nullptr).isError());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// File format
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ContinuousFileTest, RandomAccessAcrossChunks) {
+    const uint32_t channels = 12;
+    const uint32_t n = 1000;
+    const auto frames = smoothFrames(n, channels, 3);
+    const auto ts = sampleTimes(n);
+    const auto path = tempPath("cbsdk_codec_random_access.cbz5");
+    writeFile(path, encodeFile(frames, ts, channels, 128));
+
+    auto result = ContinuousReader::open(path);
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& reader = result.value();
+    EXPECT_TRUE(reader.hadIndex());
+    EXPECT_EQ(reader.sampleCount(), n);
+    EXPECT_EQ(reader.chunks().size(), 8u);     // 7 full chunks of 128 plus 104 rows
+    EXPECT_EQ(reader.header().channel_count, channels);
+    EXPECT_EQ(reader.header().chunk_samples, 128u);
+    EXPECT_STREQ(reader.header().label, "30 kS/s");
+    ASSERT_EQ(reader.channelIds().size(), channels);
+    EXPECT_EQ(reader.channelIds()[11], 12);
+
+    // Backwards, straddling chunk boundaries
+    for (const uint64_t first : {900ull, 500ull, 120ull, 0ull}) {
+        const size_t count = 100;
+        std::vector<int16_t> samples(count * channels);
+        std::vector<uint64_t> times(count);
+        auto r = reader.read(first, count, samples.data(), times.data());
+        ASSERT_TRUE(r.isOk()) << r.error();
+        EXPECT_TRUE(std::equal(samples.begin(), samples.end(), frames.begin() + first * channels)) << first;
+        EXPECT_TRUE(std::equal(times.begin(), times.end(), ts.begin() + first)) << first;
+    }
+
+    std::vector<int16_t> all(frames.size());
+    ASSERT_TRUE(reader.read(0, n, all.data(), nullptr).isOk());
+    EXPECT_EQ(all, frames);
+    EXPECT_TRUE(reader.read(950, 51, all.data(), nullptr).isError());
+
+    EXPECT_EQ(reader.sampleAtOrAfter(0).value(), 0u);
+    EXPECT_EQ(reader.sampleAtOrAfter(ts[777]).value(), 777u);
+    EXPECT_EQ(reader.sampleAtOrAfter(ts[777] + 1).value(), 778u);
+    EXPECT_EQ(reader.sampleAtOrAfter(ts[n - 1] + 1).value(), n);
+
+    std::remove(path.c_str());
+}
+
+TEST(ContinuousFileTest, RecoversFileWithoutIndex) {
+    const uint32_t channels = 3;
+    const uint32_t n = 500;
+    const auto frames = smoothFrames(n, channels);
+    const auto ts = sampleTimes(n);
+    auto bytes = encodeFile(frames, ts, channels, 100);
+
+    // Simulate a crash: drop the index and footer plus part of the last chunk
+    ContinuousFileFooter footer;
+    std::memcpy(&footer, &bytes[bytes.size() - sizeof(footer)], sizeof(footer));
+    ContinuousChunkIndexEntry last;
+    std::memcpy(&last, &bytes[footer.index_offset + 4 * sizeof(last)], sizeof(last));
+    bytes.resize(last.file_offset + 40);
+
+    const auto path = tempPath("cbsdk_codec_truncated.cbz5");
+    writeFile(path, bytes);
+    auto result = ContinuousReader::open(path);
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& reader = result.value();
+    EXPECT_FALSE(reader.hadIndex());
+    ASSERT_EQ(reader.sampleCount(), 400u);
+    ASSERT_EQ(reader.chunks().size(), 4u);
+    EXPECT_EQ(reader.chunks()[3].last_timestamp, ts[399]);
+
+    std::vector<int16_t> samples(400 * channels);
+    ASSERT_TRUE(reader.read(0, 400, samples.data(), nullptr).isOk());
+    EXPECT_TRUE(std::equal(samples.begin(), samples.end(), frames.begin()));
+    std::remove(path.c_str());
+}
+
+TEST(ContinuousFileTest, RejectsInvalidInput) {
+    std::vector<uint8_t> out;
+    EXPECT_TRUE(ContinuousEncoder::create({}, 1, "", out).isError());
+    EXPECT_TRUE(ContinuousEncoder::create({1}, 1, "", out, 0).isError());
+    EXPECT_TRUE(ContinuousEncoder::create({1}, 1, "", out, CONTINUOUS_MAX_CHUNK_SAMPLES + 1).isError());
+
+    const auto path = tempPath("cbsdk_codec_not_a_file.cbz5");
+    writeFile(path, std::vector<uint8_t>(100, 0x55));
+    EXPECT_TRUE(ContinuousReader::open(path).isError());
+    std::remove(path.c_str());
+    EXPECT_TRUE(ContinuousReader::open(path).isError());
+}
@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_datagram_capture.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for capture files and replay sessions
+///
+/// Captures are written directly with CaptureWriter, so no device or socket is needed.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbdev/capture.h>
+#include <cbdev/device_factory.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace cbdev;
+
+namespace {
+
+std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/// One datagram: a 2-channel group packet followed by a SYSREP at the given runlevel
+std::vector<uint8_t> makeDatagram(uint64_t time, uint32_t runlevel) {
+    std::vector<uint8_t> buf;
+
+    cbPKT_GENERIC grp = {};
+    grp.cbpkt_header.time = time;
+    grp.cbpkt_header.chid = 0;
+    grp.cbpkt_header.type = 5;
+    grp.cbpkt_header.dlen = 1;
+    auto* bytes = reinterpret_cast<const uint8_t*>(&grp);
+    buf.insert(buf.end(), bytes, bytes + cbPKT_HEADER_SIZE + 4);
+
+    cbPKT_SYSINFO sys = {};
+    sys.cbpkt_header.time = time;
+    sys.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    sys.cbpkt_header.type = cbPKTTYPE_SYSREP;
+    sys.cbpkt_header.dlen = cbPKTDLEN_SYSINFO;
+    sys.runlevel = runlevel;
+    bytes = reinterpret_cast<const uint8_t*>(&sys);
+    buf.insert(buf.end(), bytes, bytes + cbPKT_HEADER_SIZE + cbPKTDLEN_SYSINFO * 4);
+    return buf;
+}
+
+/// Write @p count datagrams spaced @p spacing apart in capture time
+void writeCapture(const std::string& path, size_t count, std::chrono::milliseconds spacing,
+                  ProtocolVersion protocol = ProtocolVersion::PROTOCOL_CURRENT) {
+    auto writer = CaptureWriter::open(path, protocol);
+    ASSERT_TRUE(writer.isOk()) << writer.error();
+    const auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        const auto dg = makeDatagram(1000 * (i + 1), static_cast<uint32_t>(i + 1));
+        writer.value().write(t0 + spacing * i, dg.data(), dg.size());
+    }
+    writer.value().close();
+    EXPECT_EQ(writer.value().stats().datagrams, count);
+    EXPECT_EQ(writer.value().stats().dropped, 0u);
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Capture files
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(DatagramCaptureTest, RoundTrip) {
+    const auto path = tempPath("cbdev_capture_roundtrip.cbcap");
+    writeCapture(path, 100, std::chrono::milliseconds(1));
+
+    auto reader = CaptureReader::open(path);
+    ASSERT_TRUE(reader.isOk()) << reader.error();
+    EXPECT_EQ(reader.value().protocol(), ProtocolVersion::PROTOCOL_CURRENT);
+    EXPECT_GT(reader.value().header().start_unix_ns, 0u);
+
+    CaptureRecord record;
+    uint64_t prev_offset = 0;
+    size_t n = 0;
+    for (;;) {
+        auto next = reader.value().next(record);
+        ASSERT_TRUE(next.isOk()) << next.error();
+        if (!next.value()) break;
+        EXPECT_EQ(record.data, makeDatagram(1000 * (n + 1), static_cast<uint32_t>(n + 1)));
+        EXPECT_GE(record.offset_ns, prev_offset);
+        prev_offset = record.offset_ns;
+        ++n;
+    }
+    EXPECT_EQ(n, 100u);
+
+    // Rewind reads the same first record again
+    reader.value().rewind();
+    ASSERT_TRUE(reader.value().next(record).value());
+    EXPECT_EQ(record.data, makeDatagram(1000, 1));
+
+    std::filesystem::remove(path);
+}
+
+TEST(DatagramCaptureTest, RejectsNonCaptureFiles) {
+    EXPECT_TRUE(CaptureReader::open(tempPath("cbdev_capture_missing.cbcap")).isError());
+
+    const auto path = tempPath("cbdev_capture_garbage.cbcap");
+    {
+        FILE* f = std::fopen(path.c_str(), "wb");
+        ASSERT_NE(f, nullptr);
+        const char junk[64] = "definitely not a capture";
+        std::fwrite(junk, 1, sizeof(junk), f);
+        std::fclose(f);
+    }
+    EXPECT_TRUE(CaptureReader::open(path).isError());
+    EXPECT_TRUE(CaptureWriter::open(path, ProtocolVersion::UNKNOWN).isError());
+    std::filesystem::remove(path);
+}
+
+TEST(DatagramCaptureTest, TruncatedTailReadsAsEnd) {
+    const auto path = tempPath("cbdev_capture_truncated.cbcap");
+    writeCapture(path, 3, std::chrono::milliseconds(1));
+    const auto full = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, full - 10);  // cut into the last payload
+
+    auto reader = CaptureReader::open(path);
+    ASSERT_TRUE(reader.isOk()) << reader.error();
+    CaptureRecord record;
+    size_t n = 0;
+    while (reader.value().next(record).value()) ++n;
+    EXPECT_EQ(n, 2u);
+
+    std::filesystem::remove(path);
+}
+
+TEST(DatagramCaptureTest, DropsInsteadOfBlockingWhenBacklogIsFull) {
+    const auto path = tempPath("cbdev_capture_backlog.cbcap");
+    auto writer = CaptureWriter::open(path, ProtocolVersion::PROTOCOL_CURRENT, 64);
+    ASSERT_TRUE(writer.isOk()) << writer.error();
+
+    const std::vector<uint8_t> big(128, 0xAB);
+    writer.value().write(std::chrono::steady_clock::now(), big.data(), big.size());
+    writer.value().close();
+    EXPECT_EQ(writer.value().stats().datagrams, 0u);
+    EXPECT_EQ(writer.value().stats().dropped, 1u);
+
+    std::filesystem::remove(path);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Replay sessions
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(DatagramCaptureTest, ReplayFeedsTheReceivePath) {
+    const auto path = tempPath("cbdev_capture_replay.cbcap");
+    writeCapture(path, 50, std::chrono::milliseconds(1));
+
+    ConnectionParams params = ConnectionParams::forDevice(DeviceType::NSP);
+    params.replay_path = path;
+    params.replay_speed = 0;
+    auto result = createDeviceSession(params);
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& session = *result.value();
+    EXPECT_EQ(session.getProtocolVersion(), ProtocolVersion::PROTOCOL_CURRENT);
+    EXPECT_TRUE(session.isConnected());
+
+    // Requests go nowhere but succeed
+    EXPECT_TRUE(session.requestConfiguration().isOk());
+
+    uint8_t buffer[cbCER_UDP_SIZE_MAX];
+    size_t datagrams = 0;
+    while (!session.isReplayFinished()) {
+        auto r = session.receivePackets(buffer, sizeof(buffer));
+        ASSERT_TRUE(r.isOk()) << r.error();
+        if (r.value() > 0) ++datagrams;
+    }
+    EXPECT_EQ(datagrams, 50u);
+
+    // Configuration tracking saw the replayed SYSREPs
+    EXPECT_EQ(session.getSysInfo().runlevel, 50u);
+
+    std::filesystem::remove(path);
+}
+
+TEST(DatagramCaptureTest, ReplayKeepsRecordedPace) {
+    const auto path = tempPath("cbdev_capture_pace.cbcap");
+    writeCapture(path, 3, std::chrono::milliseconds(100));
+
+    ConnectionParams params = ConnectionParams::forDevice(DeviceType::NSP);
+    params.replay_path = path;
+    params.replay_speed = 2.0;
+    auto result = createDeviceSession(params);
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& session = *result.value();
+
+    uint8_t buffer[cbCER_UDP_SIZE_MAX];
+    const auto start = std::chrono::steady_clock::now();
+    size_t datagrams = 0;
+    while (datagrams < 3) {
+        auto r = session.receivePackets(buffer, sizeof(buffer));
+        ASSERT_TRUE(r.isOk()) << r.error();
+        if (r.value() > 0) ++datagrams;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    // 200 ms of capture at 2x speed
+    EXPECT_GE(elapsed, std::chrono::milliseconds(95));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(1000));
+
+    std::filesystem::remove(path);
+}
+
+TEST(DatagramCaptureTest, ReplayRebuildsTheCapturedProtocolWrapper) {
+    const auto path = tempPath("cbdev_capture_protocol.cbcap");
+    writeCapture(path, 1, std::chrono::milliseconds(1), ProtocolVersion::PROTOCOL_400);
+
+    ConnectionParams params = ConnectionParams::forDevice(DeviceType::NSP);
+    params.replay_path = path;
+    auto result = createDeviceSession(params);
+    ASSERT_TRUE(result.isOk()) << result.error();
+    EXPECT_EQ(result.value()->getProtocolVersion(), ProtocolVersion::PROTOCOL_400);
+
+    EXPECT_TRUE(createDeviceSession(params, ProtocolVersion::PROTOCOL_CURRENT).isOk());
+
+    params.replay_speed = -1;
+    EXPECT_TRUE(createDeviceSession(params).isError());
+
+    std::filesystem::remove(path);
+}
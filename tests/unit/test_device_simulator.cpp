@@ -0,0 +1,853 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_device_simulator.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  End-to-end tests of SdkSession against cbsim::DeviceSimulator on loopback
+///
+/// Each test binds the simulator to an ephemeral port and connects an SdkSession to it with
+/// custom addresses, so the whole UDP -> cbdev -> cbshm -> callback path runs without hardware.
+/// There is one smoke test per feature; the stages themselves are unit tested on their own.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsim/device_simulator.h>
+#include <cbsdk/sdk_session.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace cbsim;
+
+namespace {
+
+/// Poll @p pred for up to @p timeout
+template<typename Pred>
+bool waitFor(Pred pred, std::chrono::milliseconds timeout = std::chrono::seconds(3)) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+} // namespace
+
+/// Runs a simulator on loopback and connects sessions to it.  The simulator outlives the
+/// test body, so a session declared there always stops first; state its callbacks capture
+/// must be declared before the session for the same reason.
+class DeviceSimulatorTest : public ::testing::Test {
+protected:
+    /// Start the simulator on an ephemeral loopback port
+    /// @return false (and the test failed) if it did not start
+    bool startSimulator(SimulatorConfig config) {
+        config.address = "127.0.0.1";
+        config.port = 0;
+        auto result = DeviceSimulator::create(config);
+        if (result.isError()) {
+            ADD_FAILURE() << result.error();
+            return false;
+        }
+        sim = std::make_unique<DeviceSimulator>(std::move(result.value()));
+        const auto started = sim->start();
+        if (started.isError()) {
+            ADD_FAILURE() << started.error();
+            return false;
+        }
+        return true;
+    }
+
+    /// Session options that reach the running simulator
+    cbsdk::SdkConfig loopbackConfig(const bool autorun = false) const {
+        cbsdk::SdkConfig config;
+        config.autorun = autorun;
+        config.custom_device_address = "127.0.0.1";
+        config.custom_client_address = "127.0.0.1";
+        config.custom_device_port = sim->port();
+        config.custom_client_port = 0;
+        config.recv_buffer_size = 0;
+        return config;
+    }
+
+    /// Connect a STANDALONE session to the running simulator
+    /// @return The session, or nothing if it failed (the test failed) or another session owns
+    ///         the shared memory (the test skipped); either way the test should return
+    std::optional<cbsdk::SdkSession> startSession(const cbsdk::SdkConfig& config) {
+        auto result = cbsdk::SdkSession::create(config);
+        if (result.isError()) {
+            ADD_FAILURE() << result.error();
+            return std::nullopt;
+        }
+        if (!result.value().isStandalone()) {
+            [] { GTEST_SKIP() << "Another session owns the shared memory"; }();
+            return std::nullopt;
+        }
+        return std::move(result.value());
+    }
+
+    /// Start the simulator with @p config, then a session on it (see above)
+    std::optional<cbsdk::SdkSession> startSession(const SimulatorConfig& config, const bool autorun = false) {
+        if (!startSimulator(config)) {
+            return std::nullopt;
+        }
+        return startSession(loopbackConfig(autorun));
+    }
+
+    std::unique_ptr<DeviceSimulator> sim;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Configuration validation
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeviceSimulatorTest, RejectsInvalidConfig) {
+    SimulatorConfig config;
+    config.port = 0;
+
+    config.groups = {{7, 8}};
+    EXPECT_TRUE(DeviceSimulator::create(config).isError());
+
+    config.groups = {};
+    EXPECT_TRUE(DeviceSimulator::create(config).isError());
+
+    config.groups = {{5, cbNUM_ANALOG_CHANS}, {2, 1}};
+    EXPECT_TRUE(DeviceSimulator::create(config).isError());
+
+    config.groups = {{5, 8}};
+    config.max_datagram_bytes = 100;
+    EXPECT_TRUE(DeviceSimulator::create(config).isError());
+
+    config.max_datagram_bytes = 8192;
+    auto ok = DeviceSimulator::create(config);
+    ASSERT_TRUE(ok.isOk()) << ok.error();
+    EXPECT_NE(ok.value().port(), 0);
+    EXPECT_EQ(ok.value().channelCount(), 8u);
+    EXPECT_FALSE(ok.value().isRunning());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Device protocol
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeviceSimulatorTest, StreamsConfigurationGroupsAndSpikes) {
+    SimulatorConfig config;
+    config.groups = {{5, 256}, {2, 16}};
+    config.spike_rate_hz = 50.0;
+    std::atomic<uint64_t> fast{0}, slow{0}, spikes{0};
+    std::atomic<uint32_t> fast_dlen{0}, slow_dlen{0};
+    auto session = startSession(config);
+    if (!session) return;
+
+    // Configuration beyond the first 256 channels
+    EXPECT_GE(sim->stats().config_requests, 1u);
+    EXPECT_NE(session->getProcIdent().find("Simulator"), std::string::npos);
+    const auto* first = session->getChanInfo(1);
+    const auto* last = session->getChanInfo(cbNUM_ANALOG_CHANS);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(first->smpgroup, 5u);
+    EXPECT_EQ(last->smpgroup, 2u);
+    EXPECT_FALSE(last->chancaps & cbCHAN_ISOLATED);  // analog input, not front end
+    uint16_t list[cbNUM_ANALOG_CHANS];
+    EXPECT_EQ(session->getGroupChannelList(5, list, cbNUM_ANALOG_CHANS), 256u);
+    EXPECT_EQ(session->getGroupChannelList(2, list, cbNUM_ANALOG_CHANS), 16u);
+    EXPECT_EQ(list[0], cbNUM_FE_CHANS + 1);
+
+    session->registerGroupCallback(cbsdk::SampleRate::SR_30kHz, [&](const cbPKT_GROUP& pkt) {
+        fast_dlen = pkt.cbpkt_header.dlen;
+        ++fast;
+    });
+    session->registerGroupCallback(cbsdk::SampleRate::SR_1kHz, [&](const cbPKT_GROUP& pkt) {
+        slow_dlen = pkt.cbpkt_header.dlen;
+        ++slow;
+    });
+    session->registerEventCallback(cbsdk::ChannelType::FRONTEND, [&](const cbPKT_GENERIC&) { ++spikes; });
+
+    ASSERT_TRUE(waitFor([&] { return slow.load() >= 100; })) << "1 kHz group not streaming";
+    EXPECT_GT(fast.load(), slow.load() * 10);
+    EXPECT_EQ(fast_dlen.load(), 128u);  // 256 int16 samples
+    EXPECT_EQ(slow_dlen.load(), 8u);    // 16 int16 samples
+    EXPECT_TRUE(waitFor([&] { return spikes.load() > 0; }));
+    EXPECT_EQ(sim->stats().send_errors, 0u);
+}
+
+TEST_F(DeviceSimulatorTest, HandshakeAndClockProbes) {
+    SimulatorConfig config;
+    config.groups = {{5, 32}};
+    config.initial_runlevel = cbRUNLEVEL_STANDBY;
+    auto session = startSession(config, true);
+    if (!session) return;
+
+    EXPECT_EQ(sim->runlevel(), static_cast<uint32_t>(cbRUNLEVEL_RUNNING));
+    EXPECT_EQ(session->getRunLevel(), static_cast<uint32_t>(cbRUNLEVEL_RUNNING));
+
+    // The offset can come from data-packet timestamps before any probe is answered, so wait
+    // for the simulator to see a probe first
+    ASSERT_TRUE(waitFor([&] { return sim->stats().clock_probes >= 1; }));
+    EXPECT_TRUE(waitFor([&] { return session->getClockOffsetNs().has_value(); }));
+}
+
+TEST_F(DeviceSimulatorTest, ChannelSettersMoveChannelsBetweenGroups) {
+    SimulatorConfig config;
+    config.groups = {{5, 16}};
+    config.spike_rate_hz = 0;
+    std::atomic<uint32_t> slow_dlen{0};
+    auto session = startSession(config);
+    if (!session) return;
+
+    // Stage "the first two front-end channels", then take channel 1 out of the front end
+    // before committing: the selection is made against the configuration at commit
+    ASSERT_TRUE(session->beginConfigTransaction().isOk());
+    ASSERT_TRUE(session->setSampleGroup(2, cbsdk::ChannelType::FRONTEND, cbsdk::SampleRate::SR_1kHz).isOk());
+    cbPKT_CHANINFO ci = *session->getChanInfo(1);
+    ci.cbpkt_header.type = cbPKTTYPE_CHANSET;
+    ci.chancaps &= ~cbCHAN_ISOLATED;
+    auto changed = session->setChannelConfigAsync(ci, 3000);
+    ASSERT_TRUE(changed.isOk()) << changed.error();
+    ASSERT_TRUE(changed.value().wait(3000).isOk());
+    auto stats = session->commitConfigTransaction();
+    ASSERT_TRUE(stats.isOk()) << stats.error();
+    EXPECT_EQ(stats.value().channels, 2u);
+    EXPECT_EQ(session->getChanInfo(1)->smpgroup, 5u);
+    EXPECT_EQ(session->getChanInfo(2)->smpgroup, 2u);
+    EXPECT_EQ(session->getChanInfo(3)->smpgroup, 2u);
+
+    // An explicit list is not filtered by type
+    session->registerGroupCallback(cbsdk::SampleRate::SR_1kHz, [&](const cbPKT_GROUP& pkt) {
+        slow_dlen = pkt.cbpkt_header.dlen;
+    });
+    const uint32_t chans[] = {1, 2, 3, 4};
+    auto op = session->setSampleGroupAsync(4, cbsdk::ChannelType::FRONTEND, cbsdk::SampleRate::SR_1kHz,
+                                           false, chans);
+    ASSERT_TRUE(op.isOk()) << op.error();
+    ASSERT_TRUE(op.value().wait(3000).isOk());
+    EXPECT_EQ(session->getChanInfo(1)->smpgroup, 2u);
+    EXPECT_TRUE(waitFor([&] { return slow_dlen.load() == 2u; })) << "channels not streaming at 1 kHz";
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Batch callbacks
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeviceSimulatorTest, BatchCallbacksMatchTheFullGroup) {
+    SimulatorConfig config;
+    config.groups = {{5, 8}};
+    // All callbacks run on the callback thread, the full group first
+    std::vector<int16_t> full;
+    std::vector<uint64_t> full_ts;
+    std::vector<cbsdk::ChannelScale> scales;
+    std::atomic<uint64_t> subset{0}, scaled{0}, blocks{0}, flushed{0}, mismatches{0};
+    auto session = startSession(config);
+    if (!session) return;
+
+    uint16_t list[cbNUM_ANALOG_CHANS];
+    ASSERT_EQ(session->getGroupChannelList(5, list, cbNUM_ANALOG_CHANS), 8u);
+    for (size_t c = 0; c < 8; ++c) {
+        const cbPKT_CHANINFO* info = session->getChanInfo(list[c]);
+        ASSERT_NE(info, nullptr);
+        scales.push_back(cbsdk::channelScale(info->scalin));
+    }
+    const auto rate = cbsdk::SampleRate::SR_30kHz;
+    EXPECT_TRUE(session->registerGroupBatchCallback(rate, {}, [](auto...) {}).isError());
+    EXPECT_TRUE(session->registerGroupBatchCallback(rate, {list[0], 200}, [](auto...) {}).isError());
+    cbsdk::GroupBatchFormat format;
+    format.policy = {10, 5, 0};
+    EXPECT_TRUE(session->registerFormattedGroupBatchCallback(rate, format, [](auto...) {}).isError());
+    format.policy = {0, 0, 2000};   // nothing for max_delay_us to wait for
+    EXPECT_TRUE(session->registerFormattedGroupBatchCallback(rate, format, [](auto...) {}).isError());
+
+    session->registerGroupBatchCallback(rate,
+        [&](const int16_t* samples, size_t n, size_t channels, const uint64_t* ts) {
+            full.assign(samples, samples + n * channels);
+            full_ts.assign(ts, ts + n);
+        });
+    const auto same_batch = [&](const size_t n, const uint64_t* ts) {
+        return n == full_ts.size() && std::equal(ts, ts + n, full_ts.begin());
+    };
+
+    // Columns 2-3 form one run, 0 and 7 single columns
+    const size_t subset_columns[] = {2, 3, 0, 7};
+    auto projected = session->registerGroupBatchCallback(rate, {list[2], list[3], list[0], list[7]},
+        [&](const int16_t* samples, size_t n, size_t channels, const uint64_t* ts) {
+            if (channels != 4 || !same_batch(n, ts)) { ++mismatches; return; }
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t c = 0; c < 4; ++c) {
+                    if (samples[i * 4 + c] != full[i * 8 + subset_columns[c]]) ++mismatches;
+                }
+            }
+            ++subset;
+        });
+    ASSERT_TRUE(projected.isOk()) << projected.error();
+
+    // A subset in physical units, channel-major
+    const size_t scaled_columns[] = {6, 1, 2};
+    format.policy = {};
+    format.layout = cbsdk::SampleLayout::CHANNEL_MAJOR;
+    format.chan_ids = {list[6], list[1], list[2]};
+    auto floats = session->registerScaledGroupBatchCallback(rate, format,
+        [&](const float* samples, size_t n, size_t channels, const uint64_t* ts) {
+            if (channels != 3 || !same_batch(n, ts)) { ++mismatches; return; }
+            for (size_t i = 0; i < n; ++i) {
+                for (size_t c = 0; c < 3; ++c) {
+                    const auto& sc = scales[scaled_columns[c]];
+                    const float expected = static_cast<float>(full[i * 8 + scaled_columns[c]]) * sc.gain + sc.offset;
+                    if (std::abs(samples[c * n + i] - expected) > 1e-3f * (1.0f + std::abs(expected))) ++mismatches;
+                }
+            }
+            ++scaled;
+        });
+    ASSERT_TRUE(floats.isOk()) << floats.error();
+
+    // Re-cut into blocks of exactly 50 samples, and held until max_delay_us releases them
+    format = {};
+    format.policy = {50, 50, 0};
+    auto fixed = session->registerFormattedGroupBatchCallback(rate, format,
+        [&](const int16_t*, size_t n, size_t channels, const uint64_t*) {
+            if (n != 50 || channels != 8) ++mismatches;
+            ++blocks;
+        });
+    ASSERT_TRUE(fixed.isOk()) << fixed.error();
+    format.policy = {1000000, 0, 2000};
+    auto delayed = session->registerFormattedGroupBatchCallback(rate, format,
+        [&](const int16_t*, size_t n, size_t, const uint64_t*) {
+            if (n == 0 || n >= 1000000) ++mismatches;
+            ++flushed;
+        });
+    ASSERT_TRUE(delayed.isOk()) << delayed.error();
+
+    ASSERT_TRUE(waitFor([&] {
+        return subset.load() >= 20 && scaled.load() >= 20 && blocks.load() >= 20 && flushed.load() >= 5;
+    })) << "Batch callbacks not called";
+    EXPECT_EQ(mismatches.load(), 0u);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Derived streams
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeviceSimulatorTest, VirtualGroupsResampleAndRereference) {
+    SimulatorConfig config;
+    config.groups = {{5, 8}};
+    std::atomic<uint64_t> source{0}, resampled{0}, rereferenced{0};
+    std::atomic<int> worst{0};
+    auto session = startSession(config);
+    if (!session) return;
+
+    EXPECT_TRUE(session->createResampledGroup(cbsdk::SampleRate::NONE, 1, 30, 100).isError());
+    EXPECT_TRUE(session->createResampledGroup(cbsdk::SampleRate::SR_30kHz, 0, 30, 100).isError());
+    auto created = session->createResampledGroup(cbsdk::SampleRate::SR_30kHz, 1, 30, 100);
+    ASSERT_TRUE(created.isOk()) << created.error();
+    const auto lfp = created.value();
+    created = session->createRereferencedGroup(cbsdk::SampleRate::SR_30kHz, cbsdk::ReferenceScheme::COMMON,
+                                               cbsdk::ReferenceStatistic::MEAN, 100);
+    ASSERT_TRUE(created.isOk()) << created.error();
+    const auto car = created.value();
+
+    session->registerGroupBatchCallback(cbsdk::SampleRate::SR_30kHz,
+        [&](const int16_t*, size_t n, size_t, const uint64_t*) { source += n; });
+    ASSERT_NE(session->registerVirtualGroupBatchCallback(lfp,
+        [&](const int16_t*, size_t n, size_t, const uint64_t*) { resampled += n; }), 0u);
+    EXPECT_EQ(session->registerVirtualGroupBatchCallback(car + 1, [](auto...) {}), 0u);
+    // Every re-referenced row of front-end channels sums to (about) zero
+    ASSERT_NE(session->registerVirtualGroupBatchCallback(car,
+        [&](const int16_t* samples, size_t n, size_t channels, const uint64_t*) {
+            for (size_t r = 0; r < n; ++r) {
+                int sum = 0;
+                for (size_t c = 0; c < channels; ++c) sum += samples[r * channels + c];
+                worst = std::max(worst.load(), std::abs(sum));
+            }
+            rereferenced += n;
+        }), 0u);
+
+    ASSERT_TRUE(waitFor([&] { return resampled.load() >= 200 && rereferenced.load() >= 1000; }))
+        << "Virtual groups not streaming";
+    EXPECT_NEAR(static_cast<double>(source.load()) / resampled.load(), 30.0, 3.0);
+    EXPECT_LE(worst.load(), 8);
+
+    const auto info = session->getVirtualGroupInfo(lfp);
+    ASSERT_TRUE(info.isOk());
+    EXPECT_EQ(info.value().kind, cbsdk::VirtualGroupKind::RESAMPLED);
+    EXPECT_DOUBLE_EQ(info.value().sample_rate_hz, 1000.0);
+    EXPECT_EQ(info.value().channel_count, 8u);
+    EXPECT_EQ(info.value().buffered, 100u);
+    EXPECT_GT(info.value().samples_overwritten, 0u);
+    EXPECT_EQ(session->getVirtualGroupInfo(car).value().kind, cbsdk::VirtualGroupKind::REREFERENCED);
+
+    // The ring buffer holds the newest 100 samples, 30 source samples apart
+    std::vector<int16_t> samples(100 * 8);
+    std::vector<uint64_t> ts(100);
+    size_t channels = 0;
+    EXPECT_TRUE(session->readVirtualGroup(lfp, samples.data(), ts.data(), 100, 4, channels).isError());
+    const auto n = session->readVirtualGroup(lfp, samples.data(), ts.data(), 100, 8, channels);
+    ASSERT_TRUE(n.isOk()) << n.error();
+    EXPECT_EQ(channels, 8u);
+    ASSERT_EQ(n.value(), 100u);
+    for (size_t i = 2; i < n.value(); ++i) {
+        ASSERT_EQ(ts[i] - ts[i - 1], ts[1] - ts[0]);
+    }
+
+    ASSERT_TRUE(session->destroyVirtualGroup(lfp).isOk());
+    EXPECT_TRUE(session->destroyVirtualGroup(lfp).isError());
+    EXPECT_TRUE(session->getVirtualGroupInfo(lfp).isError());
+    EXPECT_TRUE(session->getVirtualGroupInfo(car).isOk());
+}
+
+TEST_F(DeviceSimulatorTest, BandPowerStreamsMeasureTheSimulatedTones) {
+    SimulatorConfig config;
+    config.groups = {{5, 8}};
+    std::mutex mutex;
+    std::vector<float> last(8 * 3);
+    std::atomic<uint64_t> frames{0}, bad{0};
+    auto session = startSession(config);
+    if (!session) return;
+
+    // The simulator plays 400-unit 10 Hz and 120-unit 180 Hz tones over noise
+    cbsdk::BandPowerConfig bands;
+    bands.window = 512;
+    bands.hop = 50;
+    bands.bands = {{5.0, 15.0}, {170.0, 190.0}, {300.0, 400.0}};
+    auto lfp = session->createResampledGroup(cbsdk::SampleRate::SR_30kHz, 1, 30, 0);
+    ASSERT_TRUE(lfp.isOk());
+    EXPECT_TRUE(session->createBandPowerStream(lfp.value() + 1, bands, 10).isError());
+    auto from_lfp = session->createBandPowerStream(lfp.value(), bands, 10);
+    ASSERT_TRUE(from_lfp.isOk()) << from_lfp.error();
+
+    cbsdk::BandPowerConfig raw_bands;
+    raw_bands.window = 4096;
+    raw_bands.hop = 3000;
+    raw_bands.bands = {{170.0, 190.0}};
+    EXPECT_TRUE(session->createBandPowerStream(cbsdk::SampleRate::NONE, raw_bands, 10).isError());
+    auto from_raw = session->createBandPowerStream(cbsdk::SampleRate::SR_30kHz, raw_bands, 10);
+    ASSERT_TRUE(from_raw.isOk()) << from_raw.error();
+
+    ASSERT_NE(session->registerBandPowerCallback(from_lfp.value(),
+        [&](const float* features, size_t n_frames, size_t n_channels, size_t n_bands, const uint64_t*) {
+            if (n_channels != 8 || n_bands != 3) { ++bad; return; }
+            std::lock_guard<std::mutex> lock(mutex);
+            std::copy_n(features + (n_frames - 1) * 24, 24, last.begin());
+            frames += n_frames;
+        }), 0u);
+
+    // 512 ms to fill the window, then 20 vectors a second
+    ASSERT_TRUE(waitFor([&] { return frames.load() >= 10; })) << "No band power vectors";
+    EXPECT_EQ(bad.load(), 0u);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t c = 0; c < 8; ++c) {
+            EXPECT_NEAR(last[c * 3 + 0], 80000.0, 8000.0) << "channel " << c;
+            EXPECT_NEAR(last[c * 3 + 1], 7200.0, 1500.0) << "channel " << c;
+            EXPECT_LT(last[c * 3 + 2], 500.0) << "channel " << c;
+        }
+    }
+
+    ASSERT_TRUE(waitFor([&] { return session->getBandPowerStreamInfo(from_raw.value()).value().buffered >= 1; }));
+    const auto info = session->getBandPowerStreamInfo(from_raw.value());
+    ASSERT_TRUE(info.isOk());
+    EXPECT_EQ(info.value().channel_count, 8u);
+    EXPECT_EQ(info.value().band_count, 1u);
+    EXPECT_DOUBLE_EQ(info.value().sample_rate_hz, 30000.0);
+    std::vector<float> features(10 * 8);
+    std::vector<uint64_t> ts(10);
+    size_t channels = 0;
+    const auto n = session->readBandPower(from_raw.value(), features.data(), ts.data(), 10, 8, channels);
+    ASSERT_TRUE(n.isOk()) << n.error();
+    ASSERT_GE(n.value(), 1u);
+    EXPECT_EQ(channels, 8u);
+    EXPECT_NEAR(features[0], 7200.0, 1500.0);
+
+    ASSERT_TRUE(session->destroyBandPowerStream(from_raw.value()).isOk());
+    EXPECT_TRUE(session->destroyBandPowerStream(from_raw.value()).isError());
+    EXPECT_TRUE(session->getBandPowerStreamInfo(from_raw.value()).isError());
+}
+
+TEST_F(DeviceSimulatorTest, EpochStreamsCutWindowsAroundSpikes) {
+    SimulatorConfig config;
+    config.groups = {{5, 8}};
+    config.spike_rate_hz = 20.0;
+    std::atomic<uint64_t> count{0}, bad{0};
+    auto session = startSession(config);
+    if (!session) return;
+
+    cbsdk::EpochConfig epochs;
+    epochs.pre_samples = 300;
+    epochs.post_samples = 600;
+    cbsdk::EpochTriggers triggers;
+    triggers.channels = {1, 2, 3, 4, 5, 6, 7, 8};
+    triggers.unit_mask = 1u << 2;
+    EXPECT_TRUE(session->createEpochStream(cbsdk::SampleRate::NONE, epochs, triggers, 10).isError());
+    triggers.channels.push_back(cbMAXCHANS + 1);
+    EXPECT_TRUE(session->createEpochStream(cbsdk::SampleRate::SR_30kHz, epochs, triggers, 10).isError());
+    triggers.channels.pop_back();
+    const auto stream = session->createEpochStream(cbsdk::SampleRate::SR_30kHz, epochs, triggers, 10);
+    ASSERT_TRUE(stream.isOk()) << stream.error();
+
+    session->registerEpochCallback(stream.value(), [&](const cbsdk::EpochEvent& event, const int16_t*,
+                                                       size_t n_samples, size_t n_channels, const uint64_t* ts) {
+        if (n_samples != 900 || n_channels != 8 || event.value != 2 || event.chan_id < 1 || event.chan_id > 8 ||
+            event.trigger_time < event.time || event.trigger_time - event.time > 40'000 ||
+            ts[300] != event.trigger_time || ts[0] >= ts[899]) {
+            ++bad;
+        }
+        ++count;
+    });
+
+    ASSERT_TRUE(waitFor([&] { return count.load() >= 5; })) << "No epochs";
+    EXPECT_EQ(bad.load(), 0u);
+
+    const auto info = session->getEpochStreamInfo(stream.value());
+    ASSERT_TRUE(info.isOk());
+    EXPECT_EQ(info.value().channel_count, 8u);
+    EXPECT_EQ(info.value().buffer_capacity, 10u);
+    EXPECT_GE(info.value().epochs_produced, 5u);
+    std::vector<int16_t> samples(10 * 900 * 8);
+    std::vector<cbsdk::EpochEvent> events(10);
+    size_t channels = 0;
+    const auto n = session->readEpochs(stream.value(), samples.data(), events.data(), 10, 8, channels);
+    ASSERT_TRUE(n.isOk()) << n.error();
+    EXPECT_GE(n.value(), 1u);
+    EXPECT_EQ(channels, 8u);
+    EXPECT_EQ(events[0].value, 2u);
+
+    ASSERT_TRUE(session->destroyEpochStream(stream.value()).isOk());
+    EXPECT_TRUE(session->destroyEpochStream(stream.value()).isError());
+    EXPECT_EQ(session->registerEpochCallback(stream.value(), nullptr), 0u);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Spikes and digital inputs
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeviceSimulatorTest, HostSpikeDetectionAndSorting) {
+    SimulatorConfig config;
+    config.groups = {{5, 8}};
+    config.spike_rate_hz = 0.0;     // device extraction off
+    std::atomic<uint64_t> sorted{0}, unsorted{0}, bad{0};
+    std::atomic<uint32_t> dlen{0};
+    auto session = startSession(config);
+    if (!session) return;
+
+    cbsdk::ChannelSortModel model;
+    EXPECT_TRUE(session->setSpikeSortModel(1, model).isError());     // not running
+    EXPECT_TRUE(session->getSpikeSortingStats().isError());
+    cbsdk::SpikeSortingConfig sorting;
+    sorting.threads = 2;
+    ASSERT_TRUE(session->startSpikeSorting(sorting).isOk());
+    EXPECT_TRUE(session->isSpikeSortingRunning());
+
+    // Channel 1: the first component is the waveform's mean, one broad unit around the origin
+    const uint32_t len = session->getSpikeLength();
+    model.basis.assign(len * 3, 0.0f);
+    for (uint32_t i = 0; i < len; ++i) {
+        model.basis[i * 3] = 1.0f / static_cast<float>(len);
+    }
+    model.basis[1] = 1.0f;
+    cbsdk::SortUnit unit;
+    unit.mean[0] = unit.mean[1] = 0.0f;
+    unit.inv_covariance[0][0] = unit.inv_covariance[1][1] = 1e-8f;
+    model.units = {unit};
+    EXPECT_TRUE(session->setSpikeSortModel(0, model).isError());
+    ASSERT_TRUE(session->setSpikeSortModel(1, model).isOk());
+
+    EXPECT_TRUE(session->getSpikeDetectionLevel(1).isError());
+    cbsdk::SpikeDetectionConfig detection;
+    detection.source = cbsdk::SampleRate::SR_30kHz;
+    detection.threshold = cbsdk::SpikeThreshold::fixed(-300);     // the simulator's 10 Hz swing
+    detection.refractory_samples = 1500;
+    ASSERT_TRUE(session->startSpikeDetection(detection).isOk());
+    EXPECT_TRUE(session->isSpikeDetectionRunning());
+    EXPECT_EQ(session->getSpikeDetectionLevel(1).value(), -300);
+    EXPECT_TRUE(session->getSpikeDetectionLevel(9).isError());
+    ASSERT_TRUE(session->setSpikeDetectionThreshold(8, cbsdk::SpikeThreshold::off()).isOk());
+    EXPECT_TRUE(session->setSpikeDetectionThreshold(9, cbsdk::SpikeThreshold::off()).isError());
+
+    const uint32_t pretrigger = session->getSpikePretrigger();
+    session->registerEventCallback(cbsdk::ChannelType::FRONTEND, [&](const cbPKT_GENERIC& pkt) {
+        const auto& spk = reinterpret_cast<const cbPKT_SPK&>(pkt);
+        const uint16_t chid = spk.cbpkt_header.chid;
+        if (chid < 1 || chid > 7 || spk.wave[pretrigger] > -300 || spk.nValley > -300) ++bad;
+        if (chid == 1) {
+            if (spk.cbpkt_header.type != 1 || spk.fPattern[0] >= 0.0f ||
+                spk.fPattern[1] != static_cast<float>(spk.wave[0])) {
+                ++bad;
+            }
+            ++sorted;
+        } else {
+            if (spk.cbpkt_header.type != 0) ++bad;
+            ++unsorted;
+        }
+        dlen = spk.cbpkt_header.dlen;
+    });
+
+    ASSERT_TRUE(waitFor([&] { return sorted.load() >= 2 && unsorted.load() >= 2; })) << "No sorted spikes";
+    EXPECT_EQ(bad.load(), 0u);
+    EXPECT_EQ(dlen.load(), cbPKTDLEN_SPKSHORT + (len + 1) / 2);
+    const auto stats = session->getSpikeSortingStats();
+    ASSERT_TRUE(stats.isOk());
+    EXPECT_GE(stats.value().spikes_sorted, 2u);
+    EXPECT_GE(stats.value().spikes_unmodelled, 2u);
+
+    session->stopSpikeDetection();
+    EXPECT_FALSE(session->isSpikeDetectionRunning());
+    EXPECT_TRUE(session->setSpikeDetectionThreshold(1, cbsdk::SpikeThreshold::off()).isError());
+    session->stopSpikeSorting();
+    EXPECT_FALSE(session->isSpikeSortingRunning());
+}
+
+TEST_F(DeviceSimulatorTest, SpikeBinningCountsDeviceSpikes) {
+    SimulatorConfig config;
+    config.groups = {{5, 8}};
+    config.spike_rate_hz = 50.0;
+    std::atomic<uint64_t> bins{0}, spikes{0}, gaps{0}, bad{0};
+    std::atomic<uint64_t> last_start{0};
+    auto session = startSession(config);
+    if (!session) return;
+
+    EXPECT_TRUE(session->getSpikeBinningStats().isError());
+    cbsdk::SpikeBinnerConfig binning;
+    binning.bin_width = 10'000'000;
+    binning.latency = 5'000'000;
+    binning.unit_count = 6;
+    binning.buffer_bins = 1000;
+    binning.channel_count = cbNUM_ANALOG_CHANS + 1;
+    EXPECT_TRUE(session->startSpikeBinning(binning).isError());
+    binning.channel_count = 8;
+    ASSERT_TRUE(session->startSpikeBinning(binning).isOk());
+    EXPECT_TRUE(session->isSpikeBinningRunning());
+
+    session->registerSpikeBinCallback([&](uint64_t start, const uint32_t* counts, size_t channels, size_t units) {
+        if (channels != 8 || units != 6 || start % 10'000'000 != 0) ++bad;
+        const uint64_t prev = last_start.exchange(start);
+        if (prev != 0 && start != prev + 10'000'000) ++gaps;
+        for (size_t c = 0; c < channels; ++c) {
+            for (size_t u = 0; u < units; ++u) {
+                if (counts[c * units + u] && (u == 0 || u > 3)) ++bad;     // simulator units are 1-3
+                spikes += counts[c * units + u];
+            }
+        }
+        ++bins;
+    });
+
+    ASSERT_TRUE(waitFor([&] { return bins.load() >= 100 && spikes.load() > 0; })) << "No spike bins";
+    EXPECT_EQ(bad.load(), 0u);
+    EXPECT_EQ(gaps.load(), 0u);
+
+    std::vector<uint32_t> counts(binning.buffer_bins * 8 * 6);
+    std::vector<uint64_t> starts(binning.buffer_bins);
+    const auto n = session->readSpikeBins(counts.data(), starts.data(), binning.buffer_bins);
+    ASSERT_TRUE(n.isOk());
+    EXPECT_GE(n.value(), 100u);
+    const auto stats = session->getSpikeBinningStats();
+    ASSERT_TRUE(stats.isOk());
+    EXPECT_GT(stats.value().spikes_counted, 0u);
+
+    session->stopSpikeBinning();
+    EXPECT_FALSE(session->isSpikeBinningRunning());
+    EXPECT_TRUE(session->readSpikeBins(counts.data(), starts.data(), 1).isError());
+}
+
+TEST_F(DeviceSimulatorTest, DigitalInputTrackingLogsCounterWords) {
+    SimulatorConfig config;
+    config.groups = {{5, 8}};
+    config.digital_rate_hz = 200.0;
+    auto session = startSession(config);
+    if (!session) return;
+
+    EXPECT_TRUE(session->getDigitalInputStats().isError());
+    EXPECT_TRUE(session->startDigitalInputTracking(0).isError());
+    ASSERT_TRUE(session->startDigitalInputTracking(4096).isOk());
+    EXPECT_TRUE(session->isDigitalInputTrackingRunning());
+
+    // The simulator counts up one per packet, so each word follows the previous one
+    std::vector<cbsdk::DigitalInputEvent> events;
+    uint64_t cursor = 0;
+    uint64_t skipped = 0;
+    ASSERT_TRUE(waitFor([&] {
+        cbsdk::DigitalInputEvent buf[64];
+        const auto n = session->readDigitalInputEvents(cursor, buf, 64, &skipped);
+        if (n.isOk()) events.insert(events.end(), buf, buf + n.value());
+        return events.size() >= 20;
+    })) << "No digital input events";
+    EXPECT_EQ(skipped, 0u);
+    size_t bad = 0;
+    for (size_t i = 1; i < events.size(); ++i) {
+        const auto& e = events[i];
+        const uint32_t prev = events[i - 1].value;
+        if (e.chan_id != events[0].chan_id || e.chan_id <= cbNUM_ANALOG_CHANS || e.value != ((prev + 1) & 0xFFFF) ||
+            e.rising != (e.value & ~prev) || e.falling != (prev & ~e.value) || e.time <= events[i - 1].time) {
+            ++bad;
+        }
+    }
+    EXPECT_EQ(bad, 0u);
+
+    // The word at each event's time is its value; just before it, the previous one
+    const uint32_t chan = events[0].chan_id;
+    std::vector<uint64_t> times;
+    for (size_t i = 1; i < events.size(); ++i) {
+        times.push_back(events[i].time);
+        times.push_back(events[i].time - 1);
+    }
+    std::vector<uint32_t> values(times.size());
+    const auto exact = session->getDigitalInputState(chan, times.data(), times.size(), values.data());
+    ASSERT_TRUE(exact.isOk());
+    EXPECT_EQ(exact.value(), times.size());
+    for (size_t i = 1; i < events.size(); ++i) {
+        EXPECT_EQ(values[2 * (i - 1)], events[i].value);
+        EXPECT_EQ(values[2 * (i - 1) + 1], events[i - 1].value);
+    }
+    const auto word = session->getDigitalInputWord(chan);
+    ASSERT_TRUE(word.isOk());
+    EXPECT_GE(session->getDigitalInputStats().value().events, events.size());
+
+    session->stopDigitalInputTracking();
+    EXPECT_FALSE(session->isDigitalInputTrackingRunning());
+    EXPECT_TRUE(session->getDigitalInputWord(chan).isError());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Statistics
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeviceSimulatorTest, LatencyAndOwnerStats) {
+    SimulatorConfig config;
+    config.groups = {{5, 32}};
+    std::atomic<uint64_t> groups{0};
+    ASSERT_TRUE(startSimulator(config));
+    auto sdk_config = loopbackConfig();
+    sdk_config.latency_sample_interval = 4;
+    auto owner = startSession(sdk_config);
+    if (!owner) return;
+
+    owner->registerGroupCallback(cbsdk::SampleRate::SR_1kHz, [&](const cbPKT_GROUP&) { ++groups; });
+    ASSERT_TRUE(waitFor([&] { return owner->getLatencyStats().dequeue_to_callback.count >= 50; }));
+    const auto latency = owner->getLatencyStats();
+    for (const auto* stage : {&latency.arrival_to_store, &latency.store_to_dequeue, &latency.dequeue_to_callback}) {
+        EXPECT_GT(stage->count, 0u);
+        EXPECT_LE(stage->min_ns, stage->p50_ns);
+        EXPECT_LE(stage->p50_ns, stage->p99_ns);
+        EXPECT_LE(stage->p99_ns, stage->max_ns);
+    }
+    EXPECT_EQ(latency.store_to_dequeue.count, latency.dequeue_to_callback.count);
+
+    // A client reads what the owner's send thread publishes every 100 ms
+    auto client = cbsdk::SdkSession::create(sdk_config);
+    ASSERT_TRUE(client.isOk()) << client.error();
+    ASSERT_FALSE(client.value().isStandalone());
+    ASSERT_TRUE(waitFor([&] {
+        const auto stats = client.value().getOwnerStats();
+        return stats && stats->packets_received_from_device > 100;
+    }));
+    const auto published = client.value().getOwnerStats();
+    ASSERT_TRUE(published.has_value());
+    EXPECT_GT(published->bytes_received_from_device, published->packets_received_from_device);
+    EXPECT_LE(published->packets_received_from_device, owner->getStats().packets_received_from_device);
+    EXPECT_GT(published->queue_capacity, 0u);
+    EXPECT_EQ(published->queue_capacity, owner->getStats().queue_capacity);
+#if defined(__linux__)
+    EXPECT_GT(published->receive_thread_cpu_ns, 0u);
+    EXPECT_GT(published->send_thread_cpu_ns, 0u);
+    EXPECT_LE(published->receive_thread_cpu_ns, owner->getStats().receive_thread_cpu_ns);
+#endif
+    EXPECT_EQ(owner->getOwnerStats()->packets_dropped, owner->getStats().packets_dropped);
+
+    owner->resetStats();
+    EXPECT_EQ(owner->getLatencyStats().store_to_dequeue.count, 0u);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Recording, capture and replay
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST_F(DeviceSimulatorTest, RecordsGroupsAndSpikesToNsxAndNev) {
+    const auto base = (std::filesystem::temp_directory_path() / "cbsim_recording").string();
+
+    SimulatorConfig config;
+    config.groups = {{5, 32}, {2, 8}};
+    config.spike_rate_hz = 50.0;
+    auto session = startSession(config);
+    if (!session) return;
+
+    ASSERT_TRUE(session->startRecording(base).isOk());
+    EXPECT_TRUE(session->isRecording());
+    EXPECT_TRUE(session->startRecording(base).isError());
+    ASSERT_TRUE(waitFor([&] {
+        const auto stats = session->getRecordingStats();
+        return stats.continuous_packets > 3000 && stats.spike_packets > 10;
+    }));
+    session->stopRecording();
+    EXPECT_FALSE(session->isRecording());
+
+    const auto stats = session->getRecordingStats();
+    EXPECT_EQ(stats.packets_dropped, 0u);
+    EXPECT_EQ(stats.write_errors, 0u);
+    const auto ns5 = std::filesystem::file_size(base + ".ns5");
+    const auto ns2 = std::filesystem::file_size(base + ".ns2");
+    const auto nev = std::filesystem::file_size(base + ".nev");
+    EXPECT_EQ(ns5 + ns2 + nev, stats.bytes_written);
+
+    // Every NSx packet is a 13-byte header plus one sample per channel
+    const uint64_t ns5_headers = 314 + 32 * 66;
+    const uint64_t ns2_headers = 314 + 8 * 66;
+    EXPECT_EQ((ns5 - ns5_headers) % (13 + 32 * 2), 0u);
+    EXPECT_EQ((ns2 - ns2_headers) % (13 + 8 * 2), 0u);
+    EXPECT_EQ((ns5 - ns5_headers) / (13 + 32 * 2) + (ns2 - ns2_headers) / (13 + 8 * 2),
+              stats.continuous_packets);
+
+    for (const char* ext : {".ns5", ".ns2", ".nev"}) {
+        std::filesystem::remove(base + ext);
+    }
+}
+
+TEST_F(DeviceSimulatorTest, CaptureReplaysThroughTheSameSdkPath) {
+    const auto path = (std::filesystem::temp_directory_path() / "cbsim_capture_replay.cbcap").string();
+
+    SimulatorConfig config;
+    config.groups = {{5, 32}, {2, 8}};
+    config.spike_rate_hz = 50.0;
+    ASSERT_TRUE(startSimulator(config));
+
+    uint64_t live_packets = 0;
+    {
+        std::atomic<uint64_t> slow{0};
+        auto live_config = loopbackConfig();
+        live_config.capture_path = path;
+        auto session = startSession(live_config);
+        if (!session) return;
+
+        session->registerGroupCallback(cbsdk::SampleRate::SR_1kHz, [&](const cbPKT_GROUP&) { ++slow; });
+        ASSERT_TRUE(waitFor([&] { return slow.load() >= 200; }));
+
+        sim->stop();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));  // let the last datagram drain
+        session->stopCapture();
+        live_packets = session->getStats().packets_received_from_device;
+    }
+
+    std::atomic<uint64_t> spikes{0};
+    cbsdk::SdkConfig replay_config;
+    replay_config.replay_path = path;
+    replay_config.replay_speed = 0;
+    auto result = cbsdk::SdkSession::create(replay_config);
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& replay = result.value();
+
+    replay.registerEventCallback(cbsdk::ChannelType::FRONTEND, [&](const cbPKT_GENERIC&) { ++spikes; });
+    ASSERT_TRUE(waitFor([&] { return replay.isReplayFinished(); }));
+
+    EXPECT_EQ(replay.getStats().packets_received_from_device, live_packets);
+    EXPECT_NE(replay.getProcIdent().find("Simulator"), std::string::npos);
+    ASSERT_NE(replay.getChanInfo(cbNUM_FE_CHANS + 1), nullptr);
+    EXPECT_EQ(replay.getChanInfo(1)->smpgroup, 5u);
+    EXPECT_TRUE(waitFor([&] { return spikes.load() > 0; }));
+
+    std::filesystem::remove(path);
+}
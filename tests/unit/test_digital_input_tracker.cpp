@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_digital_input_tracker.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the digital input event log
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/digital_input_tracker.h>
+
+#include <vector>
+
+using namespace cbsdk;
+
+TEST(DigitalInputTrackerTest, DecodesEdgesPerChannel) {
+    auto created = DigitalInputTracker::create(16);
+    ASSERT_TRUE(created.isOk()) << created.error();
+    auto& tracker = created.value();
+
+    auto e = tracker.add(151, 100, 0x5);
+    EXPECT_EQ(e.rising, 0x5u);
+    EXPECT_EQ(e.falling, 0u);
+    tracker.add(152, 110, 0xF0);
+    e = tracker.add(151, 120, 0x6);
+    EXPECT_EQ(e.rising, 0x2u);
+    EXPECT_EQ(e.falling, 0x1u);
+    e = tracker.add(151, 130, 0x6);     // repeated word: no edges
+    EXPECT_EQ(e.rising | e.falling, 0u);
+
+    EXPECT_EQ(tracker.current(151), 0x6u);
+    EXPECT_EQ(tracker.current(152), 0xF0u);
+    EXPECT_EQ(tracker.current(153), 0u);
+    EXPECT_EQ(tracker.sequence(), 4u);
+    EXPECT_EQ(tracker.stats().edges_rising, 2u + 4u + 1u);
+    EXPECT_EQ(tracker.stats().edges_falling, 1u);
+}
+
+TEST(DigitalInputTrackerTest, ReadsFromCursorAndReportsOverwrites) {
+    auto created = DigitalInputTracker::create(8);
+    ASSERT_TRUE(created.isOk());
+    auto& tracker = created.value();
+
+    for (uint32_t i = 0; i < 5; ++i) {
+        tracker.add(151, 100 + i, i);
+    }
+    std::vector<DigitalInputEvent> out(8);
+    uint64_t cursor = 0;
+    uint64_t skipped = 99;
+    EXPECT_EQ(tracker.read(cursor, out.data(), 3, &skipped), 3u);
+    EXPECT_EQ(skipped, 0u);
+    EXPECT_EQ(cursor, 3u);
+    EXPECT_EQ(out[2].value, 2u);
+    EXPECT_EQ(tracker.read(cursor, out.data(), 8), 2u);
+    EXPECT_EQ(out[1].value, 4u);
+    EXPECT_EQ(tracker.read(cursor, out.data(), 8), 0u);
+
+    // 12 more events: the log holds sequence numbers 9..16, the cursor is at 5
+    for (uint32_t i = 5; i < 17; ++i) {
+        tracker.add(151, 100 + i, i);
+    }
+    EXPECT_EQ(tracker.read(cursor, out.data(), 8, &skipped), 8u);
+    EXPECT_EQ(skipped, 4u);
+    EXPECT_EQ(out[0].value, 9u);
+    EXPECT_EQ(out[7].value, 16u);
+    EXPECT_EQ(cursor, 17u);
+}
+
+TEST(DigitalInputTrackerTest, AnswersStateAtTimes) {
+    auto created = DigitalInputTracker::create(4);
+    ASSERT_TRUE(created.isOk());
+    auto& tracker = created.value();
+
+    tracker.add(151, 100, 0x1);
+    tracker.add(152, 105, 0x8);
+    tracker.add(151, 200, 0x3);
+    tracker.add(151, 300, 0x2);
+
+    const std::vector<uint64_t> times = {50, 100, 150, 250, 300, 1000};
+    std::vector<uint32_t> values(times.size());
+    EXPECT_EQ(tracker.stateAt(151, times.data(), times.size(), values.data()), times.size());
+    EXPECT_EQ(values, (std::vector<uint32_t>{0x0, 0x1, 0x1, 0x3, 0x2, 0x2}));
+    EXPECT_EQ(tracker.stateAt(153, times.data(), times.size(), values.data()), times.size());
+    EXPECT_EQ(values, std::vector<uint32_t>(times.size(), 0));
+
+    // Overwrite the first event of 151: times before 200 read the word from before it
+    tracker.add(152, 400, 0x0);
+    EXPECT_EQ(tracker.stateAt(151, times.data(), times.size(), values.data()), 3u);
+    EXPECT_EQ(values, (std::vector<uint32_t>{0x1, 0x1, 0x1, 0x3, 0x2, 0x2}));
+
+    // With none of its events held, 151 answers with its current word
+    for (uint64_t t = 500; t < 540; t += 10) {
+        tracker.add(153, t, static_cast<uint32_t>(t));
+    }
+    EXPECT_EQ(tracker.stateAt(151, times.data(), times.size(), values.data()), 0u);
+    EXPECT_EQ(values, std::vector<uint32_t>(times.size(), 0x2));
+}
+
+TEST(DigitalInputTrackerTest, RejectsZeroCapacity) {
+    EXPECT_TRUE(DigitalInputTracker::create(0).isError());
+    EXPECT_TRUE(DigitalInputTracker::create(1).isOk());
+}
@@ -0,0 +1,168 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_epoch_extractor.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the peri-event epoch extractor
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/epoch_extractor.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+struct Epoch {
+    EpochEvent event;
+    std::vector<int16_t> samples;
+    std::vector<uint64_t> timestamps;
+};
+
+/// Row r of the test stream: channel 0 = r, channel 1 = -r, timestamp 1000 + 10 r
+constexpr uint64_t rowTime(const size_t r) {
+    return 1000 + 10 * r;
+}
+
+/// Feed rows [begin, end) of the test stream in batches of 1, 2, ... 29 rows
+void feed(EpochExtractor& extractor, const size_t begin, const size_t end, std::vector<Epoch>& epochs) {
+    const size_t len = extractor.epochLength();
+    const EpochSink sink = [&](const EpochEvent& event, const int16_t* samples, const uint64_t* timestamps) {
+        epochs.push_back({event, std::vector<int16_t>(samples, samples + len * 2),
+                          std::vector<uint64_t>(timestamps, timestamps + len)});
+    };
+    for (size_t r = begin, batch = 1; r < end; r += batch, batch = batch % 29 + 1) {
+        const size_t m = std::min(batch, end - r);
+        std::vector<int16_t> rows(m * 2);
+        std::vector<uint64_t> ts(m);
+        for (size_t i = 0; i < m; ++i) {
+            rows[i * 2] = static_cast<int16_t>(r + i);
+            rows[i * 2 + 1] = static_cast<int16_t>(-static_cast<int>(r + i));
+            ts[i] = rowTime(r + i);
+        }
+        extractor.addSamples(rows.data(), ts.data(), m, sink);
+    }
+}
+
+/// Check that @p epoch holds rows trigger - pre .. trigger + post - 1
+void expectWindow(const Epoch& epoch, const size_t trigger, const EpochConfig& config) {
+    EXPECT_EQ(epoch.event.trigger_time, rowTime(trigger));
+    for (size_t i = 0; i < config.pre_samples + config.post_samples; ++i) {
+        const size_t row = trigger - config.pre_samples + i;
+        ASSERT_EQ(epoch.samples[i * 2], static_cast<int16_t>(row)) << "row " << i;
+        ASSERT_EQ(epoch.samples[i * 2 + 1], static_cast<int16_t>(-static_cast<int>(row))) << "row " << i;
+        ASSERT_EQ(epoch.timestamps[i], rowTime(row)) << "row " << i;
+    }
+}
+
+EpochEvent event(const uint64_t time, const uint32_t chan_id) {
+    EpochEvent e;
+    e.time = time;
+    e.chan_id = chan_id;
+    return e;
+}
+
+} // anonymous namespace
+
+TEST(EpochExtractorTest, CutsWindowsAroundEarlyAndLateEvents) {
+    EpochConfig config;
+    config.pre_samples = 20;
+    config.post_samples = 50;
+    config.max_delay_samples = 100;
+    auto created = EpochExtractor::create(config, 2);
+    ASSERT_TRUE(created.isOk()) << created.error();
+    auto& extractor = created.value();
+    EXPECT_EQ(extractor.epochLength(), 70u);
+
+    std::vector<Epoch> epochs;
+    extractor.addEvent(event(rowTime(300), 1));        // before its trigger sample arrives
+    extractor.addEvent(event(rowTime(310) - 5, 2));    // between rows: the trigger is the next row
+    feed(extractor, 0, 400, epochs);
+    extractor.addEvent(event(rowTime(330), 3));        // 70 rows late
+    extractor.addEvent(event(rowTime(395), 4));        // post window not yet complete
+    EXPECT_EQ(extractor.pendingCount(), 2u);
+    feed(extractor, 400, 500, epochs);
+
+    ASSERT_EQ(epochs.size(), 4u);
+    std::sort(epochs.begin(), epochs.end(), [](const Epoch& a, const Epoch& b) { return a.event.chan_id < b.event.chan_id; });
+    expectWindow(epochs[0], 300, config);
+    expectWindow(epochs[1], 310, config);
+    expectWindow(epochs[2], 330, config);
+    expectWindow(epochs[3], 395, config);
+    EXPECT_EQ(epochs[1].event.time, rowTime(310) - 5);
+    EXPECT_EQ(extractor.pendingCount(), 0u);
+    EXPECT_EQ(extractor.stats().epochs, 4u);
+}
+
+TEST(EpochExtractorTest, DropsWindowsOutsideTheHistory) {
+    EpochConfig config;
+    config.pre_samples = 20;
+    config.post_samples = 30;
+    config.max_delay_samples = 40;
+    auto created = EpochExtractor::create(config, 2);
+    ASSERT_TRUE(created.isOk());
+    auto& extractor = created.value();
+
+    std::vector<Epoch> epochs;
+    extractor.addEvent(event(rowTime(5), 1));          // fewer than pre_samples rows before it
+    feed(extractor, 0, 200, epochs);
+    extractor.addEvent(event(rowTime(100), 2));        // 100 rows late
+    extractor.addEvent(event(rowTime(160), 3));        // 40 rows late: still held
+    feed(extractor, 200, 220, epochs);
+
+    ASSERT_EQ(epochs.size(), 1u);
+    EXPECT_EQ(epochs[0].event.chan_id, 3u);
+    expectWindow(epochs[0], 160, config);
+    EXPECT_EQ(extractor.stats().events_late, 2u);
+}
+
+TEST(EpochExtractorTest, ClockRestartAndOverflowDropPendingEvents) {
+    EpochConfig config;
+    config.pre_samples = 10;
+    config.post_samples = 10;
+    config.max_pending = 2;
+    auto created = EpochExtractor::create(config, 2);
+    ASSERT_TRUE(created.isOk());
+    auto& extractor = created.value();
+
+    std::vector<Epoch> epochs;
+    feed(extractor, 0, 100, epochs);
+    extractor.addEvent(event(rowTime(150), 1));
+    extractor.addEvent(event(rowTime(160), 2));
+    extractor.addEvent(event(rowTime(170), 3));        // over max_pending
+    EXPECT_EQ(extractor.stats().events_dropped, 1u);
+
+    feed(extractor, 0, 100, epochs);                   // time goes back: a clock restart
+    EXPECT_EQ(extractor.pendingCount(), 0u);
+    EXPECT_EQ(extractor.stats().events_dropped, 3u);
+
+    // The history restarts too: an event needs pre_samples rows after the restart
+    extractor.addEvent(event(rowTime(5), 1));
+    extractor.addEvent(event(rowTime(50), 2));
+    feed(extractor, 100, 120, epochs);
+    ASSERT_EQ(epochs.size(), 1u);
+    expectWindow(epochs[0], 50, config);
+    EXPECT_EQ(extractor.stats().events_late, 1u);
+
+    extractor.addEvent(event(rowTime(130), 3));
+    extractor.reset();
+    feed(extractor, 120, 200, epochs);
+    EXPECT_EQ(epochs.size(), 1u);
+}
+
+TEST(EpochExtractorTest, RejectsInvalidConfigs) {
+    EpochConfig config;
+    EXPECT_TRUE(EpochExtractor::create(config, 0).isError());
+    config.post_samples = 0;
+    EXPECT_TRUE(EpochExtractor::create(config, 4).isError());
+    config.post_samples = 1;
+    config.max_pending = 0;
+    EXPECT_TRUE(EpochExtractor::create(config, 4).isError());
+    config.max_pending = 1;
+    config.pre_samples = 0;
+    EXPECT_TRUE(EpochExtractor::create(config, 4).isOk());
+}
@@ -0,0 +1,458 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_file_reader.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the memory-mapped NSx / cbz / NEV readers
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/cbsdk.h>
+#include <cbsdk/continuous_codec.h>
+#include <cbsdk/file_reader.h>
+#include <cbsdk/nsx_nev_format.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace cbsdk;
+using namespace cbsdk::fileformat;
+
+namespace {
+
+constexpr uint32_t CHANNELS = 5;
+
+std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void writeFile(const std::string& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+template<typename T>
+void append(std::vector<uint8_t>& out, const T& value, const size_t bytes = sizeof(T)) {
+    const auto* p = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), p, p + bytes);
+}
+
+/// Sample of channel column @p c in row @p r
+int16_t valueAt(const uint64_t r, const uint32_t c) {
+    return static_cast<int16_t>(r * 7 + c * 1000 - 20000);
+}
+
+/// NSx data packet: first timestamp and number of rows
+struct Packet {
+    uint64_t timestamp;
+    uint32_t points;
+};
+
+/// NSx file of CHANNELS channels (ids 10, 11, ...) holding @p packets of consecutive rows
+/// @param v30 NSx 3.0 (64-bit ns timestamps) rather than 2.2 (32-bit 30 kHz timestamps)
+/// @param rows_written Rows actually stored (defaults to the sum of the packets' points)
+std::vector<uint8_t> buildNsx(const bool v30, const std::vector<Packet>& packets, uint64_t rows_written = 0) {
+    std::vector<uint8_t> out;
+    NsxBasicHeader basic{};
+    std::memcpy(basic.file_type_id, v30 ? NSX_FILE_TYPE_ID : "NEURALCD", 8);
+    basic.major_version = v30 ? 3 : 2;
+    basic.minor_version = v30 ? 0 : 2;
+    basic.bytes_in_headers = sizeof(NsxBasicHeader) + CHANNELS * sizeof(NsxChannelHeader);
+    std::strcpy(basic.label, "30 kS/s");
+    basic.period = 1;
+    basic.time_resolution = v30 ? 1'000'000'000 : 30000;
+    basic.channel_count = CHANNELS;
+    append(out, basic);
+    for (uint32_t c = 0; c < CHANNELS; ++c) {
+        NsxChannelHeader cc{};
+        cc.type[0] = 'C';
+        cc.type[1] = 'C';
+        cc.electrode_id = static_cast<uint16_t>(10 + c);
+        append(out, cc);
+    }
+
+    if (rows_written == 0) {
+        for (const auto& p : packets) {
+            rows_written += p.points;
+        }
+    }
+    uint64_t row = 0;
+    for (const auto& p : packets) {
+        append(out, uint8_t{1});
+        append(out, p.timestamp, v30 ? 8 : 4);
+        append(out, p.points);
+        const uint64_t rows = p.points == 0 ? rows_written - row : p.points;
+        for (uint64_t r = 0; r < rows && row < rows_written; ++r, ++row) {
+            for (uint32_t c = 0; c < CHANNELS; ++c) {
+                append(out, valueAt(row, c));
+            }
+        }
+    }
+    return out;
+}
+
+/// @p n single-sample packets 1/30000 s apart starting at @p t0 (ns)
+std::vector<Packet> singleSamplePackets(const uint32_t n, const uint64_t t0 = 1'000'000) {
+    std::vector<Packet> packets(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        packets[i] = {t0 + uint64_t{i} * 1'000'000'000 / 30000, 1};
+    }
+    return packets;
+}
+
+/// NEV file of @p n packets alternating between electrodes 1 and 2, with a digital packet
+/// (id 0) every tenth; timestamps are 3 * index + 100
+std::vector<uint8_t> buildNev(const bool v30, const uint32_t n, const uint32_t packet_size) {
+    std::vector<uint8_t> out;
+    NevBasicHeader basic{};
+    std::memcpy(basic.file_type_id, v30 ? NEV_FILE_TYPE_ID : "NEURALEV", 8);
+    basic.bytes_in_headers = sizeof(NevBasicHeader);
+    basic.bytes_per_packet = packet_size;
+    basic.time_resolution = v30 ? 1'000'000'000 : 30000;
+    append(out, basic);
+    const size_t ts_bytes = v30 ? 8 : 4;
+    for (uint32_t i = 0; i < n; ++i) {
+        const size_t start = out.size();
+        append(out, uint64_t{3} * i + 100, ts_bytes);
+        append(out, static_cast<uint16_t>(i % 10 == 0 ? 0 : 1 + i % 2));
+        append(out, static_cast<uint8_t>(i % 4));
+        append(out, uint8_t{0});
+        for (size_t w = 0; w < (packet_size - ts_bytes - 4) / 2; ++w) {
+            append(out, static_cast<int16_t>(i + w));
+        }
+        EXPECT_EQ(out.size() - start, packet_size);
+    }
+    return out;
+}
+
+ContinuousFileReader openContinuous(const std::string& path) {
+    auto reader = ContinuousFileReader::open(path);
+    EXPECT_TRUE(reader.isOk()) << reader.error();
+    return std::move(reader.value());
+}
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// NSx
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ContinuousFileReaderTest, IndexesSingleSamplePacketsAsOneSegment) {
+    const std::string path = tempPath("cerelink_reader_single.ns5");
+    const uint32_t n = 5000;
+    const auto packets = singleSamplePackets(n);
+    writeFile(path, buildNsx(true, packets));
+
+    {
+        auto reader = openContinuous(path);
+        EXPECT_FALSE(reader.isCompressed());
+        EXPECT_EQ(reader.label(), "30 kS/s");
+        EXPECT_EQ(reader.timeResolution(), 1'000'000'000u);
+        EXPECT_EQ(reader.channelIds(), (std::vector<uint16_t>{10, 11, 12, 13, 14}));
+        EXPECT_EQ(reader.sampleCount(), n);
+        ASSERT_EQ(reader.segments().size(), 1u);
+        EXPECT_EQ(reader.segments()[0].first_timestamp, packets.front().timestamp);
+        EXPECT_EQ(reader.segments()[0].last_timestamp, packets.back().timestamp);
+
+        // [t0, t1) boundaries land exactly on and just after sample times
+        auto range = reader.findRange(packets[1000].timestamp, packets[1200].timestamp);
+        ASSERT_TRUE(range.isOk()) << range.error();
+        EXPECT_EQ(range.value().first, 1000u);
+        EXPECT_EQ(range.value().count, 200u);
+        range = reader.findRange(packets[1000].timestamp + 1, packets[1200].timestamp + 1);
+        EXPECT_EQ(range.value().first, 1001u);
+        EXPECT_EQ(range.value().count, 200u);
+        EXPECT_EQ(reader.findRange(0, 1).value().count, 0u);
+        EXPECT_EQ(reader.findRange(packets.back().timestamp + 1, UINT64_MAX).value().first, n);
+
+        auto view = reader.view(1000, 200);
+        ASSERT_TRUE(view.isOk()) << view.error();
+        EXPECT_EQ(view.value().row_stride, sizeof(NsxDataHeader) + CHANNELS * sizeof(int16_t));
+        EXPECT_EQ(view.value().sample(0, 0), valueAt(1000, 0));
+        EXPECT_EQ(view.value().sample(199, 4), valueAt(1199, 4));
+
+        // Subset in a different order than the file
+        std::vector<int16_t> samples(200 * 2);
+        std::vector<uint64_t> timestamps(200);
+        auto r = reader.readSamples({13, 10}, 1000, 200, samples.data(), timestamps.data());
+        ASSERT_TRUE(r.isOk()) << r.error();
+        for (uint32_t i = 0; i < 200; ++i) {
+            EXPECT_EQ(samples[i * 2], valueAt(1000 + i, 3));
+            EXPECT_EQ(samples[i * 2 + 1], valueAt(1000 + i, 0));
+            EXPECT_EQ(timestamps[i], packets[1000 + i].timestamp);
+        }
+
+        auto data = reader.read({}, packets[4990].timestamp, UINT64_MAX);
+        ASSERT_TRUE(data.isOk()) << data.error();
+        ASSERT_EQ(data.value().timestamps.size(), 10u);
+        EXPECT_EQ(data.value().channel_ids.size(), CHANNELS);
+        EXPECT_EQ(data.value().samples.back(), valueAt(n - 1, CHANNELS - 1));
+    }
+    std::remove(path.c_str());
+}
+
+TEST(ContinuousFileReaderTest, SplitsSegmentsAtClockResets) {
+    const std::string path = tempPath("cerelink_reader_reset.ns5");
+    auto packets = singleSamplePackets(3000, 50'000'000);
+    const auto restarted = singleSamplePackets(2000, 1'000);
+    packets.insert(packets.end(), restarted.begin(), restarted.end());
+    writeFile(path, buildNsx(true, packets));
+
+    {
+        auto reader = openContinuous(path);
+        ASSERT_EQ(reader.segments().size(), 2u);
+        EXPECT_EQ(reader.segments()[0].sample_count, 3000u);
+        EXPECT_EQ(reader.segments()[1].first_sample, 3000u);
+        EXPECT_EQ(reader.segments()[1].first_timestamp, 1'000u);
+
+        EXPECT_TRUE(reader.view(2990, 20).isError());
+        std::vector<int16_t> samples(20 * CHANNELS);
+        std::vector<uint64_t> timestamps(20);
+        auto r = reader.readSamples({}, 2990, 20, samples.data(), timestamps.data());
+        ASSERT_TRUE(r.isOk()) << r.error();
+        for (uint32_t i = 0; i < 20; ++i) {
+            EXPECT_EQ(samples[i * CHANNELS + 2], valueAt(2990 + i, 2));
+            EXPECT_EQ(timestamps[i], packets[2990 + i].timestamp);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+TEST(ContinuousFileReaderTest, ReadsNsx22MultiSamplePackets) {
+    const std::string path = tempPath("cerelink_reader_v22.ns5");
+    writeFile(path, buildNsx(false, {{100, 1000}, {90000, 2000}}));
+
+    {
+        auto reader = openContinuous(path);
+        EXPECT_EQ(reader.timeResolution(), 30000u);
+        EXPECT_EQ(reader.sampleCount(), 3000u);
+        ASSERT_EQ(reader.segments().size(), 2u);
+        EXPECT_EQ(reader.segments()[0].last_timestamp, 1099u);
+        EXPECT_EQ(reader.segments()[1].last_timestamp, 91999u);
+
+        auto range = reader.findRange(1050, 90010);
+        ASSERT_TRUE(range.isOk());
+        EXPECT_EQ(range.value().first, 950u);
+        EXPECT_EQ(range.value().count, 60u);
+
+        // Rows of a multi-sample packet are contiguous
+        auto view = reader.view(1000, 2000);
+        ASSERT_TRUE(view.isOk()) << view.error();
+        EXPECT_EQ(view.value().row_stride, CHANNELS * sizeof(int16_t));
+        EXPECT_EQ(view.value().sample(1999, 1), valueAt(2999, 1));
+
+        std::vector<int16_t> samples(60 * CHANNELS);
+        std::vector<uint64_t> timestamps(60);
+        ASSERT_TRUE(reader.readSamples({}, 950, 60, samples.data(), timestamps.data()).isOk());
+        EXPECT_EQ(samples[0], valueAt(950, 0));
+        EXPECT_EQ(samples.back(), valueAt(1009, CHANNELS - 1));
+        EXPECT_EQ(timestamps[49], 1099u);
+        EXPECT_EQ(timestamps[50], 90000u);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(ContinuousFileReaderTest, ReadsUnterminatedPacketToEndOfFile) {
+    // Central leaves num_points at 0 when a recording is cut short
+    const std::string path = tempPath("cerelink_reader_open_ended.ns5");
+    writeFile(path, buildNsx(false, {{0, 0}}, 777));
+
+    {
+        auto reader = openContinuous(path);
+        EXPECT_EQ(reader.sampleCount(), 777u);
+        EXPECT_EQ(reader.findRange(700, UINT64_MAX).value().count, 77u);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(ContinuousFileReaderTest, RejectsBadRequests) {
+    const std::string path = tempPath("cerelink_reader_errors.ns5");
+    writeFile(path, buildNsx(true, singleSamplePackets(100)));
+
+    {
+        auto reader = openContinuous(path);
+        int16_t sample = 0;
+        EXPECT_TRUE(reader.readSamples({99}, 0, 1, &sample, nullptr).isError());
+        EXPECT_TRUE(reader.readSamples({}, 90, 20, nullptr, nullptr).isError());
+        EXPECT_TRUE(reader.view(101, 0).isError());
+        EXPECT_TRUE(reader.read({99}, 0, UINT64_MAX).isError());
+    }
+    std::remove(path.c_str());
+
+    EXPECT_TRUE(ContinuousFileReader::open(path).isError());
+    writeFile(path, std::vector<uint8_t>(400, 'x'));
+    EXPECT_TRUE(ContinuousFileReader::open(path).isError());
+    std::remove(path.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Compressed
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ContinuousFileReaderTest, ReadsCompressedFiles) {
+    const std::string path = tempPath("cerelink_reader.cbz5");
+    const uint32_t n = 10000;
+    const auto packets = singleSamplePackets(n);
+    std::vector<uint8_t> out;
+    auto encoder = ContinuousEncoder::create({10, 11, 12, 13, 14}, 1, "30 kS/s", out, 1024);
+    ASSERT_TRUE(encoder.isOk()) << encoder.error();
+    std::vector<int16_t> frame(CHANNELS);
+    for (uint32_t r = 0; r < n; ++r) {
+        for (uint32_t c = 0; c < CHANNELS; ++c) {
+            frame[c] = valueAt(r, c);
+        }
+        encoder.value().push(packets[r].timestamp, frame.data(), out);
+    }
+    encoder.value().finish(out);
+    writeFile(path, out);
+
+    {
+        auto reader = openContinuous(path);
+        EXPECT_TRUE(reader.isCompressed());
+        EXPECT_EQ(reader.label(), "30 kS/s");
+        EXPECT_EQ(reader.sampleCount(), n);
+        EXPECT_EQ(reader.segments().size(), 10u);
+        EXPECT_TRUE(reader.view(0, 1).isError());
+
+        auto data = reader.read({14, 11}, packets[1000].timestamp, packets[6000].timestamp);
+        ASSERT_TRUE(data.isOk()) << data.error();
+        ASSERT_EQ(data.value().timestamps.size(), 5000u);
+        for (uint32_t i = 0; i < 5000; i += 499) {
+            EXPECT_EQ(data.value().samples[i * 2], valueAt(1000 + i, 4));
+            EXPECT_EQ(data.value().samples[i * 2 + 1], valueAt(1000 + i, 1));
+            EXPECT_EQ(data.value().timestamps[i], packets[1000 + i].timestamp);
+        }
+    }
+    std::remove(path.c_str());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// NEV
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Both NEV versions, with and without a partial trailing packet
+class EventFileReaderTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(EventFileReaderTest, FindsAndFiltersPackets) {
+    const bool v30 = GetParam();
+    const std::string path = tempPath(v30 ? "cerelink_reader_v30.nev" : "cerelink_reader_v2.nev");
+    const uint32_t n = 5000;
+    const uint32_t packet_size = v30 ? 104 : 40;
+    auto bytes = buildNev(v30, n, packet_size);
+    bytes.resize(bytes.size() + packet_size / 2);     // torn final packet
+    writeFile(path, bytes);
+
+    {
+        auto opened = EventFileReader::open(path);
+        ASSERT_TRUE(opened.isOk()) << opened.error();
+        const auto& reader = opened.value();
+        EXPECT_EQ(reader.packetCount(), n);
+        EXPECT_EQ(reader.packetSize(), packet_size);
+        EXPECT_EQ(reader.waveformSamples(), (packet_size - (v30 ? 12u : 8u)) / 2);
+        EXPECT_EQ(reader.timestamp(4321), 3u * 4321 + 100);
+
+        // Ranges on both sides of sparse index entries
+        for (const uint32_t i : {0u, 1023u, 1024u, 1025u, 4999u}) {
+            const auto range = reader.findRange(3 * i + 100, 3 * i + 101);
+            EXPECT_EQ(range.first, i);
+            EXPECT_EQ(range.count, 1u);
+            EXPECT_EQ(reader.findRange(3 * i + 99, 3 * i + 100).first, i);
+        }
+        EXPECT_EQ(reader.findRange(0, 100).count, 0u);
+        EXPECT_EQ(reader.findRange(UINT64_MAX - 1, UINT64_MAX).first, n);
+
+        const auto spikes = reader.read({2}, 3 * 1000 + 100, 3 * 1100 + 100);
+        ASSERT_EQ(spikes.timestamps.size(), 50u);   // odd indices 1001..1099
+        EXPECT_EQ(spikes.timestamps[0], 3u * 1001 + 100);
+        EXPECT_EQ(spikes.packet_ids[0], 2);
+        EXPECT_EQ(spikes.units[0], 1001 % 4);
+        EXPECT_EQ(spikes.waveforms.size(), spikes.timestamps.size() * reader.waveformSamples());
+        EXPECT_EQ(spikes.waveforms[reader.waveformSamples() + 3], 1003 + 3);
+
+        const auto digital = reader.read({0}, 0, UINT64_MAX);
+        EXPECT_EQ(digital.timestamps.size(), n / 10);
+        EXPECT_TRUE(reader.readPackets({}, n, 1).isError());
+    }
+    std::remove(path.c_str());
+}
+
+INSTANTIATE_TEST_SUITE_P(Versions, EventFileReaderTest, ::testing::Bool());
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// C API
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(FileReaderCApiTest, ReadsThroughHandles) {
+    const std::string nsx_path = tempPath("cerelink_reader_capi.ns5");
+    const std::string nev_path = tempPath("cerelink_reader_capi.nev");
+    const auto packets = singleSamplePackets(300);
+    writeFile(nsx_path, buildNsx(true, packets));
+    writeFile(nev_path, buildNev(true, 50, 104));
+
+    cbsdk_continuous_reader_t continuous = nullptr;
+    ASSERT_EQ(cbsdk_continuous_reader_open(nsx_path.c_str(), &continuous), CBSDK_RESULT_SUCCESS);
+    cbsdk_continuous_file_info_t info{};
+    ASSERT_EQ(cbsdk_continuous_reader_get_info(continuous, &info), CBSDK_RESULT_SUCCESS);
+    EXPECT_EQ(info.channel_count, CHANNELS);
+    EXPECT_EQ(info.sample_count, 300u);
+    EXPECT_EQ(info.segment_count, 1u);
+    EXPECT_FALSE(info.compressed);
+
+    uint16_t ids[8] = {};
+    uint32_t n_ids = 8;
+    ASSERT_EQ(cbsdk_continuous_reader_get_channel_ids(continuous, ids, &n_ids), CBSDK_RESULT_SUCCESS);
+    EXPECT_EQ(n_ids, CHANNELS);
+    EXPECT_EQ(ids[4], 14);
+
+    uint64_t first = 0;
+    uint64_t count = 0;
+    ASSERT_EQ(cbsdk_continuous_reader_find_range(continuous, packets[100].timestamp, packets[110].timestamp,
+                                                 &first, &count), CBSDK_RESULT_SUCCESS);
+    EXPECT_EQ(first, 100u);
+    EXPECT_EQ(count, 10u);
+
+    const uint16_t wanted[] = {12};
+    int16_t samples[10] = {};
+    uint64_t timestamps[10] = {};
+    ASSERT_EQ(cbsdk_continuous_reader_read(continuous, wanted, 1, first, count, samples, timestamps),
+              CBSDK_RESULT_SUCCESS);
+    EXPECT_EQ(samples[9], valueAt(109, 2));
+    EXPECT_EQ(timestamps[0], packets[100].timestamp);
+    const uint16_t missing[] = {99};
+    EXPECT_EQ(cbsdk_continuous_reader_read(continuous, missing, 1, 0, 1, samples, nullptr),
+              CBSDK_RESULT_INVALID_PARAMETER);
+
+    const void* data = nullptr;
+    size_t stride = 0;
+    ASSERT_EQ(cbsdk_continuous_reader_view(continuous, first, count, &data, &stride), CBSDK_RESULT_SUCCESS);
+    int16_t sample = 0;
+    std::memcpy(&sample, static_cast<const uint8_t*>(data) + 9 * stride + 2 * sizeof(int16_t), sizeof(sample));
+    EXPECT_EQ(sample, valueAt(109, 2));
+    cbsdk_continuous_reader_close(continuous);
+
+    cbsdk_event_reader_t events = nullptr;
+    ASSERT_EQ(cbsdk_event_reader_open(nev_path.c_str(), &events), CBSDK_RESULT_SUCCESS);
+    cbsdk_event_file_info_t event_info{};
+    ASSERT_EQ(cbsdk_event_reader_get_info(events, &event_info), CBSDK_RESULT_SUCCESS);
+    EXPECT_EQ(event_info.packet_count, 50u);
+    EXPECT_EQ(event_info.waveform_samples, 46u);
+    ASSERT_EQ(cbsdk_event_reader_find_range(events, 0, UINT64_MAX, &first, &count), CBSDK_RESULT_SUCCESS);
+    EXPECT_EQ(count, 50u);
+    const uint16_t digital[] = {0};
+    uint64_t event_ts[50] = {};
+    uint16_t event_ids[50] = {};
+    uint64_t n_out = 0;
+    ASSERT_EQ(cbsdk_event_reader_read(events, first, count, digital, 1, event_ts, event_ids, nullptr, nullptr,
+                                      &n_out), CBSDK_RESULT_SUCCESS);
+    EXPECT_EQ(n_out, 5u);
+    EXPECT_EQ(event_ts[1], 3u * 10 + 100);
+    cbsdk_event_reader_close(events);
+
+    std::remove(nsx_path.c_str());
+    std::remove(nev_path.c_str());
+}
@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_filter_bank.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for host-side biquad filter design and the streaming filter bank
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/filter_bank.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+constexpr double FS = 30000.0;
+constexpr double PI = 3.14159265358979323846;
+
+/// Gain at a -3 dB corner
+constexpr double HALF_POWER = 0.70710678118654752440;
+
+std::vector<Biquad> design(const FilterSpec& spec) {
+    auto sections = designFilter(spec, FS);
+    EXPECT_TRUE(sections.isOk()) << sections.error();
+    return sections.isOk() ? sections.value() : std::vector<Biquad>{};
+}
+
+/// Direct-form cascade, one channel at a time: the reference for the vectorised bank
+std::vector<double> referenceFilter(const std::vector<Biquad>& sections, const std::vector<int16_t>& rows,
+                                    const size_t channels) {
+    const size_t n = rows.size() / channels;
+    std::vector<double> out(rows.size());
+    for (size_t c = 0; c < channels; ++c) {
+        std::vector<double> x(n);
+        for (size_t r = 0; r < n; ++r) {
+            x[r] = rows[r * channels + c];
+        }
+        for (const auto& q : sections) {
+            double x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+            for (size_t r = 0; r < n; ++r) {
+                const double y = q.b0 * x[r] + q.b1 * x1 + q.b2 * x2 - q.a1 * y1 - q.a2 * y2;
+                x2 = x1;
+                x1 = x[r];
+                y2 = y1;
+                y1 = y;
+                x[r] = y;
+            }
+        }
+        for (size_t r = 0; r < n; ++r) {
+            out[r * channels + c] = x[r];
+        }
+    }
+    return out;
+}
+
+/// @p n rows of @p channels sinusoids at @p freq_hz
+std::vector<int16_t> sine(const size_t n, const size_t channels, const double freq_hz, const double amplitude) {
+    std::vector<int16_t> rows(n * channels);
+    for (size_t r = 0; r < n; ++r) {
+        const auto v = static_cast<int16_t>(std::lround(amplitude * std::sin(2.0 * PI * freq_hz * r / FS)));
+        for (size_t c = 0; c < channels; ++c) {
+            rows[r * channels + c] = v;
+        }
+    }
+    return rows;
+}
+
+/// Largest magnitude over the last @p tail rows of channel 0
+int maxTail(const std::vector<int16_t>& rows, const size_t channels, const size_t tail) {
+    int peak = 0;
+    for (size_t r = rows.size() / channels - tail; r < rows.size() / channels; ++r) {
+        peak = std::max(peak, std::abs(static_cast<int>(rows[r * channels])));
+    }
+    return peak;
+}
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Design
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(FilterDesignTest, ButterworthCornersAreMinus3dB) {
+    for (const uint32_t order : {1u, 2u, 3u, 4u, 7u}) {
+        FilterSpec lp;
+        lp.lpfreq = 1000000;
+        lp.lporder = order;
+        const auto low = design(lp);
+        EXPECT_EQ(low.size(), (order + 1) / 2);
+        EXPECT_NEAR(filterMagnitude(low, 0.0, FS), 1.0, 1e-9);
+        EXPECT_NEAR(filterMagnitude(low, 1000.0, FS), HALF_POWER, 1e-6) << "order " << order;
+        EXPECT_LT(filterMagnitude(low, 10000.0, FS), 0.3);
+
+        FilterSpec hp;
+        hp.hpfreq = 250000;
+        hp.hporder = order;
+        const auto high = design(hp);
+        EXPECT_NEAR(filterMagnitude(high, 0.0, FS), 0.0, 1e-9);
+        EXPECT_NEAR(filterMagnitude(high, 250.0, FS), HALF_POWER, 1e-6) << "order " << order;
+        EXPECT_NEAR(filterMagnitude(high, 5000.0, FS), 1.0, 0.01);
+    }
+}
+
+TEST(FilterDesignTest, NotchRejectsCentreAndPassesElsewhere) {
+    FilterSpec spec;
+    spec.notch_freq = 60000;
+    spec.notch_bandwidth = 2000;
+    const auto sections = design(spec);
+    ASSERT_EQ(sections.size(), 1u);
+    EXPECT_LT(filterMagnitude(sections, 60.0, FS), 1e-9);
+    EXPECT_NEAR(filterMagnitude(sections, 59.0, FS), HALF_POWER, 0.01);
+    EXPECT_NEAR(filterMagnitude(sections, 61.0, FS), HALF_POWER, 0.01);
+    EXPECT_NEAR(filterMagnitude(sections, 1000.0, FS), 1.0, 1e-3);
+}
+
+TEST(FilterDesignTest, BandPassCombinesStagesInOrder) {
+    FilterSpec spec;
+    spec.hpfreq = 300000;
+    spec.hporder = 2;
+    spec.lpfreq = 6000000;
+    spec.lporder = 3;
+    spec.notch_freq = 60000;
+    const auto sections = design(spec);
+    EXPECT_EQ(sections.size(), 1u + 2u + 1u);
+    EXPECT_NEAR(filterMagnitude(sections, 1500.0, FS), 1.0, 0.01);
+    EXPECT_LT(filterMagnitude(sections, 60.0, FS), 1e-6);
+    EXPECT_TRUE(design(FilterSpec{}).empty());
+}
+
+TEST(FilterDesignTest, RejectsUnsupportedDesigns) {
+    FilterSpec spec;
+    spec.lpfreq = 1000000;
+    spec.lporder = 0;
+    EXPECT_TRUE(designFilter(spec, FS).isError());
+    spec.lporder = FILTER_MAX_ORDER + 1;
+    EXPECT_TRUE(designFilter(spec, FS).isError());
+    spec.lporder = 2;
+    spec.lptype = cbFILTTYPE_CHEBYCHEV;
+    EXPECT_TRUE(designFilter(spec, FS).isError());
+    spec.lptype = cbFILTTYPE_DIGITAL | cbFILTTYPE_BUTTERWORTH;
+    EXPECT_TRUE(designFilter(spec, FS).isOk());
+    spec.lpfreq = 15000000;
+    EXPECT_TRUE(designFilter(spec, FS).isError());
+    EXPECT_TRUE(designFilter(spec, 0.0).isError());
+}
+
+TEST(FilterDesignTest, ReadsDeviceFilterFields) {
+    cbPKT_FILTINFO info{};
+    info.hpfreq = 250000;
+    info.hporder = 4;
+    info.hptype = cbFILTTYPE_BUTTERWORTH;
+    info.lpfreq = 7500000;
+    info.lporder = 3;
+    info.lptype = cbFILTTYPE_BUTTERWORTH;
+    const auto spec = FilterSpec::fromFiltInfo(info);
+    EXPECT_EQ(spec.hpfreq, 250000u);
+    EXPECT_EQ(spec.lporder, 3u);
+    EXPECT_EQ(spec.notch_freq, 0u);
+    EXPECT_EQ(design(spec).size(), 2u + 2u);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Filter bank
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(BiquadFilterBankTest, MatchesPerChannelReferenceAcrossBatches) {
+    FilterSpec spec;
+    spec.hpfreq = 250000;
+    spec.hporder = 3;
+    spec.lpfreq = 5000000;
+    spec.lporder = 4;
+    spec.notch_freq = 60000;
+    const auto sections = design(spec);
+
+    const size_t channels = 7;      // odd: exercises the padded SIMD lane
+    const size_t n = 3000;
+    std::mt19937 rng(3);
+    std::normal_distribution<double> noise(0.0, 2000.0);
+    std::vector<int16_t> rows(n * channels);
+    for (auto& v : rows) {
+        v = static_cast<int16_t>(std::lround(std::clamp(noise(rng), -32768.0, 32767.0)));
+    }
+    const auto expected = referenceFilter(sections, rows, channels);
+
+    auto bank = BiquadFilterBank::create(sections, channels);
+    ASSERT_TRUE(bank.isOk()) << bank.error();
+    std::vector<float> filtered(rows.size());
+    std::vector<int16_t> rounded(rows.size());
+    auto copy = BiquadFilterBank::create(sections, channels);
+    for (size_t r = 0, batch = 1; r < n; r += batch, batch = batch % 37 + 1) {
+        const size_t m = std::min(batch, n - r);
+        bank.value().process(&rows[r * channels], m, &filtered[r * channels]);
+        copy.value().process(&rows[r * channels], m, &rounded[r * channels]);
+    }
+    for (size_t i = 0; i < rows.size(); ++i) {
+        ASSERT_NEAR(filtered[i], expected[i], 1e-2) << "sample " << i;
+        ASSERT_NEAR(rounded[i], std::clamp(expected[i], -32768.0, 32767.0), 0.5 + 1e-6) << "sample " << i;
+    }
+}
+
+TEST(BiquadFilterBankTest, NotchRemovesLineNoise) {
+    FilterSpec spec;
+    spec.notch_freq = 60000;
+    auto bank = BiquadFilterBank::create(design(spec), 3);
+    ASSERT_TRUE(bank.isOk());
+
+    // A 2 Hz wide notch settles with a time constant of about 1 / (pi * 2 Hz)
+    auto hum = sine(60000, 3, 60.0, 1000.0);
+    bank.value().process(hum.data(), 60000, hum.data());
+    EXPECT_LE(maxTail(hum, 3, 3000), 2);
+
+    bank.value().reset();
+    auto tone = sine(30000, 3, 1000.0, 1000.0);
+    bank.value().process(tone.data(), 30000, tone.data());
+    EXPECT_NEAR(maxTail(tone, 3, 3000), 1000, 5);
+}
+
+TEST(BiquadFilterBankTest, SaturatesAndResets) {
+    Biquad gain;
+    gain.b0 = 4.0;
+    auto bank = BiquadFilterBank::create({gain}, 2);
+    ASSERT_TRUE(bank.isOk());
+    const std::vector<int16_t> in = {20000, -20000, 100, -101};
+    std::vector<int16_t> out(4);
+    bank.value().process(in.data(), 2, out.data());
+    EXPECT_EQ(out, (std::vector<int16_t>{32767, -32768, 400, -404}));
+
+    // reset() makes a stateful cascade repeat itself exactly
+    FilterSpec spec;
+    spec.hpfreq = 1000000;
+    spec.hporder = 2;
+    auto hp = BiquadFilterBank::create(design(spec), 2);
+    const auto step = std::vector<int16_t>(200, 5000);
+    std::vector<int16_t> first(200);
+    std::vector<int16_t> second(200);
+    hp.value().process(step.data(), 100, first.data());
+    hp.value().reset();
+    hp.value().process(step.data(), 100, second.data());
+    EXPECT_EQ(first, second);
+
+    EXPECT_TRUE(BiquadFilterBank::create({}, 0).isError());
+    auto passthrough = BiquadFilterBank::create({}, 2);
+    passthrough.value().process(in.data(), 2, out.data());
+    EXPECT_EQ(out, in);
+}
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_latency_histogram.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for cbutil::LatencyHistogram
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbutil/latency_histogram.h>
+#include <cstdint>
+
+using cbutil::LatencyHistogram;
+
+TEST(LatencyHistogramTest, EmptyHistogramReadsZero) {
+    LatencyHistogram h;
+    EXPECT_EQ(h.count(), 0u);
+    EXPECT_EQ(h.min(), 0u);
+    EXPECT_EQ(h.max(), 0u);
+    EXPECT_EQ(h.mean(), 0.0);
+    EXPECT_EQ(h.valueAtPercentile(50), 0u);
+}
+
+TEST(LatencyHistogramTest, BinsAreContiguousAndBounded) {
+    // Every value lands in a bin whose upper edge is >= the value and within ~1/16 of it
+    for (uint64_t v = 0; v < 1'000'000; v = v < 64 ? v + 1 : v + v / 7) {
+        const size_t i = LatencyHistogram::bucketIndex(v);
+        ASSERT_LT(i, LatencyHistogram::BUCKET_COUNT);
+        const uint64_t edge = LatencyHistogram::bucketUpperEdge(i);
+        EXPECT_GE(edge, v);
+        EXPECT_LE(edge - v, v / 16 + 1) << "v=" << v;
+        if (i > 0) {
+            EXPECT_LT(LatencyHistogram::bucketUpperEdge(i - 1), v) << "v=" << v;
+        }
+    }
+    // Around each power of two, including those past 32 bits
+    for (unsigned bit = LatencyHistogram::SUB_BUCKET_BITS; bit < LatencyHistogram::MAX_VALUE_BITS; ++bit) {
+        for (const uint64_t v : {(uint64_t{1} << bit) - 1, uint64_t{1} << bit, (uint64_t{1} << bit) + 1}) {
+            const uint64_t edge = LatencyHistogram::bucketUpperEdge(LatencyHistogram::bucketIndex(v));
+            EXPECT_GE(edge, v);
+            EXPECT_LE(edge - v, v / 16 + 1) << "v=" << v;
+        }
+    }
+    EXPECT_LT(LatencyHistogram::bucketIndex(LatencyHistogram::MAX_VALUE), LatencyHistogram::BUCKET_COUNT);
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformValues) {
+    LatencyHistogram h;
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        h.record(v * 1000);  // 1 us .. 10 ms
+    }
+    EXPECT_EQ(h.count(), 10000u);
+    EXPECT_EQ(h.min(), 1000u);
+    EXPECT_EQ(h.max(), 10'000'000u);
+    EXPECT_NEAR(h.mean(), 5'000'500.0, 1.0);
+
+    EXPECT_NEAR(static_cast<double>(h.valueAtPercentile(50)), 5e6, 5e6 * 0.07);
+    EXPECT_NEAR(static_cast<double>(h.valueAtPercentile(99)), 9.9e6, 9.9e6 * 0.07);
+    EXPECT_EQ(h.valueAtPercentile(100), h.max());
+    EXPECT_LE(h.valueAtPercentile(0), 1100u);
+}
+
+TEST(LatencyHistogramTest, ClampsAndResets) {
+    LatencyHistogram h;
+    h.record(UINT64_MAX);
+    EXPECT_EQ(h.max(), LatencyHistogram::MAX_VALUE);
+    EXPECT_EQ(h.valueAtPercentile(50), LatencyHistogram::MAX_VALUE);
+
+    h.reset();
+    EXPECT_EQ(h.count(), 0u);
+    h.record(7);
+    EXPECT_EQ(h.min(), 7u);
+    EXPECT_EQ(h.max(), 7u);
+    EXPECT_EQ(h.valueAtPercentile(99.9), 7u);
+}
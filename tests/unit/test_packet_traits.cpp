@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_packet_traits.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for table-driven packet classification
+///
+/// The traits table replaces hand-written `(type & 0xF0) == ...` chains, so these tests pin
+/// the table against the packet type constants and check that data packets are never
+/// mistaken for configuration packets that happen to share a type code.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbproto/packet_traits.h>
+#include <cbproto/packet_translator.h>
+#include <cstring>
+#include <vector>
+
+using namespace cbproto;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Classification Tests
+/// @{
+
+TEST(PacketTraitsTest, ClassifyByChid) {
+    EXPECT_EQ(classifyPacket(0), PacketClass::GROUP);
+    EXPECT_EQ(classifyPacket(1), PacketClass::EVENT);
+    EXPECT_EQ(classifyPacket(cbMAXCHANS), PacketClass::EVENT);
+    EXPECT_EQ(classifyPacket(cbPKTCHAN_CONFIGURATION), PacketClass::CONFIG);
+    EXPECT_EQ(classifyPacket(cbPKTCHAN_CONFIGURATION | 0x0012), PacketClass::CONFIG);
+}
+
+TEST(PacketTraitsTest, DataPacketsIgnoreType) {
+    // Group 1 shares type code 0x01 with SYSPROTOCOLMONITOR; spike unit 0x12 with SYSREPRUNLEV
+    const auto& group = packetTraits(0, cbPKTTYPE_SYSPROTOCOLMONITOR);
+    EXPECT_EQ(group.cls, PacketClass::GROUP);
+    EXPECT_EQ(group.slot, ConfigSlot::NONE);
+    EXPECT_EQ(group.from_410, PayloadXlate::NONE);
+
+    const auto& event = packetTraits(5, cbPKTTYPE_SYSREPRUNLEV);
+    EXPECT_EQ(event.cls, PacketClass::EVENT);
+    EXPECT_EQ(event.slot, ConfigSlot::NONE);
+}
+
+TEST(PacketTraitsTest, ConfigFamiliesMapToSlots) {
+    for (uint16_t type = cbPKTTYPE_SYSREP; type < cbPKTTYPE_SYSREP + 0x10; ++type) {
+        EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, type).slot, ConfigSlot::SYSINFO) << type;
+    }
+    for (uint16_t type = cbPKTTYPE_CHANREP; type < cbPKTTYPE_CHANREP + 0x10; ++type) {
+        EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, type).slot, ConfigSlot::CHANINFO) << type;
+    }
+    EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_PROCREP).slot, ConfigSlot::PROCINFO);
+    EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_GROUPREP).slot, ConfigSlot::GROUPINFO);
+    EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_NPLAYREP).slot, ConfigSlot::NPLAY);
+    EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_SS_MODELREP).slot, ConfigSlot::SS_MODEL);
+    // Requests are never stored
+    EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_CHANSET).slot, ConfigSlot::NONE);
+    EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_SYSSETRUNLEV).slot, ConfigSlot::NONE);
+    // Out-of-table types fall back to an unstored config entry
+    EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, 0x1FF).cls, PacketClass::CONFIG);
+    EXPECT_EQ(packetTraits(cbPKTCHAN_CONFIGURATION, 0x1FF).slot, ConfigSlot::NONE);
+}
+
+TEST(PacketTraitsTest, DlenRanges) {
+    const auto& chan = packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_CHANREP);
+    EXPECT_TRUE(chan.dlenInRange(cbPKTDLEN_CHANINFO));
+    EXPECT_TRUE(chan.dlenInRange(cbPKTDLEN_CHANINFOSHORT));
+    EXPECT_FALSE(chan.dlenInRange(cbPKTDLEN_CHANINFOSHORT - 1));
+    EXPECT_TRUE(chan.dlenInRange(cbPKTDLEN_CHANINFO + 1));    // Fields appended by newer firmware
+
+    const auto& sys = packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_SYSREPRUNLEV);
+    EXPECT_TRUE(sys.dlenInRange(cbPKTDLEN_SYSINFO));
+    EXPECT_FALSE(sys.dlenInRange(cbPKTDLEN_SYSINFO - 1));
+    EXPECT_TRUE(sys.dlenInRange(MAX_PACKET_DLEN));
+
+    EXPECT_TRUE(packetTraits(0, 1).dlenInRange(0));
+    EXPECT_TRUE(packetTraits(7, 0).dlenInRange(MAX_PACKET_DLEN));
+}
+
+TEST(PacketTraitsTest, CopyConfigPacketTruncatesToTheShorter) {
+    // A longer reply: the struct's prefix is stored, the appended words are not
+    std::vector<uint32_t> words(cbPKT_HEADER_32SIZE + cbPKTDLEN_SYSINFO + 4, 0xA5A5A5A5u);
+    cbPKT_SYSINFO sent = {};
+    sent.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    sent.cbpkt_header.type = cbPKTTYPE_SYSREP;
+    sent.cbpkt_header.dlen = cbPKTDLEN_SYSINFO + 4;
+    sent.sysfreq = 30000;
+    std::memcpy(words.data(), &sent, sizeof(sent));
+    cbPKT_SYSINFO stored = {};
+    copyConfigPacket(reinterpret_cast<const uint8_t*>(words.data()), stored);
+    EXPECT_EQ(std::memcmp(&stored, &sent, sizeof(sent)), 0);
+
+    // A short reply: the tail of the stored struct is left as it was
+    cbPKT_GROUPINFO group = {};
+    group.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    group.cbpkt_header.type = cbPKTTYPE_GROUPREP;
+    group.cbpkt_header.dlen = cbPKTDLEN_GROUPINFOSHORT + 1;
+    group.length = 2;
+    group.list[0] = 7;
+    group.list[1] = 8;
+    cbPKT_GROUPINFO known = {};
+    known.list[cbNUM_ANALOG_CHANS - 1] = 99;
+    copyConfigPacket(reinterpret_cast<const uint8_t*>(&group), known);
+    EXPECT_EQ(known.length, 2u);
+    EXPECT_EQ(known.list[1], 8u);
+    EXPECT_EQ(known.list[cbNUM_ANALOG_CHANS - 1], 99u);
+}
+
+TEST(PacketTraitsTest, TranslationFlagsMatchVersions) {
+    const auto& mon = packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_SYSPROTOCOLMONITOR);
+    EXPECT_EQ(mon.from_311, PayloadXlate::PROTOCOL_MONITOR);
+    EXPECT_EQ(mon.from_400, PayloadXlate::PROTOCOL_MONITOR);
+    EXPECT_EQ(mon.from_410, PayloadXlate::PREVLNC_TYPE);
+
+    const auto& chanset = packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_CHANSETSMP);
+    EXPECT_EQ(chanset.to_311, PayloadXlate::CHANINFO);
+    EXPECT_EQ(chanset.to_400, PayloadXlate::CHANINFO);
+    EXPECT_EQ(chanset.to_410, PayloadXlate::NONE);
+
+    const auto& comment = packetTraits(cbPKTCHAN_CONFIGURATION, cbPKTTYPE_COMMENTREP);
+    EXPECT_EQ(comment.from_311, PayloadXlate::COMMENT);
+    EXPECT_EQ(comment.from_400, PayloadXlate::NONE);
+}
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Translator Routing Tests
+/// @{
+
+TEST(PacketTraitsTest, Group1PacketNotRemappedFrom410) {
+    // A group-1 sample packet (chid 0, type 0x01) must pass through untouched
+    cbPKT_GENERIC pkt = {};
+    pkt.cbpkt_header.chid = 0;
+    pkt.cbpkt_header.type = 1;
+    pkt.cbpkt_header.dlen = 4;
+
+    auto* bytes = reinterpret_cast<uint8_t*>(&pkt);
+    const size_t dlen = PacketTranslator::translatePayload_410_to_current(bytes, bytes);
+    EXPECT_EQ(dlen, 4u);
+    EXPECT_EQ(pkt.cbpkt_header.type, 1u);
+}
+
+TEST(PacketTraitsTest, Group1PacketCopiedVerbatimFrom400) {
+    // Pre-fix, this payload was parsed as a SYSPROTOCOLMONITOR and dlen grew by one
+    uint8_t src[HEADER_SIZE_400 + 16] = {};
+    for (size_t i = 0; i < 16; ++i) {
+        src[HEADER_SIZE_400 + i] = static_cast<uint8_t>(i + 1);
+    }
+    cbPKT_GENERIC dest = {};
+    dest.cbpkt_header.chid = 0;
+    dest.cbpkt_header.type = 1;
+    dest.cbpkt_header.dlen = 4;
+
+    const size_t dlen = PacketTranslator::translatePayload_400_to_current(
+        src, reinterpret_cast<uint8_t*>(&dest));
+    EXPECT_EQ(dlen, 4u);
+    EXPECT_EQ(std::memcmp(reinterpret_cast<uint8_t*>(&dest) + cbPKT_HEADER_SIZE,
+                          &src[HEADER_SIZE_400], 16), 0);
+}
+
+/// @}
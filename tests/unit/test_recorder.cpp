@@ -0,0 +1,350 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_recorder.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the NSx/NEV recorder and its aligned file writer
+///
+/// Packets are fed to cbsdk::Recorder directly and the files are parsed back with the
+/// structures from cbsdk/nsx_nev_format.h, so no device or session is needed.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/recorder.h>
+#include <cbsdk/continuous_codec.h>
+#include <cbsdk/nsx_nev_format.h>
+#include "aligned_file_writer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace cbsdk;
+using namespace cbsdk::fileformat;
+
+namespace {
+
+std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<uint8_t> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+template<typename T>
+T readAt(const std::vector<uint8_t>& bytes, size_t offset) {
+    T value{};
+    if (offset + sizeof(T) <= bytes.size()) {
+        std::memcpy(&value, &bytes[offset], sizeof(T));
+    }
+    return value;
+}
+
+RecordingChannel makeChannel(uint32_t chan, uint32_t caps, const char* label) {
+    RecordingChannel ch;
+    ch.info.chan = chan;
+    ch.info.bank = 1;
+    ch.info.term = chan;
+    ch.info.chancaps = cbCHAN_EXISTS | cbCHAN_CONNECTED | caps;
+    std::snprintf(ch.info.label, sizeof(ch.info.label), "%s", label);
+    ch.info.scalin = {-32764, 32764, -8191, 8191, 1, "uV"};
+    ch.continuous_filter.hpfreq = 300;
+    ch.continuous_filter.lpfreq = 7500000;
+    ch.spike_filter.hpfreq = 250000;
+    return ch;
+}
+
+cbPKT_GENERIC groupPacket(uint64_t time, uint8_t group, std::initializer_list<int16_t> samples) {
+    cbPKT_GENERIC pkt = {};
+    pkt.cbpkt_header.time = time;
+    pkt.cbpkt_header.chid = 0;
+    pkt.cbpkt_header.type = group;
+    pkt.cbpkt_header.dlen = static_cast<uint16_t>((samples.size() + 1) / 2);
+    auto& grp = reinterpret_cast<cbPKT_GROUP&>(pkt);
+    size_t i = 0;
+    for (const int16_t s : samples) grp.data[i++] = s;
+    return pkt;
+}
+
+cbPKT_GENERIC spikePacket(uint64_t time, uint16_t chan, uint8_t unit) {
+    cbPKT_GENERIC pkt = {};
+    pkt.cbpkt_header.time = time;
+    pkt.cbpkt_header.chid = chan;
+    pkt.cbpkt_header.type = unit;
+    pkt.cbpkt_header.dlen = cbPKTDLEN_SPK;
+    auto& spk = reinterpret_cast<cbPKT_SPK&>(pkt);
+    for (int i = 0; i < cbMAX_PNTS; ++i) spk.wave[i] = static_cast<int16_t>(i - 10);
+    return pkt;
+}
+
+cbPKT_GENERIC digitalPacket(uint64_t time, uint16_t chan, uint32_t value) {
+    cbPKT_GENERIC pkt = {};
+    pkt.cbpkt_header.time = time;
+    pkt.cbpkt_header.chid = chan;
+    pkt.cbpkt_header.dlen = (sizeof(cbPKT_DINP) - cbPKT_HEADER_SIZE) / 4;
+    reinterpret_cast<cbPKT_DINP&>(pkt).valueRead = value;
+    return pkt;
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// AlignedFileWriter
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+class AlignedFileWriterTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(AlignedFileWriterTest, WritesExactBytesAcrossBufferBoundaries) {
+    const auto path = tempPath("cbsdk_aligned_writer.bin");
+    std::vector<uint8_t> expected(3 * AlignedFileWriter::BLOCK_SIZE + 1234);
+    for (size_t i = 0; i < expected.size(); ++i) expected[i] = static_cast<uint8_t>(i * 7);
+
+    {
+        auto result = AlignedFileWriter::open(path, AlignedFileWriter::BLOCK_SIZE, GetParam());
+        ASSERT_TRUE(result.isOk()) << result.error();
+        auto& writer = result.value();
+        // Odd-sized appends so chunks straddle the buffer edge
+        for (size_t at = 0; at < expected.size(); at += 1000) {
+            const size_t n = std::min<size_t>(1000, expected.size() - at);
+            ASSERT_TRUE(writer.append(&expected[at], n));
+        }
+        EXPECT_EQ(writer.size(), expected.size());
+        EXPECT_TRUE(writer.finish());
+    }
+
+    EXPECT_EQ(readFile(path), expected);
+    std::remove(path.c_str());
+}
+
+INSTANTIATE_TEST_SUITE_P(DirectAndBuffered, AlignedFileWriterTest, ::testing::Bool());
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Recorder
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(RecorderTest, WritesNsxHeadersAndSamples) {
+    const auto base = tempPath("cbsdk_recorder_nsx");
+    RecordingLayout layout;
+    RecordingGroup group;
+    group.group_id = 5;
+    group.period = 1;
+    group.channels = {makeChannel(1, cbCHAN_AINP, "elec1"),
+                      makeChannel(2, cbCHAN_AINP, "elec2"),
+                      makeChannel(3, cbCHAN_AINP, "elec3")};
+    layout.groups.push_back(group);
+
+    {
+        auto result = Recorder::open(base, layout);
+        ASSERT_TRUE(result.isOk()) << result.error();
+        auto& recorder = result.value();
+        ASSERT_EQ(recorder.files().size(), 2u);
+        EXPECT_EQ(recorder.files()[1], base + ".ns5");
+
+        std::vector<cbPKT_GENERIC> packets;
+        for (int i = 0; i < 10; ++i) {
+            packets.push_back(groupPacket(1000 + i * 33333, 5,
+                                          {static_cast<int16_t>(i), static_cast<int16_t>(-i), 7, 0}));
+        }
+        packets.push_back(groupPacket(5000, 2, {1, 2}));   // not recorded
+        recorder.write(packets.data(), packets.size());
+        recorder.close();
+
+        const auto stats = recorder.stats();
+        EXPECT_EQ(stats.continuous_packets, 10u);
+        EXPECT_EQ(stats.packets_dropped, 0u);
+        EXPECT_EQ(stats.write_errors, 0u);
+    }
+
+    const auto bytes = readFile(base + ".ns5");
+    const auto basic = readAt<NsxBasicHeader>(bytes, 0);
+    EXPECT_EQ(std::memcmp(basic.file_type_id, NSX_FILE_TYPE_ID, 8), 0);
+    EXPECT_EQ(basic.major_version, 3);
+    EXPECT_EQ(basic.bytes_in_headers, sizeof(NsxBasicHeader) + 3 * sizeof(NsxChannelHeader));
+    EXPECT_EQ(basic.channel_count, 3u);
+    EXPECT_EQ(basic.period, 1u);
+    EXPECT_EQ(basic.time_resolution, 1'000'000'000u);
+    EXPECT_STREQ(basic.label, "30 kS/s");
+
+    const auto cc = readAt<NsxChannelHeader>(bytes, sizeof(NsxBasicHeader) + sizeof(NsxChannelHeader));
+    EXPECT_EQ(cc.type[0], 'C');
+    EXPECT_EQ(cc.electrode_id, 2);
+    EXPECT_STREQ(cc.label, "elec2");
+    EXPECT_EQ(cc.max_digital_value, 32764);
+    EXPECT_EQ(cc.max_analog_value, 8191);
+    EXPECT_STREQ(cc.units, "uV");
+    EXPECT_EQ(cc.low_freq_corner, 7500000u);
+
+    const size_t packet_size = sizeof(NsxDataHeader) + 3 * sizeof(int16_t);
+    ASSERT_EQ(bytes.size(), basic.bytes_in_headers + 10 * packet_size);
+    for (int i = 0; i < 10; ++i) {
+        const size_t at = basic.bytes_in_headers + i * packet_size;
+        const auto dh = readAt<NsxDataHeader>(bytes, at);
+        EXPECT_EQ(dh.header, 1);
+        EXPECT_EQ(dh.timestamp, 1000u + i * 33333u);
+        EXPECT_EQ(dh.num_points, 1u);
+        EXPECT_EQ(readAt<int16_t>(bytes, at + sizeof(dh)), i);
+        EXPECT_EQ(readAt<int16_t>(bytes, at + sizeof(dh) + 2), -i);
+        EXPECT_EQ(readAt<int16_t>(bytes, at + sizeof(dh) + 4), 7);
+    }
+    std::remove((base + ".ns5").c_str());
+    std::remove((base + ".nev").c_str());
+}
+
+TEST(RecorderTest, CompressesGroupsWhenRequested) {
+    const auto base = tempPath("cbsdk_recorder_cbz");
+    RecordingLayout layout;
+    RecordingGroup group;
+    group.group_id = 5;
+    group.channels = {makeChannel(1, cbCHAN_AINP, "elec1"), makeChannel(2, cbCHAN_AINP, "elec2")};
+    layout.groups.push_back(group);
+    RecordingOptions options;
+    options.compress_continuous = true;
+    options.compress_chunk_samples = 64;
+
+    const int rows = 1000;
+    {
+        auto result = Recorder::open(base, layout, options);
+        ASSERT_TRUE(result.isOk()) << result.error();
+        auto& recorder = result.value();
+        ASSERT_EQ(recorder.files().size(), 2u);
+        EXPECT_EQ(recorder.files()[1], base + ".cbz5");
+
+        std::vector<cbPKT_GENERIC> packets;
+        for (int i = 0; i < rows; ++i) {
+            packets.push_back(groupPacket(1000 + i * 33333, 5, {static_cast<int16_t>(i / 4), -5}));
+        }
+        packets.push_back(groupPacket(1000 + rows * 33333, 5, {77}));  // short packet: zero-filled
+        recorder.write(packets.data(), packets.size());
+        recorder.close();
+
+        const auto stats = recorder.stats();
+        EXPECT_EQ(stats.continuous_packets, rows + 1u);
+        EXPECT_EQ(stats.write_errors, 0u);
+        EXPECT_GT(stats.continuous_raw_bytes, 4 * stats.continuous_encoded_bytes);
+    }
+    EXPECT_FALSE(std::filesystem::exists(base + ".ns5"));
+
+    auto reader = ContinuousReader::open(base + ".cbz5");
+    ASSERT_TRUE(reader.isOk()) << reader.error();
+    EXPECT_TRUE(reader.value().hadIndex());
+    ASSERT_EQ(reader.value().sampleCount(), rows + 1u);
+    EXPECT_EQ(reader.value().channelIds(), (std::vector<uint16_t>{1, 2}));
+    std::vector<int16_t> samples((rows + 1) * 2);
+    std::vector<uint64_t> times(rows + 1);
+    ASSERT_TRUE(reader.value().read(0, rows + 1, samples.data(), times.data()).isOk());
+    for (int i = 0; i < rows; ++i) {
+        EXPECT_EQ(samples[i * 2], i / 4);
+        EXPECT_EQ(samples[i * 2 + 1], -5);
+        EXPECT_EQ(times[i], 1000u + i * 33333u);
+    }
+    EXPECT_EQ(samples[rows * 2], 77);
+    EXPECT_EQ(samples[rows * 2 + 1], 0);
+    std::remove((base + ".cbz5").c_str());
+    std::remove((base + ".nev").c_str());
+}
+
+TEST(RecorderTest, WritesSpikesAndDigitalEventsToNev) {
+    const auto base = tempPath("cbsdk_recorder_nev");
+    RecordingLayout layout;
+    layout.spike_length = 48;
+    layout.event_channels = {makeChannel(1, cbCHAN_AINP | cbCHAN_ISOLATED, "elec1"),
+                             makeChannel(151, cbCHAN_DINP, "digin")};
+
+    {
+        auto result = Recorder::open(base, layout);
+        ASSERT_TRUE(result.isOk()) << result.error();
+        auto& recorder = result.value();
+
+        std::vector<cbPKT_GENERIC> packets = {
+            spikePacket(100, 1, 2),
+            digitalPacket(200, 151, 0x1ABCD),
+            spikePacket(300, 3, 0),             // channel not in the layout
+        };
+        cbPKT_GENERIC config = {};
+        config.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+        config.cbpkt_header.type = cbPKTTYPE_SYSREP;
+        packets.push_back(config);
+        recorder.write(packets.data(), packets.size());
+        recorder.close();
+
+        const auto stats = recorder.stats();
+        EXPECT_EQ(stats.spike_packets, 1u);
+        EXPECT_EQ(stats.digital_packets, 1u);
+    }
+
+    const auto bytes = readFile(base + ".nev");
+    const auto basic = readAt<NevBasicHeader>(bytes, 0);
+    EXPECT_EQ(std::memcmp(basic.file_type_id, NEV_FILE_TYPE_ID, 8), 0);
+    EXPECT_EQ(basic.flags, NEV_FLAG_WAVEFORMS_16BIT);
+    EXPECT_EQ(basic.bytes_per_packet, sizeof(NevSpikePacket) + 48 * sizeof(int16_t));
+    EXPECT_EQ(basic.sample_resolution, 30000u);
+    EXPECT_STREQ(basic.application, "CereLink");
+    ASSERT_EQ(basic.extended_header_count, 4u);    // NEUEVWAV + NEUEVLBL + NEUEVFLT + DIGLABEL
+    EXPECT_EQ(basic.bytes_in_headers, sizeof(NevBasicHeader) + 4 * 32);
+
+    const auto wav = readAt<NevWaveformExtHeader>(bytes, sizeof(NevBasicHeader));
+    EXPECT_EQ(std::memcmp(wav.id, "NEUEVWAV", 8), 0);
+    EXPECT_EQ(wav.electrode_id, 1);
+    EXPECT_EQ(wav.digitization_factor, 250);       // 8191 uV / 32764 steps
+    EXPECT_EQ(wav.spike_width, 48);
+    const auto dig = readAt<NevDigitalLabelExtHeader>(bytes, sizeof(NevBasicHeader) + 3 * 32);
+    EXPECT_EQ(std::memcmp(dig.id, "DIGLABEL", 8), 0);
+    EXPECT_STREQ(dig.label, "digin");
+    EXPECT_EQ(dig.mode, 1);
+
+    ASSERT_EQ(bytes.size(), basic.bytes_in_headers + 2 * basic.bytes_per_packet);
+    const auto spike = readAt<NevSpikePacket>(bytes, basic.bytes_in_headers);
+    EXPECT_EQ(spike.header.timestamp, 100u);
+    EXPECT_EQ(spike.header.packet_id, 1);
+    EXPECT_EQ(spike.unit, 2);
+    EXPECT_EQ(readAt<int16_t>(bytes, basic.bytes_in_headers + sizeof(NevSpikePacket)), -10);
+    EXPECT_EQ(readAt<int16_t>(bytes, basic.bytes_in_headers + sizeof(NevSpikePacket) + 47 * 2), 37);
+
+    const auto digital = readAt<NevDigitalPacket>(bytes, basic.bytes_in_headers + basic.bytes_per_packet);
+    EXPECT_EQ(digital.header.timestamp, 200u);
+    EXPECT_EQ(digital.header.packet_id, 0);
+    EXPECT_EQ(digital.reason, NEV_DIGITAL_REASON_PARALLEL);
+    EXPECT_EQ(digital.value, 0xABCD);
+    std::remove((base + ".nev").c_str());
+}
+
+TEST(RecorderTest, DropsInsteadOfBlockingWhenBacklogIsFull) {
+    const auto base = tempPath("cbsdk_recorder_backlog");
+    RecordingLayout layout;
+    RecordingGroup group;
+    group.group_id = 5;
+    group.channels = {makeChannel(1, cbCHAN_AINP, "elec1"), makeChannel(2, cbCHAN_AINP, "elec2")};
+    layout.groups.push_back(group);
+
+    RecordingOptions options;
+    options.max_pending_bytes = 256;
+
+    auto result = Recorder::open(base, layout, options);
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& recorder = result.value();
+
+    // One batch is queued under a single lock, so most of it cannot fit
+    std::vector<cbPKT_GENERIC> packets(100, groupPacket(1, 5, {1, 2}));
+    recorder.write(packets.data(), packets.size());
+    recorder.close();
+
+    const auto stats = recorder.stats();
+    EXPECT_GT(stats.packets_dropped, 0u);
+    EXPECT_EQ(stats.continuous_packets + stats.packets_dropped, packets.size());
+    EXPECT_EQ(stats.pending_bytes, 0u);
+    std::remove((base + ".ns5").c_str());
+    std::remove((base + ".nev").c_str());
+}
+
+TEST(RecorderTest, FailsWhenFilesCannotBeCreated) {
+    const auto base = (std::filesystem::temp_directory_path() / "cbsdk_no_such_dir" / "rec").string();
+    auto result = Recorder::open(base, RecordingLayout{});
+    EXPECT_TRUE(result.isError());
+}
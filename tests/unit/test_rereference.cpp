@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_rereference.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for common average / median and electrode re-referencing
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/rereference.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+std::vector<int16_t> noise(const size_t n, const size_t channels, const uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(-8000, 8000);
+    std::vector<int16_t> rows(n * channels);
+    for (auto& v : rows) {
+        v = static_cast<int16_t>(dist(rng));
+    }
+    return rows;
+}
+
+/// Per-sample reference computed the slow way, in double
+std::vector<int16_t> referencePooled(const std::vector<int16_t>& rows, const std::vector<int32_t>& pools,
+                                     const ReferenceStatistic statistic) {
+    const size_t channels = pools.size();
+    const size_t n = rows.size() / channels;
+    std::vector<int16_t> out = rows;
+    for (size_t r = 0; r < n; ++r) {
+        for (size_t c = 0; c < channels; ++c) {
+            if (pools[c] < 0) continue;
+            std::vector<double> pool;
+            for (size_t k = 0; k < channels; ++k) {
+                if (pools[k] == pools[c]) pool.push_back(rows[r * channels + k]);
+            }
+            double ref = 0.0;
+            if (statistic == ReferenceStatistic::MEAN) {
+                for (const double v : pool) ref += v;
+                ref /= static_cast<double>(pool.size());
+            } else {
+                std::sort(pool.begin(), pool.end());
+                const size_t mid = pool.size() / 2;
+                ref = pool.size() % 2 ? pool[mid] : 0.5 * (pool[mid - 1] + pool[mid]);
+            }
+            const double v = std::clamp(rows[r * channels + c] - ref, -32768.0, 32767.0);
+            out[r * channels + c] = static_cast<int16_t>(std::lround(v));
+        }
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+TEST(RereferencerTest, CommonAverageMatchesReference) {
+    const size_t channels = 13;         // not a multiple of the SIMD width
+    const size_t n = 300;               // more rows than one transposed chunk
+    const auto rows = noise(n, channels, 1);
+    const std::vector<int32_t> pools(channels, 0);
+
+    auto car = Rereferencer::createPooled(pools, ReferenceStatistic::MEAN);
+    ASSERT_TRUE(car.isOk()) << car.error();
+    EXPECT_EQ(car.value().channelCount(), channels);
+    EXPECT_EQ(car.value().poolCount(), 1u);
+
+    auto out = rows;
+    car.value().process(out.data(), n);
+    const auto expected = referencePooled(rows, pools, ReferenceStatistic::MEAN);
+    for (size_t i = 0; i < out.size(); ++i) {
+        ASSERT_NEAR(out[i], expected[i], 1) << "sample " << i;
+    }
+
+    // After CAR every row sums to (about) zero
+    for (size_t r = 0; r < n; ++r) {
+        int sum = 0;
+        for (size_t c = 0; c < channels; ++c) sum += out[r * channels + c];
+        ASSERT_LE(std::abs(sum), static_cast<int>(channels));
+    }
+}
+
+TEST(RereferencerTest, BankMediansUseOnlyTheirOwnPool) {
+    // Two interleaved pools of odd and even size, and two columns left alone
+    const std::vector<int32_t> pools = {7, 3, 7, 3, -1, 7, 3, 7, -1, 3, 7};
+    const size_t n = 64;
+    const auto rows = noise(n, pools.size(), 2);
+
+    auto median = Rereferencer::createPooled(pools, ReferenceStatistic::MEDIAN);
+    ASSERT_TRUE(median.isOk());
+    EXPECT_EQ(median.value().poolCount(), 2u);
+    auto out = rows;
+    median.value().process(out.data(), n);
+    EXPECT_EQ(out, referencePooled(rows, pools, ReferenceStatistic::MEDIAN));
+
+    // A railed channel shifts the mean but not the median of its pool
+    std::vector<int16_t> row = {100, 0, 102, 0, 0, 98, 0, 32767, 0, 0, 100};
+    median.value().process(row.data(), 1);
+    EXPECT_EQ(row[0], 0);
+    EXPECT_EQ(row[4], 0);       // unpooled: unchanged
+}
+
+TEST(RereferencerTest, ElectrodeSubtractsItsReferenceColumn) {
+    const std::vector<int32_t> refs = {2, 2, -1, 0};
+    std::vector<int16_t> rows = {10, 20, 5, 1,
+                                 -32000, 30000, 1000, 7};
+    auto bipolar = Rereferencer::createElectrode(refs);
+    ASSERT_TRUE(bipolar.isOk());
+    EXPECT_EQ(bipolar.value().poolCount(), 0u);
+    bipolar.value().process(rows.data(), 2);
+    // Column 3 subtracts column 0's original value; differences saturate
+    EXPECT_EQ(rows, (std::vector<int16_t>{5, 15, 5, -9,
+                                          -32768, 29000, 1000, 32007}));
+
+    EXPECT_TRUE(Rereferencer::createElectrode({}).isError());
+    EXPECT_TRUE(Rereferencer::createElectrode({0, 2}).isError());
+    EXPECT_TRUE(Rereferencer::createPooled({}, ReferenceStatistic::MEAN).isError());
+}
@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_resampler.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the polyphase FIR resampler
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/resampler.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+constexpr double PI = 3.14159265358979323846;
+
+struct Output {
+    std::vector<int16_t> samples;
+    std::vector<uint64_t> timestamps;
+};
+
+/// Feed @p rows through @p resampler in batches of 1, 2, ... 37 rows
+Output run(PolyphaseResampler& resampler, const std::vector<int16_t>& rows, const std::vector<uint64_t>& ts) {
+    const size_t channels = resampler.channelCount();
+    const size_t n = ts.size();
+    Output result;
+    std::vector<int16_t> out;
+    std::vector<uint64_t> out_ts;
+    for (size_t r = 0, batch = 1; r < n; r += batch, batch = batch % 37 + 1) {
+        const size_t m = std::min(batch, n - r);
+        out.resize(resampler.maxOutput(m) * channels);
+        out_ts.resize(resampler.maxOutput(m));
+        const size_t produced = resampler.process(&rows[r * channels], &ts[r], m, out.data(), out_ts.data());
+        EXPECT_LE(produced, resampler.maxOutput(m));
+        result.samples.insert(result.samples.end(), out.begin(), out.begin() + produced * channels);
+        result.timestamps.insert(result.timestamps.end(), out_ts.begin(), out_ts.begin() + produced);
+    }
+    return result;
+}
+
+std::vector<uint64_t> ticks(const size_t n, const uint64_t start, const uint64_t step) {
+    std::vector<uint64_t> ts(n);
+    for (size_t r = 0; r < n; ++r) {
+        ts[r] = start + r * step;
+    }
+    return ts;
+}
+
+/// @p n rows of @p channels sinusoids at @p freq (cycles per sample)
+std::vector<int16_t> sine(const size_t n, const size_t channels, const double freq, const double amplitude) {
+    std::vector<int16_t> rows(n * channels);
+    for (size_t r = 0; r < n; ++r) {
+        const auto v = static_cast<int16_t>(std::lround(amplitude * std::sin(2.0 * PI * freq * r)));
+        std::fill_n(&rows[r * channels], channels, v);
+    }
+    return rows;
+}
+
+/// Largest magnitude of channel @p c over output rows [from, end)
+int peak(const Output& out, const size_t channels, const size_t c, const size_t from) {
+    int p = 0;
+    for (size_t r = from; r < out.timestamps.size(); ++r) {
+        p = std::max(p, std::abs(static_cast<int>(out.samples[r * channels + c])));
+    }
+    return p;
+}
+
+} // anonymous namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Design
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ResamplerDesignTest, TapsHaveUnitGainAtTheInputRate) {
+    for (const auto& [up, down] : {std::pair<uint32_t, uint32_t>{1, 30}, {3, 2}, {2, 3}, {1, 1}}) {
+        auto taps = designResamplerTaps(up, down);
+        ASSERT_TRUE(taps.isOk()) << taps.error();
+        EXPECT_EQ(taps.value().size(), 20u * std::max(up, down) + 1);
+        EXPECT_NEAR(std::accumulate(taps.value().begin(), taps.value().end(), 0.0), up, 1e-4);
+        // Symmetric: linear phase
+        const auto& h = taps.value();
+        for (size_t n = 0; n < h.size() / 2; ++n) {
+            ASSERT_FLOAT_EQ(h[n], h[h.size() - 1 - n]);
+        }
+    }
+    // Factors are reduced to lowest terms
+    EXPECT_EQ(designResamplerTaps(2, 60).value(), designResamplerTaps(1, 30).value());
+}
+
+TEST(ResamplerDesignTest, RejectsInvalidFactors) {
+    EXPECT_TRUE(designResamplerTaps(0, 30).isError());
+    EXPECT_TRUE(designResamplerTaps(1, 0).isError());
+    EXPECT_TRUE(designResamplerTaps(1, RESAMPLER_MAX_FACTOR + 1).isError());
+    EXPECT_TRUE(PolyphaseResampler::create(1, 30, 0).isError());
+    EXPECT_TRUE(PolyphaseResampler::create(1, 30, std::vector<float>{}, 4).isError());
+    EXPECT_TRUE(PolyphaseResampler::create(1, 30, 4).isOk());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Streaming
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(PolyphaseResamplerTest, MatchesDirectUpsampleFilterDownsample) {
+    const uint32_t up = 3;
+    const uint32_t down = 2;
+    const auto taps = designResamplerTaps(up, down).value();
+    const int64_t delay = static_cast<int64_t>(taps.size() - 1) / 2;
+
+    for (const size_t channels : {size_t{5}, size_t{21}}) {      // SIMD blocks of 16 and 4, plus padding
+        const size_t n = 2000;
+        std::mt19937 rng(static_cast<uint32_t>(channels));
+        std::normal_distribution<double> noise(0.0, 3000.0);
+        std::vector<int16_t> rows(n * channels);
+        for (auto& v : rows) {
+            v = static_cast<int16_t>(std::lround(std::clamp(noise(rng), -20000.0, 20000.0)));
+        }
+
+        auto resampler = PolyphaseResampler::create(up, down, channels);
+        ASSERT_TRUE(resampler.isOk()) << resampler.error();
+        const auto out = run(resampler.value(), rows, ticks(n, 0, 1));
+
+        // Output k exists once input floor(k * down / up) has arrived; the first is the one
+        // representing input 0
+        const int64_t first = (delay + down - 1) / down;
+        const int64_t last = (static_cast<int64_t>(n) * up - 1) / down;
+        ASSERT_EQ(out.timestamps.size(), static_cast<size_t>(last - first + 1));
+
+        for (int64_t k = first; k <= last; ++k) {
+            const size_t row = static_cast<size_t>(k - first);
+            for (size_t c = 0; c < channels; ++c) {
+                double y = 0.0;
+                for (int64_t j = 0; j < static_cast<int64_t>(taps.size()); ++j) {
+                    const int64_t pos = k * down - j;           // position in the upsampled stream
+                    if (pos >= 0 && pos % up == 0 && pos / up < static_cast<int64_t>(n)) {
+                        y += taps[j] * rows[static_cast<size_t>(pos / up) * channels + c];
+                    }
+                }
+                ASSERT_NEAR(out.samples[row * channels + c], y, 1.0) << "output " << k << " channel " << c;
+            }
+        }
+    }
+}
+
+TEST(PolyphaseResamplerTest, DecimatesRawToLfp) {
+    const size_t channels = 4;
+    const size_t n = 30000;
+    auto resampler = PolyphaseResampler::create(1, 30, channels);
+    ASSERT_TRUE(resampler.isOk());
+    EXPECT_DOUBLE_EQ(resampler.value().groupDelay(), 300.0);
+
+    // 50 Hz at 30 kHz passes at full amplitude
+    auto pass = run(resampler.value(), sine(n, channels, 50.0 / 30000.0, 10000.0), ticks(n, 0, 1));
+    // Outputs lag the input by the group delay: the last 300 inputs are still in the filter
+    EXPECT_EQ(pass.timestamps.size(), (n - 300) / 30);
+    EXPECT_NEAR(peak(pass, channels, 3, 100), 10000, 50);
+
+    // 1400 Hz would alias to 400 Hz; it must be suppressed by the anti-aliasing filter
+    resampler.value().reset();
+    auto alias = run(resampler.value(), sine(n, channels, 1400.0 / 30000.0, 10000.0), ticks(n, 0, 1));
+    EXPECT_LT(peak(alias, channels, 0, 100), 30);
+}
+
+TEST(PolyphaseResamplerTest, TimestampsAreThoseTheSamplesRepresent) {
+    const size_t channels = 1;
+    const size_t n = 1000;
+    const uint64_t start = 1000000;
+    const uint64_t step = 33333;        // ns per sample at 30 kHz
+
+    // Decimation: every output lands on an input sample
+    auto lfp = PolyphaseResampler::create(1, 30, channels);
+    const auto dec = run(lfp.value(), std::vector<int16_t>(n), ticks(n, start, step));
+    ASSERT_FALSE(dec.timestamps.empty());
+    for (size_t k = 0; k < dec.timestamps.size(); ++k) {
+        ASSERT_EQ(dec.timestamps[k], start + k * 30 * step);
+    }
+
+    // Interpolation: outputs between input samples get interpolated times
+    auto up = PolyphaseResampler::create(3, 2, channels);
+    const auto res = run(up.value(), std::vector<int16_t>(n), ticks(n, start, step));
+    ASSERT_FALSE(res.timestamps.empty());
+    const uint64_t origin = res.timestamps.front();
+    for (size_t k = 0; k < res.timestamps.size(); ++k) {
+        ASSERT_NEAR(static_cast<double>(res.timestamps[k] - origin), k * step * 2.0 / 3.0, 1.0);
+    }
+}
+
+TEST(PolyphaseResamplerTest, ResetRestartsTheStream) {
+    const size_t channels = 3;
+    const size_t n = 3000;
+    auto resampler = PolyphaseResampler::create(2, 5, channels);
+    const auto rows = sine(n, channels, 0.01, 5000.0);
+    const auto first = run(resampler.value(), rows, ticks(n, 0, 1));
+    resampler.value().reset();
+    const auto second = run(resampler.value(), rows, ticks(n, 0, 1));
+    EXPECT_EQ(first.samples, second.samples);
+    EXPECT_EQ(first.timestamps, second.timestamps);
+
+    // Constant input settles to the same constant
+    resampler.value().reset();
+    const auto dc = run(resampler.value(), std::vector<int16_t>(n * channels, 1234), ticks(n, 0, 1));
+    EXPECT_EQ(dc.samples.back(), 1234);
+}
@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_response_waiters.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for DeviceSession's type-indexed response waiters
+///
+/// Packets are fed straight into updateConfigFromBuffer(), so no device is needed; the
+/// session only binds a loopback socket.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include "device_session_impl.h"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace cbdev;
+
+namespace {
+
+/// Append one configuration packet of the given type and dlen to a datagram buffer
+void appendConfigPacket(std::vector<uint8_t>& buf, uint16_t type, uint32_t dlen, uint32_t chan = 0) {
+    cbPKT_GENERIC pkt = {};
+    pkt.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    pkt.cbpkt_header.type = type;
+    pkt.cbpkt_header.dlen = dlen;
+    if (chan != 0) {
+        reinterpret_cast<cbPKT_CHANINFO&>(pkt).chan = chan;
+    }
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&pkt);
+    buf.insert(buf.end(), bytes, bytes + cbPKT_HEADER_SIZE + dlen * 4);
+}
+
+/// A REQCONFIGALL reply flood: config-all marker, per-channel CHANREPs, then the SYSREP barrier
+std::vector<uint8_t> makeConfigFlood(uint32_t nchans) {
+    std::vector<uint8_t> buf;
+    appendConfigPacket(buf, cbPKTTYPE_REPCONFIGALL, 0);
+    appendConfigPacket(buf, cbPKTTYPE_PROCREP, cbPKTDLEN_PROCINFO);
+    for (uint32_t chan = 1; chan <= nchans; ++chan) {
+        appendConfigPacket(buf, cbPKTTYPE_CHANREP, cbPKTDLEN_CHANINFO, chan);
+    }
+    appendConfigPacket(buf, cbPKTTYPE_SYSREP, cbPKTDLEN_SYSINFO);
+    return buf;
+}
+
+} // namespace
+
+/// Test fixture owning a loopback DeviceSession
+class ResponseWaiterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto params = ConnectionParams::custom("127.0.0.1", "127.0.0.1", 0, 0);
+        params.recv_buffer_size = 0;
+        auto result = DeviceSession::create(params);
+        if (result.isError()) {
+            GTEST_SKIP() << "Cannot create loopback session: " << result.error();
+        }
+        session = std::make_unique<DeviceSession>(std::move(result.value()));
+    }
+
+    std::unique_ptr<DeviceSession> session;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Matching Tests
+/// @{
+
+TEST_F(ResponseWaiterTest, TypedWaiterOnlySeesItsTypes) {
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    auto waiter = session->registerResponseWaiter(
+        {cbPKTTYPE_SYSREP},
+        [calls](const cbPKT_HEADER* hdr) {
+            ++*calls;
+            return hdr->type == cbPKTTYPE_SYSREP;
+        });
+
+    const auto flood = makeConfigFlood(100);
+    session->updateConfigFromBuffer(flood.data(), flood.size());
+
+    EXPECT_TRUE(waiter.wait(std::chrono::milliseconds(0)).isOk());
+    EXPECT_EQ(calls->load(), 1);
+}
+
+TEST_F(ResponseWaiterTest, CatchAllWaiterSeesEveryConfigPacket) {
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    auto waiter = session->registerResponseWaiter(
+        [calls](const cbPKT_HEADER* hdr) {
+            ++*calls;
+            return hdr->type == cbPKTTYPE_SYSREP;
+        });
+
+    const auto flood = makeConfigFlood(100);
+    session->updateConfigFromBuffer(flood.data(), flood.size());
+
+    EXPECT_TRUE(waiter.wait(std::chrono::milliseconds(0)).isOk());
+    EXPECT_EQ(calls->load(), 103);  // REPCONFIGALL + PROCREP + 100 CHANREP + SYSREP
+}
+
+TEST_F(ResponseWaiterTest, MultiTypeWaiterCountsAcrossBuckets) {
+    auto waiter = session->registerResponseWaiter(
+        {cbPKTTYPE_CHANREP, cbPKTTYPE_CHANREPAINP, cbPKTTYPE_CHANREP},  // duplicate is ignored
+        [](const cbPKT_HEADER*) { return true; },
+        4);
+
+    std::vector<uint8_t> buf;
+    appendConfigPacket(buf, cbPKTTYPE_CHANREP, cbPKTDLEN_CHANINFO, 1);
+    appendConfigPacket(buf, cbPKTTYPE_CHANREPAINP, cbPKTDLEN_CHANINFO, 2);
+    appendConfigPacket(buf, cbPKTTYPE_CHANREPSMP, cbPKTDLEN_CHANINFO, 3);
+    appendConfigPacket(buf, cbPKTTYPE_CHANREP, cbPKTDLEN_CHANINFO, 4);
+    session->updateConfigFromBuffer(buf.data(), buf.size());
+    EXPECT_TRUE(waiter.wait(std::chrono::milliseconds(0)).isError());  // 3 of 4
+
+    buf.clear();
+    appendConfigPacket(buf, cbPKTTYPE_CHANREPAINP, cbPKTDLEN_CHANINFO, 5);
+    session->updateConfigFromBuffer(buf.data(), buf.size());
+    EXPECT_TRUE(waiter.wait(std::chrono::milliseconds(0)).isOk());
+}
+
+TEST_F(ResponseWaiterTest, DestroyedWaiterIsUnlinked) {
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    {
+        auto typed = session->registerResponseWaiter(
+            {cbPKTTYPE_SYSREP}, [calls](const cbPKT_HEADER*) { ++*calls; return false; });
+        auto any = session->registerResponseWaiter(
+            [calls](const cbPKT_HEADER*) { ++*calls; return false; });
+    }
+
+    const auto flood = makeConfigFlood(10);
+    session->updateConfigFromBuffer(flood.data(), flood.size());
+    EXPECT_EQ(calls->load(), 0);
+}
+
+TEST_F(ResponseWaiterTest, MalformedConfigPacketIsDropped) {
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    auto waiter = session->registerResponseWaiter(
+        [calls](const cbPKT_HEADER* hdr) {
+            ++*calls;
+            return hdr->type == cbPKTTYPE_SYSREP;
+        });
+
+    // A SYSREP one word short of cbPKT_SYSINFO is neither stored nor matched
+    cbPKT_SYSINFO sysinfo = {};
+    sysinfo.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    sysinfo.cbpkt_header.type = cbPKTTYPE_SYSREP;
+    sysinfo.cbpkt_header.dlen = cbPKTDLEN_SYSINFO - 1;
+    sysinfo.sysfreq = 1234;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&sysinfo);
+    std::vector<uint8_t> buf(bytes, bytes + cbPKT_HEADER_SIZE + (cbPKTDLEN_SYSINFO - 1) * 4);
+    session->updateConfigFromBuffer(buf.data(), buf.size());
+    EXPECT_EQ(calls->load(), 0);
+    EXPECT_TRUE(waiter.wait(std::chrono::milliseconds(0)).isError());
+    EXPECT_NE(session->getSysInfo().sysfreq, 1234u);
+
+    sysinfo.cbpkt_header.dlen = cbPKTDLEN_SYSINFO;
+    buf.assign(bytes, bytes + cbPKT_HEADER_SIZE + cbPKTDLEN_SYSINFO * 4);
+    session->updateConfigFromBuffer(buf.data(), buf.size());
+    EXPECT_TRUE(waiter.wait(std::chrono::milliseconds(0)).isOk());
+    EXPECT_EQ(session->getSysInfo().sysfreq, 1234u);
+}
+
+TEST_F(ResponseWaiterTest, LongerConfigPacketIsStoredAndMatched) {
+    auto waiter = session->registerResponseWaiter(
+        [](const cbPKT_HEADER* hdr) { return hdr->type == cbPKTTYPE_SYSREP; });
+
+    // Newer firmware appending two words to SYSREP: the known fields are still stored
+    cbPKT_SYSINFO sysinfo = {};
+    sysinfo.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    sysinfo.cbpkt_header.type = cbPKTTYPE_SYSREP;
+    sysinfo.cbpkt_header.dlen = cbPKTDLEN_SYSINFO + 2;
+    sysinfo.sysfreq = 4321;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&sysinfo);
+    std::vector<uint8_t> buf(bytes, bytes + sizeof(sysinfo));
+    buf.resize(buf.size() + 8, 0xEE);
+    session->updateConfigFromBuffer(buf.data(), buf.size());
+    EXPECT_TRUE(waiter.wait(std::chrono::milliseconds(0)).isOk());
+    EXPECT_EQ(session->getSysInfo().sysfreq, 4321u);
+}
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Handshake Flood
+/// @{
+
+/// A handshake's config flood with 1, 10 and 100 outstanding waiters.  The extra waiters wait
+/// on per-channel replies that never arrive, as concurrent sendAndWait() calls for other
+/// settings would; the flood must resolve the SYSREP waiter and leave them pending.  (The
+/// receive-side cost is measured by BM_DeviceSession_ConfigFloodWithWaiters.)
+TEST_F(ResponseWaiterTest, HandshakeFloodWithOutstandingWaiters) {
+    const auto flood = makeConfigFlood(cbMAXCHANS);
+    constexpr int kRounds = 3;
+
+    for (const size_t outstanding : {size_t(1), size_t(10), size_t(100)}) {
+        for (const bool typed : {true, false}) {
+            auto spurious = std::make_shared<std::atomic<int>>(0);
+            std::vector<DeviceSession::ResponseWaiter> others;
+            for (size_t i = 0; i < outstanding; ++i) {
+                auto match = [spurious](const cbPKT_HEADER* hdr) {
+                    const bool matched = hdr->type == cbPKTTYPE_CHANREPSPKTHR;
+                    *spurious += matched ? 1 : 0;
+                    return matched;
+                };
+                others.push_back(typed
+                    ? session->registerResponseWaiter({cbPKTTYPE_CHANREPSPKTHR}, match)
+                    : session->registerResponseWaiter(match));
+            }
+
+            for (int round = 0; round < kRounds; ++round) {
+                auto sysrep = session->registerResponseWaiter(
+                    {cbPKTTYPE_SYSREP}, [](const cbPKT_HEADER* hdr) { return hdr->type == cbPKTTYPE_SYSREP; });
+                session->updateConfigFromBuffer(flood.data(), flood.size());
+                EXPECT_TRUE(sysrep.wait(std::chrono::milliseconds(0)).isOk())
+                    << outstanding << (typed ? " typed" : " catch-all") << " round " << round;
+            }
+
+            EXPECT_EQ(spurious->load(), 0);
+            for (auto& other : others) {
+                EXPECT_TRUE(other.wait(std::chrono::milliseconds(0)).isError());
+            }
+        }
+    }
+}
+
+/// @}
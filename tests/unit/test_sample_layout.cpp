@@ -0,0 +1,109 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_sample_layout.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for batch transposition and scaling
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/sample_layout.h>
+
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+std::vector<int16_t> randomBatch(const size_t n_samples, const size_t n_channels) {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> dist(-32768, 32767);
+    std::vector<int16_t> batch(n_samples * n_channels);
+    for (auto& v : batch) {
+        v = static_cast<int16_t>(dist(rng));
+    }
+    return batch;
+}
+
+cbSCALING scaling(const int16_t digmin, const int16_t digmax, const int32_t anamin, const int32_t anamax,
+                  const char* unit) {
+    cbSCALING s{};
+    s.digmin = digmin;
+    s.digmax = digmax;
+    s.anamin = anamin;
+    s.anamax = anamax;
+    std::strncpy(s.anaunit, unit, sizeof(s.anaunit) - 1);
+    return s;
+}
+
+} // anonymous namespace
+
+TEST(SampleLayoutTest, TransposeMatchesReference) {
+    // Sizes around the 8 x 8 tile and the 64-sample block
+    for (const size_t n_samples : {1u, 7u, 8u, 30u, 64u, 65u, 128u}) {
+        for (const size_t n_channels : {1u, 5u, 8u, 13u, 96u, 272u}) {
+            const auto in = randomBatch(n_samples, n_channels);
+            std::vector<int16_t> out(in.size());
+            transposeSamples(in.data(), n_samples, n_channels, out.data());
+            for (size_t s = 0; s < n_samples; ++s) {
+                for (size_t c = 0; c < n_channels; ++c) {
+                    ASSERT_EQ(out[c * n_samples + s], in[s * n_channels + c])
+                        << n_samples << "x" << n_channels << " at " << s << "," << c;
+                }
+            }
+        }
+    }
+}
+
+TEST(SampleLayoutTest, ScaleMatchesReferenceInBothLayouts) {
+    for (const size_t n_samples : {3u, 30u, 71u}) {
+        for (const size_t n_channels : {4u, 19u, 96u}) {
+            const auto in = randomBatch(n_samples, n_channels);
+            std::vector<ChannelScale> scales(n_channels);
+            for (size_t c = 0; c < n_channels; ++c) {
+                scales[c].gain = 0.25f + 0.01f * static_cast<float>(c);
+                scales[c].offset = static_cast<float>(c) - 10.0f;
+            }
+            std::vector<float> sample_major(in.size());
+            std::vector<float> channel_major(in.size());
+            scaleSamples(in.data(), n_samples, n_channels, scales.data(), SampleLayout::SAMPLE_MAJOR,
+                         sample_major.data());
+            scaleSamples(in.data(), n_samples, n_channels, scales.data(), SampleLayout::CHANNEL_MAJOR,
+                         channel_major.data());
+            for (size_t s = 0; s < n_samples; ++s) {
+                for (size_t c = 0; c < n_channels; ++c) {
+                    const float expected = static_cast<float>(in[s * n_channels + c]) * scales[c].gain +
+                                           scales[c].offset;
+                    ASSERT_FLOAT_EQ(sample_major[s * n_channels + c], expected) << s << "," << c;
+                    ASSERT_FLOAT_EQ(channel_major[c * n_samples + s], expected) << s << "," << c;
+                }
+            }
+        }
+    }
+}
+
+TEST(SampleLayoutTest, ChannelScaleConvertsToMicrovolts) {
+    // Front end: 0.25 uV per step
+    auto s = channelScale(scaling(-32764, 32764, -8191, 8191, "uV"));
+    EXPECT_NEAR(s.gain, 0.25f, 1e-4f);
+    EXPECT_NEAR(s.offset, 0.0f, 1e-2f);
+
+    // Analog input in mV: 5000 mV over 32764 steps
+    s = channelScale(scaling(-32764, 32764, -5000, 5000, "mV"));
+    EXPECT_NEAR(s.gain, 5e6f / 32764.0f, 1e-2f);
+
+    // Asymmetric range keeps the offset; non-voltage units are left alone
+    s = channelScale(scaling(0, 1000, 100, 300, "MPa"));
+    EXPECT_FLOAT_EQ(s.gain, 0.2f);
+    EXPECT_FLOAT_EQ(s.offset, 100.0f);
+    EXPECT_FLOAT_EQ(0 * s.gain + s.offset, 100.0f);
+    EXPECT_FLOAT_EQ(1000 * s.gain + s.offset, 300.0f);
+
+    // No digital span: raw steps
+    s = channelScale(scaling(0, 0, -10, 10, "uV"));
+    EXPECT_FLOAT_EQ(s.gain, 1.0f);
+    EXPECT_FLOAT_EQ(s.offset, 0.0f);
+}
@@ -15,7 +15,9 @@
 #include <cbproto/instrument_id.h>
 #include <cbproto/connection.h>    // For cbproto_protocol_version_t
 #include <cbproto/packet_translator.h>
+#include <atomic>
 #include <cstring>
+#include <thread>
 #ifdef _WIN32
 #include <windows.h>  // GetCurrentProcessId()
 #else
@@ -1089,6 +1091,43 @@ TEST_F(NativeShmemSessionTest, ChanInfo_RejectOutOfRange) {
     EXPECT_TRUE(set_result.isError()) << "Channel " << cbshm::NATIVE_MAXCHANS << " should be out of range for native mode";
 }
 
+TEST_F(NativeShmemSessionTest, SetAndGetSortModels) {
+    auto result = createNativeSession();
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& session = result.value();
+
+    cbPKT_FS_BASIS basis;
+    std::memset(&basis, 0, sizeof(basis));
+    basis.chan = 8;
+    basis.basis[3][1] = 0.5f;
+    ASSERT_TRUE(session.setFeatureBasis(7, basis).isOk());
+
+    cbPKT_SS_MODELSET model;
+    std::memset(&model, 0, sizeof(model));
+    model.chan = 7;
+    model.unit_number = 255;
+    model.valid = 1;
+    ASSERT_TRUE(session.setSortModel(7, cbMAXUNITS + 1, model).isOk());
+    EXPECT_TRUE(session.setSortModel(7, cbMAXUNITS + 2, model).isError());
+
+    cbPKT_SS_NOISE_BOUNDARY boundary;
+    std::memset(&boundary, 0, sizeof(boundary));
+    boundary.chan = 8;
+    boundary.afS[2][2] = 40.0f;
+    ASSERT_TRUE(session.setNoiseBoundary(7, boundary).isOk());
+
+    auto basis_result = session.getFeatureBasis(7);
+    ASSERT_TRUE(basis_result.isOk());
+    EXPECT_FLOAT_EQ(basis_result.value().basis[3][1], 0.5f);
+    auto model_result = session.getSortModel(7, cbMAXUNITS + 1);
+    ASSERT_TRUE(model_result.isOk());
+    EXPECT_EQ(model_result.value().unit_number, 255u);
+    auto boundary_result = session.getNoiseBoundary(7);
+    ASSERT_TRUE(boundary_result.isOk());
+    EXPECT_FLOAT_EQ(boundary_result.value().afS[2][2], 40.0f);
+    EXPECT_TRUE(session.getNoiseBoundary(cbshm::NATIVE_MAXCHANS).isError());
+}
+
 TEST_F(NativeShmemSessionTest, StorePacket_PROCINFO) {
     auto result = createNativeSession();
     ASSERT_TRUE(result.isOk()) << result.error();
@@ -1812,6 +1851,162 @@ TEST_F(CentralCompatProtocolTest, CentralLayout_AlwaysCurrent) {
     EXPECT_EQ(result.value().getCompatProtocolVersion(), CBPROTO_PROTOCOL_CURRENT);
 }
 
+/// @brief Non-Gemini tick timestamps are converted with the cached sysfreq, which a SYSREP
+/// changes for itself and the packets after it
+TEST_F(CentralCompatProtocolTest, TickConversion_RefreshedOnSysrep) {
+    auto result = createCompatSession();
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& session = result.value();
+    ASSERT_TRUE(session.setGeminiSystem(false).isOk());
+
+    auto* cfg = session.getLegacyConfigBuffer();
+    ASSERT_NE(cfg, nullptr);
+
+    cbPKT_GENERIC pkt;
+    std::memset(&pkt, 0, sizeof(pkt));
+    pkt.cbpkt_header.time = 30000;  // 1 s of 30 kHz ticks (sysfreq 0 falls back to 30 kHz)
+    pkt.cbpkt_header.chid = 1;
+    pkt.cbpkt_header.type = 0x01;
+    pkt.cbpkt_header.dlen = 1;
+    ASSERT_TRUE(session.storePacket(pkt).isOk());
+    EXPECT_EQ(session.getLastTime(), 1000000000u);
+
+    // Device now reports a different clock; Central updates sysinfo, then forwards SYSREP
+    cfg->sysinfo.sysfreq = 7500;
+    cbPKT_GENERIC sysrep;
+    std::memset(&sysrep, 0, sizeof(sysrep));
+    sysrep.cbpkt_header.time = 30001;
+    sysrep.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    sysrep.cbpkt_header.type = cbPKTTYPE_SYSREP;
+    sysrep.cbpkt_header.dlen = 1;
+    ASSERT_TRUE(session.storePacket(sysrep).isOk());
+
+    cbPKT_GENERIC read_pkts[4];
+    size_t packets_read = 0;
+    ASSERT_TRUE(session.readReceiveBuffer(read_pkts, 4, packets_read).isOk());
+    ASSERT_EQ(packets_read, 2u);
+    // The packet ahead of the SYSREP keeps the old sysfreq, the SYSREP takes the new one
+    EXPECT_EQ(read_pkts[0].cbpkt_header.time, 1000000000u);
+    EXPECT_EQ(read_pkts[1].cbpkt_header.time, 4000133333u);
+
+    pkt.cbpkt_header.time = 20000;
+    ASSERT_TRUE(session.storePacket(pkt).isOk());
+    ASSERT_TRUE(session.readReceiveBuffer(read_pkts, 4, packets_read).isOk());
+    ASSERT_EQ(packets_read, 1u);
+    EXPECT_EQ(read_pkts[0].cbpkt_header.time, 2666666666u);
+    EXPECT_EQ(session.getLastTime(), 2666666666u);
+
+    // Gemini timestamps are already nanoseconds
+    ASSERT_TRUE(session.setGeminiSystem(true).isOk());
+    EXPECT_EQ(session.getLastTime(), 20000u);
+}
+
+/// @brief A batch spanning a SYSREP converts the packets on each side at their own sysfreq
+TEST_F(CentralCompatProtocolTest, TickConversion_BatchSplitAtSysrep) {
+    auto result = createCompatSession();
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& session = result.value();
+    ASSERT_TRUE(session.setGeminiSystem(false).isOk());
+    auto* cfg = session.getLegacyConfigBuffer();
+    ASSERT_NE(cfg, nullptr);
+
+    cbPKT_GENERIC pkt;
+    std::memset(&pkt, 0, sizeof(pkt));
+    pkt.cbpkt_header.chid = 1;
+    pkt.cbpkt_header.type = 0x01;
+    pkt.cbpkt_header.dlen = 1;
+    cbPKT_GENERIC sysrep;
+    std::memset(&sysrep, 0, sizeof(sysrep));
+    sysrep.cbpkt_header.chid = cbPKTCHAN_CONFIGURATION;
+    sysrep.cbpkt_header.type = cbPKTTYPE_SYSREP;
+    sysrep.cbpkt_header.dlen = 1;
+
+    pkt.cbpkt_header.time = 30000;   // 1 s at 30 kHz
+    ASSERT_TRUE(session.storePacket(pkt).isOk());
+    pkt.cbpkt_header.time = 60000;   // 2 s at 30 kHz
+    ASSERT_TRUE(session.storePacket(pkt).isOk());
+    sysrep.cbpkt_header.time = 45000;
+    ASSERT_TRUE(session.storePacket(sysrep).isOk());
+    pkt.cbpkt_header.time = 45000;   // 3 s at 15 kHz
+    ASSERT_TRUE(session.storePacket(pkt).isOk());
+
+    // Central has already updated sysinfo when the reader gets to the batch
+    cfg->sysinfo.sysfreq = 15000;
+    cbPKT_GENERIC read_pkts[8];
+    size_t packets_read = 0;
+    ASSERT_TRUE(session.readReceiveBuffer(read_pkts, 8, packets_read).isOk());
+    ASSERT_EQ(packets_read, 4u);
+    EXPECT_EQ(read_pkts[0].cbpkt_header.time, 1000000000u);
+    EXPECT_EQ(read_pkts[1].cbpkt_header.time, 2000000000u);
+    EXPECT_EQ(read_pkts[2].cbpkt_header.time, 3000000000u);
+    EXPECT_EQ(read_pkts[3].cbpkt_header.time, 3000000000u);
+}
+
+/// @brief A Gemini flag changed by another process takes effect without a refresh call
+TEST_F(CentralCompatProtocolTest, TickConversion_GeminiFlagReadLive) {
+    // The standalone session stands in for Central
+    auto central = createCompatSession();
+    ASSERT_TRUE(central.isOk()) << central.error();
+    central.value().getLegacyConfigBuffer()->sysinfo.sysfreq = 7500;
+    ASSERT_TRUE(central.value().setGeminiSystem(false).isOk());
+
+    cbPKT_GENERIC pkt;
+    std::memset(&pkt, 0, sizeof(pkt));
+    pkt.cbpkt_header.time = 7500;
+    pkt.cbpkt_header.chid = 1;
+    pkt.cbpkt_header.type = 0x01;
+    pkt.cbpkt_header.dlen = 1;
+    ASSERT_TRUE(central.value().storePacket(pkt).isOk());
+
+    auto result = ShmemSession::create(
+        test_name + "_cfg", test_name + "_rec", test_name + "_xmt",
+        test_name + "_xmt_local", test_name + "_status", test_name + "_spk",
+        test_name + "_signal", Mode::CLIENT, ShmemLayout::CENTRAL_COMPAT);
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& session = result.value();
+    EXPECT_EQ(session.getLastTime(), 1000000000u);
+
+    // Gemini timestamps are already nanoseconds
+    ASSERT_TRUE(central.value().setGeminiSystem(true).isOk());
+    EXPECT_EQ(session.getLastTime(), 7500u);
+    ASSERT_TRUE(central.value().setGeminiSystem(false).isOk());
+    EXPECT_EQ(session.getLastTime(), 1000000000u);
+}
+
+/// @brief Readers on other threads see a whole conversion while setGeminiSystem() refreshes it
+TEST_F(CentralCompatProtocolTest, TickConversion_RefreshWhileReading) {
+    auto result = createCompatSession();
+    ASSERT_TRUE(result.isOk()) << result.error();
+    auto& session = result.value();
+    session.getLegacyConfigBuffer()->sysinfo.sysfreq = 7500;
+    ASSERT_TRUE(session.setGeminiSystem(false).isOk());
+
+    cbPKT_GENERIC pkt;
+    std::memset(&pkt, 0, sizeof(pkt));
+    pkt.cbpkt_header.time = 7500;
+    pkt.cbpkt_header.chid = 1;
+    pkt.cbpkt_header.type = 0x01;
+    pkt.cbpkt_header.dlen = 1;
+    ASSERT_TRUE(session.storePacket(pkt).isOk());
+
+    // 7500 ticks: 1 s at 7.5 kHz, 0.5 s at 15 kHz, or already nanoseconds (Gemini)
+    std::atomic<bool> stop{false};
+    std::thread toggler([&] {
+        for (int i = 0; !stop.load(); ++i) {
+            session.getLegacyConfigBuffer()->sysinfo.sysfreq = (i & 2) ? 15000 : 7500;
+            (void)session.setGeminiSystem(i % 3 == 0);
+        }
+    });
+    int torn = 0;
+    for (int i = 0; i < 100000; ++i) {
+        const auto t = session.getLastTime();
+        torn += (t != 7500u && t != 1000000000u && t != 500000000u) ? 1 : 0;
+    }
+    stop = true;
+    toggler.join();
+    EXPECT_EQ(torn, 0);
+}
+
 /// @}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
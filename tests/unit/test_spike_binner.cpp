@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_spike_binner.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the binned spike-count producer
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/spike_binner.h>
+
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+constexpr uint64_t kBin = 1000;
+
+SpikeBinnerConfig smallConfig() {
+    SpikeBinnerConfig config;
+    config.bin_width = kBin;
+    config.latency = 500;
+    config.channel_count = 4;
+    config.unit_count = 3;
+    config.buffer_bins = 16;
+    return config;
+}
+
+struct Bins {
+    std::vector<uint32_t> counts;
+    std::vector<uint64_t> starts;
+    size_t cells = 0;
+
+    uint32_t at(const size_t bin, const uint32_t chan_id, const uint32_t unit, const size_t units) const {
+        return counts[bin * cells + (chan_id - 1) * units + unit];
+    }
+};
+
+Bins read(SpikeBinner& binner, const bool take = false) {
+    const auto& config = binner.config();
+    Bins bins;
+    bins.cells = config.channel_count * config.unit_count;
+    bins.counts.resize(config.buffer_bins * bins.cells);
+    bins.starts.resize(config.buffer_bins);
+    const size_t n = take ? binner.takeClosed(bins.counts.data(), bins.starts.data(), config.buffer_bins)
+                          : binner.readBins(bins.counts.data(), bins.starts.data(), config.buffer_bins);
+    bins.counts.resize(n * bins.cells);
+    bins.starts.resize(n);
+    return bins;
+}
+
+} // anonymous namespace
+
+TEST(SpikeBinnerTest, BinsAlignToDeviceTime) {
+    auto binner = SpikeBinner::create(smallConfig());
+    ASSERT_TRUE(binner.isOk()) << binner.error();
+    auto& b = binner.value();
+
+    b.advance(10'500);                  // the first open bin holds time - latency
+    b.addSpike(1, 0, 10'200);
+    b.addSpike(1, 0, 10'999);
+    b.addSpike(4, 2, 11'000);
+    b.advance(11'400);                  // bin [10000, 11000) still within its latency
+    EXPECT_EQ(b.buffered(), 0u);
+    b.advance(11'500);
+    EXPECT_EQ(b.buffered(), 1u);
+    b.advance(12'600);
+
+    const auto bins = read(b);
+    ASSERT_EQ(bins.starts.size(), 2u);
+    EXPECT_EQ(bins.starts[0], 10'000u);
+    EXPECT_EQ(bins.starts[1], 11'000u);
+    EXPECT_EQ(bins.at(0, 1, 0, 3), 2u);
+    EXPECT_EQ(bins.at(0, 4, 2, 3), 0u);
+    EXPECT_EQ(bins.at(1, 4, 2, 3), 1u);
+    EXPECT_EQ(b.stats().spikes_counted, 3u);
+    EXPECT_EQ(b.stats().bins_closed, 2u);
+}
+
+TEST(SpikeBinnerTest, LateSpikesLandInTheirBin) {
+    auto binner = SpikeBinner::create(smallConfig());
+    ASSERT_TRUE(binner.isOk());
+    auto& b = binner.value();
+
+    b.advance(20'000);
+    b.advance(21'200);
+    b.addSpike(2, 1, 20'100);           // 1.1 bins late, within latency of its bin's end
+    b.advance(21'600);
+    b.addSpike(2, 1, 20'200);           // its bin closed at 21'500
+    b.advance(22'600);
+
+    const auto bins = read(b);
+    ASSERT_GE(bins.starts.size(), 2u);
+    size_t found = 0;
+    for (size_t i = 0; i < bins.starts.size(); ++i) {
+        if (bins.starts[i] == 20'000) {
+            EXPECT_EQ(bins.at(i, 2, 1, 3), 1u);
+            ++found;
+        } else {
+            EXPECT_EQ(bins.at(i, 2, 1, 3), 0u);
+        }
+    }
+    EXPECT_EQ(found, 1u);
+    EXPECT_EQ(b.stats().spikes_late, 1u);
+}
+
+TEST(SpikeBinnerTest, SpikesOutsideTheMatrixAreIgnored) {
+    auto binner = SpikeBinner::create(smallConfig());
+    ASSERT_TRUE(binner.isOk());
+    auto& b = binner.value();
+    b.addSpike(0, 0, 100);
+    b.addSpike(5, 0, 100);
+    b.addSpike(1, 3, 100);
+    b.addSpike(1, 2, 100);
+    EXPECT_EQ(b.stats().spikes_ignored, 3u);
+    EXPECT_EQ(b.stats().spikes_counted, 1u);
+}
+
+TEST(SpikeBinnerTest, CursorsAreIndependentAndHistoryOverflows) {
+    auto binner = SpikeBinner::create(smallConfig());
+    ASSERT_TRUE(binner.isOk());
+    auto& b = binner.value();
+
+    b.advance(0);
+    b.addSpike(3, 0, 0);
+    b.advance(4'500);                   // closes bins 0..3
+    EXPECT_EQ(read(b, true).starts.size(), 4u);
+    EXPECT_EQ(read(b, true).starts.size(), 0u);
+    EXPECT_EQ(b.buffered(), 4u);
+
+    b.advance(20'500);                  // 20 bins closed, the history holds 16
+    EXPECT_EQ(read(b, true).starts.size(), 16u);
+    const auto bins = read(b);
+    ASSERT_EQ(bins.starts.size(), 16u);
+    EXPECT_EQ(bins.starts.front(), 4'000u);
+    EXPECT_EQ(bins.starts.back(), 19'000u);
+    EXPECT_EQ(b.stats().bins_overwritten, 4u);
+}
+
+TEST(SpikeBinnerTest, LongGapsSkipEmptyBins) {
+    auto binner = SpikeBinner::create(smallConfig());
+    ASSERT_TRUE(binner.isOk());
+    auto& b = binner.value();
+
+    b.addSpike(1, 0, 1'000);
+    b.advance(1'000'000'500);           // a million bins later
+    const auto bins = read(b);
+    ASSERT_EQ(bins.starts.size(), 16u);
+    EXPECT_EQ(bins.starts.back(), 999'999'000u);
+    EXPECT_GT(b.stats().bins_skipped, 0u);
+    EXPECT_EQ(b.stats().bins_closed + b.stats().bins_skipped, 1'000'000u);
+
+    // A spike far past the open bins closes the bins before it by itself
+    b.addSpike(1, 0, 1'000'010'000);
+    EXPECT_EQ(b.stats().spikes_counted, 2u);
+    EXPECT_EQ(b.stats().spikes_late, 0u);
+}
+
+TEST(SpikeBinnerTest, ClockRestartRestartsBinning) {
+    auto binner = SpikeBinner::create(smallConfig());
+    ASSERT_TRUE(binner.isOk());
+    auto& b = binner.value();
+
+    b.advance(100'000'000);
+    b.addSpike(1, 0, 100'000'000);
+    (void)read(b);
+    b.addSpike(2, 0, 300);              // device clock reset to 0
+    b.advance(2'600);
+    EXPECT_EQ(b.stats().spikes_late, 0u);
+    const auto bins = read(b);
+    ASSERT_FALSE(bins.starts.empty());
+    EXPECT_EQ(bins.starts.front(), 0u);
+    EXPECT_EQ(bins.at(0, 2, 0, 3), 1u);
+}
+
+TEST(SpikeBinnerTest, RejectsInvalidConfigs) {
+    auto config = smallConfig();
+    config.bin_width = 0;
+    EXPECT_TRUE(SpikeBinner::create(config).isError());
+    config = smallConfig();
+    config.unit_count = 0;
+    EXPECT_TRUE(SpikeBinner::create(config).isError());
+    config = smallConfig();
+    config.latency = config.bin_width * config.buffer_bins;
+    EXPECT_TRUE(SpikeBinner::create(config).isError());
+}
@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_spike_detector.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the host-side threshold-crossing spike detector
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/spike_detector.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+struct Spike {
+    uint32_t column;
+    uint64_t timestamp;
+    int16_t level;
+    std::vector<int16_t> wave;
+};
+
+/// Feed @p rows through @p detector in batches of 1, 2, ... 41 rows; timestamps are 1000 + row
+std::vector<Spike> run(ThresholdSpikeDetector& detector, const std::vector<int16_t>& rows) {
+    const size_t channels = detector.channelCount();
+    const size_t n = rows.size() / channels;
+    std::vector<uint64_t> ts(n);
+    for (size_t r = 0; r < n; ++r) {
+        ts[r] = 1000 + r;
+    }
+    std::vector<Spike> result;
+    std::vector<DetectedSpike> spikes;
+    for (size_t r = 0, batch = 1; r < n; r += batch, batch = batch % 41 + 1) {
+        const size_t m = std::min(batch, n - r);
+        const size_t found = detector.process(&rows[r * channels], &ts[r], m, spikes);
+        EXPECT_EQ(found, spikes.size());
+        for (const auto& s : spikes) {
+            result.push_back({s.column, s.timestamp, s.level,
+                              std::vector<int16_t>(s.wave, s.wave + detector.config().spike_length)});
+        }
+    }
+    return result;
+}
+
+/// Column @p column of rows [from, from + len)
+std::vector<int16_t> slice(const std::vector<int16_t>& rows, const size_t channels, const size_t column,
+                           const size_t from, const size_t len) {
+    std::vector<int16_t> out(len);
+    for (size_t k = 0; k < len; ++k) {
+        out[k] = rows[(from + k) * channels + column];
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+TEST(SpikeDetectorTest, CutsWaveformsAroundCrossings) {
+    const size_t channels = 19;         // two SIMD blocks plus padding
+    const size_t n = 2000;
+    std::vector<int16_t> rows(n * channels, 0);
+    // Column 17: a dip below -100 at rows 500-503 and 1200-1201; column 3: a rise above 200
+    for (size_t r = 500; r < 504; ++r) rows[r * channels + 17] = -150;
+    for (size_t r = 1200; r < 1202; ++r) rows[r * channels + 17] = -101;
+    rows[700 * channels + 3] = 250;
+    rows[701 * channels + 3] = 201;
+    rows[900 * channels + 5] = -30000;  // channel left off
+
+    SpikeDetectorConfig config;
+    config.spike_length = 48;
+    config.pretrigger = 10;
+    auto detector = ThresholdSpikeDetector::create(config, channels, SpikeThreshold::off());
+    ASSERT_TRUE(detector.isOk()) << detector.error();
+    ASSERT_TRUE(detector.value().setThreshold(17, SpikeThreshold::fixed(-100)).isOk());
+    ASSERT_TRUE(detector.value().setThreshold(3, SpikeThreshold::fixed(200)).isOk());
+    EXPECT_EQ(detector.value().level(17), -100);
+    EXPECT_EQ(detector.value().level(5), 0);
+
+    const auto spikes = run(detector.value(), rows);
+    ASSERT_EQ(spikes.size(), 3u);
+    EXPECT_EQ(spikes[0].column, 17u);
+    EXPECT_EQ(spikes[0].timestamp, 1500u);
+    EXPECT_EQ(spikes[0].level, -100);
+    EXPECT_EQ(spikes[0].wave, slice(rows, channels, 17, 490, 48));
+    EXPECT_EQ(spikes[1].column, 3u);
+    EXPECT_EQ(spikes[1].timestamp, 1700u);
+    EXPECT_EQ(spikes[1].wave, slice(rows, channels, 3, 690, 48));
+    EXPECT_EQ(spikes[2].column, 17u);
+    EXPECT_EQ(spikes[2].timestamp, 2200u);
+}
+
+TEST(SpikeDetectorTest, RefractoryPeriodSuppressesRetriggers) {
+    const size_t n = 1000;
+    std::vector<int16_t> rows(n, 0);
+    for (const size_t r : {100u, 110u, 135u, 400u}) rows[r] = -500;
+
+    SpikeDetectorConfig config;
+    config.refractory_samples = 30;
+    auto detector = ThresholdSpikeDetector::create(config, 1, SpikeThreshold::fixed(-200));
+    ASSERT_TRUE(detector.isOk());
+    const auto spikes = run(detector.value(), rows);
+    ASSERT_EQ(spikes.size(), 3u);       // 110 falls inside 100's refractory period
+    EXPECT_EQ(spikes[0].timestamp, 1100u);
+    EXPECT_EQ(spikes[1].timestamp, 1135u);
+    EXPECT_EQ(spikes[2].timestamp, 1400u);
+
+    // Overlapping waveforms are each cut in full
+    EXPECT_EQ(spikes[0].wave[10], -500);
+    EXPECT_EQ(spikes[0].wave[45], -500);
+    EXPECT_EQ(spikes[1].wave[10], -500);
+}
+
+TEST(SpikeDetectorTest, RmsThresholdsArmAfterTheWindow) {
+    const size_t channels = 4;
+    const size_t n = 60000;
+    std::mt19937 rng(7);
+    std::normal_distribution<double> noise(0.0, 50.0);
+    std::vector<int16_t> rows(n * channels);
+    for (auto& v : rows) {
+        v = static_cast<int16_t>(std::lround(noise(rng)));
+    }
+    // Large spikes on column 2, before and after the window fills
+    for (const size_t r : {5000u, 40000u, 50000u}) {
+        for (size_t k = 0; k < 5; ++k) rows[(r + k) * channels + 2] = -1000;
+    }
+
+    SpikeDetectorConfig config;
+    config.rms_window = 30000;
+    auto detector = ThresholdSpikeDetector::create(config, channels, SpikeThreshold::rms(-8.0f));
+    ASSERT_TRUE(detector.isOk());
+    const auto spikes = run(detector.value(), rows);
+    ASSERT_EQ(spikes.size(), 2u);       // the first spike came before the threshold armed
+    EXPECT_EQ(spikes[0].timestamp, 41000u);
+    EXPECT_EQ(spikes[1].timestamp, 51000u);
+    EXPECT_NEAR(detector.value().rms(0), 50.0, 3.0);
+    EXPECT_NEAR(detector.value().level(0), -400, 25);
+
+    // Reset forgets the estimate; the threshold disarms until the window fills again
+    detector.value().reset();
+    EXPECT_EQ(detector.value().level(0), 0);
+    EXPECT_DOUBLE_EQ(detector.value().rms(0), 0.0);
+}
+
+TEST(SpikeDetectorTest, RejectsInvalidParameters) {
+    SpikeDetectorConfig config;
+    EXPECT_TRUE(ThresholdSpikeDetector::create(config, 0, SpikeThreshold::off()).isError());
+    EXPECT_TRUE(ThresholdSpikeDetector::create(config, 4, SpikeThreshold::fixed(0)).isError());
+    EXPECT_TRUE(ThresholdSpikeDetector::create(config, 4, SpikeThreshold::rms(0.0f)).isError());
+    config.pretrigger = config.spike_length;
+    EXPECT_TRUE(ThresholdSpikeDetector::create(config, 4, SpikeThreshold::off()).isError());
+    config.pretrigger = 0;
+    config.spike_length = 129;
+    EXPECT_TRUE(ThresholdSpikeDetector::create(config, 4, SpikeThreshold::off()).isError());
+
+    auto detector = ThresholdSpikeDetector::create(SpikeDetectorConfig{}, 4, SpikeThreshold::off());
+    ASSERT_TRUE(detector.isOk());
+    EXPECT_TRUE(detector.value().setThreshold(4, SpikeThreshold::fixed(-10)).isError());
+    EXPECT_TRUE(detector.value().setThreshold(0, SpikeThreshold::fixed(0)).isError());
+}
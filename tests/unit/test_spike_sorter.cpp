@@ -0,0 +1,193 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_spike_sorter.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the online spike sorter
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbsdk/spike_sorter.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace cbsdk;
+
+namespace {
+
+constexpr uint32_t kLength = 44;    // not a multiple of eight: exercises the scalar tail
+
+/// Basis whose components read the mean of the first half, the mean of the second half and
+/// the first sample
+ChannelSortModel halvesModel() {
+    ChannelSortModel model;
+    model.basis.assign(kLength * 3, 0.0f);
+    for (uint32_t i = 0; i < kLength; ++i) {
+        model.basis[i * 3 + (i < kLength / 2 ? 0 : 1)] = 2.0f / kLength;
+    }
+    model.basis[2] = 1.0f;
+    return model;
+}
+
+SortUnit unitAt(const uint32_t unit, const float x, const float y, const float sigma) {
+    SortUnit u;
+    u.unit = unit;
+    u.mean[0] = x;
+    u.mean[1] = y;
+    u.inv_covariance[0][0] = u.inv_covariance[1][1] = 1.0f / (sigma * sigma);
+    u.log_determinant = 4.0f * std::log(sigma);
+    return u;
+}
+
+/// Waveform of kLength samples: @p a in the first half, @p b in the second
+std::vector<int16_t> wave(const int16_t a, const int16_t b) {
+    std::vector<int16_t> w(kLength, b);
+    std::fill(w.begin(), w.begin() + kLength / 2, a);
+    return w;
+}
+
+SpikeSorter makeSorter(const size_t threads = 0) {
+    SpikeSorterConfig config;
+    config.spike_length = kLength;
+    config.threads = threads;
+    config.min_parallel_spikes = 16;
+    auto created = SpikeSorter::create(config);
+    EXPECT_TRUE(created.isOk()) << created.error();
+    return std::move(created.value());
+}
+
+} // anonymous namespace
+
+TEST(SpikeSorterTest, ProjectsAndAssignsUnits) {
+    auto sorter = makeSorter();
+    auto model = halvesModel();
+    model.units = {unitAt(1, -100.0f, 0.0f, 10.0f), unitAt(2, 0.0f, -100.0f, 10.0f)};
+    ASSERT_TRUE(sorter.setModel(3, model).isOk());
+    EXPECT_TRUE(sorter.hasModel(3));
+    EXPECT_FALSE(sorter.hasModel(4));
+
+    const auto w1 = wave(-105, 2);
+    const auto w2 = wave(-5, -96);
+    const auto w3 = wave(-60, -60);     // between the clusters: outside both gates
+    std::vector<SpikeToSort> spikes(4);
+    spikes[0].chan_id = 3;
+    spikes[0].wave = w1.data();
+    spikes[1].chan_id = 3;
+    spikes[1].wave = w2.data();
+    spikes[2].chan_id = 3;
+    spikes[2].wave = w3.data();
+    spikes[3].chan_id = 4;
+    spikes[3].wave = w1.data();
+    sorter.sort(spikes.data(), spikes.size());
+
+    EXPECT_NEAR(spikes[0].pattern[0], -105.0f, 1e-3f);
+    EXPECT_NEAR(spikes[0].pattern[1], 2.0f, 1e-3f);
+    EXPECT_NEAR(spikes[0].pattern[2], -105.0f, 1e-3f);
+    EXPECT_EQ(spikes[0].unit, 1u);
+    EXPECT_EQ(spikes[1].unit, 2u);
+    EXPECT_EQ(spikes[2].unit, 0u);
+    EXPECT_TRUE(spikes[2].modelled);
+    EXPECT_FALSE(spikes[3].modelled);
+
+    const auto stats = sorter.stats();
+    EXPECT_EQ(stats.spikes_sorted, 2u);
+    EXPECT_EQ(stats.spikes_unsorted, 1u);
+    EXPECT_EQ(stats.spikes_unmodelled, 1u);
+
+    sorter.clearModel(3);
+    EXPECT_FALSE(sorter.hasModel(3));
+}
+
+TEST(SpikeSorterTest, NoiseBoundaryTakesPrecedence) {
+    auto sorter = makeSorter();
+    auto model = halvesModel();
+    model.units = {unitAt(1, -20.0f, 0.0f, 20.0f)};
+    model.has_noise_boundary = true;
+    // Axis-aligned ellipsoid around the origin: 30 along the first component, 10 along the others
+    model.noise_axes[0][0] = 30.0f;
+    model.noise_axes[1][1] = 10.0f;
+    model.noise_axes[2][2] = 1000.0f;
+    ASSERT_TRUE(sorter.setModel(1, model).isOk());
+
+    const auto inside = wave(-25, 0);
+    const auto outside = wave(-35, 0);
+    SpikeToSort spikes[2];
+    spikes[0].chan_id = spikes[1].chan_id = 1;
+    spikes[0].wave = inside.data();
+    spikes[1].wave = outside.data();
+    sorter.sort(spikes, 2);
+    EXPECT_EQ(spikes[0].unit, SORT_UNIT_NOISE);
+    EXPECT_EQ(spikes[1].unit, 1u);
+    EXPECT_EQ(sorter.stats().spikes_noise, 1u);
+}
+
+TEST(SpikeSorterTest, WorkerPoolMatchesInlineSorting) {
+    auto inline_sorter = makeSorter();
+    auto pooled = makeSorter(3);
+    auto model = halvesModel();
+    model.units = {unitAt(1, -100.0f, 0.0f, 15.0f), unitAt(2, 0.0f, -100.0f, 15.0f),
+                   unitAt(3, -100.0f, -100.0f, 15.0f)};
+    for (uint32_t chan = 1; chan <= 32; ++chan) {
+        ASSERT_TRUE(inline_sorter.setModel(chan, model).isOk());
+        ASSERT_TRUE(pooled.setModel(chan, model).isOk());
+    }
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> amp(-130, 10);
+    std::vector<std::vector<int16_t>> waves(1000);
+    std::vector<SpikeToSort> a(waves.size());
+    for (size_t i = 0; i < waves.size(); ++i) {
+        waves[i] = wave(static_cast<int16_t>(amp(rng)), static_cast<int16_t>(amp(rng)));
+        a[i].chan_id = static_cast<uint32_t>(1 + i % 40);     // channels 33-40 have no model
+        a[i].wave = waves[i].data();
+    }
+    auto b = a;
+    for (int round = 0; round < 3; ++round) {
+        inline_sorter.sort(a.data(), a.size());
+        pooled.sort(b.data(), b.size());
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        ASSERT_EQ(a[i].unit, b[i].unit) << i;
+        ASSERT_EQ(a[i].modelled, b[i].modelled) << i;
+        ASSERT_FLOAT_EQ(a[i].pattern[0], b[i].pattern[0]) << i;
+    }
+    const auto sa = inline_sorter.stats();
+    const auto sb = pooled.stats();
+    EXPECT_EQ(sa.spikes_sorted, sb.spikes_sorted);
+    EXPECT_EQ(sa.spikes_unmodelled, 3u * 8u * 25u);
+    EXPECT_EQ(sb.spikes_unmodelled, sa.spikes_unmodelled);
+    EXPECT_GT(sb.spikes_sorted, 0u);
+}
+
+TEST(SpikeSorterTest, RejectsInvalidConfigsAndModels) {
+    SpikeSorterConfig config;
+    config.spike_length = 0;
+    EXPECT_TRUE(SpikeSorter::create(config).isError());
+    config.spike_length = 129;
+    EXPECT_TRUE(SpikeSorter::create(config).isError());
+    config.spike_length = kLength;
+    config.gate = 0.0f;
+    EXPECT_TRUE(SpikeSorter::create(config).isError());
+
+    auto sorter = makeSorter();
+    auto model = halvesModel();
+    EXPECT_TRUE(sorter.setModel(0, model).isError());
+    model.basis.resize(kLength * 3 - 1);
+    EXPECT_TRUE(sorter.setModel(1, model).isError());
+    model.basis.assign(kLength * 3, 0.0f);
+    EXPECT_TRUE(sorter.setModel(1, model).isError());
+    model = halvesModel();
+    model.units = {unitAt(6, 0.0f, 0.0f, 1.0f)};
+    EXPECT_TRUE(sorter.setModel(1, model).isError());
+    model.units = {unitAt(1, 0.0f, 0.0f, 1.0f)};
+    model.units[0].inv_covariance[0][1] = model.units[0].inv_covariance[1][0] = 2.0f;
+    EXPECT_TRUE(sorter.setModel(1, model).isError());
+    model.units = {unitAt(SORT_UNIT_NOISE, 0.0f, 0.0f, 1.0f)};
+    model.has_noise_boundary = true;
+    EXPECT_TRUE(sorter.setModel(1, model).isError());
+    model.has_noise_boundary = false;
+    EXPECT_TRUE(sorter.setModel(1, model).isOk());
+}
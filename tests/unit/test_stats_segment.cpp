@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_stats_segment.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the published stats segment
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbshm/stats_segment.h>
+#include <string>
+#include <thread>
+
+using namespace cbshm;
+
+namespace {
+
+std::string testSegmentName(const char* suffix) {
+    return std::string("cbshm_test_stats_") + suffix;
+}
+
+} // namespace
+
+TEST(StatsSegmentTest, ReaderSeesPublishedValues) {
+    auto owner = StatsSegment::create(testSegmentName("publish"));
+    ASSERT_TRUE(owner.isOk()) << owner.error();
+
+    auto reader = StatsSegment::open(testSegmentName("publish"));
+    ASSERT_TRUE(reader.isOk()) << reader.error();
+    EXPECT_TRUE(reader.value().isOwnerAlive());
+
+    auto initial = reader.value().read();
+    EXPECT_EQ(initial.magic, NATIVE_STATS_MAGIC);
+    EXPECT_EQ(initial.version, NATIVE_STATS_VERSION);
+    EXPECT_NE(initial.owner_pid, 0u);
+    EXPECT_EQ(initial.publish_count, 0u);
+
+    NativeStatsBuffer values{};
+    values.magic = 0xDEAD;  // header fields are not published
+    values.packets_received_from_device = 1234;
+    values.packets_dropped = 5;
+    values.queue_capacity = 16383;
+    values.send_thread_cpu_ns = 42;
+    owner.value().publish(values);
+    owner.value().publish(values);
+
+    const auto seen = reader.value().read();
+    EXPECT_EQ(seen.magic, NATIVE_STATS_MAGIC);
+    EXPECT_EQ(seen.publish_count, 2u);
+    EXPECT_EQ(seen.packets_received_from_device, 1234u);
+    EXPECT_EQ(seen.packets_dropped, 5u);
+    EXPECT_EQ(seen.queue_capacity, 16383u);
+    EXPECT_EQ(seen.send_thread_cpu_ns, 42u);
+}
+
+TEST(StatsSegmentTest, ReaderCannotPublish) {
+    auto owner = StatsSegment::create(testSegmentName("readonly"));
+    ASSERT_TRUE(owner.isOk()) << owner.error();
+    auto reader = StatsSegment::open(testSegmentName("readonly"));
+    ASSERT_TRUE(reader.isOk()) << reader.error();
+
+    NativeStatsBuffer values{};
+    values.packets_dropped = 99;
+    reader.value().publish(values);  // ignored (and mapped read-only)
+    EXPECT_EQ(reader.value().read().packets_dropped, 0u);
+}
+
+TEST(StatsSegmentTest, OpenFailsWithoutOwner) {
+    EXPECT_TRUE(StatsSegment::open(testSegmentName("missing")).isError());
+
+    {
+        auto owner = StatsSegment::create(testSegmentName("gone"));
+        ASSERT_TRUE(owner.isOk()) << owner.error();
+    }
+    // The owner removes the segment when it goes away
+    EXPECT_TRUE(StatsSegment::open(testSegmentName("gone")).isError());
+}
+
+TEST(StatsSegmentTest, ThreadCpuTimeAdvances) {
+    const uint64_t before = currentThreadCpuNs();
+    volatile uint64_t sink = 0;
+    for (uint64_t i = 0; i < 20'000'000; ++i) sink = sink + i;
+    const uint64_t after = currentThreadCpuNs();
+    EXPECT_GT(before, 0u);
+    EXPECT_GT(after, before);
+}
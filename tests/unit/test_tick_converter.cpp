@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   test_tick_converter.cpp
+/// @author CereLink Development Team
+/// @date   2026-10-19
+///
+/// @brief  Unit tests for the precomputed tick <-> nanosecond converter
+///
+/// The converter must reproduce the historical t * num / den integer expressions exactly,
+/// so every test compares against the plain 64-bit (or 128-bit) divide.
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <gtest/gtest.h>
+#include <cbshm/tick_converter.h>
+#include <cbproto/cbproto.h>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace cbshm;
+
+namespace {
+
+/// Reference: the expression ShmemSession used before the converter was cached
+uint64_t referenceTicksToNs(uint64_t t, uint32_t sysfreq) {
+    if (sysfreq == 0) sysfreq = 30000;
+    uint64_t g = std::gcd(uint64_t(1000000000), uint64_t(sysfreq));
+    return t * (1000000000 / g) / (sysfreq / g);
+}
+
+uint64_t referenceNsToTicks(uint64_t t, uint32_t sysfreq) {
+    if (sysfreq == 0) sysfreq = 30000;
+    uint64_t g = std::gcd(uint64_t(1000000000), uint64_t(sysfreq));
+    return t * (sysfreq / g) / (1000000000 / g);
+}
+
+} // namespace
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name ConstDivider Tests
+/// @{
+
+TEST(ConstDividerTest, MatchesHardwareDivide) {
+    const uint32_t divisors[] = {1, 2, 3, 5, 7, 10, 3000, 30000, 32768, 100000,
+                                 999999937u, 1000000000u, 0xFFFFFFFFu};
+    std::mt19937_64 rng(42);
+    for (uint32_t d : divisors) {
+        ConstDivider div(d);
+        for (uint64_t n : {uint64_t(0), uint64_t(1), uint64_t(d) - 1, uint64_t(d), uint64_t(d) + 1,
+                           ~uint64_t(0), ~uint64_t(0) - 1, uint64_t(1) << 63}) {
+            EXPECT_EQ(div.divide(n), n / d) << "n=" << n << " d=" << d;
+        }
+        for (int i = 0; i < 20000; ++i) {
+            const uint64_t n = rng();
+            ASSERT_EQ(div.divide(n), n / d) << "n=" << n << " d=" << d;
+        }
+    }
+}
+
+TEST(ConstDividerTest, ZeroDivisorIsIdentity) {
+    ConstDivider div(0);
+    EXPECT_EQ(div.divisor(), 1u);
+    EXPECT_EQ(div.divide(12345), 12345u);
+}
+
+TEST(ConstDividerTest, MulhiPortable) {
+    EXPECT_EQ(ConstDivider::mulhi(~uint64_t(0), ~uint64_t(0)), ~uint64_t(0) - 1);
+    EXPECT_EQ(ConstDivider::mulhi(uint64_t(1) << 32, uint64_t(1) << 32), 1u);
+    EXPECT_EQ(ConstDivider::mulhi(12345, 67890), 0u);
+}
+
+/// @}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name TickConverter Tests
+/// @{
+
+TEST(TickConverterTest, DefaultIsIdentity) {
+    TickConverter conv;
+    EXPECT_EQ(conv.sysfreq(), 0u);
+    EXPECT_EQ(conv.ticksToNs(123456789), 123456789u);
+    EXPECT_EQ(conv.nsToTicks(123456789), 123456789u);
+}
+
+TEST(TickConverterTest, ReducedRatio30kHz) {
+    TickConverter conv(30000);
+    EXPECT_EQ(conv.nsPerTickNum(), 100000u);
+    EXPECT_EQ(conv.nsPerTickDen(), 3u);
+    EXPECT_EQ(conv.ticksToNs(30000), 1000000000u);
+    EXPECT_EQ(conv.ticksToNs(1), 33333u);
+    EXPECT_EQ(conv.nsToTicks(1000000000), 30000u);
+}
+
+TEST(TickConverterTest, ZeroSysfreqFallsBackTo30kHz) {
+    TickConverter conv(0);
+    EXPECT_EQ(conv.sysfreq(), 30000u);
+    EXPECT_EQ(conv.nsPerTickDen(), 3u);
+}
+
+TEST(TickConverterTest, MatchesReferenceExpression) {
+    const uint32_t freqs[] = {30000, 1000, 10000, 32768, 44100, 48000, 1000000000u, 29999};
+    std::mt19937_64 rng(7);
+    for (uint32_t f : freqs) {
+        TickConverter conv(f);
+        // Keep t * num inside 64 bits, where the reference expression is defined
+        const uint64_t limit = ~uint64_t(0) / std::max(conv.nsPerTickNum(), conv.nsPerTickDen());
+        std::uniform_int_distribution<uint64_t> dist(0, limit);
+        for (uint64_t t = 0; t < 5000; ++t) {
+            ASSERT_EQ(conv.ticksToNs(t), referenceTicksToNs(t, f)) << "t=" << t << " f=" << f;
+            ASSERT_EQ(conv.nsToTicks(t), referenceNsToTicks(t, f)) << "t=" << t << " f=" << f;
+        }
+        for (int i = 0; i < 20000; ++i) {
+            const uint64_t t = dist(rng);
+            ASSERT_EQ(conv.ticksToNs(t), referenceTicksToNs(t, f)) << "t=" << t << " f=" << f;
+            ASSERT_EQ(conv.nsToTicks(t), referenceNsToTicks(t, f)) << "t=" << t << " f=" << f;
+        }
+    }
+}
+
+TEST(TickConverterTest, ExactBeyondProductOverflow) {
+#if defined(__SIZEOF_INT128__)
+    TickConverter conv(30000);
+    const uint64_t t = uint64_t(1) << 60;  // t * 100000 overflows 64 bits
+    const auto expected = static_cast<uint64_t>((static_cast<unsigned __int128>(t) * 100000) / 3);
+    EXPECT_EQ(conv.ticksToNs(t), expected);
+#else
+    GTEST_SKIP() << "No 128-bit integer reference on this compiler";
+#endif
+}
+
+TEST(TickConverterTest, BatchMatchesScalarOnPacketStride) {
+    for (uint32_t f : {30000u, 1000u}) {
+        TickConverter conv(f);
+        std::vector<cbPKT_GENERIC> pkts(64);
+        for (size_t i = 0; i < pkts.size(); ++i) {
+            pkts[i].cbpkt_header.time = 1234567890123ULL + i * 1001;
+        }
+        conv.ticksToNsBatch(reinterpret_cast<uint8_t*>(pkts.data()) + offsetof(cbPKT_HEADER, time),
+                            sizeof(cbPKT_GENERIC), pkts.size());
+        for (size_t i = 0; i < pkts.size(); ++i) {
+            EXPECT_EQ(pkts[i].cbpkt_header.time, referenceTicksToNs(1234567890123ULL + i * 1001, f));
+        }
+    }
+}
+
+/// @}
@@ -0,0 +1,306 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   cbcompress.cpp
+/// @brief  Compress an NSx file with the lossless continuous codec and report ratio and MB/s
+///
+/// Reads NSx 2.2/2.3 ("NEURALCD", 32-bit timestamps) or 3.0 ("BRSMPGRP", 64-bit timestamps)
+/// files, streams every data packet through cbsdk::ContinuousEncoder and writes the result
+/// (see cbsdk/continuous_codec.h).  Unless --no-verify is given it then decodes the output
+/// and compares every sample and timestamp with the input, so the numbers it prints are
+/// for a proven-lossless round trip on real data.  Timings cover the codec only, not file I/O.
+///
+/// Usage:
+///   ./cbcompress INPUT.nsX [OPTIONS]
+///
+/// Options:
+///   --output PATH     Output file (default: INPUT with ".cbz<N>" replacing ".ns<N>")
+///   --chunk N         Rows per chunk (default: 4096)
+///   --no-verify       Skip the decode-and-compare pass
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cbsdk/continuous_codec.h>
+#include <cbsdk/nsx_nev_format.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using cbsdk::fileformat::NsxBasicHeader;
+using cbsdk::fileformat::NsxChannelHeader;
+using Clock = std::chrono::steady_clock;
+
+static void print_usage(const char* prog) {
+    fprintf(stderr,
+        "Usage: %s INPUT.nsX [OPTIONS]\n"
+        "\n"
+        "Losslessly compress an NSx 2.2/2.3/3.0 file and report compression ratio and codec speed.\n"
+        "\n"
+        "Options:\n"
+        "  --output PATH     Output file (default: INPUT with .cbz<N> replacing .ns<N>)\n"
+        "  --chunk N         Rows per chunk (default: %u)\n"
+        "  --no-verify       Skip the decode-and-compare pass\n"
+        "  --help            Show this help\n",
+        prog, cbsdk::ContinuousEncoder::DEFAULT_CHUNK_SAMPLES);
+}
+
+/// Sequential reader of NSx data packets, yielding rows and per-row timestamps
+class NsxStream {
+public:
+    bool open(const std::string& path, std::string& error) {
+        m_file.open(path, std::ios::binary);
+        if (!m_file) {
+            error = "Failed to open " + path;
+            return false;
+        }
+        if (!m_file.read(reinterpret_cast<char*>(&m_header), sizeof(m_header))) {
+            error = path + " is too short for an NSx header";
+            return false;
+        }
+        if (std::memcmp(m_header.file_type_id, "NEURALCD", 8) == 0) {
+            m_timestamp_bytes = 4;
+        } else if (std::memcmp(m_header.file_type_id, cbsdk::fileformat::NSX_FILE_TYPE_ID, 8) == 0) {
+            m_timestamp_bytes = 8;
+        } else {
+            error = path + " is not an NSx 2.2+ file (NSx 2.1 has no timestamps to preserve)";
+            return false;
+        }
+        if (m_header.channel_count == 0 || m_header.time_resolution == 0) {
+            error = path + " has no channels";
+            return false;
+        }
+        for (uint32_t i = 0; i < m_header.channel_count; ++i) {
+            NsxChannelHeader cc{};
+            if (!m_file.read(reinterpret_cast<char*>(&cc), sizeof(cc))) {
+                error = path + " has truncated channel headers";
+                return false;
+            }
+            m_channel_ids.push_back(cc.electrode_id);
+        }
+        m_file.seekg(m_header.bytes_in_headers);
+        return static_cast<bool>(m_file);
+    }
+
+    /// Read up to @p max_rows rows; @return rows read (0 at the end of the file)
+    size_t next(const size_t max_rows, std::vector<int16_t>& frames, std::vector<uint64_t>& timestamps) {
+        const size_t channels = m_header.channel_count;
+        frames.resize(max_rows * channels);
+        timestamps.resize(max_rows);
+        size_t rows = 0;
+        while (rows < max_rows) {
+            if (m_left == 0 && !nextPacket()) {
+                break;
+            }
+            const size_t want = std::min<uint64_t>(max_rows - rows, m_left);
+            m_file.read(reinterpret_cast<char*>(&frames[rows * channels]),
+                        static_cast<std::streamsize>(want * channels * sizeof(int16_t)));
+            const size_t got = static_cast<size_t>(m_file.gcount()) / (channels * sizeof(int16_t));
+            for (size_t i = 0; i < got; ++i) {
+                // Rows after the first of a packet are one sample period apart
+                timestamps[rows + i] = m_packet_time + (m_packet_row + i) * m_header.period *
+                                       uint64_t{m_header.time_resolution} / 30000;
+            }
+            rows += got;
+            m_packet_row += got;
+            m_left -= got;
+            if (got < want) {
+                m_left = 0;
+                m_eof = true;
+                break;
+            }
+        }
+        return rows;
+    }
+
+    const NsxBasicHeader& header() const { return m_header; }
+    const std::vector<uint16_t>& channelIds() const { return m_channel_ids; }
+
+private:
+    bool nextPacket() {
+        if (m_eof) {
+            return false;
+        }
+        uint8_t marker = 0;
+        uint64_t time = 0;
+        uint32_t points = 0;
+        if (!m_file.read(reinterpret_cast<char*>(&marker), 1) ||
+            !m_file.read(reinterpret_cast<char*>(&time), m_timestamp_bytes) ||
+            !m_file.read(reinterpret_cast<char*>(&points), sizeof(points)) || marker != 1) {
+            m_eof = true;
+            return false;
+        }
+        m_packet_time = time;
+        m_packet_row = 0;
+        // Central leaves num_points at 0 if a recording was cut short: the data runs to the end
+        m_left = points != 0 ? points : UINT64_MAX;
+        return true;
+    }
+
+    std::ifstream m_file;
+    NsxBasicHeader m_header{};
+    std::vector<uint16_t> m_channel_ids;
+    std::streamsize m_timestamp_bytes = 8;
+    uint64_t m_packet_time = 0;
+    uint64_t m_packet_row = 0;
+    uint64_t m_left = 0;
+    bool m_eof = false;
+};
+
+static double seconds(const Clock::duration d) {
+    return std::chrono::duration<double>(d).count();
+}
+
+int main(int argc, char* argv[]) {
+    std::string input;
+    std::string output;
+    uint32_t chunk = cbsdk::ContinuousEncoder::DEFAULT_CHUNK_SAMPLES;
+    bool verify = true;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (arg == "--no-verify") {
+            verify = false;
+        } else if (arg.rfind("--", 0) != 0 && input.empty()) {
+            input = arg;
+        } else if (!has_value) {
+            fprintf(stderr, "Missing value for %s\n\n", arg.c_str());
+            print_usage(argv[0]);
+            return 1;
+        } else if (arg == "--output") {
+            output = argv[++i];
+        } else if (arg == "--chunk") {
+            chunk = static_cast<uint32_t>(std::atol(argv[++i]));
+        } else {
+            fprintf(stderr, "Unknown option: %s\n\n", arg.c_str());
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (input.empty()) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (output.empty()) {
+        output = input;
+        const size_t dot = output.rfind(".ns");
+        output = dot != std::string::npos ? output.substr(0, dot) + ".cbz" + output.substr(dot + 3) : output + ".cbz";
+    }
+
+    NsxStream nsx;
+    std::string error;
+    if (!nsx.open(input, error)) {
+        fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    const auto& hdr = nsx.header();
+    const size_t channels = hdr.channel_count;
+    char label[sizeof(hdr.label) + 1] = {};
+    std::memcpy(label, hdr.label, sizeof(hdr.label));
+
+    // Encode
+    std::vector<uint8_t> encoded;
+    auto created = cbsdk::ContinuousEncoder::create(nsx.channelIds(), hdr.period, label, encoded, chunk,
+                                                    hdr.time_resolution);
+    if (created.isError()) {
+        fprintf(stderr, "%s\n", created.error().c_str());
+        return 1;
+    }
+    auto& encoder = created.value();
+    std::ofstream out(output, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        fprintf(stderr, "Failed to create %s\n", output.c_str());
+        return 1;
+    }
+
+    std::vector<int16_t> frames;
+    std::vector<uint64_t> timestamps;
+    Clock::duration encode_time{};
+    for (;;) {
+        const size_t rows = nsx.next(chunk, frames, timestamps);
+        if (rows == 0) {
+            break;
+        }
+        const auto t0 = Clock::now();
+        for (size_t r = 0; r < rows; ++r) {
+            encoder.push(timestamps[r], &frames[r * channels], encoded);
+        }
+        encode_time += Clock::now() - t0;
+        out.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+        encoded.clear();
+    }
+    const auto t0 = Clock::now();
+    encoder.finish(encoded);
+    encode_time += Clock::now() - t0;
+    out.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+    out.close();
+    if (!out) {
+        fprintf(stderr, "Failed to write %s\n", output.c_str());
+        return 1;
+    }
+
+    const auto stats = encoder.stats();
+    const double sample_mb = static_cast<double>(stats.samples * channels * sizeof(int16_t)) / 1e6;
+    printf("%s: %zu channels, %llu samples (%s)\n", input.c_str(), channels,
+           static_cast<unsigned long long>(stats.samples), label);
+    printf("%s: %.1f MB -> %.1f MB, ratio %.2f (int16 samples + 64-bit timestamps: %.2f)\n", output.c_str(),
+           sample_mb, static_cast<double>(stats.encoded_bytes) / 1e6,
+           sample_mb * 1e6 / static_cast<double>(stats.encoded_bytes),
+           static_cast<double>(stats.raw_bytes) / static_cast<double>(stats.encoded_bytes));
+    printf("encode: %.0f MB/s\n", sample_mb / std::max(seconds(encode_time), 1e-9));
+
+    if (!verify) {
+        return 0;
+    }
+
+    // Decode and compare against a second pass over the input
+    auto reader = cbsdk::ContinuousReader::open(output);
+    if (reader.isError()) {
+        fprintf(stderr, "%s\n", reader.error().c_str());
+        return 1;
+    }
+    if (reader.value().sampleCount() != stats.samples) {
+        fprintf(stderr, "Verify failed: %llu samples decoded, %llu encoded\n",
+                static_cast<unsigned long long>(reader.value().sampleCount()),
+                static_cast<unsigned long long>(stats.samples));
+        return 1;
+    }
+    NsxStream again;
+    again.open(input, error);
+    std::vector<int16_t> decoded;
+    std::vector<uint64_t> decoded_ts;
+    Clock::duration decode_time{};
+    uint64_t row = 0;
+    for (;;) {
+        const size_t rows = again.next(chunk, frames, timestamps);
+        if (rows == 0) {
+            break;
+        }
+        decoded.resize(rows * channels);
+        decoded_ts.resize(rows);
+        const auto d0 = Clock::now();
+        auto r = reader.value().read(row, rows, decoded.data(), decoded_ts.data());
+        decode_time += Clock::now() - d0;
+        if (r.isError()) {
+            fprintf(stderr, "Verify failed at sample %llu: %s\n", static_cast<unsigned long long>(row),
+                    r.error().c_str());
+            return 1;
+        }
+        if (!std::equal(decoded.begin(), decoded.end(), frames.begin()) ||
+            !std::equal(decoded_ts.begin(), decoded_ts.end(), timestamps.begin())) {
+            fprintf(stderr, "Verify failed: mismatch in samples %llu-%llu\n", static_cast<unsigned long long>(row),
+                    static_cast<unsigned long long>(row + rows - 1));
+            return 1;
+        }
+        row += rows;
+    }
+    printf("decode: %.0f MB/s, lossless round trip verified\n", sample_mb / std::max(seconds(decode_time), 1e-9));
+    return 0;
+}
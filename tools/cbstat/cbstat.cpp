@@ -0,0 +1,212 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   cbstat.cpp
+/// @brief  top-style monitor for the stats STANDALONE sessions publish to shared memory
+///
+/// Maps each device's "cbshm_{device}_stats" segment read-only (see cbshm/stats_segment.h)
+/// and prints packet rates, drops, callback queue depth, per-thread CPU load and the age of
+/// the last datagram.  Attaching costs the monitored session nothing.
+///
+/// Usage:
+///   ./cbstat [OPTIONS]
+///
+/// Options:
+///   --device NAME     Device to watch: legacy_nsp, nsp, hub1, hub2, hub3, nplay (repeatable;
+///                     default: every device with a running session)
+///   --interval SECS   Refresh interval (default: 1)
+///   --count N         Exit after N refreshes (default: run until Ctrl-C)
+///   --batch           Append rows instead of redrawing the screen (for logging)
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cbshm/stats_segment.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::atomic<bool> g_running{true};
+
+static void signal_handler(int) {
+    g_running = false;
+}
+
+static const char* const kDeviceNames[] = {"legacy_nsp", "nsp", "hub1", "hub2", "hub3", "nplay"};
+
+static void print_usage(const char* prog) {
+    fprintf(stderr,
+        "Usage: %s [OPTIONS]\n"
+        "\n"
+        "Monitor the statistics CereLink STANDALONE sessions publish to shared memory.\n"
+        "\n"
+        "Options:\n"
+        "  --device NAME     legacy_nsp, nsp, hub1, hub2, hub3 or nplay (repeatable;\n"
+        "                    default: every device with a running session)\n"
+        "  --interval SECS   Refresh interval (default: 1)\n"
+        "  --count N         Exit after N refreshes (default: until Ctrl-C)\n"
+        "  --batch           Append rows instead of redrawing the screen\n"
+        "  --help            Show this help\n",
+        prog);
+}
+
+/// One watched device: its segment (if a session is running) and the previous sample
+struct Watch {
+    std::string device;
+    std::optional<cbshm::StatsSegment> segment;
+    std::optional<cbshm::NativeStatsBuffer> prev;
+};
+
+static int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// CPU load of one thread between two samples, in percent of one core
+static double cpuPercent(uint64_t now_ns, uint64_t prev_ns, double wall_ns) {
+    return wall_ns > 0 && now_ns >= prev_ns ? 100.0 * static_cast<double>(now_ns - prev_ns) / wall_ns : 0.0;
+}
+
+/// Print one device's row
+/// @param show_missing Print a placeholder row when the device has no session
+/// @return true if a row was printed
+static bool printRow(Watch& w, bool show_missing) {
+    if (!w.segment) {
+        auto result = cbshm::StatsSegment::open("cbshm_" + w.device + "_stats");
+        if (result.isError()) {
+            if (show_missing) {
+                printf("%-10s  %s\n", w.device.c_str(), "-- no session --");
+            }
+            return show_missing;
+        }
+        w.segment = std::move(result.value());
+        w.prev.reset();
+    }
+
+    const auto s = w.segment->read();
+    if (!w.segment->isOwnerAlive()) {
+        printf("%-10s  pid %-7u  -- owner exited --\n", w.device.c_str(), s.owner_pid);
+        w.segment.reset();  // Reopen once a new session has published
+        return true;
+    }
+
+    const int64_t now = steadyNowNs();
+    const double last_dg_ms = s.last_datagram_steady_ns > 0
+        ? static_cast<double>(now - s.last_datagram_steady_ns) / 1e6 : -1.0;
+
+    double pkt_rate = 0, mb_rate = 0, drop_rate = 0;
+    double cpu_recv = 0, cpu_cb = 0, cpu_send = 0;
+    if (w.prev && s.publish_count != w.prev->publish_count) {
+        const double wall_ns = static_cast<double>(s.publish_steady_ns - w.prev->publish_steady_ns);
+        const double wall_s = wall_ns / 1e9;
+        if (wall_s > 0) {
+            pkt_rate = static_cast<double>(s.packets_received_from_device - w.prev->packets_received_from_device) / wall_s;
+            mb_rate = static_cast<double>(s.bytes_received_from_device - w.prev->bytes_received_from_device) / wall_s / 1e6;
+            drop_rate = static_cast<double>(s.packets_dropped - w.prev->packets_dropped) / wall_s;
+        }
+        cpu_recv = cpuPercent(s.receive_thread_cpu_ns, w.prev->receive_thread_cpu_ns, wall_ns);
+        cpu_cb = cpuPercent(s.callback_thread_cpu_ns, w.prev->callback_thread_cpu_ns, wall_ns);
+        cpu_send = cpuPercent(s.send_thread_cpu_ns, w.prev->send_thread_cpu_ns, wall_ns);
+    }
+    // A counter reset (SdkSession::resetStats) shows as negative rates; clamp them
+    if (pkt_rate < 0) pkt_rate = 0;
+    if (mb_rate < 0) mb_rate = 0;
+    if (drop_rate < 0) drop_rate = 0;
+    w.prev = s;
+
+    char last_dg[16];
+    if (last_dg_ms < 0) {
+        snprintf(last_dg, sizeof(last_dg), "%s", "never");
+    } else {
+        snprintf(last_dg, sizeof(last_dg), "%.0f ms", last_dg_ms);
+    }
+
+    printf("%-10s  pid %-7u  %9.0f pkt/s  %7.2f MB/s  drop %8llu (%6.0f/s)  "
+           "queue %5llu/%-5llu max %5llu  cpu rx %5.1f%% cb %5.1f%% tx %5.1f%%  last %8s  err %llu\n",
+           w.device.c_str(), s.owner_pid, pkt_rate, mb_rate,
+           static_cast<unsigned long long>(s.packets_dropped), drop_rate,
+           static_cast<unsigned long long>(s.queue_current_depth),
+           static_cast<unsigned long long>(s.queue_capacity),
+           static_cast<unsigned long long>(s.queue_max_depth),
+           cpu_recv, cpu_cb, cpu_send, last_dg,
+           static_cast<unsigned long long>(s.shmem_store_errors + s.receive_errors + s.send_errors));
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> devices;
+    double interval_s = 1.0;
+    long count = 0;
+    bool batch = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (arg == "--batch") {
+            batch = true;
+        } else if (!has_value) {
+            fprintf(stderr, "Missing value for %s\n\n", arg.c_str());
+            print_usage(argv[0]);
+            return 1;
+        } else if (arg == "--device") {
+            devices.emplace_back(argv[++i]);
+        } else if (arg == "--interval") {
+            interval_s = std::atof(argv[++i]);
+        } else if (arg == "--count") {
+            count = std::atol(argv[++i]);
+        } else {
+            fprintf(stderr, "Unknown option: %s\n\n", arg.c_str());
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (interval_s <= 0) {
+        fprintf(stderr, "--interval must be positive\n");
+        return 1;
+    }
+
+    const bool watch_all = devices.empty();
+    if (watch_all) {
+        devices.assign(std::begin(kDeviceNames), std::end(kDeviceNames));
+    }
+    std::vector<Watch> watches;
+    for (const auto& d : devices) {
+        watches.push_back({d, std::nullopt, std::nullopt});
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    const auto interval = std::chrono::duration<double>(interval_s);
+    for (long n = 0; g_running && (count <= 0 || n < count); ++n) {
+        if (!batch) {
+            printf("\033[H\033[2J");  // Home + clear screen
+            printf("cbstat - CereLink session stats (every %.1f s, Ctrl-C to quit)\n\n", interval_s);
+        }
+        size_t shown = 0;
+        for (auto& w : watches) {
+            // With no explicit devices, only list the ones that have a session
+            if (!printRow(w, !watch_all)) {
+                continue;
+            }
+            ++shown;
+        }
+        if (shown == 0) {
+            printf("No CereLink STANDALONE session is publishing stats\n");
+        }
+        fflush(stdout);
+
+        const auto deadline = std::chrono::steady_clock::now() + interval;
+        while (g_running && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////////////////////////
+/// @file   device_simulator.cpp
+/// @brief  Command-line front end for cbsim::DeviceSimulator
+///
+/// Runs a synthetic current-protocol device on loopback so the full UDP -> cbdev -> cbshm ->
+/// callback pipeline can be soak- and load-tested without hardware or nPlayServer.
+///
+/// Usage:
+///   ./device_simulator [OPTIONS]
+///
+/// Options:
+///   --address ADDR        Address to bind (default: 127.0.0.1)
+///   --port PORT           Port to bind (default: 51001, as nPlayServer; 0 = any)
+///   --client ADDR:PORT    Stream to a fixed client instead of the last peer
+///   --group G:N           Add N channels at sample group G (repeatable; default 5:96)
+///   --spike-rate HZ       Mean spikes/s per front-end channel (default: 10)
+///   --datagram BYTES      Maximum datagram size (default: 8192)
+///   --speed X             Clock rate relative to real time; 0 = as fast as possible (default: 1)
+///   --standby             Start in STANDBY (client must run the startup handshake)
+///   --duration SECS       Stop after SECS seconds (default: run until Ctrl-C)
+///
+/// Examples:
+///   # nPlay-compatible: connect with DeviceType::NPLAY
+///   ./device_simulator --group 5:256 --group 2:16
+///
+///   # Throughput test on a custom port, unthrottled
+///   ./device_simulator --port 52001 --group 6:272 --speed 0
+///
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cbsim/device_simulator.h>
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+static std::atomic<bool> g_running{true};
+
+static void signal_handler(int) {
+    g_running = false;
+}
+
+static void print_usage(const char* prog) {
+    fprintf(stderr,
+        "Usage: %s [OPTIONS]\n"
+        "\n"
+        "Synthetic current-protocol device for loopback load testing.\n"
+        "\n"
+        "Options:\n"
+        "  --address ADDR        Address to bind (default: 127.0.0.1)\n"
+        "  --port PORT           Port to bind (default: 51001; 0 = any)\n"
+        "  --client ADDR:PORT    Stream to a fixed client instead of the last peer\n"
+        "  --group G:N           Add N channels at sample group G (repeatable; default 5:96)\n"
+        "  --spike-rate HZ       Mean spikes/s per front-end channel (default: 10)\n"
+        "  --datagram BYTES      Maximum datagram size (default: 8192)\n"
+        "  --speed X             Clock rate relative to real time; 0 = unthrottled (default: 1)\n"
+        "  --standby             Start in STANDBY (client must run the startup handshake)\n"
+        "  --duration SECS       Stop after SECS seconds (default: until Ctrl-C)\n"
+        "  --help                Show this help\n",
+        prog);
+}
+
+int main(int argc, char* argv[]) {
+    cbsim::SimulatorConfig config;
+    config.groups.clear();
+    double duration_s = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        } else if (arg == "--standby") {
+            config.initial_runlevel = 30;  // cbRUNLEVEL_STANDBY
+        } else if (!has_value) {
+            fprintf(stderr, "Missing value for %s\n\n", arg.c_str());
+            print_usage(argv[0]);
+            return 1;
+        } else if (arg == "--address") {
+            config.address = argv[++i];
+        } else if (arg == "--port") {
+            config.port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (arg == "--client") {
+            const std::string value = argv[++i];
+            const auto colon = value.rfind(':');
+            if (colon == std::string::npos) {
+                fprintf(stderr, "--client expects ADDR:PORT\n");
+                return 1;
+            }
+            config.client_address = value.substr(0, colon);
+            config.client_port = static_cast<uint16_t>(std::atoi(value.c_str() + colon + 1));
+        } else if (arg == "--group") {
+            unsigned group = 0, channels = 0;
+            if (std::sscanf(argv[++i], "%u:%u", &group, &channels) != 2) {
+                fprintf(stderr, "--group expects G:N (e.g. 5:96)\n");
+                return 1;
+            }
+            config.groups.push_back({group, channels});
+        } else if (arg == "--spike-rate") {
+            config.spike_rate_hz = std::atof(argv[++i]);
+        } else if (arg == "--datagram") {
+            config.max_datagram_bytes = static_cast<size_t>(std::atol(argv[++i]));
+        } else if (arg == "--speed") {
+            config.speed = std::atof(argv[++i]);
+        } else if (arg == "--duration") {
+            duration_s = std::atof(argv[++i]);
+        } else {
+            fprintf(stderr, "Unknown option: %s\n\n", arg.c_str());
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (config.groups.empty()) {
+        config.groups.push_back({});
+    }
+
+    auto result = cbsim::DeviceSimulator::create(config);
+    if (result.isError()) {
+        fprintf(stderr, "Failed to create simulator: %s\n", result.error().c_str());
+        return 1;
+    }
+    auto& sim = result.value();
+    if (auto started = sim.start(); started.isError()) {
+        fprintf(stderr, "Failed to start simulator: %s\n", started.error().c_str());
+        return 1;
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+
+    fprintf(stderr, "Simulating %u channels on %s:%u (speed %s). Ctrl-C to stop.\n",
+            sim.channelCount(), config.address.c_str(), sim.port(),
+            config.speed > 0 ? std::to_string(config.speed).c_str() : "unthrottled");
+
+    // One status line per second
+    const auto start = std::chrono::steady_clock::now();
+    cbsim::SimulatorStats prev;
+    while (g_running) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        const auto s = sim.stats();
+        const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        fprintf(stderr, "%8.1f s  runlevel %u  %7.0f pkt/s  %7.2f MB/s  %6.0f spk/s  "
+                        "probes %llu  cfg %llu  send errors %llu\n",
+                elapsed, sim.runlevel(),
+                static_cast<double>(s.packets_sent - prev.packets_sent),
+                static_cast<double>(s.bytes_sent - prev.bytes_sent) / 1e6,
+                static_cast<double>(s.spike_packets - prev.spike_packets),
+                static_cast<unsigned long long>(s.clock_probes),
+                static_cast<unsigned long long>(s.config_requests),
+                static_cast<unsigned long long>(s.send_errors));
+        prev = s;
+        if (duration_s > 0 && elapsed >= duration_s) break;
+    }
+
+    sim.stop();
+    const auto s = sim.stats();
+    fprintf(stderr, "Sent %llu packets (%llu group, %llu spike) in %llu datagrams\n",
+            static_cast<unsigned long long>(s.packets_sent),
+            static_cast<unsigned long long>(s.group_packets),
+            static_cast<unsigned long long>(s.spike_packets),
+            static_cast<unsigned long long>(s.datagrams_sent));
+    return 0;
+}